@@ -19,7 +19,8 @@ function(compile_shader SHADERS TARGET_NAME SHADER_INCLUDE_FOLDER GENERATED_DIR
         set(CPP_FILE "${CMAKE_CURRENT_SOURCE_DIR}/${GENERATED_DIR}/cpp/${HEADER_NAME}.h")
 
         # 检查是否为光线追踪着色器，需要更高的SPIR-V版本
-        if(SHADER_NAME MATCHES "\.\(rgen|rchit|rmiss|rcall\)$")
+        # rt_前缀的计算着色器属于光线追踪流程，可能使用光线查询扩展，同样按 Vulkan 1.2 编译
+        if(SHADER_NAME MATCHES "\.\(rgen|rchit|rmiss|rcall\)$" OR SHADER_NAME MATCHES "^rt_.*\.comp$")
             # 光线追踪着色器使用 KHR 扩展，需要 Vulkan 1.2 支持
             add_custom_command(
                 OUTPUT ${SPV_FILE}
@@ -48,6 +49,54 @@ function(compile_shader SHADERS TARGET_NAME SHADER_INCLUDE_FOLDER GENERATED_DIR
 
     endforeach()
 
+    # 着色器变体：同一源文件以额外宏定义再编译一份，参数格式为 "<文件名>:<宏>"
+    # 例如 "PBR.frag:RAY_QUERY_SHADOWS" 生成 PBR_ray_query_shadows.frag.spv 与全局变量 PBR_RAY_QUERY_SHADOWS_FRAG
+    # 变体通常用于可选硬件特性（如光线查询），统一以 Vulkan 1.2 / SPIR-V 1.4 为目标编译
+    cmake_parse_arguments(SHADER_ARG "" "" "VARIANTS" ${ARGN})
+    foreach(VARIANT ${SHADER_ARG_VARIANTS})
+        string(REPLACE ":" ";" VARIANT_PARTS ${VARIANT})
+        list(GET VARIANT_PARTS 0 VARIANT_SOURCE_NAME)
+        list(GET VARIANT_PARTS 1 VARIANT_DEFINE)
+
+        set(VARIANT_SHADER "")
+        foreach(SHADER ${SHADERS})
+            get_filename_component(SHADER_NAME ${SHADER} NAME)
+            if(SHADER_NAME STREQUAL VARIANT_SOURCE_NAME)
+                set(VARIANT_SHADER ${SHADER})
+            endif()
+        endforeach()
+        if(NOT VARIANT_SHADER)
+            message(FATAL_ERROR "Shader variant source ${VARIANT_SOURCE_NAME} not found")
+        endif()
+
+        get_filename_component(VARIANT_STEM ${VARIANT_SOURCE_NAME} NAME_WE)
+        get_filename_component(VARIANT_EXT ${VARIANT_SOURCE_NAME} EXT)
+        string(TOLOWER ${VARIANT_DEFINE} VARIANT_SUFFIX)
+        set(SHADER_NAME "${VARIANT_STEM}_${VARIANT_SUFFIX}${VARIANT_EXT}")
+        string(REPLACE "." "_" HEADER_NAME ${SHADER_NAME})
+        string(TOUPPER ${HEADER_NAME} GLOBAL_SHADER_VAR)
+
+        set(SPV_FILE "${CMAKE_CURRENT_SOURCE_DIR}/${GENERATED_DIR}/spv/${SHADER_NAME}.spv")
+        set(CPP_FILE "${CMAKE_CURRENT_SOURCE_DIR}/${GENERATED_DIR}/cpp/${HEADER_NAME}.h")
+
+        add_custom_command(
+            OUTPUT ${SPV_FILE}
+            COMMAND ${GLSLANG_BIN} -I${SHADER_INCLUDE_FOLDER} -V --target-env vulkan1.2 -D${VARIANT_DEFINE} -o ${SPV_FILE} ${VARIANT_SHADER}
+            DEPENDS ${VARIANT_SHADER}
+            WORKING_DIRECTORY "${working_dir}")
+
+        list(APPEND ALL_GENERATED_SPV_FILES ${SPV_FILE})
+
+        add_custom_command(
+            OUTPUT ${CPP_FILE}
+            COMMAND ${CMAKE_COMMAND} -DPATH=${SPV_FILE} -DHEADER="${CPP_FILE}" 
+                -DGLOBAL="${GLOBAL_SHADER_VAR}" -P "${EnumaElish_ROOT_DIR}/cmake/GenerateShaderCPPFile.cmake"
+            DEPENDS ${SPV_FILE}
+            WORKING_DIRECTORY "${working_dir}")
+
+        list(APPEND ALL_GENERATED_CPP_FILES ${CPP_FILE})
+    endforeach()
+
     add_custom_target(${TARGET_NAME}
         DEPENDS ${ALL_GENERATED_SPV_FILES} ${ALL_GENERATED_CPP_FILES} SOURCES ${SHADERS})
 
@@ -0,0 +1,147 @@
+#include "acceleration_structure_cache.h"
+#include "../core/base/macro.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace Elish
+{
+    namespace
+    {
+        // FNV-1a 64位哈希
+        constexpr uint64_t k_fnv_offset_basis = 14695981039346656037ull;
+        constexpr uint64_t k_fnv_prime = 1099511628211ull;
+
+        uint64_t fnv1a(const void* data, size_t size, uint64_t seed = k_fnv_offset_basis)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            uint64_t hash = seed;
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= k_fnv_prime;
+            }
+            return hash;
+        }
+    }
+
+    AccelerationStructureCache::AccelerationStructureCache(std::string cache_directory)
+        : m_cache_directory(std::move(cache_directory))
+    {
+    }
+
+    void AccelerationStructureCache::setDeviceKey(const uint8_t device_uuid[RHI_UUID_SIZE], const uint8_t driver_uuid[RHI_UUID_SIZE])
+    {
+        m_device_key = fnv1a(driver_uuid, RHI_UUID_SIZE, fnv1a(device_uuid, RHI_UUID_SIZE));
+    }
+
+    uint64_t AccelerationStructureCache::hashMesh(const void* vertex_data, size_t vertex_bytes, const uint32_t* indices, size_t index_count, uint32_t build_flags)
+    {
+        uint64_t hash = fnv1a(&build_flags, sizeof(build_flags));
+        hash = fnv1a(&vertex_bytes, sizeof(vertex_bytes), hash);
+        hash = fnv1a(vertex_data, vertex_bytes, hash);
+        hash = fnv1a(&index_count, sizeof(index_count), hash);
+        return fnv1a(indices, index_count * sizeof(uint32_t), hash);
+    }
+
+    std::string AccelerationStructureCache::getFilePath(uint64_t mesh_hash) const
+    {
+        char file_name[64];
+        snprintf(file_name, sizeof(file_name), "%016llx_%016llx.blas",
+                 static_cast<unsigned long long>(m_device_key), static_cast<unsigned long long>(mesh_hash));
+        return (std::filesystem::path(m_cache_directory) / file_name).string();
+    }
+
+    bool AccelerationStructureCache::load(uint64_t mesh_hash, std::vector<uint8_t>& serialized_data) const
+    {
+        std::ifstream file(getFilePath(mesh_hash), std::ios::in | std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        FileHeader header{};
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            header.magic != k_magic || header.version != k_version ||
+            header.device_key != m_device_key || header.mesh_hash != mesh_hash ||
+            header.data_size < k_version_data_size + 3 * sizeof(uint64_t))
+        {
+            LOG_WARN("[AccelerationStructureCache] Invalid cache header for mesh {:016x}", mesh_hash);
+            return false;
+        }
+
+        serialized_data.resize(static_cast<size_t>(header.data_size));
+        if (!file.read(reinterpret_cast<char*>(serialized_data.data()), static_cast<std::streamsize>(header.data_size)))
+        {
+            LOG_WARN("[AccelerationStructureCache] Truncated cache file for mesh {:016x}", mesh_hash);
+            serialized_data.clear();
+            return false;
+        }
+        return true;
+    }
+
+    bool AccelerationStructureCache::store(uint64_t mesh_hash, const void* serialized_data, size_t size) const
+    {
+        std::error_code error;
+        std::filesystem::create_directories(m_cache_directory, error);
+        if (error)
+        {
+            LOG_WARN("[AccelerationStructureCache] Failed to create cache directory {}: {}", m_cache_directory, error.message());
+            return false;
+        }
+
+        // 先写临时文件再重命名，避免中断时留下不完整的缓存
+        std::string path = getFilePath(mesh_hash);
+        std::string temp_path = path + ".tmp";
+        {
+            std::ofstream file(temp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                LOG_WARN("[AccelerationStructureCache] Failed to open {} for writing", temp_path);
+                return false;
+            }
+
+            FileHeader header{};
+            header.magic = k_magic;
+            header.version = k_version;
+            header.device_key = m_device_key;
+            header.mesh_hash = mesh_hash;
+            header.data_size = size;
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(static_cast<const char*>(serialized_data), static_cast<std::streamsize>(size));
+            if (!file)
+            {
+                LOG_WARN("[AccelerationStructureCache] Failed to write {}", temp_path);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temp_path, path, error);
+        if (error)
+        {
+            LOG_WARN("[AccelerationStructureCache] Failed to finalize {}: {}", path, error.message());
+            std::filesystem::remove(temp_path, error);
+            return false;
+        }
+        return true;
+    }
+
+    void AccelerationStructureCache::remove(uint64_t mesh_hash) const
+    {
+        std::error_code error;
+        std::filesystem::remove(getFilePath(mesh_hash), error);
+    }
+
+    RHIDeviceSize AccelerationStructureCache::getDeserializedSize(const std::vector<uint8_t>& serialized_data)
+    {
+        const size_t offset = k_version_data_size + sizeof(uint64_t);
+        if (serialized_data.size() < offset + sizeof(uint64_t))
+        {
+            return 0;
+        }
+        uint64_t deserialized_size = 0;
+        memcpy(&deserialized_size, serialized_data.data() + offset, sizeof(uint64_t));
+        return static_cast<RHIDeviceSize>(deserialized_size);
+    }
+} // namespace Elish
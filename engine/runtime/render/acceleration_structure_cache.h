@@ -0,0 +1,77 @@
+#pragma once
+
+#include "render_type.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Elish
+{
+    /**
+     * @brief 加速结构磁盘缓存
+     * @details 以网格哈希为键保存序列化后的（压缩）BLAS数据，文件头记录设备/驱动UUID，
+     *          设备或驱动变化时缓存自动失效。序列化数据自身的兼容性由RHI::isAccelerationStructureCompatible再次校验
+     */
+    class AccelerationStructureCache
+    {
+    public:
+        explicit AccelerationStructureCache(std::string cache_directory = "../bin/cache/blas");
+
+        /**
+         * @brief 设置设备键（物理设备UUID + 驱动UUID）
+         */
+        void setDeviceKey(const uint8_t device_uuid[RHI_UUID_SIZE], const uint8_t driver_uuid[RHI_UUID_SIZE]);
+
+        /**
+         * @brief 计算网格哈希（顶点、索引数据与构建标志）
+         */
+        static uint64_t hashMesh(const void* vertex_data, size_t vertex_bytes, const uint32_t* indices, size_t index_count, uint32_t build_flags);
+
+        /**
+         * @brief 读取缓存的序列化数据
+         * @param mesh_hash 网格哈希
+         * @param serialized_data 输出的序列化数据
+         * @return 文件存在且文件头（魔数、版本、设备键、网格哈希、长度）匹配时返回true
+         */
+        bool load(uint64_t mesh_hash, std::vector<uint8_t>& serialized_data) const;
+
+        /**
+         * @brief 写入序列化数据，失败仅记录警告
+         */
+        bool store(uint64_t mesh_hash, const void* serialized_data, size_t size) const;
+
+        /**
+         * @brief 删除失效的缓存文件
+         */
+        void remove(uint64_t mesh_hash) const;
+
+        /**
+         * @brief 从序列化数据头读取反序列化后加速结构所需的大小
+         * @details 数据头布局：driverUUID[16] + compatibilityUUID[16] + 序列化大小(u64) + 反序列化大小(u64) + 句柄数(u64)
+         * @return 数据过短时返回0
+         */
+        static RHIDeviceSize getDeserializedSize(const std::vector<uint8_t>& serialized_data);
+
+        /**
+         * @brief 序列化数据头中版本信息的长度（供兼容性检查）
+         */
+        static constexpr size_t k_version_data_size = 2 * RHI_UUID_SIZE;
+
+    private:
+        std::string getFilePath(uint64_t mesh_hash) const;
+
+        struct FileHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t device_key;
+            uint64_t mesh_hash;
+            uint64_t data_size;
+        };
+
+        static constexpr uint32_t k_magic = 0x53414545; // "EEAS"
+        static constexpr uint32_t k_version = 1;
+
+        std::string m_cache_directory;
+        uint64_t m_device_key = 0;
+    };
+} // namespace Elish
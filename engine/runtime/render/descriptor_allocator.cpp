@@ -0,0 +1,365 @@
+#include "descriptor_allocator.h"
+#include "../core/base/macro.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Elish
+{
+    namespace
+    {
+        /**
+         * @brief 新建描述符池时每个描述符集平均预留的各类描述符数量
+         * @details 池按“描述符集数 × 比例”分配各类型容量，比例覆盖本渲染器中的常见布局（材质纹理、实例缓冲、存储图像等）
+         */
+        struct PoolSizeRatio
+        {
+            RHIDescriptorType type;
+            float             ratio;
+        };
+
+        constexpr PoolSizeRatio k_pool_size_ratios[] = {
+            { RHI_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1.0f },
+            { RHI_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f },
+            { RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2.0f },
+            { RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1.0f },
+            { RHI_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.0f },
+            { RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE, 2.0f },
+            { RHI_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 1.0f },
+        };
+
+        constexpr float k_acceleration_structure_ratio = 1.0f;
+
+        uint64_t pointerKey(const void* pointer)
+        {
+            return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+        }
+    } // namespace
+
+    DescriptorAllocator::~DescriptorAllocator()
+    {
+        clear();
+    }
+
+    void DescriptorAllocator::initialize(std::shared_ptr<RHI> rhi)
+    {
+        m_rhi = rhi;
+        m_frames.clear();
+        m_frames.resize(std::max<uint32_t>(1, m_rhi->getMaxFramesInFlight()));
+        m_current_frame = 0;
+        m_stats = Stats{};
+    }
+
+    void DescriptorAllocator::clear()
+    {
+        if (!m_rhi)
+        {
+            return;
+        }
+
+        // 已归还的集合仍记录在长期池链中，随池链一并销毁
+        m_free_sets.clear();
+        destroyChain(m_persistent_chain);
+        for (FrameResources& frame : m_frames)
+        {
+            frame.pending_releases.clear();
+            destroyChain(frame.cache_chain);
+            frame.cache.clear();
+            frame.cache_entry_count = 0;
+            frame.cache_reset_pending = false;
+        }
+        m_frames.clear();
+        m_stats.cache_entries = 0;
+        m_rhi.reset();
+    }
+
+    void DescriptorAllocator::beginFrame(uint32_t frame_index)
+    {
+        if (m_frames.empty())
+        {
+            return;
+        }
+
+        m_current_frame = frame_index % static_cast<uint32_t>(m_frames.size());
+        FrameResources& frame = m_frames[m_current_frame];
+
+        // 该飞行帧的栅栏已等待完成，上一轮归还的描述符集不再被GPU引用，可以复用
+        for (const auto& [layout, descriptor_set] : frame.pending_releases)
+        {
+            m_free_sets[layout].push_back(descriptor_set);
+        }
+        frame.pending_releases.clear();
+
+        // 缓存过大或已失效时整体重置，避免逐条淘汰
+        if (frame.cache_reset_pending || frame.cache_entry_count > k_max_cache_entries_per_frame)
+        {
+            resetCache(frame);
+        }
+        m_stats.cache_entries = frame.cache_entry_count;
+    }
+
+    RHIDescriptorSet* DescriptorAllocator::allocate(RHIDescriptorSetLayout* layout)
+    {
+        auto free_sets = m_free_sets.find(layout);
+        if (free_sets != m_free_sets.end() && !free_sets->second.empty())
+        {
+            RHIDescriptorSet* descriptor_set = free_sets->second.back();
+            free_sets->second.pop_back();
+            return descriptor_set;
+        }
+        return allocateFromChain(m_persistent_chain, layout);
+    }
+
+    void DescriptorAllocator::release(RHIDescriptorSetLayout* layout, RHIDescriptorSet* descriptor_set)
+    {
+        if (m_frames.empty() || !layout || !descriptor_set)
+        {
+            return;
+        }
+        m_frames[m_current_frame].pending_releases.emplace_back(layout, descriptor_set);
+    }
+
+    RHIDescriptorSet* DescriptorAllocator::getOrCreate(RHIDescriptorSetLayout* layout, uint32_t write_count, const RHIWriteDescriptorSet* writes)
+    {
+        if (m_frames.empty() || !layout)
+        {
+            return nullptr;
+        }
+
+        FrameResources& frame = m_frames[m_current_frame];
+        buildCacheKey(layout, write_count, writes, m_key_scratch);
+        uint64_t hash = hashCacheKey(m_key_scratch);
+
+        std::vector<CacheEntry>& bucket = frame.cache[hash];
+        for (const CacheEntry& entry : bucket)
+        {
+            if (entry.layout == layout && entry.key == m_key_scratch)
+            {
+                ++m_stats.cache_hits;
+                return entry.descriptor_set;
+            }
+        }
+
+        ++m_stats.cache_misses;
+        RHIDescriptorSet* descriptor_set = allocateFromChain(frame.cache_chain, layout);
+        if (!descriptor_set)
+        {
+            return nullptr;
+        }
+
+        std::vector<RHIWriteDescriptorSet> patched_writes(writes, writes + write_count);
+        for (RHIWriteDescriptorSet& write : patched_writes)
+        {
+            write.dstSet = descriptor_set;
+        }
+        m_rhi->updateDescriptorSets(write_count, patched_writes.data(), 0, nullptr);
+
+        bucket.push_back(CacheEntry{ layout, m_key_scratch, descriptor_set });
+        ++frame.cache_entry_count;
+        m_stats.cache_entries = frame.cache_entry_count;
+        return descriptor_set;
+    }
+
+    void DescriptorAllocator::invalidateCache()
+    {
+        for (FrameResources& frame : m_frames)
+        {
+            frame.cache_reset_pending = true;
+        }
+
+        // 当前帧的描述符集可能已录制进命令缓冲区，池等到下次进入该帧时再重置，这里只清空查找表
+        if (!m_frames.empty())
+        {
+            FrameResources& frame = m_frames[m_current_frame];
+            frame.cache.clear();
+            frame.cache_entry_count = 0;
+            m_stats.cache_entries = 0;
+        }
+    }
+
+    RHIDescriptorSet* DescriptorAllocator::allocateFromChain(PoolChain& chain, RHIDescriptorSetLayout* layout)
+    {
+        if (!m_rhi || !layout)
+        {
+            return nullptr;
+        }
+
+        if (chain.sets_per_pool == 0)
+        {
+            chain.sets_per_pool = k_initial_sets_per_pool;
+        }
+
+        for (uint32_t attempt = 0; attempt < 2; ++attempt)
+        {
+            if (chain.ready_pools.empty())
+            {
+                RHIDescriptorPool* pool = createPool(chain.sets_per_pool);
+                if (!pool)
+                {
+                    return nullptr;
+                }
+                chain.ready_pools.push_back(pool);
+            }
+
+            RHIDescriptorSetAllocateInfo allocate_info{};
+            allocate_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocate_info.descriptorPool = chain.ready_pools.back();
+            allocate_info.descriptorSetCount = 1;
+            allocate_info.pSetLayouts = &layout;
+
+            RHIDescriptorSet* descriptor_set = nullptr;
+            if (m_rhi->allocateDescriptorSets(&allocate_info, descriptor_set))
+            {
+                chain.allocated_sets.push_back(descriptor_set);
+                return descriptor_set;
+            }
+
+            // 当前池耗尽（或碎片化），移入full列表并以更大的容量新建池后重试
+            chain.full_pools.push_back(chain.ready_pools.back());
+            chain.ready_pools.pop_back();
+            chain.sets_per_pool = std::min(chain.sets_per_pool + chain.sets_per_pool / 2, k_max_sets_per_pool);
+        }
+
+        LOG_ERROR("[DescriptorAllocator] Failed to allocate descriptor set from a freshly created pool");
+        return nullptr;
+    }
+
+    RHIDescriptorPool* DescriptorAllocator::createPool(uint32_t max_sets)
+    {
+        std::vector<RHIDescriptorPoolSize> pool_sizes;
+        pool_sizes.reserve(sizeof(k_pool_size_ratios) / sizeof(k_pool_size_ratios[0]) + 1);
+        for (const PoolSizeRatio& ratio : k_pool_size_ratios)
+        {
+            pool_sizes.push_back({ ratio.type, static_cast<uint32_t>(std::ceil(ratio.ratio * max_sets)) });
+        }
+        if (m_rhi->isRayTracingSupported() || m_rhi->isRayQuerySupported())
+        {
+            pool_sizes.push_back({ RHI_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
+                                   static_cast<uint32_t>(std::ceil(k_acceleration_structure_ratio * max_sets)) });
+        }
+
+        RHIDescriptorPoolCreateInfo pool_info{};
+        pool_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        pool_info.flags = 0;
+        pool_info.maxSets = max_sets;
+        pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
+        pool_info.pPoolSizes = pool_sizes.data();
+
+        RHIDescriptorPool* pool = nullptr;
+        if (m_rhi->createDescriptorPool(&pool_info, pool) != RHI_SUCCESS)
+        {
+            LOG_ERROR("[DescriptorAllocator] Failed to create descriptor pool with {} sets", max_sets);
+            return nullptr;
+        }
+
+        ++m_stats.pool_count;
+        LOG_DEBUG("[DescriptorAllocator] Created descriptor pool with {} sets ({} pools total)", max_sets, m_stats.pool_count);
+        return pool;
+    }
+
+    void DescriptorAllocator::resetChain(PoolChain& chain)
+    {
+        for (RHIDescriptorPool* pool : chain.full_pools)
+        {
+            chain.ready_pools.push_back(pool);
+        }
+        chain.full_pools.clear();
+
+        for (RHIDescriptorPool* pool : chain.ready_pools)
+        {
+            m_rhi->resetDescriptorPool(pool);
+        }
+
+        for (RHIDescriptorSet* descriptor_set : chain.allocated_sets)
+        {
+            m_rhi->releaseDescriptorSet(descriptor_set);
+        }
+        chain.allocated_sets.clear();
+    }
+
+    void DescriptorAllocator::destroyChain(PoolChain& chain)
+    {
+        for (RHIDescriptorSet* descriptor_set : chain.allocated_sets)
+        {
+            m_rhi->releaseDescriptorSet(descriptor_set);
+        }
+        chain.allocated_sets.clear();
+
+        for (RHIDescriptorPool* pool : chain.ready_pools)
+        {
+            m_rhi->destroyDescriptorPool(pool);
+            --m_stats.pool_count;
+        }
+        for (RHIDescriptorPool* pool : chain.full_pools)
+        {
+            m_rhi->destroyDescriptorPool(pool);
+            --m_stats.pool_count;
+        }
+        chain.ready_pools.clear();
+        chain.full_pools.clear();
+        chain.sets_per_pool = 0;
+    }
+
+    void DescriptorAllocator::resetCache(FrameResources& frame)
+    {
+        resetChain(frame.cache_chain);
+        frame.cache.clear();
+        frame.cache_entry_count = 0;
+        frame.cache_reset_pending = false;
+    }
+
+    void DescriptorAllocator::buildCacheKey(RHIDescriptorSetLayout* layout, uint32_t write_count, const RHIWriteDescriptorSet* writes, std::vector<uint64_t>& key)
+    {
+        key.clear();
+        key.push_back(pointerKey(layout));
+        for (uint32_t i = 0; i < write_count; ++i)
+        {
+            const RHIWriteDescriptorSet& write = writes[i];
+            key.push_back((static_cast<uint64_t>(write.dstBinding) << 32) | write.dstArrayElement);
+            key.push_back((static_cast<uint64_t>(write.descriptorType) << 32) | write.descriptorCount);
+
+            for (uint32_t element = 0; element < write.descriptorCount; ++element)
+            {
+                if (write.pImageInfo)
+                {
+                    const RHIDescriptorImageInfo& image_info = write.pImageInfo[element];
+                    key.push_back(pointerKey(image_info.sampler));
+                    key.push_back(pointerKey(image_info.imageView));
+                    key.push_back(static_cast<uint64_t>(image_info.imageLayout));
+                }
+                if (write.pBufferInfo)
+                {
+                    const RHIDescriptorBufferInfo& buffer_info = write.pBufferInfo[element];
+                    key.push_back(pointerKey(buffer_info.buffer));
+                    key.push_back(buffer_info.offset);
+                    key.push_back(buffer_info.range);
+                }
+            }
+            if (write.pTexelBufferView)
+            {
+                key.push_back(pointerKey(write.pTexelBufferView));
+            }
+
+            if (write.descriptorType == RHI_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR && write.pNext)
+            {
+                const auto* acceleration_structure_info = static_cast<const RHIWriteDescriptorSetAccelerationStructureKHR*>(write.pNext);
+                for (uint32_t element = 0; element < acceleration_structure_info->accelerationStructureCount; ++element)
+                {
+                    key.push_back(pointerKey(acceleration_structure_info->pAccelerationStructures[element]));
+                }
+            }
+        }
+    }
+
+    uint64_t DescriptorAllocator::hashCacheKey(const std::vector<uint64_t>& key)
+    {
+        // FNV-1a，按64位字折叠
+        uint64_t hash = 14695981039346656037ull;
+        for (uint64_t value : key)
+        {
+            hash ^= value;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+} // namespace Elish
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "interface/rhi.h"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Elish
+{
+    /**
+     * @brief 描述符集分配器
+     * @details 在RHI的全局描述符池之外提供三类分配方式：
+     *          1. allocate()：长期存在的描述符集，从可增长的池链分配，池耗尽时自动新建更大的池，不再受单个固定大小池的限制；
+     *          2. release()：归还allocate()分配的描述符集，等所在飞行帧下次开始后供同布局的allocate()复用；
+     *          3. getOrCreate()：按“布局 + 绑定资源”缓存的描述符集，绑定资源不变时直接复用，避免每帧重复分配与vkUpdateDescriptorSets。
+     *          缓存与归还均按飞行帧划分，beginFrame()须在当前帧的栅栏等待完成之后调用
+     */
+    class DescriptorAllocator
+    {
+    public:
+        DescriptorAllocator() = default;
+        ~DescriptorAllocator();
+
+        DescriptorAllocator(const DescriptorAllocator&) = delete;
+        DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+
+        void initialize(std::shared_ptr<RHI> rhi);
+        void clear();
+
+        /**
+         * @brief 开始新的一帧：回收该飞行帧上次归还的描述符集，并按需重置该帧的缓存池
+         * @param frame_index 当前飞行帧索引
+         */
+        void beginFrame(uint32_t frame_index);
+
+        /**
+         * @brief 分配长期存在的描述符集
+         * @return 分配失败返回nullptr
+         */
+        RHIDescriptorSet* allocate(RHIDescriptorSetLayout* layout);
+
+        /**
+         * @brief 归还allocate()分配的描述符集
+         * @details 集合可能仍被在途帧引用，下次进入当前飞行帧时才进入空闲列表；调用方归还后不得再使用该句柄
+         */
+        void release(RHIDescriptorSetLayout* layout, RHIDescriptorSet* descriptor_set);
+
+        /**
+         * @brief 按布局与绑定资源查找缓存的描述符集，未命中时分配并写入
+         * @details writes中的dstSet被忽略；键比较的是句柄指针，资源销毁后若地址被复用，
+         *          调用方需先调用invalidateCache()
+         * @param layout 描述符集布局
+         * @param write_count 写入数量
+         * @param writes 完整描述该描述符集内容的写入
+         * @return 当前帧可用的描述符集，失败返回nullptr
+         */
+        RHIDescriptorSet* getOrCreate(RHIDescriptorSetLayout* layout, uint32_t write_count, const RHIWriteDescriptorSet* writes);
+
+        /**
+         * @brief 使所有缓存失效（资源重建、交换链重建后调用）
+         */
+        void invalidateCache();
+
+        struct Stats
+        {
+            uint32_t pool_count = 0;        // 当前存在的描述符池数量
+            uint32_t cache_entries = 0;     // 当前帧缓存中的描述符集数量
+            uint64_t cache_hits = 0;
+            uint64_t cache_misses = 0;
+        };
+        const Stats& getStats() const { return m_stats; }
+
+    private:
+        /**
+         * @brief 描述符池链
+         * @details 当前池耗尽时移入full列表并创建新池，新池可容纳的描述符集数按系数增长直至上限；
+         *          reset()重置所有池并释放已分配描述符集的句柄包装对象
+         */
+        struct PoolChain
+        {
+            std::vector<RHIDescriptorPool*> ready_pools;
+            std::vector<RHIDescriptorPool*> full_pools;
+            std::vector<RHIDescriptorSet*>  allocated_sets;
+            uint32_t                        sets_per_pool = 0;
+        };
+
+        struct CacheEntry
+        {
+            RHIDescriptorSetLayout* layout;
+            std::vector<uint64_t>   key;
+            RHIDescriptorSet*       descriptor_set;
+        };
+
+        struct FrameResources
+        {
+            std::vector<std::pair<RHIDescriptorSetLayout*, RHIDescriptorSet*>> pending_releases;
+            PoolChain cache_chain;
+            std::unordered_map<uint64_t, std::vector<CacheEntry>> cache;
+            uint32_t cache_entry_count = 0;
+            bool     cache_reset_pending = false;
+        };
+
+        RHIDescriptorSet* allocateFromChain(PoolChain& chain, RHIDescriptorSetLayout* layout);
+        RHIDescriptorPool* createPool(uint32_t max_sets);
+        void resetChain(PoolChain& chain);
+        void destroyChain(PoolChain& chain);
+        void resetCache(FrameResources& frame);
+
+        static void buildCacheKey(RHIDescriptorSetLayout* layout, uint32_t write_count, const RHIWriteDescriptorSet* writes, std::vector<uint64_t>& key);
+        static uint64_t hashCacheKey(const std::vector<uint64_t>& key);
+
+        std::shared_ptr<RHI>        m_rhi;
+        PoolChain                   m_persistent_chain;
+        std::unordered_map<RHIDescriptorSetLayout*, std::vector<RHIDescriptorSet*>> m_free_sets;   // 已归还且GPU不再引用的长期描述符集
+        std::vector<FrameResources> m_frames;
+        uint32_t                    m_current_frame = 0;
+        std::vector<uint64_t>       m_key_scratch;
+        Stats                       m_stats;
+
+        static constexpr uint32_t k_initial_sets_per_pool = 64;
+        static constexpr uint32_t k_max_sets_per_pool = 4096;
+        static constexpr uint32_t k_max_cache_entries_per_frame = 1024;
+    };
+} // namespace Elish
@@ -0,0 +1,1322 @@
+#include "null_rhi.h"
+
+#include "../../window_system.h"
+#include "../../../core/base/macro.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace Elish
+{
+    NullRHI::NullRHI(uint32_t width, uint32_t height)
+    {
+        m_swapchain_extent.width = width;
+        m_swapchain_extent.height = height;
+    }
+
+    NullRHI::~NullRHI()
+    {
+        clear();
+    }
+
+    // ---------------------------------------------------------------------
+    // 内部工具
+    // ---------------------------------------------------------------------
+
+    void NullRHI::resetStats()
+    {
+        uint64_t live_handles = m_stats.live_handles;
+        m_stats = NullRHIStats{};
+        m_stats.live_handles = live_handles;
+    }
+
+    RHIDeviceAddress NullRHI::allocateDeviceAddress(RHIDeviceSize size)
+    {
+        // 按256字节对齐递增，保证每个对象的地址唯一且不为0
+        RHIDeviceAddress address = m_next_device_address;
+        m_next_device_address += (std::max<RHIDeviceSize>(size, 1) + 255) & ~RHIDeviceSize(255);
+        return address;
+    }
+
+    void NullRHI::record(RHICommandBuffer* command_buffer, NullCommandType type, uint64_t handle,
+                         uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3)
+    {
+        if (!command_buffer)
+        {
+            return;
+        }
+        NullCommand command;
+        command.type = type;
+        command.handle = handle;
+        command.args[0] = arg0;
+        command.args[1] = arg1;
+        command.args[2] = arg2;
+        command.args[3] = arg3;
+        static_cast<NullCommandBuffer*>(command_buffer)->record(command);
+        ++m_stats.recorded_commands;
+    }
+
+    void NullRHI::submitCommandBuffer(RHICommandBuffer* command_buffer)
+    {
+        if (!command_buffer)
+        {
+            return;
+        }
+        const auto& commands = static_cast<NullCommandBuffer*>(command_buffer)->getCommands();
+        m_submitted_commands.insert(m_submitted_commands.end(), commands.begin(), commands.end());
+    }
+
+    void NullRHI::countUpload(RHIDeviceSize bytes)
+    {
+        ++m_stats.uploads;
+        m_stats.upload_bytes += bytes;
+    }
+
+    NullBuffer* NullRHI::newBuffer(RHIDeviceSize size)
+    {
+        return new NullBuffer(nextId(), size, allocateDeviceAddress(size));
+    }
+
+    NullImage* NullRHI::newImage(uint32_t width, uint32_t height, RHIFormat format)
+    {
+        return new NullImage(nextId(), width, height, format);
+    }
+
+    void NullRHI::deleteHandle(RHIBuffer*& handle)
+    {
+        if (handle)
+        {
+            delete static_cast<NullBuffer*>(handle);
+            handle = nullptr;
+            releaseHandle();
+        }
+    }
+
+    void NullRHI::deleteHandle(RHIDeviceMemory*& handle)
+    {
+        if (handle)
+        {
+            delete static_cast<NullDeviceMemory*>(handle);
+            handle = nullptr;
+            releaseHandle();
+        }
+    }
+
+    void NullRHI::deleteHandle(RHIImage*& handle)
+    {
+        if (handle)
+        {
+            delete static_cast<NullImage*>(handle);
+            handle = nullptr;
+            releaseHandle();
+        }
+    }
+
+    void NullRHI::deleteHandle(RHIAccelerationStructure*& handle)
+    {
+        if (handle)
+        {
+            delete static_cast<NullAccelerationStructure*>(handle);
+            handle = nullptr;
+            releaseHandle();
+        }
+    }
+
+    void NullRHI::deleteHandle(RHICommandBuffer*& handle)
+    {
+        if (handle)
+        {
+            delete static_cast<NullCommandBuffer*>(handle);
+            handle = nullptr;
+            releaseHandle();
+        }
+    }
+
+    // ---------------------------------------------------------------------
+    // 初始化
+    // ---------------------------------------------------------------------
+
+    void NullRHI::initialize(RHIInitInfo initialize_info)
+    {
+        m_window_system = initialize_info.window_system;
+        if (m_window_system)
+        {
+            std::array<int, 2> window_size = m_window_system->getWindowSize();
+            m_swapchain_extent.width = static_cast<uint32_t>(std::max(window_size[0], 1));
+            m_swapchain_extent.height = static_cast<uint32_t>(std::max(window_size[1], 1));
+        }
+
+        m_graphics_queue = new NullQueue(nextId());
+        m_compute_queue = new NullQueue(nextId());
+        createCommandPool();
+        m_descriptor_pool = new NullDescriptorPool(nextId());
+        for (uint8_t i = 0; i < k_max_frames_in_flight; ++i)
+        {
+            m_command_buffers[i] = new NullCommandBuffer(nextId());
+            m_frame_fences[i] = new NullFence(nextId());
+            m_texture_copy_semaphores[i] = new NullSemaphore(nextId());
+        }
+
+        createSwapchain();
+        createSwapchainImageViews();
+        createFramebufferImageAndView();
+
+        LOG_INFO("[NullRHI] Initialized {}x{} virtual swapchain, no GPU will be used", m_swapchain_extent.width, m_swapchain_extent.height);
+    }
+
+    void NullRHI::prepareContext()
+    {
+    }
+
+    bool NullRHI::isPointLightShadowEnabled()
+    {
+        return false;
+    }
+
+    // ---------------------------------------------------------------------
+    // 分配与创建：只分配句柄
+    // ---------------------------------------------------------------------
+
+    bool NullRHI::allocateCommandBuffers(const RHICommandBufferAllocateInfo* pAllocateInfo, RHICommandBuffer*& pCommandBuffers)
+    {
+        pCommandBuffers = new NullCommandBuffer(nextId());
+        return true;
+    }
+
+    bool NullRHI::allocateDescriptorSets(const RHIDescriptorSetAllocateInfo* pAllocateInfo, RHIDescriptorSet*& pDescriptorSets)
+    {
+        pDescriptorSets = new NullDescriptorSet(nextId());
+        return true;
+    }
+
+    RHIResult NullRHI::allocateDescriptorSets(RHIDescriptorSetLayout* layout, RHIDescriptorSet*& descriptor_set)
+    {
+        descriptor_set = new NullDescriptorSet(nextId());
+        return RHI_SUCCESS;
+    }
+
+    bool NullRHI::resetDescriptorPool(RHIDescriptorPool* descriptorPool)
+    {
+        return descriptorPool != nullptr;
+    }
+
+    void NullRHI::releaseDescriptorSet(RHIDescriptorSet* descriptorSet)
+    {
+        deleteHandle(descriptorSet);
+    }
+
+    void NullRHI::createSwapchain()
+    {
+        m_viewport = { 0.0f, 0.0f, static_cast<float>(m_swapchain_extent.width), static_cast<float>(m_swapchain_extent.height), 0.0f, 1.0f };
+        m_scissor = { { 0, 0 }, { m_swapchain_extent.width, m_swapchain_extent.height } };
+    }
+
+    void NullRHI::recreateSwapchain()
+    {
+        if (m_window_system)
+        {
+            std::array<int, 2> window_size = m_window_system->getWindowSize();
+            m_swapchain_extent.width = static_cast<uint32_t>(std::max(window_size[0], 1));
+            m_swapchain_extent.height = static_cast<uint32_t>(std::max(window_size[1], 1));
+        }
+
+        clearSwapchain();
+        createSwapchain();
+        createSwapchainImageViews();
+        createFramebufferImageAndView();
+    }
+
+    void NullRHI::createSwapchainImageViews()
+    {
+        m_swapchain_imageviews.resize(k_max_frames_in_flight);
+        for (auto& image_view : m_swapchain_imageviews)
+        {
+            image_view = new NullImageView(nextId());
+        }
+    }
+
+    void NullRHI::createFramebufferImageAndView()
+    {
+        deleteHandle(m_depth_image_view);
+        deleteHandle(m_depth_image);
+        m_depth_image = newImage(m_swapchain_extent.width, m_swapchain_extent.height, m_depth_image_format);
+        m_depth_image_view = new NullImageView(nextId());
+    }
+
+    RHISampler* NullRHI::getOrCreateDefaultSampler(RHIDefaultSamplerType type)
+    {
+        RHISampler*& sampler = type == Default_Sampler_Nearest ? m_nearest_sampler : m_linear_sampler;
+        if (!sampler)
+        {
+            sampler = new NullSampler(nextId());
+        }
+        return sampler;
+    }
+
+    RHISampler* NullRHI::getOrCreateMipmapSampler(uint32_t width, uint32_t height)
+    {
+        uint32_t mip_levels = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+        auto it = m_mipmap_sampler_map.find(mip_levels);
+        if (it != m_mipmap_sampler_map.end())
+        {
+            return it->second;
+        }
+        RHISampler* sampler = new NullSampler(nextId());
+        m_mipmap_sampler_map.emplace(mip_levels, sampler);
+        return sampler;
+    }
+
+    RHIShader* NullRHI::createShaderModule(const std::vector<unsigned char>& shader_code)
+    {
+        return new NullShader(nextId());
+    }
+
+    void NullRHI::createBuffer(RHIDeviceSize size, RHIBufferUsageFlags usage, RHIMemoryPropertyFlags properties, RHIBuffer*& buffer, RHIDeviceMemory*& buffer_memory)
+    {
+        buffer = newBuffer(size);
+        buffer_memory = new NullDeviceMemory(nextId(), size);
+    }
+
+    RHIResult NullRHI::createBuffer(const RHIBufferCreateInfo* create_info, RHIBuffer*& buffer)
+    {
+        buffer = newBuffer(create_info->size);
+        return RHI_SUCCESS;
+    }
+
+    void NullRHI::createBufferAndInitialize(RHIBufferUsageFlags usage, RHIMemoryPropertyFlags properties, RHIBuffer*& buffer, RHIDeviceMemory*& buffer_memory, RHIDeviceSize size, void* data, int datasize)
+    {
+        createBuffer(size, usage, properties, buffer, buffer_memory);
+        if (data && datasize > 0)
+        {
+            size_t copy_size = std::min(static_cast<size_t>(datasize), static_cast<size_t>(size));
+            memcpy(static_cast<NullBuffer*>(buffer)->getData(), data, copy_size);
+            memcpy(static_cast<NullDeviceMemory*>(buffer_memory)->getData(), data, copy_size);
+            countUpload(copy_size);
+        }
+    }
+
+    bool NullRHI::createBufferVMA(VmaAllocator allocator,
+        const RHIBufferCreateInfo* pBufferCreateInfo,
+        const VmaAllocationCreateInfo* pAllocationCreateInfo,
+        RHIBuffer*& pBuffer,
+        VmaAllocation* pAllocation,
+        VmaAllocationInfo* pAllocationInfo)
+    {
+        NullBuffer* buffer = newBuffer(pBufferCreateInfo->size);
+        pBuffer = buffer;
+        if (pAllocation)
+        {
+            *pAllocation = nullptr;
+        }
+        if (pAllocationInfo)
+        {
+            *pAllocationInfo = {};
+            pAllocationInfo->size = pBufferCreateInfo->size;
+            pAllocationInfo->pMappedData = buffer->getData();
+        }
+        return true;
+    }
+
+    bool NullRHI::createBufferWithAlignmentVMA(
+        VmaAllocator allocator,
+        const RHIBufferCreateInfo* pBufferCreateInfo,
+        const VmaAllocationCreateInfo* pAllocationCreateInfo,
+        RHIDeviceSize minAlignment,
+        RHIBuffer*& pBuffer,
+        VmaAllocation* pAllocation,
+        VmaAllocationInfo* pAllocationInfo)
+    {
+        return createBufferVMA(allocator, pBufferCreateInfo, pAllocationCreateInfo, pBuffer, pAllocation, pAllocationInfo);
+    }
+
+    void NullRHI::copyBuffer(RHIBuffer* srcBuffer, RHIBuffer* dstBuffer, RHIDeviceSize srcOffset, RHIDeviceSize dstOffset, RHIDeviceSize size)
+    {
+        NullBuffer* src = static_cast<NullBuffer*>(srcBuffer);
+        NullBuffer* dst = static_cast<NullBuffer*>(dstBuffer);
+        if (src && dst && srcOffset + size <= src->getSize() && dstOffset + size <= dst->getSize())
+        {
+            memcpy(dst->getData() + dstOffset, src->getData() + srcOffset, static_cast<size_t>(size));
+        }
+        countUpload(size);
+    }
+
+    void NullRHI::createImage(uint32_t image_width, uint32_t image_height, RHIFormat format, RHIImageTiling image_tiling, RHIImageUsageFlags image_usage_flags, RHIMemoryPropertyFlags memory_property_flags,
+        RHIImage*& image, RHIDeviceMemory*& memory, RHIImageCreateFlags image_create_flags, uint32_t array_layers, uint32_t miplevels)
+    {
+        image = newImage(image_width, image_height, format);
+        memory = new NullDeviceMemory(nextId(), 0);
+    }
+
+    void NullRHI::createImageView(RHIImage* image, RHIFormat format, RHIImageAspectFlags image_aspect_flags, RHIImageViewType view_type, uint32_t layout_count, uint32_t miplevels, RHIImageView*& image_view)
+    {
+        image_view = new NullImageView(nextId());
+    }
+
+    RHIResult NullRHI::createImageView(const RHIImageViewCreateInfo* create_info, RHIImageView*& image_view)
+    {
+        image_view = new NullImageView(nextId());
+        return RHI_SUCCESS;
+    }
+
+    void NullRHI::createGlobalImage(RHIImage*& image, RHIImageView*& image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, void* texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels)
+    {
+        image = newImage(texture_image_width, texture_image_height, texture_image_format);
+        image_view = new NullImageView(nextId());
+        image_allocation = nullptr;
+        if (texture_image_pixels)
+        {
+            countUpload(static_cast<RHIDeviceSize>(texture_image_width) * texture_image_height * 4);
+        }
+    }
+
+    void NullRHI::createCubeMap(RHIImage*& image, RHIImageView*& image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, std::array<void*, 6> texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels)
+    {
+        image = newImage(texture_image_width, texture_image_height, texture_image_format);
+        image_view = new NullImageView(nextId());
+        image_allocation = nullptr;
+        for (void* pixels : texture_image_pixels)
+        {
+            if (pixels)
+            {
+                countUpload(static_cast<RHIDeviceSize>(texture_image_width) * texture_image_height * 4);
+            }
+        }
+    }
+
+    void NullRHI::createCommandPool()
+    {
+        if (!m_command_pool)
+        {
+            m_command_pool = new NullCommandPool(nextId());
+        }
+    }
+
+    bool NullRHI::createCommandPool(const RHICommandPoolCreateInfo* pCreateInfo, RHICommandPool*& pCommandPool)
+    {
+        pCommandPool = new NullCommandPool(nextId());
+        return true;
+    }
+
+    bool NullRHI::createDescriptorPool(const RHIDescriptorPoolCreateInfo* pCreateInfo, RHIDescriptorPool*& pDescriptorPool)
+    {
+        pDescriptorPool = new NullDescriptorPool(nextId());
+        return true;
+    }
+
+    bool NullRHI::createDescriptorSetLayout(const RHIDescriptorSetLayoutCreateInfo* pCreateInfo, RHIDescriptorSetLayout*& pSetLayout)
+    {
+        pSetLayout = new NullDescriptorSetLayout(nextId());
+        return true;
+    }
+
+    bool NullRHI::createFence(const RHIFenceCreateInfo* pCreateInfo, RHIFence*& pFence)
+    {
+        pFence = new NullFence(nextId());
+        return true;
+    }
+
+    bool NullRHI::createFramebuffer(const RHIFramebufferCreateInfo* pCreateInfo, RHIFramebuffer*& pFramebuffer)
+    {
+        pFramebuffer = new NullFramebuffer(nextId());
+        return true;
+    }
+
+    bool NullRHI::createGraphicsPipelines(RHIPipelineCache* pipelineCache, uint32_t createInfoCount, const RHIGraphicsPipelineCreateInfo* pCreateInfos, RHIPipeline*& pPipelines)
+    {
+        pPipelines = new NullPipeline(nextId());
+        return true;
+    }
+
+    bool NullRHI::createComputePipelines(RHIPipelineCache* pipelineCache, uint32_t createInfoCount, const RHIComputePipelineCreateInfo* pCreateInfos, RHIPipeline*& pPipelines)
+    {
+        pPipelines = new NullPipeline(nextId());
+        return true;
+    }
+
+    bool NullRHI::createRayTracingPipelines(RHIPipelineCache* pipelineCache, uint32_t createInfoCount, const RHIRayTracingPipelineCreateInfo* pCreateInfos, RHIPipeline*& pPipelines)
+    {
+        pPipelines = new NullPipeline(nextId());
+        return true;
+    }
+
+    // ---------------------------------------------------------------------
+    // 加速结构：只记录大小与伪造的设备地址
+    // ---------------------------------------------------------------------
+
+    bool NullRHI::createAccelerationStructure(const RHIAccelerationStructureCreateInfo* pCreateInfo, RHIAccelerationStructure*& pAccelerationStructure)
+    {
+        pAccelerationStructure = new NullAccelerationStructure(nextId(), pCreateInfo->size, allocateDeviceAddress(pCreateInfo->size));
+        return true;
+    }
+
+    bool NullRHI::buildAccelerationStructure(RHICommandBuffer* commandBuffer, const RHIAccelerationStructureBuildInfo* pBuildInfo)
+    {
+        record(commandBuffer, NullCommandType::BuildAccelerationStructure, handleId(pBuildInfo->dstAccelerationStructure),
+               static_cast<uint32_t>(pBuildInfo->type), static_cast<uint32_t>(pBuildInfo->mode), pBuildInfo->geometryCount);
+        ++m_stats.acceleration_structure_builds;
+        return true;
+    }
+
+    void NullRHI::getAccelerationStructureDeviceAddress(const RHIAccelerationStructureDeviceAddressInfo* pInfo, RHIDeviceAddress* pAddress)
+    {
+        *pAddress = pInfo->accelerationStructure ? static_cast<NullAccelerationStructure*>(pInfo->accelerationStructure)->getDeviceAddress() : 0;
+    }
+
+    void NullRHI::getAccelerationStructureBuildSizes(const RHIAccelerationStructureBuildGeometryInfoKHR* pBuildInfo, const uint32_t* pMaxPrimitiveCounts, RHIAccelerationStructureBuildSizesInfoKHR* pSizeInfo)
+    {
+        // 按每个图元/实例64字节粗略估算，只需保证大小非零且随场景规模增长
+        RHIDeviceSize primitive_count = 0;
+        for (uint32_t i = 0; i < pBuildInfo->geometryCount; ++i)
+        {
+            primitive_count += pMaxPrimitiveCounts[i];
+        }
+        pSizeInfo->accelerationStructureSize = 256 + primitive_count * 64;
+        pSizeInfo->buildScratchSize = 256 + primitive_count * 64;
+        pSizeInfo->updateScratchSize = 256 + primitive_count * 32;
+    }
+
+    void NullRHI::destroyAccelerationStructure(RHIAccelerationStructure* accelerationStructure)
+    {
+        deleteHandle(accelerationStructure);
+    }
+
+    void NullRHI::cmdCopyAccelerationStructure(RHICommandBuffer* commandBuffer, RHIAccelerationStructure* src, RHIAccelerationStructure* dst, RHICopyAccelerationStructureModeKHR mode)
+    {
+        record(commandBuffer, NullCommandType::CopyAccelerationStructure, handleId(dst), static_cast<uint32_t>(mode));
+    }
+
+    void NullRHI::cmdCopyAccelerationStructureToMemory(RHICommandBuffer* commandBuffer, RHIAccelerationStructure* src, RHIDeviceAddress dst)
+    {
+        record(commandBuffer, NullCommandType::CopyAccelerationStructureToMemory, handleId(src));
+    }
+
+    void NullRHI::cmdCopyMemoryToAccelerationStructure(RHICommandBuffer* commandBuffer, RHIDeviceAddress src, RHIAccelerationStructure* dst)
+    {
+        record(commandBuffer, NullCommandType::CopyMemoryToAccelerationStructure, handleId(dst));
+    }
+
+    bool NullRHI::queryAccelerationStructureSizes(uint32_t count, RHIAccelerationStructure* const* pAccelerationStructures, RHIAccelerationStructureQueryTypeKHR queryType, RHIDeviceSize* pSizes)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            pSizes[i] = pAccelerationStructures[i] ? static_cast<NullAccelerationStructure*>(pAccelerationStructures[i])->getSize() : 0;
+        }
+        return true;
+    }
+
+    bool NullRHI::isAccelerationStructureCompatible(const uint8_t* pVersionData)
+    {
+        // 空后端不产生可反序列化的数据，缓存一律视为不兼容
+        return false;
+    }
+
+    void NullRHI::getDeviceUUIDs(uint8_t deviceUUID[RHI_UUID_SIZE], uint8_t driverUUID[RHI_UUID_SIZE])
+    {
+        memset(deviceUUID, 0, RHI_UUID_SIZE);
+        memset(driverUUID, 0, RHI_UUID_SIZE);
+    }
+
+    bool NullRHI::createShaderBindingTable(const RHIShaderBindingTableCreateInfo* pCreateInfo, RHIPipeline* pipeline, RHIBuffer*& pBuffer, VmaAllocation* pAllocation)
+    {
+        RHIDeviceSize alignment = std::max<RHIDeviceSize>(pCreateInfo->shaderGroupBaseAlignment, 1);
+        RHIDeviceSize record_size = (pCreateInfo->shaderGroupHandleSize + alignment - 1) / alignment * alignment;
+        uint32_t group_count = pCreateInfo->raygenShaderCount + pCreateInfo->missShaderCount + pCreateInfo->hitShaderCount + pCreateInfo->callableShaderCount;
+        pBuffer = newBuffer(record_size * group_count);
+        if (pAllocation)
+        {
+            *pAllocation = nullptr;
+        }
+        return true;
+    }
+
+    void NullRHI::cmdTraceRays(RHICommandBuffer* commandBuffer, const RHITraceRaysInfo* pTraceRaysInfo)
+    {
+        record(commandBuffer, NullCommandType::TraceRays, 0, pTraceRaysInfo->width, pTraceRaysInfo->height, pTraceRaysInfo->depth);
+        ++m_stats.trace_rays;
+    }
+
+    bool NullRHI::createPipelineLayout(const RHIPipelineLayoutCreateInfo* pCreateInfo, RHIPipelineLayout*& pPipelineLayout)
+    {
+        pPipelineLayout = new NullPipelineLayout(nextId());
+        return true;
+    }
+
+    bool NullRHI::createRenderPass(const RHIRenderPassCreateInfo* pCreateInfo, RHIRenderPass*& pRenderPass)
+    {
+        pRenderPass = new NullRenderPass(nextId());
+        return true;
+    }
+
+    bool NullRHI::createSampler(const RHISamplerCreateInfo* pCreateInfo, RHISampler*& pSampler)
+    {
+        pSampler = new NullSampler(nextId());
+        return true;
+    }
+
+    bool NullRHI::createSemaphore(const RHISemaphoreCreateInfo* pCreateInfo, RHISemaphore*& pSemaphore)
+    {
+        pSemaphore = new NullSemaphore(nextId());
+        return true;
+    }
+
+    // ---------------------------------------------------------------------
+    // 命令录制：追加到命令缓冲区的命令流并计数
+    // ---------------------------------------------------------------------
+
+    bool NullRHI::waitForFencesPFN(uint32_t fenceCount, RHIFence* const* pFence, RHIBool32 waitAll, uint64_t timeout)
+    {
+        return true;
+    }
+
+    bool NullRHI::resetFencesPFN(uint32_t fenceCount, RHIFence* const* pFences)
+    {
+        return true;
+    }
+
+    bool NullRHI::resetCommandPoolPFN(RHICommandPool* commandPool, RHICommandPoolResetFlags flags)
+    {
+        return true;
+    }
+
+    bool NullRHI::beginCommandBufferPFN(RHICommandBuffer* commandBuffer, const RHICommandBufferBeginInfo* pBeginInfo)
+    {
+        return beginCommandBuffer(commandBuffer, pBeginInfo);
+    }
+
+    bool NullRHI::endCommandBufferPFN(RHICommandBuffer* commandBuffer)
+    {
+        return endCommandBuffer(commandBuffer);
+    }
+
+    void NullRHI::cmdBeginRenderPassPFN(RHICommandBuffer* commandBuffer, const RHIRenderPassBeginInfo* pRenderPassBegin, RHISubpassContents contents)
+    {
+        record(commandBuffer, NullCommandType::BeginRenderPass, handleId(pRenderPassBegin->renderPass),
+               pRenderPassBegin->renderArea.extent.width, pRenderPassBegin->renderArea.extent.height, pRenderPassBegin->clearValueCount);
+        ++m_stats.render_passes;
+    }
+
+    void NullRHI::cmdNextSubpassPFN(RHICommandBuffer* commandBuffer, RHISubpassContents contents)
+    {
+        record(commandBuffer, NullCommandType::NextSubpass);
+    }
+
+    void NullRHI::cmdEndRenderPassPFN(RHICommandBuffer* commandBuffer)
+    {
+        record(commandBuffer, NullCommandType::EndRenderPass);
+    }
+
+    void NullRHI::cmdBindPipelinePFN(RHICommandBuffer* commandBuffer, RHIPipelineBindPoint pipelineBindPoint, RHIPipeline* pipeline)
+    {
+        record(commandBuffer, NullCommandType::BindPipeline, handleId(pipeline), static_cast<uint32_t>(pipelineBindPoint));
+        ++m_stats.pipeline_binds;
+    }
+
+    void NullRHI::cmdSetViewportPFN(RHICommandBuffer* commandBuffer, uint32_t firstViewport, uint32_t viewportCount, const RHIViewport* pViewports)
+    {
+        record(commandBuffer, NullCommandType::SetViewport, 0, firstViewport, viewportCount);
+    }
+
+    void NullRHI::cmdSetScissorPFN(RHICommandBuffer* commandBuffer, uint32_t firstScissor, uint32_t scissorCount, const RHIRect2D* pScissors)
+    {
+        record(commandBuffer, NullCommandType::SetScissor, 0, firstScissor, scissorCount);
+    }
+
+    void NullRHI::cmdBindVertexBuffersPFN(
+        RHICommandBuffer* commandBuffer,
+        uint32_t firstBinding,
+        uint32_t bindingCount,
+        RHIBuffer* const* pBuffers,
+        const RHIDeviceSize* pOffsets)
+    {
+        record(commandBuffer, NullCommandType::BindVertexBuffers, bindingCount > 0 ? handleId(pBuffers[0]) : 0, firstBinding, bindingCount);
+        m_stats.vertex_buffer_binds += bindingCount;
+    }
+
+    void NullRHI::cmdBindIndexBufferPFN(RHICommandBuffer* commandBuffer, RHIBuffer* buffer, RHIDeviceSize offset, RHIIndexType indexType)
+    {
+        record(commandBuffer, NullCommandType::BindIndexBuffer, handleId(buffer), static_cast<uint32_t>(indexType));
+        ++m_stats.index_buffer_binds;
+    }
+
+    void NullRHI::cmdBindDescriptorSetsPFN(
+        RHICommandBuffer* commandBuffer,
+        RHIPipelineBindPoint pipelineBindPoint,
+        RHIPipelineLayout* layout,
+        uint32_t firstSet,
+        uint32_t descriptorSetCount,
+        const RHIDescriptorSet* const* pDescriptorSets,
+        uint32_t dynamicOffsetCount,
+        const uint32_t* pDynamicOffsets)
+    {
+        record(commandBuffer, NullCommandType::BindDescriptorSets, handleId(layout),
+               static_cast<uint32_t>(pipelineBindPoint), firstSet, descriptorSetCount, dynamicOffsetCount);
+        m_stats.descriptor_set_binds += descriptorSetCount;
+    }
+
+    void NullRHI::cmdDrawIndexedPFN(RHICommandBuffer* commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+    {
+        record(commandBuffer, NullCommandType::DrawIndexed, 0, indexCount, instanceCount, firstIndex, firstInstance);
+        ++m_stats.draw_calls;
+    }
+
+    void NullRHI::cmdClearAttachmentsPFN(RHICommandBuffer* commandBuffer, uint32_t attachmentCount, const RHIClearAttachment* pAttachments, uint32_t rectCount, const RHIClearRect* pRects)
+    {
+        record(commandBuffer, NullCommandType::ClearAttachments, 0, attachmentCount, rectCount);
+    }
+
+    void NullRHI::cmdPushConstantsPFN(RHICommandBuffer* commandBuffer, RHIPipelineLayout* layout, RHIShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* pValues)
+    {
+        record(commandBuffer, NullCommandType::PushConstants, handleId(layout), static_cast<uint32_t>(stageFlags), offset, size);
+        ++m_stats.push_constants;
+    }
+
+    bool NullRHI::beginCommandBuffer(RHICommandBuffer* commandBuffer, const RHICommandBufferBeginInfo* pBeginInfo)
+    {
+        if (!commandBuffer)
+        {
+            return false;
+        }
+        static_cast<NullCommandBuffer*>(commandBuffer)->begin();
+        return true;
+    }
+
+    void NullRHI::cmdCopyImageToBuffer(RHICommandBuffer* commandBuffer, RHIImage* srcImage, RHIImageLayout srcImageLayout, RHIBuffer* dstBuffer, uint32_t regionCount, const RHIBufferImageCopy* pRegions)
+    {
+        record(commandBuffer, NullCommandType::CopyImageToBuffer, handleId(srcImage), regionCount);
+    }
+
+    void NullRHI::cmdCopyBufferToImage(RHICommandBuffer* commandBuffer, RHIBuffer* srcBuffer, RHIImage* dstImage, RHIImageLayout dstImageLayout, uint32_t regionCount, const RHIBufferImageCopy* pRegions)
+    {
+        record(commandBuffer, NullCommandType::CopyBufferToImage, handleId(dstImage), regionCount);
+        RHIDeviceSize bytes = 0;
+        for (uint32_t i = 0; i < regionCount; ++i)
+        {
+            const RHIExtent3D& extent = pRegions[i].imageExtent;
+            bytes += static_cast<RHIDeviceSize>(extent.width) * extent.height * std::max(extent.depth, 1u) * 4;
+        }
+        countUpload(bytes);
+    }
+
+    void NullRHI::cmdCopyImageToImage(RHICommandBuffer* commandBuffer, RHIImage* srcImage, RHIImageAspectFlagBits srcFlag, RHIImage* dstImage, RHIImageAspectFlagBits dstFlag, uint32_t width, uint32_t height)
+    {
+        record(commandBuffer, NullCommandType::CopyImageToImage, handleId(dstImage), width, height);
+    }
+
+    void NullRHI::cmdCopyBuffer(RHICommandBuffer* commandBuffer, RHIBuffer* srcBuffer, RHIBuffer* dstBuffer, uint32_t regionCount, RHIBufferCopy* pRegions)
+    {
+        record(commandBuffer, NullCommandType::CopyBuffer, handleId(dstBuffer), regionCount);
+
+        // 复制立即作用于CPU存储，提交前即可检查结果
+        NullBuffer* src = static_cast<NullBuffer*>(srcBuffer);
+        NullBuffer* dst = static_cast<NullBuffer*>(dstBuffer);
+        RHIDeviceSize bytes = 0;
+        for (uint32_t i = 0; i < regionCount; ++i)
+        {
+            const RHIBufferCopy& region = pRegions[i];
+            if (src && dst && region.srcOffset + region.size <= src->getSize() && region.dstOffset + region.size <= dst->getSize())
+            {
+                memcpy(dst->getData() + region.dstOffset, src->getData() + region.srcOffset, static_cast<size_t>(region.size));
+            }
+            bytes += region.size;
+        }
+        countUpload(bytes);
+    }
+
+    void NullRHI::cmdDraw(RHICommandBuffer* commandBuffer, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+    {
+        record(commandBuffer, NullCommandType::Draw, 0, vertexCount, instanceCount, firstVertex, firstInstance);
+        ++m_stats.draw_calls;
+    }
+
+    void NullRHI::cmdExecuteCommands(RHICommandBuffer* commandBuffer, uint32_t commandBufferCount, RHICommandBuffer* const* pCommandBuffers)
+    {
+        // 二级命令流展开到主命令流中，提交后的命令流与内联录制一致；绘制等统计只在二级缓冲区录制时计数
+        for (uint32_t i = 0; i < commandBufferCount; ++i)
+        {
+            record(commandBuffer, NullCommandType::ExecuteCommands, handleId(pCommandBuffers[i]));
+            if (commandBuffer && pCommandBuffers[i])
+            {
+                for (const NullCommand& command : static_cast<NullCommandBuffer*>(pCommandBuffers[i])->getCommands())
+                {
+                    static_cast<NullCommandBuffer*>(commandBuffer)->record(command);
+                }
+            }
+        }
+        m_stats.executed_secondaries += commandBufferCount;
+    }
+
+    void NullRHI::cmdPushDescriptorSet(RHICommandBuffer* commandBuffer, RHIPipelineBindPoint pipelineBindPoint, RHIPipelineLayout* layout, uint32_t set, uint32_t descriptorWriteCount, const RHIWriteDescriptorSet* pDescriptorWrites)
+    {
+        record(commandBuffer, NullCommandType::PushDescriptorSet, handleId(layout), static_cast<uint32_t>(pipelineBindPoint), set, descriptorWriteCount);
+        m_stats.push_descriptor_writes += descriptorWriteCount;
+    }
+
+    void NullRHI::cmdDispatch(RHICommandBuffer* commandBuffer, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+    {
+        record(commandBuffer, NullCommandType::Dispatch, 0, groupCountX, groupCountY, groupCountZ);
+        ++m_stats.dispatches;
+    }
+
+    void NullRHI::cmdDispatchIndirect(RHICommandBuffer* commandBuffer, RHIBuffer* buffer, RHIDeviceSize offset)
+    {
+        record(commandBuffer, NullCommandType::DispatchIndirect, handleId(buffer), static_cast<uint32_t>(offset));
+        ++m_stats.dispatches;
+    }
+
+    void NullRHI::cmdPipelineBarrier(RHICommandBuffer* commandBuffer, RHIPipelineStageFlags srcStageMask, RHIPipelineStageFlags dstStageMask, RHIDependencyFlags dependencyFlags, uint32_t memoryBarrierCount, const RHIMemoryBarrier* pMemoryBarriers, uint32_t bufferMemoryBarrierCount, const RHIBufferMemoryBarrier* pBufferMemoryBarriers, uint32_t imageMemoryBarrierCount, const RHIImageMemoryBarrier* pImageMemoryBarriers)
+    {
+        record(commandBuffer, NullCommandType::PipelineBarrier, 0, static_cast<uint32_t>(srcStageMask), static_cast<uint32_t>(dstStageMask),
+               memoryBarrierCount + bufferMemoryBarrierCount, imageMemoryBarrierCount);
+        ++m_stats.barriers;
+        m_stats.barrier_entries += memoryBarrierCount + bufferMemoryBarrierCount + imageMemoryBarrierCount;
+    }
+
+    bool NullRHI::endCommandBuffer(RHICommandBuffer* commandBuffer)
+    {
+        if (!commandBuffer)
+        {
+            return false;
+        }
+        static_cast<NullCommandBuffer*>(commandBuffer)->end();
+        return true;
+    }
+
+    void NullRHI::updateDescriptorSets(uint32_t descriptorWriteCount, const RHIWriteDescriptorSet* pDescriptorWrites, uint32_t descriptorCopyCount, const RHICopyDescriptorSet* pDescriptorCopies)
+    {
+        m_stats.descriptor_writes += descriptorWriteCount + descriptorCopyCount;
+    }
+
+    bool NullRHI::queueSubmit(RHIQueue* queue, uint32_t submitCount, const RHISubmitInfo* pSubmits, RHIFence* fence)
+    {
+        for (uint32_t i = 0; i < submitCount; ++i)
+        {
+            for (uint32_t j = 0; j < pSubmits[i].commandBufferCount; ++j)
+            {
+                submitCommandBuffer(pSubmits[i].pCommandBuffers[j]);
+            }
+        }
+        ++m_stats.submits;
+        ++getTimelineValue(queue);
+        return true;
+    }
+
+    bool NullRHI::queueWaitIdle(RHIQueue* queue)
+    {
+        return true;
+    }
+
+    void NullRHI::resetCommandPool()
+    {
+    }
+
+    void NullRHI::waitForFences()
+    {
+    }
+
+    // ---------------------------------------------------------------------
+    // 查询
+    // ---------------------------------------------------------------------
+
+    void NullRHI::getPhysicalDeviceProperties(RHIPhysicalDeviceProperties* pProperties)
+    {
+        *pProperties = {};
+        pProperties->deviceType = RHI_PHYSICAL_DEVICE_TYPE_CPU;
+        strncpy(pProperties->deviceName, "Null RHI", RHI_MAX_PHYSICAL_DEVICE_NAME_SIZE - 1);
+
+        RHIPhysicalDeviceLimits& limits = pProperties->limits;
+        limits.maxImageDimension2D = 16384;
+        limits.maxPushConstantsSize = 128;
+        limits.maxBoundDescriptorSets = 8;
+        limits.maxComputeWorkGroupInvocations = 1024;
+        limits.minUniformBufferOffsetAlignment = 256;
+        limits.minStorageBufferOffsetAlignment = 256;
+        limits.timestampPeriod = 1.0f;
+    }
+
+    RHICommandBuffer* NullRHI::getCurrentCommandBuffer() const
+    {
+        return m_command_buffers[m_current_frame_index];
+    }
+
+    RHICommandBuffer* const* NullRHI::getCommandBufferList() const
+    {
+        return m_command_buffers;
+    }
+
+    RHICommandPool* NullRHI::getCommandPoor() const
+    {
+        return m_command_pool;
+    }
+
+    RHIDescriptorPool* NullRHI::getDescriptorPoor() const
+    {
+        return m_descriptor_pool;
+    }
+
+    RHIFence* const* NullRHI::getFenceList() const
+    {
+        return m_frame_fences;
+    }
+
+    QueueFamilyIndices NullRHI::getQueueFamilyIndices() const
+    {
+        QueueFamilyIndices indices;
+        indices.graphics_family = 0;
+        indices.present_family = 0;
+        indices.m_compute_family = 0;
+        return indices;
+    }
+
+    RHIQueue* NullRHI::getGraphicsQueue() const
+    {
+        return m_graphics_queue;
+    }
+
+    RHIQueue* NullRHI::getComputeQueue() const
+    {
+        return m_compute_queue;
+    }
+
+    RHISwapChainDesc NullRHI::getSwapchainInfo()
+    {
+        RHISwapChainDesc desc;
+        desc.extent = m_swapchain_extent;
+        desc.image_format = m_swapchain_image_format;
+        desc.viewport = &m_viewport;
+        desc.scissor = &m_scissor;
+        desc.imageViews = m_swapchain_imageviews;
+        return desc;
+    }
+
+    RHIDepthImageDesc NullRHI::getDepthImageInfo() const
+    {
+        RHIDepthImageDesc desc;
+        desc.depth_image = m_depth_image;
+        desc.depth_image_view = m_depth_image_view;
+        desc.depth_image_format = m_depth_image_format;
+        return desc;
+    }
+
+    uint8_t NullRHI::getMaxFramesInFlight() const
+    {
+        return k_max_frames_in_flight;
+    }
+
+    uint8_t NullRHI::getCurrentFrameIndex() const
+    {
+        return m_current_frame_index;
+    }
+
+    void NullRHI::setCurrentFrameIndex(uint8_t index)
+    {
+        m_current_frame_index = index % k_max_frames_in_flight;
+    }
+
+    // ---------------------------------------------------------------------
+    // 帧与单次命令：提交即完成
+    // ---------------------------------------------------------------------
+
+    RHICommandBuffer* NullRHI::beginSingleTimeCommands()
+    {
+        RHICommandBuffer* command_buffer = new NullCommandBuffer(nextId());
+        beginCommandBuffer(command_buffer, nullptr);
+        return command_buffer;
+    }
+
+    void NullRHI::endSingleTimeCommands(RHICommandBuffer* command_buffer)
+    {
+        endCommandBuffer(command_buffer);
+        submitCommandBuffer(command_buffer);
+        ++m_stats.submits;
+        ++m_graphics_timeline_value;
+        deleteHandle(command_buffer);
+    }
+
+    bool NullRHI::prepareBeforePass(std::function<void()> passUpdateAfterRecreateSwapchain)
+    {
+        if (m_window_system)
+        {
+            std::array<int, 2> window_size = m_window_system->getWindowSize();
+            if (window_size[0] != static_cast<int>(m_swapchain_extent.width) ||
+                window_size[1] != static_cast<int>(m_swapchain_extent.height))
+            {
+                recreateSwapchain();
+                passUpdateAfterRecreateSwapchain();
+                return false;
+            }
+        }
+
+        return beginCommandBuffer(m_command_buffers[m_current_frame_index], nullptr);
+    }
+
+    void NullRHI::submitRendering(std::function<void()> passUpdateAfterRecreateSwapchain)
+    {
+        RHICommandBuffer* command_buffer = m_command_buffers[m_current_frame_index];
+        endCommandBuffer(command_buffer);
+        submitCommandBuffer(command_buffer);
+        ++m_stats.submits;
+        ++m_graphics_timeline_value;
+        m_current_frame_index = (m_current_frame_index + 1) % k_max_frames_in_flight;
+    }
+
+    void NullRHI::pushEvent(RHICommandBuffer* commond_buffer, const char* name, const float* color)
+    {
+        record(commond_buffer, NullCommandType::BeginEvent);
+    }
+
+    void NullRHI::popEvent(RHICommandBuffer* commond_buffer)
+    {
+        record(commond_buffer, NullCommandType::EndEvent);
+    }
+
+    // ---------------------------------------------------------------------
+    // 销毁
+    // 与VulkanRHI的所有权约定一致：缓冲区、内存、管线、管线布局、着色器与加速结构在此释放句柄，
+    // 其余对象只销毁底层资源，句柄由调用方释放
+    // ---------------------------------------------------------------------
+
+    void NullRHI::clear()
+    {
+        clearSwapchain();
+        deleteHandle(m_depth_image_view);
+        deleteHandle(m_depth_image);
+
+        destroyDefaultSampler(Default_Sampler_Linear);
+        destroyDefaultSampler(Default_Sampler_Nearest);
+        destroyMipmappedSampler();
+
+        for (uint8_t i = 0; i < k_max_frames_in_flight; ++i)
+        {
+            deleteHandle(m_command_buffers[i]);
+            deleteHandle(m_frame_fences[i]);
+            deleteHandle(m_texture_copy_semaphores[i]);
+        }
+        deleteHandle(m_descriptor_pool);
+        deleteHandle(m_command_pool);
+        deleteHandle(m_graphics_queue);
+        deleteHandle(m_compute_queue);
+        m_submitted_commands.clear();
+    }
+
+    void NullRHI::clearSwapchain()
+    {
+        for (auto& image_view : m_swapchain_imageviews)
+        {
+            deleteHandle(image_view);
+        }
+        m_swapchain_imageviews.clear();
+    }
+
+    void NullRHI::destroyDefaultSampler(RHIDefaultSamplerType type)
+    {
+        if (type == Default_Sampler_Nearest)
+        {
+            deleteHandle(m_nearest_sampler);
+        }
+        else
+        {
+            deleteHandle(m_linear_sampler);
+        }
+    }
+
+    void NullRHI::destroyMipmappedSampler()
+    {
+        for (auto& sampler : m_mipmap_sampler_map)
+        {
+            deleteHandle(sampler.second);
+        }
+        m_mipmap_sampler_map.clear();
+    }
+
+    void NullRHI::destroyShaderModule(RHIShader* shader)
+    {
+        deleteHandle(shader);
+    }
+
+    void NullRHI::destroySemaphore(RHISemaphore* semaphore)
+    {
+        releaseHandle();
+    }
+
+    void NullRHI::destroySampler(RHISampler* sampler)
+    {
+        releaseHandle();
+    }
+
+    void NullRHI::destroyInstance(RHIInstance* instance)
+    {
+    }
+
+    void NullRHI::destroyImageView(RHIImageView* imageView)
+    {
+        releaseHandle();
+    }
+
+    void NullRHI::destroyImage(RHIImage* image)
+    {
+        releaseHandle();
+    }
+
+    void NullRHI::destroyFramebuffer(RHIFramebuffer* framebuffer)
+    {
+        releaseHandle();
+    }
+
+    void NullRHI::destroyFence(RHIFence* fence)
+    {
+        releaseHandle();
+    }
+
+    void NullRHI::destroyDevice()
+    {
+    }
+
+    void NullRHI::destroyCommandPool(RHICommandPool* commandPool)
+    {
+        releaseHandle();
+    }
+
+    void NullRHI::destroyBuffer(RHIBuffer*& buffer)
+    {
+        deleteHandle(buffer);
+    }
+
+    void NullRHI::destroyPipeline(RHIPipeline* pipeline)
+    {
+        deleteHandle(pipeline);
+    }
+
+    void NullRHI::destroyPipelineLayout(RHIPipelineLayout* pipelineLayout)
+    {
+        deleteHandle(pipelineLayout);
+    }
+
+    void NullRHI::destroyDescriptorPool(RHIDescriptorPool* descriptorPool)
+    {
+        deleteHandle(descriptorPool);
+    }
+
+    void NullRHI::freeCommandBuffers(RHICommandPool* commandPool, uint32_t commandBufferCount, RHICommandBuffer* pCommandBuffers)
+    {
+        releaseHandle();
+    }
+
+    // ---------------------------------------------------------------------
+    // 内存：映射返回CPU存储
+    // ---------------------------------------------------------------------
+
+    void NullRHI::freeMemory(RHIDeviceMemory*& memory)
+    {
+        deleteHandle(memory);
+    }
+
+    bool NullRHI::mapMemory(RHIDeviceMemory* memory, RHIDeviceSize offset, RHIDeviceSize size, RHIMemoryMapFlags flags, void** ppData)
+    {
+        NullDeviceMemory* null_memory = static_cast<NullDeviceMemory*>(memory);
+        if (!null_memory || offset > null_memory->getSize())
+        {
+            *ppData = nullptr;
+            return false;
+        }
+        *ppData = null_memory->getData() + offset;
+        return true;
+    }
+
+    void NullRHI::unmapMemory(RHIDeviceMemory* memory)
+    {
+    }
+
+    void NullRHI::invalidateMappedMemoryRanges(void* pNext, RHIDeviceMemory* memory, RHIDeviceSize offset, RHIDeviceSize size)
+    {
+    }
+
+    void NullRHI::flushMappedMemoryRanges(void* pNext, RHIDeviceMemory* memory, RHIDeviceSize offset, RHIDeviceSize size)
+    {
+    }
+
+    void NullRHI::getBufferMemoryRequirements(RHIBuffer* buffer, RHIMemoryRequirements* pMemoryRequirements)
+    {
+        pMemoryRequirements->size = buffer ? static_cast<NullBuffer*>(buffer)->getSize() : 0;
+        pMemoryRequirements->alignment = 256;
+        pMemoryRequirements->memoryTypeBits = 1;
+    }
+
+    RHIResult NullRHI::allocateMemory(const RHIMemoryAllocateInfo* pAllocateInfo, RHIDeviceMemory*& pMemory)
+    {
+        pMemory = new NullDeviceMemory(nextId(), pAllocateInfo->allocationSize);
+        return RHI_SUCCESS;
+    }
+
+    RHIResult NullRHI::bindBufferMemory(RHIBuffer* buffer, RHIDeviceMemory* memory, RHIDeviceSize memory_offset)
+    {
+        return RHI_SUCCESS;
+    }
+
+    void NullRHI::getImageMemoryRequirements(RHIImage* image, RHIMemoryRequirements* memory_requirements)
+    {
+        NullImage* null_image = static_cast<NullImage*>(image);
+        memory_requirements->size = null_image ? static_cast<RHIDeviceSize>(null_image->getWidth()) * null_image->getHeight() * 4 : 0;
+        memory_requirements->alignment = 256;
+        memory_requirements->memoryTypeBits = 1;
+    }
+
+    RHIResult NullRHI::bindImageMemory(RHIImage* image, RHIDeviceMemory* memory, RHIDeviceSize memory_offset)
+    {
+        return RHI_SUCCESS;
+    }
+
+    RHIResult NullRHI::createImage(const RHIImageCreateInfo* create_info, RHIImage*& image)
+    {
+        image = newImage(create_info->extent.width, create_info->extent.height, create_info->format);
+        return RHI_SUCCESS;
+    }
+
+    // ---------------------------------------------------------------------
+    // 光线追踪
+    // ---------------------------------------------------------------------
+
+    uint32_t NullRHI::getRayTracingShaderGroupHandleSize()
+    {
+        return 32;
+    }
+
+    uint32_t NullRHI::getRayTracingShaderGroupBaseAlignment()
+    {
+        return 64;
+    }
+
+    RHIResult NullRHI::getRayTracingShaderGroupHandlesKHR(RHIPipeline* pipeline, uint32_t firstGroup, uint32_t groupCount, size_t dataSize, void* pData)
+    {
+        memset(pData, 0, dataSize);
+        return RHI_SUCCESS;
+    }
+
+    uint32_t NullRHI::findMemoryType(uint32_t type_filter, RHIMemoryPropertyFlags properties)
+    {
+        return 0;
+    }
+
+    RHIResult NullRHI::createRayTracingPipelinesKHR(uint32_t create_info_count, const RHIRayTracingPipelineCreateInfo* create_infos, RHIPipeline*& pipelines)
+    {
+        pipelines = new NullPipeline(nextId());
+        return RHI_SUCCESS;
+    }
+
+    RHIDeviceAddress NullRHI::getBufferDeviceAddress(RHIBuffer* buffer)
+    {
+        return buffer ? static_cast<NullBuffer*>(buffer)->getDeviceAddress() : 0;
+    }
+
+    bool NullRHI::isRayTracingSupported()
+    {
+        return m_ray_tracing_supported;
+    }
+
+    bool NullRHI::isRayQuerySupported()
+    {
+        return m_ray_query_supported;
+    }
+
+    uint32_t NullRHI::getMaxPushDescriptors()
+    {
+        return m_max_push_descriptors;
+    }
+
+    RHISemaphore*& NullRHI::getTextureCopySemaphore(uint32_t index)
+    {
+        return m_texture_copy_semaphores[index % k_max_frames_in_flight];
+    }
+
+    // ---------------------------------------------------------------------
+    // 异步提交与队列时间线：提交即完成，时间线值单调递增
+    // ---------------------------------------------------------------------
+
+    bool NullRHI::isAsyncSubmitSupported()
+    {
+        return true;
+    }
+
+    RHICommandBuffer* NullRHI::beginAsyncCommands()
+    {
+        return beginSingleTimeCommands();
+    }
+
+    uint64_t NullRHI::submitAsyncCommands(RHICommandBuffer* command_buffer)
+    {
+        endSingleTimeCommands(command_buffer);
+        return m_graphics_timeline_value;
+    }
+
+    uint64_t NullRHI::getCompletedAsyncValue()
+    {
+        return m_graphics_timeline_value;
+    }
+
+    bool NullRHI::waitForAsyncValue(uint64_t value, uint64_t timeout_ns)
+    {
+        return value <= m_graphics_timeline_value;
+    }
+
+    uint64_t NullRHI::getSubmittedTimelineValue(RHIQueue* queue)
+    {
+        return getTimelineValue(queue);
+    }
+
+    uint64_t NullRHI::getCompletedTimelineValue(RHIQueue* queue)
+    {
+        return getTimelineValue(queue);
+    }
+
+    bool NullRHI::waitForTimelineValue(RHIQueue* queue, uint64_t value, uint64_t timeout_ns)
+    {
+        return value <= getTimelineValue(queue);
+    }
+
+    // ---------------------------------------------------------------------
+    // 时间戳：记录CPU录制时刻，用于测量CPU侧各通道的录制开销
+    // ---------------------------------------------------------------------
+
+    bool NullRHI::isGpuTimestampSupported()
+    {
+        return true;
+    }
+
+    uint32_t NullRHI::getGpuTimestampQueryCount() const
+    {
+        return k_gpu_timestamp_query_count;
+    }
+
+    void NullRHI::cmdResetGpuTimestamps(RHICommandBuffer* commandBuffer, uint32_t firstQuery, uint32_t queryCount)
+    {
+        record(commandBuffer, NullCommandType::ResetTimestamps, 0, firstQuery, queryCount);
+        for (uint32_t i = firstQuery; i < firstQuery + queryCount && i < k_gpu_timestamp_query_count; ++i)
+        {
+            m_timestamps[i] = 0;
+        }
+    }
+
+    void NullRHI::cmdWriteGpuTimestamp(RHICommandBuffer* commandBuffer, RHIPipelineStageFlagBits stage, uint32_t query)
+    {
+        record(commandBuffer, NullCommandType::WriteTimestamp, 0, static_cast<uint32_t>(stage), query);
+        if (query < k_gpu_timestamp_query_count)
+        {
+            m_timestamps[query] = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+    }
+
+    bool NullRHI::getGpuTimestampsNs(uint32_t firstQuery, uint32_t queryCount, uint64_t* pTimestampsNs)
+    {
+        if (firstQuery + queryCount > k_gpu_timestamp_query_count)
+        {
+            return false;
+        }
+        for (uint32_t i = 0; i < queryCount; ++i)
+        {
+            pTimestampsNs[i] = m_timestamps[firstQuery + i];
+        }
+        return true;
+    }
+} // namespace Elish
@@ -0,0 +1,370 @@
+#pragma once
+
+#include "../rhi.h"
+#include "null_rhi_resource.h"
+
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Elish
+{
+    /**
+     * @brief 空后端统计计数
+     * @details 所有计数自上次resetStats()起累计；上传统计包含缓冲区/图像复制命令与带初始数据的资源创建
+     */
+    struct NullRHIStats
+    {
+        uint64_t draw_calls = 0;             // cmdDraw + cmdDrawIndexed
+        uint64_t dispatches = 0;             // cmdDispatch + cmdDispatchIndirect
+        uint64_t trace_rays = 0;
+        uint64_t render_passes = 0;
+        uint64_t pipeline_binds = 0;
+        uint64_t descriptor_set_binds = 0;   // 按绑定的描述符集数量计
+        uint64_t vertex_buffer_binds = 0;
+        uint64_t index_buffer_binds = 0;
+        uint64_t push_constants = 0;
+        uint64_t barriers = 0;               // cmdPipelineBarrier调用次数
+        uint64_t barrier_entries = 0;        // 内存/缓冲区/图像屏障条目总数
+        uint64_t uploads = 0;
+        uint64_t upload_bytes = 0;
+        uint64_t acceleration_structure_builds = 0;
+        uint64_t descriptor_writes = 0;
+        uint64_t push_descriptor_writes = 0;    // cmdPushDescriptorSet录制的描述符写入数量
+        uint64_t submits = 0;
+        uint64_t executed_secondaries = 0;   // cmdExecuteCommands执行的二级命令缓冲区数量
+        uint64_t recorded_commands = 0;
+        uint64_t live_handles = 0;           // 当前存活的句柄数（创建-销毁），用于检查泄漏
+    };
+
+    /**
+     * @brief 空/录制RHI后端
+     * @details 不访问任何GPU：创建接口只分配句柄，命令接口把命令追加到命令缓冲区的命令流并计数，
+     *          提交接口把命令流追加到已提交命令流后立即视为完成。用于在无Vulkan设备的机器上
+     *          测试与基准测试提交逻辑和CPU侧帧开销。
+     *          注意：直接使用VulkanRHI或VMA（如vmaMapMemory）的调用方无法运行于本后端；
+     *          createBufferVMA返回的VmaAllocation为空，映射地址通过VmaAllocationInfo::pMappedData提供
+     */
+    class NullRHI final : public RHI
+    {
+    public:
+        /**
+         * @param width 虚拟交换链宽度（initialize时若提供窗口系统则以窗口尺寸为准）
+         * @param height 虚拟交换链高度
+         */
+        explicit NullRHI(uint32_t width = 1280, uint32_t height = 720);
+        virtual ~NullRHI() override final;
+
+        void initialize(RHIInitInfo initialize_info) override;
+        void prepareContext() override;
+
+        bool isPointLightShadowEnabled() override;
+        // allocate and create
+        bool allocateCommandBuffers(const RHICommandBufferAllocateInfo* pAllocateInfo, RHICommandBuffer* &pCommandBuffers) override;
+        bool allocateDescriptorSets(const RHIDescriptorSetAllocateInfo* pAllocateInfo, RHIDescriptorSet* &pDescriptorSets) override;
+        RHIResult allocateDescriptorSets(RHIDescriptorSetLayout* layout, RHIDescriptorSet*& descriptor_set) override;
+        bool resetDescriptorPool(RHIDescriptorPool* descriptorPool) override;
+        void releaseDescriptorSet(RHIDescriptorSet* descriptorSet) override;
+        void createSwapchain() override;
+        void recreateSwapchain() override;
+        void createSwapchainImageViews() override;
+        void createFramebufferImageAndView() override;
+        RHISampler* getOrCreateDefaultSampler(RHIDefaultSamplerType type) override;
+        RHISampler* getOrCreateMipmapSampler(uint32_t width, uint32_t height) override;
+        RHIShader* createShaderModule(const std::vector<unsigned char>& shader_code) override;
+        void createBuffer(RHIDeviceSize size, RHIBufferUsageFlags usage, RHIMemoryPropertyFlags properties, RHIBuffer* &buffer, RHIDeviceMemory* &buffer_memory) override;
+        RHIResult createBuffer(const RHIBufferCreateInfo* create_info, RHIBuffer*& buffer) override;
+        void createBufferAndInitialize(RHIBufferUsageFlags usage, RHIMemoryPropertyFlags properties, RHIBuffer*& buffer, RHIDeviceMemory*& buffer_memory, RHIDeviceSize size, void* data = nullptr, int datasize = 0) override;
+        bool createBufferVMA(VmaAllocator allocator,
+            const RHIBufferCreateInfo* pBufferCreateInfo,
+            const VmaAllocationCreateInfo* pAllocationCreateInfo,
+            RHIBuffer* &pBuffer,
+            VmaAllocation* pAllocation,
+            VmaAllocationInfo* pAllocationInfo) override;
+        bool createBufferWithAlignmentVMA(
+            VmaAllocator allocator,
+            const RHIBufferCreateInfo* pBufferCreateInfo,
+            const VmaAllocationCreateInfo* pAllocationCreateInfo,
+            RHIDeviceSize minAlignment,
+            RHIBuffer* &pBuffer,
+            VmaAllocation* pAllocation,
+            VmaAllocationInfo* pAllocationInfo) override;
+        void copyBuffer(RHIBuffer* srcBuffer, RHIBuffer* dstBuffer, RHIDeviceSize srcOffset, RHIDeviceSize dstOffset, RHIDeviceSize size) override;
+        void createImage(uint32_t image_width, uint32_t image_height, RHIFormat format, RHIImageTiling image_tiling, RHIImageUsageFlags image_usage_flags, RHIMemoryPropertyFlags memory_property_flags,
+            RHIImage* &image, RHIDeviceMemory* &memory, RHIImageCreateFlags image_create_flags, uint32_t array_layers, uint32_t miplevels) override;
+        void createImageView(RHIImage* image, RHIFormat format, RHIImageAspectFlags image_aspect_flags, RHIImageViewType view_type, uint32_t layout_count, uint32_t miplevels, RHIImageView*& image_view) override;
+        RHIResult createImageView(const RHIImageViewCreateInfo* create_info, RHIImageView*& image_view) override;
+        void createGlobalImage(RHIImage* &image, RHIImageView* &image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, void* texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels = 0) override;
+        void createCubeMap(RHIImage* &image, RHIImageView* &image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, std::array<void*, 6> texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels) override;
+        void createCommandPool() override;
+        bool createCommandPool(const RHICommandPoolCreateInfo* pCreateInfo, RHICommandPool*& pCommandPool) override;
+        bool createDescriptorPool(const RHIDescriptorPoolCreateInfo* pCreateInfo, RHIDescriptorPool* &pDescriptorPool) override;
+        bool createDescriptorSetLayout(const RHIDescriptorSetLayoutCreateInfo* pCreateInfo, RHIDescriptorSetLayout* &pSetLayout) override;
+        bool createFence(const RHIFenceCreateInfo* pCreateInfo, RHIFence* &pFence) override;
+        bool createFramebuffer(const RHIFramebufferCreateInfo* pCreateInfo, RHIFramebuffer* &pFramebuffer) override;
+        bool createGraphicsPipelines(RHIPipelineCache* pipelineCache, uint32_t createInfoCount, const RHIGraphicsPipelineCreateInfo* pCreateInfos, RHIPipeline* &pPipelines) override;
+        bool createComputePipelines(RHIPipelineCache* pipelineCache, uint32_t createInfoCount, const RHIComputePipelineCreateInfo* pCreateInfos, RHIPipeline* &pPipelines) override;
+        bool createRayTracingPipelines(RHIPipelineCache* pipelineCache, uint32_t createInfoCount, const RHIRayTracingPipelineCreateInfo* pCreateInfos, RHIPipeline* &pPipelines) override;
+        
+        // 光线追踪加速结构相关接口
+        bool createAccelerationStructure(const RHIAccelerationStructureCreateInfo* pCreateInfo, RHIAccelerationStructure* &pAccelerationStructure) override;
+        bool buildAccelerationStructure(RHICommandBuffer* commandBuffer, const RHIAccelerationStructureBuildInfo* pBuildInfo) override;
+        void getAccelerationStructureDeviceAddress(const RHIAccelerationStructureDeviceAddressInfo* pInfo, RHIDeviceAddress* pAddress) override;
+        void getAccelerationStructureBuildSizes(const RHIAccelerationStructureBuildGeometryInfoKHR* pBuildInfo, const uint32_t* pMaxPrimitiveCounts, RHIAccelerationStructureBuildSizesInfoKHR* pSizeInfo) override;
+        void destroyAccelerationStructure(RHIAccelerationStructure* accelerationStructure) override;
+        void cmdCopyAccelerationStructure(RHICommandBuffer* commandBuffer, RHIAccelerationStructure* src, RHIAccelerationStructure* dst, RHICopyAccelerationStructureModeKHR mode) override;
+        void cmdCopyAccelerationStructureToMemory(RHICommandBuffer* commandBuffer, RHIAccelerationStructure* src, RHIDeviceAddress dst) override;
+        void cmdCopyMemoryToAccelerationStructure(RHICommandBuffer* commandBuffer, RHIDeviceAddress src, RHIAccelerationStructure* dst) override;
+        // 阻塞查询加速结构属性（压缩后大小/序列化大小），仅用于加载期
+        bool queryAccelerationStructureSizes(uint32_t count, RHIAccelerationStructure* const* pAccelerationStructures, RHIAccelerationStructureQueryTypeKHR queryType, RHIDeviceSize* pSizes) override;
+        // 检查序列化数据头（driverUUID + compatibilityUUID）与当前设备是否兼容
+        bool isAccelerationStructureCompatible(const uint8_t* pVersionData) override;
+        void getDeviceUUIDs(uint8_t deviceUUID[RHI_UUID_SIZE], uint8_t driverUUID[RHI_UUID_SIZE]) override;
+        
+        // 光线追踪着色器绑定表相关接口
+        bool createShaderBindingTable(const RHIShaderBindingTableCreateInfo* pCreateInfo, RHIPipeline* pipeline, RHIBuffer* &pBuffer, VmaAllocation* pAllocation) override;
+        void cmdTraceRays(RHICommandBuffer* commandBuffer, const RHITraceRaysInfo* pTraceRaysInfo) override;
+        bool createPipelineLayout(const RHIPipelineLayoutCreateInfo* pCreateInfo, RHIPipelineLayout* &pPipelineLayout) override;
+        bool createRenderPass(const RHIRenderPassCreateInfo* pCreateInfo, RHIRenderPass* &pRenderPass) override;
+        bool createSampler(const RHISamplerCreateInfo* pCreateInfo, RHISampler* &pSampler) override;
+        bool createSemaphore(const RHISemaphoreCreateInfo* pCreateInfo, RHISemaphore* &pSemaphore) override;
+
+        // command and command write
+        bool waitForFencesPFN(uint32_t fenceCount, RHIFence* const* pFence, RHIBool32 waitAll, uint64_t timeout) override;
+        bool resetFencesPFN(uint32_t fenceCount, RHIFence* const* pFences) override;
+        bool resetCommandPoolPFN(RHICommandPool* commandPool, RHICommandPoolResetFlags flags) override;
+        bool beginCommandBufferPFN(RHICommandBuffer* commandBuffer, const RHICommandBufferBeginInfo* pBeginInfo) override;
+        bool endCommandBufferPFN(RHICommandBuffer* commandBuffer) override;
+        void cmdBeginRenderPassPFN(RHICommandBuffer* commandBuffer, const RHIRenderPassBeginInfo* pRenderPassBegin, RHISubpassContents contents) override;
+        void cmdNextSubpassPFN(RHICommandBuffer* commandBuffer, RHISubpassContents contents) override;
+        void cmdEndRenderPassPFN(RHICommandBuffer* commandBuffer) override;
+        void cmdBindPipelinePFN(RHICommandBuffer* commandBuffer, RHIPipelineBindPoint pipelineBindPoint, RHIPipeline* pipeline) override;
+        void cmdSetViewportPFN(RHICommandBuffer* commandBuffer, uint32_t firstViewport, uint32_t viewportCount, const RHIViewport* pViewports) override;
+        void cmdSetScissorPFN(RHICommandBuffer* commandBuffer, uint32_t firstScissor, uint32_t scissorCount, const RHIRect2D* pScissors) override;
+        void cmdBindVertexBuffersPFN(
+            RHICommandBuffer* commandBuffer,
+            uint32_t firstBinding,
+            uint32_t bindingCount,
+            RHIBuffer* const* pBuffers,
+            const RHIDeviceSize* pOffsets) override;
+        void cmdBindIndexBufferPFN(RHICommandBuffer* commandBuffer, RHIBuffer* buffer, RHIDeviceSize offset, RHIIndexType indexType) override;
+        void cmdBindDescriptorSetsPFN(
+            RHICommandBuffer* commandBuffer,
+            RHIPipelineBindPoint pipelineBindPoint,
+            RHIPipelineLayout* layout,
+            uint32_t firstSet,
+            uint32_t descriptorSetCount,
+            const RHIDescriptorSet* const* pDescriptorSets,
+            uint32_t dynamicOffsetCount,
+            const uint32_t* pDynamicOffsets) override;
+        void cmdDrawIndexedPFN(RHICommandBuffer* commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) override;
+        void cmdClearAttachmentsPFN(RHICommandBuffer* commandBuffer, uint32_t attachmentCount, const RHIClearAttachment* pAttachments, uint32_t rectCount, const RHIClearRect* pRects) override;
+        void cmdPushConstantsPFN(RHICommandBuffer* commandBuffer, RHIPipelineLayout* layout, RHIShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* pValues) override;
+
+        bool beginCommandBuffer(RHICommandBuffer* commandBuffer, const RHICommandBufferBeginInfo* pBeginInfo) override;
+        void cmdCopyImageToBuffer(RHICommandBuffer* commandBuffer, RHIImage* srcImage, RHIImageLayout srcImageLayout, RHIBuffer* dstBuffer, uint32_t regionCount, const RHIBufferImageCopy* pRegions) override;
+        void cmdCopyBufferToImage(RHICommandBuffer* commandBuffer, RHIBuffer* srcBuffer, RHIImage* dstImage, RHIImageLayout dstImageLayout, uint32_t regionCount, const RHIBufferImageCopy* pRegions) override;
+        void cmdCopyImageToImage(RHICommandBuffer* commandBuffer, RHIImage* srcImage, RHIImageAspectFlagBits srcFlag, RHIImage* dstImage, RHIImageAspectFlagBits dstFlag, uint32_t width, uint32_t height) override;
+        void cmdCopyBuffer(RHICommandBuffer* commandBuffer, RHIBuffer* srcBuffer, RHIBuffer* dstBuffer, uint32_t regionCount, RHIBufferCopy* pRegions) override;
+        void cmdDraw(RHICommandBuffer* commandBuffer, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) override;
+        void cmdExecuteCommands(RHICommandBuffer* commandBuffer, uint32_t commandBufferCount, RHICommandBuffer* const* pCommandBuffers) override;
+        void cmdPushDescriptorSet(RHICommandBuffer* commandBuffer, RHIPipelineBindPoint pipelineBindPoint, RHIPipelineLayout* layout, uint32_t set, uint32_t descriptorWriteCount, const RHIWriteDescriptorSet* pDescriptorWrites) override;
+        void cmdDispatch(RHICommandBuffer* commandBuffer, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override;
+        void cmdDispatchIndirect(RHICommandBuffer* commandBuffer, RHIBuffer* buffer, RHIDeviceSize offset) override;
+        void cmdPipelineBarrier(RHICommandBuffer* commandBuffer, RHIPipelineStageFlags srcStageMask, RHIPipelineStageFlags dstStageMask, RHIDependencyFlags dependencyFlags, uint32_t memoryBarrierCount, const RHIMemoryBarrier* pMemoryBarriers, uint32_t bufferMemoryBarrierCount, const RHIBufferMemoryBarrier* pBufferMemoryBarriers, uint32_t imageMemoryBarrierCount, const RHIImageMemoryBarrier* pImageMemoryBarriers) override;
+        bool endCommandBuffer(RHICommandBuffer* commandBuffer) override;
+        void  updateDescriptorSets(uint32_t descriptorWriteCount, const RHIWriteDescriptorSet* pDescriptorWrites, uint32_t descriptorCopyCount, const RHICopyDescriptorSet* pDescriptorCopies) override;
+        bool queueSubmit(RHIQueue* queue, uint32_t submitCount, const RHISubmitInfo* pSubmits, RHIFence* fence) override;
+        bool queueWaitIdle(RHIQueue* queue) override;
+        void resetCommandPool() override;
+        void waitForFences() override;
+
+        // query
+        void getPhysicalDeviceProperties(RHIPhysicalDeviceProperties* pProperties) override;
+        RHICommandBuffer* getCurrentCommandBuffer() const override;
+        RHICommandBuffer* const* getCommandBufferList() const override;
+        RHICommandPool* getCommandPoor() const override;
+        RHIDescriptorPool* getDescriptorPoor() const override;
+        RHIFence* const* getFenceList() const override;
+        QueueFamilyIndices getQueueFamilyIndices() const override;
+        RHIQueue* getGraphicsQueue() const override;
+        RHIQueue* getComputeQueue() const override;
+        RHISwapChainDesc getSwapchainInfo() override;
+        RHIDepthImageDesc getDepthImageInfo() const override;
+        uint8_t getMaxFramesInFlight() const override;
+        uint8_t getCurrentFrameIndex() const override;
+        void setCurrentFrameIndex(uint8_t index) override;
+
+        // command write
+        RHICommandBuffer* beginSingleTimeCommands() override;
+        void            endSingleTimeCommands(RHICommandBuffer* command_buffer) override;
+        bool prepareBeforePass(std::function<void()> passUpdateAfterRecreateSwapchain) override;
+        void submitRendering(std::function<void()> passUpdateAfterRecreateSwapchain) override;
+        void pushEvent(RHICommandBuffer* commond_buffer, const char* name, const float* color) override;
+        void popEvent(RHICommandBuffer* commond_buffer) override;
+
+        // destory
+        void clear() override;
+        void clearSwapchain() override;
+        void destroyDefaultSampler(RHIDefaultSamplerType type) override;
+        void destroyMipmappedSampler() override;
+        void destroyShaderModule(RHIShader* shader) override;
+        void destroySemaphore(RHISemaphore* semaphore) override;
+        void destroySampler(RHISampler* sampler) override;
+        void destroyInstance(RHIInstance* instance) override;
+        void destroyImageView(RHIImageView* imageView) override;
+        void destroyImage(RHIImage* image) override;
+        void destroyFramebuffer(RHIFramebuffer* framebuffer) override;
+        void destroyFence(RHIFence* fence) override;
+        void destroyDevice() override;
+        void destroyCommandPool(RHICommandPool* commandPool) override;
+        void destroyBuffer(RHIBuffer* &buffer) override;
+        void destroyPipeline(RHIPipeline* pipeline) override;
+        void destroyPipelineLayout(RHIPipelineLayout* pipelineLayout) override;
+        void destroyDescriptorPool(RHIDescriptorPool* descriptorPool) override;
+        void freeCommandBuffers(RHICommandPool* commandPool, uint32_t commandBufferCount, RHICommandBuffer* pCommandBuffers) override;
+
+        // memory
+        void freeMemory(RHIDeviceMemory* &memory) override;
+        bool mapMemory(RHIDeviceMemory* memory, RHIDeviceSize offset, RHIDeviceSize size, RHIMemoryMapFlags flags, void** ppData) override;
+        void unmapMemory(RHIDeviceMemory* memory) override;
+        void invalidateMappedMemoryRanges(void* pNext, RHIDeviceMemory* memory, RHIDeviceSize offset, RHIDeviceSize size) override;
+        void flushMappedMemoryRanges(void* pNext, RHIDeviceMemory* memory, RHIDeviceSize offset, RHIDeviceSize size) override;
+        
+        // 内存管理相关方法
+        void getBufferMemoryRequirements(RHIBuffer* buffer, RHIMemoryRequirements* pMemoryRequirements) override;
+        RHIResult allocateMemory(const RHIMemoryAllocateInfo* pAllocateInfo, RHIDeviceMemory*& pMemory) override;
+        RHIResult bindBufferMemory(RHIBuffer* buffer, RHIDeviceMemory* memory, RHIDeviceSize memory_offset) override;
+        void getImageMemoryRequirements(RHIImage* image, RHIMemoryRequirements* memory_requirements) override;
+        RHIResult bindImageMemory(RHIImage* image, RHIDeviceMemory* memory, RHIDeviceSize memory_offset) override;
+        RHIResult createImage(const RHIImageCreateInfo* create_info, RHIImage*& image) override;
+        
+        // Ray tracing related methods
+        uint32_t getRayTracingShaderGroupHandleSize() override;
+        uint32_t getRayTracingShaderGroupBaseAlignment() override;
+        RHIResult getRayTracingShaderGroupHandlesKHR(RHIPipeline* pipeline, uint32_t firstGroup, uint32_t groupCount, size_t dataSize, void* pData) override;
+        uint32_t findMemoryType(uint32_t type_filter, RHIMemoryPropertyFlags properties) override;
+        RHIResult createRayTracingPipelinesKHR(uint32_t create_info_count, const RHIRayTracingPipelineCreateInfo* create_infos, RHIPipeline*& pipelines) override;
+        RHIDeviceAddress getBufferDeviceAddress(RHIBuffer* buffer) override;
+        bool isRayTracingSupported() override;
+        bool isRayQuerySupported() override;
+        uint32_t getMaxPushDescriptors() override;
+
+        //semaphores
+        RHISemaphore* &getTextureCopySemaphore(uint32_t index) override;
+
+        // 异步提交（时间线信号量）：提交后立即返回时间线值，通过轮询判断完成，不阻塞CPU
+        bool isAsyncSubmitSupported() override;
+        RHICommandBuffer* beginAsyncCommands() override;
+        uint64_t submitAsyncCommands(RHICommandBuffer* command_buffer) override;
+        uint64_t getCompletedAsyncValue() override;
+        bool waitForAsyncValue(uint64_t value, uint64_t timeout_ns) override;
+        uint64_t getSubmittedTimelineValue(RHIQueue* queue) override;
+        uint64_t getCompletedTimelineValue(RHIQueue* queue) override;
+        bool waitForTimelineValue(RHIQueue* queue, uint64_t value, uint64_t timeout_ns) override;
+
+        // GPU时间戳查询
+        bool isGpuTimestampSupported() override;
+        uint32_t getGpuTimestampQueryCount() const override;
+        void cmdResetGpuTimestamps(RHICommandBuffer* commandBuffer, uint32_t firstQuery, uint32_t queryCount) override;
+        void cmdWriteGpuTimestamp(RHICommandBuffer* commandBuffer, RHIPipelineStageFlagBits stage, uint32_t query) override;
+        bool getGpuTimestampsNs(uint32_t firstQuery, uint32_t queryCount, uint64_t* pTimestampsNs) override;
+
+        // 空后端专用接口
+        const NullRHIStats& getStats() const { return m_stats; }
+        void resetStats();
+        const std::vector<NullCommand>& getSubmittedCommands() const { return m_submitted_commands; }
+        void clearSubmittedCommands() { m_submitted_commands.clear(); }
+        void setRayTracingSupported(bool supported) { m_ray_tracing_supported = supported; }
+        void setRayQuerySupported(bool supported) { m_ray_query_supported = supported; }
+        void setMaxPushDescriptors(uint32_t max_push_descriptors) { m_max_push_descriptors = max_push_descriptors; }
+
+    public:
+        static uint8_t const k_max_frames_in_flight {3};
+        static uint32_t const k_gpu_timestamp_query_count {32};
+
+    private:
+        // 管线可能在PipelineCache的后台编译线程上创建，句柄计数需加锁
+        uint64_t nextId() { std::lock_guard<std::mutex> lock(m_handle_mutex); ++m_stats.live_handles; return ++m_next_id; }
+        void releaseHandle() { std::lock_guard<std::mutex> lock(m_handle_mutex); if (m_stats.live_handles > 0) { --m_stats.live_handles; } }
+        RHIDeviceAddress allocateDeviceAddress(RHIDeviceSize size);
+        void record(RHICommandBuffer* command_buffer, NullCommandType type, uint64_t handle = 0,
+                    uint32_t arg0 = 0, uint32_t arg1 = 0, uint32_t arg2 = 0, uint32_t arg3 = 0);
+        void submitCommandBuffer(RHICommandBuffer* command_buffer);
+        void countUpload(RHIDeviceSize bytes);
+        NullBuffer* newBuffer(RHIDeviceSize size);
+        NullImage* newImage(uint32_t width, uint32_t height, RHIFormat format);
+
+
+        template<typename Base>
+        static uint64_t handleId(const Base* handle)
+        {
+            return handle ? static_cast<const NullResource<Base>*>(handle)->getId() : 0;
+        }
+
+        // 按句柄的实际类型释放，携带数据的句柄类型需要单独的重载
+        template<typename Base>
+        void deleteHandle(Base*& handle)
+        {
+            if (handle)
+            {
+                delete static_cast<NullResource<Base>*>(handle);
+                handle = nullptr;
+                releaseHandle();
+            }
+        }
+        void deleteHandle(RHIBuffer*& handle);
+        void deleteHandle(RHIDeviceMemory*& handle);
+        void deleteHandle(RHIImage*& handle);
+        void deleteHandle(RHIAccelerationStructure*& handle);
+        void deleteHandle(RHICommandBuffer*& handle);
+
+    private:
+        NullRHIStats m_stats;
+        uint64_t m_next_id{ 0 };
+        std::mutex m_handle_mutex;
+        RHIDeviceAddress m_next_device_address{ 0x10000 };
+        std::vector<NullCommand> m_submitted_commands;
+
+        std::shared_ptr<WindowSystem> m_window_system;
+
+        bool m_ray_tracing_supported{ false };
+        bool m_ray_query_supported{ false };
+        uint32_t m_max_push_descriptors{ 32 };     // 与VK_KHR_push_descriptor要求的最小上限一致，设为0模拟不支持
+
+        // 虚拟交换链与深度缓冲
+        RHIExtent2D m_swapchain_extent{};
+        RHIFormat m_swapchain_image_format{ RHI_FORMAT_B8G8R8A8_UNORM };
+        RHIViewport m_viewport{};
+        RHIRect2D m_scissor{};
+        std::vector<RHIImageView*> m_swapchain_imageviews;
+        RHIImage* m_depth_image{ nullptr };
+        RHIImageView* m_depth_image_view{ nullptr };
+        RHIFormat m_depth_image_format{ RHI_FORMAT_D32_SFLOAT };
+
+        // 帧资源
+        uint8_t m_current_frame_index{ 0 };
+        RHICommandPool* m_command_pool{ nullptr };
+        RHIDescriptorPool* m_descriptor_pool{ nullptr };
+        RHIQueue* m_graphics_queue{ nullptr };
+        RHIQueue* m_compute_queue{ nullptr };
+        RHICommandBuffer* m_command_buffers[k_max_frames_in_flight]{};
+        RHIFence* m_frame_fences[k_max_frames_in_flight]{};
+        RHISemaphore* m_texture_copy_semaphores[k_max_frames_in_flight]{};
+
+        // 采样器缓存
+        RHISampler* m_linear_sampler{ nullptr };
+        RHISampler* m_nearest_sampler{ nullptr };
+        std::map<uint32_t, RHISampler*> m_mipmap_sampler_map;
+
+        // 提交立即完成，各队列时间线值即该队列的提交次数
+        uint64_t m_graphics_timeline_value{ 0 };
+        uint64_t m_compute_timeline_value{ 0 };
+        uint64_t& getTimelineValue(RHIQueue* queue) { return queue == m_compute_queue ? m_compute_timeline_value : m_graphics_timeline_value; }
+
+        // 时间戳记录的是CPU录制时刻
+        std::array<uint64_t, k_gpu_timestamp_query_count> m_timestamps{};
+    };
+} // namespace Elish
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "../rhi.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Elish
+{
+    /**
+     * @brief 空后端录制的命令类型
+     */
+    enum class NullCommandType : uint8_t
+    {
+        BeginRenderPass,
+        NextSubpass,
+        EndRenderPass,
+        BindPipeline,
+        SetViewport,
+        SetScissor,
+        BindVertexBuffers,
+        BindIndexBuffer,
+        BindDescriptorSets,
+        PushConstants,
+        PushDescriptorSet,
+        Draw,
+        DrawIndexed,
+        Dispatch,
+        DispatchIndirect,
+        TraceRays,
+        ClearAttachments,
+        PipelineBarrier,
+        CopyBuffer,
+        CopyBufferToImage,
+        CopyImageToBuffer,
+        CopyImageToImage,
+        BuildAccelerationStructure,
+        CopyAccelerationStructure,
+        CopyAccelerationStructureToMemory,
+        CopyMemoryToAccelerationStructure,
+        ResetTimestamps,
+        WriteTimestamp,
+        BeginEvent,
+        EndEvent,
+        ExecuteCommands
+    };
+
+    /**
+     * @brief 空后端录制的一条命令
+     * @details handle为命令主要操作对象的句柄ID（管线、缓冲区、图像等），0表示无；
+     *          args按命令类型保存计数参数，例如Draw为(vertexCount, instanceCount, firstVertex, firstInstance)
+     */
+    struct NullCommand
+    {
+        NullCommandType type;
+        uint64_t handle = 0;
+        uint32_t args[4] = { 0, 0, 0, 0 };
+    };
+
+    /**
+     * @brief 空后端句柄
+     * @details 不持有任何GPU对象，只携带单调递增的ID，便于在命令流中识别
+     */
+    template<typename Base>
+    class NullResource : public Base
+    {
+    public:
+        explicit NullResource(uint64_t id) : m_id(id) {}
+        uint64_t getId() const
+        {
+            return m_id;
+        }
+    private:
+        uint64_t m_id;
+    };
+
+    using NullBufferView = NullResource<RHIBufferView>;
+    using NullCommandPool = NullResource<RHICommandPool>;
+    using NullDescriptorPool = NullResource<RHIDescriptorPool>;
+    using NullDescriptorSet = NullResource<RHIDescriptorSet>;
+    using NullDescriptorSetLayout = NullResource<RHIDescriptorSetLayout>;
+    using NullEvent = NullResource<RHIEvent>;
+    using NullFence = NullResource<RHIFence>;
+    using NullFramebuffer = NullResource<RHIFramebuffer>;
+    using NullImageView = NullResource<RHIImageView>;
+    using NullQueue = NullResource<RHIQueue>;
+    using NullPipeline = NullResource<RHIPipeline>;
+    using NullPipelineLayout = NullResource<RHIPipelineLayout>;
+    using NullRenderPass = NullResource<RHIRenderPass>;
+    using NullSampler = NullResource<RHISampler>;
+    using NullSemaphore = NullResource<RHISemaphore>;
+    using NullShader = NullResource<RHIShader>;
+
+    /**
+     * @brief 空后端缓冲区
+     * @details 主机可见的缓冲区在CPU内存中保留数据，映射与复制命令都作用于该内存；
+     *          设备地址为伪造的唯一地址，只用于比较与打印
+     */
+    class NullBuffer : public NullResource<RHIBuffer>
+    {
+    public:
+        NullBuffer(uint64_t id, RHIDeviceSize size, RHIDeviceAddress device_address)
+            : NullResource<RHIBuffer>(id), m_size(size), m_device_address(device_address), m_data(static_cast<size_t>(size)) {}
+
+        RHIDeviceSize getSize() const { return m_size; }
+        RHIDeviceAddress getDeviceAddress() const { return m_device_address; }
+        uint8_t* getData() { return m_data.data(); }
+
+    private:
+        RHIDeviceSize m_size;
+        RHIDeviceAddress m_device_address;
+        std::vector<uint8_t> m_data;
+    };
+
+    /**
+     * @brief 空后端设备内存，mapMemory返回其CPU存储
+     */
+    class NullDeviceMemory : public NullResource<RHIDeviceMemory>
+    {
+    public:
+        NullDeviceMemory(uint64_t id, RHIDeviceSize size)
+            : NullResource<RHIDeviceMemory>(id), m_data(static_cast<size_t>(size)) {}
+
+        RHIDeviceSize getSize() const { return m_data.size(); }
+        uint8_t* getData() { return m_data.data(); }
+
+    private:
+        std::vector<uint8_t> m_data;
+    };
+
+    /**
+     * @brief 空后端图像，只记录尺寸与格式
+     */
+    class NullImage : public NullResource<RHIImage>
+    {
+    public:
+        NullImage(uint64_t id, uint32_t width, uint32_t height, RHIFormat format)
+            : NullResource<RHIImage>(id), m_width(width), m_height(height), m_format(format) {}
+
+        uint32_t getWidth() const { return m_width; }
+        uint32_t getHeight() const { return m_height; }
+        RHIFormat getFormat() const { return m_format; }
+
+    private:
+        uint32_t m_width;
+        uint32_t m_height;
+        RHIFormat m_format;
+    };
+
+    /**
+     * @brief 空后端加速结构，只记录大小与伪造的设备地址
+     */
+    class NullAccelerationStructure : public NullResource<RHIAccelerationStructure>
+    {
+    public:
+        NullAccelerationStructure(uint64_t id, RHIDeviceSize size, RHIDeviceAddress device_address)
+            : NullResource<RHIAccelerationStructure>(id), m_size(size), m_device_address(device_address) {}
+
+        RHIDeviceSize getSize() const { return m_size; }
+        RHIDeviceAddress getDeviceAddress() const { return m_device_address; }
+
+    private:
+        RHIDeviceSize m_size;
+        RHIDeviceAddress m_device_address;
+    };
+
+    /**
+     * @brief 空后端命令缓冲区
+     * @details 录制的命令按顺序保存在命令流中，begin时清空，提交时追加到NullRHI的已提交命令流
+     */
+    class NullCommandBuffer : public NullResource<RHICommandBuffer>
+    {
+    public:
+        explicit NullCommandBuffer(uint64_t id) : NullResource<RHICommandBuffer>(id) {}
+
+        void begin()
+        {
+            m_commands.clear();
+            m_recording = true;
+        }
+        void end()
+        {
+            m_recording = false;
+        }
+        bool isRecording() const { return m_recording; }
+
+        void record(const NullCommand& command)
+        {
+            m_commands.push_back(command);
+        }
+        const std::vector<NullCommand>& getCommands() const
+        {
+            return m_commands;
+        }
+
+    private:
+        std::vector<NullCommand> m_commands;
+        bool m_recording = false;
+    };
+} // namespace Elish
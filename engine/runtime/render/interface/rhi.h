@@ -31,6 +31,9 @@ namespace Elish
         virtual bool allocateCommandBuffers(const RHICommandBufferAllocateInfo* pAllocateInfo, RHICommandBuffer* &pCommandBuffers) = 0;
         virtual bool allocateDescriptorSets(const RHIDescriptorSetAllocateInfo* pAllocateInfo, RHIDescriptorSet* &pDescriptorSets) = 0;
         virtual RHIResult allocateDescriptorSets(RHIDescriptorSetLayout* layout, RHIDescriptorSet*& descriptor_set) = 0;
+        // 描述符池管理：重置后从该池分配的描述符集全部失效，句柄包装对象需另行用releaseDescriptorSet释放
+        virtual bool resetDescriptorPool(RHIDescriptorPool* descriptorPool) = 0;
+        virtual void releaseDescriptorSet(RHIDescriptorSet* descriptorSet) = 0;
         virtual void createSwapchain() = 0;
         virtual void recreateSwapchain() = 0;
         virtual void createSwapchainImageViews() = 0;
@@ -68,6 +71,7 @@ namespace Elish
         virtual bool createDescriptorSetLayout(const RHIDescriptorSetLayoutCreateInfo* pCreateInfo, RHIDescriptorSetLayout* &pSetLayout) = 0;
         virtual bool createFence(const RHIFenceCreateInfo* pCreateInfo, RHIFence* &pFence) = 0;
         virtual bool createFramebuffer(const RHIFramebufferCreateInfo* pCreateInfo, RHIFramebuffer* &pFramebuffer) = 0;
+        // 图形管线创建只读取创建信息与设备句柄，实现须允许后台线程与渲染线程并发调用（PipelineCache异步编译依赖此约定）
         virtual bool createGraphicsPipelines(RHIPipelineCache* pipelineCache, uint32_t createInfoCount, const RHIGraphicsPipelineCreateInfo* pCreateInfos, RHIPipeline* &pPipelines) = 0;
         virtual bool createComputePipelines(RHIPipelineCache* pipelineCache, uint32_t createInfoCount, const RHIComputePipelineCreateInfo* pCreateInfos, RHIPipeline* &pPipelines) = 0;
         virtual bool createRayTracingPipelines(RHIPipelineCache* pipelineCache, uint32_t createInfoCount, const RHIRayTracingPipelineCreateInfo* pCreateInfos, RHIPipeline* &pPipelines) = 0;
@@ -77,6 +81,15 @@ namespace Elish
         virtual bool buildAccelerationStructure(RHICommandBuffer* commandBuffer, const RHIAccelerationStructureBuildInfo* pBuildInfo) = 0;
         virtual void getAccelerationStructureDeviceAddress(const RHIAccelerationStructureDeviceAddressInfo* pInfo, RHIDeviceAddress* pAddress) = 0;
         virtual void getAccelerationStructureBuildSizes(const RHIAccelerationStructureBuildGeometryInfoKHR* pBuildInfo, const uint32_t* pMaxPrimitiveCounts, RHIAccelerationStructureBuildSizesInfoKHR* pSizeInfo) = 0;
+        virtual void destroyAccelerationStructure(RHIAccelerationStructure* accelerationStructure) = 0;
+        virtual void cmdCopyAccelerationStructure(RHICommandBuffer* commandBuffer, RHIAccelerationStructure* src, RHIAccelerationStructure* dst, RHICopyAccelerationStructureModeKHR mode) = 0;
+        virtual void cmdCopyAccelerationStructureToMemory(RHICommandBuffer* commandBuffer, RHIAccelerationStructure* src, RHIDeviceAddress dst) = 0;
+        virtual void cmdCopyMemoryToAccelerationStructure(RHICommandBuffer* commandBuffer, RHIDeviceAddress src, RHIAccelerationStructure* dst) = 0;
+        // 阻塞查询加速结构属性（压缩后大小/序列化大小），仅用于加载期
+        virtual bool queryAccelerationStructureSizes(uint32_t count, RHIAccelerationStructure* const* pAccelerationStructures, RHIAccelerationStructureQueryTypeKHR queryType, RHIDeviceSize* pSizes) = 0;
+        // 检查序列化数据头（driverUUID + compatibilityUUID）与当前设备是否兼容
+        virtual bool isAccelerationStructureCompatible(const uint8_t* pVersionData) = 0;
+        virtual void getDeviceUUIDs(uint8_t deviceUUID[RHI_UUID_SIZE], uint8_t driverUUID[RHI_UUID_SIZE]) = 0;
         
         // 光线追踪着色器绑定表相关接口
         virtual bool createShaderBindingTable(const RHIShaderBindingTableCreateInfo* pCreateInfo, RHIPipeline* pipeline, RHIBuffer* &pBuffer, VmaAllocation* pAllocation) = 0;
@@ -120,9 +133,13 @@ namespace Elish
 
         virtual bool beginCommandBuffer(RHICommandBuffer* commandBuffer, const RHICommandBufferBeginInfo* pBeginInfo) = 0;
         virtual void cmdCopyImageToBuffer(RHICommandBuffer* commandBuffer, RHIImage* srcImage, RHIImageLayout srcImageLayout, RHIBuffer* dstBuffer, uint32_t regionCount, const RHIBufferImageCopy* pRegions) = 0;
+        virtual void cmdCopyBufferToImage(RHICommandBuffer* commandBuffer, RHIBuffer* srcBuffer, RHIImage* dstImage, RHIImageLayout dstImageLayout, uint32_t regionCount, const RHIBufferImageCopy* pRegions) = 0;
         virtual void cmdCopyImageToImage(RHICommandBuffer* commandBuffer, RHIImage* srcImage, RHIImageAspectFlagBits srcFlag, RHIImage* dstImage, RHIImageAspectFlagBits dstFlag, uint32_t width, uint32_t height) = 0;
         virtual void cmdCopyBuffer(RHICommandBuffer* commandBuffer, RHIBuffer* srcBuffer, RHIBuffer* dstBuffer, uint32_t regionCount, RHIBufferCopy* pRegions) = 0;
         virtual void cmdDraw(RHICommandBuffer* commandBuffer, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) = 0;
+        virtual void cmdExecuteCommands(RHICommandBuffer* commandBuffer, uint32_t commandBufferCount, RHICommandBuffer* const* pCommandBuffers) = 0;
+        // 推送描述符：录制时直接写入集合set的绑定，无需分配描述符集；该集合布局需带PUSH_DESCRIPTOR标志，写入的dstSet被忽略
+        virtual void cmdPushDescriptorSet(RHICommandBuffer* commandBuffer, RHIPipelineBindPoint pipelineBindPoint, RHIPipelineLayout* layout, uint32_t set, uint32_t descriptorWriteCount, const RHIWriteDescriptorSet* pDescriptorWrites) = 0;
         virtual void cmdDispatch(RHICommandBuffer* commandBuffer, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) = 0;
         virtual void cmdDispatchIndirect(RHICommandBuffer* commandBuffer, RHIBuffer* buffer, RHIDeviceSize offset) = 0;
         virtual void cmdPipelineBarrier(RHICommandBuffer* commandBuffer, RHIPipelineStageFlags srcStageMask, RHIPipelineStageFlags dstStageMask, RHIDependencyFlags dependencyFlags, uint32_t memoryBarrierCount, const RHIMemoryBarrier* pMemoryBarriers, uint32_t bufferMemoryBarrierCount, const RHIBufferMemoryBarrier* pBufferMemoryBarriers, uint32_t imageMemoryBarrierCount, const RHIImageMemoryBarrier* pImageMemoryBarriers) = 0;
@@ -175,6 +192,7 @@ namespace Elish
         virtual void destroyBuffer(RHIBuffer* &buffer) = 0;
         virtual void destroyPipeline(RHIPipeline* pipeline) = 0;
         virtual void destroyPipelineLayout(RHIPipelineLayout* pipelineLayout) = 0;
+        virtual void destroyDescriptorPool(RHIDescriptorPool* descriptorPool) = 0;
         virtual void freeCommandBuffers(RHICommandPool* commandPool, uint32_t commandBufferCount, RHICommandBuffer* pCommandBuffers) = 0;
 
         // memory
@@ -200,10 +218,32 @@ namespace Elish
         virtual RHIResult createRayTracingPipelinesKHR(uint32_t create_info_count, const RHIRayTracingPipelineCreateInfo* create_infos, RHIPipeline*& pipelines) = 0;
         virtual RHIDeviceAddress getBufferDeviceAddress(RHIBuffer* buffer) = 0;
         virtual bool isRayTracingSupported() = 0;
+        virtual bool isRayQuerySupported() = 0;
+        virtual uint32_t getMaxPushDescriptors() = 0;  // 推送描述符集合的最大绑定数，不支持推送描述符时返回0
 
         //semaphores
         virtual RHISemaphore* &getTextureCopySemaphore(uint32_t index) = 0;
 
+        // 异步提交（时间线信号量）：提交后立即返回时间线值，通过轮询判断完成，不阻塞CPU
+        virtual bool isAsyncSubmitSupported() = 0;
+        virtual RHICommandBuffer* beginAsyncCommands() = 0;
+        virtual uint64_t submitAsyncCommands(RHICommandBuffer* command_buffer) = 0;
+        virtual uint64_t getCompletedAsyncValue() = 0;
+        virtual bool waitForAsyncValue(uint64_t value, uint64_t timeout_ns) = 0;
+
+        // 队列时间线：每个队列一条时间线信号量，该队列上的每次提交（帧、上传、异步、queueSubmit）都以递增值发出信号，
+        // 资源复用/销毁只需等待其最后一次使用所在提交的值。不支持时间线信号量时退化为等待队列空闲
+        virtual uint64_t getSubmittedTimelineValue(RHIQueue* queue) = 0;
+        virtual uint64_t getCompletedTimelineValue(RHIQueue* queue) = 0;
+        virtual bool waitForTimelineValue(RHIQueue* queue, uint64_t value, uint64_t timeout_ns) = 0;
+
+        // GPU时间戳查询
+        virtual bool isGpuTimestampSupported() = 0;
+        virtual uint32_t getGpuTimestampQueryCount() const = 0;
+        virtual void cmdResetGpuTimestamps(RHICommandBuffer* commandBuffer, uint32_t firstQuery, uint32_t queryCount) = 0;
+        virtual void cmdWriteGpuTimestamp(RHICommandBuffer* commandBuffer, RHIPipelineStageFlagBits stage, uint32_t query) = 0;
+        virtual bool getGpuTimestampsNs(uint32_t firstQuery, uint32_t queryCount, uint64_t* pTimestampsNs) = 0;
+
     private:
     };
 
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "rhi.h"
+
+namespace Elish
+{
+    /**
+     * @brief 命令列表后端特征
+     * @details 每个后端特化本模板，声明其原生句柄类型；RHICommandList按这些类型存取参数，
+     *          调用方在录制前用toNative()把RHI句柄转换一次，录制循环内不再经过虚函数与包装对象
+     */
+    template<typename Backend>
+    struct RHICommandListTraits;
+
+    /**
+     * @brief 编译期选择后端的命令列表（CRTP）
+     * @details 接口函数全部内联转发到Derived的*Impl实现，后端在模板实例化时确定，
+     *          热路径（逐物体绑定与绘制）不产生虚函数调用。只覆盖逐绘制调用的高频命令，
+     *          渲染通道开始/结束、屏障等低频命令仍通过RHI录制
+     * @tparam Derived 具体后端命令列表类型
+     */
+    template<typename Derived>
+    class RHICommandList
+    {
+    public:
+        using Traits = RHICommandListTraits<Derived>;
+        using BufferHandle = typename Traits::BufferHandle;
+        using PipelineHandle = typename Traits::PipelineHandle;
+        using PipelineLayoutHandle = typename Traits::PipelineLayoutHandle;
+        using DescriptorSetHandle = typename Traits::DescriptorSetHandle;
+
+        void bindPipeline(RHIPipelineBindPoint bind_point, PipelineHandle pipeline)
+        {
+            derived().bindPipelineImpl(bind_point, pipeline);
+        }
+
+        void bindVertexBuffer(uint32_t binding, BufferHandle buffer, RHIDeviceSize offset = 0)
+        {
+            derived().bindVertexBufferImpl(binding, buffer, offset);
+        }
+
+        void bindIndexBuffer(BufferHandle buffer, RHIDeviceSize offset, RHIIndexType index_type)
+        {
+            derived().bindIndexBufferImpl(buffer, offset, index_type);
+        }
+
+        void bindDescriptorSet(RHIPipelineBindPoint bind_point, PipelineLayoutHandle layout, uint32_t set, DescriptorSetHandle descriptor_set)
+        {
+            derived().bindDescriptorSetImpl(bind_point, layout, set, descriptor_set);
+        }
+
+        void pushConstants(PipelineLayoutHandle layout, RHIShaderStageFlags stage_flags, uint32_t offset, uint32_t size, const void* values)
+        {
+            derived().pushConstantsImpl(layout, stage_flags, offset, size, values);
+        }
+
+        // 写入中的资源仍为RHI句柄，由后端转换
+        void pushDescriptorSet(RHIPipelineBindPoint bind_point, PipelineLayoutHandle layout, uint32_t set, uint32_t write_count, const RHIWriteDescriptorSet* writes)
+        {
+            derived().pushDescriptorSetImpl(bind_point, layout, set, write_count, writes);
+        }
+
+        void draw(uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance)
+        {
+            derived().drawImpl(vertex_count, instance_count, first_vertex, first_instance);
+        }
+
+        void drawIndexed(uint32_t index_count, uint32_t instance_count, uint32_t first_index, int32_t vertex_offset, uint32_t first_instance)
+        {
+            derived().drawIndexedImpl(index_count, instance_count, first_index, vertex_offset, first_instance);
+        }
+
+        void dispatch(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z)
+        {
+            derived().dispatchImpl(group_count_x, group_count_y, group_count_z);
+        }
+
+        // RHI句柄到原生句柄的转换，空句柄转换为后端的空值
+        static BufferHandle toNative(RHIBuffer* buffer) { return Derived::toNativeImpl(buffer); }
+        static PipelineHandle toNative(RHIPipeline* pipeline) { return Derived::toNativeImpl(pipeline); }
+        static PipelineLayoutHandle toNative(RHIPipelineLayout* layout) { return Derived::toNativeImpl(layout); }
+        static DescriptorSetHandle toNative(RHIDescriptorSet* descriptor_set) { return Derived::toNativeImpl(descriptor_set); }
+
+    protected:
+        RHICommandList() = default;
+
+    private:
+        Derived& derived() { return static_cast<Derived&>(*this); }
+    };
+
+    class RHIGenericCommandList;
+
+    template<>
+    struct RHICommandListTraits<RHIGenericCommandList>
+    {
+        using BufferHandle = RHIBuffer*;
+        using PipelineHandle = RHIPipeline*;
+        using PipelineLayoutHandle = RHIPipelineLayout*;
+        using DescriptorSetHandle = RHIDescriptorSet*;
+    };
+
+    /**
+     * @brief 通用后端：原生句柄即RHI句柄，命令经RHI虚接口录制
+     * @details 用于没有专用命令列表的后端（如NullRHI），保证同一份模板录制代码在所有后端上可用
+     */
+    class RHIGenericCommandList : public RHICommandList<RHIGenericCommandList>
+    {
+    public:
+        RHIGenericCommandList(RHI* rhi, RHICommandBuffer* command_buffer)
+            : m_rhi(rhi), m_command_buffer(command_buffer) {}
+
+    private:
+        friend class RHICommandList<RHIGenericCommandList>;
+
+        void bindPipelineImpl(RHIPipelineBindPoint bind_point, RHIPipeline* pipeline)
+        {
+            m_rhi->cmdBindPipelinePFN(m_command_buffer, bind_point, pipeline);
+        }
+
+        void bindVertexBufferImpl(uint32_t binding, RHIBuffer* buffer, RHIDeviceSize offset)
+        {
+            m_rhi->cmdBindVertexBuffersPFN(m_command_buffer, binding, 1, &buffer, &offset);
+        }
+
+        void bindIndexBufferImpl(RHIBuffer* buffer, RHIDeviceSize offset, RHIIndexType index_type)
+        {
+            m_rhi->cmdBindIndexBufferPFN(m_command_buffer, buffer, offset, index_type);
+        }
+
+        void bindDescriptorSetImpl(RHIPipelineBindPoint bind_point, RHIPipelineLayout* layout, uint32_t set, RHIDescriptorSet* descriptor_set)
+        {
+            m_rhi->cmdBindDescriptorSetsPFN(m_command_buffer, bind_point, layout, set, 1, &descriptor_set, 0, nullptr);
+        }
+
+        void pushConstantsImpl(RHIPipelineLayout* layout, RHIShaderStageFlags stage_flags, uint32_t offset, uint32_t size, const void* values)
+        {
+            m_rhi->cmdPushConstantsPFN(m_command_buffer, layout, stage_flags, offset, size, values);
+        }
+
+        void pushDescriptorSetImpl(RHIPipelineBindPoint bind_point, RHIPipelineLayout* layout, uint32_t set, uint32_t write_count, const RHIWriteDescriptorSet* writes)
+        {
+            m_rhi->cmdPushDescriptorSet(m_command_buffer, bind_point, layout, set, write_count, writes);
+        }
+
+        void drawImpl(uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance)
+        {
+            m_rhi->cmdDraw(m_command_buffer, vertex_count, instance_count, first_vertex, first_instance);
+        }
+
+        void drawIndexedImpl(uint32_t index_count, uint32_t instance_count, uint32_t first_index, int32_t vertex_offset, uint32_t first_instance)
+        {
+            m_rhi->cmdDrawIndexedPFN(m_command_buffer, index_count, instance_count, first_index, vertex_offset, first_instance);
+        }
+
+        void dispatchImpl(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z)
+        {
+            m_rhi->cmdDispatch(m_command_buffer, group_count_x, group_count_y, group_count_z);
+        }
+
+        static RHIBuffer* toNativeImpl(RHIBuffer* buffer) { return buffer; }
+        static RHIPipeline* toNativeImpl(RHIPipeline* pipeline) { return pipeline; }
+        static RHIPipelineLayout* toNativeImpl(RHIPipelineLayout* layout) { return layout; }
+        static RHIDescriptorSet* toNativeImpl(RHIDescriptorSet* descriptor_set) { return descriptor_set; }
+
+    private:
+        RHI* m_rhi;
+        RHICommandBuffer* m_command_buffer;
+    };
+} // namespace Elish
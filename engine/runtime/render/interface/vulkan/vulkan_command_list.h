@@ -0,0 +1,122 @@
+#pragma once
+
+#include "../rhi_command_list.h"
+#include "vulkan_rhi.h"
+#include "vulkan_rhi_resource.h"
+
+#include <vulkan/vulkan.h>
+
+namespace Elish
+{
+    class VulkanCommandList;
+
+    template<>
+    struct RHICommandListTraits<VulkanCommandList>
+    {
+        using BufferHandle = VkBuffer;
+        using PipelineHandle = VkPipeline;
+        using PipelineLayoutHandle = VkPipelineLayout;
+        using DescriptorSetHandle = VkDescriptorSet;
+    };
+
+    /**
+     * @brief Vulkan命令列表
+     * @details 构造时取出原生VkCommandBuffer并复制所需的设备级函数指针，之后每条命令
+     *          直接调用Vulkan函数：不经过RHI虚函数，不解包Vulkan*包装对象，也不分配临时数组。
+     *          生命周期应限定在一次录制范围内，不得跨帧保存
+     */
+    class VulkanCommandList : public RHICommandList<VulkanCommandList>
+    {
+    public:
+        VulkanCommandList(const VulkanRHI& rhi, RHICommandBuffer* command_buffer)
+            : m_rhi(rhi)
+            , m_command_buffer(static_cast<VulkanCommandBuffer*>(command_buffer)->getResource())
+            , m_cmd_bind_pipeline(rhi._vkCmdBindPipeline)
+            , m_cmd_bind_vertex_buffers(rhi._vkCmdBindVertexBuffers)
+            , m_cmd_bind_index_buffer(rhi._vkCmdBindIndexBuffer)
+            , m_cmd_bind_descriptor_sets(rhi._vkCmdBindDescriptorSets)
+            , m_cmd_push_constants(rhi._vkCmdPushConstants)
+            , m_cmd_draw_indexed(rhi._vkCmdDrawIndexed)
+        {
+        }
+
+        VkCommandBuffer getNativeCommandBuffer() const { return m_command_buffer; }
+
+    private:
+        friend class RHICommandList<VulkanCommandList>;
+
+        void bindPipelineImpl(RHIPipelineBindPoint bind_point, VkPipeline pipeline)
+        {
+            m_cmd_bind_pipeline(m_command_buffer, static_cast<VkPipelineBindPoint>(bind_point), pipeline);
+        }
+
+        void bindVertexBufferImpl(uint32_t binding, VkBuffer buffer, RHIDeviceSize offset)
+        {
+            VkDeviceSize vk_offset = offset;
+            m_cmd_bind_vertex_buffers(m_command_buffer, binding, 1, &buffer, &vk_offset);
+        }
+
+        void bindIndexBufferImpl(VkBuffer buffer, RHIDeviceSize offset, RHIIndexType index_type)
+        {
+            m_cmd_bind_index_buffer(m_command_buffer, buffer, offset, static_cast<VkIndexType>(index_type));
+        }
+
+        void bindDescriptorSetImpl(RHIPipelineBindPoint bind_point, VkPipelineLayout layout, uint32_t set, VkDescriptorSet descriptor_set)
+        {
+            m_cmd_bind_descriptor_sets(m_command_buffer, static_cast<VkPipelineBindPoint>(bind_point), layout, set, 1, &descriptor_set, 0, nullptr);
+        }
+
+        void pushConstantsImpl(VkPipelineLayout layout, RHIShaderStageFlags stage_flags, uint32_t offset, uint32_t size, const void* values)
+        {
+            m_cmd_push_constants(m_command_buffer, layout, static_cast<VkShaderStageFlags>(stage_flags), offset, size, values);
+        }
+
+        void pushDescriptorSetImpl(RHIPipelineBindPoint bind_point, VkPipelineLayout layout, uint32_t set, uint32_t write_count, const RHIWriteDescriptorSet* writes)
+        {
+            // 写入的句柄转换复用VulkanRHI的线程局部暂存数组
+            m_rhi.cmdPushDescriptorSetNative(m_command_buffer, static_cast<VkPipelineBindPoint>(bind_point), layout, set, write_count, writes);
+        }
+
+        void drawImpl(uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance)
+        {
+            vkCmdDraw(m_command_buffer, vertex_count, instance_count, first_vertex, first_instance);
+        }
+
+        void drawIndexedImpl(uint32_t index_count, uint32_t instance_count, uint32_t first_index, int32_t vertex_offset, uint32_t first_instance)
+        {
+            m_cmd_draw_indexed(m_command_buffer, index_count, instance_count, first_index, vertex_offset, first_instance);
+        }
+
+        void dispatchImpl(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z)
+        {
+            vkCmdDispatch(m_command_buffer, group_count_x, group_count_y, group_count_z);
+        }
+
+        static VkBuffer toNativeImpl(RHIBuffer* buffer)
+        {
+            return buffer ? static_cast<VulkanBuffer*>(buffer)->getResource() : VK_NULL_HANDLE;
+        }
+        static VkPipeline toNativeImpl(RHIPipeline* pipeline)
+        {
+            return pipeline ? static_cast<VulkanPipeline*>(pipeline)->getResource() : VK_NULL_HANDLE;
+        }
+        static VkPipelineLayout toNativeImpl(RHIPipelineLayout* layout)
+        {
+            return layout ? static_cast<VulkanPipelineLayout*>(layout)->getResource() : VK_NULL_HANDLE;
+        }
+        static VkDescriptorSet toNativeImpl(RHIDescriptorSet* descriptor_set)
+        {
+            return descriptor_set ? static_cast<VulkanDescriptorSet*>(descriptor_set)->getResource() : VK_NULL_HANDLE;
+        }
+
+    private:
+        const VulkanRHI& m_rhi;
+        VkCommandBuffer m_command_buffer;
+        PFN_vkCmdBindPipeline m_cmd_bind_pipeline;
+        PFN_vkCmdBindVertexBuffers m_cmd_bind_vertex_buffers;
+        PFN_vkCmdBindIndexBuffer m_cmd_bind_index_buffer;
+        PFN_vkCmdBindDescriptorSets m_cmd_bind_descriptor_sets;
+        PFN_vkCmdPushConstants m_cmd_push_constants;
+        PFN_vkCmdDrawIndexed m_cmd_draw_indexed;
+    };
+} // namespace Elish
@@ -1,10 +1,12 @@
 #include "vulkan_rhi.h"
 #include "vulkan_util.h"
+#include "vulkan_struct_layout.h"
 
 #include "../../window_system.h"
 #include "../../../core/base/macro.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iostream>
 
@@ -77,6 +79,105 @@
 
 namespace Elish
 {
+    namespace
+    {
+        /**
+         * @brief 句柄解包用的线程局部暂存数组
+         * @details 描述符写入与提交信息中的句柄是包装对象指针，无法按Vulkan布局直接传递，
+         *          解包结果写入这些数组；容量只增不减，稳定后每次调用不再分配堆内存
+         */
+        struct VulkanConversionScratch
+        {
+            std::vector<VkWriteDescriptorSet> write_descriptor_sets;
+            std::vector<VkCopyDescriptorSet> copy_descriptor_sets;
+            std::vector<VkDescriptorImageInfo> descriptor_image_infos;
+            std::vector<VkDescriptorBufferInfo> descriptor_buffer_infos;
+            std::vector<VkSubmitInfo> submit_infos;
+            std::vector<VkCommandBuffer> command_buffers;
+            std::vector<VkSemaphore> wait_semaphores;
+            std::vector<VkSemaphore> signal_semaphores;
+            std::vector<VkBuffer> buffers;
+        };
+
+        VulkanConversionScratch& getConversionScratch()
+        {
+            thread_local VulkanConversionScratch scratch;
+            return scratch;
+        }
+
+        /**
+         * @brief 把RHI描述符写入转换到暂存数组，供vkUpdateDescriptorSets与vkCmdPushDescriptorSetKHR共用
+         * @details 先统计图像/缓冲区信息总数，再一次性调整暂存数组大小，保证指针稳定；dstSet为空时（推送描述符）转换为VK_NULL_HANDLE
+         */
+        void convertWriteDescriptorSets(VulkanConversionScratch& scratch, uint32_t descriptorWriteCount, const RHIWriteDescriptorSet* pDescriptorWrites)
+        {
+            size_t image_info_count = 0;
+            size_t buffer_info_count = 0;
+            for (uint32_t i = 0; i < descriptorWriteCount; ++i)
+            {
+                const auto& rhi_write = pDescriptorWrites[i];
+                if (rhi_write.pImageInfo != nullptr)
+                {
+                    image_info_count += rhi_write.descriptorCount;
+                }
+                if (rhi_write.pBufferInfo != nullptr)
+                {
+                    buffer_info_count += rhi_write.descriptorCount;
+                }
+            }
+            scratch.write_descriptor_sets.resize(descriptorWriteCount);
+            scratch.descriptor_image_infos.resize(image_info_count);
+            scratch.descriptor_buffer_infos.resize(buffer_info_count);
+
+            size_t image_info_current = 0;
+            size_t buffer_info_current = 0;
+            for (uint32_t i = 0; i < descriptorWriteCount; ++i)
+            {
+                const auto& rhi_write = pDescriptorWrites[i];
+                auto& vk_write = scratch.write_descriptor_sets[i];
+
+                const VkDescriptorImageInfo* vk_image_info_ptr = nullptr;
+                if (rhi_write.pImageInfo != nullptr)
+                {
+                    vk_image_info_ptr = &scratch.descriptor_image_infos[image_info_current];
+                    for (uint32_t j = 0; j < rhi_write.descriptorCount; ++j)
+                    {
+                        const auto& rhi_image_info = rhi_write.pImageInfo[j];
+                        auto& vk_image_info = scratch.descriptor_image_infos[image_info_current++];
+                        vk_image_info.sampler = rhi_image_info.sampler ? ((VulkanSampler*)rhi_image_info.sampler)->getResource() : VK_NULL_HANDLE;
+                        vk_image_info.imageView = rhi_image_info.imageView ? ((VulkanImageView*)rhi_image_info.imageView)->getResource() : VK_NULL_HANDLE;
+                        vk_image_info.imageLayout = (VkImageLayout)rhi_image_info.imageLayout;
+                    }
+                }
+
+                const VkDescriptorBufferInfo* vk_buffer_info_ptr = nullptr;
+                if (rhi_write.pBufferInfo != nullptr)
+                {
+                    vk_buffer_info_ptr = &scratch.descriptor_buffer_infos[buffer_info_current];
+                    for (uint32_t j = 0; j < rhi_write.descriptorCount; ++j)
+                    {
+                        const auto& rhi_buffer_info = rhi_write.pBufferInfo[j];
+                        auto& vk_buffer_info = scratch.descriptor_buffer_infos[buffer_info_current++];
+                        vk_buffer_info.buffer = rhi_buffer_info.buffer ? ((VulkanBuffer*)rhi_buffer_info.buffer)->getResource() : VK_NULL_HANDLE;
+                        vk_buffer_info.offset = (VkDeviceSize)rhi_buffer_info.offset;
+                        vk_buffer_info.range = (VkDeviceSize)rhi_buffer_info.range;
+                    }
+                }
+
+                vk_write.sType = (VkStructureType)rhi_write.sType;
+                vk_write.pNext = (const void*)rhi_write.pNext;
+                vk_write.dstSet = rhi_write.dstSet ? ((VulkanDescriptorSet*)rhi_write.dstSet)->getResource() : VK_NULL_HANDLE;
+                vk_write.dstBinding = rhi_write.dstBinding;
+                vk_write.dstArrayElement = rhi_write.dstArrayElement;
+                vk_write.descriptorCount = rhi_write.descriptorCount;
+                vk_write.descriptorType = (VkDescriptorType)rhi_write.descriptorType;
+                vk_write.pImageInfo = vk_image_info_ptr;
+                vk_write.pBufferInfo = vk_buffer_info_ptr;
+                vk_write.pTexelBufferView = nullptr;
+            }
+        }
+    }
+
     VulkanRHI::~VulkanRHI()
     {
         // TODO
@@ -191,8 +292,13 @@ namespace Elish
 
     void VulkanRHI::waitForFences()
     {
+        // 时间线可用时帧节奏由图形时间线驱动：等待该帧上次提交的值
+        if (m_graphics_timeline.semaphore != VK_NULL_HANDLE)
+        {
+            waitForTimeline(m_graphics_timeline, m_frame_timeline_values[m_current_frame_index], UINT64_MAX);
+            return;
+        }
 
-        
         VkResult res_wait_for_fences =
             _vkWaitForFences(m_device, 1, &m_is_frame_in_flight_fences[m_current_frame_index], VK_TRUE, UINT64_MAX);
         if (VK_SUCCESS != res_wait_for_fences)
@@ -467,20 +573,26 @@ namespace Elish
             submit_info.signalSemaphoreCount   = 0;
             submit_info.pSignalSemaphores      = NULL;
 
-            VkResult res_reset_fences = _vkResetFences(m_device, 1, &m_is_frame_in_flight_fences[m_current_frame_index]);
-            if (VK_SUCCESS != res_reset_fences)
+            VkFence frame_fence = VK_NULL_HANDLE;
+            if (m_graphics_timeline.semaphore == VK_NULL_HANDLE)
             {
-                LOG_ERROR("_vkResetFences failed!");
-                return false;
+                VkResult res_reset_fences = _vkResetFences(m_device, 1, &m_is_frame_in_flight_fences[m_current_frame_index]);
+                if (VK_SUCCESS != res_reset_fences)
+                {
+                    LOG_ERROR("_vkResetFences failed!");
+                    return false;
+                }
+                frame_fence = m_is_frame_in_flight_fences[m_current_frame_index];
             }
 
-            VkResult res_queue_submit =
-                vkQueueSubmit(((VulkanQueue*)m_graphics_queue)->getResource(), 1, &submit_info, m_is_frame_in_flight_fences[m_current_frame_index]);
+            uint64_t frame_value = 0;
+            VkResult res_queue_submit = submitWithTimeline(m_graphics_queue, submit_info, frame_fence, frame_value);
             if (VK_SUCCESS != res_queue_submit)
             {
                 LOG_ERROR("vkQueueSubmit failed!");
                 return false;
             }
+            m_frame_timeline_values[m_current_frame_index] = frame_value;
             m_current_frame_index = (m_current_frame_index + 1) % k_max_frames_in_flight;
             return false; // 交换链次优，需要跳过当前帧
         }
@@ -552,17 +664,22 @@ namespace Elish
 
 
         
-        VkResult res_reset_fences = _vkResetFences(m_device, 1, &m_is_frame_in_flight_fences[m_current_frame_index]);
-
-        if (VK_SUCCESS != res_reset_fences)
+        // 时间线可用时不再使用帧围栏，帧完成由本次提交的时间线值表示
+        VkFence frame_fence = VK_NULL_HANDLE;
+        if (m_graphics_timeline.semaphore == VK_NULL_HANDLE)
         {
-            LOG_ERROR("_vkResetFences failed with result: {}", res_reset_fences);
-            return;
+            VkResult res_reset_fences = _vkResetFences(m_device, 1, &m_is_frame_in_flight_fences[m_current_frame_index]);
+
+            if (VK_SUCCESS != res_reset_fences)
+            {
+                LOG_ERROR("_vkResetFences failed with result: {}", res_reset_fences);
+                return;
+            }
+            frame_fence = m_is_frame_in_flight_fences[m_current_frame_index];
         }
         
-        
-        VkResult res_queue_submit =
-            vkQueueSubmit(((VulkanQueue*)m_graphics_queue)->getResource(), 1, &submit_info, m_is_frame_in_flight_fences[m_current_frame_index]);
+        uint64_t frame_value = 0;
+        VkResult res_queue_submit = submitWithTimeline(m_graphics_queue, submit_info, frame_fence, frame_value);
         
         if (VK_SUCCESS != res_queue_submit)
         {
@@ -598,6 +715,7 @@ namespace Elish
             }
             return;
         }
+        m_frame_timeline_values[m_current_frame_index] = frame_value;
 
         // present swapchain
         VkPresentInfoKHR present_info   = {};
@@ -658,13 +776,320 @@ namespace Elish
         submitInfo.commandBufferCount = 1;
         submitInfo.pCommandBuffers    = &vk_command_buffer;
 
-        vkQueueSubmit(((VulkanQueue*)m_graphics_queue)->getResource(), 1, &submitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(((VulkanQueue*)m_graphics_queue)->getResource());
+        // 只等待本次提交的时间线值，不再等待整个队列空闲（在途帧可继续执行）
+        uint64_t signal_value = 0;
+        submitWithTimeline(m_graphics_queue, submitInfo, VK_NULL_HANDLE, signal_value);
+        if (signal_value != 0)
+        {
+            waitForTimeline(m_graphics_timeline, signal_value, UINT64_MAX);
+        }
+        else
+        {
+            vkQueueWaitIdle(((VulkanQueue*)m_graphics_queue)->getResource());
+        }
 
         vkFreeCommandBuffers(m_device, ((VulkanCommandPool*)m_rhi_command_pool)->getResource(), 1, &vk_command_buffer);
         delete(command_buffer);
     }
 
+    /**
+     * @brief 开始录制异步命令缓冲区
+     * @details 与单次命令相同从通用命令池分配，但提交后不等待队列空闲
+     */
+    RHICommandBuffer* VulkanRHI::beginAsyncCommands()
+    {
+        if (!isAsyncSubmitSupported())
+        {
+            LOG_ERROR("[VulkanRHI] Async submission requested but timeline semaphores are unavailable");
+            return nullptr;
+        }
+
+        // 顺带回收已完成的命令缓冲区，避免长时间不轮询时积压
+        getCompletedAsyncValue();
+        return beginSingleTimeCommands();
+    }
+
+    /**
+     * @brief 提交异步命令缓冲区
+     * @return 完成时时间线信号量到达的值，提交失败返回0
+     */
+    uint64_t VulkanRHI::submitAsyncCommands(RHICommandBuffer* command_buffer)
+    {
+        if (!command_buffer)
+        {
+            return 0;
+        }
+
+        VkCommandBuffer vk_command_buffer = ((VulkanCommandBuffer*)command_buffer)->getResource();
+        delete(command_buffer);
+        _vkEndCommandBuffer(vk_command_buffer);
+
+        VkSubmitInfo submit_info {};
+        submit_info.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit_info.commandBufferCount = 1;
+        submit_info.pCommandBuffers    = &vk_command_buffer;
+
+        uint64_t signal_value = 0;
+        VkResult result = submitWithTimeline(m_graphics_queue, submit_info, VK_NULL_HANDLE, signal_value);
+        if (result != VK_SUCCESS)
+        {
+            LOG_ERROR("[VulkanRHI] Async queue submit failed with result: {}", result);
+            vkFreeCommandBuffers(m_device, ((VulkanCommandPool*)m_rhi_command_pool)->getResource(), 1, &vk_command_buffer);
+            return 0;
+        }
+
+        m_pending_async_command_buffers.push_back({ signal_value, vk_command_buffer });
+        return signal_value;
+    }
+
+    /**
+     * @brief 非阻塞查询时间线信号量当前值，并回收已完成的命令缓冲区
+     */
+    uint64_t VulkanRHI::getCompletedAsyncValue()
+    {
+        if (!isAsyncSubmitSupported())
+        {
+            return 0;
+        }
+        return getCompletedTimelineValue(m_graphics_queue);
+    }
+
+    /**
+     * @brief 等待图形时间线到达指定值
+     * @param value 目标值
+     * @param timeout_ns 超时时间（纳秒），0表示仅查询
+     * @return 在超时前到达返回true
+     */
+    bool VulkanRHI::waitForAsyncValue(uint64_t value, uint64_t timeout_ns)
+    {
+        if (!isAsyncSubmitSupported() || value == 0)
+        {
+            return true;
+        }
+        return waitForTimelineValue(m_graphics_queue, value, timeout_ns);
+    }
+
+    VulkanRHI::QueueTimeline* VulkanRHI::getQueueTimeline(RHIQueue* queue)
+    {
+        QueueTimeline* timeline = nullptr;
+        if (queue == m_graphics_queue)
+        {
+            timeline = &m_graphics_timeline;
+        }
+        else if (queue == m_compute_queue)
+        {
+            timeline = &m_compute_timeline;
+        }
+        return (timeline && timeline->semaphore != VK_NULL_HANDLE) ? timeline : nullptr;
+    }
+
+    VkResult VulkanRHI::submitWithTimeline(RHIQueue* queue, const VkSubmitInfo& submit_info, VkFence fence, uint64_t& signal_value)
+    {
+        signal_value = 0;
+        VkQueue vk_queue = ((VulkanQueue*)queue)->getResource();
+        QueueTimeline* timeline = getQueueTimeline(queue);
+        if (!timeline)
+        {
+            return vkQueueSubmit(vk_queue, 1, &submit_info, fence);
+        }
+
+        // 调用方链中已有时间线信息时无法在不复制未知结构的前提下合并，原样提交并记录；
+        // 在下一次带信号的提交之前，queueWaitIdle()退回vkQueueWaitIdle
+        for (const VkBaseInStructure* node = static_cast<const VkBaseInStructure*>(submit_info.pNext); node; node = node->pNext)
+        {
+            if (node->sType == VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR)
+            {
+                VkResult result = vkQueueSubmit(vk_queue, 1, &submit_info, fence);
+                if (result == VK_SUCCESS)
+                {
+                    timeline->has_unsignaled_submit = true;
+                }
+                return result;
+            }
+        }
+
+        // 原有二值信号量在前，时间线信号量在最后；二值信号量对应的值被忽略
+        std::array<VkSemaphore, 8> signal_semaphores;
+        std::array<uint64_t, 8> signal_values {};
+        if (submit_info.signalSemaphoreCount + 1 > signal_semaphores.size())
+        {
+            LOG_ERROR("[VulkanRHI] Too many signal semaphores for timeline submit: {}", submit_info.signalSemaphoreCount);
+            VkResult result = vkQueueSubmit(vk_queue, 1, &submit_info, fence);
+            if (result == VK_SUCCESS)
+            {
+                timeline->has_unsignaled_submit = true;
+            }
+            return result;
+        }
+        for (uint32_t i = 0; i < submit_info.signalSemaphoreCount; ++i)
+        {
+            signal_semaphores[i] = submit_info.pSignalSemaphores[i];
+        }
+        uint64_t value = timeline->submitted_value + 1;
+        signal_semaphores[submit_info.signalSemaphoreCount] = timeline->semaphore;
+        signal_values[submit_info.signalSemaphoreCount] = value;
+
+        // 时间线信息插在调用方pNext链之前，其余扩展结构保持不变
+        VkTimelineSemaphoreSubmitInfoKHR timeline_submit_info {};
+        timeline_submit_info.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+        timeline_submit_info.pNext                     = submit_info.pNext;
+        timeline_submit_info.signalSemaphoreValueCount = submit_info.signalSemaphoreCount + 1;
+        timeline_submit_info.pSignalSemaphoreValues    = signal_values.data();
+
+        VkSubmitInfo timeline_info = submit_info;
+        timeline_info.pNext                = &timeline_submit_info;
+        timeline_info.signalSemaphoreCount = submit_info.signalSemaphoreCount + 1;
+        timeline_info.pSignalSemaphores    = signal_semaphores.data();
+
+        VkResult result = vkQueueSubmit(vk_queue, 1, &timeline_info, fence);
+        if (result == VK_SUCCESS)
+        {
+            // 信号操作覆盖提交顺序中此前的全部命令，之前未带信号的提交随之可被等待
+            timeline->submitted_value = value;
+            timeline->has_unsignaled_submit = false;
+            signal_value = value;
+        }
+        return result;
+    }
+
+    bool VulkanRHI::waitForTimeline(QueueTimeline& timeline, uint64_t value, uint64_t timeout_ns)
+    {
+        if (value == 0)
+        {
+            return true;
+        }
+
+        VkSemaphoreWaitInfoKHR wait_info {};
+        wait_info.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+        wait_info.semaphoreCount = 1;
+        wait_info.pSemaphores    = &timeline.semaphore;
+        wait_info.pValues        = &value;
+
+        VkResult result = _vkWaitSemaphoresKHR(m_device, &wait_info, timeout_ns);
+        if (result == VK_SUCCESS)
+        {
+            if (&timeline == &m_graphics_timeline)
+            {
+                recycleAsyncCommandBuffers(value);
+            }
+            return true;
+        }
+        if (result == VK_ERROR_DEVICE_LOST)
+        {
+            LOG_ERROR("CRITICAL: Device lost while waiting for timeline value {}", value);
+            exit(1); // 设备丢失是不可恢复的错误
+        }
+        if (result != VK_TIMEOUT)
+        {
+            LOG_ERROR("[VulkanRHI] Waiting for timeline value {} failed with result: {}", value, result);
+        }
+        return false;
+    }
+
+    /**
+     * @brief 队列最近一次提交的时间线值
+     */
+    uint64_t VulkanRHI::getSubmittedTimelineValue(RHIQueue* queue)
+    {
+        QueueTimeline* timeline = getQueueTimeline(queue);
+        return timeline ? timeline->submitted_value : 0;
+    }
+
+    /**
+     * @brief 非阻塞查询队列时间线当前值，并回收已完成的异步命令缓冲区
+     */
+    uint64_t VulkanRHI::getCompletedTimelineValue(RHIQueue* queue)
+    {
+        QueueTimeline* timeline = getQueueTimeline(queue);
+        if (!timeline)
+        {
+            return 0;
+        }
+
+        uint64_t completed_value = 0;
+        if (_vkGetSemaphoreCounterValueKHR(m_device, timeline->semaphore, &completed_value) != VK_SUCCESS)
+        {
+            LOG_ERROR("[VulkanRHI] Failed to query timeline semaphore value");
+            return 0;
+        }
+
+        if (timeline == &m_graphics_timeline)
+        {
+            recycleAsyncCommandBuffers(completed_value);
+        }
+        return completed_value;
+    }
+
+    /**
+     * @brief 等待队列时间线到达指定值；队列没有时间线时退化为等待队列空闲
+     */
+    bool VulkanRHI::waitForTimelineValue(RHIQueue* queue, uint64_t value, uint64_t timeout_ns)
+    {
+        QueueTimeline* timeline = getQueueTimeline(queue);
+        if (!timeline)
+        {
+            return queue ? vkQueueWaitIdle(((VulkanQueue*)queue)->getResource()) == VK_SUCCESS : false;
+        }
+        return waitForTimeline(*timeline, value, timeout_ns);
+    }
+
+    void VulkanRHI::recycleAsyncCommandBuffers(uint64_t completed_value)
+    {
+        while (!m_pending_async_command_buffers.empty() &&
+               m_pending_async_command_buffers.front().timeline_value <= completed_value)
+        {
+            VkCommandBuffer command_buffer = m_pending_async_command_buffers.front().command_buffer;
+            vkFreeCommandBuffers(m_device, ((VulkanCommandPool*)m_rhi_command_pool)->getResource(), 1, &command_buffer);
+            m_pending_async_command_buffers.pop_front();
+        }
+    }
+
+    void VulkanRHI::cmdResetGpuTimestamps(RHICommandBuffer* commandBuffer, uint32_t firstQuery, uint32_t queryCount)
+    {
+        if (m_gpu_timestamp_query_pool == VK_NULL_HANDLE || firstQuery + queryCount > k_gpu_timestamp_query_count)
+        {
+            return;
+        }
+        vkCmdResetQueryPool(((VulkanCommandBuffer*)commandBuffer)->getResource(), m_gpu_timestamp_query_pool, firstQuery, queryCount);
+    }
+
+    void VulkanRHI::cmdWriteGpuTimestamp(RHICommandBuffer* commandBuffer, RHIPipelineStageFlagBits stage, uint32_t query)
+    {
+        if (m_gpu_timestamp_query_pool == VK_NULL_HANDLE || query >= k_gpu_timestamp_query_count)
+        {
+            return;
+        }
+        vkCmdWriteTimestamp(((VulkanCommandBuffer*)commandBuffer)->getResource(), (VkPipelineStageFlagBits)stage, m_gpu_timestamp_query_pool, query);
+    }
+
+    /**
+     * @brief 非阻塞读取时间戳查询结果
+     * @param pTimestampsNs 输出：换算为纳秒的时间戳
+     * @return 全部查询结果可用时返回true，GPU尚未执行到对应位置时返回false
+     */
+    bool VulkanRHI::getGpuTimestampsNs(uint32_t firstQuery, uint32_t queryCount, uint64_t* pTimestampsNs)
+    {
+        if (m_gpu_timestamp_query_pool == VK_NULL_HANDLE || firstQuery + queryCount > k_gpu_timestamp_query_count)
+        {
+            return false;
+        }
+
+        std::vector<uint64_t> ticks(queryCount);
+        VkResult result = vkGetQueryPoolResults(m_device, m_gpu_timestamp_query_pool, firstQuery, queryCount,
+                                                queryCount * sizeof(uint64_t), ticks.data(), sizeof(uint64_t),
+                                                VK_QUERY_RESULT_64_BIT);
+        if (result != VK_SUCCESS)
+        {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < queryCount; ++i)
+        {
+            pTimestampsNs[i] = static_cast<uint64_t>(static_cast<double>(ticks[i]) * m_timestamp_period_ns);
+        }
+        return true;
+    }
+
     // validation layers
     /**
      * @brief 检查验证层支持情况
@@ -994,8 +1419,14 @@ namespace Elish
         };
 
         // 查询光线追踪相关特性和属性
+        m_timeline_semaphore_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+        m_timeline_semaphore_features.pNext = nullptr;
+
+        m_ray_query_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_QUERY_FEATURES_KHR;
+        m_ray_query_features.pNext = &m_timeline_semaphore_features;
+
         m_rt_pipeline_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_FEATURES_KHR;
-        m_rt_pipeline_features.pNext = nullptr;
+        m_rt_pipeline_features.pNext = &m_ray_query_features;
         
         m_as_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR;
         m_as_features.pNext = &m_rt_pipeline_features;
@@ -1013,8 +1444,11 @@ namespace Elish
         vkGetPhysicalDeviceFeatures2(m_physical_device, &physical_device_features2);
         
         // 先查询光线追踪属性（无论是否支持都需要初始化结构体）
+        m_push_descriptor_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR;
+        m_push_descriptor_properties.pNext = nullptr;
+
         m_rt_pipeline_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_PROPERTIES_KHR;
-        m_rt_pipeline_properties.pNext = nullptr;
+        m_rt_pipeline_properties.pNext = &m_push_descriptor_properties;
         
         m_as_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR;
         m_as_properties.pNext = &m_rt_pipeline_properties;
@@ -1027,6 +1461,51 @@ namespace Elish
         
         // 增强的光线追踪兼容性检测
         m_ray_tracing_supported = checkRayTracingCompatibility();
+        m_ray_query_supported = m_ray_tracing_supported && m_ray_query_features.rayQuery == VK_TRUE;
+        LOG_INFO("  Ray Query: {}", m_ray_query_supported ? "Supported" : "Not Supported");
+
+        // 时间线信号量用于帧节奏、上传与异步提交的同步，不依赖光线追踪
+        bool timeline_extension_available = false;
+        bool push_descriptor_extension_available = false;
+        {
+            uint32_t extension_count = 0;
+            vkEnumerateDeviceExtensionProperties(m_physical_device, nullptr, &extension_count, nullptr);
+            std::vector<VkExtensionProperties> available_extensions(extension_count);
+            vkEnumerateDeviceExtensionProperties(m_physical_device, nullptr, &extension_count, available_extensions.data());
+            for (const auto& extension : available_extensions)
+            {
+                if (strcmp(extension.extensionName, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) == 0)
+                {
+                    timeline_extension_available = true;
+                }
+                else if (strcmp(extension.extensionName, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME) == 0)
+                {
+                    push_descriptor_extension_available = true;
+                }
+            }
+        }
+        m_timeline_semaphore_supported = timeline_extension_available &&
+                                         m_timeline_semaphore_features.timelineSemaphore == VK_TRUE;
+        LOG_INFO("  Timeline Semaphore: {}", m_timeline_semaphore_supported ? "Supported" : "Not Supported");
+        if (m_timeline_semaphore_supported)
+        {
+            required_extensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+        }
+        else
+        {
+            // 未启用的扩展结构体不能出现在设备创建的特性链中
+            m_ray_query_features.pNext = nullptr;
+        }
+
+        // 推送描述符用于逐绘制的绑定：录制时直接写入，无需为每个物体分配描述符集。该扩展没有特性结构体，
+        // 属性结构体在扩展不可用时不会被驱动填写
+        m_push_descriptor_supported = push_descriptor_extension_available && m_push_descriptor_properties.maxPushDescriptors > 0;
+        LOG_INFO("  Push Descriptor: {} (max {})", m_push_descriptor_supported ? "Supported" : "Not Supported",
+                 m_push_descriptor_supported ? m_push_descriptor_properties.maxPushDescriptors : 0u);
+        if (m_push_descriptor_supported)
+        {
+            required_extensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+        }
         
         // 根据支持情况添加光线追踪扩展
         if (m_ray_tracing_supported)
@@ -1080,6 +1559,8 @@ namespace Elish
             // 启用光线追踪特性
             m_rt_pipeline_features.rayTracingPipeline = VK_TRUE;
             m_as_features.accelerationStructure = VK_TRUE;
+            m_ray_query_features.rayQuery = m_ray_query_supported ? VK_TRUE : VK_FALSE;
+            m_timeline_semaphore_features.timelineSemaphore = m_timeline_semaphore_supported ? VK_TRUE : VK_FALSE;
             m_buffer_device_address_features.bufferDeviceAddress = VK_TRUE;
             m_descriptor_indexing_features.descriptorBindingPartiallyBound = VK_TRUE;
             m_descriptor_indexing_features.runtimeDescriptorArray = VK_TRUE;
@@ -1089,6 +1570,16 @@ namespace Elish
             device_create_info.pNext = &physical_device_features2;
             device_create_info.pEnabledFeatures = nullptr;
         }
+        else if (m_timeline_semaphore_supported)
+        {
+            // 不支持光线追踪时特性链只保留时间线信号量
+            m_timeline_semaphore_features.pNext = nullptr;
+            m_timeline_semaphore_features.timelineSemaphore = VK_TRUE;
+            physical_device_features2.pNext = &m_timeline_semaphore_features;
+            physical_device_features2.features = physical_device_features;
+            device_create_info.pNext = &physical_device_features2;
+            device_create_info.pEnabledFeatures = nullptr;
+        }
         else
         {
             device_create_info.pEnabledFeatures = &physical_device_features;
@@ -1131,6 +1622,27 @@ namespace Elish
         _vkCmdBindDescriptorSets = (PFN_vkCmdBindDescriptorSets)vkGetDeviceProcAddr(m_device, "vkCmdBindDescriptorSets");
         _vkCmdClearAttachments   = (PFN_vkCmdClearAttachments)vkGetDeviceProcAddr(m_device, "vkCmdClearAttachments");
         _vkCmdPushConstants      = (PFN_vkCmdPushConstants)vkGetDeviceProcAddr(m_device, "vkCmdPushConstants");
+
+        if (m_push_descriptor_supported)
+        {
+            _vkCmdPushDescriptorSetKHR = (PFN_vkCmdPushDescriptorSetKHR)vkGetDeviceProcAddr(m_device, "vkCmdPushDescriptorSetKHR");
+            if (!_vkCmdPushDescriptorSetKHR)
+            {
+                LOG_WARN("vkCmdPushDescriptorSetKHR unavailable, per-object descriptor sets stay in use");
+                m_push_descriptor_supported = false;
+            }
+        }
+
+        if (m_timeline_semaphore_supported)
+        {
+            _vkGetSemaphoreCounterValueKHR = (PFN_vkGetSemaphoreCounterValueKHR)vkGetDeviceProcAddr(m_device, "vkGetSemaphoreCounterValueKHR");
+            _vkWaitSemaphoresKHR           = (PFN_vkWaitSemaphoresKHR)vkGetDeviceProcAddr(m_device, "vkWaitSemaphoresKHR");
+            if (!_vkGetSemaphoreCounterValueKHR || !_vkWaitSemaphoresKHR)
+            {
+                LOG_WARN("Timeline semaphore function pointers unavailable, falling back to fences and queue idle waits");
+                m_timeline_semaphore_supported = false;
+            }
+        }
         
         // 只在支持光线追踪时初始化光线追踪相关函数指针
         if (m_ray_tracing_supported)
@@ -1140,6 +1652,11 @@ namespace Elish
             _vkGetAccelerationStructureDeviceAddressKHR = (PFN_vkGetAccelerationStructureDeviceAddressKHR)vkGetDeviceProcAddr(m_device, "vkGetAccelerationStructureDeviceAddressKHR");
             _vkGetAccelerationStructureBuildSizesKHR = (PFN_vkGetAccelerationStructureBuildSizesKHR)vkGetDeviceProcAddr(m_device, "vkGetAccelerationStructureBuildSizesKHR");
             _vkCmdBuildAccelerationStructuresKHR = (PFN_vkCmdBuildAccelerationStructuresKHR)vkGetDeviceProcAddr(m_device, "vkCmdBuildAccelerationStructuresKHR");
+            _vkCmdCopyAccelerationStructureKHR = (PFN_vkCmdCopyAccelerationStructureKHR)vkGetDeviceProcAddr(m_device, "vkCmdCopyAccelerationStructureKHR");
+            _vkCmdCopyAccelerationStructureToMemoryKHR = (PFN_vkCmdCopyAccelerationStructureToMemoryKHR)vkGetDeviceProcAddr(m_device, "vkCmdCopyAccelerationStructureToMemoryKHR");
+            _vkCmdCopyMemoryToAccelerationStructureKHR = (PFN_vkCmdCopyMemoryToAccelerationStructureKHR)vkGetDeviceProcAddr(m_device, "vkCmdCopyMemoryToAccelerationStructureKHR");
+            _vkCmdWriteAccelerationStructuresPropertiesKHR = (PFN_vkCmdWriteAccelerationStructuresPropertiesKHR)vkGetDeviceProcAddr(m_device, "vkCmdWriteAccelerationStructuresPropertiesKHR");
+            _vkGetDeviceAccelerationStructureCompatibilityKHR = (PFN_vkGetDeviceAccelerationStructureCompatibilityKHR)vkGetDeviceProcAddr(m_device, "vkGetDeviceAccelerationStructureCompatibilityKHR");
             _vkCreateRayTracingPipelinesKHR = (PFN_vkCreateRayTracingPipelinesKHR)vkGetDeviceProcAddr(m_device, "vkCreateRayTracingPipelinesKHR");
             _vkGetRayTracingShaderGroupHandlesKHR = (PFN_vkGetRayTracingShaderGroupHandlesKHR)vkGetDeviceProcAddr(m_device, "vkGetRayTracingShaderGroupHandlesKHR");
             _vkCmdTraceRaysKHR = (PFN_vkCmdTraceRaysKHR)vkGetDeviceProcAddr(m_device, "vkCmdTraceRaysKHR");
@@ -1154,6 +1671,11 @@ namespace Elish
             _vkGetAccelerationStructureDeviceAddressKHR = nullptr;
             _vkGetAccelerationStructureBuildSizesKHR = nullptr;
             _vkCmdBuildAccelerationStructuresKHR = nullptr;
+            _vkCmdCopyAccelerationStructureKHR = nullptr;
+            _vkCmdCopyAccelerationStructureToMemoryKHR = nullptr;
+            _vkCmdCopyMemoryToAccelerationStructureKHR = nullptr;
+            _vkCmdWriteAccelerationStructuresPropertiesKHR = nullptr;
+            _vkGetDeviceAccelerationStructureCompatibilityKHR = nullptr;
             _vkCreateRayTracingPipelinesKHR = nullptr;
             _vkGetRayTracingShaderGroupHandlesKHR = nullptr;
             _vkCmdTraceRaysKHR = nullptr;
@@ -2442,6 +2964,183 @@ namespace Elish
         pSizeInfo->buildScratchSize = size_info.buildScratchSize;
     }
 
+    /**
+     * @brief 销毁加速结构句柄
+     * @details 仅销毁加速结构对象本身，底层存储缓冲区由调用者负责释放
+     */
+    void VulkanRHI::destroyAccelerationStructure(RHIAccelerationStructure* accelerationStructure)
+    {
+        if (!accelerationStructure || !_vkDestroyAccelerationStructureKHR)
+        {
+            return;
+        }
+        _vkDestroyAccelerationStructureKHR(m_device, ((VulkanAccelerationStructure*)accelerationStructure)->getResource(), nullptr);
+        delete accelerationStructure;
+    }
+
+    /**
+     * @brief 录制加速结构之间的复制（克隆/压缩）
+     */
+    void VulkanRHI::cmdCopyAccelerationStructure(RHICommandBuffer* commandBuffer, RHIAccelerationStructure* src, RHIAccelerationStructure* dst, RHICopyAccelerationStructureModeKHR mode)
+    {
+        if (!commandBuffer || !src || !dst || !_vkCmdCopyAccelerationStructureKHR)
+        {
+            LOG_ERROR("[VulkanRHI::cmdCopyAccelerationStructure] Invalid parameters or ray tracing not supported!");
+            return;
+        }
+
+        VkCopyAccelerationStructureInfoKHR copy_info{};
+        copy_info.sType = VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR;
+        copy_info.src = ((VulkanAccelerationStructure*)src)->getResource();
+        copy_info.dst = ((VulkanAccelerationStructure*)dst)->getResource();
+        copy_info.mode = (VkCopyAccelerationStructureModeKHR)mode;
+        _vkCmdCopyAccelerationStructureKHR(((VulkanCommandBuffer*)commandBuffer)->getResource(), &copy_info);
+    }
+
+    /**
+     * @brief 录制加速结构序列化命令
+     * @param dst 目标设备地址，需256字节对齐，大小不小于序列化大小查询结果
+     */
+    void VulkanRHI::cmdCopyAccelerationStructureToMemory(RHICommandBuffer* commandBuffer, RHIAccelerationStructure* src, RHIDeviceAddress dst)
+    {
+        if (!commandBuffer || !src || dst == 0 || !_vkCmdCopyAccelerationStructureToMemoryKHR)
+        {
+            LOG_ERROR("[VulkanRHI::cmdCopyAccelerationStructureToMemory] Invalid parameters or ray tracing not supported!");
+            return;
+        }
+
+        VkCopyAccelerationStructureToMemoryInfoKHR copy_info{};
+        copy_info.sType = VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_TO_MEMORY_INFO_KHR;
+        copy_info.src = ((VulkanAccelerationStructure*)src)->getResource();
+        copy_info.dst.deviceAddress = dst;
+        copy_info.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_SERIALIZE_KHR;
+        _vkCmdCopyAccelerationStructureToMemoryKHR(((VulkanCommandBuffer*)commandBuffer)->getResource(), &copy_info);
+    }
+
+    /**
+     * @brief 录制加速结构反序列化命令
+     * @param src 序列化数据的设备地址，需256字节对齐
+     */
+    void VulkanRHI::cmdCopyMemoryToAccelerationStructure(RHICommandBuffer* commandBuffer, RHIDeviceAddress src, RHIAccelerationStructure* dst)
+    {
+        if (!commandBuffer || src == 0 || !dst || !_vkCmdCopyMemoryToAccelerationStructureKHR)
+        {
+            LOG_ERROR("[VulkanRHI::cmdCopyMemoryToAccelerationStructure] Invalid parameters or ray tracing not supported!");
+            return;
+        }
+
+        VkCopyMemoryToAccelerationStructureInfoKHR copy_info{};
+        copy_info.sType = VK_STRUCTURE_TYPE_COPY_MEMORY_TO_ACCELERATION_STRUCTURE_INFO_KHR;
+        copy_info.src.deviceAddress = src;
+        copy_info.dst = ((VulkanAccelerationStructure*)dst)->getResource();
+        copy_info.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_DESERIALIZE_KHR;
+        _vkCmdCopyMemoryToAccelerationStructureKHR(((VulkanCommandBuffer*)commandBuffer)->getResource(), &copy_info);
+    }
+
+    /**
+     * @brief 查询加速结构属性（压缩后大小/序列化大小）
+     * @details 使用临时查询池与单次命令缓冲区，等待GPU完成后读回结果，仅在加载阶段调用
+     * @return 查询成功返回true
+     */
+    bool VulkanRHI::queryAccelerationStructureSizes(uint32_t count, RHIAccelerationStructure* const* pAccelerationStructures, RHIAccelerationStructureQueryTypeKHR queryType, RHIDeviceSize* pSizes)
+    {
+        if (count == 0 || !pAccelerationStructures || !pSizes || !_vkCmdWriteAccelerationStructuresPropertiesKHR)
+        {
+            LOG_ERROR("[VulkanRHI::queryAccelerationStructureSizes] Invalid parameters or ray tracing not supported!");
+            return false;
+        }
+
+        VkQueryPoolCreateInfo query_pool_info{};
+        query_pool_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        query_pool_info.queryType = (VkQueryType)queryType;
+        query_pool_info.queryCount = count;
+
+        VkQueryPool query_pool = VK_NULL_HANDLE;
+        if (vkCreateQueryPool(m_device, &query_pool_info, nullptr, &query_pool) != VK_SUCCESS)
+        {
+            LOG_ERROR("[VulkanRHI::queryAccelerationStructureSizes] Failed to create query pool");
+            return false;
+        }
+
+        std::vector<VkAccelerationStructureKHR> structures(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            structures[i] = ((VulkanAccelerationStructure*)pAccelerationStructures[i])->getResource();
+        }
+
+        RHICommandBuffer* command_buffer = beginSingleTimeCommands();
+        VkCommandBuffer vk_command_buffer = ((VulkanCommandBuffer*)command_buffer)->getResource();
+        vkCmdResetQueryPool(vk_command_buffer, query_pool, 0, count);
+
+        // 属性写入前需等待此前的构建/复制完成
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        barrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+        vkCmdPipelineBarrier(vk_command_buffer,
+                             VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                             VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        _vkCmdWriteAccelerationStructuresPropertiesKHR(vk_command_buffer, count, structures.data(), query_pool_info.queryType, query_pool, 0);
+        endSingleTimeCommands(command_buffer);
+
+        std::vector<uint64_t> results(count, 0);
+        VkResult result = vkGetQueryPoolResults(m_device, query_pool, 0, count,
+                                                sizeof(uint64_t) * count, results.data(), sizeof(uint64_t),
+                                                VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+        vkDestroyQueryPool(m_device, query_pool, nullptr);
+
+        if (result != VK_SUCCESS)
+        {
+            LOG_ERROR("[VulkanRHI::queryAccelerationStructureSizes] Failed to read query results: {}", (int)result);
+            return false;
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            pSizes[i] = static_cast<RHIDeviceSize>(results[i]);
+        }
+        return true;
+    }
+
+    /**
+     * @brief 检查序列化加速结构数据与当前设备的兼容性
+     * @param pVersionData 序列化数据头部（2 * RHI_UUID_SIZE 字节）
+     */
+    bool VulkanRHI::isAccelerationStructureCompatible(const uint8_t* pVersionData)
+    {
+        if (!pVersionData || !_vkGetDeviceAccelerationStructureCompatibilityKHR)
+        {
+            return false;
+        }
+
+        VkAccelerationStructureVersionInfoKHR version_info{};
+        version_info.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_VERSION_INFO_KHR;
+        version_info.pVersionData = pVersionData;
+
+        VkAccelerationStructureCompatibilityKHR compatibility = VK_ACCELERATION_STRUCTURE_COMPATIBILITY_INCOMPATIBLE_KHR;
+        _vkGetDeviceAccelerationStructureCompatibilityKHR(m_device, &version_info, &compatibility);
+        return compatibility == VK_ACCELERATION_STRUCTURE_COMPATIBILITY_COMPATIBLE_KHR;
+    }
+
+    /**
+     * @brief 获取物理设备与驱动的UUID（用于磁盘缓存键）
+     */
+    void VulkanRHI::getDeviceUUIDs(uint8_t deviceUUID[RHI_UUID_SIZE], uint8_t driverUUID[RHI_UUID_SIZE])
+    {
+        VkPhysicalDeviceIDProperties id_properties{};
+        id_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+
+        VkPhysicalDeviceProperties2 properties{};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties.pNext = &id_properties;
+        vkGetPhysicalDeviceProperties2(m_physical_device, &properties);
+
+        memcpy(deviceUUID, id_properties.deviceUUID, RHI_UUID_SIZE);
+        memcpy(driverUUID, id_properties.driverUUID, RHI_UUID_SIZE);
+    }
+
     /**
      * @brief 创建着色器绑定表
      * @param pCreateInfo 着色器绑定表创建信息
@@ -2934,7 +3633,8 @@ namespace Elish
             command_buffer_inheritance_info.pNext = (const void*)pBeginInfo->pInheritanceInfo->pNext;
             command_buffer_inheritance_info.renderPass = ((VulkanRenderPass*)pBeginInfo->pInheritanceInfo->renderPass)->getResource();
             command_buffer_inheritance_info.subpass = pBeginInfo->pInheritanceInfo->subpass;
-            command_buffer_inheritance_info.framebuffer = ((VulkanFramebuffer*)pBeginInfo->pInheritanceInfo->framebuffer)->getResource();
+            command_buffer_inheritance_info.framebuffer = pBeginInfo->pInheritanceInfo->framebuffer ?
+                ((VulkanFramebuffer*)pBeginInfo->pInheritanceInfo->framebuffer)->getResource() : VK_NULL_HANDLE;
             command_buffer_inheritance_info.occlusionQueryEnable = (VkBool32)pBeginInfo->pInheritanceInfo->occlusionQueryEnable;
             command_buffer_inheritance_info.queryFlags = (VkQueryControlFlags)pBeginInfo->pInheritanceInfo->queryFlags;
             command_buffer_inheritance_info.pipelineStatistics = (VkQueryPipelineStatisticFlags)pBeginInfo->pInheritanceInfo->pipelineStatistics;
@@ -3051,49 +3751,12 @@ namespace Elish
 
     void VulkanRHI::cmdSetViewportPFN(RHICommandBuffer* commandBuffer, uint32_t firstViewport, uint32_t viewportCount, const RHIViewport* pViewports)
     {
-        //viewport
-        int viewport_size = viewportCount;
-        std::vector<VkViewport> vk_viewport_list(viewport_size);
-        for (int i = 0; i < viewport_size; ++i)
-        {
-            const auto& rhi_viewport_element = pViewports[i];
-            auto& vk_viewport_element = vk_viewport_list[i];
-
-            vk_viewport_element.x = rhi_viewport_element.x;
-            vk_viewport_element.y = rhi_viewport_element.y;
-            vk_viewport_element.width = rhi_viewport_element.width;
-            vk_viewport_element.height = rhi_viewport_element.height;
-            vk_viewport_element.minDepth = rhi_viewport_element.minDepth;
-            vk_viewport_element.maxDepth = rhi_viewport_element.maxDepth;
-        };
-
-        return _vkCmdSetViewport(((VulkanCommandBuffer*)commandBuffer)->getResource(), firstViewport, viewportCount, vk_viewport_list.data());
+        return _vkCmdSetViewport(((VulkanCommandBuffer*)commandBuffer)->getResource(), firstViewport, viewportCount, vulkanCast(pViewports));
     }
 
     void VulkanRHI::cmdSetScissorPFN(RHICommandBuffer* commandBuffer, uint32_t firstScissor, uint32_t scissorCount, const RHIRect2D* pScissors)
     {
-        //rect_2d
-        int rect_2d_size = scissorCount;
-        std::vector<VkRect2D> vk_rect_2d_list(rect_2d_size);
-        for (int i = 0; i < rect_2d_size; ++i)
-        {
-            const auto& rhi_rect_2d_element = pScissors[i];
-            auto& vk_rect_2d_element = vk_rect_2d_list[i];
-
-            VkOffset2D offset_2d{};
-            offset_2d.x = rhi_rect_2d_element.offset.x;
-            offset_2d.y = rhi_rect_2d_element.offset.y;
-
-            VkExtent2D extent_2d{};
-            extent_2d.width = rhi_rect_2d_element.extent.width;
-            extent_2d.height = rhi_rect_2d_element.extent.height;
-
-            vk_rect_2d_element.offset = (VkOffset2D)offset_2d;
-            vk_rect_2d_element.extent = (VkExtent2D)extent_2d;
-
-        };
-
-        return _vkCmdSetScissor(((VulkanCommandBuffer*)commandBuffer)->getResource(), firstScissor, scissorCount, vk_rect_2d_list.data());
+        return _vkCmdSetScissor(((VulkanCommandBuffer*)commandBuffer)->getResource(), firstScissor, scissorCount, vulkanCast(pScissors));
     }
 
     void VulkanRHI::cmdBindVertexBuffersPFN(
@@ -3103,29 +3766,15 @@ namespace Elish
         RHIBuffer* const* pBuffers,
         const RHIDeviceSize* pOffsets)
     {
-        //buffer
-        int buffer_size = bindingCount;
-        std::vector<VkBuffer> vk_buffer_list(buffer_size);
-        for (int i = 0; i < buffer_size; ++i)
+        //buffer：偏移量与VkDeviceSize类型一致，直接传递
+        std::vector<VkBuffer>& vk_buffer_list = getConversionScratch().buffers;
+        vk_buffer_list.resize(bindingCount);
+        for (uint32_t i = 0; i < bindingCount; ++i)
         {
-            const auto& rhi_buffer_element = pBuffers[i];
-            auto& vk_buffer_element = vk_buffer_list[i];
-
-            vk_buffer_element = ((VulkanBuffer*)rhi_buffer_element)->getResource();
-        };
-
-        //offset
-        int offset_size = bindingCount;
-        std::vector<VkDeviceSize> vk_device_size_list(offset_size);
-        for (int i = 0; i < offset_size; ++i)
-        {
-            const auto& rhi_offset_element = pOffsets[i];
-            auto& vk_offset_element = vk_device_size_list[i];
-
-            vk_offset_element = rhi_offset_element;
-        };
+            vk_buffer_list[i] = ((VulkanBuffer*)pBuffers[i])->getResource();
+        }
 
-        return _vkCmdBindVertexBuffers(((VulkanCommandBuffer*)commandBuffer)->getResource(), firstBinding, bindingCount, vk_buffer_list.data(), vk_device_size_list.data());
+        return _vkCmdBindVertexBuffers(((VulkanCommandBuffer*)commandBuffer)->getResource(), firstBinding, bindingCount, vk_buffer_list.data(), pOffsets);
     }
 
     void VulkanRHI::cmdBindIndexBufferPFN(RHICommandBuffer* commandBuffer, RHIBuffer* buffer, RHIDeviceSize offset, RHIIndexType indexType)
@@ -3268,34 +3917,12 @@ namespace Elish
             vk_clear_attachment_element.colorAttachment = rhi_clear_attachment_element.colorAttachment;
         };
 
-        //clear_rect
-        int clear_rect_size = rectCount;
-        std::vector<VkClearRect> vk_clear_rect_list(clear_rect_size);
-        for (int i = 0; i < clear_rect_size; ++i)
-        {
-            const auto& rhi_clear_rect_element = pRects[i];
-            auto& vk_clear_rect_element = vk_clear_rect_list[i];
-
-            VkOffset2D offset_2d{};
-            offset_2d.x = rhi_clear_rect_element.rect.offset.x;
-            offset_2d.y = rhi_clear_rect_element.rect.offset.y;
-
-            VkExtent2D extent_2d{};
-            extent_2d.width = rhi_clear_rect_element.rect.extent.width;
-            extent_2d.height = rhi_clear_rect_element.rect.extent.height;
-
-            vk_clear_rect_element.rect.offset = (VkOffset2D)offset_2d;
-            vk_clear_rect_element.rect.extent = (VkExtent2D)extent_2d;
-            vk_clear_rect_element.baseArrayLayer = rhi_clear_rect_element.baseArrayLayer;
-            vk_clear_rect_element.layerCount = rhi_clear_rect_element.layerCount;
-        };
-
         return _vkCmdClearAttachments(
             ((VulkanCommandBuffer*)commandBuffer)->getResource(),
             attachmentCount,
             vk_clear_attachment_list.data(),
             rectCount,
-            vk_clear_rect_list.data());
+            vulkanCast(pRects));
     }
 
     /**
@@ -3322,7 +3949,9 @@ namespace Elish
             command_buffer_inheritance_info.pNext = (const void*)pBeginInfo->pInheritanceInfo->pNext;
             command_buffer_inheritance_info.renderPass = ((VulkanRenderPass*)pBeginInfo->pInheritanceInfo->renderPass)->getResource();
             command_buffer_inheritance_info.subpass = pBeginInfo->pInheritanceInfo->subpass;
-            command_buffer_inheritance_info.framebuffer = ((VulkanFramebuffer*)(pBeginInfo->pInheritanceInfo->framebuffer))->getResource();
+            // 帧缓冲可选：为空时二级命令缓冲区可在该子通道的任意帧缓冲中执行
+            command_buffer_inheritance_info.framebuffer = pBeginInfo->pInheritanceInfo->framebuffer ?
+                ((VulkanFramebuffer*)(pBeginInfo->pInheritanceInfo->framebuffer))->getResource() : VK_NULL_HANDLE;
             command_buffer_inheritance_info.occlusionQueryEnable = (VkBool32)pBeginInfo->pInheritanceInfo->occlusionQueryEnable;
             command_buffer_inheritance_info.queryFlags = (VkQueryControlFlags)pBeginInfo->pInheritanceInfo->queryFlags;
             command_buffer_inheritance_info.pipelineStatistics = (VkQueryPipelineStatisticFlags)pBeginInfo->pInheritanceInfo->pipelineStatistics;
@@ -3370,218 +3999,84 @@ namespace Elish
         uint32_t descriptorCopyCount,
         const RHICopyDescriptorSet* pDescriptorCopies)
     {
+        VulkanConversionScratch& scratch = getConversionScratch();
+
         //write_descriptor_set
-        int write_descriptor_set_size = descriptorWriteCount;
-        std::vector<VkWriteDescriptorSet> vk_write_descriptor_set_list(write_descriptor_set_size);
-        int image_info_count = 0;
-        int buffer_info_count = 0;
-        for (int i = 0; i < write_descriptor_set_size; ++i)
-        {
-            const auto& rhi_write_descriptor_set_element = pDescriptorWrites[i];
-            if (rhi_write_descriptor_set_element.pImageInfo != nullptr)
-            {
-                image_info_count++;
-            }
-            if (rhi_write_descriptor_set_element.pBufferInfo != nullptr)
-            {
-                buffer_info_count++;
-            }
-        }
-        std::vector<VkDescriptorImageInfo> vk_descriptor_image_info_list(image_info_count);
-        std::vector<VkDescriptorBufferInfo> vk_descriptor_buffer_info_list(buffer_info_count);
-        int image_info_current = 0;
-        int buffer_info_current = 0;
+        convertWriteDescriptorSets(scratch, descriptorWriteCount, pDescriptorWrites);
 
-        for (int i = 0; i < write_descriptor_set_size; ++i)
+        //copy_descriptor_set
+        scratch.copy_descriptor_sets.resize(descriptorCopyCount);
+        for (uint32_t i = 0; i < descriptorCopyCount; ++i)
         {
-            const auto& rhi_write_descriptor_set_element = pDescriptorWrites[i];
-            auto& vk_write_descriptor_set_element = vk_write_descriptor_set_list[i];
+            const auto& rhi_copy = pDescriptorCopies[i];
+            auto& vk_copy = scratch.copy_descriptor_sets[i];
 
-            const VkDescriptorImageInfo* vk_descriptor_image_info_ptr = nullptr;
-            if (rhi_write_descriptor_set_element.pImageInfo != nullptr)
-            {
-                auto& vk_descriptor_image_info = vk_descriptor_image_info_list[image_info_current];
-                if (rhi_write_descriptor_set_element.pImageInfo->sampler == nullptr)
-                {
-                    vk_descriptor_image_info.sampler = nullptr;
-                }
-                else
-                {
-                    vk_descriptor_image_info.sampler = ((VulkanSampler*)rhi_write_descriptor_set_element.pImageInfo->sampler)->getResource();
-                }
-                vk_descriptor_image_info.imageView = ((VulkanImageView*)rhi_write_descriptor_set_element.pImageInfo->imageView)->getResource();
-                vk_descriptor_image_info.imageLayout = (VkImageLayout)rhi_write_descriptor_set_element.pImageInfo->imageLayout;
-
-                vk_descriptor_image_info_ptr = &vk_descriptor_image_info;
-                image_info_current++;
-            }
-
-            const VkDescriptorBufferInfo* vk_descriptor_buffer_info_ptr = nullptr;
-            if (rhi_write_descriptor_set_element.pBufferInfo != nullptr)
-            {
-                auto& vk_descriptor_buffer_info = vk_descriptor_buffer_info_list[buffer_info_current];
-                vk_descriptor_buffer_info.buffer = ((VulkanBuffer*)rhi_write_descriptor_set_element.pBufferInfo->buffer)->getResource();
-                vk_descriptor_buffer_info.offset = (VkDeviceSize)rhi_write_descriptor_set_element.pBufferInfo->offset;
-                vk_descriptor_buffer_info.range = (VkDeviceSize)rhi_write_descriptor_set_element.pBufferInfo->range;
-
-                vk_descriptor_buffer_info_ptr = &vk_descriptor_buffer_info;
-                buffer_info_current++;
-            }
-
-            vk_write_descriptor_set_element.sType = (VkStructureType)rhi_write_descriptor_set_element.sType;
-            vk_write_descriptor_set_element.pNext = (const void*)rhi_write_descriptor_set_element.pNext;
-            vk_write_descriptor_set_element.dstSet = ((VulkanDescriptorSet*)rhi_write_descriptor_set_element.dstSet)->getResource();
-            vk_write_descriptor_set_element.dstBinding = rhi_write_descriptor_set_element.dstBinding;
-            vk_write_descriptor_set_element.dstArrayElement = rhi_write_descriptor_set_element.dstArrayElement;
-            vk_write_descriptor_set_element.descriptorCount = rhi_write_descriptor_set_element.descriptorCount;
-            vk_write_descriptor_set_element.descriptorType = (VkDescriptorType)rhi_write_descriptor_set_element.descriptorType;
-            vk_write_descriptor_set_element.pImageInfo = vk_descriptor_image_info_ptr;
-            vk_write_descriptor_set_element.pBufferInfo = vk_descriptor_buffer_info_ptr;
-            //vk_write_descriptor_set_element.pTexelBufferView = &((VulkanBufferView*)rhi_write_descriptor_set_element.pTexelBufferView)->getResource();
-        };
-
-        if (image_info_current != image_info_count
-            || buffer_info_current != buffer_info_count)
-        {
-            LOG_ERROR("image_info_current != image_info_count || buffer_info_current != buffer_info_count");
-            return;
+            vk_copy.sType = (VkStructureType)rhi_copy.sType;
+            vk_copy.pNext = (const void*)rhi_copy.pNext;
+            vk_copy.srcSet = ((VulkanDescriptorSet*)rhi_copy.srcSet)->getResource();
+            vk_copy.srcBinding = rhi_copy.srcBinding;
+            vk_copy.srcArrayElement = rhi_copy.srcArrayElement;
+            vk_copy.dstSet = ((VulkanDescriptorSet*)rhi_copy.dstSet)->getResource();
+            vk_copy.dstBinding = rhi_copy.dstBinding;
+            vk_copy.dstArrayElement = rhi_copy.dstArrayElement;
+            vk_copy.descriptorCount = rhi_copy.descriptorCount;
         }
 
-        //copy_descriptor_set
-        int copy_descriptor_set_size = descriptorCopyCount;
-        std::vector<VkCopyDescriptorSet> vk_copy_descriptor_set_list(copy_descriptor_set_size);
-        for (int i = 0; i < copy_descriptor_set_size; ++i)
-        {
-            const auto& rhi_copy_descriptor_set_element = pDescriptorCopies[i];
-            auto& vk_copy_descriptor_set_element = vk_copy_descriptor_set_list[i];
-
-            vk_copy_descriptor_set_element.sType = (VkStructureType)rhi_copy_descriptor_set_element.sType;
-            vk_copy_descriptor_set_element.pNext = (const void*)rhi_copy_descriptor_set_element.pNext;
-            vk_copy_descriptor_set_element.srcSet = ((VulkanDescriptorSet*)rhi_copy_descriptor_set_element.srcSet)->getResource();
-            vk_copy_descriptor_set_element.srcBinding = rhi_copy_descriptor_set_element.srcBinding;
-            vk_copy_descriptor_set_element.srcArrayElement = rhi_copy_descriptor_set_element.srcArrayElement;
-            vk_copy_descriptor_set_element.dstSet = ((VulkanDescriptorSet*)rhi_copy_descriptor_set_element.dstSet)->getResource();
-            vk_copy_descriptor_set_element.dstBinding = rhi_copy_descriptor_set_element.dstBinding;
-            vk_copy_descriptor_set_element.dstArrayElement = rhi_copy_descriptor_set_element.dstArrayElement;
-            vk_copy_descriptor_set_element.descriptorCount = rhi_copy_descriptor_set_element.descriptorCount;
-        };
-
-        vkUpdateDescriptorSets(m_device, descriptorWriteCount, vk_write_descriptor_set_list.data(), descriptorCopyCount, vk_copy_descriptor_set_list.data());
+        vkUpdateDescriptorSets(m_device, descriptorWriteCount, scratch.write_descriptor_sets.data(), descriptorCopyCount, scratch.copy_descriptor_sets.data());
     }
 
     bool VulkanRHI::queueSubmit(RHIQueue* queue, uint32_t submitCount, const RHISubmitInfo* pSubmits, RHIFence* fence)
     {
-        //submit_info
-        int command_buffer_size_total = 0;
-        int semaphore_size_total = 0;
-        int signal_semaphore_size_total = 0;
-        int pipeline_stage_flags_size_total = 0;
+        VulkanConversionScratch& scratch = getConversionScratch();
 
-        int submit_info_size = submitCount;
-        for (int i = 0; i < submit_info_size; ++i)
+        //submit_info：先统计句柄总数，再一次性调整暂存数组大小，保证指针稳定
+        size_t command_buffer_count = 0;
+        size_t wait_semaphore_count = 0;
+        size_t signal_semaphore_count = 0;
+        for (uint32_t i = 0; i < submitCount; ++i)
         {
-            const auto& rhi_submit_info_element = pSubmits[i];
-            command_buffer_size_total += rhi_submit_info_element.commandBufferCount;
-            semaphore_size_total += rhi_submit_info_element.waitSemaphoreCount;
-            signal_semaphore_size_total += rhi_submit_info_element.signalSemaphoreCount;
-            pipeline_stage_flags_size_total += rhi_submit_info_element.waitSemaphoreCount;
+            command_buffer_count += pSubmits[i].commandBufferCount;
+            wait_semaphore_count += pSubmits[i].waitSemaphoreCount;
+            signal_semaphore_count += pSubmits[i].signalSemaphoreCount;
         }
-        std::vector<VkCommandBuffer> vk_command_buffer_list_external(command_buffer_size_total);
-        std::vector<VkSemaphore> vk_semaphore_list_external(semaphore_size_total);
-        std::vector<VkSemaphore> vk_signal_semaphore_list_external(signal_semaphore_size_total);
-        std::vector<VkPipelineStageFlags> vk_pipeline_stage_flags_list_external(pipeline_stage_flags_size_total);
+        scratch.submit_infos.resize(submitCount);
+        scratch.command_buffers.resize(command_buffer_count);
+        scratch.wait_semaphores.resize(wait_semaphore_count);
+        scratch.signal_semaphores.resize(signal_semaphore_count);
 
-        int command_buffer_size_current = 0;
-        int semaphore_size_current = 0;
-        int signal_semaphore_size_current = 0;
-        int pipeline_stage_flags_size_current = 0;
-
-
-        std::vector<VkSubmitInfo> vk_submit_info_list(submit_info_size);
-        for (int i = 0; i < submit_info_size; ++i)
+        size_t command_buffer_current = 0;
+        size_t wait_semaphore_current = 0;
+        size_t signal_semaphore_current = 0;
+        for (uint32_t i = 0; i < submitCount; ++i)
         {
-            const auto& rhi_submit_info_element = pSubmits[i];
-            auto& vk_submit_info_element = vk_submit_info_list[i];
-
-            vk_submit_info_element.sType = (VkStructureType)rhi_submit_info_element.sType;
-            vk_submit_info_element.pNext = (const void*)rhi_submit_info_element.pNext;
+            const auto& rhi_submit_info = pSubmits[i];
+            auto& vk_submit_info = scratch.submit_infos[i];
 
-            //command_buffer
-            if (rhi_submit_info_element.commandBufferCount > 0)
-            {
-                vk_submit_info_element.commandBufferCount = rhi_submit_info_element.commandBufferCount;
-                vk_submit_info_element.pCommandBuffers = &vk_command_buffer_list_external[command_buffer_size_current];
-                int command_buffer_size = rhi_submit_info_element.commandBufferCount;
-                for (int i = 0; i < command_buffer_size; ++i)
-                {
-                    const auto& rhi_command_buffer_element = rhi_submit_info_element.pCommandBuffers[i];
-                    auto& vk_command_buffer_element = vk_command_buffer_list_external[command_buffer_size_current];
-
-                    vk_command_buffer_element = ((VulkanCommandBuffer*)rhi_command_buffer_element)->getResource();
-
-                    command_buffer_size_current++;
-                };
-            }
+            vk_submit_info.sType = (VkStructureType)rhi_submit_info.sType;
+            vk_submit_info.pNext = (const void*)rhi_submit_info.pNext;
 
-            //semaphore
-            if (rhi_submit_info_element.waitSemaphoreCount > 0)
+            vk_submit_info.commandBufferCount = rhi_submit_info.commandBufferCount;
+            vk_submit_info.pCommandBuffers = rhi_submit_info.commandBufferCount > 0 ? &scratch.command_buffers[command_buffer_current] : nullptr;
+            for (uint32_t j = 0; j < rhi_submit_info.commandBufferCount; ++j)
             {
-                vk_submit_info_element.waitSemaphoreCount = rhi_submit_info_element.waitSemaphoreCount;
-                vk_submit_info_element.pWaitSemaphores = &vk_semaphore_list_external[semaphore_size_current];
-                int semaphore_size = rhi_submit_info_element.waitSemaphoreCount;
-                for (int i = 0; i < semaphore_size; ++i)
-                {
-                    const auto& rhi_semaphore_element = rhi_submit_info_element.pWaitSemaphores[i];
-                    auto& vk_semaphore_element = vk_semaphore_list_external[semaphore_size_current];
-
-                    vk_semaphore_element = ((VulkanSemaphore*)rhi_semaphore_element)->getResource();
-
-                    semaphore_size_current++;
-                };
+                scratch.command_buffers[command_buffer_current++] = ((VulkanCommandBuffer*)rhi_submit_info.pCommandBuffers[j])->getResource();
             }
 
-            //signal_semaphore
-            if (rhi_submit_info_element.signalSemaphoreCount > 0)
+            // 等待阶段掩码与VkPipelineStageFlags类型一致，直接传递
+            vk_submit_info.waitSemaphoreCount = rhi_submit_info.waitSemaphoreCount;
+            vk_submit_info.pWaitSemaphores = rhi_submit_info.waitSemaphoreCount > 0 ? &scratch.wait_semaphores[wait_semaphore_current] : nullptr;
+            vk_submit_info.pWaitDstStageMask = rhi_submit_info.waitSemaphoreCount > 0 ? rhi_submit_info.pWaitDstStageMask : nullptr;
+            for (uint32_t j = 0; j < rhi_submit_info.waitSemaphoreCount; ++j)
             {
-                vk_submit_info_element.signalSemaphoreCount = rhi_submit_info_element.signalSemaphoreCount;
-                vk_submit_info_element.pSignalSemaphores = &vk_signal_semaphore_list_external[signal_semaphore_size_current];
-                int signal_semaphore_size = rhi_submit_info_element.signalSemaphoreCount;
-                for (int i = 0; i < signal_semaphore_size; ++i)
-                {
-                    const auto& rhi_signal_semaphore_element = rhi_submit_info_element.pSignalSemaphores[i];
-                    auto& vk_signal_semaphore_element = vk_signal_semaphore_list_external[signal_semaphore_size_current];
-
-                    vk_signal_semaphore_element = ((VulkanSemaphore*)rhi_signal_semaphore_element)->getResource();
-
-                    signal_semaphore_size_current++;
-                };
+                scratch.wait_semaphores[wait_semaphore_current++] = ((VulkanSemaphore*)rhi_submit_info.pWaitSemaphores[j])->getResource();
             }
 
-            //pipeline_stage_flags
-            if (rhi_submit_info_element.waitSemaphoreCount > 0)
+            vk_submit_info.signalSemaphoreCount = rhi_submit_info.signalSemaphoreCount;
+            vk_submit_info.pSignalSemaphores = rhi_submit_info.signalSemaphoreCount > 0 ? &scratch.signal_semaphores[signal_semaphore_current] : nullptr;
+            for (uint32_t j = 0; j < rhi_submit_info.signalSemaphoreCount; ++j)
             {
-                vk_submit_info_element.pWaitDstStageMask = &vk_pipeline_stage_flags_list_external[pipeline_stage_flags_size_current];
-                int pipeline_stage_flags_size = rhi_submit_info_element.waitSemaphoreCount;
-                for (int i = 0; i < pipeline_stage_flags_size; ++i)
-                {
-                    const auto& rhi_pipeline_stage_flags_element = rhi_submit_info_element.pWaitDstStageMask[i];
-                    auto& vk_pipeline_stage_flags_element = vk_pipeline_stage_flags_list_external[pipeline_stage_flags_size_current];
-
-                    vk_pipeline_stage_flags_element = (VkPipelineStageFlags)rhi_pipeline_stage_flags_element;
-
-                    pipeline_stage_flags_size_current++;
-                };
+                scratch.signal_semaphores[signal_semaphore_current++] = ((VulkanSemaphore*)rhi_submit_info.pSignalSemaphores[j])->getResource();
             }
-        };
-        
-
-        if ((command_buffer_size_total != command_buffer_size_current)
-            || (semaphore_size_total != semaphore_size_current)
-            || (signal_semaphore_size_total != signal_semaphore_size_current)
-            || (pipeline_stage_flags_size_total != pipeline_stage_flags_size_current))
-        {
-            LOG_ERROR("submit info is not right!");
-            return false;
         }
 
         VkFence vk_fence = VK_NULL_HANDLE;
@@ -3590,7 +4085,21 @@ namespace Elish
             vk_fence = ((VulkanFence*)fence)->getResource();
         }
 
-        VkResult result = vkQueueSubmit(((VulkanQueue*)queue)->getResource(), submitCount, vk_submit_info_list.data(), vk_fence);
+        // 前面的批次原样提交，最后一个批次追加时间线信号：信号操作覆盖提交顺序中此前的全部命令
+        VkResult result = VK_SUCCESS;
+        if (submitCount > 1)
+        {
+            result = vkQueueSubmit(((VulkanQueue*)queue)->getResource(), submitCount - 1, scratch.submit_infos.data(), VK_NULL_HANDLE);
+        }
+        if (result == VK_SUCCESS && submitCount > 0)
+        {
+            uint64_t signal_value = 0;
+            result = submitWithTimeline(queue, scratch.submit_infos[submitCount - 1], vk_fence, signal_value);
+        }
+        else if (result == VK_SUCCESS && vk_fence != VK_NULL_HANDLE)
+        {
+            result = vkQueueSubmit(((VulkanQueue*)queue)->getResource(), 0, nullptr, vk_fence);
+        }
 
         if (result == VK_SUCCESS)
         {
@@ -3605,10 +4114,21 @@ namespace Elish
 
     bool VulkanRHI::queueWaitIdle(RHIQueue* queue)
     {
+        // 队列上的提交都带时间线信号时，等待最后一次提交的值即等价于队列空闲
+        QueueTimeline* timeline = getQueueTimeline(queue);
+        if (timeline && !timeline->has_unsignaled_submit)
+        {
+            return waitForTimeline(*timeline, timeline->submitted_value, UINT64_MAX);
+        }
+
         VkResult result = vkQueueWaitIdle(((VulkanQueue*)queue)->getResource());
 
         if (result == VK_SUCCESS)
         {
+            if (timeline)
+            {
+                timeline->has_unsignaled_submit = false;
+            }
             return true;
         }
         else
@@ -3630,21 +4150,6 @@ namespace Elish
         const RHIImageMemoryBarrier* pImageMemoryBarriers)
     {
 
-        //memory_barrier
-        int memory_barrier_size = memoryBarrierCount;
-        std::vector<VkMemoryBarrier> vk_memory_barrier_list(memory_barrier_size);
-        for (int i = 0; i < memory_barrier_size; ++i)
-        {
-            const auto& rhi_memory_barrier_element = pMemoryBarriers[i];
-            auto& vk_memory_barrier_element = vk_memory_barrier_list[i];
-
-
-            vk_memory_barrier_element.sType = (VkStructureType)rhi_memory_barrier_element.sType;
-            vk_memory_barrier_element.pNext = (const void*)rhi_memory_barrier_element.pNext;
-            vk_memory_barrier_element.srcAccessMask = (VkAccessFlags)rhi_memory_barrier_element.srcAccessMask;
-            vk_memory_barrier_element.dstAccessMask = (VkAccessFlags)rhi_memory_barrier_element.dstAccessMask;
-        };
-
         //buffer_memory_barrier
         int buffer_memory_barrier_size = bufferMemoryBarrierCount;
         std::vector<VkBufferMemoryBarrier> vk_buffer_memory_barrier_list(buffer_memory_barrier_size);
@@ -3697,7 +4202,7 @@ namespace Elish
             (RHIPipelineStageFlags)dstStageMask,
             (RHIDependencyFlags)dependencyFlags,
             memoryBarrierCount,
-            vk_memory_barrier_list.data(),
+            vulkanCast(pMemoryBarriers),
             bufferMemoryBarrierCount,
             vk_buffer_memory_barrier_list.data(),
             imageMemoryBarrierCount,
@@ -3708,6 +4213,35 @@ namespace Elish
     {
         vkCmdDraw(((VulkanCommandBuffer*)commandBuffer)->getResource(), vertexCount, instanceCount, firstVertex, firstInstance);
     }
+
+    void VulkanRHI::cmdExecuteCommands(RHICommandBuffer* commandBuffer, uint32_t commandBufferCount, RHICommandBuffer* const* pCommandBuffers)
+    {
+        VulkanConversionScratch& scratch = getConversionScratch();
+        scratch.command_buffers.resize(commandBufferCount);
+        for (uint32_t i = 0; i < commandBufferCount; ++i)
+        {
+            scratch.command_buffers[i] = ((VulkanCommandBuffer*)pCommandBuffers[i])->getResource();
+        }
+        vkCmdExecuteCommands(((VulkanCommandBuffer*)commandBuffer)->getResource(), commandBufferCount, scratch.command_buffers.data());
+    }
+
+    void VulkanRHI::cmdPushDescriptorSet(RHICommandBuffer* commandBuffer, RHIPipelineBindPoint pipelineBindPoint, RHIPipelineLayout* layout, uint32_t set, uint32_t descriptorWriteCount, const RHIWriteDescriptorSet* pDescriptorWrites)
+    {
+        cmdPushDescriptorSetNative(((VulkanCommandBuffer*)commandBuffer)->getResource(), (VkPipelineBindPoint)pipelineBindPoint,
+                                   ((VulkanPipelineLayout*)layout)->getResource(), set, descriptorWriteCount, pDescriptorWrites);
+    }
+
+    void VulkanRHI::cmdPushDescriptorSetNative(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout layout, uint32_t set, uint32_t descriptorWriteCount, const RHIWriteDescriptorSet* pDescriptorWrites) const
+    {
+        if (!_vkCmdPushDescriptorSetKHR)
+        {
+            LOG_ERROR("[VulkanRHI] vkCmdPushDescriptorSetKHR is unavailable, push descriptors are not supported on this device");
+            return;
+        }
+        VulkanConversionScratch& scratch = getConversionScratch();
+        convertWriteDescriptorSets(scratch, descriptorWriteCount, pDescriptorWrites);
+        _vkCmdPushDescriptorSetKHR(commandBuffer, pipelineBindPoint, layout, set, descriptorWriteCount, scratch.write_descriptor_sets.data());
+    }
     
     void VulkanRHI::cmdDispatch(RHICommandBuffer* commandBuffer, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
     {
@@ -3727,53 +4261,30 @@ namespace Elish
         uint32_t regionCount,
         const RHIBufferImageCopy* pRegions)
     {
-        //buffer_image_copy
-        int buffer_image_copy_size = regionCount;
-        std::vector<VkBufferImageCopy> vk_buffer_image_copy_list(buffer_image_copy_size);
-        for (int i = 0; i < buffer_image_copy_size; ++i)
-        {
-            const auto& rhi_buffer_image_copy_element = pRegions[i];
-            auto& vk_buffer_image_copy_element = vk_buffer_image_copy_list[i];
-
-            VkImageSubresourceLayers image_subresource_layers{};
-            image_subresource_layers.aspectMask = (VkImageAspectFlags)rhi_buffer_image_copy_element.imageSubresource.aspectMask;
-            image_subresource_layers.mipLevel = rhi_buffer_image_copy_element.imageSubresource.mipLevel;
-            image_subresource_layers.baseArrayLayer = rhi_buffer_image_copy_element.imageSubresource.baseArrayLayer;
-            image_subresource_layers.layerCount = rhi_buffer_image_copy_element.imageSubresource.layerCount;
-
-            VkOffset3D offset_3d{};
-            offset_3d.x = rhi_buffer_image_copy_element.imageOffset.x;
-            offset_3d.y = rhi_buffer_image_copy_element.imageOffset.y;
-            offset_3d.z = rhi_buffer_image_copy_element.imageOffset.z;
-
-            VkExtent3D extent_3d{};
-            extent_3d.width = rhi_buffer_image_copy_element.imageExtent.width;
-            extent_3d.height = rhi_buffer_image_copy_element.imageExtent.height;
-            extent_3d.depth = rhi_buffer_image_copy_element.imageExtent.depth;
-
-            VkBufferImageCopy buffer_image_copy{};
-            buffer_image_copy.bufferOffset = (VkDeviceSize)rhi_buffer_image_copy_element.bufferOffset;
-            buffer_image_copy.bufferRowLength = rhi_buffer_image_copy_element.bufferRowLength;
-            buffer_image_copy.bufferImageHeight = rhi_buffer_image_copy_element.bufferImageHeight;
-            buffer_image_copy.imageSubresource = image_subresource_layers;
-            buffer_image_copy.imageOffset = offset_3d;
-            buffer_image_copy.imageExtent = extent_3d;
-
-            vk_buffer_image_copy_element.bufferOffset = (VkDeviceSize)rhi_buffer_image_copy_element.bufferOffset;
-            vk_buffer_image_copy_element.bufferRowLength = rhi_buffer_image_copy_element.bufferRowLength;
-            vk_buffer_image_copy_element.bufferImageHeight = rhi_buffer_image_copy_element.bufferImageHeight;
-            vk_buffer_image_copy_element.imageSubresource = image_subresource_layers;
-            vk_buffer_image_copy_element.imageOffset = offset_3d;
-            vk_buffer_image_copy_element.imageExtent = extent_3d;
-        };
-
         vkCmdCopyImageToBuffer(
             ((VulkanCommandBuffer*)commandBuffer)->getResource(),
             ((VulkanImage*)srcImage)->getResource(),
             (VkImageLayout)srcImageLayout,
             ((VulkanBuffer*)dstBuffer)->getResource(),
             regionCount,
-            vk_buffer_image_copy_list.data());
+            vulkanCast(pRegions));
+    }
+
+    void VulkanRHI::cmdCopyBufferToImage(
+        RHICommandBuffer* commandBuffer,
+        RHIBuffer* srcBuffer,
+        RHIImage* dstImage,
+        RHIImageLayout dstImageLayout,
+        uint32_t regionCount,
+        const RHIBufferImageCopy* pRegions)
+    {
+        vkCmdCopyBufferToImage(
+            ((VulkanCommandBuffer*)commandBuffer)->getResource(),
+            ((VulkanBuffer*)srcBuffer)->getResource(),
+            ((VulkanImage*)dstImage)->getResource(),
+            (VkImageLayout)dstImageLayout,
+            regionCount,
+            vulkanCast(pRegions));
     }
 
     void VulkanRHI::cmdCopyImageToImage(RHICommandBuffer* commandBuffer, RHIImage* srcImage, RHIImageAspectFlagBits srcFlag, RHIImage* dstImage, RHIImageAspectFlagBits dstFlag, uint32_t width, uint32_t height)
@@ -3802,21 +4313,11 @@ namespace Elish
 
     void VulkanRHI::cmdCopyBuffer(RHICommandBuffer* commandBuffer, RHIBuffer* srcBuffer, RHIBuffer* dstBuffer, uint32_t regionCount, RHIBufferCopy* pRegions)
     {
-        VkBufferCopy copyRegion{};
-        copyRegion.srcOffset = pRegions->srcOffset;
-        copyRegion.dstOffset = pRegions->dstOffset;
-        copyRegion.size = pRegions->size;
-
-        LOG_INFO("[VulkanRHI] Starting buffer copy operation - Size: {} bytes, SrcOffset: {}, DstOffset: {}", 
-                 copyRegion.size, copyRegion.srcOffset, copyRegion.dstOffset);
-
         vkCmdCopyBuffer(((VulkanCommandBuffer*)commandBuffer)->getResource(),
             ((VulkanBuffer*)srcBuffer)->getResource(),
             ((VulkanBuffer*)dstBuffer)->getResource(),
             regionCount,
-            &copyRegion);
-
-        LOG_INFO("[VulkanRHI] Buffer copy command recorded successfully");
+            vulkanCast(pRegions));
     }
 
     void VulkanRHI::createCommandBuffers()
@@ -3912,6 +4413,55 @@ namespace Elish
             m_rhi_is_frame_in_flight_fences[i] = new VulkanFence();
             ((VulkanFence*)m_rhi_is_frame_in_flight_fences[i])->setResource(m_is_frame_in_flight_fences[i]);
         }
+
+        // 图形/计算队列各一条时间线信号量（初始值0，每次提交信号值递增）
+        if (m_timeline_semaphore_supported)
+        {
+            VkSemaphoreTypeCreateInfoKHR semaphore_type_create_info {};
+            semaphore_type_create_info.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+            semaphore_type_create_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+            semaphore_type_create_info.initialValue  = 0;
+
+            VkSemaphoreCreateInfo timeline_create_info {};
+            timeline_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            timeline_create_info.pNext = &semaphore_type_create_info;
+
+            for (QueueTimeline* timeline : { &m_graphics_timeline, &m_compute_timeline })
+            {
+                if (vkCreateSemaphore(m_device, &timeline_create_info, nullptr, &timeline->semaphore) != VK_SUCCESS)
+                {
+                    LOG_ERROR("vk create queue timeline semaphore");
+                    timeline->semaphore = VK_NULL_HANDLE;
+                }
+            }
+        }
+
+        // GPU时间戳查询池（图形队列需支持时间戳）
+        uint32_t queue_family_count = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(m_physical_device, &queue_family_count, nullptr);
+        std::vector<VkQueueFamilyProperties> queue_families(queue_family_count);
+        vkGetPhysicalDeviceQueueFamilyProperties(m_physical_device, &queue_family_count, queue_families.data());
+
+        VkPhysicalDeviceProperties physical_device_properties {};
+        vkGetPhysicalDeviceProperties(m_physical_device, &physical_device_properties);
+
+        uint32_t graphics_family = m_queue_indices.graphics_family.value();
+        if (graphics_family < queue_family_count && queue_families[graphics_family].timestampValidBits > 0 &&
+            physical_device_properties.limits.timestampPeriod > 0.0f)
+        {
+            m_timestamp_period_ns = physical_device_properties.limits.timestampPeriod;
+
+            VkQueryPoolCreateInfo query_pool_create_info {};
+            query_pool_create_info.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            query_pool_create_info.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+            query_pool_create_info.queryCount = k_gpu_timestamp_query_count;
+
+            if (vkCreateQueryPool(m_device, &query_pool_create_info, nullptr, &m_gpu_timestamp_query_pool) != VK_SUCCESS)
+            {
+                LOG_ERROR("vk create timestamp query pool");
+                m_gpu_timestamp_query_pool = VK_NULL_HANDLE;
+            }
+        }
     }
 
     void VulkanRHI::createFramebufferImageAndView()
@@ -4258,7 +4808,15 @@ namespace Elish
         }
         else
         {
-            LOG_ERROR("vkAllocateDescriptorSets failed with result: {}", static_cast<int>(result));
+            // 池耗尽由调用方（如DescriptorAllocator扩展池链）处理，不按错误上报
+            if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL)
+            {
+                LOG_DEBUG("vkAllocateDescriptorSets: descriptor pool exhausted ({})", static_cast<int>(result));
+            }
+            else
+            {
+                LOG_ERROR("vkAllocateDescriptorSets failed with result: {}", static_cast<int>(result));
+            }
             // 清理已分配的内存
             if (pDescriptorSets) {
                 delete pDescriptorSets;
@@ -4278,7 +4836,7 @@ namespace Elish
         command_buffer_allocate_info.commandBufferCount = pAllocateInfo->commandBufferCount;
 
         VkCommandBuffer vk_command_buffer;
-        pCommandBuffers = new RHICommandBuffer();
+        pCommandBuffers = new VulkanCommandBuffer();
         VkResult result = vkAllocateCommandBuffers(m_device, &command_buffer_allocate_info, &vk_command_buffer);
         ((VulkanCommandBuffer*)pCommandBuffers)->setResource(vk_command_buffer);
 
@@ -4474,6 +5032,15 @@ namespace Elish
         }
     }
 
+    void VulkanRHI::destroyDescriptorPool(RHIDescriptorPool* descriptorPool)
+    {
+        if (descriptorPool)
+        {
+            vkDestroyDescriptorPool(m_device, ((VulkanDescriptorPool*)descriptorPool)->getResource(), nullptr);
+            delete descriptorPool;
+        }
+    }
+
     void VulkanRHI::freeCommandBuffers(RHICommandPool* commandPool, uint32_t commandBufferCount, RHICommandBuffer* pCommandBuffers)
     {
         VkCommandBuffer vk_command_buffer = ((VulkanCommandBuffer*)pCommandBuffers)->getResource();
@@ -4542,12 +5109,24 @@ namespace Elish
             glfwWaitEvents();
         }
 
-        VkResult res_wait_for_fences =
-            _vkWaitForFences(m_device, k_max_frames_in_flight, m_is_frame_in_flight_fences, VK_TRUE, UINT64_MAX);
-        if (VK_SUCCESS != res_wait_for_fences)
+        if (m_graphics_timeline.semaphore != VK_NULL_HANDLE)
         {
-            LOG_ERROR("_vkWaitForFences failed");
-            return;
+            // 所有在途帧都在图形时间线上，等待最近一次提交即可
+            if (!waitForTimeline(m_graphics_timeline, m_graphics_timeline.submitted_value, UINT64_MAX))
+            {
+                LOG_ERROR("waiting for graphics timeline failed");
+                return;
+            }
+        }
+        else
+        {
+            VkResult res_wait_for_fences =
+                _vkWaitForFences(m_device, k_max_frames_in_flight, m_is_frame_in_flight_fences, VK_TRUE, UINT64_MAX);
+            if (VK_SUCCESS != res_wait_for_fences)
+            {
+                LOG_ERROR("_vkWaitForFences failed");
+                return;
+            }
         }
         // Destroying old resources
         destroyImageView(m_depth_image_view);
@@ -5015,6 +5594,29 @@ namespace Elish
         return RHI_FALSE;
     }
 
+    /**
+     * @brief 重置描述符池，从该池分配的所有描述符集一并回收
+     */
+    bool VulkanRHI::resetDescriptorPool(RHIDescriptorPool* descriptorPool)
+    {
+        VkResult result = vkResetDescriptorPool(m_device, ((VulkanDescriptorPool*)descriptorPool)->getResource(), 0);
+        if (result != VK_SUCCESS)
+        {
+            LOG_ERROR("[VulkanRHI] vkResetDescriptorPool failed with result: {}", static_cast<int>(result));
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 释放描述符集的句柄包装对象
+     * @details 底层VkDescriptorSet由所属池的重置或销毁统一回收
+     */
+    void VulkanRHI::releaseDescriptorSet(RHIDescriptorSet* descriptorSet)
+    {
+        delete (VulkanDescriptorSet*)descriptorSet;
+    }
+
     /**
      * @brief 创建缓冲区
      * @param create_info 创建信息
@@ -8,6 +8,7 @@
 
 #include <functional>
 #include <map>
+#include <deque>
 #include <vector>
 
 namespace Elish
@@ -65,6 +66,8 @@ namespace Elish
         
         // 内存管理相关接口
         RHIResult allocateDescriptorSets(RHIDescriptorSetLayout* layout, RHIDescriptorSet*& descriptor_set) override;
+        bool resetDescriptorPool(RHIDescriptorPool* descriptorPool) override;
+        void releaseDescriptorSet(RHIDescriptorSet* descriptorSet) override;
         RHIResult createBuffer(const RHIBufferCreateInfo* create_info, RHIBuffer*& buffer) override;
         RHIResult createImageView(const RHIImageViewCreateInfo* create_info, RHIImageView*& image_view) override;
         void getBufferMemoryRequirements(RHIBuffer* buffer, RHIMemoryRequirements* pMemoryRequirements) override;
@@ -80,6 +83,13 @@ namespace Elish
         bool buildAccelerationStructure(RHICommandBuffer* commandBuffer, const RHIAccelerationStructureBuildInfo* pBuildInfo) override;
         void getAccelerationStructureDeviceAddress(const RHIAccelerationStructureDeviceAddressInfo* pInfo, RHIDeviceAddress* pAddress) override;
         void getAccelerationStructureBuildSizes(const RHIAccelerationStructureBuildGeometryInfoKHR* pBuildInfo, const uint32_t* pMaxPrimitiveCounts, RHIAccelerationStructureBuildSizesInfoKHR* pSizeInfo) override;
+        void destroyAccelerationStructure(RHIAccelerationStructure* accelerationStructure) override;
+        void cmdCopyAccelerationStructure(RHICommandBuffer* commandBuffer, RHIAccelerationStructure* src, RHIAccelerationStructure* dst, RHICopyAccelerationStructureModeKHR mode) override;
+        void cmdCopyAccelerationStructureToMemory(RHICommandBuffer* commandBuffer, RHIAccelerationStructure* src, RHIDeviceAddress dst) override;
+        void cmdCopyMemoryToAccelerationStructure(RHICommandBuffer* commandBuffer, RHIDeviceAddress src, RHIAccelerationStructure* dst) override;
+        bool queryAccelerationStructureSizes(uint32_t count, RHIAccelerationStructure* const* pAccelerationStructures, RHIAccelerationStructureQueryTypeKHR queryType, RHIDeviceSize* pSizes) override;
+        bool isAccelerationStructureCompatible(const uint8_t* pVersionData) override;
+        void getDeviceUUIDs(uint8_t deviceUUID[RHI_UUID_SIZE], uint8_t driverUUID[RHI_UUID_SIZE]) override;
         RHIDeviceAddress getBufferDeviceAddress(RHIBuffer* buffer) override;
         
         // 光线追踪着色器绑定表相关接口
@@ -133,10 +143,15 @@ namespace Elish
 
         bool beginCommandBuffer(RHICommandBuffer* commandBuffer, const RHICommandBufferBeginInfo* pBeginInfo) override;
         void cmdCopyImageToBuffer(RHICommandBuffer* commandBuffer, RHIImage* srcImage, RHIImageLayout srcImageLayout, RHIBuffer* dstBuffer, uint32_t regionCount, const RHIBufferImageCopy* pRegions) override;
+        void cmdCopyBufferToImage(RHICommandBuffer* commandBuffer, RHIBuffer* srcBuffer, RHIImage* dstImage, RHIImageLayout dstImageLayout, uint32_t regionCount, const RHIBufferImageCopy* pRegions) override;
         void cmdCopyImageToImage(RHICommandBuffer* commandBuffer, RHIImage* srcImage, RHIImageAspectFlagBits srcFlag, RHIImage* dstImage, RHIImageAspectFlagBits dstFlag, uint32_t width, uint32_t height) override;
         void cmdCopyImageToImage(RHICommandBuffer* commandBuffer, RHIImage* srcImage, RHIImageLayout srcLayout, RHIImageAspectFlagBits srcFlag, RHIImage* dstImage, RHIImageLayout dstLayout, RHIImageAspectFlagBits dstFlag, uint32_t width, uint32_t height);
         void cmdCopyBuffer(RHICommandBuffer* commandBuffer, RHIBuffer* srcBuffer, RHIBuffer* dstBuffer, uint32_t regionCount, RHIBufferCopy* pRegions) override;
         void cmdDraw(RHICommandBuffer* commandBuffer, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) override;
+        void cmdExecuteCommands(RHICommandBuffer* commandBuffer, uint32_t commandBufferCount, RHICommandBuffer* const* pCommandBuffers) override;
+        void cmdPushDescriptorSet(RHICommandBuffer* commandBuffer, RHIPipelineBindPoint pipelineBindPoint, RHIPipelineLayout* layout, uint32_t set, uint32_t descriptorWriteCount, const RHIWriteDescriptorSet* pDescriptorWrites) override;
+        // 原生句柄版本，供VulkanCommandList在录制循环内直接使用
+        void cmdPushDescriptorSetNative(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout layout, uint32_t set, uint32_t descriptorWriteCount, const RHIWriteDescriptorSet* pDescriptorWrites) const;
         void cmdDispatch(RHICommandBuffer* commandBuffer, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override;
         void cmdDispatchIndirect(RHICommandBuffer* commandBuffer, RHIBuffer* buffer, RHIDeviceSize offset) override;
         void cmdPipelineBarrier(RHICommandBuffer* commandBuffer, RHIPipelineStageFlags srcStageMask, RHIPipelineStageFlags dstStageMask, RHIDependencyFlags dependencyFlags, uint32_t memoryBarrierCount, const RHIMemoryBarrier* pMemoryBarriers, uint32_t bufferMemoryBarrierCount, const RHIBufferMemoryBarrier* pBufferMemoryBarriers, uint32_t imageMemoryBarrierCount, const RHIImageMemoryBarrier* pImageMemoryBarriers) override;
@@ -191,6 +206,7 @@ namespace Elish
         void destroyBuffer(RHIBuffer* &buffer) override;
         void destroyPipeline(RHIPipeline* pipeline) override;
         void destroyPipelineLayout(RHIPipelineLayout* pipelineLayout) override;
+        void destroyDescriptorPool(RHIDescriptorPool* descriptorPool) override;
         void freeCommandBuffers(RHICommandPool* commandPool, uint32_t commandBufferCount, RHICommandBuffer* pCommandBuffers) override;
 
         // memory
@@ -202,6 +218,23 @@ namespace Elish
         
         //semaphores
         RHISemaphore* &getTextureCopySemaphore(uint32_t index) override;
+
+        // 异步提交（时间线信号量）
+        bool isAsyncSubmitSupported() override { return m_graphics_timeline.semaphore != VK_NULL_HANDLE; }
+        RHICommandBuffer* beginAsyncCommands() override;
+        uint64_t submitAsyncCommands(RHICommandBuffer* command_buffer) override;
+        uint64_t getCompletedAsyncValue() override;
+        bool waitForAsyncValue(uint64_t value, uint64_t timeout_ns) override;
+        uint64_t getSubmittedTimelineValue(RHIQueue* queue) override;
+        uint64_t getCompletedTimelineValue(RHIQueue* queue) override;
+        bool waitForTimelineValue(RHIQueue* queue, uint64_t value, uint64_t timeout_ns) override;
+
+        // GPU时间戳查询
+        bool isGpuTimestampSupported() override { return m_gpu_timestamp_query_pool != VK_NULL_HANDLE; }
+        uint32_t getGpuTimestampQueryCount() const override { return k_gpu_timestamp_query_count; }
+        void cmdResetGpuTimestamps(RHICommandBuffer* commandBuffer, uint32_t firstQuery, uint32_t queryCount) override;
+        void cmdWriteGpuTimestamp(RHICommandBuffer* commandBuffer, RHIPipelineStageFlagBits stage, uint32_t query) override;
+        bool getGpuTimestampsNs(uint32_t firstQuery, uint32_t queryCount, uint64_t* pTimestampsNs) override;
     public:
         static uint8_t const k_max_frames_in_flight {3};
 
@@ -267,6 +300,7 @@ namespace Elish
         PFN_vkCmdDrawIndexed        _vkCmdDrawIndexed;
         PFN_vkCmdClearAttachments   _vkCmdClearAttachments;
         PFN_vkCmdPushConstants      _vkCmdPushConstants;
+        PFN_vkCmdPushDescriptorSetKHR _vkCmdPushDescriptorSetKHR{ nullptr };
         
         // 光线追踪相关函数指针
         PFN_vkCreateAccelerationStructureKHR _vkCreateAccelerationStructureKHR;
@@ -274,10 +308,19 @@ namespace Elish
         PFN_vkGetAccelerationStructureDeviceAddressKHR _vkGetAccelerationStructureDeviceAddressKHR;
         PFN_vkGetAccelerationStructureBuildSizesKHR _vkGetAccelerationStructureBuildSizesKHR;
         PFN_vkCmdBuildAccelerationStructuresKHR _vkCmdBuildAccelerationStructuresKHR;
+        PFN_vkCmdCopyAccelerationStructureKHR _vkCmdCopyAccelerationStructureKHR{ nullptr };
+        PFN_vkCmdCopyAccelerationStructureToMemoryKHR _vkCmdCopyAccelerationStructureToMemoryKHR{ nullptr };
+        PFN_vkCmdCopyMemoryToAccelerationStructureKHR _vkCmdCopyMemoryToAccelerationStructureKHR{ nullptr };
+        PFN_vkCmdWriteAccelerationStructuresPropertiesKHR _vkCmdWriteAccelerationStructuresPropertiesKHR{ nullptr };
+        PFN_vkGetDeviceAccelerationStructureCompatibilityKHR _vkGetDeviceAccelerationStructureCompatibilityKHR{ nullptr };
         PFN_vkCreateRayTracingPipelinesKHR _vkCreateRayTracingPipelinesKHR;
         PFN_vkGetRayTracingShaderGroupHandlesKHR _vkGetRayTracingShaderGroupHandlesKHR;
         PFN_vkCmdTraceRaysKHR _vkCmdTraceRaysKHR;
 
+        // 时间线信号量相关函数指针
+        PFN_vkGetSemaphoreCounterValueKHR _vkGetSemaphoreCounterValueKHR{ nullptr };
+        PFN_vkWaitSemaphoresKHR           _vkWaitSemaphoresKHR{ nullptr };
+
         // global descriptor pool
         VkDescriptorPool m_vk_descriptor_pool;
 
@@ -325,7 +368,44 @@ namespace Elish
         VkPhysicalDeviceAccelerationStructureFeaturesKHR m_as_features{};
         VkPhysicalDeviceBufferDeviceAddressFeaturesKHR m_buffer_device_address_features{};
         VkPhysicalDeviceDescriptorIndexingFeaturesEXT m_descriptor_indexing_features{};
+        VkPhysicalDeviceRayQueryFeaturesKHR m_ray_query_features{};
         bool m_ray_tracing_supported{ false };
+        bool m_ray_query_supported{ false };      // 光线查询（片段/计算着色器内追踪）是否可用
+        VkPhysicalDevicePushDescriptorPropertiesKHR m_push_descriptor_properties{};
+        bool m_push_descriptor_supported{ false };   // VK_KHR_push_descriptor是否启用
+
+        // 队列时间线：每个队列一条时间线信号量，该队列上的每次提交递增信号值
+        struct QueueTimeline {
+            VkSemaphore semaphore{ VK_NULL_HANDLE };
+            uint64_t submitted_value{ 0 };                                 // 最近一次提交的信号值
+            bool has_unsignaled_submit{ false };                           // 最近一次信号之后存在未携带时间线信号的提交
+        };
+        struct PendingAsyncCommandBuffer {
+            uint64_t timeline_value;
+            VkCommandBuffer command_buffer;
+        };
+        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR m_timeline_semaphore_features{};
+        bool m_timeline_semaphore_supported{ false };
+        QueueTimeline m_graphics_timeline;
+        QueueTimeline m_compute_timeline;
+        uint64_t m_frame_timeline_values[k_max_frames_in_flight]{};        // 各帧提交时的图形时间线值，替代帧围栏
+        std::deque<PendingAsyncCommandBuffer> m_pending_async_command_buffers; // 等待GPU完成后回收
+
+        QueueTimeline* getQueueTimeline(RHIQueue* queue);
+        /**
+         * @brief 提交并在队列时间线上追加一次信号
+         * @details submit_info原有的二值信号量保持不变；时间线不可用或submit_info已带pNext时按原样提交
+         * @param signal_value 输出本次提交的时间线值，未追加信号时为0
+         */
+        VkResult submitWithTimeline(RHIQueue* queue, const VkSubmitInfo& submit_info, VkFence fence, uint64_t& signal_value);
+        bool waitForTimeline(QueueTimeline& timeline, uint64_t value, uint64_t timeout_ns);
+
+        // GPU时间戳查询池
+        static constexpr uint32_t k_gpu_timestamp_query_count = 32;
+        VkQueryPool m_gpu_timestamp_query_pool{ VK_NULL_HANDLE };
+        float m_timestamp_period_ns{ 1.0f };                               // 每个时间戳刻度对应的纳秒数
+
+        void recycleAsyncCommandBuffers(uint64_t completed_value);
 
     private:
         void createInstance();
@@ -347,6 +427,8 @@ namespace Elish
         
         // 光线追踪相关查询接口
         bool isRayTracingSupported() override { return m_ray_tracing_supported; }
+        bool isRayQuerySupported() override { return m_ray_query_supported; }
+        uint32_t getMaxPushDescriptors() override { return m_push_descriptor_supported ? m_push_descriptor_properties.maxPushDescriptors : 0; }
         const VkPhysicalDeviceRayTracingPipelinePropertiesKHR& getRayTracingPipelineProperties() const { return m_rt_pipeline_properties; }
         const VkPhysicalDeviceAccelerationStructurePropertiesKHR& getAccelerationStructureProperties() const { return m_as_properties; }
 
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "../rhi_struct.h"
+
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace Elish
+{
+    /**
+     * @brief RHI结构体与Vulkan结构体的二进制兼容映射
+     * @details 只有在本文件中声明并通过大小/偏移静态断言的结构体，才允许用vulkanCast()直接按Vulkan类型传递，
+     *          避免逐字段拷贝到临时std::vector。包含RHI句柄（包装对象指针）的结构体与Vulkan句柄不兼容，
+     *          不能在此声明，仍需逐字段转换
+     */
+    template<typename RHIType>
+    struct VulkanLayoutCompatible;
+
+#define ELISH_VULKAN_LAYOUT_COMPATIBLE(RHIType, VkType)                                              \
+    template<>                                                                                        \
+    struct VulkanLayoutCompatible<RHIType>                                                            \
+    {                                                                                                 \
+        using Type = VkType;                                                                          \
+    };                                                                                                \
+    static_assert(sizeof(RHIType) == sizeof(VkType), #RHIType " size differs from " #VkType);         \
+    static_assert(alignof(RHIType) == alignof(VkType), #RHIType " alignment differs from " #VkType); \
+    static_assert(std::is_standard_layout<RHIType>::value, #RHIType " must be standard layout")
+
+#define ELISH_VULKAN_LAYOUT_FIELD(RHIType, VkType, rhi_field, vk_field) \
+    static_assert(offsetof(RHIType, rhi_field) == offsetof(VkType, vk_field), #RHIType "::" #rhi_field " offset differs from " #VkType)
+
+    // 标志与尺寸类型
+    static_assert(sizeof(RHIFlags) == sizeof(VkFlags), "RHIFlags size differs from VkFlags");
+    static_assert(sizeof(RHIDeviceSize) == sizeof(VkDeviceSize), "RHIDeviceSize size differs from VkDeviceSize");
+    static_assert(sizeof(RHIPipelineStageFlags) == sizeof(VkPipelineStageFlags), "RHIPipelineStageFlags size differs from VkPipelineStageFlags");
+    static_assert(sizeof(RHIStructureType) == sizeof(VkStructureType), "RHIStructureType size differs from VkStructureType");
+
+    ELISH_VULKAN_LAYOUT_COMPATIBLE(RHIOffset2D, VkOffset2D);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIOffset2D, VkOffset2D, x, x);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIOffset2D, VkOffset2D, y, y);
+
+    ELISH_VULKAN_LAYOUT_COMPATIBLE(RHIOffset3D, VkOffset3D);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIOffset3D, VkOffset3D, x, x);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIOffset3D, VkOffset3D, y, y);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIOffset3D, VkOffset3D, z, z);
+
+    ELISH_VULKAN_LAYOUT_COMPATIBLE(RHIExtent2D, VkExtent2D);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIExtent2D, VkExtent2D, width, width);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIExtent2D, VkExtent2D, height, height);
+
+    ELISH_VULKAN_LAYOUT_COMPATIBLE(RHIExtent3D, VkExtent3D);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIExtent3D, VkExtent3D, width, width);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIExtent3D, VkExtent3D, height, height);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIExtent3D, VkExtent3D, depth, depth);
+
+    ELISH_VULKAN_LAYOUT_COMPATIBLE(RHIRect2D, VkRect2D);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIRect2D, VkRect2D, offset, offset);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIRect2D, VkRect2D, extent, extent);
+
+    ELISH_VULKAN_LAYOUT_COMPATIBLE(RHIViewport, VkViewport);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIViewport, VkViewport, x, x);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIViewport, VkViewport, y, y);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIViewport, VkViewport, width, width);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIViewport, VkViewport, height, height);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIViewport, VkViewport, minDepth, minDepth);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIViewport, VkViewport, maxDepth, maxDepth);
+
+    ELISH_VULKAN_LAYOUT_COMPATIBLE(RHIClearRect, VkClearRect);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIClearRect, VkClearRect, rect, rect);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIClearRect, VkClearRect, baseArrayLayer, baseArrayLayer);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIClearRect, VkClearRect, layerCount, layerCount);
+
+    ELISH_VULKAN_LAYOUT_COMPATIBLE(RHIBufferCopy, VkBufferCopy);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIBufferCopy, VkBufferCopy, srcOffset, srcOffset);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIBufferCopy, VkBufferCopy, dstOffset, dstOffset);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIBufferCopy, VkBufferCopy, size, size);
+
+    ELISH_VULKAN_LAYOUT_COMPATIBLE(RHIImageSubresourceLayers, VkImageSubresourceLayers);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIImageSubresourceLayers, VkImageSubresourceLayers, aspectMask, aspectMask);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIImageSubresourceLayers, VkImageSubresourceLayers, mipLevel, mipLevel);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIImageSubresourceLayers, VkImageSubresourceLayers, baseArrayLayer, baseArrayLayer);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIImageSubresourceLayers, VkImageSubresourceLayers, layerCount, layerCount);
+
+    ELISH_VULKAN_LAYOUT_COMPATIBLE(RHIImageSubresourceRange, VkImageSubresourceRange);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIImageSubresourceRange, VkImageSubresourceRange, aspectMask, aspectMask);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIImageSubresourceRange, VkImageSubresourceRange, baseMipLevel, baseMipLevel);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIImageSubresourceRange, VkImageSubresourceRange, levelCount, levelCount);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIImageSubresourceRange, VkImageSubresourceRange, baseArrayLayer, baseArrayLayer);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIImageSubresourceRange, VkImageSubresourceRange, layerCount, layerCount);
+
+    ELISH_VULKAN_LAYOUT_COMPATIBLE(RHIBufferImageCopy, VkBufferImageCopy);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIBufferImageCopy, VkBufferImageCopy, bufferOffset, bufferOffset);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIBufferImageCopy, VkBufferImageCopy, bufferRowLength, bufferRowLength);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIBufferImageCopy, VkBufferImageCopy, bufferImageHeight, bufferImageHeight);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIBufferImageCopy, VkBufferImageCopy, imageSubresource, imageSubresource);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIBufferImageCopy, VkBufferImageCopy, imageOffset, imageOffset);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIBufferImageCopy, VkBufferImageCopy, imageExtent, imageExtent);
+
+    ELISH_VULKAN_LAYOUT_COMPATIBLE(RHIMemoryBarrier, VkMemoryBarrier);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIMemoryBarrier, VkMemoryBarrier, sType, sType);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIMemoryBarrier, VkMemoryBarrier, pNext, pNext);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIMemoryBarrier, VkMemoryBarrier, srcAccessMask, srcAccessMask);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIMemoryBarrier, VkMemoryBarrier, dstAccessMask, dstAccessMask);
+
+    ELISH_VULKAN_LAYOUT_COMPATIBLE(RHIPushConstantRange, VkPushConstantRange);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIPushConstantRange, VkPushConstantRange, stageFlags, stageFlags);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIPushConstantRange, VkPushConstantRange, offset, offset);
+    ELISH_VULKAN_LAYOUT_FIELD(RHIPushConstantRange, VkPushConstantRange, size, size);
+
+#undef ELISH_VULKAN_LAYOUT_FIELD
+#undef ELISH_VULKAN_LAYOUT_COMPATIBLE
+
+    /**
+     * @brief 将布局兼容的RHI结构体数组按对应的Vulkan类型直接传递
+     * @details 未在上方声明兼容的类型会在编译期报错
+     */
+    template<typename RHIType>
+    inline const typename VulkanLayoutCompatible<RHIType>::Type* vulkanCast(const RHIType* value)
+    {
+        return reinterpret_cast<const typename VulkanLayoutCompatible<RHIType>::Type*>(value);
+    }
+} // namespace Elish
@@ -1,6 +1,7 @@
 #include "directional_light_pass.h"
 #include "../render_resource.h"
 #include "../render_system.h"
+#include "../pipeline_cache.h"
 #include "../../global/global_context.h"
 #include "../../core/base/macro.h"
 #include "../interface/rhi.h"
@@ -512,8 +513,8 @@ namespace Elish
         
         // 创建着色器模块
         
-        RHIShader* vert_shader_module = rhi->createShaderModule(SHADOW_VERT);
-         RHIShader* frag_shader_module = rhi->createShaderModule(SHADOW_FRAG);
+        RHIShader* vert_shader_module = m_pipeline_cache->getShader(SHADOW_VERT);
+        RHIShader* frag_shader_module = m_pipeline_cache->getShader(SHADOW_FRAG);
         
         // 配置着色器阶段
         RHIPipelineShaderStageCreateInfo vert_shader_stage_info{};
@@ -693,19 +694,15 @@ namespace Elish
         }
         
         // 创建图形管线
-        if (rhi->createGraphicsPipelines(RHI_NULL_HANDLE, 1, &pipeline_info, m_render_pipeline) != RHI_SUCCESS)
+        m_render_pipeline = m_pipeline_cache->getOrCreateGraphicsPipeline(pipeline_info);
+        if (!m_render_pipeline)
         {
             LOG_ERROR("[DirectionalLightShadowPass] Failed to create graphics pipeline");
             throw std::runtime_error("Failed to create graphics pipeline");
         }
         
         // LOG_INFO("[DirectionalLightShadowPass] Graphics pipeline created successfully");
-        
-        
-        // 清理着色器模块
-        rhi->destroyShaderModule(vert_shader_module);
-        rhi->destroyShaderModule(frag_shader_module);
-        
+        // 着色器模块与管线归管线缓存所有，不在此销毁
     }
     
     /**
@@ -770,14 +767,14 @@ namespace Elish
      * @brief 渲染模型到阴影贴图
      * @details 该函数执行实际的模型渲染操作：
      *          1. 验证渲染资源有效性
-     *          2. 获取当前帧的所有渲染对象
-     *          3. 对每个渲染对象：
+     *          2. 按块遍历同时带TransformComponent与MeshComponent的场景实体，只读取几何句柄与场景图节点
+     *          3. 对每个实体：
+     *             - 通过Push Constants传递世界矩阵
      *             - 绑定顶点缓冲区（仅位置数据）
      *             - 绑定索引缓冲区（如果存在）
      *             - 执行绘制调用（索引化或非索引化）
-     *             - 使用实例索引区分不同对象
+     *             - 使用渲染对象索引作为实例索引区分不同对象
      * @note 此函数假设uniform buffer和描述符集已在draw()中更新和绑定
-     * @note 每个对象使用不同的实例索引，着色器可据此获取对应的变换矩阵
      */
     void DirectionalLightShadowPass::drawModel()
     {
@@ -787,8 +784,8 @@ namespace Elish
             return;
         }
         
-        const auto& render_objects = m_current_render_resource->getLoadedRenderObjects();
-        if (render_objects.empty()) {
+        EntityWorld& scene_world = m_current_render_resource->getSceneWorld();
+        if (scene_world.count<TransformComponent, MeshComponent>() == 0) {
             LOG_WARN("[DirectionalLightShadowPass] No render objects available for shadow rendering");
             return;
         }
@@ -796,75 +793,50 @@ namespace Elish
         // 注意：uniform buffer更新和描述符集绑定已在draw()方法中完成
         // 这里只需要进行模型渲染
         
-        // LOG_INFO("[DirectionalLightShadowPass] Rendering {} objects to shadow map", render_objects.size());
-        
-        // 渲染每个模型
-        for (size_t i = 0; i < render_objects.size(); ++i) {
-            const auto& render_object = render_objects[i];
-            // 验证渲染对象的有效性
-            if (!render_object.vertexBuffer) {
-                LOG_WARN("[DirectionalLightShadowPass] Object {} has no vertex buffer, skipping", i);
-                continue;
-            }
-            
-            // LOG_DEBUG("[DirectionalLightShadowPass] Rendering object {} with {} vertices", i, render_object.vertices.size());
-            
-            // 计算模型变换矩阵
-            const auto& params = render_object.animationParams;
-            glm::mat4 model = glm::mat4(1.0f);
-            
-            // 应用位移
-            model = glm::translate(model, params.position);
-            
-            // 应用旋转（如果启用动画）
-            if (params.enableAnimation) {
-                float currentTime = static_cast<float>(glfwGetTime());
-                float rotationAngle = currentTime * params.rotationSpeed;
-                model = glm::rotate(model, rotationAngle, params.rotationAxis);
-            }
-            
-            // 应用缩放
-            model = glm::scale(model, params.scale);
-            
-            // 通过Push Constants传递模型矩阵
-            m_rhi->cmdPushConstantsPFN(m_rhi->getCurrentCommandBuffer(),
-                                     m_pipeline_layout,
-                                     RHI_SHADER_STAGE_VERTEX_BIT,
-                                     0,
-                                     sizeof(glm::mat4),
-                                     &model);
-            
-            // 绑定顶点缓冲区 - 只需要位置数据用于深度渲染
-            RHIBuffer* vertex_buffers[] = { render_object.vertexBuffer };
-            RHIDeviceSize offsets[] = { 0 };
-            m_rhi->cmdBindVertexBuffersPFN(m_rhi->getCurrentCommandBuffer(), 0, 1, vertex_buffers, offsets);
-            
-            // 根据是否有索引缓冲区选择绘制方式
-            if (render_object.indexBuffer && !render_object.indices.empty()) {
-                // 绑定索引缓冲区
-                m_rhi->cmdBindIndexBufferPFN(m_rhi->getCurrentCommandBuffer(), 
-                                           render_object.indexBuffer, 0, RHI_INDEX_TYPE_UINT32);
-                
-                // 执行索引化绘制
-                // 使用实例索引来区分不同的对象，着色器可以据此获取对应的变换矩阵
-                m_rhi->cmdDrawIndexedPFN(m_rhi->getCurrentCommandBuffer(),
-                                       static_cast<uint32_t>(render_object.indices.size()), // 索引数量
-                                       1, // 实例数量
-                                       0, // 第一个索引
-                                       0, // 顶点偏移
-                                       static_cast<uint32_t>(i)); // 第一个实例（用作实例索引）
-            } else if (!render_object.vertices.empty()) {
-                // 执行非索引化绘制
-                m_rhi->cmdDraw(m_rhi->getCurrentCommandBuffer(),
-                             static_cast<uint32_t>(render_object.vertices.size()), // 顶点数量
-                             1, // 实例数量
-                             0, // 第一个顶点
-                             static_cast<uint32_t>(i)); // 第一个实例（用作实例索引）
-            } else {
-                LOG_WARN("[DirectionalLightShadowPass] Object {} has no valid geometry data, skipping", i);
-                continue;
-            }
-        }
+        // 与主相机通道共用同一帧的世界矩阵，阴影与模型保持一致
+        const SceneGraph& scene_graph = m_current_render_resource->getSceneGraph();
+        RHICommandBuffer* command_buffer = m_rhi->getCurrentCommandBuffer();
+        
+        scene_world.eachChunk<TransformComponent, MeshComponent>(
+            [&](uint32_t count, const Entity*, TransformComponent* transforms, MeshComponent* meshes) {
+                for (uint32_t i = 0; i < count; ++i) {
+                    const MeshComponent& mesh = meshes[i];
+                    if (!mesh.indexBuffer && mesh.vertexCount == 0) {
+                        continue;
+                    }
+                    
+                    // 通过Push Constants传递模型矩阵
+                    const glm::mat4& model = scene_graph.getWorldMatrix(transforms[i].node);
+                    m_rhi->cmdPushConstantsPFN(command_buffer,
+                                             m_pipeline_layout,
+                                             RHI_SHADER_STAGE_VERTEX_BIT,
+                                             0,
+                                             sizeof(glm::mat4),
+                                             &model);
+                    
+                    // 绑定顶点缓冲区 - 只需要位置数据用于深度渲染
+                    RHIBuffer* vertex_buffers[] = { mesh.vertexBuffer };
+                    RHIDeviceSize offsets[] = { 0 };
+                    m_rhi->cmdBindVertexBuffersPFN(command_buffer, 0, 1, vertex_buffers, offsets);
+                    
+                    // 根据是否有索引缓冲区选择绘制方式
+                    if (mesh.indexBuffer) {
+                        m_rhi->cmdBindIndexBufferPFN(command_buffer, mesh.indexBuffer, 0, RHI_INDEX_TYPE_UINT32);
+                        m_rhi->cmdDrawIndexedPFN(command_buffer,
+                                               mesh.indexCount,          // 索引数量
+                                               1,                        // 实例数量
+                                               0,                        // 第一个索引
+                                               0,                        // 顶点偏移
+                                               mesh.renderObjectIndex);  // 第一个实例（用作实例索引）
+                    } else {
+                        m_rhi->cmdDraw(command_buffer,
+                                     mesh.vertexCount,          // 顶点数量
+                                     1,                         // 实例数量
+                                     0,                         // 第一个顶点
+                                     mesh.renderObjectIndex);   // 第一个实例（用作实例索引）
+                    }
+                }
+            });
         
         // LOG_INFO("[DirectionalLightShadowPass] Model rendering completed");
         
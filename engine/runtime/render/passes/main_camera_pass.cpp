@@ -5,16 +5,20 @@
 #include "../../render/interface/rhi.h"
 #include "../../render/interface/vulkan/vulkan_rhi_resource.h"
 #include "../../render/interface/vulkan/vulkan_rhi.h"
+#include "../../render/interface/vulkan/vulkan_command_list.h"
 #include "../../render/interface/vulkan/vulkan_util.h"
 #include "../../render/render_system.h"
 #include "../render_resource.h"
 #include "../render_pipeline.h"
+#include "../descriptor_allocator.h"
+#include "../pipeline_cache.h"
 #include "ui_pass.h"
 #include "../../global/global_context.h"
 #include "../../input/input_system.h"
 
 #include <vector>
 #include <cstring>
+#include <algorithm>
 #include <string>
 #include <chrono>
 #include <atomic>
@@ -27,12 +31,39 @@
 #include "../../shader/generated/cpp/pic_frag.h"
 #include "../../shader/generated/cpp/skybox_new_vert.h"
 #include "../../shader/generated/cpp/skybox_new_frag.h"
+#include "../../shader/generated/cpp/post_process_vert.h"
+#include "../../shader/generated/cpp/rt_composite_frag.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "../../../3rdparty/tinyobjloader/examples/viewer/stb_image.h"
 
 namespace Elish
 {
+    namespace
+    {
+        // FNV-1a 64位哈希，用于判断静态二级命令缓冲区是否需要重录
+        constexpr uint64_t k_fnv_offset_basis = 14695981039346656037ull;
+        constexpr uint64_t k_fnv_prime = 1099511628211ull;
+
+        uint64_t fnv1a(const void* data, size_t size, uint64_t seed)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            uint64_t hash = seed;
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= k_fnv_prime;
+            }
+            return hash;
+        }
+
+        template<typename T>
+        uint64_t hashValue(const T& value, uint64_t seed)
+        {
+            return fnv1a(&value, sizeof(T), seed);
+        }
+    }
+
     /**
      * @brief 初始化主相机渲染通道。
      * 该函数负责设置渲染通道所需的所有资源，包括创建Uniform Buffer、设置渲染通道、描述符集布局、图形管线、描述符集以及交换链帧缓冲。
@@ -154,7 +185,22 @@ namespace Elish
         
         // Store loaded render objects to avoid repeated access
         if (m_render_resource) {
+            // 逐物体描述符集只保存在本通道的副本中，重新复制时按顶点缓冲区沿用已分配的集合
+            std::vector<RenderObject> previousObjects = std::move(m_loaded_render_objects);
             m_loaded_render_objects = m_render_resource->getLoadedRenderObjects();
+            size_t carriedCount = std::min(previousObjects.size(), m_loaded_render_objects.size());
+            for (size_t i = 0; i < carriedCount; ++i) {
+                if (previousObjects[i].vertexBuffer == m_loaded_render_objects[i].vertexBuffer &&
+                    m_loaded_render_objects[i].descriptorSets.empty()) {
+                    m_loaded_render_objects[i].descriptorSets = std::move(previousObjects[i].descriptorSets);
+                }
+            }
+            // 未被沿用的集合（物体已删除或替换）归还分配器
+            for (RenderObject& previousObject : previousObjects) {
+                for (uint32_t frameIndex = 0; frameIndex < previousObject.descriptorSets.size(); ++frameIndex) {
+                    releaseModelDescriptorSet(previousObject, frameIndex);
+                }
+            }
             
             
             if (!m_loaded_render_objects.empty()) {
@@ -168,7 +214,7 @@ namespace Elish
         
         // Create model rendering pipeline if not already created
         if (m_render_resource && !m_render_resource->isModelPipelineResourceCreated()) {
-            if (!m_render_resource->createModelPipelineResource(m_framebuffer.render_pass)) {
+            if (!m_render_resource->createModelPipelineResource(m_framebuffer.render_pass, m_pipeline_cache)) {
                 LOG_ERROR("[MainCameraPass::preparePassData] Failed to create model pipeline resource");
             } else {
                 // Set up model pipeline in render pipelines array
@@ -180,11 +226,28 @@ namespace Elish
                 }
             }
         }
+
+        // 模型管线变体在后台线程编译，就绪前各帧沿用默认模型管线（及阴影贴图）；
+        // 就绪后替换进管线数组，并让静态二级命令缓冲区按新管线重新录制
+        if (m_render_resource && m_render_resource->updateModelPipelineRequests(m_pipeline_cache.get())) {
+            if (m_render_pipelines.size() >= 4 && m_render_resource->isModelRayQueryPipelineResourceCreated()) {
+                m_render_pipelines[3] = m_render_resource->getModelRayQueryPipelineResource();
+            }
+            if (m_render_pipelines.size() >= 6 && m_render_resource->isModelRtLightingPipelineResourceCreated()) {
+                m_render_pipelines[5] = m_render_resource->getModelRtLightingPipelineResource();
+            }
+            invalidateStaticDraws();
+        }
         
         // Setup model descriptor set now that textures are available (only once)
-        if (!m_loaded_render_objects.empty() && !m_model_descriptor_sets_initialized) {
-            setupModelDescriptorSet();
+        // 推送描述符模式下绑定在绘制时写入，不分配逐物体描述符集
+        if (!m_loaded_render_objects.empty() && !m_model_descriptor_sets_initialized &&
+            m_render_resource && m_render_resource->isModelPipelineResourceCreated()) {
+            if (!m_render_resource->isModelPushDescriptorEnabled()) {
+                setupModelDescriptorSet();
+            }
             m_model_descriptor_sets_initialized = true;
+            invalidateStaticDraws();
         }
         
         // 天空盒描述符集将在首次渲染时延迟初始化
@@ -193,25 +256,31 @@ namespace Elish
     /**
      * @brief 执行前向渲染命令。
      * 该函数负责在给定的交换链图像索引上执行所有前向渲染操作。
-     * 它会更新Uniform Buffer，获取当前命令缓冲区，开始渲染通道，设置视口和裁剪区域，
-     * 绑定并绘制背景管线，然后切换到模型渲染管线，绑定全局描述符集，最后绘制场景中的模型。
+     * 子通道0优先执行预录制的二级命令缓冲区：静态部分（视口、背景、静止模型）仅在状态变化时重录，
+     * 动态部分（天空盒、动画模型）每帧录制；二级命令缓冲区不可用时回退到内联录制。
      * @param swapchain_image_index 当前交换链图像的索引，用于绑定正确的帧缓冲。
      */
     void MainCameraPass::drawForward(uint32_t swapchain_image_index)
     {
-        
-
-        
-        updateUniformBuffer(m_rhi->getCurrentFrameIndex());//更新统一缓存区，更新描述符集
-        
+        uint32_t currentFrameIndex = m_rhi->getCurrentFrameIndex();
+        updateUniformBuffer(currentFrameIndex);//更新统一缓存区，更新描述符集
         
         // 获取当前命令缓冲区
-        
         RHICommandBuffer* command_buffer = m_rhi->getCurrentCommandBuffer();
         if (!command_buffer) {
             LOG_ERROR("Failed to get current command buffer");
             return;
         }
+
+        // 视口与模型管线在渲染通道开始前确定，二级命令缓冲区需在开始前录制完成
+        RHIViewport viewport{};
+        RHIRect2D scissor{};
+        resolveSceneViewport(viewport, scissor);
+
+        ModelPipelineSelection modelSelection;
+        bool drawModelsEnabled = selectModelPipeline(currentFrameIndex, modelSelection);
+        bool useSecondary = m_enable_secondary_command_buffers &&
+                            recordSubpassCommandBuffers(currentFrameIndex, viewport, scissor, drawModelsEnabled ? &modelSelection : nullptr);
         
         // 设置渲染通道开始信息
         RHIRenderPassBeginInfo render_pass_begin_info{};
@@ -229,18 +298,61 @@ namespace Elish
         render_pass_begin_info.clearValueCount = static_cast<uint32_t>(clear_values.size());
         render_pass_begin_info.pClearValues = clear_values.data();
         
-
-        
         // 开始渲染通道
-        m_rhi->cmdBeginRenderPassPFN(command_buffer, &render_pass_begin_info, RHI_SUBPASS_CONTENTS_INLINE);
+        m_rhi->cmdBeginRenderPassPFN(command_buffer, &render_pass_begin_info,
+                                     useSecondary ? RHI_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : RHI_SUBPASS_CONTENTS_INLINE);
 
         // === 子通道0：主渲染（背景+模型） ===
-        float main_color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
-        m_rhi->pushEvent(command_buffer, "MAIN RENDER SUBPASS", main_color);
+        if (useSecondary) {
+            // 以二级命令缓冲区内容开始的子通道只允许执行命令，调试标记与视口均已录制在二级命令缓冲区中
+            RHICommandBuffer* secondaries[2] = { m_static_command_buffers[currentFrameIndex], m_dynamic_command_buffers[currentFrameIndex] };
+            m_rhi->cmdExecuteCommands(command_buffer, 2, secondaries);
+        } else {
+            float main_color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            m_rhi->pushEvent(command_buffer, "MAIN RENDER SUBPASS", main_color);
+
+            m_rhi->cmdSetViewportPFN(command_buffer, 0, 1, &viewport);
+            m_rhi->cmdSetScissorPFN(command_buffer, 0, 1, &scissor);
+
+            // 渲染背景
+            drawBackground(command_buffer);
+
+            // 渲染天空盒
+            drawSkybox(command_buffer);
+
+            // 渲染模型
+            if (drawModelsEnabled) {
+                drawModels(command_buffer, modelSelection, ModelDrawFilter::All);
+            }
+
+            m_rhi->popEvent(command_buffer);
+        }
+        
+        // === 切换到子通道1：UI渲染 ===
+        m_rhi->cmdNextSubpassPFN(command_buffer, RHI_SUBPASS_CONTENTS_INLINE);
+        
+        float ui_color[4] = { 0.0f, 1.0f, 0.0f, 1.0f };
+        m_rhi->pushEvent(command_buffer, "UI RENDER SUBPASS", ui_color);
+        
+        // 先合成光线追踪输出，UI随后绘制在其上方
+        drawRayTracingComposite(command_buffer, viewport, scissor);
         
-        // 设置视口和裁剪矩形
+        // 渲染UI内容
+        drawUI(command_buffer);
+        
+        m_rhi->popEvent(command_buffer);
+        
+        // 结束渲染通道
+        m_rhi->cmdEndRenderPassPFN(command_buffer);
+    }
+
+    /**
+     * @brief 计算本帧场景视口与裁剪矩形
+     * @details 编辑器布局给出有效场景视口时使用该视口并同步相机宽高比，否则回退到全屏视口
+     */
+    void MainCameraPass::resolveSceneViewport(RHIViewport& viewport, RHIRect2D& scissor)
+    {
         // 尝试从 RenderPipeline 获取 EditorLayoutState
-        bool viewportSet = false;
         if (g_runtime_global_context.m_render_system) {
             auto pipeline = std::dynamic_pointer_cast<RenderPipeline>(g_runtime_global_context.m_render_system->getRenderPipeline());
             if (pipeline) {
@@ -248,7 +360,6 @@ namespace Elish
                 
                 // 如果计算出的视口有效（宽度和高度大于0），则使用它
                 if (layoutState.sceneViewport.width > 1.0f && layoutState.sceneViewport.height > 1.0f) {
-                    RHIViewport viewport;
                     viewport.x = layoutState.sceneViewport.x;
                     viewport.y = layoutState.sceneViewport.y;
                     viewport.width = layoutState.sceneViewport.width;
@@ -256,57 +367,194 @@ namespace Elish
                     viewport.minDepth = 0.0f;
                     viewport.maxDepth = 1.0f;
                     
-                    RHIRect2D scissor;
                     scissor.offset.x = (int32_t)viewport.x;
                     scissor.offset.y = (int32_t)viewport.y;
                     scissor.extent.width = (uint32_t)viewport.width;
                     scissor.extent.height = (uint32_t)viewport.height;
                     
-                    m_rhi->cmdSetViewportPFN(m_rhi->getCurrentCommandBuffer(), 0, 1, &viewport);
-                    m_rhi->cmdSetScissorPFN(m_rhi->getCurrentCommandBuffer(), 0, 1, &scissor);
-                    viewportSet = true;
+                    m_scene_viewport = viewport;
                     
                     // 更新相机宽高比
                     if (m_camera) {
                         m_camera->setAspect(viewport.width / viewport.height);
                     }
+                    return;
                 }
             }
         }
         
-        if (!viewportSet) {
-            // 回退到默认全屏视口
-            m_rhi->cmdSetViewportPFN(m_rhi->getCurrentCommandBuffer(), 0, 1, m_rhi->getSwapchainInfo().viewport);
-            m_rhi->cmdSetScissorPFN(m_rhi->getCurrentCommandBuffer(), 0, 1, m_rhi->getSwapchainInfo().scissor);
+        // 回退到默认全屏视口
+        viewport = *m_rhi->getSwapchainInfo().viewport;
+        scissor = *m_rhi->getSwapchainInfo().scissor;
+        m_scene_viewport = viewport;
+    }
+
+    /**
+     * @brief 为每个飞行帧分配静态与动态二级命令缓冲区
+     * @details 分配自RHI的图形命令池（带RESET_COMMAND_BUFFER标志，可单独重录），失败时关闭二级命令缓冲区路径
+     */
+    bool MainCameraPass::allocateSubpassCommandBuffers()
+    {
+        uint32_t maxFramesInFlight = m_rhi->getMaxFramesInFlight();
+        if (m_static_command_buffers.size() == maxFramesInFlight) {
+            return true;
         }
-        
-        // 渲染背景
-        drawBackground(command_buffer);
-        
-        // 渲染天空盒
-        drawSkybox(command_buffer);
-        
-        // 渲染模型
-        drawModels(command_buffer);
-        
-        m_rhi->popEvent(command_buffer);
-        
-        // === 切换到子通道1：UI渲染 ===
-        m_rhi->cmdNextSubpassPFN(command_buffer, RHI_SUBPASS_CONTENTS_INLINE);
-        
-        float ui_color[4] = { 0.0f, 1.0f, 0.0f, 1.0f };
-        m_rhi->pushEvent(command_buffer, "UI RENDER SUBPASS", ui_color);
-        
-        // 渲染UI内容
-        drawUI(command_buffer);
-        
-        m_rhi->popEvent(command_buffer);
-        
-        // 结束渲染通道
-        m_rhi->cmdEndRenderPassPFN(command_buffer);
 
-        
+        RHICommandBufferAllocateInfo allocateInfo{};
+        allocateInfo.sType = RHI_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.commandPool = m_rhi->getCommandPoor();
+        allocateInfo.level = RHI_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocateInfo.commandBufferCount = 1;
+
+        std::vector<RHICommandBuffer*> staticBuffers(maxFramesInFlight, nullptr);
+        std::vector<RHICommandBuffer*> dynamicBuffers(maxFramesInFlight, nullptr);
+        for (uint32_t i = 0; i < maxFramesInFlight; ++i) {
+            if (allocateInfo.commandPool == nullptr ||
+                m_rhi->allocateCommandBuffers(&allocateInfo, staticBuffers[i]) != RHI_SUCCESS ||
+                m_rhi->allocateCommandBuffers(&allocateInfo, dynamicBuffers[i]) != RHI_SUCCESS) {
+                LOG_WARN("[MainCameraPass] Failed to allocate secondary command buffers, falling back to inline recording");
+                m_enable_secondary_command_buffers = false;
+                return false;
+            }
+        }
+
+        m_static_command_buffers = std::move(staticBuffers);
+        m_dynamic_command_buffers = std::move(dynamicBuffers);
+        m_static_command_keys.assign(maxFramesInFlight, 0);
+        LOG_INFO("[MainCameraPass] Allocated {} static and {} dynamic secondary command buffers", maxFramesInFlight, maxFramesInFlight);
+        return true;
+    }
+
+    /**
+     * @brief 准备本帧子通道0的二级命令缓冲区
+     * @details 静态命令缓冲区的状态键与上次录制一致时直接复用；该帧上一次提交已在帧节奏控制中等待完成，
+     *          因此重录当前帧的命令缓冲区是安全的
+     */
+    bool MainCameraPass::recordSubpassCommandBuffers(uint32_t currentFrameIndex, const RHIViewport& viewport, const RHIRect2D& scissor,
+                                                     const ModelPipelineSelection* selection)
+    {
+        if (!allocateSubpassCommandBuffers()) {
+            return false;
+        }
+
+        // 帧缓冲留空：命令可在该渲染通道子通道0的任意交换链帧缓冲中执行
+        RHICommandBufferInheritanceInfo inheritanceInfo{};
+        inheritanceInfo.sType = RHI_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.renderPass = m_framebuffer.render_pass;
+        inheritanceInfo.subpass = 0;
+        inheritanceInfo.framebuffer = nullptr;
+
+        RHICommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = RHI_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = RHI_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+        float main_color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+        uint64_t staticKey = computeStaticDrawKey(currentFrameIndex, viewport, selection);
+        if (m_static_command_keys[currentFrameIndex] != staticKey) {
+            RHICommandBuffer* staticBuffer = m_static_command_buffers[currentFrameIndex];
+            m_static_command_keys[currentFrameIndex] = 0;
+            if (!m_rhi->beginCommandBuffer(staticBuffer, &beginInfo)) {
+                return false;
+            }
+            // 动态状态不从主命令缓冲区继承，每个二级命令缓冲区自行设置视口
+            m_rhi->pushEvent(staticBuffer, "MAIN RENDER STATIC", main_color);
+            m_rhi->cmdSetViewportPFN(staticBuffer, 0, 1, &viewport);
+            m_rhi->cmdSetScissorPFN(staticBuffer, 0, 1, &scissor);
+            drawBackground(staticBuffer);
+            if (selection) {
+                drawModels(staticBuffer, *selection, ModelDrawFilter::StaticOnly);
+            }
+            m_rhi->popEvent(staticBuffer);
+            if (!m_rhi->endCommandBuffer(staticBuffer)) {
+                return false;
+            }
+            m_static_command_keys[currentFrameIndex] = staticKey;
+            ++m_static_command_rerecords;
+            LOG_DEBUG("[MainCameraPass] Re-recorded static draws for frame {} ({} total)", currentFrameIndex, m_static_command_rerecords);
+        }
 
+        RHICommandBuffer* dynamicBuffer = m_dynamic_command_buffers[currentFrameIndex];
+        beginInfo.flags |= RHI_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        if (!m_rhi->beginCommandBuffer(dynamicBuffer, &beginInfo)) {
+            return false;
+        }
+        m_rhi->pushEvent(dynamicBuffer, "MAIN RENDER DYNAMIC", main_color);
+        m_rhi->cmdSetViewportPFN(dynamicBuffer, 0, 1, &viewport);
+        m_rhi->cmdSetScissorPFN(dynamicBuffer, 0, 1, &scissor);
+        // 天空盒深度测试为LEQUAL且不写深度，在静止模型之后绘制只填充未被遮挡的像素
+        drawSkybox(dynamicBuffer);
+        if (selection) {
+            drawModels(dynamicBuffer, *selection, ModelDrawFilter::AnimatedOnly);
+        }
+        m_rhi->popEvent(dynamicBuffer);
+        return m_rhi->endCommandBuffer(dynamicBuffer);
+    }
+
+    /**
+     * @brief 计算静态命令缓冲区的状态键
+     * @details 覆盖静态命令中录制的全部句柄与常量：视口、背景开关与描述符集、模型管线变体及其集合1、
+     *          光照推送常量、每个静止物体的缓冲区/描述符集（推送模式下为推送的图像视图）/索引数/模型矩阵；
+     *          描述符内容的改写由invalidateStaticDraws()处理
+     */
+    uint64_t MainCameraPass::computeStaticDrawKey(uint32_t currentFrameIndex, const RHIViewport& viewport, const ModelPipelineSelection* selection) const
+    {
+        uint64_t hash = hashValue(m_framebuffer.render_pass, k_fnv_offset_basis);
+        hash = hashValue(viewport, hash);
+        hash = hashValue(m_enable_background, hash);
+        if (m_enable_background && !m_render_pipelines.empty()) {
+            hash = hashValue(m_render_pipelines[0].graphicsPipeline, hash);
+            hash = hashValue(m_descriptor_infos[currentFrameIndex].descriptor_set, hash);
+        }
+
+        if (selection) {
+            hash = hashValue(selection->pipeline->graphicsPipeline, hash);
+            hash = hashValue(selection->pipeline->pipelineLayout, hash);
+            hash = hashValue(selection->useRtLighting, hash);
+            hash = hashValue(selection->useRayQueryShadows, hash);
+            hash = hashValue(selection->hasRtReflections, hash);
+            hash = hashValue(m_rt_ambient_occlusion != nullptr, hash);
+            hash = hashValue(m_rt_reflection_roughness_threshold, hash);
+
+            bool usePushDescriptors = m_render_resource->isModelPushDescriptorEnabled();
+            if (usePushDescriptors) {
+                hash = hashValue(m_render_resource->getCubemapImageView(), hash);
+                hash = hashValue(m_render_resource->getDirectionalLightShadowImageView(), hash);
+            }
+
+            for (size_t i = 0; i < m_loaded_render_objects.size(); ++i) {
+                const auto& renderObject = m_loaded_render_objects[i];
+                if (m_render_resource->isRenderObjectAnimated(i)) {
+                    continue;
+                }
+                hash = hashValue(renderObject.vertexBuffer, hash);
+                hash = hashValue(renderObject.indexBuffer, hash);
+                if (usePushDescriptors) {
+                    // 推送的纹理句柄直接录制在命令中
+                    for (RHIImageView* textureImageView : renderObject.textureImageViews) {
+                        hash = hashValue(textureImageView, hash);
+                    }
+                    for (RHISampler* textureSampler : renderObject.textureSamplers) {
+                        hash = hashValue(textureSampler, hash);
+                    }
+                } else if (currentFrameIndex < renderObject.descriptorSets.size()) {
+                    hash = hashValue(renderObject.descriptorSets[currentFrameIndex], hash);
+                }
+                hash = hashValue(renderObject.indices.size(), hash);
+                hash = hashValue(m_render_resource->getRenderObjectWorldMatrix(i), hash);
+            }
+        }
+        // 0保留为“需要重录”
+        return hash != 0 ? hash : 1;
+    }
+
+    /**
+     * @brief 丢弃所有已录制的静态命令，下次使用时重录
+     */
+    void MainCameraPass::invalidateStaticDraws()
+    {
+        std::fill(m_static_command_keys.begin(), m_static_command_keys.end(), 0);
     }
 
     void MainCameraPass::drawBackground(RHICommandBuffer* command_buffer){
@@ -610,6 +858,24 @@ namespace Elish
             throw std::runtime_error("create skybox descriptor set layout");
         }
 
+        // === 创建光线追踪合成的描述符集布局 ===
+        RHIDescriptorSetLayoutBinding rt_composite_binding{};
+        rt_composite_binding.binding = 0;
+        rt_composite_binding.descriptorCount = 1;
+        rt_composite_binding.descriptorType = RHI_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        rt_composite_binding.pImmutableSamplers = nullptr;
+        rt_composite_binding.stageFlags = RHI_SHADER_STAGE_FRAGMENT_BIT;
+
+        RHIDescriptorSetLayoutCreateInfo rt_composite_layoutInfo{};
+        rt_composite_layoutInfo.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        rt_composite_layoutInfo.bindingCount = 1;
+        rt_composite_layoutInfo.pBindings = &rt_composite_binding;
+
+        if (m_rhi->createDescriptorSetLayout(&rt_composite_layoutInfo, m_rt_composite_descriptor_layout) != RHI_SUCCESS)
+        {
+            throw std::runtime_error("create ray tracing composite descriptor set layout");
+        }
+
         
     }
     /**
@@ -623,7 +889,7 @@ namespace Elish
     void MainCameraPass::setupPipelines()
     {
         
-        m_render_pipelines.resize(3);  // Resize to accommodate background, skybox, and model pipelines  
+        m_render_pipelines.resize(6);  // Resize to accommodate background, skybox, model, ray query shadow model, RT composite and RT lighting model pipelines
 
                 
         
@@ -646,8 +912,8 @@ namespace Elish
         
         
         //shader创建和顶点缓冲区绑定
-        RHIShader* vert_shader_module = m_rhi->createShaderModule(PIC_VERT);
-        RHIShader* frag_shader_module = m_rhi->createShaderModule(PIC_FRAG);
+        RHIShader* vert_shader_module = m_pipeline_cache->getShader(PIC_VERT);
+        RHIShader* frag_shader_module = m_pipeline_cache->getShader(PIC_FRAG);
 
         RHIPipelineShaderStageCreateInfo vert_pipeline_shader_stage_create_info {};
         vert_pipeline_shader_stage_create_info.sType  = RHI_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -757,16 +1023,11 @@ namespace Elish
         pipelineInfo.basePipelineHandle  = RHI_NULL_HANDLE;
         pipelineInfo.pDynamicState       = &dynamic_state_create_info;
 
-        if (m_rhi->createGraphicsPipelines(RHI_NULL_HANDLE,
-            1,
-            &pipelineInfo,
-            m_render_pipelines[0].graphicsPipeline) !=
-            RHI_SUCCESS)
+        m_render_pipelines[0].graphicsPipeline = m_pipeline_cache->getOrCreateGraphicsPipeline(pipelineInfo);
+        if (!m_render_pipelines[0].graphicsPipeline)
         {
             throw std::runtime_error("create mesh lighting graphics pipeline");
         }
-        m_rhi->destroyShaderModule(vert_shader_module);
-        m_rhi->destroyShaderModule(frag_shader_module);
 
         // 创建天空盒渲染管线
         RHIDescriptorSetLayout* skybox_descriptorset_layouts[1] = {m_skybox_descriptor_layout};
@@ -790,8 +1051,8 @@ namespace Elish
         }
 
         // 创建天空盒着色器模块
-        RHIShader* skybox_vert_shader_module = m_rhi->createShaderModule(SKYBOX_NEW_VERT);
-        RHIShader* skybox_frag_shader_module = m_rhi->createShaderModule(SKYBOX_NEW_FRAG);
+        RHIShader* skybox_vert_shader_module = m_pipeline_cache->getShader(SKYBOX_NEW_VERT);
+        RHIShader* skybox_frag_shader_module = m_pipeline_cache->getShader(SKYBOX_NEW_FRAG);
 
         RHIPipelineShaderStageCreateInfo skybox_vert_pipeline_shader_stage_create_info {};
         skybox_vert_pipeline_shader_stage_create_info.sType  = RHI_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -842,16 +1103,89 @@ namespace Elish
         skybox_pipelineInfo.basePipelineHandle  = RHI_NULL_HANDLE;
         skybox_pipelineInfo.pDynamicState       = &dynamic_state_create_info;
 
-        if (m_rhi->createGraphicsPipelines(RHI_NULL_HANDLE,
-            1,
-            &skybox_pipelineInfo,
-            m_render_pipelines[1].graphicsPipeline) !=
-            RHI_SUCCESS)
+        m_render_pipelines[1].graphicsPipeline = m_pipeline_cache->getOrCreateGraphicsPipeline(skybox_pipelineInfo);
+        if (!m_render_pipelines[1].graphicsPipeline)
         {
             throw std::runtime_error("create skybox graphics pipeline");
         }
-        m_rhi->destroyShaderModule(skybox_vert_shader_module);
-        m_rhi->destroyShaderModule(skybox_frag_shader_module);
+
+        // 创建光线追踪合成管线（UI子通道，全屏三角形 + alpha混合，无深度）
+        RHIPushConstantRange rt_composite_push_constant_range {};
+        rt_composite_push_constant_range.stageFlags = RHI_SHADER_STAGE_FRAGMENT_BIT;
+        rt_composite_push_constant_range.offset = 0;
+        rt_composite_push_constant_range.size = sizeof(RayTracingCompositePushConstants);
+
+        RHIPipelineLayoutCreateInfo rt_composite_pipeline_layout_create_info {};
+        rt_composite_pipeline_layout_create_info.sType          = RHI_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        rt_composite_pipeline_layout_create_info.setLayoutCount = 1;
+        rt_composite_pipeline_layout_create_info.pSetLayouts    = &m_rt_composite_descriptor_layout;
+        rt_composite_pipeline_layout_create_info.pushConstantRangeCount = 1;
+        rt_composite_pipeline_layout_create_info.pPushConstantRanges = &rt_composite_push_constant_range;
+
+        if (m_rhi->createPipelineLayout(&rt_composite_pipeline_layout_create_info, m_render_pipelines[4].pipelineLayout) != RHI_SUCCESS)
+        {
+            throw std::runtime_error("create ray tracing composite pipeline layout");
+        }
+        m_render_pipelines[4].descriptorSetLayout = m_rt_composite_descriptor_layout;
+
+        RHIShader* rt_composite_vert_shader_module = m_pipeline_cache->getShader(POST_PROCESS_VERT);
+        RHIShader* rt_composite_frag_shader_module = m_pipeline_cache->getShader(RT_COMPOSITE_FRAG);
+
+        RHIPipelineShaderStageCreateInfo rt_composite_shader_stages[2] = {};
+        rt_composite_shader_stages[0].sType  = RHI_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        rt_composite_shader_stages[0].stage  = RHI_SHADER_STAGE_VERTEX_BIT;
+        rt_composite_shader_stages[0].module = rt_composite_vert_shader_module;
+        rt_composite_shader_stages[0].pName  = "main";
+        rt_composite_shader_stages[1].sType  = RHI_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        rt_composite_shader_stages[1].stage  = RHI_SHADER_STAGE_FRAGMENT_BIT;
+        rt_composite_shader_stages[1].module = rt_composite_frag_shader_module;
+        rt_composite_shader_stages[1].pName  = "main";
+
+        RHIPipelineColorBlendAttachmentState rt_composite_blend_attachment = {};
+        rt_composite_blend_attachment.colorWriteMask = RHI_COLOR_COMPONENT_R_BIT | RHI_COLOR_COMPONENT_G_BIT |
+                                                       RHI_COLOR_COMPONENT_B_BIT | RHI_COLOR_COMPONENT_A_BIT;
+        rt_composite_blend_attachment.blendEnable         = RHI_TRUE;
+        rt_composite_blend_attachment.srcColorBlendFactor = RHI_BLEND_FACTOR_SRC_ALPHA;
+        rt_composite_blend_attachment.dstColorBlendFactor = RHI_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        rt_composite_blend_attachment.colorBlendOp        = RHI_BLEND_OP_ADD;
+        rt_composite_blend_attachment.srcAlphaBlendFactor = RHI_BLEND_FACTOR_ONE;
+        rt_composite_blend_attachment.dstAlphaBlendFactor = RHI_BLEND_FACTOR_ZERO;
+        rt_composite_blend_attachment.alphaBlendOp        = RHI_BLEND_OP_ADD;
+
+        RHIPipelineColorBlendStateCreateInfo rt_composite_color_blend_state_create_info = color_blend_state_create_info;
+        rt_composite_color_blend_state_create_info.attachmentCount = 1;
+        rt_composite_color_blend_state_create_info.pAttachments    = &rt_composite_blend_attachment;
+
+        // 全屏三角形由顶点索引生成，无顶点输入
+        RHIPipelineVertexInputStateCreateInfo rt_composite_vertex_input_state_create_info {};
+        rt_composite_vertex_input_state_create_info.sType = RHI_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        rt_composite_vertex_input_state_create_info.vertexBindingDescriptionCount   = 0;
+        rt_composite_vertex_input_state_create_info.pVertexBindingDescriptions      = nullptr;
+        rt_composite_vertex_input_state_create_info.vertexAttributeDescriptionCount = 0;
+        rt_composite_vertex_input_state_create_info.pVertexAttributeDescriptions    = nullptr;
+
+        // UI子通道没有深度附件，关闭深度测试与写入
+        RHIPipelineDepthStencilStateCreateInfo rt_composite_depth_stencil_create_info {};
+        rt_composite_depth_stencil_create_info.sType            = RHI_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        rt_composite_depth_stencil_create_info.depthTestEnable  = RHI_FALSE;
+        rt_composite_depth_stencil_create_info.depthWriteEnable = RHI_FALSE;
+        rt_composite_depth_stencil_create_info.depthCompareOp   = RHI_COMPARE_OP_ALWAYS;
+        rt_composite_depth_stencil_create_info.depthBoundsTestEnable = RHI_FALSE;
+        rt_composite_depth_stencil_create_info.stencilTestEnable     = RHI_FALSE;
+
+        RHIGraphicsPipelineCreateInfo rt_composite_pipelineInfo = pipelineInfo;
+        rt_composite_pipelineInfo.pStages            = rt_composite_shader_stages;
+        rt_composite_pipelineInfo.pVertexInputState  = &rt_composite_vertex_input_state_create_info;
+        rt_composite_pipelineInfo.pColorBlendState   = &rt_composite_color_blend_state_create_info;
+        rt_composite_pipelineInfo.pDepthStencilState = &rt_composite_depth_stencil_create_info;
+        rt_composite_pipelineInfo.layout             = m_render_pipelines[4].pipelineLayout;
+        rt_composite_pipelineInfo.subpass            = 1;
+
+        m_render_pipelines[4].graphicsPipeline = m_pipeline_cache->getOrCreateGraphicsPipeline(rt_composite_pipelineInfo);
+        if (!m_render_pipelines[4].graphicsPipeline)
+        {
+            throw std::runtime_error("create ray tracing composite graphics pipeline");
+        }
 
     }
     /**
@@ -917,7 +1251,8 @@ namespace Elish
             mesh_descriptor_writes_info[1].pTexelBufferView = nullptr;
             m_rhi->updateDescriptorSets(2, mesh_descriptor_writes_info, 0, nullptr);
         }
-        
+        // 背景描述符集已重写，静态二级命令缓冲区需重录
+        invalidateStaticDraws();
     }
 
     /**
@@ -1025,6 +1360,20 @@ namespace Elish
         setup_in_progress.store(false);
     }
 
+    /**
+     * @brief 把物体在某飞行帧的模型描述符集归还分配器并置空
+     */
+    void MainCameraPass::releaseModelDescriptorSet(RenderObject& render_object, uint32_t frame_index)
+    {
+        if (frame_index >= render_object.descriptorSets.size() || !render_object.descriptorSets[frame_index]) {
+            return;
+        }
+        if (m_descriptor_allocator) {
+            m_descriptor_allocator->release(m_render_pipelines[2].descriptorSetLayout, render_object.descriptorSets[frame_index]);
+        }
+        render_object.descriptorSets[frame_index] = VK_NULL_HANDLE;
+    }
+
     void MainCameraPass::setupModelDescriptorSet()//分配模型描述符集
     {
         
@@ -1067,21 +1416,13 @@ namespace Elish
                     
                     // 检查是否已经分配过描述符集，避免重复分配
                     if (renderObject.descriptorSets[frameIndex] == VK_NULL_HANDLE) {
-                        // 分配当前对象的描述符集 (使用共享的模型描述符布局)
-                        RHIDescriptorSetAllocateInfo object_descriptor_set_alloc_info{};
-                        object_descriptor_set_alloc_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-                        object_descriptor_set_alloc_info.pNext = nullptr;
-                        object_descriptor_set_alloc_info.descriptorPool = m_rhi->getDescriptorPoor();
-                        object_descriptor_set_alloc_info.descriptorSetCount = 1;
-                        object_descriptor_set_alloc_info.pSetLayouts = &m_render_pipelines[2].descriptorSetLayout;
-
-                        if (RHI_SUCCESS != m_rhi->allocateDescriptorSets(&object_descriptor_set_alloc_info, 
-                                                                         renderObject.descriptorSets[frameIndex])) {
+                        // 从分配器的可增长池链分配，物体数量不再受全局描述符池的固定容量限制
+                        renderObject.descriptorSets[frameIndex] = m_descriptor_allocator->allocate(m_render_pipelines[2].descriptorSetLayout);
+                        if (!renderObject.descriptorSets[frameIndex]) {
                             LOG_ERROR("[setupModelDescriptorSet] Failed to allocate descriptor set for object {} frame {}", 
                                      objIndex, frameIndex);
                             continue;
                         }
-                        LOG_INFO("[setupModelDescriptorSet] Successfully allocated descriptor set for object {} frame {}", objIndex, frameIndex);
                     } else {
                         LOG_DEBUG("[setupModelDescriptorSet] Descriptor set already allocated for object {} frame {}, skipping allocation", objIndex, frameIndex);
                     }
@@ -1125,8 +1466,8 @@ namespace Elish
                     if (!cubemapImageView || !cubemapSampler) {
                         LOG_ERROR("[setupModelDescriptorSet] Cubemap resources are null (imageView: {}, sampler: {}) for object {} frame {}, skipping model rendering", 
                                  (void*)cubemapImageView, (void*)cubemapSampler, objIndex, frameIndex);
-                        // 将描述符集标记为无效，避免在drawModels中使用
-                        renderObject.descriptorSets[frameIndex] = VK_NULL_HANDLE;
+                        // 归还描述符集并标记为无效，避免在drawModels中使用
+                        releaseModelDescriptorSet(renderObject, frameIndex);
                         continue;
                     }
                     
@@ -1154,8 +1495,8 @@ namespace Elish
                     if (!shadowMapImageView || !shadowMapSampler) {
                         LOG_ERROR("[setupModelDescriptorSet] Shadow map resources are null (imageView: {}, sampler: {}) for object {} frame {}, skipping model rendering", 
                                  (void*)shadowMapImageView, (void*)shadowMapSampler, objIndex, frameIndex);
-                        // 将描述符集标记为无效，避免在drawModels中使用
-                        renderObject.descriptorSets[frameIndex] = VK_NULL_HANDLE;
+                        // 归还描述符集并标记为无效，避免在drawModels中使用
+                        releaseModelDescriptorSet(renderObject, frameIndex);
                         continue;
                     }
                     
@@ -1249,116 +1590,228 @@ namespace Elish
     }
     
     /**
-     * @brief Draw all loaded models using the model rendering pipeline
-     * This method renders all RenderObjects loaded by RenderResource
+     * @brief 选择本帧模型管线变体
+     * - 光线追踪反射或环境遮蔽生效时使用光照变体，集合1为TLAS与结果采样器，阴影来源与启用项由推送常量选择
+     * - 否则光线查询阴影生效时使用阴影变体，并绑定集合1（TLAS）
      */
-    void MainCameraPass::drawModels(RHICommandBuffer* command_buffer)
+    bool MainCameraPass::selectModelPipeline(uint32_t currentFrameIndex, ModelPipelineSelection& selection)
     {
         if (!m_render_resource) {
             LOG_WARN("[MainCameraPass::drawModels] No render resource available");
-            return;
+            return false;
         }
         
         // Use stored render objects instead of repeatedly accessing render resource
         if (m_loaded_render_objects.empty()) {
             LOG_WARN("[MainCameraPass::drawModels] No loaded render objects available for rendering");
-            return;
+            return false;
         }
         
-        // LOG_INFO("[MainCameraPass::drawModels] Starting to render {} models", m_loaded_render_objects.size());
-        
         // Check if model pipeline is available
         if (m_render_pipelines.size() < 3 || !m_render_pipelines[2].graphicsPipeline) {
             LOG_ERROR("[MainCameraPass::drawModels] Model rendering pipeline not available");
-            return;
+            return false;
         }
-        
-        
-        
+
+        selection.useRayQueryShadows = isRayQueryShadowsActive();
+        selection.hasRtReflections = m_rt_reflection_color && m_rt_reflection_guide;
+        selection.useRtLighting = (selection.hasRtReflections || m_rt_ambient_occlusion) && isRayTracedLightingSupported() &&
+                                  m_render_resource->getRayTracingResource().tlas != nullptr &&
+                                  updateRayTracedLightingDescriptorSet(currentFrameIndex);
+        if (!selection.useRtLighting && selection.useRayQueryShadows) {
+            selection.useRayQueryShadows = updateRayQueryDescriptorSet(currentFrameIndex);
+        }
+        selection.pipeline = selection.useRtLighting ? &m_render_pipelines[5] :
+                             (selection.useRayQueryShadows ? &m_render_pipelines[3] : &m_render_pipelines[2]);
+        return true;
+    }
+
+    /**
+     * @brief Draw loaded models using the selected model rendering pipeline
+     * @param filter 只录制静止模型、只录制动画模型或全部录制
+     */
+    void MainCameraPass::drawModels(RHICommandBuffer* command_buffer, const ModelPipelineSelection& selection, ModelDrawFilter filter)
+    {
+        uint32_t currentFrameIndex = m_rhi->getCurrentFrameIndex();
+        const RenderPipelineResource& modelPipeline = *selection.pipeline;
+
         // Bind model rendering pipeline
-        m_rhi->cmdBindPipelinePFN(command_buffer, RHI_PIPELINE_BIND_POINT_GRAPHICS, m_render_pipelines[2].graphicsPipeline);
+        m_rhi->cmdBindPipelinePFN(command_buffer, RHI_PIPELINE_BIND_POINT_GRAPHICS, modelPipeline.graphicsPipeline);
+        if (selection.useRtLighting) {
+            m_rhi->cmdBindDescriptorSetsPFN(command_buffer, RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                          modelPipeline.pipelineLayout, 1, 1,
+                                          &m_rt_lighting_descriptor_sets[currentFrameIndex], 0, nullptr);
+
+            RayTracedLightingPushConstants lightingConstants{};
+            lightingConstants.viewport_offset = glm::vec2(m_scene_viewport.x, m_scene_viewport.y);
+            lightingConstants.viewport_extent = glm::vec2(std::max(m_scene_viewport.width, 1.0f), std::max(m_scene_viewport.height, 1.0f));
+            lightingConstants.roughness_threshold = m_rt_reflection_roughness_threshold;
+            lightingConstants.flags = (selection.useRayQueryShadows ? k_rt_lighting_flag_ray_query_shadows : 0u) |
+                                      (selection.hasRtReflections ? k_rt_lighting_flag_reflections : 0u) |
+                                      (m_rt_ambient_occlusion ? k_rt_lighting_flag_ambient_occlusion : 0u);
+            m_rhi->cmdPushConstantsPFN(command_buffer, modelPipeline.pipelineLayout, RHI_SHADER_STAGE_FRAGMENT_BIT,
+                                     sizeof(glm::mat4), sizeof(RayTracedLightingPushConstants), &lightingConstants);
+        } else if (selection.useRayQueryShadows) {
+            m_rhi->cmdBindDescriptorSetsPFN(command_buffer, RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                          modelPipeline.pipelineLayout, 1, 1,
+                                          &m_ray_query_descriptor_sets[currentFrameIndex], 0, nullptr);
+        }
+
+        // 逐物体命令走编译期选择的命令列表：Vulkan后端直接调用原生函数，其余后端经RHI虚接口录制
+        if (VulkanRHI* vulkanRHI = dynamic_cast<VulkanRHI*>(m_rhi.get())) {
+            VulkanCommandList commandList(*vulkanRHI, command_buffer);
+            recordModelDraws(commandList, modelPipeline, currentFrameIndex, filter);
+        } else {
+            RHIGenericCommandList commandList(m_rhi.get(), command_buffer);
+            recordModelDraws(commandList, modelPipeline, currentFrameIndex, filter);
+        }
+    }
+
+    /**
+     * @brief 填写模型集合0的共享推送描述符写入
+     * @details 绑定与setupModelDescriptorSet()写入的描述符集一致：0/1为本帧MVP与灯光UBO，2为立方体贴图，
+     *          8为方向光阴影贴图，9为光源矩阵UBO；绑定3-7由setModelPushDescriptorTextures()逐物体填写
+     * @return 共享资源缺失时返回false，本次不绘制模型
+     */
+    bool MainCameraPass::prepareModelPushDescriptors(uint32_t currentFrameIndex, ModelPushDescriptors& descriptors) const
+    {
+        RHIImageView* cubemapImageView = m_render_resource->getCubemapImageView();
+        RHISampler* cubemapSampler = m_render_resource->getCubemapImageSampler();
+        RHIImageView* shadowMapImageView = m_render_resource->getDirectionalLightShadowImageView();
+        RHISampler* shadowMapSampler = m_render_resource->getDirectionalLightShadowImageSampler();
+        if (!cubemapImageView || !cubemapSampler || !shadowMapImageView || !shadowMapSampler ||
+            currentFrameIndex >= uniformBuffers.size() || !uniformBuffers[currentFrameIndex]) {
+            LOG_ERROR("[MainCameraPass::drawModels] Shared model resources are not ready for frame {}, skipping model rendering", currentFrameIndex);
+            return false;
+        }
+
+        descriptors.buffer_infos[0].buffer = uniformBuffers[currentFrameIndex];
+        descriptors.buffer_infos[0].offset = 0;
+        descriptors.buffer_infos[0].range = sizeof(UniformBufferObject);
+        descriptors.buffer_infos[1].buffer = viewUniformBuffers[currentFrameIndex];
+        descriptors.buffer_infos[1].offset = 0;
+        descriptors.buffer_infos[1].range = sizeof(UniformBufferObjectView);
+        descriptors.buffer_infos[2].buffer = lightSpaceMatrixBuffers[currentFrameIndex];
+        descriptors.buffer_infos[2].offset = 0;
+        descriptors.buffer_infos[2].range = sizeof(glm::mat4);
+
+        for (auto& imageInfo : descriptors.image_infos) {
+            imageInfo.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        }
+        descriptors.image_infos[0].imageView = cubemapImageView;
+        descriptors.image_infos[0].sampler = cubemapSampler;
+        descriptors.image_infos[6].imageView = shadowMapImageView;
+        descriptors.image_infos[6].sampler = shadowMapSampler;
+
+        for (uint32_t binding = 0; binding < ModelPushDescriptors::k_binding_count; ++binding) {
+            RHIWriteDescriptorSet& write = descriptors.writes[binding];
+            write.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = nullptr;     // 推送描述符不指定目标集合
+            write.dstBinding = binding;
+            write.dstArrayElement = 0;
+            write.descriptorCount = 1;
+            if (binding == 0 || binding == 1 || binding == 9) {
+                write.descriptorType = RHI_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                write.pBufferInfo = &descriptors.buffer_infos[binding == 9 ? 2 : binding];
+            } else {
+                write.descriptorType = RHI_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                write.pImageInfo = &descriptors.image_infos[binding - 2];
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 改写推送描述符中的物体纹理绑定3-7
+     * @details 纹理数量不足5张时循环复用，与setupModelDescriptorSet()一致
+     * @return 物体没有可用纹理时返回false
+     */
+    bool MainCameraPass::setModelPushDescriptorTextures(const RenderObject& render_object, ModelPushDescriptors& descriptors)
+    {
+        size_t textureCount = std::min(render_object.textureImageViews.size(), render_object.textureSamplers.size());
+        if (textureCount == 0) {
+            return false;
+        }
+        for (uint32_t binding = 3; binding < 8; ++binding) {
+            size_t textureIndex = (binding - 3) % textureCount;
+            RHIImageView* imageView = render_object.textureImageViews[textureIndex];
+            RHISampler* sampler = render_object.textureSamplers[textureIndex];
+            if (!imageView || !sampler) {
+                return false;
+            }
+            descriptors.image_infos[binding - 2].imageView = imageView;
+            descriptors.image_infos[binding - 2].sampler = sampler;
+        }
+        return true;
+    }
+
+    template<typename CommandList>
+    void MainCameraPass::recordModelDraws(CommandList& commandList, const RenderPipelineResource& modelPipeline, uint32_t currentFrameIndex, ModelDrawFilter filter)
+    {
+        // 管线布局在循环外转换为原生句柄，循环内只剩内联的原生调用
+        const auto pipelineLayout = CommandList::toNative(modelPipeline.pipelineLayout);
+
+        // 推送描述符模式：共享绑定只填写一次，逐物体只改写纹理绑定
+        const bool usePushDescriptors = m_render_resource->isModelPushDescriptorEnabled();
+        ModelPushDescriptors pushDescriptors;
+        if (usePushDescriptors && !prepareModelPushDescriptors(currentFrameIndex, pushDescriptors)) {
+            return;
+        }
 
-        
-        // 获取当前时间用于动画计算
-        float currentTime = static_cast<float>(glfwGetTime());
-        
         // Render each loaded model using stored data
         for (size_t i = 0; i < m_loaded_render_objects.size(); ++i) {
             const auto& renderObject = m_loaded_render_objects[i];
-            
-            // 计算每个模型的独立变换矩阵
-            glm::mat4 modelMatrix = glm::mat4(1.0f);
-            
-            // 应用位置变换
-            modelMatrix = glm::translate(modelMatrix, renderObject.animationParams.position);
-            
-            // 应用旋转变换（平台模型保持静止）
-            if (renderObject.animationParams.enableAnimation && !renderObject.animationParams.isPlatform) {
-                // 非平台模型的动画旋转
-                float rotationAngle = currentTime * renderObject.animationParams.rotationSpeed;
-                modelMatrix = glm::rotate(modelMatrix, rotationAngle, renderObject.animationParams.rotationAxis);
+
+            bool animated = m_render_resource->isRenderObjectAnimated(i);
+            if ((filter == ModelDrawFilter::StaticOnly && animated) || (filter == ModelDrawFilter::AnimatedOnly && !animated)) {
+                continue;
             }
-            // 应用静态旋转
-            modelMatrix = glm::rotate(modelMatrix, renderObject.animationParams.rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
-            modelMatrix = glm::rotate(modelMatrix, renderObject.animationParams.rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
-            modelMatrix = glm::rotate(modelMatrix, renderObject.animationParams.rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
             
-            // 应用缩放变换
-            modelMatrix = glm::scale(modelMatrix, renderObject.animationParams.scale);
+            // 世界矩阵由RenderResource的变换系统在帧开始时算好
+            const glm::mat4& modelMatrix = m_render_resource->getRenderObjectWorldMatrix(i);
             
-            // 通过Push Constants传递model矩阵到着色器
-            // LOG_DEBUG("[MainCameraPass::drawModels] About to call cmdPushConstantsPFN for model {}", i);
-            m_rhi->cmdPushConstantsPFN(command_buffer, m_render_pipelines[2].pipelineLayout, 
-                                     RHI_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &modelMatrix);
-            // LOG_DEBUG("[MainCameraPass::drawModels] cmdPushConstantsPFN completed for model {}", i);
-            
-            // Bind vertex buffer
-            // LOG_DEBUG("[MainCameraPass::drawModels] About to bind vertex buffer for model {}", i);
-            if (renderObject.vertexBuffer) {
-                RHIBuffer* vertex_buffers[] = {renderObject.vertexBuffer};
-                RHIDeviceSize offsets[] = {0};
-                m_rhi->cmdBindVertexBuffersPFN(command_buffer, 0, 1, vertex_buffers, offsets);
-                // LOG_DEBUG("[MainCameraPass::drawModels] Vertex buffer bound for model {}", i);
-            } else {
+            if (!renderObject.vertexBuffer) {
                 LOG_ERROR("[MainCameraPass::drawModels] Model {} has no vertex buffer", i);
                 continue;
             }
-            
-            // Bind index buffer
-            // LOG_DEBUG("[MainCameraPass::drawModels] About to bind index buffer for model {}", i);
-            if (renderObject.indexBuffer) {
-                m_rhi->cmdBindIndexBufferPFN(command_buffer, renderObject.indexBuffer, 0, RHI_INDEX_TYPE_UINT32);
-                // LOG_DEBUG("[MainCameraPass::drawModels] Index buffer bound for model {}", i);
-            } else {
+            if (!renderObject.indexBuffer) {
                 LOG_ERROR("[MainCameraPass::drawModels] Model {} has no index buffer", i);
                 continue;
             }
             
             // 检查描述符集是否有效
-            uint32_t currentFrameIndex = m_rhi->getCurrentFrameIndex();
-            if (renderObject.descriptorSets[currentFrameIndex] == VK_NULL_HANDLE) {
+            if (usePushDescriptors) {
+                if (!setModelPushDescriptorTextures(renderObject, pushDescriptors)) {
+                    LOG_WARN("[MainCameraPass::drawModels] Model {} has no valid textures, skipping", i);
+                    continue;
+                }
+            } else if (currentFrameIndex >= renderObject.descriptorSets.size() ||
+                       renderObject.descriptorSets[currentFrameIndex] == VK_NULL_HANDLE) {
                 LOG_WARN("[MainCameraPass::drawModels] Model {} has invalid descriptor set for frame {}, skipping", i, currentFrameIndex);
                 continue;
             }
             
+            // 通过Push Constants传递model矩阵到着色器
+            commandList.pushConstants(pipelineLayout, RHI_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &modelMatrix);
+            commandList.bindVertexBuffer(0, CommandList::toNative(renderObject.vertexBuffer), 0);
+            commandList.bindIndexBuffer(CommandList::toNative(renderObject.indexBuffer), 0, RHI_INDEX_TYPE_UINT32);
+            
             // 绑定模型渲染的描述符集
-            // LOG_DEBUG("[MainCameraPass::drawModels] About to bind descriptor sets for model {}", i);
-            m_rhi->cmdBindDescriptorSetsPFN(command_buffer, RHI_PIPELINE_BIND_POINT_GRAPHICS, 
-                                          m_render_pipelines[2].pipelineLayout, 0, 1, 
-                                          &renderObject.descriptorSets[currentFrameIndex], 0, nullptr);
-            // LOG_DEBUG("[MainCameraPass::drawModels] Descriptor sets bound for model {}", i);
+            if (usePushDescriptors) {
+                commandList.pushDescriptorSet(RHI_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0,
+                                              ModelPushDescriptors::k_binding_count, pushDescriptors.writes.data());
+            } else {
+                commandList.bindDescriptorSet(RHI_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0,
+                                              CommandList::toNative(renderObject.descriptorSets[currentFrameIndex]));
+            }
             
             // Draw the model
-            // LOG_DEBUG("[MainCameraPass::drawModels] About to draw model {} with {} indices", i, renderObject.indices.size());
             if (!renderObject.indices.empty()) {
-                m_rhi->cmdDrawIndexedPFN(command_buffer, static_cast<uint32_t>(renderObject.indices.size()), 1, 0, 0, 0);
-                // LOG_DEBUG("[MainCameraPass::drawModels] Model {} drawn successfully", i);
+                commandList.drawIndexed(static_cast<uint32_t>(renderObject.indices.size()), 1, 0, 0, 0);
             } else {
                 LOG_WARN("[MainCameraPass::drawModels] Model {} has no indices to render", i);
             }
         }
-        
-
     }
 
     void MainCameraPass::setupFramebufferDescriptorSet(){
@@ -1961,4 +2414,231 @@ namespace Elish
     {
         return m_enable_skybox;
     }
-}
\ No newline at end of file
+
+    /**
+     * @brief 设置光线查询阴影启用状态
+     */
+    void MainCameraPass::setRayQueryShadowsEnabled(bool enabled)
+    {
+        if (enabled && !m_rhi->isRayQuerySupported()) {
+            LOG_WARN("[MainCameraPass] Ray query is not supported on this device, keeping shadow map");
+            enabled = false;
+        }
+        m_enable_ray_query_shadows = enabled;
+        LOG_INFO("[MainCameraPass] Ray query shadows {}", enabled ? "enabled" : "disabled");
+    }
+
+    /**
+     * @brief 光线查询阴影在当前帧是否实际生效
+     */
+    bool MainCameraPass::isRayQueryShadowsActive() const
+    {
+        if (!m_enable_ray_query_shadows || !m_render_resource) {
+            return false;
+        }
+        if (m_render_pipelines.size() < 4 || !m_render_pipelines[3].graphicsPipeline) {
+            return false;
+        }
+        return m_render_resource->getRayTracingResource().tlas != nullptr;
+    }
+
+    /**
+     * @brief 分配并刷新当前帧的TLAS描述符集
+     * @details 每个飞行帧独占一个描述符集，仅在TLAS句柄变化（如加速结构重建）时重写，
+     *          避免修改仍被GPU使用的描述符集
+     * @return 描述符集可用返回true
+     */
+    bool MainCameraPass::updateRayQueryDescriptorSet(uint32_t currentFrameIndex)
+    {
+        uint32_t maxFramesInFlight = m_rhi->getMaxFramesInFlight();
+        if (m_ray_query_descriptor_sets.size() != maxFramesInFlight) {
+            m_ray_query_descriptor_sets.assign(maxFramesInFlight, nullptr);
+            m_ray_query_bound_tlas.assign(maxFramesInFlight, nullptr);
+        }
+
+        RHIDescriptorSet*& descriptorSet = m_ray_query_descriptor_sets[currentFrameIndex];
+        if (!descriptorSet) {
+            descriptorSet = m_descriptor_allocator->allocate(m_render_pipelines[3].descriptorSetLayout);
+            if (!descriptorSet) {
+                LOG_ERROR("[MainCameraPass] Failed to allocate ray query descriptor set for frame {}", currentFrameIndex);
+                return false;
+            }
+        }
+
+        RHIAccelerationStructure* tlas = m_render_resource->getRayTracingResource().tlas;
+        if (m_ray_query_bound_tlas[currentFrameIndex] != tlas) {
+            RHIWriteDescriptorSetAccelerationStructureKHR tlasInfo{};
+            tlasInfo.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR;
+            tlasInfo.accelerationStructureCount = 1;
+            tlasInfo.pAccelerationStructures = &tlas;
+
+            RHIWriteDescriptorSet tlasWrite{};
+            tlasWrite.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            tlasWrite.pNext = &tlasInfo;
+            tlasWrite.dstSet = descriptorSet;
+            tlasWrite.dstBinding = 0;
+            tlasWrite.dstArrayElement = 0;
+            tlasWrite.descriptorType = RHI_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+            tlasWrite.descriptorCount = 1;
+
+            m_rhi->updateDescriptorSets(1, &tlasWrite, 0, nullptr);
+            m_ray_query_bound_tlas[currentFrameIndex] = tlas;
+            invalidateStaticDraws();
+        }
+        return true;
+    }
+
+    /**
+     * @brief 设置本帧模型着色使用的半分辨率光线追踪反射
+     */
+    void MainCameraPass::setRayTracingReflectionSource(RHIImageView* color_view, RHIImageView* guide_view, float roughness_threshold)
+    {
+        m_rt_reflection_color = color_view;
+        m_rt_reflection_guide = guide_view;
+        m_rt_reflection_roughness_threshold = roughness_threshold;
+    }
+
+    /**
+     * @brief 光线追踪光照变体管线是否可用
+     */
+    bool MainCameraPass::isRayTracedLightingSupported() const
+    {
+        return m_render_pipelines.size() >= 6 && m_render_pipelines[5].graphicsPipeline != nullptr;
+    }
+
+    /**
+     * @brief 分配并刷新当前帧的光线追踪光照描述符集
+     * @details 与TLAS描述符集相同，每个飞行帧独占一个描述符集，仅在TLAS或结果图像视图变化时重写；
+     *          本帧未启用的结果由已启用的视图占位（对应标志位为0时着色器不读取）
+     * @return 描述符集可用返回true
+     */
+    bool MainCameraPass::updateRayTracedLightingDescriptorSet(uint32_t currentFrameIndex)
+    {
+        RHIImageView* fallbackView = m_rt_reflection_color ? m_rt_reflection_color : m_rt_ambient_occlusion;
+        if (!fallbackView) {
+            return false;
+        }
+        std::array<RHIImageView*, 3> views = {
+            m_rt_reflection_color ? m_rt_reflection_color : fallbackView,
+            m_rt_reflection_guide ? m_rt_reflection_guide : fallbackView,
+            m_rt_ambient_occlusion ? m_rt_ambient_occlusion : fallbackView,
+        };
+
+        uint32_t maxFramesInFlight = m_rhi->getMaxFramesInFlight();
+        if (m_rt_lighting_descriptor_sets.size() != maxFramesInFlight) {
+            m_rt_lighting_descriptor_sets.assign(maxFramesInFlight, nullptr);
+            m_rt_lighting_bound_tlas.assign(maxFramesInFlight, nullptr);
+            m_rt_lighting_bound_views.assign(maxFramesInFlight, {});
+        }
+
+        RHIDescriptorSet*& descriptorSet = m_rt_lighting_descriptor_sets[currentFrameIndex];
+        if (!descriptorSet) {
+            descriptorSet = m_descriptor_allocator->allocate(m_render_pipelines[5].descriptorSetLayout);
+            if (!descriptorSet) {
+                LOG_ERROR("[MainCameraPass] Failed to allocate ray traced lighting descriptor set for frame {}", currentFrameIndex);
+                return false;
+            }
+        }
+
+        RHIAccelerationStructure* tlas = m_render_resource->getRayTracingResource().tlas;
+        if (m_rt_lighting_bound_tlas[currentFrameIndex] != tlas ||
+            m_rt_lighting_bound_views[currentFrameIndex] != views) {
+            RHIWriteDescriptorSetAccelerationStructureKHR tlasInfo{};
+            tlasInfo.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR;
+            tlasInfo.accelerationStructureCount = 1;
+            tlasInfo.pAccelerationStructures = &tlas;
+
+            // 上采样以texelFetch读取，采样器仅用于满足组合图像采样器类型
+            RHIDescriptorImageInfo imageInfos[3] = {};
+            for (uint32_t i = 0; i < 3; ++i) {
+                imageInfos[i].imageLayout = RHI_IMAGE_LAYOUT_GENERAL;
+                imageInfos[i].imageView = views[i];
+                imageInfos[i].sampler = m_rhi->getOrCreateDefaultSampler(Default_Sampler_Linear);
+            }
+
+            RHIWriteDescriptorSet writes[4] = {};
+            writes[0].sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[0].pNext = &tlasInfo;
+            writes[0].dstSet = descriptorSet;
+            writes[0].dstBinding = 0;
+            writes[0].dstArrayElement = 0;
+            writes[0].descriptorType = RHI_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+            writes[0].descriptorCount = 1;
+            for (uint32_t i = 1; i < 4; ++i) {
+                writes[i].sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                writes[i].dstSet = descriptorSet;
+                writes[i].dstBinding = i;
+                writes[i].dstArrayElement = 0;
+                writes[i].descriptorType = RHI_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                writes[i].descriptorCount = 1;
+                writes[i].pImageInfo = &imageInfos[i - 1];
+            }
+
+            m_rhi->updateDescriptorSets(4, writes, 0, nullptr);
+            m_rt_lighting_bound_tlas[currentFrameIndex] = tlas;
+            m_rt_lighting_bound_views[currentFrameIndex] = views;
+            invalidateStaticDraws();
+        }
+        return true;
+    }
+
+    /**
+     * @brief 设置本帧在UI子通道中合成的光线追踪输出
+     */
+    void MainCameraPass::setRayTracingCompositeSource(RHIImageView* image_view, float opacity)
+    {
+        m_rt_composite_source = image_view;
+        m_rt_composite_opacity = std::clamp(opacity, 0.0f, 1.0f);
+    }
+
+    /**
+     * @brief 在UI子通道中合成光线追踪输出
+     * @details 采样描述符集由DescriptorAllocator按输出图像视图缓存，仅在视图变化（如分辨率缩放重建）时分配新集合。
+     *          子通道0经二级命令缓冲区执行后动态状态未定义，绑定合成管线前重新设置场景视口与裁剪矩形
+     */
+    void MainCameraPass::drawRayTracingComposite(RHICommandBuffer* command_buffer, const RHIViewport& viewport, const RHIRect2D& scissor)
+    {
+        if (!m_rt_composite_source || m_rt_composite_opacity <= 0.0f ||
+            m_render_pipelines.size() < 5 || !m_render_pipelines[4].graphicsPipeline) {
+            return;
+        }
+
+        RHIDescriptorImageInfo imageInfo{};
+        imageInfo.imageLayout = RHI_IMAGE_LAYOUT_GENERAL;
+        imageInfo.imageView = m_rt_composite_source;
+        imageInfo.sampler = m_rhi->getOrCreateDefaultSampler(Default_Sampler_Linear);
+
+        RHIWriteDescriptorSet write{};
+        write.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstBinding = 0;
+        write.dstArrayElement = 0;
+        write.descriptorType = RHI_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.descriptorCount = 1;
+        write.pImageInfo = &imageInfo;
+
+        RHIDescriptorSet* descriptorSet = m_descriptor_allocator->getOrCreate(m_rt_composite_descriptor_layout, 1, &write);
+        if (!descriptorSet) {
+            LOG_ERROR("[MainCameraPass] Failed to allocate ray tracing composite descriptor set for frame {}", m_rhi->getCurrentFrameIndex());
+            return;
+        }
+
+        RayTracingCompositePushConstants pushConstants{};
+        pushConstants.viewport_offset = glm::vec2(m_scene_viewport.x, m_scene_viewport.y);
+        pushConstants.viewport_extent = glm::vec2(std::max(m_scene_viewport.width, 1.0f), std::max(m_scene_viewport.height, 1.0f));
+        pushConstants.opacity = m_rt_composite_opacity;
+
+        float composite_color[4] = { 1.0f, 0.5f, 0.0f, 1.0f };
+        m_rhi->pushEvent(command_buffer, "RT COMPOSITE", composite_color);
+
+        m_rhi->cmdSetViewportPFN(command_buffer, 0, 1, &viewport);
+        m_rhi->cmdSetScissorPFN(command_buffer, 0, 1, &scissor);
+        m_rhi->cmdBindPipelinePFN(command_buffer, RHI_PIPELINE_BIND_POINT_GRAPHICS, m_render_pipelines[4].graphicsPipeline);
+        m_rhi->cmdBindDescriptorSetsPFN(command_buffer, RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                      m_render_pipelines[4].pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+        m_rhi->cmdPushConstantsPFN(command_buffer, m_render_pipelines[4].pipelineLayout,
+                                 RHI_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(RayTracingCompositePushConstants), &pushConstants);
+        m_rhi->cmdDraw(command_buffer, 3, 1, 0, 0);
+
+        m_rhi->popEvent(command_buffer);
+    }
+}
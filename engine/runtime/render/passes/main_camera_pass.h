@@ -1,5 +1,6 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <array>
 
 #include "../render_pass.h"
 #include "../render_resource.h"
@@ -18,6 +19,8 @@ namespace Elish
 {
     class MainCameraPass : public RenderPass
     {
+        friend class MainCameraPassTestAccess;  // engine/test中经NullRHI驱动私有的模型绘制路径
+
     public:
         // 核心渲染接口
         void initialize() override;
@@ -66,6 +69,58 @@ namespace Elish
          * @return 天空盒绘制是否启用
          */
         bool isSkyboxEnabled() const;
+
+        /**
+         * @brief 设置光线查询阴影启用状态
+         * @details 启用后模型使用PBR光线查询变体，每像素对TLAS发射一条阴影光线替代阴影贴图查找
+         * @param enabled 是否启用光线查询阴影
+         */
+        void setRayQueryShadowsEnabled(bool enabled);
+        bool isRayQueryShadowsEnabled() const { return m_enable_ray_query_shadows; }
+
+        /**
+         * @brief 光线查询阴影在当前帧是否实际生效
+         * @details 需同时满足：已启用、设备支持且变体管线已创建、场景TLAS可用；
+         *          生效时阴影贴图不会被采样，渲染管线可跳过阴影通道
+         */
+        bool isRayQueryShadowsActive() const;
+
+        /**
+         * @brief 设置本帧在UI子通道中合成的光线追踪输出
+         * @details 输出图像按场景视口双线性放大后以alpha混合绘制在光栅化结果之上、UI之下；
+         *          传入nullptr表示本帧不合成
+         * @param image_view 光线追踪输出图像视图（GENERAL布局，需带SAMPLED用途）
+         * @param opacity 合成不透明度[0,1]
+         */
+        void setRayTracingCompositeSource(RHIImageView* image_view, float opacity = 1.0f);
+
+        /**
+         * @brief 设置本帧模型着色使用的半分辨率光线追踪反射
+         * @details 设置后模型使用PBR光线追踪光照变体管线：按深度/法线感知地上采样反射结果，
+         *          替换粗糙度低于阈值的表面的天空盒镜面辐射度；传入nullptr表示本帧不使用
+         * @param color_view 反射结果图像视图（GENERAL布局，需带SAMPLED用途）
+         * @param guide_view 上采样引导图像视图（主表面法线与距离）
+         * @param roughness_threshold 反射通道使用的粗糙度阈值
+         */
+        void setRayTracingReflectionSource(RHIImageView* color_view, RHIImageView* guide_view, float roughness_threshold);
+
+        /**
+         * @brief 设置本帧模型着色使用的光线追踪环境遮蔽
+         * @details 设置后模型使用PBR光线追踪光照变体管线，深度感知地上采样的遮蔽值与材质AO贴图相乘后
+         *          作用于间接漫反射与镜面遮蔽；传入nullptr表示本帧不使用
+         * @param ao_view 环境遮蔽图像视图（r: 遮蔽, g: 主表面距离；GENERAL布局，需带SAMPLED用途）
+         */
+        void setRayTracingAmbientOcclusionSource(RHIImageView* ao_view) { m_rt_ambient_occlusion = ao_view; }
+
+        /**
+         * @brief 光线追踪光照变体管线是否可用（设备支持光线查询且管线已创建）
+         */
+        bool isRayTracedLightingSupported() const;
+
+        /**
+         * @brief 获取上一帧的场景视口，供半分辨率通道确定输出尺寸
+         */
+        const RHIViewport& getSceneViewport() const { return m_scene_viewport; }
         
         // 旧的兼容性接口已移除，现在使用 RenderResource 管理光源
 
@@ -146,6 +201,42 @@ namespace Elish
         std::vector<RHIDescriptorSet*> m_skybox_descriptor_sets;  // 天空盒渲染描述符集
         RHIDescriptorSetLayout* m_skybox_descriptor_layout = nullptr;  // 天空盒专用描述符布局
         
+        // 光线查询阴影资源（m_render_pipelines[3]为光线查询变体管线）
+        bool m_enable_ray_query_shadows = false;
+        std::vector<RHIDescriptorSet*> m_ray_query_descriptor_sets;          // 每帧一个TLAS描述符集（集合1）
+        std::vector<RHIAccelerationStructure*> m_ray_query_bound_tlas;       // 各描述符集当前绑定的TLAS，变化时重写
+
+        // 光线追踪合成资源（m_render_pipelines[4]为合成管线，位于UI子通道）
+        struct RayTracingCompositePushConstants {
+            glm::vec2 viewport_offset;
+            glm::vec2 viewport_extent;
+            float opacity;
+            float _padding[3];
+        };
+        RHIImageView* m_rt_composite_source = nullptr;
+        float m_rt_composite_opacity = 1.0f;
+        RHIDescriptorSetLayout* m_rt_composite_descriptor_layout = nullptr;
+        RHIViewport m_scene_viewport{};                                     // 本帧场景视口，供合成计算纹理坐标
+
+        // 光线追踪光照资源（m_render_pipelines[5]为反射/环境遮蔽变体模型管线）
+        struct RayTracedLightingPushConstants {
+            glm::vec2 viewport_offset;
+            glm::vec2 viewport_extent;
+            float roughness_threshold;
+            uint32_t flags;                 // bit0: 阴影使用光线查询, bit1: 反射有效, bit2: 环境遮蔽有效
+            float _padding[2];
+        };
+        static constexpr uint32_t k_rt_lighting_flag_ray_query_shadows = 1u << 0;
+        static constexpr uint32_t k_rt_lighting_flag_reflections = 1u << 1;
+        static constexpr uint32_t k_rt_lighting_flag_ambient_occlusion = 1u << 2;
+        RHIImageView* m_rt_reflection_color = nullptr;
+        RHIImageView* m_rt_reflection_guide = nullptr;
+        float m_rt_reflection_roughness_threshold = 0.0f;
+        RHIImageView* m_rt_ambient_occlusion = nullptr;
+        std::vector<RHIDescriptorSet*> m_rt_lighting_descriptor_sets;    // 每帧一个（TLAS + 反射/环境遮蔽采样器）
+        std::vector<RHIAccelerationStructure*> m_rt_lighting_bound_tlas;
+        std::vector<std::array<RHIImageView*, 3>> m_rt_lighting_bound_views;  // 各描述符集当前绑定的反射颜色/引导/环境遮蔽视图
+
         uint32_t layout_size = 10;//定义模型的描述符集布局大小，即需要几个绑定点  五张纹理，一张cubmap，三个缓冲区，一张阴影贴图
         // Render resource
         std::shared_ptr<RenderResource> m_render_resource = nullptr;
@@ -170,12 +261,72 @@ namespace Elish
 		// void createIndexBuffer();		// 创建IndexBuffer顶点点序缓存区
 		void createUniformBuffers();		// 创建UnifromBuffer统一缓存区
         
+        // 子通道0的二级命令缓冲区（每个飞行帧一组）：
+        // 静态部分（视口、背景、静止模型）只在场景、管线、描述符或视口变化时重新录制，其余帧直接执行；
+        // 动态部分（天空盒、动画模型）每帧录制。每帧变化的相机/灯光数据经各帧独立的uniform缓冲区传入，
+        // 因此静态命令无需因相机移动而重录
+        enum class ModelDrawFilter
+        {
+            All,
+            StaticOnly,     // 仅静止模型（含平台）
+            AnimatedOnly    // 仅随时间旋转的模型
+        };
+        struct ModelPipelineSelection
+        {
+            const RenderPipelineResource* pipeline = nullptr;
+            bool useRtLighting = false;
+            bool useRayQueryShadows = false;
+            bool hasRtReflections = false;
+        };
+        // 推送描述符模式下模型集合0的写入：共享绑定（UBO、立方体贴图、阴影贴图）每次录制填写一次，
+        // 纹理绑定3-7逐物体改写后随绘制推送；writes指向本结构体内的信息数组，填写后不得复制
+        struct ModelPushDescriptors
+        {
+            static constexpr uint32_t k_binding_count = 10;
+            std::array<RHIDescriptorBufferInfo, 3> buffer_infos{};     // 绑定0、1、9
+            std::array<RHIDescriptorImageInfo, 7> image_infos{};       // 绑定2-8
+            std::array<RHIWriteDescriptorSet, k_binding_count> writes{};
+        };
+        bool m_enable_secondary_command_buffers = true;             // 分配失败时关闭，回退到内联录制
+        std::vector<RHICommandBuffer*> m_static_command_buffers;
+        std::vector<RHICommandBuffer*> m_dynamic_command_buffers;
+        std::vector<uint64_t> m_static_command_keys;                 // 各帧静态命令录制时的状态哈希，0表示需要重录
+        uint64_t m_static_command_rerecords = 0;
+
         // 私有方法 - 绘制相关
         void drawBackground(RHICommandBuffer* command_buffer);
         void drawSkybox(RHICommandBuffer* command_buffer);  // 新增：天空盒绘制方法
-        void drawModels(RHICommandBuffer* command_buffer);
+        void drawModels(RHICommandBuffer* command_buffer, const ModelPipelineSelection& selection, ModelDrawFilter filter);
+        /**
+         * @brief 录制逐物体的模型绘制命令
+         * @tparam CommandList 命令列表后端（VulkanCommandList或RHIGenericCommandList），编译期确定
+         */
+        template<typename CommandList>
+        void recordModelDraws(CommandList& commandList, const RenderPipelineResource& modelPipeline, uint32_t currentFrameIndex, ModelDrawFilter filter);
+        /**
+         * @brief 选择本帧模型管线变体并刷新其集合1描述符集
+         * @return 无可绘制模型或模型管线不可用时返回false
+         */
+        bool selectModelPipeline(uint32_t currentFrameIndex, ModelPipelineSelection& selection);
+        void resolveSceneViewport(RHIViewport& viewport, RHIRect2D& scissor);   // 计算场景视口并更新相机宽高比
+        bool allocateSubpassCommandBuffers();
+        /**
+         * @brief 准备本帧子通道0的二级命令缓冲区：静态部分按需重录，动态部分每帧录制
+         * @param selection 模型管线选择，为nullptr表示本帧不绘制模型
+         * @return 失败时返回false，调用方回退到内联录制
+         */
+        bool recordSubpassCommandBuffers(uint32_t currentFrameIndex, const RHIViewport& viewport, const RHIRect2D& scissor,
+                                         const ModelPipelineSelection* selection);
+        uint64_t computeStaticDrawKey(uint32_t currentFrameIndex, const RHIViewport& viewport, const ModelPipelineSelection* selection) const;
+        void invalidateStaticDraws();   // 描述符集或帧缓冲重建后丢弃已录制的静态命令
+        bool prepareModelPushDescriptors(uint32_t currentFrameIndex, ModelPushDescriptors& descriptors) const;
+        void releaseModelDescriptorSet(RenderObject& render_object, uint32_t frame_index);
+        static bool setModelPushDescriptorTextures(const RenderObject& render_object, ModelPushDescriptors& descriptors);
         void drawUI(RHICommandBuffer* command_buffer);
         void updateUniformBuffer(uint32_t currentFrameIndex);
+        bool updateRayQueryDescriptorSet(uint32_t currentFrameIndex);  // 分配/刷新当前帧TLAS描述符集
+        bool updateRayTracedLightingDescriptorSet(uint32_t currentFrameIndex);  // 分配/刷新当前帧光线追踪光照描述符集
+        void drawRayTracingComposite(RHICommandBuffer* command_buffer, const RHIViewport& viewport, const RHIRect2D& scissor); // UI子通道内合成光线追踪输出
          
         // 静态方法 - 顶点输入描述
         static std::vector<RHIVertexInputBindingDescription> getVertexBindingDescriptions();
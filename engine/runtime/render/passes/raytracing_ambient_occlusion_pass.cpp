@@ -0,0 +1,394 @@
+#include "raytracing_ambient_occlusion_pass.h"
+#include "../../core/base/macro.h"
+#include "../../render/interface/rhi.h"
+#include "../render_resource.h"
+#include "../render_camera.h"
+#include "../descriptor_allocator.h"
+
+#include <glm/gtc/matrix_access.hpp>
+#include <stdexcept>
+
+// 包含生成的光线追踪环境遮蔽计算着色器头文件
+#include "../../shader/generated/cpp/rt_ambient_occlusion_comp.h"
+
+namespace Elish
+{
+    /**
+     * @brief 析构函数
+     * @details 等待GPU完成后释放输出图像与管线
+     */
+    RayTracingAmbientOcclusionPass::~RayTracingAmbientOcclusionPass()
+    {
+        if (!m_rhi)
+        {
+            return;
+        }
+
+        waitForGpuIdle();
+
+        destroyOutputImages();
+
+        // 计算管线归管线缓存所有，销毁布局前移除以该布局为键的缓存管线
+        m_pipeline = nullptr;
+        if (m_pipeline_layout)
+        {
+            if (m_pipeline_cache)
+            {
+                m_pipeline_cache->releasePipelineLayout(m_pipeline_layout);
+            }
+            m_rhi->destroyPipelineLayout(m_pipeline_layout);
+            m_pipeline_layout = nullptr;
+        }
+    }
+
+    /**
+     * @brief 初始化遮蔽通道
+     */
+    void RayTracingAmbientOcclusionPass::initialize()
+    {
+        m_is_initialized = false;
+
+        if (!m_rhi)
+        {
+            LOG_ERROR("[RayTracingAmbientOcclusionPass] RHI is null, cannot initialize ray traced ambient occlusion");
+            return;
+        }
+
+        if (!m_rhi->isRayQuerySupported())
+        {
+            LOG_INFO("[RayTracingAmbientOcclusionPass] Ray query not supported, ray traced ambient occlusion disabled");
+            return;
+        }
+
+        m_is_initialized = runSetupStep("[RayTracingAmbientOcclusionPass]", "Initialization failed", [this]() {
+            setupDescriptorSetLayout();
+            setupPipeline();
+        });
+        if (m_is_initialized)
+        {
+            LOG_INFO("[RayTracingAmbientOcclusionPass] Ray traced ambient occlusion initialized");
+        }
+    }
+
+    /**
+     * @brief 准备遮蔽数据
+     */
+    void RayTracingAmbientOcclusionPass::preparePassData(std::shared_ptr<RenderResource> render_resource)
+    {
+        m_render_resource = render_resource;
+        if (!render_resource)
+        {
+            return;
+        }
+
+        auto camera = render_resource->getCamera();
+        if (camera)
+        {
+            m_current_view_proj = camera->getPersProjMatrix() * camera->getViewMatrix();
+        }
+    }
+
+    /**
+     * @brief 设置遮蔽输出分辨率
+     */
+    void RayTracingAmbientOcclusionPass::setOutputSize(uint32_t width, uint32_t height)
+    {
+        if (!m_is_initialized || width == 0 || height == 0)
+        {
+            return;
+        }
+        if (width == m_width && height == m_height && m_outputs[0].image)
+        {
+            return;
+        }
+
+        // 输出图像可能仍被在途帧的计算或片段着色器引用，重建前等待GPU空闲
+        waitForGpuIdle();
+
+        m_width = width;
+        m_height = height;
+
+        if (runSetupStep("[RayTracingAmbientOcclusionPass]", "Failed to create occlusion buffers", [this]() { createOutputImages(); }))
+        {
+            LOG_DEBUG("[RayTracingAmbientOcclusionPass] Occlusion buffers resized to {}x{}", m_width, m_height);
+        }
+        else
+        {
+            destroyOutputImages();
+        }
+    }
+
+    /**
+     * @brief 录制遮蔽追踪与时域滤波命令
+     */
+    void RayTracingAmbientOcclusionPass::draw(RHICommandBuffer* command_buffer)
+    {
+        if (!isReady() || !command_buffer || !m_render_resource)
+        {
+            return;
+        }
+
+        uint32_t frame_index = m_rhi->getCurrentFrameIndex();
+        if (!updateDescriptorSet(frame_index))
+        {
+            return;
+        }
+
+        if (!m_output_images_initialized)
+        {
+            // 首次使用时将乒乓输出图像转换到GENERAL布局，历史内容未定义
+            RHIImageMemoryBarrier barriers[2] = {};
+            for (uint32_t i = 0; i < 2; ++i)
+            {
+                barriers[i].sType = RHI_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                barriers[i].oldLayout = RHI_IMAGE_LAYOUT_UNDEFINED;
+                barriers[i].newLayout = RHI_IMAGE_LAYOUT_GENERAL;
+                barriers[i].srcQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
+                barriers[i].dstQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
+                barriers[i].image = m_outputs[i].image;
+                barriers[i].subresourceRange.aspectMask = RHI_IMAGE_ASPECT_COLOR_BIT;
+                barriers[i].subresourceRange.baseMipLevel = 0;
+                barriers[i].subresourceRange.levelCount = 1;
+                barriers[i].subresourceRange.baseArrayLayer = 0;
+                barriers[i].subresourceRange.layerCount = 1;
+                barriers[i].srcAccessMask = 0;
+                barriers[i].dstAccessMask = RHI_ACCESS_SHADER_READ_BIT | RHI_ACCESS_SHADER_WRITE_BIT;
+            }
+
+            m_rhi->cmdPipelineBarrier(
+                command_buffer,
+                RHI_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                0,
+                0, nullptr,
+                0, nullptr,
+                2, barriers);
+
+            m_output_images_initialized = true;
+            m_history_valid = false;
+        }
+        else
+        {
+            // 本帧写入的图像在两帧前曾被片段着色器读取（读后写冲突）
+            m_rhi->cmdPipelineBarrier(
+                command_buffer,
+                RHI_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                0,
+                0, nullptr,
+                0, nullptr,
+                0, nullptr);
+        }
+
+        AmbientOcclusionPushConstants push_constants{};
+        push_constants.view_proj_inverse = glm::inverse(m_current_view_proj);
+        push_constants.prev_view_proj_row0 = glm::row(m_prev_view_proj, 0);
+        push_constants.prev_view_proj_row1 = glm::row(m_prev_view_proj, 1);
+        push_constants.prev_view_proj_row3 = glm::row(m_prev_view_proj, 3);
+        push_constants.max_distance = m_radius;
+        push_constants.max_history = m_history_valid ? k_max_history : 0.0f;
+        push_constants.frame_index = m_frame_number++;
+        push_constants.ray_count = m_rays_per_pixel;
+
+        m_rhi->cmdBindPipelinePFN(command_buffer, RHI_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+        m_rhi->cmdBindDescriptorSetsPFN(command_buffer, RHI_PIPELINE_BIND_POINT_COMPUTE, m_pipeline_layout,
+            0, 1, &m_descriptor_sets[frame_index], 0, nullptr);
+        m_rhi->cmdPushConstantsPFN(command_buffer, m_pipeline_layout, RHI_SHADER_STAGE_COMPUTE_BIT,
+            0, sizeof(AmbientOcclusionPushConstants), &push_constants);
+        m_rhi->cmdDispatch(command_buffer,
+            (m_width + k_workgroup_size - 1) / k_workgroup_size,
+            (m_height + k_workgroup_size - 1) / k_workgroup_size,
+            1);
+
+        // 遮蔽结果供主相机通道的片段着色器上采样，并作为下一帧的历史
+        RHIMemoryBarrier completion_barrier{};
+        completion_barrier.sType = RHI_STRUCTURE_TYPE_MEMORY_BARRIER;
+        completion_barrier.srcAccessMask = RHI_ACCESS_SHADER_WRITE_BIT;
+        completion_barrier.dstAccessMask = RHI_ACCESS_SHADER_READ_BIT;
+        m_rhi->cmdPipelineBarrier(
+            command_buffer,
+            RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            RHI_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0,
+            1, &completion_barrier,
+            0, nullptr,
+            0, nullptr);
+
+        m_prev_view_proj = m_current_view_proj;
+        m_history_valid = true;
+        m_output_index ^= 1u;
+    }
+
+    /**
+     * @brief 创建描述符集布局
+     * @details 0 TLAS, 1 几何地址表, 2 历史遮蔽, 3 本帧遮蔽
+     */
+    void RayTracingAmbientOcclusionPass::setupDescriptorSetLayout()
+    {
+        RHIDescriptorSetLayoutBinding bindings[4] = {};
+        const RHIDescriptorType types[4] = {
+            RHI_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
+            RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+            RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+        };
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = types[i];
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = RHI_SHADER_STAGE_COMPUTE_BIT;
+            bindings[i].pImmutableSamplers = nullptr;
+        }
+
+        RHIDescriptorSetLayoutCreateInfo layout_create_info{};
+        layout_create_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layout_create_info.bindingCount = 4;
+        layout_create_info.pBindings = bindings;
+
+        if (m_rhi->createDescriptorSetLayout(&layout_create_info, m_descriptor_set_layout) != RHI_SUCCESS)
+        {
+            throw std::runtime_error("[RayTracingAmbientOcclusionPass] Failed to create descriptor set layout");
+        }
+    }
+
+    /**
+     * @brief 创建遮蔽计算管线
+     */
+    void RayTracingAmbientOcclusionPass::setupPipeline()
+    {
+        RHIPushConstantRange push_constant_range{};
+        push_constant_range.stageFlags = RHI_SHADER_STAGE_COMPUTE_BIT;
+        push_constant_range.offset = 0;
+        push_constant_range.size = sizeof(AmbientOcclusionPushConstants);
+
+        RHIPipelineLayoutCreateInfo pipeline_layout_create_info{};
+        pipeline_layout_create_info.sType = RHI_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipeline_layout_create_info.setLayoutCount = 1;
+        pipeline_layout_create_info.pSetLayouts = &m_descriptor_set_layout;
+        pipeline_layout_create_info.pushConstantRangeCount = 1;
+        pipeline_layout_create_info.pPushConstantRanges = &push_constant_range;
+
+        if (m_rhi->createPipelineLayout(&pipeline_layout_create_info, m_pipeline_layout) != RHI_SUCCESS)
+        {
+            throw std::runtime_error("[RayTracingAmbientOcclusionPass] Failed to create pipeline layout");
+        }
+
+        RHIShader* shader_module = m_pipeline_cache->getShader(RT_AMBIENT_OCCLUSION_COMP);
+        if (!shader_module)
+        {
+            throw std::runtime_error("[RayTracingAmbientOcclusionPass] Failed to create compute shader module");
+        }
+
+        RHIPipelineShaderStageCreateInfo stage{};
+        stage.sType = RHI_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stage.stage = RHI_SHADER_STAGE_COMPUTE_BIT;
+        stage.module = shader_module;
+        stage.pName = "main";
+        stage.pSpecializationInfo = nullptr;
+
+        RHIComputePipelineCreateInfo pipeline_create_info{};
+        pipeline_create_info.sType = RHI_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipeline_create_info.pStages = &stage;
+        pipeline_create_info.layout = m_pipeline_layout;
+        pipeline_create_info.basePipelineHandle = RHI_NULL_HANDLE;
+        pipeline_create_info.basePipelineIndex = -1;
+
+        m_pipeline = m_pipeline_cache->getOrCreateComputePipeline(pipeline_create_info);
+        if (!m_pipeline)
+        {
+            throw std::runtime_error("[RayTracingAmbientOcclusionPass] Failed to create compute pipeline");
+        }
+    }
+
+    /**
+     * @brief 创建乒乓输出图像（rgba16f，可作存储图像与采样图像）
+     */
+    void RayTracingAmbientOcclusionPass::createOutputImages()
+    {
+        destroyOutputImages();
+        for (auto& attachment : m_outputs)
+        {
+            createStorageImage(m_width, m_height, RHI_FORMAT_R16G16B16A16_SFLOAT,
+                               RHI_IMAGE_USAGE_STORAGE_BIT | RHI_IMAGE_USAGE_SAMPLED_BIT, attachment);
+        }
+        m_output_images_initialized = false;
+        m_history_valid = false;
+        m_output_index = 0;
+    }
+
+    /**
+     * @brief 销毁输出图像
+     */
+    void RayTracingAmbientOcclusionPass::destroyOutputImages()
+    {
+        for (auto& attachment : m_outputs)
+        {
+            destroyStorageImage(attachment);
+        }
+    }
+
+    /**
+     * @brief 从分配器缓存取得与当前TLAS、几何地址表和乒乓方向匹配的描述符集
+     * @return 描述符集可用返回true
+     */
+    bool RayTracingAmbientOcclusionPass::updateDescriptorSet(uint32_t frame_index)
+    {
+        const RayTracingResource& ray_tracing_resource = m_render_resource->getRayTracingResource();
+        RHIAccelerationStructure* tlas = ray_tracing_resource.tlas;
+        RHIBuffer* geometry_table = ray_tracing_resource.geometryAddressBuffer;
+        if (!tlas || !geometry_table)
+        {
+            return false;
+        }
+
+        uint32_t max_frames_in_flight = m_rhi->getMaxFramesInFlight();
+        if (m_descriptor_sets.size() != max_frames_in_flight)
+        {
+            m_descriptor_sets.assign(max_frames_in_flight, nullptr);
+        }
+
+        RHIWriteDescriptorSetAccelerationStructureKHR tlas_info{};
+        tlas_info.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR;
+        tlas_info.accelerationStructureCount = 1;
+        tlas_info.pAccelerationStructures = &tlas;
+
+        RHIDescriptorBufferInfo geometry_table_info{};
+        geometry_table_info.buffer = geometry_table;
+        geometry_table_info.offset = 0;
+        geometry_table_info.range = RHI_WHOLE_SIZE;
+
+        RHIDescriptorImageInfo image_infos[2] = {};
+        image_infos[0].imageLayout = RHI_IMAGE_LAYOUT_GENERAL;
+        image_infos[0].imageView = m_outputs[m_output_index ^ 1u].view;
+        image_infos[1].imageLayout = RHI_IMAGE_LAYOUT_GENERAL;
+        image_infos[1].imageView = m_outputs[m_output_index].view;
+
+        RHIWriteDescriptorSet writes[4] = {};
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            writes[i].sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstBinding = i;
+            writes[i].dstArrayElement = 0;
+            writes[i].descriptorCount = 1;
+        }
+        writes[0].pNext = &tlas_info;
+        writes[0].descriptorType = RHI_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+        writes[1].descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[1].pBufferInfo = &geometry_table_info;
+        writes[2].descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[2].pImageInfo = &image_infos[0];
+        writes[3].descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[3].pImageInfo = &image_infos[1];
+
+        // 两个乒乓方向各命中一个缓存的描述符集，TLAS或几何地址表不变时不再重写
+        m_descriptor_sets[frame_index] = m_descriptor_allocator->getOrCreate(m_descriptor_set_layout, 4, writes);
+        if (!m_descriptor_sets[frame_index])
+        {
+            LOG_ERROR("[RayTracingAmbientOcclusionPass] Failed to allocate descriptor set for frame {}", frame_index);
+            return false;
+        }
+        return true;
+    }
+
+} // namespace Elish
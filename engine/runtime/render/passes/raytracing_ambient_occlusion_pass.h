@@ -0,0 +1,128 @@
+#pragma once
+
+#include "../render_pass.h"
+#include "../render_resource.h"
+#include <glm/glm.hpp>
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace Elish
+{
+    /**
+     * @brief 半分辨率光线追踪环境遮蔽（RTAO）通道
+     * @details 材质AO贴图只描述网格自身的遮蔽，本通道补充物体之间的动态接触遮蔽：
+     *          计算着色器以光线查询求主光线可见表面，在法线半球内发射少量短距离、命中即终止的遮蔽光线，
+     *          再经深度一致性检查的时域累积降噪；结果由主相机通道的PBR光照变体深度感知地上采样后乘入环境光照
+     */
+    class RayTracingAmbientOcclusionPass : public RenderPass
+    {
+    public:
+        RayTracingAmbientOcclusionPass() = default;
+        ~RayTracingAmbientOcclusionPass();
+
+        /**
+         * @brief 初始化遮蔽通道
+         * @details 设备不支持光线查询时不创建任何资源，isReady()保持false
+         */
+        void initialize() override;
+
+        /**
+         * @brief 准备遮蔽数据
+         * @param render_resource 渲染资源管理器，用于获取相机矩阵、TLAS与几何地址表
+         */
+        void preparePassData(std::shared_ptr<RenderResource> render_resource) override;
+
+        /**
+         * @brief 设置遮蔽输出分辨率（通常为场景视口的一半）
+         * @details 分辨率变化时等待GPU空闲后重建输出图像并丢弃历史，未变化时直接返回
+         */
+        void setOutputSize(uint32_t width, uint32_t height);
+
+        /**
+         * @brief 录制遮蔽追踪与时域滤波命令
+         * @details 结束时插入计算->片段着色器屏障，输出图像保持GENERAL布局供片段着色器读取
+         */
+        void draw(RHICommandBuffer* command_buffer);
+
+        bool isReady() const { return m_is_initialized && m_outputs[0].view && m_outputs[1].view; }
+
+        void setEnabled(bool enabled) { m_enabled = enabled; m_history_valid = false; }
+        bool isEnabled() const { return m_enabled; }
+
+        /**
+         * @brief 设置遮蔽光线的最大距离（世界单位），只统计该范围内的接触遮蔽
+         */
+        void setRadius(float radius) { m_radius = glm::max(radius, 0.01f); }
+        float getRadius() const { return m_radius; }
+
+        /**
+         * @brief 设置每像素遮蔽光线数（1~4）
+         */
+        void setRaysPerPixel(uint32_t rays) { m_rays_per_pixel = glm::clamp(rays, 1u, 4u); }
+        uint32_t getRaysPerPixel() const { return m_rays_per_pixel; }
+
+        /**
+         * @brief 获取本帧写入的遮蔽结果（draw之后有效）
+         */
+        RHIImageView* getAmbientOcclusionView() const { return m_outputs[m_output_index ^ 1u].view; }
+
+        /**
+         * @brief 丢弃历史（如场景切换）
+         */
+        void resetHistory() { m_history_valid = false; }
+
+    private:
+        /**
+         * @brief 遮蔽推送常量
+         * @details 与rt_ambient_occlusion.comp中的PushConstants布局一致，共128字节
+         */
+        struct AmbientOcclusionPushConstants {
+            glm::mat4 view_proj_inverse;      // 视图投影矩阵的逆
+            glm::vec4 prev_view_proj_row0;    // 上一帧视图投影矩阵第0行
+            glm::vec4 prev_view_proj_row1;    // 上一帧视图投影矩阵第1行
+            glm::vec4 prev_view_proj_row3;    // 上一帧视图投影矩阵第3行
+            float max_distance;               // 遮蔽光线最大距离
+            float max_history;                // 时域累积帧数上限，0表示历史无效
+            uint32_t frame_index;             // 帧序号
+            uint32_t ray_count;               // 每像素遮蔽光线数
+        };
+
+        static constexpr uint32_t k_workgroup_size = 8;
+        static constexpr float k_max_history = 16.0f;
+
+        void setupDescriptorSetLayout();
+        void setupPipeline();
+        void createOutputImages();
+        void destroyOutputImages();
+        bool updateDescriptorSet(uint32_t frame_index);
+
+    private:
+        bool m_is_initialized = false;
+        bool m_enabled = false;
+        bool m_history_valid = false;
+        bool m_output_images_initialized = false;  // 输出图像是否已转换到GENERAL布局
+        float m_radius = 0.5f;
+        uint32_t m_rays_per_pixel = 2;
+        uint32_t m_frame_number = 0;
+
+        uint32_t m_width = 0;
+        uint32_t m_height = 0;
+
+        // 输出乒乓：本帧写入m_outputs[m_output_index]，读取另一张作为历史（rgba16f）
+        std::array<FrameBufferAttachment, 2> m_outputs{};
+        uint32_t m_output_index = 0;
+
+        // 各飞行帧本帧使用的描述符集，由DescriptorAllocator按绑定资源缓存
+        RHIDescriptorSetLayout* m_descriptor_set_layout = nullptr;
+        std::vector<RHIDescriptorSet*> m_descriptor_sets;
+
+        RHIPipelineLayout* m_pipeline_layout = nullptr;
+        RHIPipeline* m_pipeline = nullptr;
+
+        std::shared_ptr<RenderResource> m_render_resource;
+        glm::mat4 m_current_view_proj = glm::mat4(1.0f);
+        glm::mat4 m_prev_view_proj = glm::mat4(1.0f);
+    };
+
+} // namespace Elish
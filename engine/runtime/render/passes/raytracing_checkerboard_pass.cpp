@@ -0,0 +1,398 @@
+#include "raytracing_checkerboard_pass.h"
+#include "../../core/base/macro.h"
+#include "../../render/interface/rhi.h"
+#include "../render_resource.h"
+#include "../render_camera.h"
+#include "../descriptor_allocator.h"
+
+#include <stdexcept>
+#include <vector>
+
+// 包含生成的棋盘格重建计算着色器头文件
+#include "../../shader/generated/cpp/rt_checkerboard_comp.h"
+
+namespace Elish
+{
+    /**
+     * @brief 析构函数
+     * @details 等待GPU完成后释放历史缓冲区与管线
+     */
+    RayTracingCheckerboardPass::~RayTracingCheckerboardPass()
+    {
+        if (!m_rhi)
+        {
+            return;
+        }
+
+        waitForGpuIdle();
+
+        destroyHistoryImages();
+
+        // 计算管线归管线缓存所有，销毁布局前移除以该布局为键的缓存管线
+        m_pipeline = nullptr;
+        if (m_pipeline_layout)
+        {
+            if (m_pipeline_cache)
+            {
+                m_pipeline_cache->releasePipelineLayout(m_pipeline_layout);
+            }
+            m_rhi->destroyPipelineLayout(m_pipeline_layout);
+            m_pipeline_layout = nullptr;
+        }
+    }
+
+    /**
+     * @brief 初始化重建通道
+     */
+    void RayTracingCheckerboardPass::initialize()
+    {
+        m_is_initialized = false;
+
+        if (!m_rhi)
+        {
+            LOG_ERROR("[RayTracingCheckerboardPass] RHI is null, cannot initialize checkerboard reconstruction");
+            return;
+        }
+
+        m_is_initialized = runSetupStep("[RayTracingCheckerboardPass]", "Initialization failed", [this]() {
+            setupDescriptorSetLayout();
+            setupPipeline();
+        });
+        if (m_is_initialized)
+        {
+            LOG_INFO("[RayTracingCheckerboardPass] Checkerboard reconstruction initialized");
+        }
+    }
+
+    /**
+     * @brief 准备重建数据
+     */
+    void RayTracingCheckerboardPass::preparePassData(std::shared_ptr<RenderResource> render_resource)
+    {
+        if (!render_resource)
+        {
+            return;
+        }
+
+        auto camera = render_resource->getCamera();
+        if (camera)
+        {
+            m_current_view_proj = camera->getPersProjMatrix() * camera->getViewMatrix();
+        }
+    }
+
+    /**
+     * @brief 设置重建输入图像
+     */
+    void RayTracingCheckerboardPass::setInputImages(RHIImageView* color_view, RHIImageView* gbuffer_position_view,
+                                                    RHIImageView* gbuffer_normal_view, RHIImageView* gbuffer_albedo_view,
+                                                    uint32_t width, uint32_t height)
+    {
+        if (!m_is_initialized || !color_view || !gbuffer_position_view || !gbuffer_normal_view || !gbuffer_albedo_view ||
+            width == 0 || height == 0)
+        {
+            return;
+        }
+
+        bool inputs_changed = color_view != m_color_view ||
+                              gbuffer_position_view != m_gbuffer_position_view ||
+                              gbuffer_normal_view != m_gbuffer_normal_view ||
+                              gbuffer_albedo_view != m_gbuffer_albedo_view;
+        bool size_changed = width != m_width || height != m_height;
+        if (!inputs_changed && !size_changed)
+        {
+            return;
+        }
+
+        // 描述符集与历史图像可能仍被在途帧引用，重建前等待GPU空闲
+        waitForGpuIdle();
+
+        m_color_view = color_view;
+        m_gbuffer_position_view = gbuffer_position_view;
+        m_gbuffer_normal_view = gbuffer_normal_view;
+        m_gbuffer_albedo_view = gbuffer_albedo_view;
+
+        bool rebuilt = runSetupStep("[RayTracingCheckerboardPass]", "Failed to rebuild reconstruction resources", [&]() {
+            if (size_changed || !m_history_color[0].image)
+            {
+                m_width = width;
+                m_height = height;
+                createHistoryImages();
+            }
+            updateDescriptorSets();
+        });
+        if (rebuilt)
+        {
+            LOG_DEBUG("[RayTracingCheckerboardPass] Inputs rebound at {}x{}", m_width, m_height);
+        }
+        else
+        {
+            destroyHistoryImages();
+        }
+    }
+
+    /**
+     * @brief 录制重建命令
+     */
+    void RayTracingCheckerboardPass::draw(RHICommandBuffer* command_buffer, uint32_t parity)
+    {
+        if (!m_is_initialized || !command_buffer || !m_history_color[0].image || !m_descriptor_sets[0])
+        {
+            return;
+        }
+
+        // 首次使用时将历史图像转换到GENERAL布局
+        if (!m_history_images_initialized)
+        {
+            std::vector<RHIImageMemoryBarrier> barriers;
+            auto add_barrier = [&barriers](RHIImage* image) {
+                RHIImageMemoryBarrier barrier{};
+                barrier.sType = RHI_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                barrier.oldLayout = RHI_IMAGE_LAYOUT_UNDEFINED;
+                barrier.newLayout = RHI_IMAGE_LAYOUT_GENERAL;
+                barrier.srcQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
+                barrier.image = image;
+                barrier.subresourceRange.aspectMask = RHI_IMAGE_ASPECT_COLOR_BIT;
+                barrier.subresourceRange.baseMipLevel = 0;
+                barrier.subresourceRange.levelCount = 1;
+                barrier.subresourceRange.baseArrayLayer = 0;
+                barrier.subresourceRange.layerCount = 1;
+                barrier.srcAccessMask = 0;
+                barrier.dstAccessMask = RHI_ACCESS_SHADER_READ_BIT | RHI_ACCESS_SHADER_WRITE_BIT;
+                barriers.push_back(barrier);
+            };
+            for (auto& attachment : m_history_color)
+            {
+                add_barrier(attachment.image);
+            }
+            for (auto& attachment : m_history_position)
+            {
+                add_barrier(attachment.image);
+            }
+
+            m_rhi->cmdPipelineBarrier(
+                command_buffer,
+                RHI_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                0,
+                0, nullptr,
+                0, nullptr,
+                static_cast<uint32_t>(barriers.size()), barriers.data());
+
+            m_history_images_initialized = true;
+            m_history_valid = false;
+        }
+
+        // 等待光线追踪写入输出图像和G-Buffer
+        RHIMemoryBarrier rt_barrier{};
+        rt_barrier.sType = RHI_STRUCTURE_TYPE_MEMORY_BARRIER;
+        rt_barrier.srcAccessMask = RHI_ACCESS_SHADER_WRITE_BIT;
+        rt_barrier.dstAccessMask = RHI_ACCESS_SHADER_READ_BIT | RHI_ACCESS_SHADER_WRITE_BIT;
+        m_rhi->cmdPipelineBarrier(
+            command_buffer,
+            RHI_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+            RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0,
+            1, &rt_barrier,
+            0, nullptr,
+            0, nullptr);
+
+        CheckerboardPushConstants push_constants{};
+        push_constants.prev_view_proj = m_prev_view_proj;
+        push_constants.parity = parity & 1u;
+        push_constants.flags = m_history_valid ? k_flag_history_valid : 0u;
+
+        m_rhi->cmdBindPipelinePFN(command_buffer, RHI_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+        m_rhi->cmdBindDescriptorSetsPFN(command_buffer, RHI_PIPELINE_BIND_POINT_COMPUTE, m_pipeline_layout,
+            0, 1, &m_descriptor_sets[m_history_index], 0, nullptr);
+        m_rhi->cmdPushConstantsPFN(command_buffer, m_pipeline_layout, RHI_SHADER_STAGE_COMPUTE_BIT,
+            0, sizeof(CheckerboardPushConstants), &push_constants);
+        m_rhi->cmdDispatch(command_buffer,
+            (m_width + k_workgroup_size - 1) / k_workgroup_size,
+            (m_height + k_workgroup_size - 1) / k_workgroup_size,
+            1);
+
+        // 重建结果供降噪与合成使用
+        RHIMemoryBarrier completion_barrier{};
+        completion_barrier.sType = RHI_STRUCTURE_TYPE_MEMORY_BARRIER;
+        completion_barrier.srcAccessMask = RHI_ACCESS_SHADER_WRITE_BIT;
+        completion_barrier.dstAccessMask = RHI_ACCESS_MEMORY_READ_BIT | RHI_ACCESS_MEMORY_WRITE_BIT;
+        m_rhi->cmdPipelineBarrier(
+            command_buffer,
+            RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            RHI_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            0,
+            1, &completion_barrier,
+            0, nullptr,
+            0, nullptr);
+
+        m_prev_view_proj = m_current_view_proj;
+        m_history_valid = true;
+        m_history_index ^= 1u;
+    }
+
+    /**
+     * @brief 创建描述符集布局
+     * @details 0 光线追踪输出, 1 G-Buffer位置, 2 G-Buffer法线, 3 G-Buffer反照率,
+     *          4 上一帧颜色, 5 上一帧位置, 6 本帧颜色, 7 本帧位置
+     */
+    void RayTracingCheckerboardPass::setupDescriptorSetLayout()
+    {
+        std::vector<RHIDescriptorSetLayoutBinding> bindings(8);
+        for (uint32_t i = 0; i < bindings.size(); ++i)
+        {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = RHI_SHADER_STAGE_COMPUTE_BIT;
+            bindings[i].pImmutableSamplers = nullptr;
+        }
+
+        RHIDescriptorSetLayoutCreateInfo layout_create_info{};
+        layout_create_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layout_create_info.bindingCount = static_cast<uint32_t>(bindings.size());
+        layout_create_info.pBindings = bindings.data();
+
+        if (m_rhi->createDescriptorSetLayout(&layout_create_info, m_descriptor_set_layout) != RHI_SUCCESS)
+        {
+            throw std::runtime_error("[RayTracingCheckerboardPass] Failed to create descriptor set layout");
+        }
+    }
+
+    /**
+     * @brief 创建重建计算管线
+     */
+    void RayTracingCheckerboardPass::setupPipeline()
+    {
+        RHIPushConstantRange push_constant_range{};
+        push_constant_range.stageFlags = RHI_SHADER_STAGE_COMPUTE_BIT;
+        push_constant_range.offset = 0;
+        push_constant_range.size = sizeof(CheckerboardPushConstants);
+
+        RHIPipelineLayoutCreateInfo pipeline_layout_create_info{};
+        pipeline_layout_create_info.sType = RHI_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipeline_layout_create_info.setLayoutCount = 1;
+        pipeline_layout_create_info.pSetLayouts = &m_descriptor_set_layout;
+        pipeline_layout_create_info.pushConstantRangeCount = 1;
+        pipeline_layout_create_info.pPushConstantRanges = &push_constant_range;
+
+        if (m_rhi->createPipelineLayout(&pipeline_layout_create_info, m_pipeline_layout) != RHI_SUCCESS)
+        {
+            throw std::runtime_error("[RayTracingCheckerboardPass] Failed to create pipeline layout");
+        }
+
+        RHIShader* shader_module = m_pipeline_cache->getShader(RT_CHECKERBOARD_COMP);
+        if (!shader_module)
+        {
+            throw std::runtime_error("[RayTracingCheckerboardPass] Failed to create compute shader module");
+        }
+
+        RHIPipelineShaderStageCreateInfo stage{};
+        stage.sType = RHI_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stage.stage = RHI_SHADER_STAGE_COMPUTE_BIT;
+        stage.module = shader_module;
+        stage.pName = "main";
+        stage.pSpecializationInfo = nullptr;
+
+        RHIComputePipelineCreateInfo pipeline_create_info{};
+        pipeline_create_info.sType = RHI_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipeline_create_info.pStages = &stage;
+        pipeline_create_info.layout = m_pipeline_layout;
+        pipeline_create_info.basePipelineHandle = RHI_NULL_HANDLE;
+        pipeline_create_info.basePipelineIndex = -1;
+
+        m_pipeline = m_pipeline_cache->getOrCreateComputePipeline(pipeline_create_info);
+        if (!m_pipeline)
+        {
+            throw std::runtime_error("[RayTracingCheckerboardPass] Failed to create compute pipeline");
+        }
+    }
+
+    /**
+     * @brief 创建历史缓冲区
+     */
+    void RayTracingCheckerboardPass::createHistoryImages()
+    {
+        destroyHistoryImages();
+
+        for (auto& attachment : m_history_color)
+        {
+            createStorageImage(m_width, m_height, RHI_FORMAT_R8G8B8A8_UNORM, RHI_IMAGE_USAGE_STORAGE_BIT, attachment);
+        }
+        for (auto& attachment : m_history_position)
+        {
+            createStorageImage(m_width, m_height, RHI_FORMAT_R32G32B32A32_SFLOAT, RHI_IMAGE_USAGE_STORAGE_BIT, attachment);
+        }
+
+        m_history_images_initialized = false;
+        m_history_valid = false;
+        m_history_index = 0;
+    }
+
+    /**
+     * @brief 销毁历史缓冲区
+     */
+    void RayTracingCheckerboardPass::destroyHistoryImages()
+    {
+        for (auto& attachment : m_history_color)
+        {
+            destroyStorageImage(attachment);
+        }
+        for (auto& attachment : m_history_position)
+        {
+            destroyStorageImage(attachment);
+        }
+    }
+
+    /**
+     * @brief 分配（首次）并更新两组重建描述符集
+     */
+    void RayTracingCheckerboardPass::updateDescriptorSets()
+    {
+        for (uint32_t set_index = 0; set_index < m_descriptor_sets.size(); ++set_index)
+        {
+            RHIDescriptorSet*& descriptor_set = m_descriptor_sets[set_index];
+            if (!descriptor_set)
+            {
+                descriptor_set = m_descriptor_allocator->allocate(m_descriptor_set_layout);
+            }
+            if (!descriptor_set)
+            {
+                throw std::runtime_error("[RayTracingCheckerboardPass] Failed to allocate descriptor set");
+            }
+
+            uint32_t prev_index = set_index ^ 1u;
+            std::array<RHIImageView*, 8> views = {
+                m_color_view,
+                m_gbuffer_position_view,
+                m_gbuffer_normal_view,
+                m_gbuffer_albedo_view,
+                m_history_color[prev_index].view,
+                m_history_position[prev_index].view,
+                m_history_color[set_index].view,
+                m_history_position[set_index].view,
+            };
+
+            std::array<RHIDescriptorImageInfo, 8> image_infos{};
+            std::array<RHIWriteDescriptorSet, 8> descriptor_writes{};
+            for (uint32_t i = 0; i < views.size(); ++i)
+            {
+                image_infos[i].imageLayout = RHI_IMAGE_LAYOUT_GENERAL;
+                image_infos[i].imageView = views[i];
+                image_infos[i].sampler = nullptr;
+
+                descriptor_writes[i].sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                descriptor_writes[i].dstSet = descriptor_set;
+                descriptor_writes[i].dstBinding = i;
+                descriptor_writes[i].dstArrayElement = 0;
+                descriptor_writes[i].descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+                descriptor_writes[i].descriptorCount = 1;
+                descriptor_writes[i].pImageInfo = &image_infos[i];
+            }
+
+            m_rhi->updateDescriptorSets(static_cast<uint32_t>(descriptor_writes.size()), descriptor_writes.data(), 0, nullptr);
+        }
+    }
+
+} // namespace Elish
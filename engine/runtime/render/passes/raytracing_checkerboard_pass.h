@@ -0,0 +1,112 @@
+#pragma once
+
+#include "../render_pass.h"
+#include "../render_resource.h"
+#include <glm/glm.hpp>
+#include <array>
+#include <memory>
+
+namespace Elish
+{
+    /**
+     * @brief 棋盘格光线追踪重建通道
+     * @details 光线追踪通道在棋盘格模式下每帧只追踪一半像素（奇偶交替），本通道以计算着色器补全缺失像素：
+     *          优先将插值位置重投影到上一帧复用历史颜色，失败时按深度/法线引导的空间插值填充；
+     *          补全结果与G-Buffer原地写回，后续降噪与合成无需区分棋盘格模式
+     */
+    class RayTracingCheckerboardPass : public RenderPass
+    {
+    public:
+        RayTracingCheckerboardPass() = default;
+        ~RayTracingCheckerboardPass();
+
+        /**
+         * @brief 初始化重建通道
+         * @details 创建描述符集布局、管线布局与重建计算管线
+         */
+        void initialize() override;
+
+        /**
+         * @brief 准备重建数据
+         * @param render_resource 渲染资源管理器，用于获取当前相机矩阵
+         */
+        void preparePassData(std::shared_ptr<RenderResource> render_resource) override;
+
+        /**
+         * @brief 设置重建输入图像
+         * @details 输入图像或分辨率变化时重建历史缓冲区并更新描述符集，未变化时直接返回
+         * @param color_view 光线追踪输出图像视图（rgba8，原地补全）
+         * @param gbuffer_position_view G-Buffer位置图像视图（rgba32f）
+         * @param gbuffer_normal_view G-Buffer法线图像视图（rgba16f）
+         * @param gbuffer_albedo_view G-Buffer反照率图像视图（rgba8）
+         * @param width 输入分辨率宽度
+         * @param height 输入分辨率高度
+         */
+        void setInputImages(RHIImageView* color_view, RHIImageView* gbuffer_position_view,
+                            RHIImageView* gbuffer_normal_view, RHIImageView* gbuffer_albedo_view,
+                            uint32_t width, uint32_t height);
+
+        /**
+         * @brief 录制重建命令
+         * @param command_buffer 当前命令缓冲区
+         * @param parity 本帧光线追踪通道追踪的像素奇偶性
+         */
+        void draw(RHICommandBuffer* command_buffer, uint32_t parity);
+
+        /**
+         * @brief 丢弃历史（如开关棋盘格模式、场景切换）
+         */
+        void resetHistory() { m_history_valid = false; }
+
+    private:
+        /**
+         * @brief 重建推送常量
+         * @details 与rt_checkerboard.comp中的PushConstants布局一致
+         */
+        struct CheckerboardPushConstants {
+            glm::mat4 prev_view_proj;   // 上一帧视图投影矩阵，用于重投影
+            uint32_t parity;            // 本帧追踪的像素奇偶性
+            uint32_t flags;             // bit0: 历史有效
+            uint32_t _padding[2];
+        };
+
+        static constexpr uint32_t k_flag_history_valid = 1u << 0;
+        static constexpr uint32_t k_workgroup_size = 8;
+
+        void setupDescriptorSetLayout();
+        void setupPipeline();
+        void createHistoryImages();
+        void destroyHistoryImages();
+        void updateDescriptorSets();
+
+    private:
+        bool m_is_initialized = false;
+        bool m_history_valid = false;
+        bool m_history_images_initialized = false;  // 历史图像是否已转换到GENERAL布局
+        uint32_t m_history_index = 0;                // 本帧写入的历史乒乓索引
+
+        // 输入（由光线追踪通道持有）
+        RHIImageView* m_color_view = nullptr;
+        RHIImageView* m_gbuffer_position_view = nullptr;
+        RHIImageView* m_gbuffer_normal_view = nullptr;
+        RHIImageView* m_gbuffer_albedo_view = nullptr;
+        uint32_t m_width = 0;
+        uint32_t m_height = 0;
+
+        // 历史缓冲区乒乓：完整的重建颜色（rgba8）与G-Buffer位置（rgba32f）
+        std::array<FrameBufferAttachment, 2> m_history_color{};
+        std::array<FrameBufferAttachment, 2> m_history_position{};
+
+        // 描述符集：第i个读取history[1-i]、写入history[i]
+        RHIDescriptorSetLayout* m_descriptor_set_layout = nullptr;
+        std::array<RHIDescriptorSet*, 2> m_descriptor_sets{};
+
+        RHIPipelineLayout* m_pipeline_layout = nullptr;
+        RHIPipeline* m_pipeline = nullptr;
+
+        // 相机矩阵
+        glm::mat4 m_current_view_proj = glm::mat4(1.0f);
+        glm::mat4 m_prev_view_proj = glm::mat4(1.0f);
+    };
+
+} // namespace Elish
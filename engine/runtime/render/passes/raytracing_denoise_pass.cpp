@@ -0,0 +1,502 @@
+#include "raytracing_denoise_pass.h"
+#include "../../core/base/macro.h"
+#include "../../render/interface/rhi.h"
+#include "../render_resource.h"
+#include "../render_camera.h"
+#include "../descriptor_allocator.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+// 包含生成的降噪计算着色器头文件
+#include "../../shader/generated/cpp/svgf_temporal_comp.h"
+#include "../../shader/generated/cpp/svgf_atrous_comp.h"
+
+namespace Elish
+{
+    /**
+     * @brief 析构函数
+     * @details 等待GPU完成后释放历史缓冲区与管线
+     */
+    RayTracingDenoisePass::~RayTracingDenoisePass()
+    {
+        if (!m_rhi)
+        {
+            return;
+        }
+
+        waitForGpuIdle();
+
+        destroyHistoryImages();
+
+        // 计算管线归管线缓存所有，销毁布局前移除以该布局为键的缓存管线
+        m_temporal_pipeline = nullptr;
+        m_atrous_pipeline = nullptr;
+        if (m_pipeline_layout)
+        {
+            if (m_pipeline_cache)
+            {
+                m_pipeline_cache->releasePipelineLayout(m_pipeline_layout);
+            }
+            m_rhi->destroyPipelineLayout(m_pipeline_layout);
+            m_pipeline_layout = nullptr;
+        }
+    }
+
+    /**
+     * @brief 初始化降噪通道
+     */
+    void RayTracingDenoisePass::initialize()
+    {
+        m_is_initialized = false;
+
+        if (!m_rhi)
+        {
+            LOG_ERROR("[RayTracingDenoisePass] RHI is null, cannot initialize denoiser");
+            return;
+        }
+
+        m_is_initialized = runSetupStep("[RayTracingDenoisePass]", "Initialization failed", [this]() {
+            setupDescriptorSetLayout();
+            setupPipelines();
+        });
+        if (m_is_initialized)
+        {
+            LOG_INFO("[RayTracingDenoisePass] SVGF denoiser initialized ({} a-trous iterations)", m_atrous_iterations);
+        }
+        else
+        {
+            m_enabled = false;
+        }
+    }
+
+    /**
+     * @brief 准备降噪数据
+     */
+    void RayTracingDenoisePass::preparePassData(std::shared_ptr<RenderResource> render_resource)
+    {
+        if (!render_resource)
+        {
+            return;
+        }
+
+        auto camera = render_resource->getCamera();
+        if (camera)
+        {
+            m_current_view_proj = camera->getPersProjMatrix() * camera->getViewMatrix();
+        }
+    }
+
+    /**
+     * @brief 设置降噪启用状态
+     */
+    void RayTracingDenoisePass::setEnabled(bool enabled)
+    {
+        if (m_enabled != enabled)
+        {
+            m_enabled = enabled;
+            m_history_valid = false;
+            LOG_INFO("[RayTracingDenoisePass] Denoiser {}", enabled ? "enabled" : "disabled");
+        }
+    }
+
+    /**
+     * @brief 设置à-trous迭代次数
+     */
+    void RayTracingDenoisePass::setAtrousIterations(uint32_t iterations)
+    {
+        m_atrous_iterations = std::clamp(iterations, 1u, 5u);
+    }
+
+    /**
+     * @brief 设置降噪输入图像
+     */
+    void RayTracingDenoisePass::setInputImages(RHIImageView* color_view, RHIImageView* gbuffer_position_view, RHIImageView* gbuffer_normal_view,
+                                               RHIImageView* gbuffer_albedo_view, uint32_t width, uint32_t height)
+    {
+        if (!m_is_initialized || !color_view || !gbuffer_position_view || !gbuffer_normal_view || !gbuffer_albedo_view ||
+            width == 0 || height == 0)
+        {
+            return;
+        }
+
+        bool inputs_changed = color_view != m_color_view ||
+                              gbuffer_position_view != m_gbuffer_position_view ||
+                              gbuffer_normal_view != m_gbuffer_normal_view ||
+                              gbuffer_albedo_view != m_gbuffer_albedo_view;
+        bool size_changed = width != m_width || height != m_height;
+        if (!inputs_changed && !size_changed)
+        {
+            return;
+        }
+
+        // 描述符集与历史图像可能仍被在途帧引用，重建前等待GPU空闲
+        waitForGpuIdle();
+
+        m_color_view = color_view;
+        m_gbuffer_position_view = gbuffer_position_view;
+        m_gbuffer_normal_view = gbuffer_normal_view;
+        m_gbuffer_albedo_view = gbuffer_albedo_view;
+
+        bool rebuilt = runSetupStep("[RayTracingDenoisePass]", "Failed to rebuild denoiser resources", [&]() {
+            if (size_changed || !m_history_color.image)
+            {
+                m_width = width;
+                m_height = height;
+                createHistoryImages();
+            }
+            updateDescriptorSets();
+        });
+        if (rebuilt)
+        {
+            LOG_DEBUG("[RayTracingDenoisePass] Inputs rebound at {}x{}", m_width, m_height);
+        }
+        else
+        {
+            destroyHistoryImages();
+            m_enabled = false;
+        }
+    }
+
+    /**
+     * @brief 录制降噪命令
+     */
+    void RayTracingDenoisePass::draw(RHICommandBuffer* command_buffer)
+    {
+        if (!m_enabled || !m_is_initialized || !command_buffer || !m_history_color.image || !m_temporal_descriptor_sets[0])
+        {
+            return;
+        }
+
+        // 首次使用时将内部历史图像转换到GENERAL布局
+        if (!m_history_images_initialized)
+        {
+            std::vector<RHIImageMemoryBarrier> barriers;
+            auto add_barrier = [&barriers](RHIImage* image) {
+                RHIImageMemoryBarrier barrier{};
+                barrier.sType = RHI_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                barrier.oldLayout = RHI_IMAGE_LAYOUT_UNDEFINED;
+                barrier.newLayout = RHI_IMAGE_LAYOUT_GENERAL;
+                barrier.srcQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
+                barrier.image = image;
+                barrier.subresourceRange.aspectMask = RHI_IMAGE_ASPECT_COLOR_BIT;
+                barrier.subresourceRange.baseMipLevel = 0;
+                barrier.subresourceRange.levelCount = 1;
+                barrier.subresourceRange.baseArrayLayer = 0;
+                barrier.subresourceRange.layerCount = 1;
+                barrier.srcAccessMask = 0;
+                barrier.dstAccessMask = RHI_ACCESS_SHADER_READ_BIT | RHI_ACCESS_SHADER_WRITE_BIT;
+                barriers.push_back(barrier);
+            };
+            add_barrier(m_prev_gbuffer_position.image);
+            add_barrier(m_prev_gbuffer_normal.image);
+            add_barrier(m_history_color.image);
+            for (auto& attachment : m_moments)
+            {
+                add_barrier(attachment.image);
+            }
+            for (auto& attachment : m_ping_pong)
+            {
+                add_barrier(attachment.image);
+            }
+
+            m_rhi->cmdPipelineBarrier(
+                command_buffer,
+                RHI_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                0,
+                0, nullptr,
+                0, nullptr,
+                static_cast<uint32_t>(barriers.size()), barriers.data());
+
+            m_history_images_initialized = true;
+            m_history_valid = false;
+        }
+
+        // 等待光线追踪写入输出图像和G-Buffer
+        RHIMemoryBarrier rt_barrier{};
+        rt_barrier.sType = RHI_STRUCTURE_TYPE_MEMORY_BARRIER;
+        rt_barrier.srcAccessMask = RHI_ACCESS_SHADER_WRITE_BIT;
+        rt_barrier.dstAccessMask = RHI_ACCESS_SHADER_READ_BIT | RHI_ACCESS_SHADER_WRITE_BIT;
+        m_rhi->cmdPipelineBarrier(
+            command_buffer,
+            RHI_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+            RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0,
+            1, &rt_barrier,
+            0, nullptr,
+            0, nullptr);
+
+        uint32_t group_count_x = (m_width + k_workgroup_size - 1) / k_workgroup_size;
+        uint32_t group_count_y = (m_height + k_workgroup_size - 1) / k_workgroup_size;
+
+        DenoisePushConstants push_constants{};
+        push_constants.prev_view_proj = m_prev_view_proj;
+        push_constants.flags = m_history_valid ? k_flag_history_valid : 0u;
+
+        // 1. 时域累积与方差估计：光线追踪输出 -> ping[0]
+        m_rhi->cmdBindPipelinePFN(command_buffer, RHI_PIPELINE_BIND_POINT_COMPUTE, m_temporal_pipeline);
+        m_rhi->cmdBindDescriptorSetsPFN(command_buffer, RHI_PIPELINE_BIND_POINT_COMPUTE, m_pipeline_layout,
+            0, 1, &m_temporal_descriptor_sets[m_moments_parity], 0, nullptr);
+        m_rhi->cmdPushConstantsPFN(command_buffer, m_pipeline_layout, RHI_SHADER_STAGE_COMPUTE_BIT,
+            0, sizeof(DenoisePushConstants), &push_constants);
+        m_rhi->cmdDispatch(command_buffer, group_count_x, group_count_y, 1);
+
+        // 2. à-trous小波滤波：ping[0] <-> ping[1]，步长1,2,4,...
+        m_rhi->cmdBindPipelinePFN(command_buffer, RHI_PIPELINE_BIND_POINT_COMPUTE, m_atrous_pipeline);
+        for (uint32_t i = 0; i < m_atrous_iterations; ++i)
+        {
+            insertComputeBarrier(command_buffer);
+
+            push_constants.step_size = 1 << i;
+            push_constants.iteration = i;
+            push_constants.flags = (m_history_valid ? k_flag_history_valid : 0u) |
+                                   (i + 1 == m_atrous_iterations ? k_flag_last_iteration : 0u);
+
+            m_rhi->cmdBindDescriptorSetsPFN(command_buffer, RHI_PIPELINE_BIND_POINT_COMPUTE, m_pipeline_layout,
+                0, 1, &m_atrous_descriptor_sets[i % 2], 0, nullptr);
+            m_rhi->cmdPushConstantsPFN(command_buffer, m_pipeline_layout, RHI_SHADER_STAGE_COMPUTE_BIT,
+                0, sizeof(DenoisePushConstants), &push_constants);
+            m_rhi->cmdDispatch(command_buffer, group_count_x, group_count_y, 1);
+        }
+
+        // 降噪结果供后续复制/采样使用
+        RHIMemoryBarrier completion_barrier{};
+        completion_barrier.sType = RHI_STRUCTURE_TYPE_MEMORY_BARRIER;
+        completion_barrier.srcAccessMask = RHI_ACCESS_SHADER_WRITE_BIT;
+        completion_barrier.dstAccessMask = RHI_ACCESS_MEMORY_READ_BIT | RHI_ACCESS_MEMORY_WRITE_BIT;
+        m_rhi->cmdPipelineBarrier(
+            command_buffer,
+            RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            RHI_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            0,
+            1, &completion_barrier,
+            0, nullptr,
+            0, nullptr);
+
+        m_prev_view_proj = m_current_view_proj;
+        m_history_valid = true;
+        m_moments_parity ^= 1u;
+    }
+
+    /**
+     * @brief 创建描述符集布局
+     * @details 时域与à-trous着色器共用同一布局：
+     *          0 光线追踪输出, 1 G-Buffer位置, 2 G-Buffer反照率, 3 上一帧G-Buffer位置,
+     *          4 历史光照, 5 上一帧亮度矩, 6 当前亮度矩, 7 乒乓输入, 8 乒乓输出,
+     *          9 G-Buffer法线, 10 上一帧G-Buffer法线
+     */
+    void RayTracingDenoisePass::setupDescriptorSetLayout()
+    {
+        std::vector<RHIDescriptorSetLayoutBinding> bindings(11);
+        for (uint32_t i = 0; i < bindings.size(); ++i)
+        {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = RHI_SHADER_STAGE_COMPUTE_BIT;
+            bindings[i].pImmutableSamplers = nullptr;
+        }
+
+        RHIDescriptorSetLayoutCreateInfo layout_create_info{};
+        layout_create_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layout_create_info.bindingCount = static_cast<uint32_t>(bindings.size());
+        layout_create_info.pBindings = bindings.data();
+
+        if (m_rhi->createDescriptorSetLayout(&layout_create_info, m_descriptor_set_layout) != RHI_SUCCESS)
+        {
+            throw std::runtime_error("[RayTracingDenoisePass] Failed to create descriptor set layout");
+        }
+    }
+
+    /**
+     * @brief 创建时域与à-trous计算管线
+     */
+    void RayTracingDenoisePass::setupPipelines()
+    {
+        RHIPushConstantRange push_constant_range{};
+        push_constant_range.stageFlags = RHI_SHADER_STAGE_COMPUTE_BIT;
+        push_constant_range.offset = 0;
+        push_constant_range.size = sizeof(DenoisePushConstants);
+
+        RHIPipelineLayoutCreateInfo pipeline_layout_create_info{};
+        pipeline_layout_create_info.sType = RHI_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipeline_layout_create_info.setLayoutCount = 1;
+        pipeline_layout_create_info.pSetLayouts = &m_descriptor_set_layout;
+        pipeline_layout_create_info.pushConstantRangeCount = 1;
+        pipeline_layout_create_info.pPushConstantRanges = &push_constant_range;
+
+        if (m_rhi->createPipelineLayout(&pipeline_layout_create_info, m_pipeline_layout) != RHI_SUCCESS)
+        {
+            throw std::runtime_error("[RayTracingDenoisePass] Failed to create pipeline layout");
+        }
+
+        auto create_compute_pipeline = [this](const std::vector<unsigned char>& shader_code, RHIPipeline*& pipeline) {
+            RHIShader* shader_module = m_pipeline_cache->getShader(shader_code);
+            if (!shader_module)
+            {
+                throw std::runtime_error("[RayTracingDenoisePass] Failed to create compute shader module");
+            }
+
+            RHIPipelineShaderStageCreateInfo stage{};
+            stage.sType = RHI_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            stage.stage = RHI_SHADER_STAGE_COMPUTE_BIT;
+            stage.module = shader_module;
+            stage.pName = "main";
+            stage.pSpecializationInfo = nullptr;
+
+            RHIComputePipelineCreateInfo pipeline_create_info{};
+            pipeline_create_info.sType = RHI_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+            pipeline_create_info.pStages = &stage;
+            pipeline_create_info.layout = m_pipeline_layout;
+            pipeline_create_info.basePipelineHandle = RHI_NULL_HANDLE;
+            pipeline_create_info.basePipelineIndex = -1;
+
+            pipeline = m_pipeline_cache->getOrCreateComputePipeline(pipeline_create_info);
+            if (!pipeline)
+            {
+                throw std::runtime_error("[RayTracingDenoisePass] Failed to create compute pipeline");
+            }
+        };
+
+        create_compute_pipeline(SVGF_TEMPORAL_COMP, m_temporal_pipeline);
+        create_compute_pipeline(SVGF_ATROUS_COMP, m_atrous_pipeline);
+    }
+
+    /**
+     * @brief 创建内部历史缓冲区
+     */
+    void RayTracingDenoisePass::createHistoryImages()
+    {
+        destroyHistoryImages();
+
+        createStorageImage(m_width, m_height, RHI_FORMAT_R32G32B32A32_SFLOAT, RHI_IMAGE_USAGE_STORAGE_BIT, m_prev_gbuffer_position);
+        createStorageImage(m_width, m_height, RHI_FORMAT_R16G16B16A16_SFLOAT, RHI_IMAGE_USAGE_STORAGE_BIT, m_prev_gbuffer_normal);
+        createStorageImage(m_width, m_height, RHI_FORMAT_R16G16B16A16_SFLOAT, RHI_IMAGE_USAGE_STORAGE_BIT, m_history_color);
+        for (auto& attachment : m_moments)
+        {
+            createStorageImage(m_width, m_height, RHI_FORMAT_R16G16B16A16_SFLOAT, RHI_IMAGE_USAGE_STORAGE_BIT, attachment);
+        }
+        for (auto& attachment : m_ping_pong)
+        {
+            createStorageImage(m_width, m_height, RHI_FORMAT_R16G16B16A16_SFLOAT, RHI_IMAGE_USAGE_STORAGE_BIT, attachment);
+        }
+
+        m_history_images_initialized = false;
+        m_history_valid = false;
+    }
+
+    /**
+     * @brief 销毁内部历史缓冲区
+     */
+    void RayTracingDenoisePass::destroyHistoryImages()
+    {
+        destroyStorageImage(m_prev_gbuffer_position);
+        destroyStorageImage(m_prev_gbuffer_normal);
+        destroyStorageImage(m_history_color);
+        for (auto& attachment : m_moments)
+        {
+            destroyStorageImage(attachment);
+        }
+        for (auto& attachment : m_ping_pong)
+        {
+            destroyStorageImage(attachment);
+        }
+    }
+
+    /**
+     * @brief 分配（首次）并更新全部降噪描述符集
+     */
+    void RayTracingDenoisePass::updateDescriptorSets()
+    {
+        auto allocate_if_needed = [this](RHIDescriptorSet*& descriptor_set) {
+            if (!descriptor_set)
+            {
+                descriptor_set = m_descriptor_allocator->allocate(m_descriptor_set_layout);
+            }
+            if (!descriptor_set)
+            {
+                throw std::runtime_error("[RayTracingDenoisePass] Failed to allocate descriptor set");
+            }
+        };
+        for (auto& descriptor_set : m_temporal_descriptor_sets)
+        {
+            allocate_if_needed(descriptor_set);
+        }
+        for (auto& descriptor_set : m_atrous_descriptor_sets)
+        {
+            allocate_if_needed(descriptor_set);
+        }
+
+        // 时域：第parity帧读 moments[1-parity]、写 moments[parity]，输出到 ping[0]
+        writeDescriptorSet(m_temporal_descriptor_sets[0], m_moments[1], m_moments[0], m_ping_pong[1], m_ping_pong[0]);
+        writeDescriptorSet(m_temporal_descriptor_sets[1], m_moments[0], m_moments[1], m_ping_pong[1], m_ping_pong[0]);
+
+        // à-trous：偶数次迭代 ping[0] -> ping[1]，奇数次 ping[1] -> ping[0]
+        writeDescriptorSet(m_atrous_descriptor_sets[0], m_moments[0], m_moments[1], m_ping_pong[0], m_ping_pong[1]);
+        writeDescriptorSet(m_atrous_descriptor_sets[1], m_moments[0], m_moments[1], m_ping_pong[1], m_ping_pong[0]);
+    }
+
+    /**
+     * @brief 写入一组降噪描述符集
+     */
+    void RayTracingDenoisePass::writeDescriptorSet(RHIDescriptorSet* descriptor_set,
+                                                   const FrameBufferAttachment& moments_prev, const FrameBufferAttachment& moments_curr,
+                                                   const FrameBufferAttachment& ping_src, const FrameBufferAttachment& ping_dst)
+    {
+        std::array<RHIImageView*, 11> views = {
+            m_color_view,
+            m_gbuffer_position_view,
+            m_gbuffer_albedo_view,
+            m_prev_gbuffer_position.view,
+            m_history_color.view,
+            moments_prev.view,
+            moments_curr.view,
+            ping_src.view,
+            ping_dst.view,
+            m_gbuffer_normal_view,
+            m_prev_gbuffer_normal.view,
+        };
+
+        std::array<RHIDescriptorImageInfo, 11> image_infos{};
+        std::array<RHIWriteDescriptorSet, 11> descriptor_writes{};
+        for (uint32_t i = 0; i < views.size(); ++i)
+        {
+            image_infos[i].imageLayout = RHI_IMAGE_LAYOUT_GENERAL;
+            image_infos[i].imageView = views[i];
+            image_infos[i].sampler = nullptr;
+
+            descriptor_writes[i].sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptor_writes[i].dstSet = descriptor_set;
+            descriptor_writes[i].dstBinding = i;
+            descriptor_writes[i].dstArrayElement = 0;
+            descriptor_writes[i].descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            descriptor_writes[i].descriptorCount = 1;
+            descriptor_writes[i].pImageInfo = &image_infos[i];
+        }
+
+        m_rhi->updateDescriptorSets(static_cast<uint32_t>(descriptor_writes.size()), descriptor_writes.data(), 0, nullptr);
+    }
+
+    /**
+     * @brief 在两个计算调度之间插入着色器读写屏障
+     */
+    void RayTracingDenoisePass::insertComputeBarrier(RHICommandBuffer* command_buffer)
+    {
+        RHIMemoryBarrier barrier{};
+        barrier.sType = RHI_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = RHI_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = RHI_ACCESS_SHADER_READ_BIT | RHI_ACCESS_SHADER_WRITE_BIT;
+        m_rhi->cmdPipelineBarrier(
+            command_buffer,
+            RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0,
+            1, &barrier,
+            0, nullptr,
+            0, nullptr);
+    }
+
+} // namespace Elish
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "../render_pass.h"
+#include "../render_resource.h"
+#include <glm/glm.hpp>
+#include <array>
+#include <memory>
+
+namespace Elish
+{
+    /**
+     * @brief 光线追踪时空降噪通道（SVGF）
+     * @details 以光线追踪通道输出的1spp图像和主光线G-Buffer（世界空间位置、命中距离、反照率）为输入，
+     *          依次执行时域累积+方差估计与若干次à-trous小波滤波，结果原地写回光线追踪输出图像
+     */
+    class RayTracingDenoisePass : public RenderPass
+    {
+    public:
+        RayTracingDenoisePass() = default;
+        ~RayTracingDenoisePass();
+
+        /**
+         * @brief 初始化降噪通道
+         * @details 创建描述符集布局、管线布局与时域/à-trous两个计算管线
+         */
+        void initialize() override;
+
+        /**
+         * @brief 准备降噪数据
+         * @param render_resource 渲染资源管理器，用于获取当前相机矩阵
+         */
+        void preparePassData(std::shared_ptr<RenderResource> render_resource) override;
+
+        /**
+         * @brief 设置降噪输入图像
+         * @details 输入图像或分辨率变化时重建内部历史缓冲区并更新描述符集，未变化时直接返回
+         * @param color_view 光线追踪输出图像视图（rgba8，原地降噪）
+         * @param gbuffer_position_view G-Buffer位置图像视图（rgba32f）
+         * @param gbuffer_normal_view G-Buffer法线图像视图（rgba16f），用于边缘停止与重投影校验
+         * @param gbuffer_albedo_view G-Buffer反照率图像视图（rgba8）
+         * @param width 输入分辨率宽度
+         * @param height 输入分辨率高度
+         */
+        void setInputImages(RHIImageView* color_view, RHIImageView* gbuffer_position_view, RHIImageView* gbuffer_normal_view,
+                            RHIImageView* gbuffer_albedo_view, uint32_t width, uint32_t height);
+
+        /**
+         * @brief 录制降噪命令
+         * @param command_buffer 当前命令缓冲区
+         */
+        void draw(RHICommandBuffer* command_buffer);
+
+        /**
+         * @brief 丢弃时域历史（如相机瞬移、场景切换）
+         */
+        void resetHistory() { m_history_valid = false; }
+
+        void setEnabled(bool enabled);
+        bool isEnabled() const { return m_enabled; }
+
+        /**
+         * @brief 设置à-trous迭代次数
+         * @param iterations 迭代次数（1-5），第i次迭代步长为2^i
+         */
+        void setAtrousIterations(uint32_t iterations);
+        uint32_t getAtrousIterations() const { return m_atrous_iterations; }
+
+    private:
+        /**
+         * @brief 降噪推送常量
+         * @details 与svgf_temporal.comp/svgf_atrous.comp中的PushConstants布局一致
+         */
+        struct DenoisePushConstants {
+            glm::mat4 prev_view_proj;   // 上一帧视图投影矩阵，用于重投影
+            int32_t step_size;          // à-trous步长
+            uint32_t iteration;         // à-trous迭代序号
+            uint32_t flags;             // bit0: 历史有效, bit1: 最后一次迭代
+            uint32_t _padding;
+        };
+
+        static constexpr uint32_t k_flag_history_valid = 1u << 0;
+        static constexpr uint32_t k_flag_last_iteration = 1u << 1;
+        static constexpr uint32_t k_workgroup_size = 8;
+
+        void setupDescriptorSetLayout();
+        void setupPipelines();
+        void createHistoryImages();
+        void destroyHistoryImages();
+        void updateDescriptorSets();
+
+        /**
+         * @brief 写入一组降噪描述符集
+         * @param descriptor_set 目标描述符集
+         * @param moments_prev 上一帧亮度矩
+         * @param moments_curr 当前帧亮度矩
+         * @param ping_src à-trous输入
+         * @param ping_dst à-trous输出
+         */
+        void writeDescriptorSet(RHIDescriptorSet* descriptor_set,
+                                const FrameBufferAttachment& moments_prev, const FrameBufferAttachment& moments_curr,
+                                const FrameBufferAttachment& ping_src, const FrameBufferAttachment& ping_dst);
+
+        /**
+         * @brief 在两个计算调度之间插入着色器读写屏障
+         */
+        void insertComputeBarrier(RHICommandBuffer* command_buffer);
+
+    private:
+        bool m_enabled = false;
+        bool m_is_initialized = false;
+        bool m_history_valid = false;
+        bool m_history_images_initialized = false;  // 历史图像是否已转换到GENERAL布局
+        uint32_t m_atrous_iterations = 4;
+        uint32_t m_moments_parity = 0;               // 亮度矩乒乓索引
+
+        // 输入（由光线追踪通道持有）
+        RHIImageView* m_color_view = nullptr;
+        RHIImageView* m_gbuffer_position_view = nullptr;
+        RHIImageView* m_gbuffer_normal_view = nullptr;
+        RHIImageView* m_gbuffer_albedo_view = nullptr;
+        uint32_t m_width = 0;
+        uint32_t m_height = 0;
+
+        // 内部历史缓冲区
+        FrameBufferAttachment m_prev_gbuffer_position{};     // 上一帧G-Buffer位置（rgba32f）
+        FrameBufferAttachment m_prev_gbuffer_normal{};       // 上一帧G-Buffer法线（rgba16f）
+        FrameBufferAttachment m_history_color{};             // 上一帧滤波后光照（rgba16f）
+        std::array<FrameBufferAttachment, 2> m_moments{};    // 亮度矩乒乓（rgba16f）
+        std::array<FrameBufferAttachment, 2> m_ping_pong{};  // à-trous乒乓（rgba16f: 光照+方差）
+
+        // 描述符集：时域x2（亮度矩乒乓）、à-trous x2（A->B, B->A）
+        RHIDescriptorSetLayout* m_descriptor_set_layout = nullptr;
+        std::array<RHIDescriptorSet*, 2> m_temporal_descriptor_sets{};
+        std::array<RHIDescriptorSet*, 2> m_atrous_descriptor_sets{};
+
+        RHIPipelineLayout* m_pipeline_layout = nullptr;
+        RHIPipeline* m_temporal_pipeline = nullptr;
+        RHIPipeline* m_atrous_pipeline = nullptr;
+
+        // 相机矩阵
+        glm::mat4 m_current_view_proj = glm::mat4(1.0f);
+        glm::mat4 m_prev_view_proj = glm::mat4(1.0f);
+    };
+
+} // namespace Elish
@@ -7,7 +7,9 @@
 #include "../../render/render_system.h"
 #include "../render_resource.h"
 #include "../render_camera.h"
+#include "../descriptor_allocator.h"
 #include "../../global/global_context.h"
+#include "../software/cpu_ray_tracer.h"
 
 #include <vector>
 #include <cstring>
@@ -16,6 +18,7 @@
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <functional>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -59,31 +62,20 @@ namespace Elish
         {
             // 等待设备空闲，确保所有GPU操作完成后再销毁资源
             // 这是防止验证层报错的关键步骤
-            m_rhi->waitForFences();
-            // 等待图形队列空闲
-            if (auto graphics_queue = m_rhi->getGraphicsQueue())
-            {
-                m_rhi->queueWaitIdle(graphics_queue);
-            }
+            waitForGpuIdle();
             
             LOG_INFO("[RayTracingPass] Starting resource cleanup after device idle");
 
             // 清理输出图像
-            if (m_output_image_view)
-            {
-                m_rhi->destroyImageView(m_output_image_view);
-                m_output_image_view = nullptr;
-            }
-            if (m_output_image)
-            {
-                m_rhi->destroyImage(m_output_image);
-                m_output_image = nullptr;
-            }
-            if (m_output_image_memory)
-            {
-                m_rhi->freeMemory(m_output_image_memory);
-                m_output_image_memory = nullptr;
-            }
+            destroyStorageImage(m_output_image, m_output_image_view, m_output_image_memory);
+            destroySoftwareStagingBuffers();
+
+            // 清理累积缓冲区与G-Buffer
+            destroyStorageImage(m_accumulation_image, m_accumulation_image_view, m_accumulation_image_memory);
+            destroyStorageImage(m_gbuffer_position_image, m_gbuffer_position_image_view, m_gbuffer_position_image_memory);
+            destroyStorageImage(m_gbuffer_albedo_image, m_gbuffer_albedo_image_view, m_gbuffer_albedo_image_memory);
+            destroyStorageImage(m_gbuffer_normal_image, m_gbuffer_normal_image_view, m_gbuffer_normal_image_memory);
+            destroyStorageImage(m_variance_image, m_variance_image_view, m_variance_image_memory);
 
             // 清理着色器绑定表缓冲区
             if (m_raygen_shader_binding_table)
@@ -186,8 +178,8 @@ namespace Elish
         // 检查光线追踪支持
         if (!m_rhi->isRayTracingSupported())
         {
-            LOG_WARN("[RayTracingPass] Ray tracing is not supported on this device, falling back to rasterization");
-            m_ray_tracing_enabled = false;  // 自动禁用光线追踪
+            LOG_WARN("[RayTracingPass] Ray tracing is not supported on this device, falling back to CPU software ray tracing");
+            initializeSoftwareFallback();
             return;
         }
 
@@ -329,11 +321,36 @@ namespace Elish
     {
         m_render_resource = render_resource;
 
+        // 不支持硬件光线追踪时，首次启用光线追踪才初始化软件回退
+        if (m_ray_tracing_enabled && !m_is_initialized && m_rhi && !m_rhi->isRayTracingSupported())
+        {
+            initializeSoftwareFallback();
+        }
+
         if (!m_is_initialized || !m_ray_tracing_enabled)
         {
             return;
         }
 
+        // 渲染缩放变化：在录制本帧追踪命令之前按新分辨率重建输出图像与G-Buffer
+        if (m_target_render_scale != m_render_scale)
+        {
+            waitForGpuIdle();
+            m_render_scale = m_target_render_scale;
+            updateAfterFramebufferRecreate();
+            LOG_INFO("[RayTracingPass] Render scale changed to {:.2f} ({}x{})", m_render_scale, m_output_width, m_output_height);
+        }
+
+        // 软件回退：场景变化时重建CPU端BVH
+        if (m_software_fallback)
+        {
+            if (m_render_resource)
+            {
+                m_software_tracer->updateScene(*m_render_resource);
+            }
+            return;
+        }
+
         // 检查光线追踪资源是否可用（临时禁用时可能为空）
         if (m_render_resource)
         {
@@ -378,6 +395,21 @@ namespace Elish
             return;
         }
 
+        if (m_software_fallback)
+        {
+            RHICommandBuffer* command_buffer = m_rhi->getCurrentCommandBuffer();
+            if (!command_buffer)
+            {
+                LOG_ERROR("[RayTracingPass] Failed to get current command buffer");
+                return;
+            }
+            drawSoftwareRayTracing(command_buffer);
+
+            auto frame_time = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - frame_start_time);
+            updatePerformanceStats(frame_time.count());
+            return;
+        }
+
         // 检查光线追踪资源是否可用
         auto& ray_tracing_resource = m_render_resource->getRayTracingResource();
         if (!ray_tracing_resource.tlas)
@@ -419,15 +451,20 @@ namespace Elish
         
         // 获取相机数据
         auto camera = m_render_resource->getCamera();
+        glm::mat4 view_matrix(1.0f);
+        glm::mat4 proj_matrix(1.0f);
         if (camera)
         {
-            uniform_data.view_inverse = glm::inverse(camera->getViewMatrix());
-            uniform_data.proj_inverse = glm::inverse(camera->getPersProjMatrix());
+            view_matrix = camera->getViewMatrix();
+            proj_matrix = camera->getPersProjMatrix();
         }
-        else
+        uniform_data.view_inverse = glm::inverse(view_matrix);
+        uniform_data.proj_inverse = glm::inverse(proj_matrix);
+
+        // 相机、光源或物体变化时重置累积，避免历史样本产生拖影
+        if (!m_accumulation_enabled || detectSceneChange(view_matrix, proj_matrix))
         {
-            uniform_data.view_inverse = glm::mat4(1.0f);
-            uniform_data.proj_inverse = glm::mat4(1.0f);
+            resetAccumulation();
         }
 
         // 设置光源数据
@@ -455,18 +492,37 @@ namespace Elish
         image_barrier.subresourceRange.layerCount = 1;
         image_barrier.srcAccessMask = 0;
         image_barrier.dstAccessMask = RHI_ACCESS_SHADER_WRITE_BIT;
+
+        // 累积缓冲区：重置时丢弃旧内容，否则保持GENERAL并等待上一次写入完成
+        RHIImageMemoryBarrier accumulation_barrier = image_barrier;
+        accumulation_barrier.image = m_accumulation_image;
+        accumulation_barrier.oldLayout = m_accumulated_frame_count == 0 ? RHI_IMAGE_LAYOUT_UNDEFINED : RHI_IMAGE_LAYOUT_GENERAL;
+        accumulation_barrier.srcAccessMask = m_accumulated_frame_count == 0 ? 0 : RHI_ACCESS_SHADER_WRITE_BIT;
+        accumulation_barrier.dstAccessMask = RHI_ACCESS_SHADER_READ_BIT | RHI_ACCESS_SHADER_WRITE_BIT;
+
+        // 方差缓冲区与累积缓冲区同步重置；自适应采样会跳过已收敛像素，G-Buffer同样需要保留旧内容
+        RHIImageMemoryBarrier variance_barrier = accumulation_barrier;
+        variance_barrier.image = m_variance_image;
+        RHIImageMemoryBarrier gbuffer_position_barrier = accumulation_barrier;
+        gbuffer_position_barrier.image = m_gbuffer_position_image;
+        RHIImageMemoryBarrier gbuffer_albedo_barrier = accumulation_barrier;
+        gbuffer_albedo_barrier.image = m_gbuffer_albedo_image;
+        RHIImageMemoryBarrier gbuffer_normal_barrier = accumulation_barrier;
+        gbuffer_normal_barrier.image = m_gbuffer_normal_image;
+
+        RHIImageMemoryBarrier image_barriers[] = { image_barrier, accumulation_barrier, variance_barrier, gbuffer_position_barrier, gbuffer_albedo_barrier, gbuffer_normal_barrier };
         
         m_rhi->cmdPipelineBarrier(
             command_buffer,
-            RHI_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            RHI_PIPELINE_STAGE_TOP_OF_PIPE_BIT | RHI_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
             RHI_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
             0,
             0, nullptr,
             0, nullptr,
-            1, &image_barrier
+            static_cast<uint32_t>(sizeof(image_barriers) / sizeof(image_barriers[0])), image_barriers
         );
         
-        LOG_DEBUG("[RayTracingPass] Output image layout transitioned to GENERAL for ray tracing");
+        LOG_DEBUG("[RayTracingPass] Output and accumulation images transitioned to GENERAL (accumulated frames: {})", m_accumulated_frame_count);
 
         // 绑定光线追踪管线
         m_rhi->cmdBindPipelinePFN(command_buffer, RHI_PIPELINE_BIND_POINT_RAY_TRACING_KHR, m_ray_tracing_pipeline);
@@ -478,6 +534,27 @@ namespace Elish
                 m_ray_tracing_pipeline_layout, 0, 1, &m_descriptor_infos[current_frame].descriptor_set, 0, nullptr);
         }
 
+        // 推送常量：帧号用于抖动与随机种子，累积帧数决定是否丢弃历史
+        // 自适应采样依赖跨帧方差统计，仅在渐进累积开启时生效；否则每像素固定采样（噪声阈值为0）
+        bool adaptive = m_adaptive_sampling_enabled && m_accumulation_enabled;
+        RayTracingPushConstants push_constants{};
+        push_constants.frame_number = m_frame_number;
+        push_constants.adaptive_samples = adaptive ? m_adaptive_max_samples : m_samples_per_pixel;
+        push_constants.noise_threshold = adaptive ? m_noise_threshold : 0.0f;
+        push_constants.quality_factor = adaptive ? m_quality_factor : 1.0f;
+        push_constants.accumulated_frames = m_accumulated_frame_count;
+        if (m_checkerboard_enabled)
+        {
+            // 棋盘格模式下每个像素隔帧追踪一次，像素自身的累积样本数为累积帧数的一半；
+            // 两种奇偶性在重置后的前两帧都从零开始累积，保证未追踪像素不会混入旧历史
+            m_checkerboard_parity = m_frame_number & 1u;
+            push_constants.accumulated_frames = m_accumulated_frame_count / 2;
+            push_constants.checkerboard = 1u | (m_checkerboard_parity << 1);
+        }
+        m_rhi->cmdPushConstantsPFN(command_buffer, m_ray_tracing_pipeline_layout,
+            RHI_SHADER_STAGE_RAYGEN_BIT_KHR | RHI_SHADER_STAGE_CLOSEST_HIT_BIT_KHR,
+            0, sizeof(RayTracingPushConstants), &push_constants);
+
         // 调度光线追踪
         auto swapchain_info = m_rhi->getSwapchainInfo();
         uint32_t width = swapchain_info.extent.width;
@@ -533,8 +610,8 @@ namespace Elish
         trace_rays_info.callableShaderBindingTableSize = 0;
         trace_rays_info.callableShaderBindingTableStride = 0;
         
-        // 使用输出图像分辨率进行光线追踪（可缩放）
-        trace_rays_info.width = m_output_width;
+        // 使用输出图像分辨率进行光线追踪（可缩放）；棋盘格模式下每行只发射一半光线
+        trace_rays_info.width = m_checkerboard_enabled ? (m_output_width + 1) / 2 : m_output_width;
         trace_rays_info.height = m_output_height;
         trace_rays_info.depth = 1;
 
@@ -545,6 +622,11 @@ namespace Elish
         // LOG_WARN("[RayTracingPass] cmdTraceRays SKIPPED for debugging VK_ERROR_DEVICE_LOST");
         
         m_traced_last_frame = true;
+        ++m_frame_number;
+        if (m_accumulation_enabled)
+        {
+            ++m_accumulated_frame_count;
+        }
 
         LOG_DEBUG("[RayTracingPass] Ray tracing dispatch completed successfully");
         
@@ -606,6 +688,275 @@ namespace Elish
         */
     }
 
+    /**
+     * @brief 初始化CPU软件光线追踪回退
+     */
+    void RayTracingPass::initializeSoftwareFallback()
+    {
+        try
+        {
+            m_software_fallback = true;
+            m_software_tracer = std::make_unique<CpuRayTracer>();
+
+            // 输出图像与硬件路径相同，合成与UI显示无需区分回退模式
+            createOutputImage();
+            if (!m_output_image || !m_output_image_view)
+            {
+                throw std::runtime_error("Output image creation failed");
+            }
+
+            m_is_initialized = true;
+            LOG_INFO("[RayTracingPass] CPU software ray tracing fallback initialized ({}x{})", m_output_width, m_output_height);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR("[RayTracingPass] Software fallback initialization failed: {}", e.what());
+            destroySoftwareStagingBuffers();
+            m_software_tracer.reset();
+            m_software_fallback = false;
+            m_ray_tracing_enabled = false;
+            m_is_initialized = false;
+        }
+    }
+
+    /**
+     * @brief 以软件光线追踪渲染一帧并录制上传命令
+     */
+    void RayTracingPass::drawSoftwareRayTracing(RHICommandBuffer* command_buffer)
+    {
+        uint32_t current_frame = m_rhi->getCurrentFrameIndex();
+        if (current_frame >= m_software_staging_mapped.size() || !m_software_staging_mapped[current_frame])
+        {
+            LOG_ERROR("[RayTracingPass] Software staging buffer for frame {} is not available", current_frame);
+            return;
+        }
+
+        auto camera = m_render_resource->getCamera();
+        glm::mat4 view_matrix(1.0f);
+        glm::mat4 proj_matrix(1.0f);
+        if (camera)
+        {
+            view_matrix = camera->getViewMatrix();
+            proj_matrix = camera->getPersProjMatrix();
+        }
+
+        // 光源参数与硬件路径的uniform数据一致
+        const glm::vec3 light_position(10.0f, 10.0f, 10.0f);
+        const glm::vec3 light_color(1.0f, 1.0f, 1.0f);
+        m_software_tracer->render(glm::inverse(view_matrix), glm::inverse(proj_matrix), light_position, light_color,
+                                  m_output_width, m_output_height, m_software_pixels);
+        memcpy(m_software_staging_mapped[current_frame], m_software_pixels.data(), m_software_pixels.size() * sizeof(uint32_t));
+
+        // 整幅图像都会被覆盖，旧内容直接丢弃；仅需等待上一帧合成对输出图像的采样结束
+        RHIImageMemoryBarrier upload_barrier{};
+        upload_barrier.sType = RHI_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        upload_barrier.oldLayout = RHI_IMAGE_LAYOUT_UNDEFINED;
+        upload_barrier.newLayout = RHI_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        upload_barrier.srcQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
+        upload_barrier.dstQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
+        upload_barrier.image = m_output_image;
+        upload_barrier.subresourceRange.aspectMask = RHI_IMAGE_ASPECT_COLOR_BIT;
+        upload_barrier.subresourceRange.baseMipLevel = 0;
+        upload_barrier.subresourceRange.levelCount = 1;
+        upload_barrier.subresourceRange.baseArrayLayer = 0;
+        upload_barrier.subresourceRange.layerCount = 1;
+        upload_barrier.srcAccessMask = 0;
+        upload_barrier.dstAccessMask = RHI_ACCESS_TRANSFER_WRITE_BIT;
+        m_rhi->cmdPipelineBarrier(command_buffer,
+            RHI_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, RHI_PIPELINE_STAGE_TRANSFER_BIT, 0,
+            0, nullptr, 0, nullptr, 1, &upload_barrier);
+
+        RHIBufferImageCopy region{};
+        region.bufferOffset = 0;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource.aspectMask = RHI_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = 0;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = { 0, 0, 0 };
+        region.imageExtent = { m_output_width, m_output_height, 1 };
+        m_rhi->cmdCopyBufferToImage(command_buffer, m_software_staging_buffers[current_frame], m_output_image,
+            RHI_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        // 合成着色器按GENERAL布局采样输出图像
+        RHIImageMemoryBarrier sample_barrier = upload_barrier;
+        sample_barrier.oldLayout = RHI_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        sample_barrier.newLayout = RHI_IMAGE_LAYOUT_GENERAL;
+        sample_barrier.srcAccessMask = RHI_ACCESS_TRANSFER_WRITE_BIT;
+        sample_barrier.dstAccessMask = RHI_ACCESS_SHADER_READ_BIT;
+        m_rhi->cmdPipelineBarrier(command_buffer,
+            RHI_PIPELINE_STAGE_TRANSFER_BIT, RHI_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+            0, nullptr, 0, nullptr, 1, &sample_barrier);
+
+        m_traced_last_frame = true;
+        ++m_frame_number;
+    }
+
+    /**
+     * @brief 按输出分辨率创建软件回退的暂存缓冲区
+     */
+    void RayTracingPass::createSoftwareStagingBuffers()
+    {
+        destroySoftwareStagingBuffers();
+
+        uint32_t max_frames_in_flight = m_rhi->getMaxFramesInFlight();
+        RHIDeviceSize buffer_size = static_cast<RHIDeviceSize>(m_output_width) * m_output_height * sizeof(uint32_t);
+        m_software_staging_buffers.resize(max_frames_in_flight, nullptr);
+        m_software_staging_memory.resize(max_frames_in_flight, nullptr);
+        m_software_staging_mapped.resize(max_frames_in_flight, nullptr);
+
+        for (uint32_t i = 0; i < max_frames_in_flight; ++i)
+        {
+            RHIBufferCreateInfo buffer_create_info{};
+            buffer_create_info.sType = RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            buffer_create_info.size = buffer_size;
+            buffer_create_info.usage = RHI_BUFFER_USAGE_TRANSFER_SRC_BIT;
+            buffer_create_info.sharingMode = RHI_SHARING_MODE_EXCLUSIVE;
+
+            if (m_rhi->createBuffer(&buffer_create_info, m_software_staging_buffers[i]) != RHI_SUCCESS)
+            {
+                throw std::runtime_error("Failed to create software staging buffer for frame " + std::to_string(i));
+            }
+
+            RHIMemoryRequirements mem_requirements;
+            m_rhi->getBufferMemoryRequirements(m_software_staging_buffers[i], &mem_requirements);
+
+            RHIMemoryAllocateInfo alloc_info{};
+            alloc_info.sType = RHI_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            alloc_info.allocationSize = mem_requirements.size;
+            alloc_info.memoryTypeIndex = m_rhi->findMemoryType(mem_requirements.memoryTypeBits,
+                RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+            if (m_rhi->allocateMemory(&alloc_info, m_software_staging_memory[i]) != RHI_SUCCESS)
+            {
+                throw std::runtime_error("Failed to allocate software staging memory for frame " + std::to_string(i));
+            }
+            if (m_rhi->bindBufferMemory(m_software_staging_buffers[i], m_software_staging_memory[i], 0) != RHI_SUCCESS)
+            {
+                throw std::runtime_error("Failed to bind software staging memory for frame " + std::to_string(i));
+            }
+            if (m_rhi->mapMemory(m_software_staging_memory[i], 0, buffer_size, 0, &m_software_staging_mapped[i]) != RHI_SUCCESS)
+            {
+                throw std::runtime_error("Failed to map software staging memory for frame " + std::to_string(i));
+            }
+        }
+    }
+
+    /**
+     * @brief 销毁软件回退的暂存缓冲区
+     */
+    void RayTracingPass::destroySoftwareStagingBuffers()
+    {
+        for (size_t i = 0; i < m_software_staging_buffers.size(); ++i)
+        {
+            if (m_software_staging_mapped[i])
+            {
+                m_rhi->unmapMemory(m_software_staging_memory[i]);
+            }
+            if (m_software_staging_buffers[i])
+            {
+                m_rhi->destroyBuffer(m_software_staging_buffers[i]);
+            }
+            if (m_software_staging_memory[i])
+            {
+                m_rhi->freeMemory(m_software_staging_memory[i]);
+            }
+        }
+        m_software_staging_buffers.clear();
+        m_software_staging_memory.clear();
+        m_software_staging_mapped.clear();
+    }
+
+    /**
+     * @brief 重置渐进式累积
+     */
+    void RayTracingPass::resetAccumulation()
+    {
+        if (m_accumulated_frame_count > 0)
+        {
+            LOG_DEBUG("[RayTracingPass] Accumulation reset after {} frames", m_accumulated_frame_count);
+        }
+        m_accumulated_frame_count = 0;
+    }
+
+    /**
+     * @brief 设置渐进式累积启用状态
+     */
+    void RayTracingPass::setAccumulationEnabled(bool enabled)
+    {
+        if (m_accumulation_enabled != enabled)
+        {
+            m_accumulation_enabled = enabled;
+            resetAccumulation();
+            LOG_INFO("[RayTracingPass] Progressive accumulation {}", enabled ? "enabled" : "disabled");
+        }
+    }
+
+    /**
+     * @brief 检测相机、光源或场景物体是否发生变化
+     */
+    bool RayTracingPass::detectSceneChange(const glm::mat4& view, const glm::mat4& proj)
+    {
+        size_t scene_state_hash = computeSceneStateHash();
+        bool changed = view != m_last_view_matrix ||
+                       proj != m_last_proj_matrix ||
+                       scene_state_hash != m_last_scene_state_hash;
+
+        m_last_view_matrix = view;
+        m_last_proj_matrix = proj;
+        m_last_scene_state_hash = scene_state_hash;
+        return changed;
+    }
+
+    /**
+     * @brief 计算光源与物体变换的哈希值
+     * @details 启用自动旋转的物体每帧都在运动，直接视为变化
+     */
+    size_t RayTracingPass::computeSceneStateHash() const
+    {
+        size_t seed = 0;
+        auto hash_combine = [&seed](float value) {
+            seed ^= std::hash<float>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        };
+        auto hash_vec3 = [&hash_combine](const glm::vec3& v) {
+            hash_combine(v.x);
+            hash_combine(v.y);
+            hash_combine(v.z);
+        };
+
+        if (!m_render_resource)
+        {
+            return seed;
+        }
+
+        for (const auto& light : m_render_resource->getDirectionalLights())
+        {
+            hash_vec3(light.direction);
+            hash_vec3(light.color);
+            hash_combine(light.intensity);
+            hash_combine(light.enabled ? 1.0f : 0.0f);
+        }
+
+        const auto& render_objects = m_render_resource->getLoadedRenderObjects();
+        for (size_t i = 0; i < render_objects.size(); ++i)
+        {
+            const auto& params = render_objects[i].animationParams;
+            // 父物体带动画时子物体同样每帧移动
+            if (m_render_resource->isRenderObjectAnimated(i))
+            {
+                hash_combine(static_cast<float>(m_frame_number));
+            }
+            hash_vec3(params.position);
+            hash_vec3(params.rotation);
+            hash_vec3(params.scale);
+            hash_combine(static_cast<float>(params.parentIndex));
+        }
+        hash_combine(static_cast<float>(m_render_resource->getRenderObjectCount()));
+
+        return seed;
+    }
+
     /**
      * @brief 更新加速结构
      */
@@ -635,6 +986,7 @@ namespace Elish
     {
         m_max_ray_depth = max_depth;
         m_samples_per_pixel = samples_per_pixel;
+        resetAccumulation();
     }
 
     /**
@@ -650,8 +1002,11 @@ namespace Elish
         // 重新创建输出图像
         createOutputImage();
 
-        // 更新描述符集
-        updateDescriptorSet();
+        // 软件回退不使用描述符集
+        if (!m_software_fallback)
+        {
+            updateDescriptorSet();
+        }
     }
 
     /**
@@ -686,21 +1041,53 @@ namespace Elish
         uniform_binding.stageFlags = RHI_SHADER_STAGE_RAYGEN_BIT_KHR | RHI_SHADER_STAGE_CLOSEST_HIT_BIT_KHR | RHI_SHADER_STAGE_MISS_BIT_KHR;
         bindings.push_back(uniform_binding);
 
-        // 绑定4: 顶点缓冲区（修正：匹配着色器中VertexBuffer的绑定）
-        RHIDescriptorSetLayoutBinding vertex_binding{};
-        vertex_binding.binding = 4;
-        vertex_binding.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        vertex_binding.descriptorCount = 1;
-        vertex_binding.stageFlags = RHI_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
-        bindings.push_back(vertex_binding);
-
-        // 绑定5: 索引缓冲区（修正：匹配着色器中IndexBuffer的绑定）
-        RHIDescriptorSetLayoutBinding index_binding{};
-        index_binding.binding = 5;
-        index_binding.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        index_binding.descriptorCount = 1;
-        index_binding.stageFlags = RHI_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
-        bindings.push_back(index_binding);
+        // 绑定3: 渐进式累积缓冲区
+        RHIDescriptorSetLayoutBinding accumulation_binding{};
+        accumulation_binding.binding = 3;
+        accumulation_binding.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        accumulation_binding.descriptorCount = 1;
+        accumulation_binding.stageFlags = RHI_SHADER_STAGE_RAYGEN_BIT_KHR;
+        bindings.push_back(accumulation_binding);
+
+        // 绑定4: 实例几何地址表（顶点/索引/材质设备地址，按instanceCustomIndex索引）
+        RHIDescriptorSetLayoutBinding geometry_table_binding{};
+        geometry_table_binding.binding = 4;
+        geometry_table_binding.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        geometry_table_binding.descriptorCount = 1;
+        geometry_table_binding.stageFlags = RHI_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
+        bindings.push_back(geometry_table_binding);
+
+        // 绑定6: G-Buffer世界空间位置与命中距离
+        RHIDescriptorSetLayoutBinding gbuffer_position_binding{};
+        gbuffer_position_binding.binding = 6;
+        gbuffer_position_binding.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        gbuffer_position_binding.descriptorCount = 1;
+        gbuffer_position_binding.stageFlags = RHI_SHADER_STAGE_RAYGEN_BIT_KHR;
+        bindings.push_back(gbuffer_position_binding);
+
+        // 绑定7: G-Buffer反照率
+        RHIDescriptorSetLayoutBinding gbuffer_albedo_binding{};
+        gbuffer_albedo_binding.binding = 7;
+        gbuffer_albedo_binding.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        gbuffer_albedo_binding.descriptorCount = 1;
+        gbuffer_albedo_binding.stageFlags = RHI_SHADER_STAGE_RAYGEN_BIT_KHR;
+        bindings.push_back(gbuffer_albedo_binding);
+
+        // 绑定9: G-Buffer世界空间法线
+        RHIDescriptorSetLayoutBinding gbuffer_normal_binding{};
+        gbuffer_normal_binding.binding = 9;
+        gbuffer_normal_binding.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        gbuffer_normal_binding.descriptorCount = 1;
+        gbuffer_normal_binding.stageFlags = RHI_SHADER_STAGE_RAYGEN_BIT_KHR;
+        bindings.push_back(gbuffer_normal_binding);
+
+        // 绑定8: 自适应采样方差缓冲区
+        RHIDescriptorSetLayoutBinding variance_binding{};
+        variance_binding.binding = 8;
+        variance_binding.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        variance_binding.descriptorCount = 1;
+        variance_binding.stageFlags = RHI_SHADER_STAGE_RAYGEN_BIT_KHR;
+        bindings.push_back(variance_binding);
 
         // 创建描述符集布局
         RHIDescriptorSetLayoutCreateInfo layout_create_info{};
@@ -886,7 +1273,8 @@ namespace Elish
         // 为每一帧分配描述符集
         for (auto& info : m_descriptor_infos)
         {
-            if (m_rhi->allocateDescriptorSets(info.layout, info.descriptor_set) != RHI_SUCCESS)
+            info.descriptor_set = m_descriptor_allocator->allocate(info.layout);
+            if (!info.descriptor_set)
             {
                 throw std::runtime_error("[RayTracingPass] Failed to allocate descriptor set");
             }
@@ -908,76 +1296,51 @@ namespace Elish
         LOG_DEBUG("[RayTracingPass] Creating output image: {}x{} (swapchain: {}x{}, scale: {:.2f})", 
                  width, height, base_width, base_height, m_render_scale);
 
-        // 清理旧的输出图像
-        if (m_output_image_view)
-        {
-            m_rhi->destroyImageView(m_output_image_view);
-            m_output_image_view = nullptr;
-        }
-        if (m_output_image)
-        {
-            m_rhi->destroyImage(m_output_image);
-            m_output_image = nullptr;
-        }
-        if (m_output_image_memory)
-        {
-            m_rhi->freeMemory(m_output_image_memory);
-            m_output_image_memory = nullptr;
-        }
-
-        // 创建输出图像
-        RHIImageCreateInfo image_create_info{};
-        image_create_info.sType = RHI_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-        image_create_info.imageType = RHI_IMAGE_TYPE_2D;
-        image_create_info.extent.width = width;
-        image_create_info.extent.height = height;
-        image_create_info.extent.depth = 1;
-        image_create_info.mipLevels = 1;
-        image_create_info.arrayLayers = 1;
-        image_create_info.format = RHI_FORMAT_R8G8B8A8_UNORM;
-        image_create_info.tiling = RHI_IMAGE_TILING_OPTIMAL;
-        image_create_info.initialLayout = RHI_IMAGE_LAYOUT_UNDEFINED;
-        image_create_info.usage = RHI_IMAGE_USAGE_STORAGE_BIT | RHI_IMAGE_USAGE_TRANSFER_SRC_BIT;
-        image_create_info.samples = RHI_SAMPLE_COUNT_1_BIT;
-        image_create_info.sharingMode = RHI_SHARING_MODE_EXCLUSIVE;
+        // TRANSFER_DST用于软件回退上传CPU渲染结果
+        createStorageImage(width, height, RHI_FORMAT_R8G8B8A8_UNORM,
+            RHI_IMAGE_USAGE_STORAGE_BIT | RHI_IMAGE_USAGE_SAMPLED_BIT |
+            RHI_IMAGE_USAGE_TRANSFER_SRC_BIT | RHI_IMAGE_USAGE_TRANSFER_DST_BIT,
+            m_output_image, m_output_image_view, m_output_image_memory);
 
-        if (m_rhi->createImage(&image_create_info, m_output_image) != RHI_SUCCESS)
+        // 软件回退只需要与输出分辨率匹配的暂存缓冲区
+        if (m_software_fallback)
         {
-            throw std::runtime_error("[RayTracingPass] Failed to create output image");
+            createSoftwareStagingBuffers();
+            return;
         }
 
-        // 分配图像内存
-        RHIMemoryRequirements mem_requirements;
-        m_rhi->getImageMemoryRequirements(m_output_image, &mem_requirements);
+        // 输出分辨率变化后历史数据失效，同步重建累积缓冲区与G-Buffer
+        createAccumulationImage();
+    }
 
-        RHIMemoryAllocateInfo alloc_info{};
-        alloc_info.sType = RHI_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc_info.allocationSize = mem_requirements.size;
-        alloc_info.memoryTypeIndex = m_rhi->findMemoryType(mem_requirements.memoryTypeBits, RHI_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    /**
+     * @brief 创建光线追踪辅助存储图像
+     * @details 创建与输出图像同分辨率的累积缓冲区和主光线G-Buffer，重建后累积自动重置
+     */
+    void RayTracingPass::createAccumulationImage()
+    {
+        // 渐进式累积缓冲区：RGBA32F保存线性空间的运行平均值，避免8位输出反复混合产生的量化误差
+        createStorageImage(m_output_width, m_output_height, RHI_FORMAT_R32G32B32A32_SFLOAT, RHI_IMAGE_USAGE_STORAGE_BIT,
+            m_accumulation_image, m_accumulation_image_view, m_accumulation_image_memory);
 
-        if (m_rhi->allocateMemory(&alloc_info, m_output_image_memory) != RHI_SUCCESS)
-        {
-            throw std::runtime_error("[RayTracingPass] Failed to allocate output image memory");
-        }
+        // 主光线G-Buffer：世界空间命中位置与命中距离（供降噪器重投影与边缘保持）
+        createStorageImage(m_output_width, m_output_height, RHI_FORMAT_R32G32B32A32_SFLOAT, RHI_IMAGE_USAGE_STORAGE_BIT | RHI_IMAGE_USAGE_TRANSFER_SRC_BIT,
+            m_gbuffer_position_image, m_gbuffer_position_image_view, m_gbuffer_position_image_memory);
 
-        m_rhi->bindImageMemory(m_output_image, m_output_image_memory, 0);
+        // 主光线G-Buffer：表面反照率（供降噪器解调/重调制纹理细节）
+        createStorageImage(m_output_width, m_output_height, RHI_FORMAT_R8G8B8A8_UNORM, RHI_IMAGE_USAGE_STORAGE_BIT,
+            m_gbuffer_albedo_image, m_gbuffer_albedo_image_view, m_gbuffer_albedo_image_memory);
 
-        // 创建图像视图
-        RHIImageViewCreateInfo view_create_info{};
-        view_create_info.sType = RHI_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-        view_create_info.image = m_output_image;
-        view_create_info.viewType = RHI_IMAGE_VIEW_TYPE_2D;
-        view_create_info.format = RHI_FORMAT_R8G8B8A8_UNORM;
-        view_create_info.subresourceRange.aspectMask = RHI_IMAGE_ASPECT_COLOR_BIT;
-        view_create_info.subresourceRange.baseMipLevel = 0;
-        view_create_info.subresourceRange.levelCount = 1;
-        view_create_info.subresourceRange.baseArrayLayer = 0;
-        view_create_info.subresourceRange.layerCount = 1;
+        // 主光线G-Buffer：世界空间法线（供棋盘格重建按法线相似度插值）
+        createStorageImage(m_output_width, m_output_height, RHI_FORMAT_R16G16B16A16_SFLOAT, RHI_IMAGE_USAGE_STORAGE_BIT,
+            m_gbuffer_normal_image, m_gbuffer_normal_image_view, m_gbuffer_normal_image_memory);
 
-        if (m_rhi->createImageView(&view_create_info, m_output_image_view) != RHI_SUCCESS)
-        {
-            throw std::runtime_error("[RayTracingPass] Failed to create output image view");
-        }
+        // 自适应采样方差缓冲区：亮度均值、二阶矩与本帧采样数
+        createStorageImage(m_output_width, m_output_height, RHI_FORMAT_R32G32B32A32_SFLOAT, RHI_IMAGE_USAGE_STORAGE_BIT,
+            m_variance_image, m_variance_image_view, m_variance_image_memory);
+
+        // 新图像内容未定义，必须从头累积
+        resetAccumulation();
     }
 
     /**
@@ -1006,9 +1369,13 @@ namespace Elish
         // 预先声明所有需要的描述符信息结构体，确保它们在整个函数执行期间都有效
         RHIWriteDescriptorSetAccelerationStructureKHR tlas_info{};
         RHIDescriptorImageInfo image_info{};
+        RHIDescriptorImageInfo accumulation_image_info{};
+        RHIDescriptorImageInfo gbuffer_position_info{};
+        RHIDescriptorImageInfo gbuffer_albedo_info{};
+        RHIDescriptorImageInfo gbuffer_normal_info{};
+        RHIDescriptorImageInfo variance_image_info{};
         RHIDescriptorBufferInfo buffer_info{};
-        RHIDescriptorBufferInfo vertex_buffer_info{};
-        RHIDescriptorBufferInfo index_buffer_info{};
+        RHIDescriptorBufferInfo geometry_table_info{};
 
         // 更新加速结构绑定
         auto& ray_tracing_resource = m_render_resource->getRayTracingResource();
@@ -1055,6 +1422,88 @@ namespace Elish
             descriptor_writes.push_back(image_write);
         }
 
+        // 更新累积缓冲区绑定
+        if (m_accumulation_image_view)
+        {
+            accumulation_image_info.imageLayout = RHI_IMAGE_LAYOUT_GENERAL;
+            accumulation_image_info.imageView = m_accumulation_image_view;
+            accumulation_image_info.sampler = nullptr;
+
+            RHIWriteDescriptorSet accumulation_write{};
+            accumulation_write.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            accumulation_write.dstSet = m_descriptor_infos[current_frame].descriptor_set;
+            accumulation_write.dstBinding = 3;
+            accumulation_write.dstArrayElement = 0;
+            accumulation_write.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            accumulation_write.descriptorCount = 1;
+            accumulation_write.pImageInfo = &accumulation_image_info;
+            descriptor_writes.push_back(accumulation_write);
+        }
+
+        // 更新G-Buffer绑定
+        if (m_gbuffer_position_image_view && m_gbuffer_albedo_image_view && m_gbuffer_normal_image_view)
+        {
+            gbuffer_position_info.imageLayout = RHI_IMAGE_LAYOUT_GENERAL;
+            gbuffer_position_info.imageView = m_gbuffer_position_image_view;
+            gbuffer_position_info.sampler = nullptr;
+
+            RHIWriteDescriptorSet gbuffer_position_write{};
+            gbuffer_position_write.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            gbuffer_position_write.dstSet = m_descriptor_infos[current_frame].descriptor_set;
+            gbuffer_position_write.dstBinding = 6;
+            gbuffer_position_write.dstArrayElement = 0;
+            gbuffer_position_write.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            gbuffer_position_write.descriptorCount = 1;
+            gbuffer_position_write.pImageInfo = &gbuffer_position_info;
+            descriptor_writes.push_back(gbuffer_position_write);
+
+            gbuffer_albedo_info.imageLayout = RHI_IMAGE_LAYOUT_GENERAL;
+            gbuffer_albedo_info.imageView = m_gbuffer_albedo_image_view;
+            gbuffer_albedo_info.sampler = nullptr;
+
+            RHIWriteDescriptorSet gbuffer_albedo_write{};
+            gbuffer_albedo_write.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            gbuffer_albedo_write.dstSet = m_descriptor_infos[current_frame].descriptor_set;
+            gbuffer_albedo_write.dstBinding = 7;
+            gbuffer_albedo_write.dstArrayElement = 0;
+            gbuffer_albedo_write.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            gbuffer_albedo_write.descriptorCount = 1;
+            gbuffer_albedo_write.pImageInfo = &gbuffer_albedo_info;
+            descriptor_writes.push_back(gbuffer_albedo_write);
+
+            gbuffer_normal_info.imageLayout = RHI_IMAGE_LAYOUT_GENERAL;
+            gbuffer_normal_info.imageView = m_gbuffer_normal_image_view;
+            gbuffer_normal_info.sampler = nullptr;
+
+            RHIWriteDescriptorSet gbuffer_normal_write{};
+            gbuffer_normal_write.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            gbuffer_normal_write.dstSet = m_descriptor_infos[current_frame].descriptor_set;
+            gbuffer_normal_write.dstBinding = 9;
+            gbuffer_normal_write.dstArrayElement = 0;
+            gbuffer_normal_write.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            gbuffer_normal_write.descriptorCount = 1;
+            gbuffer_normal_write.pImageInfo = &gbuffer_normal_info;
+            descriptor_writes.push_back(gbuffer_normal_write);
+        }
+
+        // 更新方差缓冲区绑定
+        if (m_variance_image_view)
+        {
+            variance_image_info.imageLayout = RHI_IMAGE_LAYOUT_GENERAL;
+            variance_image_info.imageView = m_variance_image_view;
+            variance_image_info.sampler = nullptr;
+
+            RHIWriteDescriptorSet variance_write{};
+            variance_write.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            variance_write.dstSet = m_descriptor_infos[current_frame].descriptor_set;
+            variance_write.dstBinding = 8;
+            variance_write.dstArrayElement = 0;
+            variance_write.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            variance_write.descriptorCount = 1;
+            variance_write.pImageInfo = &variance_image_info;
+            descriptor_writes.push_back(variance_write);
+        }
+
         // 更新uniform缓冲区绑定 - 添加更严格的检查
         if (current_frame < m_uniform_buffers.size() && 
             m_uniform_buffers[current_frame] && 
@@ -1076,46 +1525,26 @@ namespace Elish
             descriptor_writes.push_back(buffer_write);
         }
 
-        // 更新顶点和索引缓冲区绑定 - 修复字段名称不匹配问题
-        if (ray_tracing_resource.mergedVertexBuffer && ray_tracing_resource.mergedIndexBuffer)
-        {
-            LOG_DEBUG("[RayTracingPass] Binding merged buffers: vertex_buffer={}, index_buffer={}", 
-                      (void*)ray_tracing_resource.mergedVertexBuffer, (void*)ray_tracing_resource.mergedIndexBuffer);
-
-            // 顶点缓冲区（绑定4：匹配着色器中VertexBuffer的绑定）
-            vertex_buffer_info.buffer = ray_tracing_resource.mergedVertexBuffer;
-            vertex_buffer_info.offset = 0;
-            vertex_buffer_info.range = RHI_WHOLE_SIZE;
-
-            RHIWriteDescriptorSet vertex_write{};
-            vertex_write.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            vertex_write.dstSet = m_descriptor_infos[current_frame].descriptor_set;
-            vertex_write.dstBinding = 4;
-            vertex_write.dstArrayElement = 0;
-            vertex_write.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-            vertex_write.descriptorCount = 1;
-            vertex_write.pBufferInfo = &vertex_buffer_info;
-            descriptor_writes.push_back(vertex_write);
-
-            // 索引缓冲区（绑定5：匹配着色器中IndexBuffer的绑定）
-            index_buffer_info.buffer = ray_tracing_resource.mergedIndexBuffer;
-            index_buffer_info.offset = 0;
-            index_buffer_info.range = RHI_WHOLE_SIZE;
-
-            RHIWriteDescriptorSet index_write{};
-            index_write.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            index_write.dstSet = m_descriptor_infos[current_frame].descriptor_set;
-            index_write.dstBinding = 5;
-            index_write.dstArrayElement = 0;
-            index_write.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-            index_write.descriptorCount = 1;
-            index_write.pBufferInfo = &index_buffer_info;
-            descriptor_writes.push_back(index_write);
+        // 更新实例几何地址表绑定（命中着色器经设备地址读取各网格自身的缓冲区）
+        if (ray_tracing_resource.geometryAddressBuffer)
+        {
+            geometry_table_info.buffer = ray_tracing_resource.geometryAddressBuffer;
+            geometry_table_info.offset = 0;
+            geometry_table_info.range = RHI_WHOLE_SIZE;
+
+            RHIWriteDescriptorSet geometry_table_write{};
+            geometry_table_write.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            geometry_table_write.dstSet = m_descriptor_infos[current_frame].descriptor_set;
+            geometry_table_write.dstBinding = 4;
+            geometry_table_write.dstArrayElement = 0;
+            geometry_table_write.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            geometry_table_write.descriptorCount = 1;
+            geometry_table_write.pBufferInfo = &geometry_table_info;
+            descriptor_writes.push_back(geometry_table_write);
         }
         else
         {
-            LOG_ERROR("[RayTracingPass] Merged buffers are missing! VertexBuffer={}, IndexBuffer={}", 
-                      (void*)ray_tracing_resource.mergedVertexBuffer, (void*)ray_tracing_resource.mergedIndexBuffer);
+            LOG_ERROR("[RayTracingPass] Geometry address table is missing!");
         }
 
         // 更新描述符集
@@ -1408,6 +1837,11 @@ namespace Elish
                     m_rhi->destroyImage(m_output_image);
                     m_output_image = nullptr;
                 }
+                destroyStorageImage(m_accumulation_image, m_accumulation_image_view, m_accumulation_image_memory);
+                destroyStorageImage(m_gbuffer_position_image, m_gbuffer_position_image_view, m_gbuffer_position_image_memory);
+                destroyStorageImage(m_gbuffer_albedo_image, m_gbuffer_albedo_image_view, m_gbuffer_albedo_image_memory);
+                destroyStorageImage(m_gbuffer_normal_image, m_gbuffer_normal_image_view, m_gbuffer_normal_image_memory);
+                destroyStorageImage(m_variance_image, m_variance_image_view, m_variance_image_memory);
             }
             
             // 清理描述符集布局 (步骤1及以后)
@@ -1528,8 +1962,37 @@ namespace Elish
         LOG_DEBUG("[RayTracingPass] Dynamic parameters: samples={}, depth={}, noise_threshold={:.4f}, quality={:.2f}", 
                  adaptive_samples, adjusted_depth, noise_threshold, quality_factor);
         
-        // 这些参数将通过推送常量传递给着色器
-        // 在实际渲染时使用
+        // 这些参数将通过推送常量传递给着色器，在下一次调度时生效
+        // 采样预算或阈值变化只影响后续采样分配，已累积的样本仍然有效，无需重置累积
+        m_adaptive_max_samples = adaptive_samples;
+        m_noise_threshold = noise_threshold;
+        m_quality_factor = quality_factor;
+    }
+
+    /**
+     * @brief 启用或禁用自适应采样
+     */
+    void RayTracingPass::setAdaptiveSamplingEnabled(bool enabled)
+    {
+        if (m_adaptive_sampling_enabled != enabled)
+        {
+            m_adaptive_sampling_enabled = enabled;
+            LOG_INFO("[RayTracingPass] Adaptive sampling {}", enabled ? "enabled" : "disabled");
+        }
+    }
+
+    /**
+     * @brief 启用或禁用棋盘格渲染
+     * @details 两种模式下像素的累积样本数含义不同，切换时重置累积
+     */
+    void RayTracingPass::setCheckerboardEnabled(bool enabled)
+    {
+        if (m_checkerboard_enabled != enabled)
+        {
+            m_checkerboard_enabled = enabled;
+            resetAccumulation();
+            LOG_INFO("[RayTracingPass] Checkerboard rendering {}", enabled ? "enabled" : "disabled");
+        }
     }
     
     /**
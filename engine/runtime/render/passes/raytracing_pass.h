@@ -11,6 +11,8 @@
 
 namespace Elish
 {
+    class CpuRayTracer;
+
     /**
      * @brief 光线追踪渲染通道类
      * @details 负责执行光线追踪渲染，包括加速结构更新、光线追踪管线绑定和光线追踪调度
@@ -69,6 +71,13 @@ namespace Elish
          * @return 输出图像指针
          */
         RHIImage* getOutputImage() const { return m_output_image; }
+        RHIImageView* getOutputImageView() const { return m_output_image_view; }
+        RHIImage* getGBufferPositionImage() const { return m_gbuffer_position_image; }
+        RHIImageView* getGBufferPositionImageView() const { return m_gbuffer_position_image_view; }
+        RHIImageView* getGBufferAlbedoImageView() const { return m_gbuffer_albedo_image_view; }
+        RHIImageView* getGBufferNormalImageView() const { return m_gbuffer_normal_image_view; }
+        uint32_t getOutputWidth() const { return m_output_width; }
+        uint32_t getOutputHeight() const { return m_output_height; }
 
         /**
          * @brief 设置光线追踪启用状态
@@ -82,6 +91,13 @@ namespace Elish
          */
         bool isRayTracingEnabled() const { return m_ray_tracing_enabled; }
 
+        /**
+         * @brief 是否使用CPU软件光线追踪回退
+         * @details 设备不支持硬件光线追踪时由CpuRayTracer渲染，结果上传到同一输出图像，合成流程不变；
+         *          回退模式不产生G-Buffer，也不执行累积与降噪
+         */
+        bool isSoftwareFallback() const { return m_software_fallback; }
+
         /**
          * @brief 设置光线追踪参数
          * @param max_depth 最大反射深度
@@ -96,22 +112,65 @@ namespace Elish
 
         /**
          * @brief 动态调整光线追踪参数
+         * @details 参数经限制后保存，下一次调度时通过推送常量驱动自适应采样
          * @param frame_number 当前帧号
-         * @param adaptive_samples 自适应采样数
-         * @param noise_threshold 噪声阈值
+         * @param adaptive_samples 自适应采样数（单像素单帧采样上限）
+         * @param noise_threshold 噪声阈值（均值相对标准误差低于该值视为收敛）
          * @param quality_factor 质量因子
          */
         void adjustRayTracingParameters(uint32_t frame_number, uint32_t adaptive_samples, float noise_threshold, float quality_factor);
         
         /**
          * @brief 设置渲染缩放比例
+         * @details 输出图像在下一次preparePassData()中按新比例重建，不会在录制途中销毁本帧已引用的图像
          * @param scale 渲染缩放比例（0.5-1.0）
          */
-        void setRenderScale(float scale) { m_render_scale = std::clamp(scale, 0.5f, 1.0f); }
+        void setRenderScale(float scale) { m_target_render_scale = std::clamp(scale, 0.5f, 1.0f); }
         
-        float getRenderScale() const { return m_render_scale; }
+        float getRenderScale() const { return m_target_render_scale; }
         uint32_t getMaxRayDepth() const { return m_max_ray_depth; }
         uint32_t getSamplesPerPixel() const { return m_samples_per_pixel; }
+
+        /**
+         * @brief 重置渐进式累积
+         * @details 清空累积帧计数，下一帧将直接覆盖累积缓冲区重新开始收敛
+         */
+        void resetAccumulation();
+
+        /**
+         * @brief 设置渐进式累积启用状态
+         * @param enabled 是否启用累积（禁用时每帧只输出当前采样）
+         */
+        void setAccumulationEnabled(bool enabled);
+
+        bool isAccumulationEnabled() const { return m_accumulation_enabled; }
+
+        /**
+         * @brief 设置自适应采样启用状态
+         * @details 根据逐像素方差分配采样：噪声大的像素追加采样，已收敛的像素跳过追踪；
+         *          依赖渐进累积的跨帧统计，累积关闭时退化为每像素固定采样
+         * @param enabled 是否启用自适应采样
+         */
+        void setAdaptiveSamplingEnabled(bool enabled);
+
+        bool isAdaptiveSamplingEnabled() const { return m_adaptive_sampling_enabled; }
+        RHIImageView* getVarianceImageView() const { return m_variance_image_view; }
+        uint32_t getAccumulatedFrameCount() const { return m_accumulated_frame_count; }
+
+        /**
+         * @brief 设置棋盘格渲染启用状态
+         * @details 启用后每帧只对(x+y)奇偶性与当前parity一致的像素发射光线，光线数减半，
+         *          其余像素由RayTracingCheckerboardPass重建；切换时重置累积
+         * @param enabled 是否启用棋盘格渲染
+         */
+        void setCheckerboardEnabled(bool enabled);
+
+        bool isCheckerboardEnabled() const { return m_checkerboard_enabled; }
+
+        /**
+         * @brief 获取上一帧追踪的棋盘格奇偶性（供重建通道使用）
+         */
+        uint32_t getCheckerboardParity() const { return m_checkerboard_parity; }
         
         /**
          * @brief 光线追踪诊断信息结构体
@@ -171,6 +230,26 @@ namespace Elish
          */
         void createOutputImage();
 
+        /**
+         * @brief 创建渐进式累积缓冲区（RGBA32F）与主光线G-Buffer
+         * @details 与输出图像同分辨率，重建后累积自动重置
+         */
+        void createAccumulationImage();
+
+        /**
+         * @brief 检测相机、光源或场景物体是否发生变化
+         * @param view 当前视图矩阵
+         * @param proj 当前投影矩阵
+         * @return 发生变化返回true，此时需要重置累积
+         */
+        bool detectSceneChange(const glm::mat4& view, const glm::mat4& proj);
+
+        /**
+         * @brief 计算光源与物体变换的哈希值
+         * @return 场景状态哈希
+         */
+        size_t computeSceneStateHash() const;
+
         /**
          * @brief 更新描述符集
          */
@@ -181,6 +260,27 @@ namespace Elish
          */
         void createShaderBindingTable();
 
+        /**
+         * @brief 初始化CPU软件光线追踪回退
+         * @details 创建输出图像与每帧的主机可见暂存缓冲区，不创建任何光线追踪管线资源
+         */
+        void initializeSoftwareFallback();
+
+        /**
+         * @brief 以软件光线追踪渲染一帧并录制上传命令
+         * @details 相机与光源参数与硬件路径一致；CPU渲染结果写入当前帧暂存缓冲区，
+         *          再拷贝到输出图像并转换回GENERAL布局供合成采样
+         * @param command_buffer 当前命令缓冲区
+         */
+        void drawSoftwareRayTracing(RHICommandBuffer* command_buffer);
+
+        /**
+         * @brief 按输出分辨率创建软件回退的暂存缓冲区（每个飞行帧一个）
+         */
+        void createSoftwareStagingBuffers();
+
+        void destroySoftwareStagingBuffers();
+
         /**
          * @brief 执行初始化清理操作
          * @param failed_step 失败的初始化步骤
@@ -208,6 +308,27 @@ namespace Elish
         RHIImageView* m_output_image_view = nullptr;
         RHIDeviceMemory* m_output_image_memory = nullptr;
 
+        // 渐进式累积缓冲区（RGBA32F，保存线性空间的运行平均值）
+        RHIImage* m_accumulation_image = nullptr;
+        RHIImageView* m_accumulation_image_view = nullptr;
+        RHIDeviceMemory* m_accumulation_image_memory = nullptr;
+
+        // 主光线G-Buffer（降噪器的辅助输入）
+        RHIImage* m_gbuffer_position_image = nullptr;        // xyz: 世界空间命中位置, w: 命中距离（未命中为-1）
+        RHIImageView* m_gbuffer_position_image_view = nullptr;
+        RHIDeviceMemory* m_gbuffer_position_image_memory = nullptr;
+        RHIImage* m_gbuffer_albedo_image = nullptr;          // rgb: 表面反照率
+        RHIImageView* m_gbuffer_albedo_image_view = nullptr;
+        RHIDeviceMemory* m_gbuffer_albedo_image_memory = nullptr;
+        RHIImage* m_gbuffer_normal_image = nullptr;          // xyz: 世界空间法线（棋盘格重建使用）
+        RHIImageView* m_gbuffer_normal_image_view = nullptr;
+        RHIDeviceMemory* m_gbuffer_normal_image_memory = nullptr;
+
+        // 自适应采样方差缓冲区（x: 亮度均值, y: 亮度二阶矩, z: 本帧采样数, w: 相对误差）
+        RHIImage* m_variance_image = nullptr;
+        RHIImageView* m_variance_image_view = nullptr;
+        RHIDeviceMemory* m_variance_image_memory = nullptr;
+
         // 着色器绑定表
         RHIBuffer* m_raygen_shader_binding_table = nullptr;
         RHIBuffer* m_miss_shader_binding_table = nullptr;
@@ -247,8 +368,18 @@ namespace Elish
             uint32_t adaptive_samples;      // 自适应采样数
             float noise_threshold;          // 噪声阈值
             float quality_factor;           // 质量因子 (0.0-1.0)
+            uint32_t accumulated_frames;    // 已累积帧数，0表示重新开始累积
+            uint32_t checkerboard;          // bit0: 棋盘格模式, bit1: 本帧追踪的像素奇偶性
         };
 
+        // CPU软件光线追踪回退
+        bool m_software_fallback = false;
+        std::unique_ptr<CpuRayTracer> m_software_tracer;
+        std::vector<uint32_t> m_software_pixels;                // RGBA8
+        std::vector<RHIBuffer*> m_software_staging_buffers;
+        std::vector<RHIDeviceMemory*> m_software_staging_memory;
+        std::vector<void*> m_software_staging_mapped;
+
         // Uniform缓冲区
         std::vector<RHIBuffer*> m_uniform_buffers;
         std::vector<RHIDeviceMemory*> m_uniform_buffers_memory;
@@ -264,10 +395,29 @@ namespace Elish
         uint32_t m_output_width = 0;
         uint32_t m_output_height = 0;
         float m_render_scale = 1.0f;
+        float m_target_render_scale = 1.0f;         // 待生效的缩放比例，帧开始时应用
 
         // 跟踪上一帧是否执行了光线追踪
         bool m_traced_last_frame = false;
 
+        // 渐进式累积状态
+        bool m_accumulation_enabled = true;
+        uint32_t m_accumulated_frame_count = 0;     // 当前累积帧数，场景变化时归零
+        uint32_t m_frame_number = 0;                // 单调递增帧号，用于随机数种子
+
+        // 自适应采样参数
+        bool m_adaptive_sampling_enabled = true;
+        uint32_t m_adaptive_max_samples = 4;        // 单像素单帧采样上限，仅作用于累积样本足够且未收敛的像素
+        float m_noise_threshold = 0.02f;            // 收敛判定的相对误差阈值
+        float m_quality_factor = 1.0f;              // 采样预算缩放
+
+        // 棋盘格渲染状态
+        bool m_checkerboard_enabled = false;
+        uint32_t m_checkerboard_parity = 0;         // 最近一次追踪的像素奇偶性
+        glm::mat4 m_last_view_matrix = glm::mat4(0.0f);
+        glm::mat4 m_last_proj_matrix = glm::mat4(0.0f);
+        size_t m_last_scene_state_hash = 0;
+
     public:
         /**
          * @brief 查询上一帧是否执行了光线追踪
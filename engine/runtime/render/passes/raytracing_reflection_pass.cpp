@@ -0,0 +1,380 @@
+#include "raytracing_reflection_pass.h"
+#include "../../core/base/macro.h"
+#include "../../render/interface/rhi.h"
+#include "../render_resource.h"
+#include "../render_camera.h"
+#include "../descriptor_allocator.h"
+
+#include <stdexcept>
+
+// 包含生成的光线追踪反射计算着色器头文件
+#include "../../shader/generated/cpp/rt_reflections_comp.h"
+
+namespace Elish
+{
+    /**
+     * @brief 析构函数
+     * @details 等待GPU完成后释放输出图像与管线
+     */
+    RayTracingReflectionPass::~RayTracingReflectionPass()
+    {
+        if (!m_rhi)
+        {
+            return;
+        }
+
+        waitForGpuIdle();
+
+        destroyOutputImages();
+
+        // 计算管线归管线缓存所有，销毁布局前移除以该布局为键的缓存管线
+        m_pipeline = nullptr;
+        if (m_pipeline_layout)
+        {
+            if (m_pipeline_cache)
+            {
+                m_pipeline_cache->releasePipelineLayout(m_pipeline_layout);
+            }
+            m_rhi->destroyPipelineLayout(m_pipeline_layout);
+            m_pipeline_layout = nullptr;
+        }
+    }
+
+    /**
+     * @brief 初始化反射通道
+     */
+    void RayTracingReflectionPass::initialize()
+    {
+        m_is_initialized = false;
+
+        if (!m_rhi)
+        {
+            LOG_ERROR("[RayTracingReflectionPass] RHI is null, cannot initialize ray traced reflections");
+            return;
+        }
+
+        if (!m_rhi->isRayQuerySupported())
+        {
+            LOG_INFO("[RayTracingReflectionPass] Ray query not supported, ray traced reflections disabled");
+            return;
+        }
+
+        m_is_initialized = runSetupStep("[RayTracingReflectionPass]", "Initialization failed", [this]() {
+            setupDescriptorSetLayout();
+            setupPipeline();
+        });
+        if (m_is_initialized)
+        {
+            LOG_INFO("[RayTracingReflectionPass] Ray traced reflections initialized");
+        }
+    }
+
+    /**
+     * @brief 准备反射数据
+     * @details 光源与raytracing_pass保持一致，保证反射中的物体与光线追踪输出着色相同
+     */
+    void RayTracingReflectionPass::preparePassData(std::shared_ptr<RenderResource> render_resource)
+    {
+        m_render_resource = render_resource;
+        if (!render_resource)
+        {
+            return;
+        }
+
+        auto camera = render_resource->getCamera();
+        if (camera)
+        {
+            glm::mat4 view_matrix = camera->getViewMatrix();
+            glm::mat4 view_proj = camera->getPersProjMatrix() * view_matrix;
+            m_push_constants.view_proj_inverse = glm::inverse(view_proj);
+            m_push_constants.camera_position = glm::inverse(view_matrix) * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        }
+
+        m_push_constants.light_position = glm::vec4(10.0f, 10.0f, 10.0f, 1.0f);
+        m_push_constants.light_color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+        m_push_constants.params = glm::vec4(m_roughness_threshold, k_max_reflection_distance, 0.0f, 0.0f);
+    }
+
+    /**
+     * @brief 设置反射输出分辨率
+     */
+    void RayTracingReflectionPass::setOutputSize(uint32_t width, uint32_t height)
+    {
+        if (!m_is_initialized || width == 0 || height == 0)
+        {
+            return;
+        }
+        if (width == m_width && height == m_height && m_color.image)
+        {
+            return;
+        }
+
+        // 输出图像可能仍被在途帧的计算或片段着色器引用，重建前等待GPU空闲
+        waitForGpuIdle();
+
+        m_width = width;
+        m_height = height;
+
+        if (runSetupStep("[RayTracingReflectionPass]", "Failed to create reflection buffers", [this]() { createOutputImages(); }))
+        {
+            LOG_DEBUG("[RayTracingReflectionPass] Reflection buffers resized to {}x{}", m_width, m_height);
+        }
+        else
+        {
+            destroyOutputImages();
+        }
+    }
+
+    /**
+     * @brief 录制反射追踪命令
+     */
+    void RayTracingReflectionPass::draw(RHICommandBuffer* command_buffer)
+    {
+        if (!isReady() || !command_buffer || !m_render_resource)
+        {
+            return;
+        }
+
+        uint32_t frame_index = m_rhi->getCurrentFrameIndex();
+        if (!updateDescriptorSet(frame_index))
+        {
+            return;
+        }
+
+        if (!m_output_images_initialized)
+        {
+            // 首次使用时将输出图像转换到GENERAL布局
+            RHIImageMemoryBarrier barriers[2] = {};
+            RHIImage* images[2] = { m_color.image, m_guide.image };
+            for (uint32_t i = 0; i < 2; ++i)
+            {
+                barriers[i].sType = RHI_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                barriers[i].oldLayout = RHI_IMAGE_LAYOUT_UNDEFINED;
+                barriers[i].newLayout = RHI_IMAGE_LAYOUT_GENERAL;
+                barriers[i].srcQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
+                barriers[i].dstQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
+                barriers[i].image = images[i];
+                barriers[i].subresourceRange.aspectMask = RHI_IMAGE_ASPECT_COLOR_BIT;
+                barriers[i].subresourceRange.baseMipLevel = 0;
+                barriers[i].subresourceRange.levelCount = 1;
+                barriers[i].subresourceRange.baseArrayLayer = 0;
+                barriers[i].subresourceRange.layerCount = 1;
+                barriers[i].srcAccessMask = 0;
+                barriers[i].dstAccessMask = RHI_ACCESS_SHADER_WRITE_BIT;
+            }
+
+            m_rhi->cmdPipelineBarrier(
+                command_buffer,
+                RHI_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                0,
+                0, nullptr,
+                0, nullptr,
+                2, barriers);
+
+            m_output_images_initialized = true;
+        }
+        else
+        {
+            // 上一帧的片段着色器可能仍在读取输出图像（写后读之外的读后写冲突）
+            m_rhi->cmdPipelineBarrier(
+                command_buffer,
+                RHI_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                0,
+                0, nullptr,
+                0, nullptr,
+                0, nullptr);
+        }
+
+        m_rhi->cmdBindPipelinePFN(command_buffer, RHI_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+        m_rhi->cmdBindDescriptorSetsPFN(command_buffer, RHI_PIPELINE_BIND_POINT_COMPUTE, m_pipeline_layout,
+            0, 1, &m_descriptor_sets[frame_index], 0, nullptr);
+        m_rhi->cmdPushConstantsPFN(command_buffer, m_pipeline_layout, RHI_SHADER_STAGE_COMPUTE_BIT,
+            0, sizeof(ReflectionPushConstants), &m_push_constants);
+        m_rhi->cmdDispatch(command_buffer,
+            (m_width + k_workgroup_size - 1) / k_workgroup_size,
+            (m_height + k_workgroup_size - 1) / k_workgroup_size,
+            1);
+
+        // 反射结果供主相机通道的片段着色器上采样
+        RHIMemoryBarrier completion_barrier{};
+        completion_barrier.sType = RHI_STRUCTURE_TYPE_MEMORY_BARRIER;
+        completion_barrier.srcAccessMask = RHI_ACCESS_SHADER_WRITE_BIT;
+        completion_barrier.dstAccessMask = RHI_ACCESS_SHADER_READ_BIT;
+        m_rhi->cmdPipelineBarrier(
+            command_buffer,
+            RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            RHI_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            0,
+            1, &completion_barrier,
+            0, nullptr,
+            0, nullptr);
+    }
+
+    /**
+     * @brief 创建描述符集布局
+     * @details 0 TLAS, 1 几何地址表, 2 反射辐射度, 3 主表面引导图
+     */
+    void RayTracingReflectionPass::setupDescriptorSetLayout()
+    {
+        RHIDescriptorSetLayoutBinding bindings[4] = {};
+        const RHIDescriptorType types[4] = {
+            RHI_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
+            RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+            RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+        };
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = types[i];
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = RHI_SHADER_STAGE_COMPUTE_BIT;
+            bindings[i].pImmutableSamplers = nullptr;
+        }
+
+        RHIDescriptorSetLayoutCreateInfo layout_create_info{};
+        layout_create_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layout_create_info.bindingCount = 4;
+        layout_create_info.pBindings = bindings;
+
+        if (m_rhi->createDescriptorSetLayout(&layout_create_info, m_descriptor_set_layout) != RHI_SUCCESS)
+        {
+            throw std::runtime_error("[RayTracingReflectionPass] Failed to create descriptor set layout");
+        }
+    }
+
+    /**
+     * @brief 创建反射计算管线
+     */
+    void RayTracingReflectionPass::setupPipeline()
+    {
+        RHIPushConstantRange push_constant_range{};
+        push_constant_range.stageFlags = RHI_SHADER_STAGE_COMPUTE_BIT;
+        push_constant_range.offset = 0;
+        push_constant_range.size = sizeof(ReflectionPushConstants);
+
+        RHIPipelineLayoutCreateInfo pipeline_layout_create_info{};
+        pipeline_layout_create_info.sType = RHI_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipeline_layout_create_info.setLayoutCount = 1;
+        pipeline_layout_create_info.pSetLayouts = &m_descriptor_set_layout;
+        pipeline_layout_create_info.pushConstantRangeCount = 1;
+        pipeline_layout_create_info.pPushConstantRanges = &push_constant_range;
+
+        if (m_rhi->createPipelineLayout(&pipeline_layout_create_info, m_pipeline_layout) != RHI_SUCCESS)
+        {
+            throw std::runtime_error("[RayTracingReflectionPass] Failed to create pipeline layout");
+        }
+
+        RHIShader* shader_module = m_pipeline_cache->getShader(RT_REFLECTIONS_COMP);
+        if (!shader_module)
+        {
+            throw std::runtime_error("[RayTracingReflectionPass] Failed to create compute shader module");
+        }
+
+        RHIPipelineShaderStageCreateInfo stage{};
+        stage.sType = RHI_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stage.stage = RHI_SHADER_STAGE_COMPUTE_BIT;
+        stage.module = shader_module;
+        stage.pName = "main";
+        stage.pSpecializationInfo = nullptr;
+
+        RHIComputePipelineCreateInfo pipeline_create_info{};
+        pipeline_create_info.sType = RHI_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipeline_create_info.pStages = &stage;
+        pipeline_create_info.layout = m_pipeline_layout;
+        pipeline_create_info.basePipelineHandle = RHI_NULL_HANDLE;
+        pipeline_create_info.basePipelineIndex = -1;
+
+        m_pipeline = m_pipeline_cache->getOrCreateComputePipeline(pipeline_create_info);
+        if (!m_pipeline)
+        {
+            throw std::runtime_error("[RayTracingReflectionPass] Failed to create compute pipeline");
+        }
+    }
+
+    /**
+     * @brief 创建反射颜色与引导图（rgba16f，可作存储图像与采样图像）
+     */
+    void RayTracingReflectionPass::createOutputImages()
+    {
+        destroyOutputImages();
+        const RHIImageUsageFlags usage = RHI_IMAGE_USAGE_STORAGE_BIT | RHI_IMAGE_USAGE_SAMPLED_BIT;
+        createStorageImage(m_width, m_height, RHI_FORMAT_R16G16B16A16_SFLOAT, usage, m_color);
+        createStorageImage(m_width, m_height, RHI_FORMAT_R16G16B16A16_SFLOAT, usage, m_guide);
+        m_output_images_initialized = false;
+    }
+
+    /**
+     * @brief 销毁输出图像
+     */
+    void RayTracingReflectionPass::destroyOutputImages()
+    {
+        destroyStorageImage(m_color);
+        destroyStorageImage(m_guide);
+    }
+
+    /**
+     * @brief 从分配器缓存取得与当前TLAS、几何地址表和输出图像匹配的描述符集
+     * @return 描述符集可用返回true
+     */
+    bool RayTracingReflectionPass::updateDescriptorSet(uint32_t frame_index)
+    {
+        const RayTracingResource& ray_tracing_resource = m_render_resource->getRayTracingResource();
+        RHIAccelerationStructure* tlas = ray_tracing_resource.tlas;
+        RHIBuffer* geometry_table = ray_tracing_resource.geometryAddressBuffer;
+        if (!tlas || !geometry_table)
+        {
+            return false;
+        }
+
+        uint32_t max_frames_in_flight = m_rhi->getMaxFramesInFlight();
+        if (m_descriptor_sets.size() != max_frames_in_flight)
+        {
+            m_descriptor_sets.assign(max_frames_in_flight, nullptr);
+        }
+
+        RHIWriteDescriptorSetAccelerationStructureKHR tlas_info{};
+        tlas_info.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR;
+        tlas_info.accelerationStructureCount = 1;
+        tlas_info.pAccelerationStructures = &tlas;
+
+        RHIDescriptorBufferInfo geometry_table_info{};
+        geometry_table_info.buffer = geometry_table;
+        geometry_table_info.offset = 0;
+        geometry_table_info.range = RHI_WHOLE_SIZE;
+
+        RHIDescriptorImageInfo image_infos[2] = {};
+        image_infos[0].imageLayout = RHI_IMAGE_LAYOUT_GENERAL;
+        image_infos[0].imageView = m_color.view;
+        image_infos[1].imageLayout = RHI_IMAGE_LAYOUT_GENERAL;
+        image_infos[1].imageView = m_guide.view;
+
+        RHIWriteDescriptorSet writes[4] = {};
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            writes[i].sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstBinding = i;
+            writes[i].dstArrayElement = 0;
+            writes[i].descriptorCount = 1;
+        }
+        writes[0].pNext = &tlas_info;
+        writes[0].descriptorType = RHI_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+        writes[1].descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[1].pBufferInfo = &geometry_table_info;
+        writes[2].descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[2].pImageInfo = &image_infos[0];
+        writes[3].descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[3].pImageInfo = &image_infos[1];
+
+        m_descriptor_sets[frame_index] = m_descriptor_allocator->getOrCreate(m_descriptor_set_layout, 4, writes);
+        if (!m_descriptor_sets[frame_index])
+        {
+            LOG_ERROR("[RayTracingReflectionPass] Failed to allocate descriptor set for frame {}", frame_index);
+            return false;
+        }
+        return true;
+    }
+
+} // namespace Elish
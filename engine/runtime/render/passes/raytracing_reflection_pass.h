@@ -0,0 +1,108 @@
+#pragma once
+
+#include "../render_pass.h"
+#include "../render_resource.h"
+#include <glm/glm.hpp>
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace Elish
+{
+    /**
+     * @brief 粗糙度门控的半分辨率光线追踪反射通道
+     * @details 前向渲染没有G-Buffer，本通道以计算着色器中的光线查询求主光线可见表面，
+     *          仅对粗糙度下界低于阈值的材质发射一条镜面反射光线（逐像素门控由PBR.frag按粗糙度贴图完成）；输出半分辨率的反射辐射度与
+     *          主表面法线/距离引导图，由主相机通道的PBR光线追踪光照变体做深度/法线感知的上采样后替换IBL镜面项
+     */
+    class RayTracingReflectionPass : public RenderPass
+    {
+    public:
+        RayTracingReflectionPass() = default;
+        ~RayTracingReflectionPass();
+
+        /**
+         * @brief 初始化反射通道
+         * @details 设备不支持光线查询时不创建任何资源，isReady()保持false
+         */
+        void initialize() override;
+
+        /**
+         * @brief 准备反射数据
+         * @param render_resource 渲染资源管理器，用于获取相机矩阵、TLAS与几何地址表
+         */
+        void preparePassData(std::shared_ptr<RenderResource> render_resource) override;
+
+        /**
+         * @brief 设置反射输出分辨率（通常为场景视口的一半）
+         * @details 分辨率变化时等待GPU空闲后重建输出图像，未变化时直接返回
+         */
+        void setOutputSize(uint32_t width, uint32_t height);
+
+        /**
+         * @brief 录制反射追踪命令
+         * @details 结束时插入计算->片段着色器屏障，输出图像保持GENERAL布局供片段着色器读取
+         */
+        void draw(RHICommandBuffer* command_buffer);
+
+        bool isReady() const { return m_is_initialized && m_color.view && m_guide.view; }
+
+        void setEnabled(bool enabled) { m_enabled = enabled; }
+        bool isEnabled() const { return m_enabled; }
+
+        /**
+         * @brief 设置粗糙度阈值，粗糙度不低于该值的表面保持IBL
+         */
+        void setRoughnessThreshold(float threshold) { m_roughness_threshold = glm::clamp(threshold, 0.0f, 1.0f); }
+        float getRoughnessThreshold() const { return m_roughness_threshold; }
+
+        RHIImageView* getReflectionColorView() const { return m_color.view; }
+        RHIImageView* getReflectionGuideView() const { return m_guide.view; }
+
+    private:
+        /**
+         * @brief 反射推送常量
+         * @details 与rt_reflections.comp中的PushConstants布局一致
+         */
+        struct ReflectionPushConstants {
+            glm::mat4 view_proj_inverse;  // 视图投影矩阵的逆
+            glm::vec4 camera_position;    // xyz: 相机位置
+            glm::vec4 light_position;     // xyz: 点光源位置
+            glm::vec4 light_color;        // rgb: 点光源颜色
+            glm::vec4 params;             // x: 粗糙度阈值, y: 反射光线最大距离
+        };
+
+        static constexpr uint32_t k_workgroup_size = 8;
+        static constexpr float k_max_reflection_distance = 100.0f;
+
+        void setupDescriptorSetLayout();
+        void setupPipeline();
+        void createOutputImages();
+        void destroyOutputImages();
+        bool updateDescriptorSet(uint32_t frame_index);
+
+    private:
+        bool m_is_initialized = false;
+        bool m_enabled = false;
+        bool m_output_images_initialized = false;  // 输出图像是否已转换到GENERAL布局
+        float m_roughness_threshold = 0.35f;
+
+        uint32_t m_width = 0;
+        uint32_t m_height = 0;
+
+        // 输出：反射辐射度（rgb）与有效性（a）、主表面法线（xyz）与距离（w），均为rgba16f
+        FrameBufferAttachment m_color{};
+        FrameBufferAttachment m_guide{};
+
+        // 各飞行帧本帧使用的描述符集，由DescriptorAllocator按绑定资源缓存
+        RHIDescriptorSetLayout* m_descriptor_set_layout = nullptr;
+        std::vector<RHIDescriptorSet*> m_descriptor_sets;
+
+        RHIPipelineLayout* m_pipeline_layout = nullptr;
+        RHIPipeline* m_pipeline = nullptr;
+
+        std::shared_ptr<RenderResource> m_render_resource;
+        ReflectionPushConstants m_push_constants{};
+    };
+
+} // namespace Elish
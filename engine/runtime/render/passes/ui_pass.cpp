@@ -16,6 +16,7 @@
 #include <backends/imgui_impl_glfw.h>
 #include <backends/imgui_impl_vulkan.h>
 #include <algorithm>
+#include <utility>
 
 #include <stdexcept>
 #include <fstream>
@@ -535,7 +536,35 @@ namespace Elish
                             m_render_resource->updateRenderObjectAnimationParams(selected_model, updatedParams);
                         }
                         ImGui::PopItemWidth();
-                        
+
+                        // Parent（变换相对父物体，父物体移动时随之移动）
+                        ImGui::Text("Parent");
+                        const bool hasParent = animParams.parentIndex >= 0 && animParams.parentIndex < static_cast<int>(renderObjects.size());
+                        ImGui::PushItemWidth(-1);
+                        if (ImGui::BeginCombo("##Parent", hasParent ? renderObjects[animParams.parentIndex].name.c_str() : "None"))
+                        {
+                            if (ImGui::Selectable("None", !hasParent))
+                            {
+                                m_render_resource->setRenderObjectParent(selected_model, -1);
+                            }
+                            for (size_t i = 0; i < renderObjects.size(); ++i)
+                            {
+                                if (static_cast<int>(i) == selected_model)
+                                {
+                                    continue;
+                                }
+                                ImGui::PushID(static_cast<int>(i));
+                                if (ImGui::Selectable(renderObjects[i].name.c_str(), animParams.parentIndex == static_cast<int>(i)) &&
+                                    !m_render_resource->setRenderObjectParent(selected_model, static_cast<int>(i)))
+                                {
+                                    LOG_WARN("[UIPass] Cannot parent {} to {}: would create a cycle", selectedObject.name, renderObjects[i].name);
+                                }
+                                ImGui::PopID();
+                            }
+                            ImGui::EndCombo();
+                        }
+                        ImGui::PopItemWidth();
+
                         ImGui::Spacing();
                         
                         // Auto Rotate
@@ -605,94 +634,144 @@ namespace Elish
         {
             ImGui::Indent(10.0f);
             
-            // 获取渲染管线实例
-            auto render_system = g_runtime_global_context.m_render_system;
-            if (render_system)
+            // 光线追踪启用/禁用控制
+            bool raytracing_enabled = render_pipeline->isRayTracingEnabled();
+            if (ImGui::Checkbox("Enable Ray Tracing", &raytracing_enabled))
             {
-                auto render_pipeline = render_system->getRenderPipeline();
-                if (render_pipeline)
+                render_pipeline->setRayTracingEnabled(raytracing_enabled);
+            }
+            
+            if (raytracing_enabled)
+            {
+                ImGui::Spacing();
+                
+                // 1. Effects (Common)
+                static bool enable_global_illumination = false;
+                
+                ImGui::Text("Effects:");
+                // 半分辨率光线追踪反射：低粗糙度表面的镜面项由追踪结果替换IBL
+                bool enable_reflections = render_pipeline->isRayTracingReflectionsEnabled();
+                if (ImGui::Checkbox("Reflections", &enable_reflections))
+                {
+                    render_pipeline->setRayTracingReflectionsEnabled(enable_reflections);
+                }
+                ImGui::SameLine();
+                // 光线查询阴影：光栅化模型管线直接查询TLAS，阴影贴图通道整体跳过
+                bool enable_shadows = render_pipeline->isRayQueryShadowsEnabled();
+                if (ImGui::Checkbox("Shadows", &enable_shadows))
+                {
+                    render_pipeline->setRayQueryShadowsEnabled(enable_shadows);
+                }
+                ImGui::SameLine();
+                ImGui::Checkbox("GI", &enable_global_illumination);
+                // 半分辨率光线追踪环境遮蔽：短距离遮蔽光线补充接触阴影
+                bool enable_ambient_occlusion = render_pipeline->isRayTracingAmbientOcclusionEnabled();
+                if (ImGui::Checkbox("Ambient Occlusion", &enable_ambient_occlusion))
+                {
+                    render_pipeline->setRayTracingAmbientOcclusionEnabled(enable_ambient_occlusion);
+                }
+                
+                if (enable_reflections)
                 {
-                    // 光线追踪启用/禁用控制
-                    bool raytracing_enabled = render_pipeline->isRayTracingEnabled();
-                    if (ImGui::Checkbox("Enable Ray Tracing", &raytracing_enabled))
+                    float roughness_threshold = render_pipeline->getRayTracingReflectionRoughnessThreshold();
+                    if (ImGui::SliderFloat("Reflection Roughness", &roughness_threshold, 0.0f, 1.0f, "%.2f"))
                     {
-                        render_pipeline->setRayTracingEnabled(raytracing_enabled);
+                        render_pipeline->setRayTracingReflectionRoughnessThreshold(roughness_threshold);
                     }
-                    
-                    if (raytracing_enabled)
+                }
+                if (enable_ambient_occlusion)
+                {
+                    float ao_radius = render_pipeline->getRayTracingAmbientOcclusionRadius();
+                    if (ImGui::SliderFloat("AO Radius", &ao_radius, 0.1f, 5.0f, "%.2f"))
                     {
-                        ImGui::Spacing();
-                        
-                        // 1. Effects (Common)
-                        static bool enable_reflections = true;
-                        static bool enable_shadows = true;
-                        static bool enable_global_illumination = false;
-                        
-                        ImGui::Text("Effects:");
-                        ImGui::Checkbox("Reflections", &enable_reflections);
-                        ImGui::SameLine();
-                        ImGui::Checkbox("Shadows", &enable_shadows);
-                        ImGui::SameLine();
-                        ImGui::Checkbox("GI", &enable_global_illumination);
-                        
-                        ImGui::Spacing();
-                        
-                        // 2. Quality Presets (Common)
-                        ImGui::Text("Quality:");
-                        static int max_ray_depth = 5;
-                        static int samples_per_pixel = 1;
-                        static float resolution_scale = 1.0f;
-
-                        if (ImGui::Button("Low")) { max_ray_depth = 3; samples_per_pixel = 1; resolution_scale = 0.5f; }
-                        ImGui::SameLine();
-                        if (ImGui::Button("Med")) { max_ray_depth = 5; samples_per_pixel = 2; resolution_scale = 0.75f; }
-                        ImGui::SameLine();
-                        if (ImGui::Button("High")) { max_ray_depth = 8; samples_per_pixel = 4; resolution_scale = 1.0f; }
-                        ImGui::SameLine();
-                        if (ImGui::Button("Ultra")) { max_ray_depth = 10; samples_per_pixel = 8; resolution_scale = 1.0f; }
-                        
-                        ImGui::Spacing();
-                        
-                        // 3. Advanced Parameters (Folded)
-                        if (ImGui::TreeNode("Advanced Parameters"))
-                        {
-                            ImGui::Text("Max Ray Depth:");
-                            ImGui::SliderInt("##MaxRayDepth", &max_ray_depth, 1, 10);
-                            
-                            ImGui::Text("Samples Per Pixel:");
-                            ImGui::SliderInt("##SamplesPerPixel", &samples_per_pixel, 1, 16);
-                            
-                            ImGui::Text("Resolution Scale:");
-                            ImGui::SliderFloat("##ResolutionScale", &resolution_scale, 0.25f, 2.0f, "%.2fx");
-                            
-                            ImGui::Separator();
-                            
-                            static int render_mode = 0;
-                            const char* render_modes[] = { "Hybrid", "Pure RT", "Raster Only" };
-                            ImGui::Combo("Render Mode", &render_mode, render_modes, IM_ARRAYSIZE(render_modes));
-                            
-                            ImGui::TreePop();
-                        }
-                        
-                        // 4. Demo Scenes (Folded)
-                        if (ImGui::TreeNode("Demo Scenes"))
-                        {
-                             if (ImGui::Button("Load RT Demo Scene", ImVec2(-1, 0)))
-                             {
-                                 loadRayTracingDemoScene();
-                             }
-                             if (ImGui::Button("Reset Scene", ImVec2(-1, 0)))
-                             {
-                                 resetToDefaultScene();
-                             }
-                             ImGui::TreePop();
-                        }
+                        render_pipeline->setRayTracingAmbientOcclusionRadius(ao_radius);
                     }
-                    else
+                }
+                
+                ImGui::Spacing();
+                
+                // SVGF降噪：启用时光线追踪通道关闭渐进累积，改由降噪器维护时域历史
+                ImGui::Text("Denoise:");
+                bool enable_denoise = render_pipeline->isRayTracingDenoiseEnabled();
+                if (ImGui::Checkbox("SVGF Denoise", &enable_denoise))
+                {
+                    render_pipeline->setRayTracingDenoiseEnabled(enable_denoise);
+                }
+                if (enable_denoise)
+                {
+                    int atrous_iterations = static_cast<int>(render_pipeline->getRayTracingDenoiseIterations());
+                    if (ImGui::SliderInt("A-Trous Iterations", &atrous_iterations, 1, 5))
                     {
-                        ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "RT is disabled.");
+                        render_pipeline->setRayTracingDenoiseIterations(static_cast<uint32_t>(atrous_iterations));
                     }
                 }
+                
+                ImGui::Spacing();
+                
+                // 2. Quality Presets (Common)
+                ImGui::Text("Quality:");
+                static int max_ray_depth = 5;
+                static int samples_per_pixel = 1;
+
+                if (ImGui::Button("Low")) { max_ray_depth = 3; samples_per_pixel = 1; render_pipeline->setRayTracingRenderScale(0.5f); }
+                ImGui::SameLine();
+                if (ImGui::Button("Med")) { max_ray_depth = 5; samples_per_pixel = 2; render_pipeline->setRayTracingRenderScale(0.75f); }
+                ImGui::SameLine();
+                if (ImGui::Button("High")) { max_ray_depth = 8; samples_per_pixel = 4; render_pipeline->setRayTracingRenderScale(1.0f); }
+                ImGui::SameLine();
+                if (ImGui::Button("Ultra")) { max_ray_depth = 10; samples_per_pixel = 8; render_pipeline->setRayTracingRenderScale(1.0f); }
+                
+                // 输出分辨率缩放：在下一帧开始时重建光线追踪输出，合成时放大到视口
+                float render_scale = render_pipeline->getRayTracingRenderScale();
+                if (ImGui::SliderFloat("Render Scale", &render_scale, 0.5f, 1.0f, "%.2fx"))
+                {
+                    render_pipeline->setRayTracingRenderScale(render_scale);
+                }
+                ImGui::SameLine();
+                // 棋盘格渲染：每帧只追踪一半像素，其余由重建通道补全
+                bool enable_checkerboard = render_pipeline->isRayTracingCheckerboardEnabled();
+                if (ImGui::Checkbox("Checkerboard", &enable_checkerboard))
+                {
+                    render_pipeline->setRayTracingCheckerboardEnabled(enable_checkerboard);
+                }
+                
+                ImGui::Spacing();
+                
+                // 3. Advanced Parameters (Folded)
+                if (ImGui::TreeNode("Advanced Parameters"))
+                {
+                    ImGui::Text("Max Ray Depth:");
+                    ImGui::SliderInt("##MaxRayDepth", &max_ray_depth, 1, 10);
+                    
+                    ImGui::Text("Samples Per Pixel:");
+                    ImGui::SliderInt("##SamplesPerPixel", &samples_per_pixel, 1, 16);
+                    
+                    ImGui::Separator();
+                    
+                    static int render_mode = 0;
+                    const char* render_modes[] = { "Hybrid", "Pure RT", "Raster Only" };
+                    ImGui::Combo("Render Mode", &render_mode, render_modes, IM_ARRAYSIZE(render_modes));
+                    
+                    ImGui::TreePop();
+                }
+                
+                // 4. Demo Scenes (Folded)
+                if (ImGui::TreeNode("Demo Scenes"))
+                {
+                     if (ImGui::Button("Load RT Demo Scene", ImVec2(-1, 0)))
+                     {
+                         loadRayTracingDemoScene();
+                     }
+                     if (ImGui::Button("Reset Scene", ImVec2(-1, 0)))
+                     {
+                         resetToDefaultScene();
+                     }
+                     ImGui::TreePop();
+                }
+            }
+            else
+            {
+                ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "RT is disabled.");
             }
             ImGui::Unindent(10.0f);
         }
@@ -1499,113 +1578,150 @@ namespace Elish
         // 应用场景对象
         if (scene_config["objects"].is_array())
         {
-            for (const auto& obj_json : scene_config["objects"].array_items())
+            const auto& objects = scene_config["objects"].array_items();
+
+            // 文件中的对象下标 -> addRenderObject返回的索引，跳过或加载失败的对象为-1
+            std::vector<int> loaded_indices(objects.size(), -1);
+            // (已加载对象的索引, 文件中的父对象下标)，全部加载后再映射
+            std::vector<std::pair<size_t, int>> parent_links;
+
+            // 整批加载结束后只重算一次场景图；加载抛出异常时也要结束批量
+            m_render_resource->beginRenderObjectBatch();
+            try
             {
-                std::string name = obj_json["name"].string_value();
-                std::string type = obj_json["type"].string_value();
-                std::string model_path = obj_json["model_path"].string_value();
-                if (model_path.empty())
+                for (size_t file_index = 0; file_index < objects.size(); ++file_index)
                 {
-                    // 尝试兼容 levels1.json 的 model_paths 字段
-                    model_path = obj_json["model_paths"].string_value();
-                }
+                    const auto& obj_json = objects[file_index];
+                    std::string name = obj_json["name"].string_value();
+                    std::string type = obj_json["type"].string_value();
+                    std::string model_path = obj_json["model_path"].string_value();
+                    if (model_path.empty())
+                    {
+                        // 尝试兼容 levels1.json 的 model_paths 字段
+                        model_path = obj_json["model_paths"].string_value();
+                    }
                 
-                // 如果没有指定路径，尝试根据类型推断
-                if (model_path.empty() && !type.empty())
-                {
-                    model_path = "engine/runtime/content/models/" + type + ".obj";
-                }
+                    // 如果没有指定路径，尝试根据类型推断
+                    if (model_path.empty() && !type.empty())
+                    {
+                        model_path = "engine/runtime/content/models/" + type + ".obj";
+                    }
                 
-                // 如果还是空的，跳过
-                if (model_path.empty()) 
-                {
-                    LOG_WARN("[UIPass] Object '{}' missing model path or type", name);
-                    continue;
-                }
+                    // 如果还是空的，跳过
+                    if (model_path.empty()) 
+                    {
+                        LOG_WARN("[UIPass] Object '{}' missing model path or type", name);
+                        continue;
+                    }
 
-                // 纹理处理
-                std::vector<std::string> texture_paths;
-                if (obj_json["textures"].is_array())
-                {
-                    for (const auto& tex : obj_json["textures"].array_items())
+                    // 纹理处理
+                    std::vector<std::string> texture_paths;
+                    if (obj_json["textures"].is_array())
                     {
-                        texture_paths.push_back(tex.string_value());
+                        for (const auto& tex : obj_json["textures"].array_items())
+                        {
+                            texture_paths.push_back(tex.string_value());
+                        }
                     }
-                }
-                // 兼容 levels1.json 的格式 (model_texture_map)
-                else if (obj_json["model_texture_map"].is_array())
-                {
-                    for (const auto& tex : obj_json["model_texture_map"].array_items())
+                    // 兼容 levels1.json 的格式 (model_texture_map)
+                    else if (obj_json["model_texture_map"].is_array())
                     {
-                        texture_paths.push_back(tex.string_value());
+                        for (const auto& tex : obj_json["model_texture_map"].array_items())
+                        {
+                            texture_paths.push_back(tex.string_value());
+                        }
                     }
-                }
 
-                RenderObject renderObject;
-                renderObject.name = name;
+                    RenderObject renderObject;
+                    renderObject.name = name;
                 
-                // 加载资源
-                // 注意：createRenderObjectResource 需要实现具体的加载逻辑
-                if (m_render_resource->createRenderObjectResource(renderObject, model_path, texture_paths))
-                {
-                    // 应用变换
-                    if (obj_json["transform"].is_object())
+                    // 加载资源
+                    // 注意：createRenderObjectResource 需要实现具体的加载逻辑
+                    if (m_render_resource->createRenderObjectResource(renderObject, model_path, texture_paths))
                     {
-                        const auto& transform = obj_json["transform"];
-                        
-                        // Position
-                        if (transform["position"].is_array())
+                        // 应用变换
+                        if (obj_json["transform"].is_object())
                         {
-                            auto pos = transform["position"].array_items();
-                            if (pos.size() >= 3)
+                            const auto& transform = obj_json["transform"];
+                        
+                            // Position
+                            if (transform["position"].is_array())
                             {
-                                renderObject.animationParams.position = glm::vec3(
-                                    static_cast<float>(pos[0].number_value()), 
-                                    static_cast<float>(pos[1].number_value()), 
-                                    static_cast<float>(pos[2].number_value())
-                                );
+                                auto pos = transform["position"].array_items();
+                                if (pos.size() >= 3)
+                                {
+                                    renderObject.animationParams.position = glm::vec3(
+                                        static_cast<float>(pos[0].number_value()), 
+                                        static_cast<float>(pos[1].number_value()), 
+                                        static_cast<float>(pos[2].number_value())
+                                    );
+                                }
                             }
-                        }
                         
-                        // Rotation
-                        if (transform["rotation"].is_array())
-                        {
-                            auto rot = transform["rotation"].array_items();
-                            if (rot.size() >= 3)
+                            // Rotation
+                            if (transform["rotation"].is_array())
                             {
-                                // 假设 JSON 中的旋转是角度制，转换为弧度
-                                renderObject.animationParams.rotation = glm::vec3(
-                                    glm::radians(static_cast<float>(rot[0].number_value())), 
-                                    glm::radians(static_cast<float>(rot[1].number_value())), 
-                                    glm::radians(static_cast<float>(rot[2].number_value()))
-                                );
+                                auto rot = transform["rotation"].array_items();
+                                if (rot.size() >= 3)
+                                {
+                                    // 假设 JSON 中的旋转是角度制，转换为弧度
+                                    renderObject.animationParams.rotation = glm::vec3(
+                                        glm::radians(static_cast<float>(rot[0].number_value())), 
+                                        glm::radians(static_cast<float>(rot[1].number_value())), 
+                                        glm::radians(static_cast<float>(rot[2].number_value()))
+                                    );
+                                }
                             }
-                        }
                         
-                        // Scale
-                        if (transform["scale"].is_array())
-                        {
-                            auto scale = transform["scale"].array_items();
-                            if (scale.size() >= 3)
+                            // Scale
+                            if (transform["scale"].is_array())
                             {
-                                renderObject.animationParams.scale = glm::vec3(
-                                    static_cast<float>(scale[0].number_value()), 
-                                    static_cast<float>(scale[1].number_value()), 
-                                    static_cast<float>(scale[2].number_value())
-                                );
+                                auto scale = transform["scale"].array_items();
+                                if (scale.size() >= 3)
+                                {
+                                    renderObject.animationParams.scale = glm::vec3(
+                                        static_cast<float>(scale[0].number_value()), 
+                                        static_cast<float>(scale[1].number_value()), 
+                                        static_cast<float>(scale[2].number_value())
+                                    );
+                                }
                             }
                         }
-                    }
                     
-                    // 将对象添加到资源管理器
-                    m_render_resource->addRenderObject(renderObject);
-                    LOG_INFO("[UIPass] Loaded object: {}", name);
+                        // 将对象添加到资源管理器，父物体下标指向文件，挂接前先清除
+                        renderObject.animationParams.parentIndex = -1;
+                        size_t object_index = m_render_resource->addRenderObject(renderObject);
+                        loaded_indices[file_index] = static_cast<int>(object_index);
+                        if (obj_json["parent"].is_number())
+                        {
+                            parent_links.emplace_back(object_index, obj_json["parent"].int_value());
+                        }
+                        LOG_INFO("[UIPass] Loaded object: {}", name);
+                    }
+                    else
+                    {
+                        LOG_ERROR("[UIPass] Failed to load model: {}", model_path);
+                    }
                 }
-                else
+            }
+            catch (...)
+            {
+                m_render_resource->endRenderObjectBatch();
+                throw;
+            }
+
+            for (const auto& [object_index, file_parent] : parent_links)
+            {
+                bool parent_in_file = file_parent >= 0 && static_cast<size_t>(file_parent) < objects.size();
+                int parent_index = parent_in_file ? loaded_indices[file_parent] : -1;
+                if (parent_index < 0)
                 {
-                    LOG_ERROR("[UIPass] Failed to load model: {}", model_path);
+                    LOG_WARN("[UIPass] Parent {} of object {} was not loaded, keeping it as a root", file_parent, object_index);
+                    continue;
                 }
+                m_render_resource->setRenderObjectParent(object_index, parent_index);
             }
+            m_render_resource->endRenderObjectBatch();
         }
         
         LOG_INFO("[UIPass] Scene lighting and objects configuration applied");
@@ -0,0 +1,984 @@
+#include "pipeline_cache.h"
+#include "../core/base/macro.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace Elish
+{
+    namespace
+    {
+        // FNV-1a 64位哈希
+        constexpr uint64_t k_fnv_offset_basis = 14695981039346656037ull;
+        constexpr uint64_t k_fnv_prime = 1099511628211ull;
+
+        uint64_t fnv1a(const void* data, size_t size, uint64_t seed = k_fnv_offset_basis)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            uint64_t hash = seed;
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= k_fnv_prime;
+            }
+            return hash;
+        }
+
+        uint64_t hashKey(const std::vector<uint64_t>& key)
+        {
+            return fnv1a(key.data(), key.size() * sizeof(uint64_t));
+        }
+
+        uint64_t pointerKey(const void* pointer)
+        {
+            return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+        }
+
+        uint64_t floatKey(float value)
+        {
+            uint32_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        void appendBytes(const void* data, size_t size, std::vector<uint64_t>& key)
+        {
+            key.push_back(size);
+            key.push_back(data ? fnv1a(data, size) : 0);
+        }
+
+        void appendString(const char* value, std::vector<uint64_t>& key)
+        {
+            appendBytes(value, value ? std::strlen(value) : 0, key);
+        }
+
+        void appendStencilOpKey(const RHIStencilOpState& state, std::vector<uint64_t>& key)
+        {
+            key.push_back(state.failOp);
+            key.push_back(state.passOp);
+            key.push_back(state.depthFailOp);
+            key.push_back(state.compareOp);
+            key.push_back(state.compareMask);
+            key.push_back(state.writeMask);
+            key.push_back(state.reference);
+        }
+
+        // buildGraphicsKey()/buildComputeKey()中绑定点、管线布局与渲染通道句柄所在的位置
+        constexpr size_t k_key_bind_point_slot = 0;
+        constexpr size_t k_key_layout_slot = 2;
+        constexpr size_t k_key_render_pass_slot = 3;
+
+        // 各子状态以“是否存在”标记开头，区分空指针与全零状态
+        constexpr uint64_t k_absent = 0;
+        constexpr uint64_t k_present = 1;
+
+        // 管线编译主要耗在驱动内部，少量后台线程即可避免渲染线程卡顿，不与其他工作争抢核心
+        constexpr uint32_t k_max_compile_workers = 2;
+
+        struct SpecializationCopy
+        {
+            RHISpecializationInfo                   info{};
+            std::vector<RHISpecializationMapEntry>  entries;
+            std::vector<const RHISpecializationMapEntry*> entry_pointers;
+            std::vector<uint8_t>                    data;
+        };
+
+        /**
+         * @brief 创建信息中是否含有无法安全深拷贝的内容
+         * @details pNext扩展链的结构类型未知；采样掩码的字长依赖采样数且后端按原始内存解释，二者均退化为同步创建
+         */
+        bool hasUncopyableState(const RHIGraphicsPipelineCreateInfo& create_info)
+        {
+            if (create_info.pNext)
+            {
+                return true;
+            }
+            for (uint32_t i = 0; i < create_info.stageCount; ++i)
+            {
+                if (create_info.pStages[i].pNext)
+                {
+                    return true;
+                }
+            }
+            return (create_info.pVertexInputState && create_info.pVertexInputState->pNext) ||
+                   (create_info.pInputAssemblyState && create_info.pInputAssemblyState->pNext) ||
+                   (create_info.pTessellationState && create_info.pTessellationState->pNext) ||
+                   (create_info.pViewportState && create_info.pViewportState->pNext) ||
+                   (create_info.pRasterizationState && create_info.pRasterizationState->pNext) ||
+                   (create_info.pMultisampleState && (create_info.pMultisampleState->pNext || create_info.pMultisampleState->pSampleMask)) ||
+                   (create_info.pDepthStencilState && create_info.pDepthStencilState->pNext) ||
+                   (create_info.pColorBlendState && create_info.pColorBlendState->pNext) ||
+                   (create_info.pDynamicState && create_info.pDynamicState->pNext);
+        }
+    } // namespace
+
+    /**
+     * @brief 后台编译任务
+     * @details create_info中的指针全部指向任务自有的存储，入队后不再引用调用方的内存；
+     *          所有容器在取地址前一次性定长，之后不再扩容
+     */
+    struct PipelineCache::GraphicsPipelineJob
+    {
+        uint64_t              hash = 0;
+        std::vector<uint64_t> key;
+        RHIPipeline*          pipeline = nullptr;   // 编译结果，失败为nullptr
+
+        RHIGraphicsPipelineCreateInfo                     create_info{};
+        std::vector<RHIPipelineShaderStageCreateInfo>     stages;
+        std::vector<std::string>                          entry_names;
+        std::vector<SpecializationCopy>                   specializations;
+        RHIPipelineVertexInputStateCreateInfo             vertex_input{};
+        std::vector<RHIVertexInputBindingDescription>     vertex_bindings;
+        std::vector<RHIVertexInputAttributeDescription>   vertex_attributes;
+        RHIPipelineInputAssemblyStateCreateInfo           input_assembly{};
+        RHIPipelineTessellationStateCreateInfo            tessellation{};
+        RHIPipelineViewportStateCreateInfo                viewport_state{};
+        std::vector<RHIViewport>                          viewports;
+        std::vector<RHIRect2D>                            scissors;
+        RHIPipelineRasterizationStateCreateInfo           rasterization{};
+        RHIPipelineMultisampleStateCreateInfo             multisample{};
+        RHIPipelineDepthStencilStateCreateInfo            depth_stencil{};
+        RHIPipelineColorBlendStateCreateInfo              color_blend{};
+        std::vector<RHIPipelineColorBlendAttachmentState> blend_attachments;
+        RHIPipelineDynamicStateCreateInfo                 dynamic_state{};
+        std::vector<RHIDynamicState>                      dynamic_states;
+
+        void copyFrom(const RHIGraphicsPipelineCreateInfo& source);
+    };
+
+    void PipelineCache::GraphicsPipelineJob::copyFrom(const RHIGraphicsPipelineCreateInfo& source)
+    {
+        create_info = source;
+
+        stages.assign(source.pStages, source.pStages + source.stageCount);
+        entry_names.resize(source.stageCount);
+        specializations.resize(source.stageCount);
+        for (uint32_t i = 0; i < source.stageCount; ++i)
+        {
+            RHIPipelineShaderStageCreateInfo& stage = stages[i];
+            entry_names[i] = stage.pName ? stage.pName : "main";
+            stage.pName = entry_names[i].c_str();
+
+            if (const RHISpecializationInfo* specialization = stage.pSpecializationInfo)
+            {
+                SpecializationCopy& copy = specializations[i];
+                copy.entries.resize(specialization->mapEntryCount);
+                copy.entry_pointers.resize(specialization->mapEntryCount);
+                for (uint32_t entry = 0; entry < specialization->mapEntryCount; ++entry)
+                {
+                    copy.entries[entry] = *specialization->pMapEntries[entry];
+                    copy.entry_pointers[entry] = &copy.entries[entry];
+                }
+                const uint8_t* data = static_cast<const uint8_t*>(specialization->pData);
+                copy.data.assign(data, data ? data + specialization->dataSize : data);
+
+                copy.info = *specialization;
+                copy.info.pMapEntries = copy.entry_pointers.data();
+                copy.info.pData = copy.data.data();
+                stage.pSpecializationInfo = &copy.info;
+            }
+        }
+        create_info.pStages = stages.data();
+
+        if (source.pVertexInputState)
+        {
+            vertex_input = *source.pVertexInputState;
+            const RHIVertexInputBindingDescription* bindings = vertex_input.pVertexBindingDescriptions;
+            const RHIVertexInputAttributeDescription* attributes = vertex_input.pVertexAttributeDescriptions;
+            if (bindings)
+            {
+                vertex_bindings.assign(bindings, bindings + vertex_input.vertexBindingDescriptionCount);
+            }
+            if (attributes)
+            {
+                vertex_attributes.assign(attributes, attributes + vertex_input.vertexAttributeDescriptionCount);
+            }
+            vertex_input.pVertexBindingDescriptions = bindings ? vertex_bindings.data() : nullptr;
+            vertex_input.pVertexAttributeDescriptions = attributes ? vertex_attributes.data() : nullptr;
+            create_info.pVertexInputState = &vertex_input;
+        }
+        if (source.pInputAssemblyState)
+        {
+            input_assembly = *source.pInputAssemblyState;
+            create_info.pInputAssemblyState = &input_assembly;
+        }
+        if (source.pTessellationState)
+        {
+            tessellation = *source.pTessellationState;
+            create_info.pTessellationState = &tessellation;
+        }
+        if (source.pViewportState)
+        {
+            viewport_state = *source.pViewportState;
+            if (viewport_state.pViewports)
+            {
+                viewports.assign(viewport_state.pViewports, viewport_state.pViewports + viewport_state.viewportCount);
+                viewport_state.pViewports = viewports.data();
+            }
+            if (viewport_state.pScissors)
+            {
+                scissors.assign(viewport_state.pScissors, viewport_state.pScissors + viewport_state.scissorCount);
+                viewport_state.pScissors = scissors.data();
+            }
+            create_info.pViewportState = &viewport_state;
+        }
+        if (source.pRasterizationState)
+        {
+            rasterization = *source.pRasterizationState;
+            create_info.pRasterizationState = &rasterization;
+        }
+        if (source.pMultisampleState)
+        {
+            multisample = *source.pMultisampleState;
+            create_info.pMultisampleState = &multisample;
+        }
+        if (source.pDepthStencilState)
+        {
+            depth_stencil = *source.pDepthStencilState;
+            create_info.pDepthStencilState = &depth_stencil;
+        }
+        if (source.pColorBlendState)
+        {
+            color_blend = *source.pColorBlendState;
+            if (color_blend.pAttachments)
+            {
+                blend_attachments.assign(color_blend.pAttachments, color_blend.pAttachments + color_blend.attachmentCount);
+                color_blend.pAttachments = blend_attachments.data();
+            }
+            create_info.pColorBlendState = &color_blend;
+        }
+        if (source.pDynamicState)
+        {
+            dynamic_state = *source.pDynamicState;
+            if (dynamic_state.pDynamicStates)
+            {
+                dynamic_states.assign(dynamic_state.pDynamicStates, dynamic_state.pDynamicStates + dynamic_state.dynamicStateCount);
+                dynamic_state.pDynamicStates = dynamic_states.data();
+            }
+            create_info.pDynamicState = &dynamic_state;
+        }
+    }
+
+    PipelineCache::PipelineCache() = default;
+
+    PipelineCache::~PipelineCache()
+    {
+        clear();
+    }
+
+    void PipelineCache::initialize(std::shared_ptr<RHI> rhi)
+    {
+        m_rhi = rhi;
+        m_stats = Stats{};
+    }
+
+    void PipelineCache::clear()
+    {
+        if (!m_rhi)
+        {
+            return;
+        }
+
+        stopCompileWorkers();
+
+        for (auto& bucket : m_pipelines)
+        {
+            for (PipelineEntry& entry : bucket.second)
+            {
+                m_rhi->destroyPipeline(entry.pipeline);
+            }
+        }
+        m_pipelines.clear();
+
+        for (auto& bucket : m_shaders)
+        {
+            for (ShaderEntry& entry : bucket.second)
+            {
+                m_rhi->destroyShaderModule(entry.shader);
+            }
+        }
+        m_shaders.clear();
+        m_shader_hashes.clear();
+
+        m_stats.pipeline_count = 0;
+        m_stats.shader_count = 0;
+        m_stats.pending_compiles = 0;
+        m_rhi.reset();
+    }
+
+    RHIShader* PipelineCache::getShader(const std::vector<unsigned char>& shader_code)
+    {
+        if (!m_rhi || shader_code.empty())
+        {
+            return nullptr;
+        }
+
+        uint64_t code_hash = fnv1a(shader_code.data(), shader_code.size());
+        std::vector<ShaderEntry>& bucket = m_shaders[code_hash];
+        for (const ShaderEntry& entry : bucket)
+        {
+            if (entry.code_size == shader_code.size() &&
+                std::memcmp(entry.code.data(), shader_code.data(), shader_code.size()) == 0)
+            {
+                return entry.shader;
+            }
+        }
+
+        RHIShader* shader = m_rhi->createShaderModule(shader_code);
+        if (!shader)
+        {
+            LOG_ERROR("[PipelineCache] Failed to create shader module ({} bytes)", shader_code.size());
+            return nullptr;
+        }
+
+        std::vector<uint32_t> code((shader_code.size() + sizeof(uint32_t) - 1) / sizeof(uint32_t), 0);
+        std::memcpy(code.data(), shader_code.data(), shader_code.size());
+        bucket.push_back(ShaderEntry{ code_hash, shader_code.size(), std::move(code), shader });
+        m_shader_hashes[shader] = code_hash;
+        ++m_stats.shader_count;
+        return shader;
+    }
+
+    RHIPipeline* PipelineCache::getOrCreateGraphicsPipeline(const RHIGraphicsPipelineCreateInfo& create_info)
+    {
+        if (!m_rhi)
+        {
+            return nullptr;
+        }
+
+        buildGraphicsKey(create_info, m_key_scratch);
+        uint64_t hash = hashKey(m_key_scratch);
+        if (RHIPipeline* pipeline = findPipeline(hash, m_key_scratch))
+        {
+            return pipeline;
+        }
+
+        return createGraphicsPipeline(hash, m_key_scratch, create_info);
+    }
+
+    RHIPipeline* PipelineCache::getOrCreateComputePipeline(const RHIComputePipelineCreateInfo& create_info)
+    {
+        if (!m_rhi)
+        {
+            return nullptr;
+        }
+
+        buildComputeKey(create_info, m_key_scratch);
+        uint64_t hash = hashKey(m_key_scratch);
+        if (RHIPipeline* pipeline = findPipeline(hash, m_key_scratch))
+        {
+            return pipeline;
+        }
+
+        RHIPipeline* pipeline = nullptr;
+        if (m_rhi->createComputePipelines(RHI_NULL_HANDLE, 1, &create_info, pipeline) != RHI_SUCCESS || !pipeline)
+        {
+            LOG_ERROR("[PipelineCache] Failed to create compute pipeline");
+            return nullptr;
+        }
+
+        insertPipeline(hash, m_key_scratch, pipeline);
+        return pipeline;
+    }
+
+    PipelineRequest PipelineCache::requestGraphicsPipeline(const RHIGraphicsPipelineCreateInfo& create_info)
+    {
+        if (!m_rhi)
+        {
+            return 0;
+        }
+
+        PipelineRequest request = ++m_next_request;
+        buildGraphicsKey(create_info, m_key_scratch);
+        uint64_t hash = hashKey(m_key_scratch);
+        if (RHIPipeline* pipeline = findPipeline(hash, m_key_scratch))
+        {
+            m_requests[request] = RequestEntry{ PipelineRequestState::Ready, pipeline };
+            return request;
+        }
+
+        // 相同状态已在后台编译，挂到已有任务上
+        if (PendingEntry* pending = findPending(hash, m_key_scratch))
+        {
+            pending->requests.push_back(request);
+            m_requests[request] = RequestEntry{ PipelineRequestState::Pending, nullptr };
+            return request;
+        }
+
+        if (hasUncopyableState(create_info))
+        {
+            LOG_WARN("[PipelineCache] Graphics pipeline state cannot be copied for background compilation, creating synchronously");
+            RHIPipeline* pipeline = createGraphicsPipeline(hash, m_key_scratch, create_info);
+            m_requests[request] = RequestEntry{ pipeline ? PipelineRequestState::Ready : PipelineRequestState::Failed, pipeline };
+            return request;
+        }
+
+        std::unique_ptr<GraphicsPipelineJob> job = std::make_unique<GraphicsPipelineJob>();
+        job->hash = hash;
+        job->key = m_key_scratch;
+        job->copyFrom(create_info);
+
+        m_pending[hash].push_back(PendingEntry{ m_key_scratch, { request } });
+        m_requests[request] = RequestEntry{ PipelineRequestState::Pending, nullptr };
+        ++m_stats.async_compiles;
+        ++m_stats.pending_compiles;
+
+        startCompileWorkers();
+        {
+            std::lock_guard<std::mutex> lock(m_compile_mutex);
+            m_compile_queue.push_back(std::move(job));
+        }
+        m_compile_cv.notify_one();
+        return request;
+    }
+
+    PipelineRequestState PipelineCache::getRequestState(PipelineRequest request, RHIPipeline*& pipeline) const
+    {
+        pipeline = nullptr;
+        auto it = m_requests.find(request);
+        if (it == m_requests.end())
+        {
+            return PipelineRequestState::Invalid;
+        }
+        pipeline = it->second.pipeline;
+        return it->second.state;
+    }
+
+    void PipelineCache::releaseRequest(PipelineRequest request)
+    {
+        m_requests.erase(request);
+    }
+
+    uint32_t PipelineCache::collectCompletedPipelines()
+    {
+        std::vector<std::unique_ptr<GraphicsPipelineJob>> completed;
+        {
+            std::lock_guard<std::mutex> lock(m_compile_mutex);
+            if (m_compiled_jobs.empty())
+            {
+                return 0;
+            }
+            completed.swap(m_compiled_jobs);
+        }
+
+        uint32_t collected = 0;
+        for (std::unique_ptr<GraphicsPipelineJob>& job : completed)
+        {
+            RHIPipeline* pipeline = job->pipeline;
+            if (pipeline)
+            {
+                // 编译期间同一状态可能已被同步接口创建，保留先入缓存的管线
+                if (RHIPipeline* existing = lookupPipeline(job->hash, job->key))
+                {
+                    m_rhi->destroyPipeline(pipeline);
+                    pipeline = existing;
+                }
+                else
+                {
+                    insertPipeline(job->hash, job->key, pipeline);
+                    ++collected;
+                }
+            }
+            else
+            {
+                ++m_stats.async_failures;
+                LOG_ERROR("[PipelineCache] Background graphics pipeline compilation failed ({:#018x})", job->hash);
+            }
+
+            auto bucket = m_pending.find(job->hash);
+            if (bucket == m_pending.end())
+            {
+                continue;
+            }
+            std::vector<PendingEntry>& entries = bucket->second;
+            for (auto it = entries.begin(); it != entries.end(); ++it)
+            {
+                if (it->key != job->key)
+                {
+                    continue;
+                }
+                for (PipelineRequest request : it->requests)
+                {
+                    auto request_it = m_requests.find(request);
+                    if (request_it != m_requests.end())
+                    {
+                        request_it->second = RequestEntry{ pipeline ? PipelineRequestState::Ready : PipelineRequestState::Failed, pipeline };
+                    }
+                }
+                entries.erase(it);
+                break;
+            }
+            if (entries.empty())
+            {
+                m_pending.erase(bucket);
+            }
+            if (m_stats.pending_compiles > 0)
+            {
+                --m_stats.pending_compiles;
+            }
+        }
+        return collected;
+    }
+
+    void PipelineCache::waitIdle()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_compile_mutex);
+            m_idle_cv.wait(lock, [this] { return m_compile_queue.empty() && m_active_compiles == 0; });
+        }
+        collectCompletedPipelines();
+    }
+
+    uint32_t PipelineCache::releasePipelineLayout(const RHIPipelineLayout* layout)
+    {
+        return layout ? evictPipelines(k_key_layout_slot, pointerKey(layout)) : 0;
+    }
+
+    uint32_t PipelineCache::releaseRenderPass(const RHIRenderPass* render_pass)
+    {
+        return render_pass ? evictPipelines(k_key_render_pass_slot, pointerKey(render_pass)) : 0;
+    }
+
+    /**
+     * @brief 移除并销毁键中指定位置等于handle的管线
+     * @details 后台任务持有句柄的拷贝，先等待其完成并入缓存；渲染通道只出现在图形管线键中。
+     *          仍指向被移除管线的请求置为Invalid
+     */
+    uint32_t PipelineCache::evictPipelines(size_t key_slot, uint64_t handle)
+    {
+        if (!m_rhi)
+        {
+            return 0;
+        }
+        waitIdle();
+
+        const bool graphics_only = key_slot == k_key_render_pass_slot;
+        std::vector<RHIPipeline*> evicted;
+        for (auto bucket = m_pipelines.begin(); bucket != m_pipelines.end();)
+        {
+            std::vector<PipelineEntry>& entries = bucket->second;
+            auto removed = std::remove_if(entries.begin(), entries.end(), [&](const PipelineEntry& entry) {
+                if (entry.key.size() <= key_slot || entry.key[key_slot] != handle ||
+                    (graphics_only && entry.key[k_key_bind_point_slot] != RHI_PIPELINE_BIND_POINT_GRAPHICS))
+                {
+                    return false;
+                }
+                evicted.push_back(entry.pipeline);
+                return true;
+            });
+            entries.erase(removed, entries.end());
+            bucket = entries.empty() ? m_pipelines.erase(bucket) : std::next(bucket);
+        }
+        if (evicted.empty())
+        {
+            return 0;
+        }
+
+        for (auto& request : m_requests)
+        {
+            if (std::find(evicted.begin(), evicted.end(), request.second.pipeline) != evicted.end())
+            {
+                request.second = RequestEntry{ PipelineRequestState::Invalid, nullptr };
+            }
+        }
+        for (RHIPipeline* pipeline : evicted)
+        {
+            m_rhi->destroyPipeline(pipeline);
+        }
+        m_stats.pipeline_count -= static_cast<uint32_t>(evicted.size());
+        LOG_DEBUG("[PipelineCache] Evicted {} pipeline(s) referencing a destroyed handle", evicted.size());
+        return static_cast<uint32_t>(evicted.size());
+    }
+
+    void PipelineCache::startCompileWorkers()
+    {
+        if (!m_compile_workers.empty())
+        {
+            return;
+        }
+
+        uint32_t worker_count = std::clamp(std::thread::hardware_concurrency() / 2, 1u, k_max_compile_workers);
+        m_compile_workers.reserve(worker_count);
+        for (uint32_t i = 0; i < worker_count; ++i)
+        {
+            m_compile_workers.emplace_back(&PipelineCache::compileWorkerLoop, this, m_rhi.get());
+        }
+        LOG_INFO("[PipelineCache] Started {} background pipeline compile thread(s)", worker_count);
+    }
+
+    void PipelineCache::stopCompileWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_compile_mutex);
+            m_stop_workers = true;
+        }
+        m_compile_cv.notify_all();
+        for (std::thread& worker : m_compile_workers)
+        {
+            worker.join();
+        }
+        m_compile_workers.clear();
+        m_stop_workers = false;
+
+        // 线程已退出，尚未并入缓存的结果直接销毁，未开始的任务丢弃
+        for (std::unique_ptr<GraphicsPipelineJob>& job : m_compiled_jobs)
+        {
+            if (job->pipeline)
+            {
+                m_rhi->destroyPipeline(job->pipeline);
+            }
+        }
+        m_compiled_jobs.clear();
+        m_compile_queue.clear();
+        m_pending.clear();
+        m_requests.clear();
+    }
+
+    void PipelineCache::compileWorkerLoop(RHI* rhi)
+    {
+        std::unique_lock<std::mutex> lock(m_compile_mutex);
+        while (true)
+        {
+            m_compile_cv.wait(lock, [this] { return m_stop_workers || !m_compile_queue.empty(); });
+            if (m_stop_workers)
+            {
+                return;
+            }
+
+            std::unique_ptr<GraphicsPipelineJob> job = std::move(m_compile_queue.front());
+            m_compile_queue.pop_front();
+            ++m_active_compiles;
+            lock.unlock();
+
+            RHIPipeline* pipeline = nullptr;
+            if (rhi->createGraphicsPipelines(RHI_NULL_HANDLE, 1, &job->create_info, pipeline) == RHI_SUCCESS)
+            {
+                job->pipeline = pipeline;
+            }
+
+            lock.lock();
+            m_compiled_jobs.push_back(std::move(job));
+            --m_active_compiles;
+            if (m_compile_queue.empty() && m_active_compiles == 0)
+            {
+                m_idle_cv.notify_all();
+            }
+        }
+    }
+
+    RHIPipeline* PipelineCache::createGraphicsPipeline(uint64_t hash, const std::vector<uint64_t>& key, const RHIGraphicsPipelineCreateInfo& create_info)
+    {
+        RHIPipeline* pipeline = nullptr;
+        if (m_rhi->createGraphicsPipelines(RHI_NULL_HANDLE, 1, &create_info, pipeline) != RHI_SUCCESS || !pipeline)
+        {
+            LOG_ERROR("[PipelineCache] Failed to create graphics pipeline");
+            return nullptr;
+        }
+
+        insertPipeline(hash, key, pipeline);
+        return pipeline;
+    }
+
+    PipelineCache::PendingEntry* PipelineCache::findPending(uint64_t hash, const std::vector<uint64_t>& key)
+    {
+        auto it = m_pending.find(hash);
+        if (it == m_pending.end())
+        {
+            return nullptr;
+        }
+        for (PendingEntry& entry : it->second)
+        {
+            if (entry.key == key)
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    RHIPipeline* PipelineCache::lookupPipeline(uint64_t hash, const std::vector<uint64_t>& key) const
+    {
+        auto it = m_pipelines.find(hash);
+        if (it != m_pipelines.end())
+        {
+            for (const PipelineEntry& entry : it->second)
+            {
+                if (entry.key == key)
+                {
+                    return entry.pipeline;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    RHIPipeline* PipelineCache::findPipeline(uint64_t hash, const std::vector<uint64_t>& key)
+    {
+        if (RHIPipeline* pipeline = lookupPipeline(hash, key))
+        {
+            ++m_stats.hits;
+            return pipeline;
+        }
+        ++m_stats.misses;
+        return nullptr;
+    }
+
+    void PipelineCache::insertPipeline(uint64_t hash, const std::vector<uint64_t>& key, RHIPipeline* pipeline)
+    {
+        m_pipelines[hash].push_back(PipelineEntry{ key, pipeline });
+        ++m_stats.pipeline_count;
+        LOG_DEBUG("[PipelineCache] Created pipeline {:#018x} ({} cached, {} hits)", hash, m_stats.pipeline_count, m_stats.hits);
+    }
+
+    void PipelineCache::appendShaderStageKey(const RHIPipelineShaderStageCreateInfo& stage, std::vector<uint64_t>& key) const
+    {
+        key.push_back(stage.flags);
+        key.push_back(stage.stage);
+
+        // 缓存所有的模块按SPIR-V内容参与哈希，外部模块只能按句柄区分
+        auto it = m_shader_hashes.find(stage.module);
+        if (it != m_shader_hashes.end())
+        {
+            key.push_back(k_present);
+            key.push_back(it->second);
+        }
+        else
+        {
+            key.push_back(k_absent);
+            key.push_back(pointerKey(stage.module));
+        }
+        appendString(stage.pName, key);
+
+        const RHISpecializationInfo* specialization = stage.pSpecializationInfo;
+        if (!specialization)
+        {
+            key.push_back(k_absent);
+            return;
+        }
+        key.push_back(k_present);
+        key.push_back(specialization->mapEntryCount);
+        for (uint32_t i = 0; i < specialization->mapEntryCount; ++i)
+        {
+            const RHISpecializationMapEntry* entry = specialization->pMapEntries[i];
+            key.push_back(entry->constantID);
+            key.push_back(entry->offset);
+            key.push_back(entry->size);
+        }
+        appendBytes(specialization->pData, specialization->dataSize, key);
+    }
+
+    void PipelineCache::buildGraphicsKey(const RHIGraphicsPipelineCreateInfo& create_info, std::vector<uint64_t>& key) const
+    {
+        key.clear();
+        key.push_back(RHI_PIPELINE_BIND_POINT_GRAPHICS);
+        key.push_back(create_info.flags);
+        key.push_back(pointerKey(create_info.layout));
+        key.push_back(pointerKey(create_info.renderPass));
+        key.push_back(create_info.subpass);
+
+        key.push_back(create_info.stageCount);
+        for (uint32_t i = 0; i < create_info.stageCount; ++i)
+        {
+            appendShaderStageKey(create_info.pStages[i], key);
+        }
+
+        bool dynamic_viewport = false;
+        bool dynamic_scissor = false;
+        if (const RHIPipelineDynamicStateCreateInfo* dynamic_state = create_info.pDynamicState)
+        {
+            key.push_back(k_present);
+            key.push_back(dynamic_state->dynamicStateCount);
+            for (uint32_t i = 0; i < dynamic_state->dynamicStateCount; ++i)
+            {
+                RHIDynamicState state = dynamic_state->pDynamicStates[i];
+                dynamic_viewport |= state == RHI_DYNAMIC_STATE_VIEWPORT;
+                dynamic_scissor |= state == RHI_DYNAMIC_STATE_SCISSOR;
+                key.push_back(state);
+            }
+        }
+        else
+        {
+            key.push_back(k_absent);
+        }
+
+        if (const RHIPipelineVertexInputStateCreateInfo* vertex_input = create_info.pVertexInputState)
+        {
+            key.push_back(k_present);
+            key.push_back(vertex_input->vertexBindingDescriptionCount);
+            for (uint32_t i = 0; i < vertex_input->vertexBindingDescriptionCount; ++i)
+            {
+                const RHIVertexInputBindingDescription& binding = vertex_input->pVertexBindingDescriptions[i];
+                key.push_back(binding.binding);
+                key.push_back(binding.stride);
+                key.push_back(binding.inputRate);
+            }
+            key.push_back(vertex_input->vertexAttributeDescriptionCount);
+            for (uint32_t i = 0; i < vertex_input->vertexAttributeDescriptionCount; ++i)
+            {
+                const RHIVertexInputAttributeDescription& attribute = vertex_input->pVertexAttributeDescriptions[i];
+                key.push_back(attribute.location);
+                key.push_back(attribute.binding);
+                key.push_back(attribute.format);
+                key.push_back(attribute.offset);
+            }
+        }
+        else
+        {
+            key.push_back(k_absent);
+        }
+
+        if (const RHIPipelineInputAssemblyStateCreateInfo* input_assembly = create_info.pInputAssemblyState)
+        {
+            key.push_back(k_present);
+            key.push_back(input_assembly->topology);
+            key.push_back(input_assembly->primitiveRestartEnable);
+        }
+        else
+        {
+            key.push_back(k_absent);
+        }
+
+        if (const RHIPipelineTessellationStateCreateInfo* tessellation = create_info.pTessellationState)
+        {
+            key.push_back(k_present);
+            key.push_back(tessellation->patchControlPoints);
+        }
+        else
+        {
+            key.push_back(k_absent);
+        }
+
+        if (const RHIPipelineViewportStateCreateInfo* viewport_state = create_info.pViewportState)
+        {
+            key.push_back(k_present);
+            key.push_back(viewport_state->viewportCount);
+            if (!dynamic_viewport && viewport_state->pViewports)
+            {
+                for (uint32_t i = 0; i < viewport_state->viewportCount; ++i)
+                {
+                    const RHIViewport& viewport = viewport_state->pViewports[i];
+                    key.push_back(floatKey(viewport.x));
+                    key.push_back(floatKey(viewport.y));
+                    key.push_back(floatKey(viewport.width));
+                    key.push_back(floatKey(viewport.height));
+                    key.push_back(floatKey(viewport.minDepth));
+                    key.push_back(floatKey(viewport.maxDepth));
+                }
+            }
+            key.push_back(viewport_state->scissorCount);
+            if (!dynamic_scissor && viewport_state->pScissors)
+            {
+                for (uint32_t i = 0; i < viewport_state->scissorCount; ++i)
+                {
+                    const RHIRect2D& scissor = viewport_state->pScissors[i];
+                    key.push_back(static_cast<uint32_t>(scissor.offset.x));
+                    key.push_back(static_cast<uint32_t>(scissor.offset.y));
+                    key.push_back(scissor.extent.width);
+                    key.push_back(scissor.extent.height);
+                }
+            }
+        }
+        else
+        {
+            key.push_back(k_absent);
+        }
+
+        if (const RHIPipelineRasterizationStateCreateInfo* rasterization = create_info.pRasterizationState)
+        {
+            key.push_back(k_present);
+            key.push_back(rasterization->depthClampEnable);
+            key.push_back(rasterization->rasterizerDiscardEnable);
+            key.push_back(rasterization->polygonMode);
+            key.push_back(rasterization->cullMode);
+            key.push_back(rasterization->frontFace);
+            key.push_back(rasterization->depthBiasEnable);
+            key.push_back(floatKey(rasterization->depthBiasConstantFactor));
+            key.push_back(floatKey(rasterization->depthBiasClamp));
+            key.push_back(floatKey(rasterization->depthBiasSlopeFactor));
+            key.push_back(floatKey(rasterization->lineWidth));
+        }
+        else
+        {
+            key.push_back(k_absent);
+        }
+
+        if (const RHIPipelineMultisampleStateCreateInfo* multisample = create_info.pMultisampleState)
+        {
+            key.push_back(k_present);
+            key.push_back(multisample->rasterizationSamples);
+            key.push_back(multisample->sampleShadingEnable);
+            key.push_back(floatKey(multisample->minSampleShading));
+            key.push_back(multisample->pSampleMask ? pointerKey(*multisample->pSampleMask) : 0);
+            key.push_back(multisample->alphaToCoverageEnable);
+            key.push_back(multisample->alphaToOneEnable);
+        }
+        else
+        {
+            key.push_back(k_absent);
+        }
+
+        if (const RHIPipelineDepthStencilStateCreateInfo* depth_stencil = create_info.pDepthStencilState)
+        {
+            key.push_back(k_present);
+            key.push_back(depth_stencil->depthTestEnable);
+            key.push_back(depth_stencil->depthWriteEnable);
+            key.push_back(depth_stencil->depthCompareOp);
+            key.push_back(depth_stencil->depthBoundsTestEnable);
+            key.push_back(depth_stencil->stencilTestEnable);
+            appendStencilOpKey(depth_stencil->front, key);
+            appendStencilOpKey(depth_stencil->back, key);
+            key.push_back(floatKey(depth_stencil->minDepthBounds));
+            key.push_back(floatKey(depth_stencil->maxDepthBounds));
+        }
+        else
+        {
+            key.push_back(k_absent);
+        }
+
+        if (const RHIPipelineColorBlendStateCreateInfo* color_blend = create_info.pColorBlendState)
+        {
+            key.push_back(k_present);
+            key.push_back(color_blend->logicOpEnable);
+            key.push_back(color_blend->logicOp);
+            key.push_back(color_blend->attachmentCount);
+            for (uint32_t i = 0; i < color_blend->attachmentCount; ++i)
+            {
+                const RHIPipelineColorBlendAttachmentState& attachment = color_blend->pAttachments[i];
+                key.push_back(attachment.blendEnable);
+                key.push_back(attachment.srcColorBlendFactor);
+                key.push_back(attachment.dstColorBlendFactor);
+                key.push_back(attachment.colorBlendOp);
+                key.push_back(attachment.srcAlphaBlendFactor);
+                key.push_back(attachment.dstAlphaBlendFactor);
+                key.push_back(attachment.alphaBlendOp);
+                key.push_back(attachment.colorWriteMask);
+            }
+            for (float constant : color_blend->blendConstants)
+            {
+                key.push_back(floatKey(constant));
+            }
+        }
+        else
+        {
+            key.push_back(k_absent);
+        }
+    }
+
+    void PipelineCache::buildComputeKey(const RHIComputePipelineCreateInfo& create_info, std::vector<uint64_t>& key) const
+    {
+        key.clear();
+        key.push_back(RHI_PIPELINE_BIND_POINT_COMPUTE);
+        key.push_back(create_info.flags);
+        key.push_back(pointerKey(create_info.layout));
+        if (create_info.pStages)
+        {
+            key.push_back(k_present);
+            appendShaderStageKey(*create_info.pStages, key);
+        }
+        else
+        {
+            key.push_back(k_absent);
+        }
+    }
+} // namespace Elish
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "interface/rhi.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Elish
+{
+    /// 异步管线请求句柄，0表示无效
+    using PipelineRequest = uint64_t;
+
+    enum class PipelineRequestState : uint8_t
+    {
+        Invalid,    // 句柄无效或已释放
+        Pending,    // 后台编译中，调用方继续使用旧管线或回退管线
+        Ready,
+        Failed
+    };
+
+    /**
+     * @brief 管线状态对象缓存
+     * @details 以着色器、顶点布局、渲染通道/子通道、管线布局与全部固定功能状态的哈希为键缓存管线，
+     *          命中时直接返回已有管线，不再重复编译；同一缓存也服务于各种变体管线（如光线查询阴影、光线追踪光照）。
+     *          着色器模块由getShader()按SPIR-V内容去重，因此不同通道/场景重新加载时，只要着色器代码和状态相同即可命中。
+     *          缓存返回的管线与着色器模块归缓存所有，调用方不得销毁。
+     *          管线布局与渲染通道按句柄参与哈希，销毁它们之前须调用releasePipelineLayout()/releaseRenderPass()。
+     *          requestGraphicsPipeline()把编译交给后台线程，渲染线程每帧调用collectCompletedPipelines()并入结果，
+     *          编译期间帧内继续使用旧管线或回退管线，新增材质变体不会阻塞当前帧。
+     *          除后台编译线程外，所有接口只允许在渲染线程调用
+     */
+    class PipelineCache
+    {
+    public:
+        PipelineCache();
+        ~PipelineCache();
+
+        PipelineCache(const PipelineCache&) = delete;
+        PipelineCache& operator=(const PipelineCache&) = delete;
+
+        void initialize(std::shared_ptr<RHI> rhi);
+        void clear();
+
+        /**
+         * @brief 按SPIR-V内容获取着色器模块，相同代码只创建一次
+         * @return 创建失败返回nullptr
+         */
+        RHIShader* getShader(const std::vector<unsigned char>& shader_code);
+
+        /**
+         * @brief 查找或创建图形管线
+         * @details 着色器模块若来自getShader()则按内容参与哈希，否则按句柄参与哈希；
+         *          视口/裁剪矩形若声明为动态状态则不参与哈希
+         * @return 创建失败返回nullptr
+         */
+        RHIPipeline* getOrCreateGraphicsPipeline(const RHIGraphicsPipelineCreateInfo& create_info);
+
+        /**
+         * @brief 查找或创建计算管线
+         * @return 创建失败返回nullptr
+         */
+        RHIPipeline* getOrCreateComputePipeline(const RHIComputePipelineCreateInfo& create_info);
+
+        /**
+         * @brief 异步请求图形管线
+         * @details 命中缓存时请求立即就绪；否则深拷贝创建信息交给后台编译线程，调用方无需保留create_info。
+         *          相同状态的并发请求共用一次编译；带pNext扩展链或采样掩码的创建信息无法安全深拷贝，退化为同步创建
+         * @return 请求句柄，缓存未初始化时返回0
+         */
+        PipelineRequest requestGraphicsPipeline(const RHIGraphicsPipelineCreateInfo& create_info);
+
+        /**
+         * @brief 查询异步请求状态
+         * @param pipeline 就绪时输出管线（归缓存所有），否则输出nullptr
+         */
+        PipelineRequestState getRequestState(PipelineRequest request, RHIPipeline*& pipeline) const;
+
+        /**
+         * @brief 释放请求句柄，不影响缓存中的管线；未完成的编译照常进行，结果仍并入缓存
+         */
+        void releaseRequest(PipelineRequest request);
+
+        /**
+         * @brief 把后台已编译完成的管线并入缓存并更新对应请求，每帧在渲染线程调用一次，不阻塞
+         * @return 本次并入的管线数量
+         */
+        uint32_t collectCompletedPipelines();
+
+        /**
+         * @brief 阻塞等待全部后台编译完成并并入缓存
+         * @details 销毁待编译请求引用的管线布局或渲染通道之前调用
+         */
+        void waitIdle();
+
+        /**
+         * @brief 销毁管线布局之前调用，移除并销毁以该布局创建的缓存管线
+         * @details 布局与渲染通道只能按句柄参与哈希，销毁后新对象可能复用同一地址而误命中旧管线；
+         *          会先等待后台编译完成，调用方需保证GPU已不再使用这些管线
+         * @return 移除的管线数量
+         */
+        uint32_t releasePipelineLayout(const RHIPipelineLayout* layout);
+
+        /**
+         * @brief 销毁渲染通道之前调用，移除并销毁以该渲染通道创建的缓存图形管线，约束同releasePipelineLayout()
+         * @return 移除的管线数量
+         */
+        uint32_t releaseRenderPass(const RHIRenderPass* render_pass);
+
+        struct Stats
+        {
+            uint32_t shader_count = 0;
+            uint32_t pipeline_count = 0;
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t async_compiles = 0;        // 交给后台线程编译的管线数量
+            uint64_t async_failures = 0;
+            uint32_t pending_compiles = 0;      // 尚未并入缓存的后台编译
+        };
+        const Stats& getStats() const { return m_stats; }
+
+    private:
+        struct ShaderEntry
+        {
+            uint64_t              code_hash;
+            size_t                code_size;
+            std::vector<uint32_t> code;         // SPIR-V字，哈希相同时逐字节比较
+            RHIShader*            shader;
+        };
+
+        struct PipelineEntry
+        {
+            std::vector<uint64_t> key;
+            RHIPipeline*          pipeline;
+        };
+
+        struct RequestEntry
+        {
+            PipelineRequestState state;
+            RHIPipeline*         pipeline;
+        };
+
+        struct PendingEntry
+        {
+            std::vector<uint64_t>        key;
+            std::vector<PipelineRequest> requests;     // 等待同一次编译的请求
+        };
+
+        struct GraphicsPipelineJob;     // 深拷贝的创建信息与编译结果，定义见pipeline_cache.cpp
+
+        RHIPipeline* lookupPipeline(uint64_t hash, const std::vector<uint64_t>& key) const;
+        RHIPipeline* findPipeline(uint64_t hash, const std::vector<uint64_t>& key);
+        void insertPipeline(uint64_t hash, const std::vector<uint64_t>& key, RHIPipeline* pipeline);
+        RHIPipeline* createGraphicsPipeline(uint64_t hash, const std::vector<uint64_t>& key, const RHIGraphicsPipelineCreateInfo& create_info);
+        PendingEntry* findPending(uint64_t hash, const std::vector<uint64_t>& key);
+        uint32_t evictPipelines(size_t key_slot, uint64_t handle);
+
+        void startCompileWorkers();
+        void stopCompileWorkers();
+        void compileWorkerLoop(RHI* rhi);
+
+        void appendShaderStageKey(const RHIPipelineShaderStageCreateInfo& stage, std::vector<uint64_t>& key) const;
+        void buildGraphicsKey(const RHIGraphicsPipelineCreateInfo& create_info, std::vector<uint64_t>& key) const;
+        void buildComputeKey(const RHIComputePipelineCreateInfo& create_info, std::vector<uint64_t>& key) const;
+
+        std::shared_ptr<RHI> m_rhi;
+
+        std::unordered_map<uint64_t, std::vector<ShaderEntry>> m_shaders;        // SPIR-V哈希 -> 着色器模块
+        std::unordered_map<const RHIShader*, uint64_t>         m_shader_hashes;  // 缓存所有的模块 -> SPIR-V哈希
+        std::unordered_map<uint64_t, std::vector<PipelineEntry>> m_pipelines;    // 状态哈希 -> 管线
+
+        std::unordered_map<PipelineRequest, RequestEntry>        m_requests;
+        std::unordered_map<uint64_t, std::vector<PendingEntry>>  m_pending;    // 状态哈希 -> 后台编译中的管线
+        PipelineRequest                                          m_next_request = 0;
+
+        // 以下成员在渲染线程与后台编译线程之间共享，均由m_compile_mutex保护
+        std::vector<std::thread>                          m_compile_workers;
+        std::mutex                                        m_compile_mutex;
+        std::condition_variable                           m_compile_cv;
+        std::condition_variable                           m_idle_cv;
+        std::deque<std::unique_ptr<GraphicsPipelineJob>>  m_compile_queue;
+        std::vector<std::unique_ptr<GraphicsPipelineJob>> m_compiled_jobs;
+        uint32_t                                          m_active_compiles = 0;
+        bool                                              m_stop_workers = false;
+
+        std::vector<uint64_t> m_key_scratch;
+        Stats                 m_stats;
+    };
+} // namespace Elish
@@ -1,6 +1,10 @@
 #include "render_pass.h"
+#include "descriptor_allocator.h"
+#include "../core/base/macro.h"
 #include <spdlog/spdlog.h>
 
+#include <stdexcept>
+
 namespace Elish
 {
     void RenderPass::initialize()
@@ -11,4 +15,121 @@ namespace Elish
     {
 
     }
-} // namespace Elish
\ No newline at end of file
+
+    void RenderPass::waitForGpuIdle() const
+    {
+        m_rhi->waitForFences();
+        if (auto graphics_queue = m_rhi->getGraphicsQueue())
+        {
+            m_rhi->queueWaitIdle(graphics_queue);
+        }
+    }
+
+    bool RenderPass::runSetupStep(const char* log_tag, const char* failure_message, const std::function<void()>& step) const
+    {
+        try
+        {
+            step();
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR("{} {}: {}", log_tag, failure_message, e.what());
+            return false;
+        }
+    }
+
+    void RenderPass::createStorageImage(uint32_t width, uint32_t height, RHIFormat format, RHIImageUsageFlags usage,
+                                        RHIImage*& image, RHIImageView*& image_view, RHIDeviceMemory*& image_memory)
+    {
+        destroyStorageImage(image, image_view, image_memory);
+
+        RHIImageCreateInfo image_create_info{};
+        image_create_info.sType = RHI_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        image_create_info.imageType = RHI_IMAGE_TYPE_2D;
+        image_create_info.extent.width = width;
+        image_create_info.extent.height = height;
+        image_create_info.extent.depth = 1;
+        image_create_info.mipLevels = 1;
+        image_create_info.arrayLayers = 1;
+        image_create_info.format = format;
+        image_create_info.tiling = RHI_IMAGE_TILING_OPTIMAL;
+        image_create_info.initialLayout = RHI_IMAGE_LAYOUT_UNDEFINED;
+        image_create_info.usage = usage;
+        image_create_info.samples = RHI_SAMPLE_COUNT_1_BIT;
+        image_create_info.sharingMode = RHI_SHARING_MODE_EXCLUSIVE;
+
+        if (m_rhi->createImage(&image_create_info, image) != RHI_SUCCESS)
+        {
+            throw std::runtime_error("[RenderPass] Failed to create storage image");
+        }
+
+        RHIMemoryRequirements mem_requirements;
+        m_rhi->getImageMemoryRequirements(image, &mem_requirements);
+
+        RHIMemoryAllocateInfo alloc_info{};
+        alloc_info.sType = RHI_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc_info.allocationSize = mem_requirements.size;
+        alloc_info.memoryTypeIndex = m_rhi->findMemoryType(mem_requirements.memoryTypeBits, RHI_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        if (m_rhi->allocateMemory(&alloc_info, image_memory) != RHI_SUCCESS)
+        {
+            throw std::runtime_error("[RenderPass] Failed to allocate storage image memory");
+        }
+
+        m_rhi->bindImageMemory(image, image_memory, 0);
+
+        RHIImageViewCreateInfo view_create_info{};
+        view_create_info.sType = RHI_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        view_create_info.image = image;
+        view_create_info.viewType = RHI_IMAGE_VIEW_TYPE_2D;
+        view_create_info.format = format;
+        view_create_info.subresourceRange.aspectMask = RHI_IMAGE_ASPECT_COLOR_BIT;
+        view_create_info.subresourceRange.baseMipLevel = 0;
+        view_create_info.subresourceRange.levelCount = 1;
+        view_create_info.subresourceRange.baseArrayLayer = 0;
+        view_create_info.subresourceRange.layerCount = 1;
+
+        if (m_rhi->createImageView(&view_create_info, image_view) != RHI_SUCCESS)
+        {
+            throw std::runtime_error("[RenderPass] Failed to create storage image view");
+        }
+    }
+
+    void RenderPass::createStorageImage(uint32_t width, uint32_t height, RHIFormat format, RHIImageUsageFlags usage,
+                                        FrameBufferAttachment& attachment)
+    {
+        attachment.format = format;
+        createStorageImage(width, height, format, usage, attachment.image, attachment.view, attachment.mem);
+    }
+
+    void RenderPass::destroyStorageImage(RHIImage*& image, RHIImageView*& image_view, RHIDeviceMemory*& image_memory)
+    {
+        if (image_view)
+        {
+            m_rhi->destroyImageView(image_view);
+            image_view = nullptr;
+
+            // 新视图可能复用该地址，按句柄缓存的描述符集全部失效
+            if (m_descriptor_allocator)
+            {
+                m_descriptor_allocator->invalidateCache();
+            }
+        }
+        if (image)
+        {
+            m_rhi->destroyImage(image);
+            image = nullptr;
+        }
+        if (image_memory)
+        {
+            m_rhi->freeMemory(image_memory);
+            image_memory = nullptr;
+        }
+    }
+
+    void RenderPass::destroyStorageImage(FrameBufferAttachment& attachment)
+    {
+        destroyStorageImage(attachment.image, attachment.view, attachment.mem);
+    }
+} // namespace Elish
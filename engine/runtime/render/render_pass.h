@@ -7,6 +7,7 @@
 
 #include <vulkan/vulkan.h>
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -99,6 +100,34 @@ namespace Elish
 
         static VisiableNodes m_visiable_nodes;
 
+    protected:
+        /**
+         * @brief 等待在途帧与图形队列完成，销毁或重建GPU可能仍在引用的资源前调用
+         */
+        void waitForGpuIdle() const;
+
+        /**
+         * @brief 执行可能抛出异常的创建步骤，失败时记录"<log_tag> <failure_message>: <原因>"
+         * @return 步骤完整执行返回true
+         */
+        bool runSetupStep(const char* log_tag, const char* failure_message, const std::function<void()>& step) const;
+
+        /**
+         * @brief 创建单层、单mip、设备本地内存的二维存储图像及其视图，失败时抛出std::runtime_error
+         * @details 传入的句柄非空时先销毁，可直接用于按新尺寸重建
+         */
+        void createStorageImage(uint32_t width, uint32_t height, RHIFormat format, RHIImageUsageFlags usage,
+                                RHIImage*& image, RHIImageView*& image_view, RHIDeviceMemory*& image_memory);
+        void createStorageImage(uint32_t width, uint32_t height, RHIFormat format, RHIImageUsageFlags usage,
+                                FrameBufferAttachment& attachment);
+
+        /**
+         * @brief 销毁图像视图、图像与内存并置空句柄，空句柄直接跳过
+         * @details 销毁视图时使描述符分配器的缓存失效（缓存按句柄地址查找）
+         */
+        void destroyStorageImage(RHIImage*& image, RHIImageView*& image_view, RHIDeviceMemory*& image_memory);
+        void destroyStorageImage(FrameBufferAttachment& attachment);
+
     private:
     };
 } // namespace Elish
@@ -8,6 +8,8 @@ namespace Elish
     void RenderPassBase::setCommonInfo(RenderPassCommonInfo common_info)
     {
         m_rhi = common_info.rhi;
+        m_descriptor_allocator = common_info.descriptor_allocator;
+        m_pipeline_cache = common_info.pipeline_cache;
     }
     
     void RenderPassBase::preparePassData(std::shared_ptr<RenderResource> render_resource)
@@ -7,6 +7,8 @@ namespace Elish
 {
     class RHI;
     class RenderResource;
+    class DescriptorAllocator;
+    class PipelineCache;
 
     struct RenderPassInitInfo
     {};
@@ -14,6 +16,8 @@ namespace Elish
     struct RenderPassCommonInfo
     {
         std::shared_ptr<RHI>                rhi;
+        std::shared_ptr<DescriptorAllocator> descriptor_allocator;
+        std::shared_ptr<PipelineCache>      pipeline_cache;
     };
 
     class RenderPassBase
@@ -31,5 +35,7 @@ namespace Elish
 
     protected:
         std::shared_ptr<RHI>                m_rhi;
+        std::shared_ptr<DescriptorAllocator> m_descriptor_allocator;
+        std::shared_ptr<PipelineCache>      m_pipeline_cache;
     };
 } // namespace Elish
@@ -6,50 +6,117 @@
 #include "passes/directional_light_pass.h"
 #include "passes/raytracing_pass.h"
 #include "render_pass_base.h"
+#include "descriptor_allocator.h"
+#include "pipeline_cache.h"
 #include "../core/base/macro.h"
 #include <iostream>
+#include <algorithm>
 
 
 namespace Elish
 {
      // RT任务监控辅助方法实现
-    void RenderPipeline::RTTaskMonitor::begin()
+    void RenderPipeline::RTTaskMonitor::recordResult(bool success, uint64_t now_ms)
     {
-        running = true;
-        completed = false;
-        auto now = std::chrono::high_resolution_clock::now();
-        start_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
-    }
-
-    void RenderPipeline::RTTaskMonitor::finish(bool success)
-    {
-        auto now = std::chrono::high_resolution_clock::now();
-        end_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
-        last_duration_ms = end_ms - start_ms;
-        running = false;
-        completed = true;
         if (success) {
             success_count++;
+            return;
+        }
+        failure_count++;
+        last_error_timestamp_ms = now_ms;
+        if (window_start_ms == 0 || (now_ms - window_start_ms) > 60000) {
+            window_start_ms = now_ms;
+            error_count_window = 1;
         } else {
-            failure_count++;
-            last_error_timestamp_ms = end_ms;
-            if (window_start_ms == 0 || (end_ms - window_start_ms) > 60000) {
-                window_start_ms = end_ms;
-                error_count_window = 1;
-            } else {
-                error_count_window++;
+            error_count_window++;
+        }
+    }
+
+    void RenderPipeline::RTTaskMonitor::submit(uint32_t slot, uint64_t now_ms)
+    {
+        if (slot >= slots.size()) {
+            slots.resize(slot + 1);
+        }
+        slots[slot].pending = true;
+        slots[slot].timeout_reported = false;
+        slots[slot].submit_ms = now_ms;
+    }
+
+    void RenderPipeline::RTTaskMonitor::resolve(uint32_t slot, double gpu_duration_ms)
+    {
+        slots[slot].pending = false;
+        last_gpu_duration_ms = gpu_duration_ms;
+    }
+
+    bool RenderPipeline::RTTaskMonitor::isTimeout(uint32_t slot, uint64_t now_ms) const
+    {
+        return slot < slots.size() && slots[slot].pending && (now_ms - slots[slot].submit_ms) > timeout_threshold_ms;
+    }
+
+    /**
+     * @brief 非阻塞回读RT时间戳查询
+     * @details 查询结果不可用时不等待，仅在提交后超过阈值仍未完成时报告超时
+     */
+    void RenderPipeline::pollRayTracingGpuQueries(RHI* rhi)
+    {
+        auto now_ms = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+
+        for (uint32_t slot = 0; slot < m_rt_monitor.slots.size(); ++slot)
+        {
+            auto& query_slot = m_rt_monitor.slots[slot];
+            if (!query_slot.pending) {
+                continue;
+            }
+
+            uint64_t timestamps_ns[2] = {};
+            if (rhi->getGpuTimestampsNs(slot * 2, 2, timestamps_ns))
+            {
+                double gpu_ms = static_cast<double>(timestamps_ns[1] - timestamps_ns[0]) / 1.0e6;
+                m_rt_monitor.resolve(slot, gpu_ms);
+                if (gpu_ms > static_cast<double>(m_rt_monitor.timeout_threshold_ms)) {
+                    m_rt_monitor.timeout_count++;
+                    LOG_ERROR("[RTTask] Timeout detected! gpu duration={:.2f}ms, threshold={}ms", gpu_ms, m_rt_monitor.timeout_threshold_ms);
+                }
+            }
+            else if (m_rt_monitor.isTimeout(slot, now_ms) && !query_slot.timeout_reported)
+            {
+                query_slot.timeout_reported = true;
+                m_rt_monitor.timeout_count++;
+                LOG_ERROR("[RTTask] Timeout detected! GPU work still pending after {}ms, threshold={}ms",
+                          now_ms - query_slot.submit_ms, m_rt_monitor.timeout_threshold_ms);
             }
         }
     }
 
-    bool RenderPipeline::RTTaskMonitor::isTimeout(uint64_t now_ms) const
+    RenderPipeline::~RenderPipeline()
     {
-        return running && (now_ms - start_ms) > timeout_threshold_ms;
+        if (!m_pipeline_cache) {
+            return;
+        }
+
+        // 后台编译线程持有RHI与管线布局句柄，先等其全部完成；通道仍持有缓存的共享指针，这里显式销毁管线
+        m_pipeline_cache->waitIdle();
+        if (m_rhi) {
+            m_rhi->waitForFences();
+            if (auto graphics_queue = m_rhi->getGraphicsQueue()) {
+                m_rhi->queueWaitIdle(graphics_queue);
+            }
+        }
+        m_pipeline_cache->clear();
     }
+
     void RenderPipeline::initialize() 
     {
+        m_descriptor_allocator = std::make_shared<DescriptorAllocator>();
+        m_descriptor_allocator->initialize(m_rhi);
+        m_pipeline_cache = std::make_shared<PipelineCache>();
+        m_pipeline_cache->initialize(m_rhi);
+
         RenderPassCommonInfo pass_common_info;
         pass_common_info.rhi = m_rhi;
+        pass_common_info.descriptor_allocator = m_descriptor_allocator;
+        pass_common_info.pipeline_cache = m_pipeline_cache;
 
         // 初始化方向光阴影渲染通道
         auto shadow_pass = std::make_shared<DirectionalLightShadowPass>();
@@ -85,6 +152,26 @@ namespace Elish
         LOG_DEBUG("[RenderPipeline] Initializing ray tracing pass");
         m_raytracing_pass->initialize();
         LOG_DEBUG("[RenderPipeline] Ray tracing pass initialization completed");
+
+        // 初始化光线追踪降噪通道（默认关闭）
+        m_raytracing_denoise_pass = std::make_shared<RayTracingDenoisePass>();
+        m_raytracing_denoise_pass->setCommonInfo(pass_common_info);
+        m_raytracing_denoise_pass->initialize();
+
+        // 初始化棋盘格重建通道（随光线追踪通道的棋盘格模式启用）
+        m_raytracing_checkerboard_pass = std::make_shared<RayTracingCheckerboardPass>();
+        m_raytracing_checkerboard_pass->setCommonInfo(pass_common_info);
+        m_raytracing_checkerboard_pass->initialize();
+
+        // 初始化光线追踪反射通道（默认关闭，需要光线查询支持）
+        m_raytracing_reflection_pass = std::make_shared<RayTracingReflectionPass>();
+        m_raytracing_reflection_pass->setCommonInfo(pass_common_info);
+        m_raytracing_reflection_pass->initialize();
+
+        // 初始化光线追踪环境遮蔽通道（默认关闭，需要光线查询支持）
+        m_raytracing_ambient_occlusion_pass = std::make_shared<RayTracingAmbientOcclusionPass>();
+        m_raytracing_ambient_occlusion_pass->setCommonInfo(pass_common_info);
+        m_raytracing_ambient_occlusion_pass->initialize();
     }
     void RenderPipeline::forwardRender(std::shared_ptr<RHI> rhi, std::shared_ptr<RenderResource> render_resource)
     {
@@ -95,10 +182,21 @@ namespace Elish
         // vulkan_resource->resetRingBufferOffset(vulkan_rhi->m_current_frame_index);
         vulkan_rhi->waitForFences();
 
+        // 当前飞行帧的GPU工作已完成，回收该帧的瞬时描述符池
+        m_descriptor_allocator->beginFrame(rhi->getCurrentFrameIndex());
+
+        // 非阻塞回收已完成的异步工作（加速结构构建、RT时间戳查询、后台编译的管线）
+        render_resource->releaseCompletedAccelerationStructureBuilds();
+        pollRayTracingGpuQueries(rhi.get());
+        m_pipeline_cache->collectCompletedPipelines();
+
         vulkan_rhi->resetCommandPool();
         
         // 准备渲染上下文，设置当前命令缓冲区
         
+        // 更新场景实体的世界矩阵，本帧各通道共用同一动画时间
+        render_resource->updateSceneTransforms(static_cast<float>(glfwGetTime()));
+
         // 准备Pass数据，包括模型数据和相机矩阵
         m_directional_light_shadow_pass->preparePassData(render_resource);
         m_main_camera_pass->preparePassData(render_resource);
@@ -113,38 +211,126 @@ namespace Elish
             return;
         }
         // 1. 首先执行方向光阴影渲染通道（生成阴影贴图）
-        // LOG_INFO("[RenderPipeline] About to call DirectionalLightShadowPass::draw()");
-        static_cast<DirectionalLightShadowPass*>(m_directional_light_shadow_pass.get())
-        ->draw();
+        //    光线查询阴影生效时阴影贴图不会被采样，整体跳过阴影通道
+        MainCameraPass& main_camera_pass = *(static_cast<MainCameraPass*>(m_main_camera_pass.get()));
+        bool ray_query_shadows_active = main_camera_pass.isRayQueryShadowsActive();
+        bool rt_reflections_active = m_raytracing_reflection_pass && m_raytracing_reflection_pass->isEnabled() &&
+                                     main_camera_pass.isRayTracedLightingSupported() &&
+                                     render_resource->getRayTracingResource().tlas != nullptr;
+        bool rt_ambient_occlusion_active = m_raytracing_ambient_occlusion_pass && m_raytracing_ambient_occlusion_pass->isEnabled() &&
+                                           main_camera_pass.isRayTracedLightingSupported() &&
+                                           render_resource->getRayTracingResource().tlas != nullptr;
+        if (!ray_query_shadows_active)
+        {
+            // LOG_INFO("[RenderPipeline] About to call DirectionalLightShadowPass::draw()");
+            static_cast<DirectionalLightShadowPass*>(m_directional_light_shadow_pass.get())
+            ->draw();
+        }
+        if ((ray_query_shadows_active || rt_reflections_active || rt_ambient_occlusion_active) &&
+            !(m_raytracing_pass && m_raytracing_pass->isRayTracingEnabled()))
+        {
+            // 光线追踪通道关闭时由此处负责刷新动画物体的加速结构
+            if (render_resource->hasAnimatedRenderObjects())
+            {
+                if (render_resource->updateRayTracingAccelerationStructures())
+                {
+                    // 构建在独立提交中执行，片段/计算着色器读取TLAS前需等待构建完成
+                    RHIMemoryBarrier as_barrier{};
+                    as_barrier.sType = RHI_STRUCTURE_TYPE_MEMORY_BARRIER;
+                    as_barrier.srcAccessMask = RHI_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+                    as_barrier.dstAccessMask = RHI_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+                    vulkan_rhi->cmdPipelineBarrier(
+                        vulkan_rhi->getCurrentCommandBuffer(),
+                        RHI_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                        RHI_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                        0, 1, &as_barrier, 0, nullptr, 0, nullptr);
+                }
+            }
+        }
         // LOG_INFO("[RenderPipeline] DirectionalLightShadowPass::draw() completed");
         
         // 2. 执行光线追踪渲染（监控开始/结束）
         if (m_raytracing_pass && m_raytracing_pass->isRayTracingEnabled())
         {
-            m_rt_monitor.begin();
             bool rt_success = true;
+            uint32_t query_slot = vulkan_rhi->getCurrentFrameIndex();
+            bool gpu_timing = vulkan_rhi->isGpuTimestampSupported() &&
+                              (query_slot + 1) * 2 <= vulkan_rhi->getGpuTimestampQueryCount();
             try {
                 RHICommandBuffer* command_buffer = vulkan_rhi->getCurrentCommandBuffer();
-                RHIMemoryBarrier memory_barrier{};
-                memory_barrier.sType = RHI_STRUCTURE_TYPE_MEMORY_BARRIER;
-                memory_barrier.srcAccessMask = RHI_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | RHI_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-                memory_barrier.dstAccessMask = RHI_ACCESS_SHADER_READ_BIT | RHI_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
-                vulkan_rhi->cmdPipelineBarrier(
-                    command_buffer,
-                    RHI_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | RHI_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
-                    RHI_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
-                    0,
-                    1, &memory_barrier,
-                    0, nullptr,
-                    0, nullptr
-                );
-                // LOG_DEBUG("[RenderPipeline] Memory barrier added before ray tracing");
 
                 // LOG_DEBUG("[RenderPipeline] About to call preparePassData for ray tracing");
+                // 动画物体的加速结构在此异步提交，不阻塞CPU
                 m_raytracing_pass->preparePassData(render_resource);
+
+                // 等待光栅化写入与（可能的）异步加速结构构建完成后再开始追踪
+                // 软件回退只通过传输命令写入输出图像，屏障由光线追踪通道自行录制
+                if (!m_raytracing_pass->isSoftwareFallback())
+                {
+                    RHIMemoryBarrier memory_barrier{};
+                    memory_barrier.sType = RHI_STRUCTURE_TYPE_MEMORY_BARRIER;
+                    memory_barrier.srcAccessMask = RHI_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | RHI_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                                   RHI_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+                    memory_barrier.dstAccessMask = RHI_ACCESS_SHADER_READ_BIT | RHI_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+                    vulkan_rhi->cmdPipelineBarrier(
+                        command_buffer,
+                        RHI_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | RHI_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+                        RHI_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                        RHI_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+                        0,
+                        1, &memory_barrier,
+                        0, nullptr,
+                        0, nullptr
+                    );
+                }
+                // LOG_DEBUG("[RenderPipeline] Memory barrier added before ray tracing");
+
+                // GPU时间戳包围光线追踪与降噪，结果在之后的帧中非阻塞回读
+                if (gpu_timing)
+                {
+                    vulkan_rhi->cmdResetGpuTimestamps(command_buffer, query_slot * 2, 2);
+                    vulkan_rhi->cmdWriteGpuTimestamp(command_buffer, RHI_PIPELINE_STAGE_TOP_OF_PIPE_BIT, query_slot * 2);
+                }
+
                 // LOG_DEBUG("[RenderPipeline] preparePassData completed, about to call drawRayTracing");
                 m_raytracing_pass->drawRayTracing(vulkan_rhi->m_current_swapchain_image_index);
                 // LOG_DEBUG("[RenderPipeline] drawRayTracing completed successfully");
+
+                // 棋盘格模式：补全本帧未追踪的像素及其G-Buffer，之后的降噪与合成看到的是完整图像
+                if (m_raytracing_checkerboard_pass && m_raytracing_pass->isCheckerboardEnabled() &&
+                    m_raytracing_pass->didLastFrameTrace() && !m_raytracing_pass->isSoftwareFallback())
+                {
+                    m_raytracing_checkerboard_pass->preparePassData(render_resource);
+                    m_raytracing_checkerboard_pass->setInputImages(
+                        m_raytracing_pass->getOutputImageView(),
+                        m_raytracing_pass->getGBufferPositionImageView(),
+                        m_raytracing_pass->getGBufferNormalImageView(),
+                        m_raytracing_pass->getGBufferAlbedoImageView(),
+                        m_raytracing_pass->getOutputWidth(),
+                        m_raytracing_pass->getOutputHeight());
+                    m_raytracing_checkerboard_pass->draw(command_buffer, m_raytracing_pass->getCheckerboardParity());
+                }
+
+                // 对本帧光线追踪输出执行SVGF降噪（原地写回输出图像）
+                // 软件回退不生成G-Buffer，跳过降噪
+                if (m_raytracing_denoise_pass && m_raytracing_denoise_pass->isEnabled() && m_raytracing_pass->didLastFrameTrace() &&
+                    !m_raytracing_pass->isSoftwareFallback())
+                {
+                    m_raytracing_denoise_pass->preparePassData(render_resource);
+                    m_raytracing_denoise_pass->setInputImages(
+                        m_raytracing_pass->getOutputImageView(),
+                        m_raytracing_pass->getGBufferPositionImageView(),
+                        m_raytracing_pass->getGBufferNormalImageView(),
+                        m_raytracing_pass->getGBufferAlbedoImageView(),
+                        m_raytracing_pass->getOutputWidth(),
+                        m_raytracing_pass->getOutputHeight());
+                    m_raytracing_denoise_pass->draw(command_buffer);
+                }
+
+                if (gpu_timing)
+                {
+                    vulkan_rhi->cmdWriteGpuTimestamp(command_buffer, RHI_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, query_slot * 2 + 1);
+                }
             } catch (const std::exception& e) {
                 rt_success = false;
                 LOG_ERROR("[RTTask] Exception during ray tracing: {}", e.what());
@@ -152,13 +338,13 @@ namespace Elish
                 rt_success = false;
                 LOG_ERROR("[RTTask] Unknown exception during ray tracing");
             }
-            m_rt_monitor.finish(rt_success);
 
-            // 超时与频繁异常告警
+            // 录制阶段的异常统计；GPU耗时与超时在之后的帧中由pollRayTracingGpuQueries判定
             auto now_ms = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
                 std::chrono::high_resolution_clock::now().time_since_epoch()).count();
-            if (m_rt_monitor.isTimeout(now_ms)) {
-                LOG_ERROR("[RTTask] Timeout detected! duration={}ms, threshold={}ms", m_rt_monitor.last_duration_ms, m_rt_monitor.timeout_threshold_ms);
+            m_rt_monitor.recordResult(rt_success, now_ms);
+            if (rt_success && gpu_timing) {
+                m_rt_monitor.submit(query_slot, now_ms);
             }
             if (m_rt_monitor.error_count_window >= 3) {
                 LOG_WARN("[RTTask] Frequent RT errors: {} times within 1 minute", m_rt_monitor.error_count_window);
@@ -169,150 +355,61 @@ namespace Elish
             // LOG_DEBUG("[RenderPipeline] Ray tracing disabled or unavailable");
         }
 
-        // 3. 执行主相机渲染（包含UI子通道），确保UI在RT之后
-        MainCameraPass& main_camera_pass = *(static_cast<MainCameraPass*>(m_main_camera_pass.get()));
-        main_camera_pass.drawForward(vulkan_rhi->m_current_swapchain_image_index);
-        
-        // 4. 可选：复制RT输出到交换链（默认关闭，避免覆盖UI）
-        if (m_rt_copy_enabled) {
-            copyRayTracingOutputToSwapchain(rhi, vulkan_rhi->m_current_swapchain_image_index);
-        }
+        // 3. 设置RT输出合成源：本帧实际执行了光线追踪时，在UI子通道中采样其输出并混合到场景视口
+        bool rt_composite = m_rt_composite_enabled && m_raytracing_pass &&
+                            m_raytracing_pass->isRayTracingEnabled() && m_raytracing_pass->didLastFrameTrace();
+        main_camera_pass.setRayTracingCompositeSource(rt_composite ? m_raytracing_pass->getOutputImageView() : nullptr);
 
-        // 注意：UI渲染在主相机渲染通道内作为子通道执行，此顺序确保UI在RT之后
-
-        // 提交渲染命令并释放交换链图像
-        vulkan_rhi->submitRendering([](){});
-    }
-    
-    /**
-     * @brief 将光线追踪输出图像复制到交换链图像
-     * @param rhi RHI接口
-     * @param swapchain_image_index 交换链图像索引
-     */
-    void RenderPipeline::copyRayTracingOutputToSwapchain(std::shared_ptr<RHI> rhi, uint32_t swapchain_image_index)
-    {
-        if (!m_raytracing_pass) {
-            return;
-        }
-        // 若当前帧未执行光线追踪或禁用，则不进行覆盖复制，避免黑图覆盖主渲染与UI
-        if (!m_raytracing_pass->isRayTracingEnabled() || !m_raytracing_pass->didLastFrameTrace())
+        // 4. 半分辨率光线追踪反射与环境遮蔽：以场景视口（上一帧记录，首帧退回交换链尺寸）的一半追踪，主相机通道上采样合成
+        uint32_t half_width = 1;
+        uint32_t half_height = 1;
+        if (rt_reflections_active || rt_ambient_occlusion_active)
         {
-            LOG_DEBUG("[RenderPipeline] Skip RT copy: enabled={}, traced_last_frame={}", m_raytracing_pass->isRayTracingEnabled(), m_raytracing_pass->didLastFrameTrace());
-            return;
+            const RHIViewport& scene_viewport = main_camera_pass.getSceneViewport();
+            uint32_t scene_width = static_cast<uint32_t>(scene_viewport.width);
+            uint32_t scene_height = static_cast<uint32_t>(scene_viewport.height);
+            if (scene_width == 0 || scene_height == 0)
+            {
+                RHISwapChainDesc swapchain_info = vulkan_rhi->getSwapchainInfo();
+                scene_width = swapchain_info.extent.width;
+                scene_height = swapchain_info.extent.height;
+            }
+            half_width = std::max(1u, (scene_width + 1) / 2);
+            half_height = std::max(1u, (scene_height + 1) / 2);
         }
-
-        // 获取光线追踪输出图像与当前交换链图像信息
-        RHIImage* rt_image = m_raytracing_pass->getOutputImage();
-        if (!rt_image)
+        if (rt_reflections_active)
         {
-            LOG_WARN("[RenderPipeline] Ray tracing output image is null; skip copy");
-            return;
+            m_raytracing_reflection_pass->setOutputSize(half_width, half_height);
+            m_raytracing_reflection_pass->preparePassData(render_resource);
+            m_raytracing_reflection_pass->draw(vulkan_rhi->getCurrentCommandBuffer());
+            rt_reflections_active = m_raytracing_reflection_pass->isReady();
         }
-
-        RHISwapChainDesc swap_desc = rhi->getSwapchainInfo();
-
-        RHICommandBuffer* cmd = rhi->getCurrentCommandBuffer();
-        if (!cmd)
+        if (rt_ambient_occlusion_active)
         {
-            LOG_ERROR("[RenderPipeline] Current command buffer is null; skip copy");
-            return;
+            m_raytracing_ambient_occlusion_pass->setOutputSize(half_width, half_height);
+            m_raytracing_ambient_occlusion_pass->preparePassData(render_resource);
+            m_raytracing_ambient_occlusion_pass->draw(vulkan_rhi->getCurrentCommandBuffer());
+            rt_ambient_occlusion_active = m_raytracing_ambient_occlusion_pass->isReady();
         }
+        main_camera_pass.setRayTracingReflectionSource(
+            rt_reflections_active ? m_raytracing_reflection_pass->getReflectionColorView() : nullptr,
+            rt_reflections_active ? m_raytracing_reflection_pass->getReflectionGuideView() : nullptr,
+            m_raytracing_reflection_pass ? m_raytracing_reflection_pass->getRoughnessThreshold() : 0.0f);
+        main_camera_pass.setRayTracingAmbientOcclusionSource(
+            rt_ambient_occlusion_active ? m_raytracing_ambient_occlusion_pass->getAmbientOcclusionView() : nullptr);
 
-        // 准备图像布局转换：确保源为GENERAL、目标为COLOR_ATTACHMENT_OPTIMAL
-        RHIImageMemoryBarrier src_barrier{};
-        src_barrier.sType = RHI_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        src_barrier.oldLayout = RHI_IMAGE_LAYOUT_GENERAL;
-        src_barrier.newLayout = RHI_IMAGE_LAYOUT_GENERAL;
-        src_barrier.srcQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
-        src_barrier.dstQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
-        src_barrier.image = rt_image;
-        src_barrier.subresourceRange.aspectMask = RHI_IMAGE_ASPECT_COLOR_BIT;
-        src_barrier.subresourceRange.baseMipLevel = 0;
-        src_barrier.subresourceRange.levelCount = 1;
-        src_barrier.subresourceRange.baseArrayLayer = 0;
-        src_barrier.subresourceRange.layerCount = 1;
-        src_barrier.srcAccessMask = RHI_ACCESS_SHADER_WRITE_BIT;
-        src_barrier.dstAccessMask = RHI_ACCESS_TRANSFER_READ_BIT;
-
-        rhi->cmdPipelineBarrier(
-            cmd,
-            RHI_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
-            RHI_PIPELINE_STAGE_TRANSFER_BIT,
-            0,
-            0, nullptr,
-            0, nullptr,
-            1, &src_barrier);
-
-        // 包装当前交换链图像为RHIImage以进行拷贝
-        VulkanRHI* vk_rhi = static_cast<VulkanRHI*>(rhi.get());
-        VulkanImage dst_swap_image;
-        dst_swap_image.setResource(vk_rhi->m_swapchain_images[swapchain_image_index]);
-
-        // 将交换链图像转换为传输目标布局
-        RHIImageMemoryBarrier dst_barrier_to_transfer{};
-        dst_barrier_to_transfer.sType = RHI_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        dst_barrier_to_transfer.oldLayout = RHI_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-        dst_barrier_to_transfer.newLayout = RHI_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        dst_barrier_to_transfer.srcQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
-        dst_barrier_to_transfer.dstQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
-        dst_barrier_to_transfer.image = &dst_swap_image;
-        dst_barrier_to_transfer.subresourceRange.aspectMask = RHI_IMAGE_ASPECT_COLOR_BIT;
-        dst_barrier_to_transfer.subresourceRange.baseMipLevel = 0;
-        dst_barrier_to_transfer.subresourceRange.levelCount = 1;
-        dst_barrier_to_transfer.subresourceRange.baseArrayLayer = 0;
-        dst_barrier_to_transfer.subresourceRange.layerCount = 1;
-        dst_barrier_to_transfer.srcAccessMask = RHI_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-        dst_barrier_to_transfer.dstAccessMask = RHI_ACCESS_TRANSFER_WRITE_BIT;
-
-        rhi->cmdPipelineBarrier(
-            cmd,
-            RHI_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-            RHI_PIPELINE_STAGE_TRANSFER_BIT,
-            0,
-            0, nullptr,
-            0, nullptr,
-            1, &dst_barrier_to_transfer);
-
-        // 复制到交换链图像
-        rhi->cmdCopyImageToImage(
-            cmd,
-            rt_image,
-            RHI_IMAGE_ASPECT_COLOR_BIT,
-            &dst_swap_image,
-            RHI_IMAGE_ASPECT_COLOR_BIT,
-            swap_desc.extent.width,
-            swap_desc.extent.height);
-
-        // 将交换链图像恢复为颜色附件布局
-        RHIImageMemoryBarrier dst_barrier_to_color{};
-        dst_barrier_to_color.sType = RHI_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        dst_barrier_to_color.oldLayout = RHI_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        dst_barrier_to_color.newLayout = RHI_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-        dst_barrier_to_color.srcQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
-        dst_barrier_to_color.dstQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
-        dst_barrier_to_color.image = &dst_swap_image;
-        dst_barrier_to_color.subresourceRange.aspectMask = RHI_IMAGE_ASPECT_COLOR_BIT;
-        dst_barrier_to_color.subresourceRange.baseMipLevel = 0;
-        dst_barrier_to_color.subresourceRange.levelCount = 1;
-        dst_barrier_to_color.subresourceRange.baseArrayLayer = 0;
-        dst_barrier_to_color.subresourceRange.layerCount = 1;
-        dst_barrier_to_color.srcAccessMask = RHI_ACCESS_TRANSFER_WRITE_BIT;
-        dst_barrier_to_color.dstAccessMask = RHI_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-
-        rhi->cmdPipelineBarrier(
-            cmd,
-            RHI_PIPELINE_STAGE_TRANSFER_BIT,
-            RHI_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-            0,
-            0, nullptr,
-            0, nullptr,
-            1, &dst_barrier_to_color);
-
-        LOG_DEBUG("[RenderPipeline] Copied ray tracing output image to swapchain image {}", swapchain_image_index);
-    }
+        // 5. 执行主相机渲染（包含UI子通道），RT合成先于UI绘制，UI始终位于最上层
+        main_camera_pass.drawForward(vulkan_rhi->m_current_swapchain_image_index);
 
+        // 提交渲染命令并释放交换链图像
+        vulkan_rhi->submitRendering([](){});
+    }
+    
     void RenderPipeline::passUpdateAfterRecreateSwapchain()
     {
+        // 附件图像视图已重建，旧视图地址可能被复用，缓存的描述符集全部失效
+        m_descriptor_allocator->invalidateCache();
+
         // 更新方向光阴影渲染通道
         DirectionalLightShadowPass& directional_light_shadow_pass = *(static_cast<DirectionalLightShadowPass*>(m_directional_light_shadow_pass.get()));
         directional_light_shadow_pass.updateAfterFramebufferRecreate();
@@ -351,4 +448,192 @@ namespace Elish
         return false;
     }
 
-}
\ No newline at end of file
+    /**
+     * @brief 启用或禁用光线追踪降噪
+     */
+    void RenderPipeline::setRayTracingDenoiseEnabled(bool enabled)
+    {
+        if (!m_raytracing_denoise_pass)
+        {
+            return;
+        }
+
+        m_raytracing_denoise_pass->setEnabled(enabled);
+        if (m_raytracing_pass)
+        {
+            // 降噪器自行维护时域历史，与渐进累积互斥
+            m_raytracing_pass->setAccumulationEnabled(!enabled);
+        }
+    }
+
+    /**
+     * @brief 获取光线追踪降噪启用状态
+     */
+    bool RenderPipeline::isRayTracingDenoiseEnabled() const
+    {
+        return m_raytracing_denoise_pass && m_raytracing_denoise_pass->isEnabled();
+    }
+
+    /**
+     * @brief 设置降噪的à-trous迭代次数
+     */
+    void RenderPipeline::setRayTracingDenoiseIterations(uint32_t iterations)
+    {
+        if (m_raytracing_denoise_pass)
+        {
+            m_raytracing_denoise_pass->setAtrousIterations(iterations);
+        }
+    }
+
+    /**
+     * @brief 获取降噪的à-trous迭代次数
+     */
+    uint32_t RenderPipeline::getRayTracingDenoiseIterations() const
+    {
+        return m_raytracing_denoise_pass ? m_raytracing_denoise_pass->getAtrousIterations() : 0u;
+    }
+
+    /**
+     * @brief 启用或禁用棋盘格光线追踪
+     */
+    void RenderPipeline::setRayTracingCheckerboardEnabled(bool enabled)
+    {
+        if (!m_raytracing_pass)
+        {
+            return;
+        }
+
+        m_raytracing_pass->setCheckerboardEnabled(enabled);
+        if (m_raytracing_checkerboard_pass)
+        {
+            m_raytracing_checkerboard_pass->resetHistory();
+        }
+    }
+
+    /**
+     * @brief 获取棋盘格光线追踪启用状态
+     */
+    bool RenderPipeline::isRayTracingCheckerboardEnabled() const
+    {
+        return m_raytracing_pass && m_raytracing_pass->isCheckerboardEnabled();
+    }
+
+    /**
+     * @brief 设置光线追踪渲染缩放比例
+     */
+    void RenderPipeline::setRayTracingRenderScale(float scale)
+    {
+        if (m_raytracing_pass)
+        {
+            m_raytracing_pass->setRenderScale(scale);
+        }
+    }
+
+    /**
+     * @brief 获取光线追踪渲染缩放比例
+     */
+    float RenderPipeline::getRayTracingRenderScale() const
+    {
+        return m_raytracing_pass ? m_raytracing_pass->getRenderScale() : 1.0f;
+    }
+
+    /**
+     * @brief 启用或禁用光线查询阴影
+     */
+    void RenderPipeline::setRayQueryShadowsEnabled(bool enabled)
+    {
+        if (m_main_camera_pass)
+        {
+            static_cast<MainCameraPass*>(m_main_camera_pass.get())->setRayQueryShadowsEnabled(enabled);
+        }
+    }
+
+    /**
+     * @brief 获取光线查询阴影启用状态
+     */
+    bool RenderPipeline::isRayQueryShadowsEnabled() const
+    {
+        if (m_main_camera_pass)
+        {
+            return static_cast<MainCameraPass*>(m_main_camera_pass.get())->isRayQueryShadowsEnabled();
+        }
+        return false;
+    }
+
+    /**
+     * @brief 启用或禁用半分辨率光线追踪反射
+     */
+    void RenderPipeline::setRayTracingReflectionsEnabled(bool enabled)
+    {
+        if (m_raytracing_reflection_pass)
+        {
+            m_raytracing_reflection_pass->setEnabled(enabled);
+        }
+    }
+
+    /**
+     * @brief 获取光线追踪反射启用状态
+     */
+    bool RenderPipeline::isRayTracingReflectionsEnabled() const
+    {
+        return m_raytracing_reflection_pass && m_raytracing_reflection_pass->isEnabled();
+    }
+
+    /**
+     * @brief 设置光线追踪反射的粗糙度阈值
+     */
+    void RenderPipeline::setRayTracingReflectionRoughnessThreshold(float threshold)
+    {
+        if (m_raytracing_reflection_pass)
+        {
+            m_raytracing_reflection_pass->setRoughnessThreshold(threshold);
+        }
+    }
+
+    /**
+     * @brief 获取光线追踪反射的粗糙度阈值
+     */
+    float RenderPipeline::getRayTracingReflectionRoughnessThreshold() const
+    {
+        return m_raytracing_reflection_pass ? m_raytracing_reflection_pass->getRoughnessThreshold() : 0.0f;
+    }
+
+    /**
+     * @brief 启用或禁用光线追踪环境遮蔽
+     */
+    void RenderPipeline::setRayTracingAmbientOcclusionEnabled(bool enabled)
+    {
+        if (m_raytracing_ambient_occlusion_pass)
+        {
+            m_raytracing_ambient_occlusion_pass->setEnabled(enabled);
+        }
+    }
+
+    /**
+     * @brief 获取光线追踪环境遮蔽启用状态
+     */
+    bool RenderPipeline::isRayTracingAmbientOcclusionEnabled() const
+    {
+        return m_raytracing_ambient_occlusion_pass && m_raytracing_ambient_occlusion_pass->isEnabled();
+    }
+
+    /**
+     * @brief 设置光线追踪环境遮蔽的光线最大距离
+     */
+    void RenderPipeline::setRayTracingAmbientOcclusionRadius(float radius)
+    {
+        if (m_raytracing_ambient_occlusion_pass)
+        {
+            m_raytracing_ambient_occlusion_pass->setRadius(radius);
+        }
+    }
+
+    /**
+     * @brief 获取光线追踪环境遮蔽的光线最大距离
+     */
+    float RenderPipeline::getRayTracingAmbientOcclusionRadius() const
+    {
+        return m_raytracing_ambient_occlusion_pass ? m_raytracing_ambient_occlusion_pass->getRadius() : 0.0f;
+    }
+
+}
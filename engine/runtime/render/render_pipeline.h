@@ -4,12 +4,18 @@
 #include "render_pipeline_base.h"
 #include "passes/directional_light_pass.h"
 #include "passes/raytracing_pass.h"
+#include "passes/raytracing_denoise_pass.h"
+#include "passes/raytracing_checkerboard_pass.h"
+#include "passes/raytracing_reflection_pass.h"
+#include "passes/raytracing_ambient_occlusion_pass.h"
 #include <memory>
 
 namespace Elish
 {
     class UIPass;
     class RayTracingPass;
+    class DescriptorAllocator;
+    class PipelineCache;
 
     /**
      * @brief 主渲染管线类
@@ -18,6 +24,11 @@ namespace Elish
     class RenderPipeline : public RenderPipelineBase
     {
     public:
+        /**
+         * @brief 等待后台管线编译与GPU空闲后销毁缓存中的管线，此时RHI与各通道的管线布局仍然有效
+         */
+        ~RenderPipeline();
+
         virtual void initialize() override final;
         virtual void forwardRender(std::shared_ptr<RHI> rhi, std::shared_ptr<RenderResource> render_resource) override;
         void passUpdateAfterRecreateSwapchain();
@@ -56,6 +67,133 @@ namespace Elish
          */
         bool isRayTracingEnabled() const override;
 
+        /**
+         * @brief 启用或禁用光线追踪降噪（SVGF）
+         * @details 降噪依赖逐帧1spp输入，启用时关闭光线追踪通道的渐进累积
+         * @param enabled 是否启用降噪
+         */
+        void setRayTracingDenoiseEnabled(bool enabled);
+
+        /**
+         * @brief 获取光线追踪降噪启用状态
+         */
+        bool isRayTracingDenoiseEnabled() const;
+
+        /**
+         * @brief 设置降噪的à-trous迭代次数（1-5）
+         */
+        void setRayTracingDenoiseIterations(uint32_t iterations);
+
+        /**
+         * @brief 获取降噪的à-trous迭代次数
+         */
+        uint32_t getRayTracingDenoiseIterations() const;
+
+        /**
+         * @brief 获取各通道共享的描述符集分配器
+         */
+        std::shared_ptr<DescriptorAllocator> getDescriptorAllocator() const { return m_descriptor_allocator; }
+
+        /**
+         * @brief 获取各通道共享的管线状态对象缓存
+         */
+        std::shared_ptr<PipelineCache> getPipelineCache() const { return m_pipeline_cache; }
+
+        std::shared_ptr<RayTracingDenoisePass> getRayTracingDenoisePass() const { return m_raytracing_denoise_pass; }
+
+        /**
+         * @brief 启用或禁用棋盘格光线追踪
+         * @details 每帧只追踪一半像素，缺失像素由重建通道通过重投影与边缘导向插值补全
+         * @param enabled 是否启用棋盘格渲染
+         */
+        void setRayTracingCheckerboardEnabled(bool enabled);
+
+        /**
+         * @brief 获取棋盘格光线追踪启用状态
+         */
+        bool isRayTracingCheckerboardEnabled() const;
+
+        /**
+         * @brief 设置光线追踪渲染缩放比例（0.5-1.0）
+         * @details 输出图像在下一帧开始时按新分辨率重建，合成时再放大到场景视口
+         */
+        void setRayTracingRenderScale(float scale);
+
+        /**
+         * @brief 获取光线追踪渲染缩放比例
+         */
+        float getRayTracingRenderScale() const;
+
+        /**
+         * @brief 启用或禁用光线查询阴影（混合渲染）
+         * @details 启用且生效时，光栅化模型管线通过光线查询计算方向光阴影，阴影贴图通道整体跳过
+         * @param enabled 是否启用光线查询阴影
+         */
+        void setRayQueryShadowsEnabled(bool enabled);
+
+        /**
+         * @brief 获取光线查询阴影启用状态
+         */
+        bool isRayQueryShadowsEnabled() const;
+
+        /**
+         * @brief 启用或禁用半分辨率光线追踪反射（混合渲染）
+         * @details 仅粗糙度低于阈值的表面追踪反射光线，结果经深度/法线感知上采样后替换IBL镜面项；
+         *          需要设备支持光线查询
+         * @param enabled 是否启用光线追踪反射
+         */
+        void setRayTracingReflectionsEnabled(bool enabled);
+
+        /**
+         * @brief 获取光线追踪反射启用状态
+         */
+        bool isRayTracingReflectionsEnabled() const;
+
+        /**
+         * @brief 设置光线追踪反射的粗糙度阈值，粗糙度不低于该值的表面保持IBL
+         */
+        void setRayTracingReflectionRoughnessThreshold(float threshold);
+
+        /**
+         * @brief 获取光线追踪反射的粗糙度阈值
+         */
+        float getRayTracingReflectionRoughnessThreshold() const;
+
+        /**
+         * @brief 启用或禁用半分辨率光线追踪环境遮蔽（RTAO）
+         * @details 每像素少量短距离遮蔽光线经时域累积后乘入环境光照，补充物体之间的接触遮蔽；
+         *          需要设备支持光线查询
+         * @param enabled 是否启用光线追踪环境遮蔽
+         */
+        void setRayTracingAmbientOcclusionEnabled(bool enabled);
+
+        /**
+         * @brief 获取光线追踪环境遮蔽启用状态
+         */
+        bool isRayTracingAmbientOcclusionEnabled() const;
+
+        /**
+         * @brief 设置遮蔽光线的最大距离（世界单位）
+         */
+        void setRayTracingAmbientOcclusionRadius(float radius);
+
+        /**
+         * @brief 获取遮蔽光线的最大距离
+         */
+        float getRayTracingAmbientOcclusionRadius() const;
+
+        /**
+         * @brief 启用或禁用光线追踪输出合成
+         * @details 启用时光线追踪输出作为纹理在主相机UI子通道中采样，按场景视口放大并混合在UI之下
+         * @param enabled 是否启用合成
+         */
+        void setRayTracingCompositeEnabled(bool enabled) { m_rt_composite_enabled = enabled; }
+
+        /**
+         * @brief 获取光线追踪输出合成启用状态
+         */
+        bool isRayTracingCompositeEnabled() const { return m_rt_composite_enabled; }
+
         /**
          * @brief 编辑器布局状态结构体
          */
@@ -88,40 +226,52 @@ namespace Elish
 
         /**
          * @brief RT任务监控结构
-         * @details 记录RT任务开始/结束时间、耗时、成功/失败次数、异常统计与超时阈值
+         * @details RT命令随帧异步提交，耗时由GPU时间戳查询得到：每个飞行帧占用一对查询，
+         *          之后的帧中非阻塞回读；结果迟迟不可用或GPU耗时超过阈值即判定为超时。
+         *          CPU录制阶段的异常另行统计
          */
         struct RTTaskMonitor {
-            bool running = false;
-            bool completed = false;
-            uint64_t start_ms = 0;
-            uint64_t end_ms = 0;
-            uint64_t last_duration_ms = 0;
+            struct GpuQuerySlot {
+                bool pending = false;               // 已提交、GPU结果尚未回读
+                bool timeout_reported = false;      // 本次提交是否已报告超时
+                uint64_t submit_ms = 0;             // 提交时刻（CPU时间）
+            };
+            std::vector<GpuQuerySlot> slots;        // 按飞行帧索引
+            double last_gpu_duration_ms = 0.0;
             uint64_t timeout_threshold_ms = 500;
             uint64_t success_count = 0;
             uint64_t failure_count = 0;
+            uint64_t timeout_count = 0;
             uint64_t last_error_timestamp_ms = 0;
             uint32_t error_count_window = 0;
             uint64_t window_start_ms = 0;
-            void begin();
-            void finish(bool success);
-            bool isTimeout(uint64_t now_ms) const;
+            void recordResult(bool success, uint64_t now_ms);
+            void submit(uint32_t slot, uint64_t now_ms);
+            void resolve(uint32_t slot, double gpu_duration_ms);
+            bool isTimeout(uint32_t slot, uint64_t now_ms) const;
         } m_rt_monitor;
 
-        // 任务队列简化：记录RT完成后的回调（用于触发UI）
-        std::function<void()> m_rt_complete_callback;
-        
-        // 控制是否在本帧执行RT图像复制到交换链（默认关闭以避免覆盖UI）
-        bool m_rt_copy_enabled = false;
-
         /**
-         * @brief 将光线追踪输出图像复制到交换链图像
+         * @brief 非阻塞回读各飞行帧的RT时间戳查询并检测超时
          * @param rhi RHI接口
-         * @param swapchain_image_index 交换链图像索引
          */
-        void copyRayTracingOutputToSwapchain(std::shared_ptr<RHI> rhi, uint32_t swapchain_image_index);
+        void pollRayTracingGpuQueries(RHI* rhi);
+
+
+        // 任务队列简化：记录RT完成后的回调（用于触发UI）
+        std::function<void()> m_rt_complete_callback;
+        
+        // 控制是否在主相机UI子通道中合成光线追踪输出
+        bool m_rt_composite_enabled = true;
         
+        std::shared_ptr<DescriptorAllocator> m_descriptor_allocator;  ///< 各通道共享的描述符集分配器（池链、逐帧池与缓存）
+        std::shared_ptr<PipelineCache> m_pipeline_cache;  ///< 各通道共享的管线状态对象缓存
         std::shared_ptr<UIPass> m_ui_pass;  ///< UI渲染通道
         std::shared_ptr<RayTracingPass> m_raytracing_pass;  ///< 光线追踪渲染通道
+        std::shared_ptr<RayTracingDenoisePass> m_raytracing_denoise_pass;  ///< 光线追踪降噪通道
+        std::shared_ptr<RayTracingCheckerboardPass> m_raytracing_checkerboard_pass;  ///< 棋盘格光线追踪重建通道
+        std::shared_ptr<RayTracingReflectionPass> m_raytracing_reflection_pass;  ///< 半分辨率光线追踪反射通道
+        std::shared_ptr<RayTracingAmbientOcclusionPass> m_raytracing_ambient_occlusion_pass;  ///< 半分辨率光线追踪环境遮蔽通道
         // 注意：m_directional_light_shadow_pass 已在基类 RenderPipelineBase 中声明，不需要重复声明
     };
 } // namespace Elish
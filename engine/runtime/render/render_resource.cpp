@@ -1,20 +1,60 @@
 #include "render_resource.h"
+#include "pipeline_cache.h"
 #include "../../3rdparty/tinyobjloader/tiny_obj_loader.h"
 #include "../core/base/macro.h"
 #include "../../3rdparty/stb/stb_image.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include "../shader/generated/cpp/PBR_vert.h"
 #include "../shader/generated/cpp/PBR_frag.h"
+#include "../shader/generated/cpp/PBR_ray_query_shadows_frag.h"
+#include "../shader/generated/cpp/PBR_rt_lighting_frag.h"
 #include "../shader/generated/cpp/raytracing_rgen.h"
 #include "../shader/generated/cpp/raytracing_rchit.h"
 #include "../shader/generated/cpp/raytracing_rmiss.h"
 #include "../shader/generated/cpp/shadow_rmiss.h"
+#include "../shader/generated/cpp/rt_tlas_instances_comp.h"
 #include "interface/vulkan/vulkan_util.h"
 #include "interface/vulkan/vulkan_rhi.h"
+#include <algorithm>
+#include <cmath>
 #include <unordered_map>
 
 namespace Elish
 {
+    namespace
+    {
+        /**
+         * @brief 组合局部矩阵：平移 -> 动画旋转 -> X/Y/Z旋转 -> 缩放（根物体的局部矩阵即原先各通道的模型矩阵）
+         * @param animation 为nullptr时表示静态实体
+         */
+        glm::mat4 composeLocalMatrix(const TransformComponent& transform, const AnimationComponent* animation, float time)
+        {
+            glm::mat4 world = glm::translate(glm::mat4(1.0f), transform.position);
+            if (animation) {
+                world = glm::rotate(world, time * animation->rotationSpeed, animation->rotationAxis);
+            }
+            world = glm::rotate(world, transform.rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
+            world = glm::rotate(world, transform.rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
+            world = glm::rotate(world, transform.rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
+            return glm::scale(world, transform.scale);
+        }
+
+        /**
+         * @brief 粗糙度贴图R通道的最小线性值
+         * @details 贴图以SRGB格式创建，着色器采样得到的是解码后的线性值，这里按同样的方式换算
+         */
+        float computeMinRoughness(const stbi_uc* pixels, int width, int height)
+        {
+            uint8_t min_value = 255;
+            size_t pixel_count = static_cast<size_t>(width) * static_cast<size_t>(height);
+            for (size_t i = 0; i < pixel_count && min_value > 0; ++i) {
+                min_value = std::min(min_value, pixels[i * 4]);
+            }
+            float srgb = min_value / 255.0f;
+            return srgb <= 0.04045f ? srgb / 12.92f : std::pow((srgb + 0.055f) / 1.055f, 2.4f);
+        }
+    } // namespace
+
     RenderResource::RenderResource()
         : m_cubemapImage(nullptr)
         , m_cubemapImageView(nullptr)
@@ -48,13 +88,13 @@ namespace Elish
         
         // 清理模型渲染管线资源
         if (m_modelPipelineResourceCreated && m_rhi) {
-            if (m_modelPipelineResource.graphicsPipeline != nullptr) {
-                // TODO: Add destroyPipeline method to RHI interface
-                // m_rhi->destroyPipeline(m_modelPipelineResource.graphicsPipeline);
-                delete m_modelPipelineResource.graphicsPipeline;
-                m_modelPipelineResource.graphicsPipeline = nullptr;
-            }
+            // 模型管线归管线缓存所有，由缓存统一销毁
+            m_modelPipelineResource.graphicsPipeline = nullptr;
             if (m_modelPipelineResource.pipelineLayout != nullptr) {
+                // 缓存仍存活时先移除以该布局为键的管线，避免新布局复用地址后误命中
+                if (std::shared_ptr<PipelineCache> pipelineCache = m_modelPipelineCache.lock()) {
+                    pipelineCache->releasePipelineLayout(m_modelPipelineResource.pipelineLayout);
+                }
                 // TODO: Add destroyPipelineLayout method to RHI interface
                 // m_rhi->destroyPipelineLayout(m_modelPipelineResource.pipelineLayout);
                 delete m_modelPipelineResource.pipelineLayout;
@@ -67,6 +107,9 @@ namespace Elish
                 m_modelPipelineResource.descriptorSetLayout = nullptr;
             }
             m_modelPipelineResourceCreated = false;
+            m_modelPushDescriptorEnabled = false;
+            m_modelRayQueryPipelineRequest = 0;
+            m_modelRtLightingPipelineRequest = 0;
         }
         
         // 清理cubemap资源
@@ -76,6 +119,7 @@ namespace Elish
                 m_cubemapImageView = nullptr;
             }
             if (m_cubemapImage != nullptr) {
+                m_resource_states.forget(m_cubemapImage);
                 m_rhi->destroyImage(m_cubemapImage);
                 m_cubemapImage = nullptr;
             }
@@ -85,6 +129,9 @@ namespace Elish
         
         // 清理光线追踪资源
         if (m_rayTracingResourceCreated && m_rhi) {
+            // 等待仍在执行的异步构建并释放其临时缓冲区
+            releaseCompletedAccelerationStructureBuilds(true);
+
             // 清理暂存缓冲区
             if (m_rayTracingResource.scratchBuffer && m_rayTracingResource.scratchBufferAllocation) {
                 VmaAllocator allocator = static_cast<VulkanRHI*>(m_rhi.get())->getAssetsAllocator();
@@ -96,16 +143,49 @@ namespace Elish
                 m_rayTracingResource.scratchBufferAllocation = nullptr;
                 LOG_DEBUG("[RenderResource::cleanup] Cleaned up scratch buffer");
             }
+            destroyRayTracingGeometryTable();
+            destroyRayTracingInstanceBuffers();
+            // 实例生成管线归管线缓存所有，缓存仍存活时先移除以该布局为键的管线
+            m_tlasInstancePipeline = nullptr;
+            if (m_tlasInstancePipelineLayout) {
+                if (std::shared_ptr<PipelineCache> pipelineCache = m_tlasInstancePipelineCache.lock()) {
+                    pipelineCache->releasePipelineLayout(m_tlasInstancePipelineLayout);
+                }
+                m_rhi->destroyPipelineLayout(m_tlasInstancePipelineLayout);
+                m_tlasInstancePipelineLayout = nullptr;
+            }
             m_rayTracingResourceCreated = false;
         }
         
         // 清理所有模型数据
+        forgetRenderObjectImages();
         m_RenderObjects.clear();
+        m_sceneWorld.clear();
+        m_sceneGraph.clear();
+        m_renderObjectEntities.clear();
     }
     
-    void RenderResource::addRenderObject(const RenderObject& renderObject)
+    size_t RenderResource::addRenderObject(const RenderObject& renderObject)
     {
         m_RenderObjects.push_back(renderObject);
+        size_t index = m_RenderObjects.size() - 1;
+        syncRenderObjectEntity(index);
+        return index;
+    }
+
+    void RenderResource::endRenderObjectBatch()
+    {
+        if (m_renderObjectBatchDepth == 0 || --m_renderObjectBatchDepth > 0) {
+            return;
+        }
+
+        // 批量期间先于父物体加载的子物体在此统一挂接
+        for (size_t i = 0; i < m_RenderObjects.size(); ++i) {
+            if (m_RenderObjects[i].animationParams.parentIndex >= 0) {
+                linkRenderObjectParent(i);
+            }
+        }
+        m_sceneGraph.update();
     }
     
     /**
@@ -113,10 +193,27 @@ namespace Elish
      */
     void RenderResource::clearAllRenderObjects()
     {
+        forgetRenderObjectImages();
         m_RenderObjects.clear();
+        m_sceneWorld.clear();
+        m_sceneGraph.clear();
+        m_renderObjectEntities.clear();
         LOG_INFO("[RenderResource::clearAllRenderObjects] Cleared all render objects");
     }
     
+    /**
+     * @brief 从状态跟踪器中移除所有渲染对象的纹理图像
+     * @details 跟踪器按地址记录状态，图像丢弃后地址可能被新图像复用
+     */
+    void RenderResource::forgetRenderObjectImages()
+    {
+        for (const RenderObject& renderObject : m_RenderObjects) {
+            for (RHIImage* textureImage : renderObject.textureImages) {
+                m_resource_states.forget(textureImage);
+            }
+        }
+    }
+    
     /**
      * @brief 更新指定渲染对象的动画参数
      * @param objectIndex 渲染对象的索引
@@ -132,13 +229,33 @@ namespace Elish
         
         // 更新动画参数
         m_RenderObjects[objectIndex].animationParams = newParams;
+        syncRenderObjectEntity(objectIndex);
         
         // LOG_INFO("[RenderResource::updateRenderObjectAnimationParams] Updated animation params for object {} ({})", 
                  // objectIndex, m_RenderObjects[objectIndex].name);
         
         return true;
     }
-    
+
+    /**
+     * @brief 设置渲染对象的光线追踪实例掩码与标志
+     * @param objectIndex 渲染对象的索引
+     * @param mask 可见性掩码
+     * @param flags 实例标志
+     * @return 设置是否成功
+     */
+    bool RenderResource::setRenderObjectRayTracingInstance(size_t objectIndex, uint8_t mask, RHIGeometryInstanceFlagsKHR flags)
+    {
+        if (objectIndex >= m_RenderObjects.size()) {
+            LOG_ERROR("[RenderResource::setRenderObjectRayTracingInstance] Invalid object index: {}", objectIndex);
+            return false;
+        }
+
+        m_RenderObjects[objectIndex].rayTracingMask = mask;
+        m_RenderObjects[objectIndex].rayTracingInstanceFlags = flags;
+        return true;
+    }
+
     bool RenderResource::createRenderObjectResource(RenderObject& outRenderObject, const std::string& objfile, const std::vector<std::string>& pngfiles)
     {
         
@@ -199,9 +316,159 @@ namespace Elish
         }
         
         m_RenderObjects.push_back(renderObject);
+        syncRenderObjectEntity(m_RenderObjects.size() - 1);
         
         return true;
     }
+
+    void RenderResource::syncRenderObjectEntity(size_t index)
+    {
+        const RenderObject& renderObject = m_RenderObjects[index];
+        const ModelAnimationParams& params = renderObject.animationParams;
+
+        if (m_renderObjectEntities.size() <= index) {
+            m_renderObjectEntities.resize(index + 1);
+        }
+        bool created = false;
+        if (!m_sceneWorld.isAlive(m_renderObjectEntities[index])) {
+            TransformComponent initialTransform;
+            initialTransform.node = m_sceneGraph.createNode();
+            m_renderObjectEntities[index] = m_sceneWorld.createEntity(initialTransform);
+            created = true;
+        }
+        Entity entity = m_renderObjectEntities[index];
+
+        TransformComponent& transform = *m_sceneWorld.getComponent<TransformComponent>(entity);
+        transform.position = params.position;
+        transform.rotation = params.rotation;
+        transform.scale = params.scale;
+
+        // 网格组件只同步句柄与计数，缓冲区仍归RenderObject所有
+        if (renderObject.vertexBuffer) {
+            MeshComponent mesh;
+            mesh.vertexBuffer = renderObject.vertexBuffer;
+            mesh.indexBuffer = renderObject.indices.empty() ? nullptr : renderObject.indexBuffer;
+            mesh.vertexCount = static_cast<uint32_t>(renderObject.vertices.size());
+            mesh.indexCount = mesh.indexBuffer ? static_cast<uint32_t>(renderObject.indices.size()) : 0;
+            mesh.renderObjectIndex = static_cast<uint32_t>(index);
+            m_sceneWorld.addComponent(entity, mesh);
+        } else {
+            m_sceneWorld.removeComponent<MeshComponent>(entity);
+        }
+
+        // 平台保持静止；静态实体不带动画组件，变换系统不会遍历到它们
+        if (params.enableAnimation && !params.isPlatform) {
+            AnimationComponent animation;
+            animation.rotationAxis = params.rotationAxis;
+            animation.rotationSpeed = params.rotationSpeed;
+            m_sceneWorld.addComponent(entity, animation);
+        } else {
+            m_sceneWorld.removeComponent<AnimationComponent>(entity);
+        }
+
+        // 迁移原型后组件地址会变化，重新获取
+        const TransformComponent& current = *m_sceneWorld.getComponent<TransformComponent>(entity);
+        m_sceneGraph.setLocalMatrix(current.node, composeLocalMatrix(current, m_sceneWorld.getComponent<AnimationComponent>(entity), m_sceneTime));
+
+        linkRenderObjectParent(index);
+        if (m_renderObjectBatchDepth > 0) {
+            // 挂接与世界矩阵重算推迟到endRenderObjectBatch()
+            return;
+        }
+        if (created) {
+            // 先于父物体加载的子物体此时挂接
+            for (size_t i = 0; i < m_RenderObjects.size(); ++i) {
+                if (i != index && m_RenderObjects[i].animationParams.parentIndex == static_cast<int>(index)) {
+                    linkRenderObjectParent(i);
+                }
+            }
+        }
+
+        // 只重算该物体所在的子树，编辑后立即可以读到新的世界矩阵
+        m_sceneGraph.update();
+    }
+
+    bool RenderResource::linkRenderObjectParent(size_t index)
+    {
+        ModelAnimationParams& params = m_RenderObjects[index].animationParams;
+        SceneNode node = m_sceneWorld.getComponent<TransformComponent>(m_renderObjectEntities[index])->node;
+
+        SceneNode parentNode;
+        if (params.parentIndex >= 0) {
+            const TransformComponent* parentTransform =
+                m_sceneWorld.getComponent<TransformComponent>(getRenderObjectEntity(static_cast<size_t>(params.parentIndex)));
+            if (parentTransform) {
+                parentNode = parentTransform->node;
+            }
+        }
+
+        if (!m_sceneGraph.setParent(node, parentNode)) {
+            LOG_WARN("[RenderResource::linkRenderObjectParent] Parent {} of object {} would create a cycle, detaching",
+                     params.parentIndex, index);
+            params.parentIndex = -1;
+            m_sceneGraph.setParent(node, SceneNode{});
+            return false;
+        }
+        return true;
+    }
+
+    bool RenderResource::setRenderObjectParent(size_t objectIndex, int parentIndex)
+    {
+        if (objectIndex >= m_RenderObjects.size() || parentIndex >= static_cast<int>(m_RenderObjects.size())) {
+            LOG_ERROR("[RenderResource::setRenderObjectParent] Invalid object index: {} (parent {})", objectIndex, parentIndex);
+            return false;
+        }
+
+        ModelAnimationParams& params = m_RenderObjects[objectIndex].animationParams;
+        int previousParent = params.parentIndex;
+        params.parentIndex = parentIndex < 0 ? -1 : parentIndex;
+        if (!linkRenderObjectParent(objectIndex)) {
+            params.parentIndex = previousParent;
+            linkRenderObjectParent(objectIndex);
+            return false;
+        }
+
+        if (m_renderObjectBatchDepth == 0) {
+            m_sceneGraph.update();
+        }
+        return true;
+    }
+
+    void RenderResource::updateSceneTransforms(float time)
+    {
+        m_sceneTime = time;
+        m_sceneWorld.eachChunk<TransformComponent, AnimationComponent>(
+            [this, time](uint32_t count, const Entity*, TransformComponent* transforms, AnimationComponent* animations) {
+                for (uint32_t i = 0; i < count; ++i) {
+                    m_sceneGraph.setLocalMatrix(transforms[i].node, composeLocalMatrix(transforms[i], &animations[i], time));
+                }
+            });
+
+        // 只有动画物体及其子树被标脏，静态层级不参与计算
+        m_sceneGraph.update();
+    }
+
+    const glm::mat4& RenderResource::getRenderObjectWorldMatrix(size_t index) const
+    {
+        const TransformComponent* transform = m_sceneWorld.getComponent<TransformComponent>(getRenderObjectEntity(index));
+        return m_sceneGraph.getWorldMatrix(transform ? transform->node : SceneNode{});
+    }
+
+    bool RenderResource::isRenderObjectAnimated(size_t index) const
+    {
+        // parentIndex链与场景图一致且无环（成环的设置会被拒绝），父物体尚未加载时链在此中断
+        while (index < m_RenderObjects.size()) {
+            const ModelAnimationParams& params = m_RenderObjects[index].animationParams;
+            if (params.enableAnimation && !params.isPlatform) {
+                return true;
+            }
+            if (params.parentIndex < 0) {
+                break;
+            }
+            index = static_cast<size_t>(params.parentIndex);
+        }
+        return false;
+    }
     
     bool RenderResource::parseOBJFile(const std::string& objPath, RenderObject& renderObject)
     {
@@ -398,6 +665,14 @@ namespace Elish
         renderObject.textureImageViews.resize(textureFiles.size());
         renderObject.textureSamplers.resize(textureFiles.size());
         
+        // 所有纹理的拷贝与布局转换收集后一次提交
+        std::vector<TextureUpload> uploads;
+        uploads.reserve(textureFiles.size());
+        
+        // 与描述符绑定一致：绑定5（粗糙度）使用第(5 - 3) % 纹理数张贴图
+        const size_t roughnessTextureIndex = 2 % textureFiles.size();
+        renderObject.minRoughness = 1.0f;
+        
         for (size_t i = 0; i < textureFiles.size(); ++i) {
             const std::string& texturePath = textureFiles[i];
             
@@ -407,7 +682,8 @@ namespace Elish
             if (!pixels) {
                 LOG_ERROR("[RenderResource::createTexturesFromFiles] Failed to load texture: {}", texturePath.c_str());
                 // Create default texture instead
-                if (!createSingleDefaultTexture(renderObject, i)) {
+                if (!createSingleDefaultTexture(renderObject, i, &uploads)) {
+                    submitTextureUploads(uploads);
                     return false;
                 }
                 continue;
@@ -415,6 +691,10 @@ namespace Elish
             
             RHIDeviceSize imageSize = texWidth * texHeight * 4; // 4 bytes per pixel (RGBA)
             
+            if (i == roughnessTextureIndex) {
+                renderObject.minRoughness = computeMinRoughness(pixels, texWidth, texHeight);
+            }
+            
             // Create staging buffer
             RHIBuffer* stagingBuffer = nullptr;
             RHIDeviceMemory* stagingBufferMemory = nullptr;
@@ -468,56 +748,17 @@ namespace Elish
         RHISampler* rhiTextureSampler = m_rhi->getOrCreateDefaultSampler(Default_Sampler_Linear);
         renderObject.textureSamplers[i] = rhiTextureSampler;
             
-            // Transition image layout and copy buffer to image
-            // First transition from undefined to transfer destination
-            VulkanUtil::transitionImageLayout(m_rhi.get(),
-                                             ((VulkanImage*)rhiTextureImage)->getResource(),
-                                             VK_IMAGE_LAYOUT_UNDEFINED,
-                                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                             1, // layer_count
-                                             1, // miplevels
-                                             VK_IMAGE_ASPECT_COLOR_BIT);
-            
-            // Copy buffer data to image
-            LOG_INFO("Copying buffer to image for texture {}, size: {}x{}", i, texWidth, texHeight);
-            VulkanUtil::copyBufferToImage(m_rhi.get(),
-                                        ((VulkanBuffer*)stagingBuffer)->getResource(),
-                                        ((VulkanImage*)rhiTextureImage)->getResource(),
-                                        texWidth,
-                                        texHeight,
-                                        1); // layer_count
-            LOG_INFO("Buffer to image copy completed for texture {}", i);
-            
-            // Transition image layout from transfer destination to shader read only
-            VulkanUtil::transitionImageLayout(m_rhi.get(),
-                                             ((VulkanImage*)rhiTextureImage)->getResource(),
-                                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                             VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                                             1, // layer_count
-                                             1, // miplevels
-                                             VK_IMAGE_ASPECT_COLOR_BIT);
-            
-            LOG_DEBUG("[RenderResource::createTexturesFromFiles] Texture {} layout transitions completed", i);
-            
-            // 等待GPU完成图像布局转换和数据复制后再清理临时缓冲区
-            // 这是防止验证层报错和数据损坏的关键步骤
-            m_rhi->waitForFences();
-            if (auto graphics_queue = m_rhi->getGraphicsQueue()) {
-                m_rhi->queueWaitIdle(graphics_queue);
-            }
-            
-            LOG_DEBUG("[RenderResource::createTexturesFromFiles] GPU operations completed for texture {}, cleaning up staging buffer", i);
-            
-            // GPU完成后安全清理临时缓冲区
-            m_rhi->destroyBuffer(stagingBuffer);
-            m_rhi->freeMemory(stagingBufferMemory);
-            
+            // 新建图像从UNDEFINED开始跟踪，拷贝与布局转换延后到submitTextureUploads统一录制
+            m_resource_states.registerImage(rhiTextureImage, 1, 1, RHI_IMAGE_ASPECT_COLOR_BIT);
+            uploads.push_back({ rhiTextureImage, stagingBuffer, stagingBufferMemory,
+                                static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight) });
         }
         
+        submitTextureUploads(uploads);
         return true;
     }
     
-    bool RenderResource::createSingleDefaultTexture(RenderObject& renderObject, size_t index)
+    bool RenderResource::createSingleDefaultTexture(RenderObject& renderObject, size_t index, std::vector<TextureUpload>* uploads)
     {
         
         if (!m_rhi) {
@@ -585,48 +826,73 @@ namespace Elish
         RHISampler* rhiTextureSampler = m_rhi->getOrCreateDefaultSampler(Default_Sampler_Linear);
         renderObject.textureSamplers[index] = rhiTextureSampler;
         
-        // Transition image layout and copy buffer to image
-        // First transition from undefined to transfer destination
-        VulkanUtil::transitionImageLayout(m_rhi.get(),
-                                         ((VulkanImage*)rhiTextureImage)->getResource(),
-                                         VK_IMAGE_LAYOUT_UNDEFINED,
-                                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                         1, // layer_count
-                                         1, // miplevels
-                                         VK_IMAGE_ASPECT_COLOR_BIT);
-        
-        // Copy buffer data to image
-        LOG_INFO("Copying buffer to image for default texture, size: {}x{}", texWidth, texHeight);
-        VulkanUtil::copyBufferToImage(m_rhi.get(),
-                                    ((VulkanBuffer*)stagingBuffer)->getResource(),
-                                    ((VulkanImage*)rhiTextureImage)->getResource(),
-                                    texWidth,
-                                    texHeight,
-                                    1); // layer_count
-        LOG_INFO("Buffer to image copy completed for default texture");
-        
-        // Transition image layout from transfer destination to shader read only
-        VulkanUtil::transitionImageLayout(m_rhi.get(),
-                                         ((VulkanImage*)rhiTextureImage)->getResource(),
-                                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                                         1, // layer_count
-                                         1, // miplevels
-                                         VK_IMAGE_ASPECT_COLOR_BIT);
-        
-        // Clean up staging buffer
-        m_rhi->destroyBuffer(stagingBuffer);
-        m_rhi->freeMemory(stagingBufferMemory);
+        m_resource_states.registerImage(rhiTextureImage, 1, 1, RHI_IMAGE_ASPECT_COLOR_BIT);
+        TextureUpload upload{ rhiTextureImage, stagingBuffer, stagingBufferMemory,
+                              static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight) };
+        if (uploads) {
+            // 由调用方与同批纹理一起提交
+            uploads->push_back(upload);
+        } else {
+            std::vector<TextureUpload> single_upload{ upload };
+            submitTextureUploads(single_upload);
+        }
         
         return true;
     }
     
-    bool RenderResource::createModelPipelineResource(RHIRenderPass* renderPass)
+    void RenderResource::submitTextureUploads(std::vector<TextureUpload>& uploads)
     {
+        if (uploads.empty()) {
+            return;
+        }
         
+        RHICommandBuffer* command_buffer = m_rhi->beginSingleTimeCommands();
         
-        if (!m_rhi) {
-            LOG_ERROR("[RenderResource::createModelPipelineResource] RHI pointer is null!");
+        // 所有图像 UNDEFINED -> TRANSFER_DST 合并为一次屏障
+        for (const TextureUpload& upload : uploads) {
+            m_resource_states.requireState(upload.image, ResourceState::TransferDst);
+        }
+        m_resource_states.flush(m_rhi.get(), command_buffer);
+        
+        for (const TextureUpload& upload : uploads) {
+            RHIBufferImageCopy region{};
+            region.bufferOffset = 0;
+            region.bufferRowLength = 0;
+            region.bufferImageHeight = 0;
+            region.imageSubresource.aspectMask = RHI_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = 0;
+            region.imageSubresource.baseArrayLayer = 0;
+            region.imageSubresource.layerCount = 1;
+            region.imageOffset = { 0, 0, 0 };
+            region.imageExtent = { upload.width, upload.height, 1 };
+            m_rhi->cmdCopyBufferToImage(command_buffer, upload.staging_buffer, upload.image,
+                                        RHI_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+        }
+        
+        // 所有图像 TRANSFER_DST -> SHADER_READ_ONLY 合并为一次屏障
+        for (const TextureUpload& upload : uploads) {
+            m_resource_states.requireState(upload.image, ResourceState::ShaderReadGraphics);
+        }
+        m_resource_states.flush(m_rhi.get(), command_buffer);
+        
+        // endSingleTimeCommands会等待队列空闲，之后可安全释放暂存缓冲区
+        m_rhi->endSingleTimeCommands(command_buffer);
+        
+        LOG_DEBUG("[RenderResource::submitTextureUploads] Uploaded {} textures in one submission", uploads.size());
+        
+        for (TextureUpload& upload : uploads) {
+            m_rhi->destroyBuffer(upload.staging_buffer);
+            m_rhi->freeMemory(upload.staging_memory);
+        }
+        uploads.clear();
+    }
+    
+    bool RenderResource::createModelPipelineResource(RHIRenderPass* renderPass, const std::shared_ptr<PipelineCache>& pipelineCache)
+    {
+        
+        
+        if (!m_rhi || !pipelineCache) {
+            LOG_ERROR("[RenderResource::createModelPipelineResource] RHI or pipeline cache pointer is null!");
             return false;
         }
         
@@ -684,11 +950,20 @@ namespace Elish
         model_layoutInfo.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
         model_layoutInfo.bindingCount = 10;
         model_layoutInfo.pBindings = model_bindings.data();
+
+        // 支持推送描述符时集合0改为推送布局：绑定在绘制时随命令写入，物体增删不再需要分配和写入描述符集
+        m_modelPushDescriptorEnabled = m_rhi->getMaxPushDescriptors() >= model_layoutInfo.bindingCount;
+        if (m_modelPushDescriptorEnabled) {
+            model_layoutInfo.flags = RHI_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+        }
         
         if (m_rhi->createDescriptorSetLayout(&model_layoutInfo, m_modelPipelineResource.descriptorSetLayout) != RHI_SUCCESS) {
             LOG_ERROR("[RenderResource::createModelPipelineResource] Failed to create descriptor set layout");
+            m_modelPushDescriptorEnabled = false;
             return false;
         }
+        LOG_INFO("[RenderResource::createModelPipelineResource] Model set 0 uses {}",
+                 m_modelPushDescriptorEnabled ? "push descriptors" : "per-object descriptor sets");
         
         // Create pipeline layout with Push Constants support
         RHIDescriptorSetLayout* descriptorSetLayouts[] = {m_modelPipelineResource.descriptorSetLayout};
@@ -714,8 +989,8 @@ namespace Elish
         }
         
         // Create graphics pipeline using MODEL shaders
-        RHIShader* vertShaderModule = m_rhi->createShaderModule(PBR_VERT);
-        RHIShader* fragShaderModule = m_rhi->createShaderModule(PBR_FRAG);
+        RHIShader* vertShaderModule = pipelineCache->getShader(PBR_VERT);
+        RHIShader* fragShaderModule = pipelineCache->getShader(PBR_FRAG);
         
         RHIPipelineShaderStageCreateInfo vertShaderStageInfo{};
         vertShaderStageInfo.sType = RHI_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -819,24 +1094,151 @@ namespace Elish
         pipelineInfo.subpass = 0;
         pipelineInfo.basePipelineHandle = RHI_NULL_HANDLE;
         
-        if (m_rhi->createGraphicsPipelines(RHI_NULL_HANDLE, 1, &pipelineInfo, m_modelPipelineResource.graphicsPipeline) != RHI_SUCCESS) {
+        m_modelPipelineResource.graphicsPipeline = pipelineCache->getOrCreateGraphicsPipeline(pipelineInfo);
+        if (!m_modelPipelineResource.graphicsPipeline) {
             LOG_ERROR("[RenderResource::createModelPipelineResource] Failed to create graphics pipeline");
             // TODO: Add proper cleanup methods to RHI interface
             delete m_modelPipelineResource.pipelineLayout;
             delete m_modelPipelineResource.descriptorSetLayout;
-            m_rhi->destroyShaderModule(vertShaderModule);
-            m_rhi->destroyShaderModule(fragShaderModule);
             return false;
         }
         
-        // Clean up shader modules
-        m_rhi->destroyShaderModule(vertShaderModule);
-        m_rhi->destroyShaderModule(fragShaderModule);
+        // 光线查询阴影变体：片段着色器直接查询TLAS，描述符集合1只包含加速结构
+        // 除片段着色器和管线布局外，其余管线状态与默认模型管线完全一致
+        if (m_rhi->isRayQuerySupported()) {
+            RHIDescriptorSetLayoutBinding tlasBinding{};
+            tlasBinding.binding = 0;
+            tlasBinding.descriptorType = RHI_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+            tlasBinding.descriptorCount = 1;
+            tlasBinding.stageFlags = RHI_SHADER_STAGE_FRAGMENT_BIT;
+            tlasBinding.pImmutableSamplers = nullptr;
+
+            RHIDescriptorSetLayoutCreateInfo tlasLayoutInfo{};
+            tlasLayoutInfo.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            tlasLayoutInfo.bindingCount = 1;
+            tlasLayoutInfo.pBindings = &tlasBinding;
+
+            bool rayQueryPipelineRequested = false;
+            if (m_rhi->createDescriptorSetLayout(&tlasLayoutInfo, m_modelRayQueryPipelineResource.descriptorSetLayout) == RHI_SUCCESS) {
+                RHIDescriptorSetLayout* rayQuerySetLayouts[] = {m_modelPipelineResource.descriptorSetLayout,
+                                                                m_modelRayQueryPipelineResource.descriptorSetLayout};
+                RHIPipelineLayoutCreateInfo rayQueryPipelineLayoutInfo = pipelineLayoutInfo;
+                rayQueryPipelineLayoutInfo.setLayoutCount = 2;
+                rayQueryPipelineLayoutInfo.pSetLayouts = rayQuerySetLayouts;
+
+                if (m_rhi->createPipelineLayout(&rayQueryPipelineLayoutInfo, m_modelRayQueryPipelineResource.pipelineLayout) == RHI_SUCCESS) {
+                    shaderStages[1].module = pipelineCache->getShader(PBR_RAY_QUERY_SHADOWS_FRAG);
+                    pipelineInfo.layout = m_modelRayQueryPipelineResource.pipelineLayout;
+
+                    // 变体交给后台线程编译，就绪前由updateModelPipelineRequests()保持默认模型管线
+                    m_modelRayQueryPipelineRequest = pipelineCache->requestGraphicsPipeline(pipelineInfo);
+                    rayQueryPipelineRequested = m_modelRayQueryPipelineRequest != 0;
+                }
+            }
+
+            if (!rayQueryPipelineRequested) {
+                // 变体创建失败不影响默认模型管线，光线查询阴影将保持不可用
+                LOG_WARN("[RenderResource::createModelPipelineResource] Failed to create ray query shadow pipeline, falling back to shadow map");
+            }
+
+            // 光线追踪光照变体：集合1为TLAS（可选的光线查询阴影）+ 半分辨率反射结果、上采样引导与环境遮蔽，
+            // 片段阶段推送常量紧跟model矩阵，布局与PBR.frag中RayTracedLightingConstants一致（32字节）
+            RHIDescriptorSetLayoutBinding lightingBindings[4] = {};
+            lightingBindings[0] = tlasBinding;
+            for (uint32_t i = 1; i < 4; ++i) {
+                lightingBindings[i].binding = i;
+                lightingBindings[i].descriptorType = RHI_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                lightingBindings[i].descriptorCount = 1;
+                lightingBindings[i].stageFlags = RHI_SHADER_STAGE_FRAGMENT_BIT;
+                lightingBindings[i].pImmutableSamplers = nullptr;
+            }
+
+            RHIDescriptorSetLayoutCreateInfo lightingLayoutInfo{};
+            lightingLayoutInfo.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            lightingLayoutInfo.bindingCount = 4;
+            lightingLayoutInfo.pBindings = lightingBindings;
+
+            RHIPushConstantRange lightingPushConstantRanges[2] = {pushConstantRange, {}};
+            lightingPushConstantRanges[1].stageFlags = RHI_SHADER_STAGE_FRAGMENT_BIT;
+            lightingPushConstantRanges[1].offset = sizeof(glm::mat4);
+            lightingPushConstantRanges[1].size = 32;
+
+            bool lightingPipelineRequested = false;
+            if (m_rhi->createDescriptorSetLayout(&lightingLayoutInfo, m_modelRtLightingPipelineResource.descriptorSetLayout) == RHI_SUCCESS) {
+                RHIDescriptorSetLayout* lightingSetLayouts[] = {m_modelPipelineResource.descriptorSetLayout,
+                                                                m_modelRtLightingPipelineResource.descriptorSetLayout};
+                RHIPipelineLayoutCreateInfo lightingPipelineLayoutInfo = pipelineLayoutInfo;
+                lightingPipelineLayoutInfo.setLayoutCount = 2;
+                lightingPipelineLayoutInfo.pSetLayouts = lightingSetLayouts;
+                lightingPipelineLayoutInfo.pushConstantRangeCount = 2;
+                lightingPipelineLayoutInfo.pPushConstantRanges = lightingPushConstantRanges;
+
+                if (m_rhi->createPipelineLayout(&lightingPipelineLayoutInfo, m_modelRtLightingPipelineResource.pipelineLayout) == RHI_SUCCESS) {
+                    shaderStages[1].module = pipelineCache->getShader(PBR_RT_LIGHTING_FRAG);
+                    pipelineInfo.layout = m_modelRtLightingPipelineResource.pipelineLayout;
+
+                    m_modelRtLightingPipelineRequest = pipelineCache->requestGraphicsPipeline(pipelineInfo);
+                    lightingPipelineRequested = m_modelRtLightingPipelineRequest != 0;
+                }
+            }
+
+            if (!lightingPipelineRequested) {
+                LOG_WARN("[RenderResource::createModelPipelineResource] Failed to create ray traced lighting pipeline, reflections and AO stay on IBL/textures");
+            }
+        }
         
         m_modelPipelineResourceCreated = true;
+        m_modelPipelineCache = pipelineCache;
         
         return true;
     }
+    bool RenderResource::updateModelPipelineRequests(PipelineCache* pipelineCache)
+    {
+        if (!pipelineCache) {
+            return false;
+        }
+
+        // 编译结束（成功或失败）后释放请求句柄，管线本身归缓存所有
+        auto takeResult = [pipelineCache](PipelineRequest& request, RHIPipeline*& pipeline) {
+            PipelineRequestState state = pipelineCache->getRequestState(request, pipeline);
+            if (state != PipelineRequestState::Pending) {
+                pipelineCache->releaseRequest(request);
+                request = 0;
+            }
+            return state;
+        };
+
+        bool changed = false;
+        if (m_modelRayQueryPipelineRequest) {
+            RHIPipeline* pipeline = nullptr;
+            PipelineRequestState state = takeResult(m_modelRayQueryPipelineRequest, pipeline);
+            if (state == PipelineRequestState::Ready) {
+                m_modelRayQueryPipelineResource.graphicsPipeline = pipeline;
+                m_modelRayQueryPipelineResourceCreated = true;
+                LOG_INFO("[RenderResource::updateModelPipelineRequests] Ray query shadow pipeline created");
+                changed = true;
+            } else if (state != PipelineRequestState::Pending) {
+                LOG_WARN("[RenderResource::updateModelPipelineRequests] Failed to create ray query shadow pipeline, falling back to shadow map");
+                changed = true;
+            }
+        }
+
+        if (m_modelRtLightingPipelineRequest) {
+            RHIPipeline* pipeline = nullptr;
+            PipelineRequestState state = takeResult(m_modelRtLightingPipelineRequest, pipeline);
+            if (state == PipelineRequestState::Ready) {
+                m_modelRtLightingPipelineResource.graphicsPipeline = pipeline;
+                m_modelRtLightingPipelineResourceCreated = true;
+                LOG_INFO("[RenderResource::updateModelPipelineRequests] Ray traced lighting pipeline created");
+                changed = true;
+            } else if (state != PipelineRequestState::Pending) {
+                LOG_WARN("[RenderResource::updateModelPipelineRequests] Failed to create ray traced lighting pipeline, reflections and AO stay on IBL/textures");
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
     /**
      * @brief Loads a cubemap texture from specified file paths.
      * @param cubemapFiles An array of 6 file paths for the cubemap faces (e.g., +X, -X, +Y, -Y, +Z, -Z).
@@ -874,6 +1276,7 @@ namespace Elish
                      (void*)m_cubemapImage, (void*)m_cubemapImageView);
             // 清理已分配的资源
             if (m_cubemapImage) {
+                m_resource_states.forget(m_cubemapImage);
                 m_rhi->destroyImage(m_cubemapImage);
                 m_cubemapImage = nullptr;
             }
@@ -895,6 +1298,7 @@ namespace Elish
                 m_cubemapImageView = nullptr;
             }
             if (m_cubemapImage) {
+                m_resource_states.forget(m_cubemapImage);
                 m_rhi->destroyImage(m_cubemapImage);
                 m_cubemapImage = nullptr;
             }
@@ -919,7 +1323,8 @@ namespace Elish
             {"rotationAxis", json11::Json::array {rotationAxis.x, rotationAxis.y, rotationAxis.z}},
             {"rotationSpeed", rotationSpeed},
             {"enableAnimation", enableAnimation},
-            {"isPlatform", isPlatform}
+            {"isPlatform", isPlatform},
+            {"parentIndex", parentIndex}
         };
     }
 
@@ -970,6 +1375,9 @@ namespace Elish
         if (json["isPlatform"].is_bool()) {
             isPlatform = json["isPlatform"].bool_value();
         }
+        if (json["parentIndex"].is_number()) {
+            parentIndex = json["parentIndex"].int_value();
+        }
 
         return true;
     }
@@ -1329,7 +1737,7 @@ namespace Elish
      * @brief 创建光线追踪资源（加速结构等）
      * @return 创建是否成功
      */
-    bool RenderResource::createRayTracingResource()
+    bool RenderResource::createRayTracingResource(const std::shared_ptr<PipelineCache>& pipelineCache)
     {
         if (!m_rhi) {
             LOG_ERROR("[RenderResource::createRayTracingResource] RHI pointer is null!");
@@ -1347,12 +1755,12 @@ namespace Elish
             return false;
         }
         
-        // 首先创建合并的顶点和索引缓冲区（用于光线追踪着色器绑定）
-        if (!createMergedVertexIndexBuffers()) {
-            LOG_ERROR("[RenderResource::createRayTracingResource] Failed to create merged vertex/index buffers");
+        // 首先创建实例几何地址表（命中着色器通过设备地址直接读取各网格的缓冲区）
+        if (!updateRayTracingGeometryTable()) {
+            LOG_ERROR("[RenderResource::createRayTracingResource] Failed to create geometry address table");
             return false;
         }
-        LOG_DEBUG("[RenderResource::createRayTracingResource] Created merged vertex and index buffers for ray tracing");
+        LOG_DEBUG("[RenderResource::createRayTracingResource] Created geometry address table for ray tracing");
         
         // 创建底层加速结构（BLAS）
         m_rayTracingResource.bottomLevelAS.resize(m_RenderObjects.size());
@@ -1362,9 +1770,13 @@ namespace Elish
         // 初始化几何数据结构存储
         m_rayTracingTrianglesData.resize(m_RenderObjects.size());
         
-        // 计算每个对象在合并缓冲区中的偏移量
-        uint32_t vertexOffset = 0;
-        uint32_t indexOffset = 0;
+        // 磁盘缓存：以设备/驱动UUID区分，命中时反序列化代替构建
+        uint8_t deviceUUID[RHI_UUID_SIZE] = {};
+        uint8_t driverUUID[RHI_UUID_SIZE] = {};
+        m_rhi->getDeviceUUIDs(deviceUUID, driverUUID);
+        m_accelerationStructureCache.setDeviceKey(deviceUUID, driverUUID);
+        std::vector<uint64_t> meshHashes(m_RenderObjects.size(), 0);
+        std::vector<std::vector<uint8_t>> cachedBlobs(m_RenderObjects.size());
         
         for (size_t i = 0; i < m_RenderObjects.size(); ++i) {
             const auto& renderObject = m_RenderObjects[i];
@@ -1379,30 +1791,19 @@ namespace Elish
             m_rayTracingTrianglesData[i].pNext = nullptr;
             geometry.geometry.triangles = &m_rayTracingTrianglesData[i];
             
-            // 使用合并的顶点缓冲区
-            if (!m_rayTracingResource.mergedVertexBuffer) {
-                LOG_ERROR("[RenderResource::createRayTracingResource] Merged vertex buffer is null for object {}", i);
+            // 直接使用对象自身的顶点缓冲区
+            if (!renderObject.vertexBuffer || !renderObject.indexBuffer) {
+                LOG_ERROR("[RenderResource::createRayTracingResource] Vertex/index buffer is null for object {}", i);
                 return false;
             }
-            // LOG_DEBUG("[RenderResource::createRayTracingResource] Using merged vertex buffer for object {}, vertex offset: {}, vertex count: {}", i, vertexOffset, renderObject.vertices.size());
             
-            // 设置顶点数据地址（基地址 + 偏移）
-            uint64_t baseVertexAddress = m_rhi->getBufferDeviceAddress(m_rayTracingResource.mergedVertexBuffer);
-            geometry.geometry.triangles->vertexData.deviceAddress = baseVertexAddress + (vertexOffset * sizeof(Vertex));
+            geometry.geometry.triangles->vertexData.deviceAddress = m_rhi->getBufferDeviceAddress(renderObject.vertexBuffer);
             geometry.geometry.triangles->vertexStride = sizeof(Vertex);
             geometry.geometry.triangles->maxVertex = static_cast<uint32_t>(renderObject.vertices.size() - 1); // maxVertex 是最大索引值
             geometry.geometry.triangles->vertexFormat = RHI_FORMAT_R32G32B32_SFLOAT;
             
-            // 使用合并的索引缓冲区
-            if (!m_rayTracingResource.mergedIndexBuffer) {
-                LOG_ERROR("[RenderResource::createRayTracingResource] Merged index buffer is null for object {}", i);
-                return false;
-            }
-            // LOG_DEBUG("[RenderResource::createRayTracingResource] Using merged index buffer for object {}, index offset: {}, index count: {}", i, indexOffset, renderObject.indices.size());
-            
-            // 设置索引数据地址（基地址 + 偏移）
-            uint64_t baseIndexAddress = m_rhi->getBufferDeviceAddress(m_rayTracingResource.mergedIndexBuffer);
-            geometry.geometry.triangles->indexData.deviceAddress = baseIndexAddress + (indexOffset * sizeof(uint32_t));
+            // 直接使用对象自身的索引缓冲区
+            geometry.geometry.triangles->indexData.deviceAddress = m_rhi->getBufferDeviceAddress(renderObject.indexBuffer);
             geometry.geometry.triangles->indexType = RHI_INDEX_TYPE_UINT32;
             geometry.geometry.triangles->transformData.deviceAddress = 0; // 暂时不使用变换数据
             geometry.flags = RHI_GEOMETRY_OPAQUE_BIT_KHR;
@@ -1411,9 +1812,8 @@ namespace Elish
             RHIAccelerationStructureBuildGeometryInfoKHR buildInfo{};
             buildInfo.sType = RHI_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
             buildInfo.type = RHI_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
-            // 优化构建标志：允许更新以支持动态场景，同时保持快速追踪
-            buildInfo.flags = RHI_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR | 
-                             RHI_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR;
+            // 网格数据静态，动画通过实例变换实现：构建一次并压缩，结果写入磁盘缓存
+            buildInfo.flags = k_blasBuildFlags;
             buildInfo.geometryCount = 1;
             buildInfo.pGeometries = &geometry;
             
@@ -1426,12 +1826,28 @@ namespace Elish
             m_rhi->getAccelerationStructureBuildSizes(&buildInfo, &primitiveCount, &sizeInfo);
             // LOG_DEBUG("[createRayTracingResource] [RenderResource::createRayTracingResource] Object {} BLAS size: {}", i, sizeInfo.accelerationStructureSize);
             
+            // 缓存命中且与当前设备兼容时，按反序列化所需大小创建BLAS
+            RHIDeviceSize blasSize = sizeInfo.accelerationStructureSize;
+            meshHashes[i] = AccelerationStructureCache::hashMesh(
+                renderObject.vertices.data(), renderObject.vertices.size() * sizeof(Vertex),
+                renderObject.indices.data(), renderObject.indices.size(), k_blasBuildFlags);
+            if (m_accelerationStructureCache.load(meshHashes[i], cachedBlobs[i])) {
+                RHIDeviceSize deserializedSize = AccelerationStructureCache::getDeserializedSize(cachedBlobs[i]);
+                if (deserializedSize > 0 && m_rhi->isAccelerationStructureCompatible(cachedBlobs[i].data())) {
+                    blasSize = deserializedSize;
+                } else {
+                    LOG_INFO("[RenderResource::createRayTracingResource] Cached BLAS {} incompatible with current device, rebuilding", i);
+                    m_accelerationStructureCache.remove(meshHashes[i]);
+                    cachedBlobs[i].clear();
+                }
+            }
+            
             // 为BLAS创建缓冲区
             RHIBufferCreateInfo bufferCreateInfo{};
             bufferCreateInfo.sType = RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
             bufferCreateInfo.pNext = nullptr;
             bufferCreateInfo.flags = 0;
-            bufferCreateInfo.size = sizeInfo.accelerationStructureSize;
+            bufferCreateInfo.size = blasSize;
             bufferCreateInfo.usage = RHI_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | RHI_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
             bufferCreateInfo.sharingMode = RHI_SHARING_MODE_EXCLUSIVE;
             bufferCreateInfo.queueFamilyIndexCount = 0;
@@ -1468,7 +1884,7 @@ namespace Elish
             RHIAccelerationStructureCreateInfo createInfo{};
             createInfo.sType = RHI_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
             createInfo.type = RHI_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
-            createInfo.size = sizeInfo.accelerationStructureSize;
+            createInfo.size = blasSize;
             createInfo.buffer = blasBuffer;
             createInfo.offset = 0;
             
@@ -1482,11 +1898,12 @@ namespace Elish
             // 存储当前对象的缓冲区信息
             m_rayTracingResource.bottomLevelASBuffers[i] = blasBuffer;
             m_rayTracingResource.bottomLevelASAllocations[i] = blasBufferAllocation;
-            
-            // 更新偏移量以便下一个对象使用
-            vertexOffset += renderObject.vertices.size();
-            indexOffset += renderObject.indices.size();
-            LOG_DEBUG("[createRayTracingResource] Updated offsets - vertex: {}, index: {}", vertexOffset, indexOffset);
+        }
+        
+        // 反序列化缓存命中的BLAS，构建其余BLAS并压缩、写回缓存
+        if (!initializeBottomLevelAccelerationStructures(meshHashes, cachedBlobs)) {
+            LOG_ERROR("[RenderResource::createRayTracingResource] Failed to initialize bottom level acceleration structures");
+            return false;
         }
         
         // 创建顶层加速结构（TLAS）
@@ -1615,17 +2032,6 @@ namespace Elish
         m_rayTracingResource.tlas = m_rayTracingResource.topLevelAS;
         LOG_DEBUG("[RenderResource::createRayTracingResource] Set tlas pointer to topLevelAS");
         
-        // 创建合并的顶点和索引缓冲区（用于光线追踪着色器绑定）
-        if (!m_RenderObjects.empty()) {
-            if (!createMergedVertexIndexBuffers()) {
-                LOG_ERROR("[RenderResource::createRayTracingResource] Failed to create merged vertex/index buffers");
-                return false;
-            }
-            LOG_DEBUG("[RenderResource::createRayTracingResource] Created merged vertex and index buffers for ray tracing");
-        } else {
-            LOG_WARN("[RenderResource::createRayTracingResource] No render objects available for vertex/index buffer setup");
-        }
-        
         // 初始化暂存缓冲区重用机制
         m_rayTracingResource.scratchBuffer = nullptr;
         m_rayTracingResource.scratchBufferAllocation = VK_NULL_HANDLE;
@@ -1633,6 +2039,9 @@ namespace Elish
         m_rayTracingResource.scratchBufferInUse = false;
         LOG_DEBUG("[RenderResource::createRayTracingResource] Initialized scratch buffer reuse mechanism");
         
+        // 实例记录由计算着色器生成，创建失败时退回CPU打包
+        createTlasInstancePipeline(pipelineCache);
+        
         m_rayTracingResourceCreated = true;
         LOG_INFO("[RenderResource::createRayTracingResource] Ray tracing resource created successfully");
         
@@ -1640,191 +2049,693 @@ namespace Elish
     }
     
     /**
-     * @brief 创建合并的顶点和索引缓冲区（用于光线追踪）
-     * @return 创建是否成功
+     * @brief 初始化底层加速结构
+     * @details 缓存命中的BLAS直接反序列化；其余BLAS构建后压缩，再序列化写入磁盘缓存供下次启动使用。
+     *          仅在加载阶段调用，各步骤使用单次命令缓冲区同步执行
+     * @param meshHashes 各对象网格哈希
+     * @param cachedBlobs 各对象的缓存数据，为空表示需要构建
+     * @return 成功返回true
      */
-    bool RenderResource::createMergedVertexIndexBuffers()
+    bool RenderResource::initializeBottomLevelAccelerationStructures(const std::vector<uint64_t>& meshHashes, const std::vector<std::vector<uint8_t>>& cachedBlobs)
     {
-        if (m_RenderObjects.empty()) {
-            LOG_ERROR("[RenderResource::createMergedVertexIndexBuffers] No render objects available");
-            return false;
-        }
-
-        // 计算合并后的顶点和索引总数
-        size_t totalVertices = 0;
-        size_t totalIndices = 0;
-        for (const auto& obj : m_RenderObjects) {
-            totalVertices += obj.vertices.size();
-            totalIndices += obj.indices.size();
-        }
-
-        LOG_DEBUG("[RenderResource::createMergedVertexIndexBuffers] Total vertices: {}, Total indices: {}", totalVertices, totalIndices);
-
-        // 创建合并的顶点数据
-        std::vector<Vertex> mergedVertices;
-        mergedVertices.reserve(totalVertices);
-        
-        std::vector<uint32_t> mergedIndices;
-        mergedIndices.reserve(totalIndices);
-
-        uint32_t vertexOffset = 0;
-        for (const auto& obj : m_RenderObjects) {
-            // 复制顶点数据
-            mergedVertices.insert(mergedVertices.end(), obj.vertices.begin(), obj.vertices.end());
-            
-            // 复制索引数据并调整偏移（使用当前的vertexOffset）
-            for (uint32_t index : obj.indices) {
-                mergedIndices.push_back(index + vertexOffset);
-            }
-            
-            // 更新偏移量以便下一个对象使用
-            vertexOffset += static_cast<uint32_t>(obj.vertices.size());
-            LOG_DEBUG("[RenderResource::createMergedVertexIndexBuffers] Object processed, new vertex offset: {}", vertexOffset);
-        }
-
-        // 创建合并的顶点缓冲区
-        RHIDeviceSize vertexBufferSize = sizeof(Vertex) * mergedVertices.size();
-        
-        // 获取VulkanRHI的VMA分配器
         VulkanRHI* vulkanRHI = static_cast<VulkanRHI*>(m_rhi.get());
         VmaAllocator allocator = vulkanRHI->getAssetsAllocator();
         
-        // 创建暂存缓冲区用于顶点数据
-        RHIBuffer* vertexStagingBuffer = nullptr;
-        VmaAllocation vertexStagingAllocation = nullptr;
+        // 序列化/反序列化与构建暂存地址的对齐要求（取规范允许的最大值）
+        constexpr RHIDeviceSize k_addressAlignment = 256;
         
-        RHIBufferCreateInfo vertexStagingBufferInfo{};
-        vertexStagingBufferInfo.sType = RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        vertexStagingBufferInfo.size = vertexBufferSize;
-        vertexStagingBufferInfo.usage = RHI_BUFFER_USAGE_TRANSFER_SRC_BIT;
-        vertexStagingBufferInfo.sharingMode = RHI_SHARING_MODE_EXCLUSIVE;
+        // 临时缓冲区：多分配一个对齐量，使用向上对齐后的设备地址
+        struct TempBuffer {
+            RHIBuffer* buffer = nullptr;
+            VmaAllocation allocation = nullptr;
+            RHIDeviceAddress alignedAddress = 0;
+            size_t alignedOffset = 0;
+        };
+        std::vector<TempBuffer> tempBuffers;
+        
+        auto createTempBuffer = [&](RHIDeviceSize size, RHIBufferUsageFlags usage, VmaMemoryUsage memoryUsage, TempBuffer& out) -> bool {
+            RHIBufferCreateInfo bufferInfo{};
+            bufferInfo.sType = RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            bufferInfo.size = size + k_addressAlignment;
+            bufferInfo.usage = usage | RHI_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+            bufferInfo.sharingMode = RHI_SHARING_MODE_EXCLUSIVE;
+            
+            VmaAllocationCreateInfo allocInfo{};
+            allocInfo.usage = memoryUsage;
+            VmaAllocationInfo allocInfoResult = {};
+            if (!m_rhi->createBufferVMA(allocator, &bufferInfo, &allocInfo, out.buffer, &out.allocation, &allocInfoResult)) {
+                return false;
+            }
+            RHIDeviceAddress baseAddress = m_rhi->getBufferDeviceAddress(out.buffer);
+            out.alignedAddress = (baseAddress + k_addressAlignment - 1) & ~(k_addressAlignment - 1);
+            out.alignedOffset = static_cast<size_t>(out.alignedAddress - baseAddress);
+            tempBuffers.push_back(out);
+            return true;
+        };
         
-        VmaAllocationCreateInfo vertexStagingAllocInfo{};
-        vertexStagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+        auto releaseTempBuffers = [&]() {
+            for (auto& temp : tempBuffers) {
+                vmaDestroyBuffer(allocator, static_cast<VulkanBuffer*>(temp.buffer)->getResource(), temp.allocation);
+                delete temp.buffer;
+            }
+            tempBuffers.clear();
+        };
         
-        VmaAllocationInfo vertexStagingAllocInfoResult = {};
+        // 上一次提交写入的加速结构在本次提交中被读取
+        auto insertAccelerationStructureBarrier = [&](RHICommandBuffer* commandBuffer) {
+            RHIMemoryBarrier barrier{};
+            barrier.sType = RHI_STRUCTURE_TYPE_MEMORY_BARRIER;
+            barrier.srcAccessMask = RHI_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+            barrier.dstAccessMask = RHI_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+            m_rhi->cmdPipelineBarrier(commandBuffer,
+                RHI_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                RHI_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                0, 1, &barrier, 0, nullptr, 0, nullptr);
+        };
         
-        if (!m_rhi->createBufferVMA(allocator, &vertexStagingBufferInfo, &vertexStagingAllocInfo, vertexStagingBuffer, &vertexStagingAllocation, &vertexStagingAllocInfoResult)) {
-            LOG_ERROR("[RenderResource::createMergedVertexIndexBuffers] Failed to create vertex staging buffer");
+        // 1. 反序列化缓存命中的BLAS，构建其余BLAS
+        std::vector<size_t> builtIndices;
+        bool success = true;
+        RHICommandBuffer* commandBuffer = m_rhi->beginSingleTimeCommands();
+        if (!commandBuffer) {
+            LOG_ERROR("[RenderResource::initializeBottomLevelAccelerationStructures] Failed to begin command buffer");
             return false;
         }
         
-        // 复制顶点数据到暂存缓冲区
-        void* vertexData = nullptr;
-        if (vmaMapMemory(allocator, vertexStagingAllocation, &vertexData) == VK_SUCCESS) {
-            memcpy(vertexData, mergedVertices.data(), static_cast<size_t>(vertexBufferSize));
-            vmaUnmapMemory(allocator, vertexStagingAllocation);
-        } else {
-            LOG_ERROR("[RenderResource::createMergedVertexIndexBuffers] Failed to map vertex staging buffer memory");
-            return false;
+        for (size_t i = 0; i < m_RenderObjects.size() && success; ++i) {
+            if (!cachedBlobs[i].empty()) {
+                TempBuffer staging;
+                void* mappedData = nullptr;
+                if (!createTempBuffer(cachedBlobs[i].size(),
+                                      RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT | RHI_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR,
+                                      VMA_MEMORY_USAGE_CPU_TO_GPU, staging) ||
+                    vmaMapMemory(allocator, staging.allocation, &mappedData) != VK_SUCCESS) {
+                    LOG_ERROR("[RenderResource::initializeBottomLevelAccelerationStructures] Failed to create staging buffer for cached BLAS {}", i);
+                    success = false;
+                    break;
+                }
+                memcpy(static_cast<uint8_t*>(mappedData) + staging.alignedOffset, cachedBlobs[i].data(), cachedBlobs[i].size());
+                vmaFlushAllocation(allocator, staging.allocation, 0, VK_WHOLE_SIZE);
+                vmaUnmapMemory(allocator, staging.allocation);
+                
+                m_rhi->cmdCopyMemoryToAccelerationStructure(commandBuffer, staging.alignedAddress, m_rayTracingResource.bottomLevelAS[i]);
+                continue;
+            }
+            
+            const auto& renderObject = m_RenderObjects[i];
+            uint32_t primitiveCount = static_cast<uint32_t>(renderObject.indices.size() / 3);
+            
+            RHIAccelerationStructureGeometry geometry{};
+            geometry.sType = RHI_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
+            geometry.geometryType = RHI_GEOMETRY_TYPE_TRIANGLES_KHR;
+            geometry.geometry.triangles = &m_rayTracingTrianglesData[i];
+            geometry.flags = RHI_GEOMETRY_OPAQUE_BIT_KHR;
+            geometry.primitiveCount = primitiveCount;
+            
+            RHIAccelerationStructureBuildGeometryInfoKHR buildInfo{};
+            buildInfo.sType = RHI_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
+            buildInfo.type = RHI_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+            buildInfo.flags = k_blasBuildFlags;
+            buildInfo.geometryCount = 1;
+            buildInfo.pGeometries = &geometry;
+            
+            RHIAccelerationStructureBuildSizesInfoKHR sizeInfo{};
+            m_rhi->getAccelerationStructureBuildSizes(&buildInfo, &primitiveCount, &sizeInfo);
+            
+            TempBuffer scratch;
+            if (!createTempBuffer(sizeInfo.buildScratchSize, RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY, scratch)) {
+                LOG_ERROR("[RenderResource::initializeBottomLevelAccelerationStructures] Failed to create scratch buffer for BLAS {}", i);
+                success = false;
+                break;
+            }
+            
+            RHIAccelerationStructureBuildInfo rhiBuildInfo{};
+            rhiBuildInfo.type = RHI_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+            rhiBuildInfo.flags = k_blasBuildFlags;
+            rhiBuildInfo.mode = RHI_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+            rhiBuildInfo.dstAccelerationStructure = m_rayTracingResource.bottomLevelAS[i];
+            rhiBuildInfo.geometryCount = 1;
+            rhiBuildInfo.pGeometries = &geometry;
+            rhiBuildInfo.scratchData.deviceAddress = scratch.alignedAddress;
+            
+            if (!m_rhi->buildAccelerationStructure(commandBuffer, &rhiBuildInfo)) {
+                LOG_ERROR("[RenderResource::initializeBottomLevelAccelerationStructures] Failed to build BLAS {}", i);
+                success = false;
+                break;
+            }
+            builtIndices.push_back(i);
         }
         
-        // 创建设备本地顶点缓冲区
-        RHIBufferCreateInfo vertexBufferInfo{};
-        vertexBufferInfo.sType = RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        vertexBufferInfo.size = vertexBufferSize;
-        vertexBufferInfo.usage = RHI_BUFFER_USAGE_TRANSFER_DST_BIT | RHI_BUFFER_USAGE_VERTEX_BUFFER_BIT | 
-                                RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT | RHI_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
-        vertexBufferInfo.sharingMode = RHI_SHARING_MODE_EXCLUSIVE;
-        
-        VmaAllocationCreateInfo vertexAllocInfo{};
-        vertexAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-        
-        VmaAllocationInfo vertexAllocInfoResult = {};
-        
-        if (!m_rhi->createBufferVMA(allocator, &vertexBufferInfo, &vertexAllocInfo, m_rayTracingResource.mergedVertexBuffer, &m_rayTracingResource.mergedVertexAllocation, &vertexAllocInfoResult)) {
-            LOG_ERROR("[RenderResource::createMergedVertexIndexBuffers] Failed to create vertex buffer");
+        m_rhi->endSingleTimeCommands(commandBuffer);
+        releaseTempBuffers();
+        if (!success) {
             return false;
         }
         
-        // 设置兼容性别名
-        m_rayTracingResource.vertex_buffer = m_rayTracingResource.mergedVertexBuffer;
+        LOG_INFO("[RenderResource::initializeBottomLevelAccelerationStructures] {} BLAS loaded from cache, {} built",
+                 m_RenderObjects.size() - builtIndices.size(), builtIndices.size());
         
-        // 从暂存缓冲区复制到顶点缓冲区
-        m_rhi->copyBuffer(vertexStagingBuffer, m_rayTracingResource.mergedVertexBuffer, 0, 0, vertexBufferSize);
+        if (builtIndices.empty()) {
+            m_rayTracingResource.bottomLevelASBuilt = true;
+            return true;
+        }
         
-        LOG_DEBUG("[RenderResource::createMergedVertexIndexBuffers] Vertex buffer copy initiated, size: {} bytes", vertexBufferSize);
-
-        // 创建合并的索引缓冲区
-        RHIDeviceSize indexBufferSize = sizeof(uint32_t) * mergedIndices.size();
+        std::vector<RHIAccelerationStructure*> builtStructures;
+        for (size_t index : builtIndices) {
+            builtStructures.push_back(m_rayTracingResource.bottomLevelAS[index]);
+        }
         
-        // 创建暂存缓冲区用于索引数据
-        RHIBuffer* indexStagingBuffer = nullptr;
-        VmaAllocation indexStagingAllocation = nullptr;
+        // 2. 压缩新构建的BLAS
+        std::vector<RHIDeviceSize> compactedSizes(builtIndices.size(), 0);
+        if (m_rhi->queryAccelerationStructureSizes(static_cast<uint32_t>(builtStructures.size()), builtStructures.data(),
+                                                   RHI_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR, compactedSizes.data())) {
+            struct ReplacedStructure {
+                RHIAccelerationStructure* accelerationStructure;
+                RHIBuffer* buffer;
+                VmaAllocation allocation;
+            };
+            std::vector<ReplacedStructure> replaced;
+            
+            commandBuffer = m_rhi->beginSingleTimeCommands();
+            insertAccelerationStructureBarrier(commandBuffer);
+            for (size_t k = 0; k < builtIndices.size(); ++k) {
+                size_t index = builtIndices[k];
+                
+                RHIBufferCreateInfo bufferInfo{};
+                bufferInfo.sType = RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+                bufferInfo.size = compactedSizes[k];
+                bufferInfo.usage = RHI_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | RHI_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+                bufferInfo.sharingMode = RHI_SHARING_MODE_EXCLUSIVE;
+                
+                VmaAllocationCreateInfo allocInfo{};
+                allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+                VmaAllocationInfo allocInfoResult = {};
+                
+                RHIBuffer* compactedBuffer = nullptr;
+                VmaAllocation compactedAllocation = nullptr;
+                if (!m_rhi->createBufferVMA(allocator, &bufferInfo, &allocInfo, compactedBuffer, &compactedAllocation, &allocInfoResult)) {
+                    LOG_WARN("[RenderResource::initializeBottomLevelAccelerationStructures] Failed to create compacted buffer for BLAS {}, keeping uncompacted", index);
+                    continue;
+                }
+                
+                RHIAccelerationStructureCreateInfo createInfo{};
+                createInfo.sType = RHI_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
+                createInfo.type = RHI_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+                createInfo.size = compactedSizes[k];
+                createInfo.buffer = compactedBuffer;
+                
+                RHIAccelerationStructure* compactedStructure = nullptr;
+                if (m_rhi->createAccelerationStructure(&createInfo, compactedStructure) != RHI_SUCCESS) {
+                    LOG_WARN("[RenderResource::initializeBottomLevelAccelerationStructures] Failed to create compacted BLAS {}, keeping uncompacted", index);
+                    vmaDestroyBuffer(allocator, static_cast<VulkanBuffer*>(compactedBuffer)->getResource(), compactedAllocation);
+                    delete compactedBuffer;
+                    continue;
+                }
+                
+                m_rhi->cmdCopyAccelerationStructure(commandBuffer, m_rayTracingResource.bottomLevelAS[index], compactedStructure,
+                                                    RHI_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR);
+                
+                replaced.push_back({ m_rayTracingResource.bottomLevelAS[index],
+                                     m_rayTracingResource.bottomLevelASBuffers[index],
+                                     m_rayTracingResource.bottomLevelASAllocations[index] });
+                m_rayTracingResource.bottomLevelAS[index] = compactedStructure;
+                m_rayTracingResource.bottomLevelASBuffers[index] = compactedBuffer;
+                m_rayTracingResource.bottomLevelASAllocations[index] = compactedAllocation;
+                builtStructures[k] = compactedStructure;
+            }
+            m_rhi->endSingleTimeCommands(commandBuffer);
+            
+            // 复制完成后释放未压缩的BLAS
+            for (auto& old : replaced) {
+                m_rhi->destroyAccelerationStructure(old.accelerationStructure);
+                vmaDestroyBuffer(allocator, static_cast<VulkanBuffer*>(old.buffer)->getResource(), old.allocation);
+                delete old.buffer;
+            }
+        } else {
+            LOG_WARN("[RenderResource::initializeBottomLevelAccelerationStructures] Compacted size query failed, keeping uncompacted BLAS");
+        }
         
-        RHIBufferCreateInfo indexStagingBufferInfo{};
-        indexStagingBufferInfo.sType = RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        indexStagingBufferInfo.size = indexBufferSize;
-        indexStagingBufferInfo.usage = RHI_BUFFER_USAGE_TRANSFER_SRC_BIT;
-        indexStagingBufferInfo.sharingMode = RHI_SHARING_MODE_EXCLUSIVE;
+        m_rayTracingResource.bottomLevelASBuilt = true;
         
-        VmaAllocationCreateInfo indexStagingAllocInfo{};
-        indexStagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+        // 3. 序列化并写入磁盘缓存（失败不影响本次运行）
+        std::vector<RHIDeviceSize> serializedSizes(builtIndices.size(), 0);
+        if (!m_rhi->queryAccelerationStructureSizes(static_cast<uint32_t>(builtStructures.size()), builtStructures.data(),
+                                                    RHI_QUERY_TYPE_ACCELERATION_STRUCTURE_SERIALIZATION_SIZE_KHR, serializedSizes.data())) {
+            LOG_WARN("[RenderResource::initializeBottomLevelAccelerationStructures] Serialization size query failed, cache not written");
+            return true;
+        }
         
-        VmaAllocationInfo indexStagingAllocInfoResult = {};
+        std::vector<TempBuffer> readbacks(builtIndices.size());
+        std::vector<bool> recorded(builtIndices.size(), false);
+        commandBuffer = m_rhi->beginSingleTimeCommands();
+        insertAccelerationStructureBarrier(commandBuffer);
+        for (size_t k = 0; k < builtIndices.size(); ++k) {
+            if (serializedSizes[k] == 0 ||
+                !createTempBuffer(serializedSizes[k], RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU, readbacks[k])) {
+                continue;
+            }
+            m_rhi->cmdCopyAccelerationStructureToMemory(commandBuffer, builtStructures[k], readbacks[k].alignedAddress);
+            recorded[k] = true;
+        }
+        m_rhi->endSingleTimeCommands(commandBuffer);
         
-        if (!m_rhi->createBufferVMA(allocator, &indexStagingBufferInfo, &indexStagingAllocInfo, indexStagingBuffer, &indexStagingAllocation, &indexStagingAllocInfoResult)) {
-            LOG_ERROR("[RenderResource::createMergedVertexIndexBuffers] Failed to create index staging buffer");
-            return false;
+        size_t storedCount = 0;
+        for (size_t k = 0; k < builtIndices.size(); ++k) {
+            void* mappedData = nullptr;
+            if (!recorded[k] || vmaMapMemory(allocator, readbacks[k].allocation, &mappedData) != VK_SUCCESS) {
+                continue;
+            }
+            vmaInvalidateAllocation(allocator, readbacks[k].allocation, 0, VK_WHOLE_SIZE);
+            if (m_accelerationStructureCache.store(meshHashes[builtIndices[k]],
+                                                   static_cast<uint8_t*>(mappedData) + readbacks[k].alignedOffset,
+                                                   static_cast<size_t>(serializedSizes[k]))) {
+                storedCount++;
+            }
+            vmaUnmapMemory(allocator, readbacks[k].allocation);
         }
+        releaseTempBuffers();
         
-        // 复制索引数据到暂存缓冲区
-        void* indexData = nullptr;
-        if (vmaMapMemory(allocator, indexStagingAllocation, &indexData) == VK_SUCCESS) {
-            memcpy(indexData, mergedIndices.data(), static_cast<size_t>(indexBufferSize));
-            vmaUnmapMemory(allocator, indexStagingAllocation);
-        } else {
-            LOG_ERROR("[RenderResource::createMergedVertexIndexBuffers] Failed to map index staging buffer memory");
+        LOG_INFO("[RenderResource::initializeBottomLevelAccelerationStructures] Wrote {} BLAS to cache", storedCount);
+        return true;
+    }
+    
+    /**
+     * @brief 创建或重建实例几何地址表
+     * @return 创建是否成功
+     */
+    bool RenderResource::updateRayTracingGeometryTable()
+    {
+        if (m_RenderObjects.empty()) {
+            LOG_ERROR("[RenderResource::updateRayTracingGeometryTable] No render objects available");
             return false;
         }
         
-        // 创建设备本地索引缓冲区
-        RHIBufferCreateInfo indexBufferInfo{};
-        indexBufferInfo.sType = RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        indexBufferInfo.size = indexBufferSize;
-        indexBufferInfo.usage = RHI_BUFFER_USAGE_TRANSFER_DST_BIT | RHI_BUFFER_USAGE_INDEX_BUFFER_BIT | 
-                               RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT | RHI_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
-        indexBufferInfo.sharingMode = RHI_SHARING_MODE_EXCLUSIVE;
+        // 旧表可能仍被在途帧读取，重建前等待设备空闲（仅在实例集合变化时发生）
+        if (m_rayTracingResource.geometryAddressBuffer) {
+            m_rhi->waitForFences();
+            if (auto graphics_queue = m_rhi->getGraphicsQueue()) {
+                m_rhi->queueWaitIdle(graphics_queue);
+            }
+            destroyRayTracingGeometryTable();
+        }
         
-        VmaAllocationCreateInfo indexAllocInfo{};
-        indexAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+        VulkanRHI* vulkanRHI = static_cast<VulkanRHI*>(m_rhi.get());
+        VmaAllocator allocator = vulkanRHI->getAssetsAllocator();
+        
+        // 材质与地址表均为小型只读数据，直接放在主机可见内存中，无需暂存缓冲区
+        VmaAllocationCreateInfo allocInfo{};
+        allocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
         
-        VmaAllocationInfo indexAllocInfoResult = {};
+        RHIBufferCreateInfo materialBufferInfo{};
+        materialBufferInfo.sType = RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        materialBufferInfo.size = sizeof(RayTracingMaterialData) * m_RenderObjects.size();
+        materialBufferInfo.usage = RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT | RHI_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        materialBufferInfo.sharingMode = RHI_SHARING_MODE_EXCLUSIVE;
         
-        if (!m_rhi->createBufferVMA(allocator, &indexBufferInfo, &indexAllocInfo, m_rayTracingResource.mergedIndexBuffer, &m_rayTracingResource.mergedIndexAllocation, &indexAllocInfoResult)) {
-            LOG_ERROR("[RenderResource::createMergedVertexIndexBuffers] Failed to create index buffer");
+        VmaAllocationInfo materialAllocInfoResult = {};
+        if (!m_rhi->createBufferVMA(allocator, &materialBufferInfo, &allocInfo, m_rayTracingResource.materialBuffer, &m_rayTracingResource.materialAllocation, &materialAllocInfoResult)) {
+            LOG_ERROR("[RenderResource::updateRayTracingGeometryTable] Failed to create material buffer");
             return false;
         }
         
-        // 设置兼容性别名
-        m_rayTracingResource.index_buffer = m_rayTracingResource.mergedIndexBuffer;
+        RHIBufferCreateInfo tableBufferInfo{};
+        tableBufferInfo.sType = RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        tableBufferInfo.size = sizeof(RayTracingGeometryAddress) * m_RenderObjects.size();
+        tableBufferInfo.usage = RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT | RHI_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        tableBufferInfo.sharingMode = RHI_SHARING_MODE_EXCLUSIVE;
         
-        // 从暂存缓冲区复制到索引缓冲区
-        m_rhi->copyBuffer(indexStagingBuffer, m_rayTracingResource.mergedIndexBuffer, 0, 0, indexBufferSize);
+        VmaAllocationInfo tableAllocInfoResult = {};
+        if (!m_rhi->createBufferVMA(allocator, &tableBufferInfo, &allocInfo, m_rayTracingResource.geometryAddressBuffer, &m_rayTracingResource.geometryAddressAllocation, &tableAllocInfoResult)) {
+            LOG_ERROR("[RenderResource::updateRayTracingGeometryTable] Failed to create geometry address buffer");
+            destroyRayTracingGeometryTable();
+            return false;
+        }
         
-        LOG_DEBUG("[RenderResource::createMergedVertexIndexBuffers] Index buffer copy initiated, size: {} bytes", indexBufferSize);
+        std::vector<RayTracingMaterialData> materials(m_RenderObjects.size());
+        std::vector<RayTracingGeometryAddress> addresses(m_RenderObjects.size());
+        RHIDeviceAddress materialBaseAddress = m_rhi->getBufferDeviceAddress(m_rayTracingResource.materialBuffer);
         
-        // 等待GPU完成所有复制操作后再清理临时缓冲区
-        // 这是防止验证层报错和数据损坏的关键步骤
-        m_rhi->waitForFences();
-        if (auto graphics_queue = m_rhi->getGraphicsQueue()) {
-            m_rhi->queueWaitIdle(graphics_queue);
+        for (size_t i = 0; i < m_RenderObjects.size(); ++i) {
+            const auto& renderObject = m_RenderObjects[i];
+            if (!renderObject.vertexBuffer || !renderObject.indexBuffer) {
+                LOG_ERROR("[RenderResource::updateRayTracingGeometryTable] Vertex/index buffer is null for object {}", i);
+                destroyRayTracingGeometryTable();
+                return false;
+            }
+            
+            // 纹理尚未接入光线追踪，使用顶点色作为反照率；粗糙度取贴图下界，反射通道据此保守地跳过整体粗糙的物体
+            materials[i].roughnessParams.x = renderObject.minRoughness;
+            materials[i].roughnessParams.y = 1.0f;
+            
+            addresses[i].vertexAddress = m_rhi->getBufferDeviceAddress(renderObject.vertexBuffer);
+            addresses[i].indexAddress = m_rhi->getBufferDeviceAddress(renderObject.indexBuffer);
+            addresses[i].materialAddress = materialBaseAddress + i * sizeof(RayTracingMaterialData);
+            addresses[i].vertexCount = static_cast<uint32_t>(renderObject.vertices.size());
+            addresses[i].indexCount = static_cast<uint32_t>(renderObject.indices.size());
         }
         
-        LOG_DEBUG("[RenderResource::createMergedVertexIndexBuffers] GPU operations completed, cleaning up staging buffers");
+        void* mappedData = nullptr;
+        if (vmaMapMemory(allocator, m_rayTracingResource.materialAllocation, &mappedData) != VK_SUCCESS) {
+            LOG_ERROR("[RenderResource::updateRayTracingGeometryTable] Failed to map material buffer memory");
+            destroyRayTracingGeometryTable();
+            return false;
+        }
+        memcpy(mappedData, materials.data(), static_cast<size_t>(materialBufferInfo.size));
+        vmaUnmapMemory(allocator, m_rayTracingResource.materialAllocation);
         
-        // GPU完成后安全清理顶点暂存缓冲区
-        vmaDestroyBuffer(allocator, static_cast<VulkanBuffer*>(vertexStagingBuffer)->getResource(), vertexStagingAllocation);
-        delete vertexStagingBuffer;
+        if (vmaMapMemory(allocator, m_rayTracingResource.geometryAddressAllocation, &mappedData) != VK_SUCCESS) {
+            LOG_ERROR("[RenderResource::updateRayTracingGeometryTable] Failed to map geometry address buffer memory");
+            destroyRayTracingGeometryTable();
+            return false;
+        }
+        memcpy(mappedData, addresses.data(), static_cast<size_t>(tableBufferInfo.size));
+        vmaUnmapMemory(allocator, m_rayTracingResource.geometryAddressAllocation);
         
-        // GPU完成后安全清理索引暂存缓冲区
-        vmaDestroyBuffer(allocator, static_cast<VulkanBuffer*>(indexStagingBuffer)->getResource(), indexStagingAllocation);
-        delete indexStagingBuffer;
-
-        LOG_INFO("[RenderResource::createMergedVertexIndexBuffers] Successfully created merged vertex and index buffers");
+        m_rayTracingResource.geometryAddressCount = static_cast<uint32_t>(addresses.size());
+        
+        LOG_INFO("[RenderResource::updateRayTracingGeometryTable] Geometry address table created for {} instances", addresses.size());
         return true;
     }
     
+    /**
+     * @brief 销毁实例几何地址表与材质缓冲区
+     */
+    void RenderResource::destroyRayTracingGeometryTable()
+    {
+        VmaAllocator allocator = static_cast<VulkanRHI*>(m_rhi.get())->getAssetsAllocator();
+        
+        if (m_rayTracingResource.geometryAddressBuffer) {
+            vmaDestroyBuffer(allocator,
+                static_cast<VulkanBuffer*>(m_rayTracingResource.geometryAddressBuffer)->getResource(),
+                m_rayTracingResource.geometryAddressAllocation);
+            delete m_rayTracingResource.geometryAddressBuffer;
+            m_rayTracingResource.geometryAddressBuffer = nullptr;
+            m_rayTracingResource.geometryAddressAllocation = nullptr;
+        }
+        if (m_rayTracingResource.materialBuffer) {
+            vmaDestroyBuffer(allocator,
+                static_cast<VulkanBuffer*>(m_rayTracingResource.materialBuffer)->getResource(),
+                m_rayTracingResource.materialAllocation);
+            delete m_rayTracingResource.materialBuffer;
+            m_rayTracingResource.materialBuffer = nullptr;
+            m_rayTracingResource.materialAllocation = nullptr;
+        }
+        m_rayTracingResource.geometryAddressCount = 0;
+    }
+
+    /**
+     * @brief 销毁实例缓冲区与实例源数据缓冲区
+     */
+    void RenderResource::destroyRayTracingInstanceBuffers()
+    {
+        VmaAllocator allocator = static_cast<VulkanRHI*>(m_rhi.get())->getAssetsAllocator();
+
+        if (m_rayTracingResource.instanceBuffer) {
+            vmaDestroyBuffer(allocator,
+                static_cast<VulkanBuffer*>(m_rayTracingResource.instanceBuffer)->getResource(),
+                m_rayTracingResource.instanceAllocation);
+            delete m_rayTracingResource.instanceBuffer;
+            m_rayTracingResource.instanceBuffer = nullptr;
+            m_rayTracingResource.instanceAllocation = nullptr;
+        }
+        if (m_rayTracingResource.instanceSourceBuffer) {
+            vmaDestroyBuffer(allocator,
+                static_cast<VulkanBuffer*>(m_rayTracingResource.instanceSourceBuffer)->getResource(),
+                m_rayTracingResource.instanceSourceAllocation);
+            delete m_rayTracingResource.instanceSourceBuffer;
+            m_rayTracingResource.instanceSourceBuffer = nullptr;
+            m_rayTracingResource.instanceSourceAllocation = nullptr;
+        }
+        m_rayTracingInstanceSources.clear();
+        m_rayTracingInstancesData.data.deviceAddress = 0;
+    }
+
+    /**
+     * @brief 创建TLAS实例生成计算管线
+     * @details 管线只有推送常量，缓冲区均通过设备地址访问，不需要描述符集
+     */
+    void RenderResource::createTlasInstancePipeline(const std::shared_ptr<PipelineCache>& pipelineCache)
+    {
+        if (!pipelineCache) {
+            LOG_WARN("[RenderResource::createTlasInstancePipeline] No pipeline cache, instance records will be packed on the CPU");
+            return;
+        }
+
+        struct TlasInstancePushConstants {
+            uint64_t sourceAddress;
+            uint64_t instanceAddress;
+            uint32_t instanceCount;
+        };
+
+        RHIPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = RHI_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(TlasInstancePushConstants);
+
+        RHIPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = RHI_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 0;
+        pipelineLayoutInfo.pSetLayouts = nullptr;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (m_rhi->createPipelineLayout(&pipelineLayoutInfo, m_tlasInstancePipelineLayout) != RHI_SUCCESS) {
+            LOG_WARN("[RenderResource::createTlasInstancePipeline] Failed to create pipeline layout, instance records will be packed on the CPU");
+            m_tlasInstancePipelineLayout = nullptr;
+            return;
+        }
+
+        RHIShader* shaderModule = pipelineCache->getShader(RT_TLAS_INSTANCES_COMP);
+        if (!shaderModule) {
+            LOG_WARN("[RenderResource::createTlasInstancePipeline] Failed to create shader module, instance records will be packed on the CPU");
+            m_rhi->destroyPipelineLayout(m_tlasInstancePipelineLayout);
+            m_tlasInstancePipelineLayout = nullptr;
+            return;
+        }
+
+        RHIPipelineShaderStageCreateInfo stage{};
+        stage.sType = RHI_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stage.stage = RHI_SHADER_STAGE_COMPUTE_BIT;
+        stage.module = shaderModule;
+        stage.pName = "main";
+        stage.pSpecializationInfo = nullptr;
+
+        RHIComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = RHI_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.pStages = &stage;
+        pipelineInfo.layout = m_tlasInstancePipelineLayout;
+        pipelineInfo.basePipelineHandle = RHI_NULL_HANDLE;
+        pipelineInfo.basePipelineIndex = -1;
+
+        m_tlasInstancePipeline = pipelineCache->getOrCreateComputePipeline(pipelineInfo);
+        if (!m_tlasInstancePipeline) {
+            LOG_WARN("[RenderResource::createTlasInstancePipeline] Failed to create compute pipeline, instance records will be packed on the CPU");
+            m_rhi->destroyPipelineLayout(m_tlasInstancePipelineLayout);
+            m_tlasInstancePipelineLayout = nullptr;
+            return;
+        }
+        m_tlasInstancePipelineCache = pipelineCache;
+
+        LOG_DEBUG("[RenderResource::createTlasInstancePipeline] TLAS instance compute pipeline created");
+    }
+
+    /**
+     * @brief 计算渲染对象当前的实例源数据
+     * @details 模型矩阵取自场景实体的世界矩阵，与光栅化各通道使用同一帧的结果
+     */
+    RayTracingInstanceSource RenderResource::buildRayTracingInstanceSource(size_t index) const
+    {
+        const auto& renderObject = m_RenderObjects[index];
+        const glm::mat4& model = getRenderObjectWorldMatrix(index);
+
+        RayTracingInstanceSource source{};
+        // GLM为列主序，实例变换为行主序3x4
+        glm::mat4 rows = glm::transpose(model);
+        source.transformRows[0] = rows[0];
+        source.transformRows[1] = rows[1];
+        source.transformRows[2] = rows[2];
+
+        RHIAccelerationStructureDeviceAddressInfo addressInfo{};
+        addressInfo.sType = RHI_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
+        addressInfo.accelerationStructure = m_rayTracingResource.bottomLevelAS[index];
+        m_rhi->getAccelerationStructureDeviceAddress(&addressInfo, &source.blasAddress);
+
+        // 实例索引即几何地址表的表项索引
+        source.customIndex = static_cast<uint32_t>(index);
+        source.maskAndFlags = static_cast<uint32_t>(renderObject.rayTracingMask) |
+                              ((renderObject.rayTracingInstanceFlags & 0xFFu) << 8);
+        return source;
+    }
+
+    /**
+     * @brief 录制实例缓冲区更新命令
+     * @details 实例源数据与CPU镜像逐条比较，相邻的变化记录合并为一个复制区域；
+     *          计算管线不可用时在CPU上打包变化的实例记录并直接复制到实例缓冲区
+     */
+    void RenderResource::updateRayTracingInstances(RHICommandBuffer* commandBuffer, std::vector<std::pair<RHIBuffer*, VmaAllocation>>& tempBuffers)
+    {
+        VmaAllocator allocator = static_cast<VulkanRHI*>(m_rhi.get())->getAssetsAllocator();
+        uint32_t instanceCount = static_cast<uint32_t>(m_RenderObjects.size());
+        RHIDeviceSize recordSize = sizeof(RayTracingInstanceSource);
+        bool gpuPacking = m_tlasInstancePipeline != nullptr;
+
+        // 实例数量变化时重建缓冲区，旧缓冲区可能仍被在途的构建读取
+        if (!m_rayTracingResource.instanceBuffer || m_rayTracingInstanceSources.size() != instanceCount) {
+            releaseCompletedAccelerationStructureBuilds(true);
+            destroyRayTracingInstanceBuffers();
+
+            RHIBufferCreateInfo bufferInfo{};
+            bufferInfo.sType = RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            bufferInfo.size = recordSize * instanceCount;
+            bufferInfo.usage = RHI_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR | RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                               RHI_BUFFER_USAGE_TRANSFER_DST_BIT | RHI_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+            bufferInfo.sharingMode = RHI_SHARING_MODE_EXCLUSIVE;
+
+            VmaAllocationCreateInfo allocInfo{};
+            allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+            VmaAllocationInfo allocInfoResult = {};
+
+            if (!m_rhi->createBufferVMA(allocator, &bufferInfo, &allocInfo, m_rayTracingResource.instanceBuffer, &m_rayTracingResource.instanceAllocation, &allocInfoResult)) {
+                throw std::runtime_error("Failed to create instance buffer");
+            }
+            if (gpuPacking) {
+                bufferInfo.usage = RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT | RHI_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+                if (!m_rhi->createBufferVMA(allocator, &bufferInfo, &allocInfo, m_rayTracingResource.instanceSourceBuffer, &m_rayTracingResource.instanceSourceAllocation, &allocInfoResult)) {
+                    throw std::runtime_error("Failed to create instance source buffer");
+                }
+            }
+
+            m_rayTracingInstancesData.data.deviceAddress = m_rhi->getBufferDeviceAddress(m_rayTracingResource.instanceBuffer);
+            LOG_DEBUG("[RenderResource::updateRayTracingInstances] Instance buffers created for {} instances ({})", instanceCount, gpuPacking ? "gpu packing" : "cpu packing");
+        }
+
+        // 1. 收集变化的实例，相邻记录合并为一个复制区域
+        std::vector<RayTracingInstanceSource> sources(instanceCount);
+        std::vector<uint32_t> changedIndices;
+        for (uint32_t i = 0; i < instanceCount; ++i) {
+            sources[i] = buildRayTracingInstanceSource(i);
+            if (sources[i].blasAddress == 0) {
+                LOG_ERROR("[RenderResource::updateRayTracingInstances] Failed to get device address for BLAS {}", i);
+                throw std::runtime_error("Failed to get BLAS device address");
+            }
+            if (i >= m_rayTracingInstanceSources.size() ||
+                memcmp(&sources[i], &m_rayTracingInstanceSources[i], sizeof(RayTracingInstanceSource)) != 0) {
+                changedIndices.push_back(i);
+            }
+        }
+        if (changedIndices.empty()) {
+            return;
+        }
+
+        std::vector<RHIBufferCopy> regions;
+        for (size_t n = 0; n < changedIndices.size(); ++n) {
+            RHIDeviceSize srcOffset = recordSize * n;
+            RHIDeviceSize dstOffset = recordSize * changedIndices[n];
+            if (!regions.empty() && regions.back().dstOffset + regions.back().size == dstOffset) {
+                regions.back().size += recordSize;
+            } else {
+                regions.push_back({ srcOffset, dstOffset, recordSize });
+            }
+        }
+
+        // 2. 写入暂存缓冲区：GPU打包时上传源数据，否则上传CPU打包的实例记录
+        RHIBufferCreateInfo stagingInfo{};
+        stagingInfo.sType = RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        stagingInfo.size = recordSize * changedIndices.size();
+        stagingInfo.usage = RHI_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        stagingInfo.sharingMode = RHI_SHARING_MODE_EXCLUSIVE;
+
+        VmaAllocationCreateInfo stagingAllocInfo{};
+        stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+
+        RHIBuffer* stagingBuffer = nullptr;
+        VmaAllocation stagingAllocation = nullptr;
+        VmaAllocationInfo stagingAllocInfoResult = {};
+        if (!m_rhi->createBufferVMA(allocator, &stagingInfo, &stagingAllocInfo, stagingBuffer, &stagingAllocation, &stagingAllocInfoResult)) {
+            throw std::runtime_error("Failed to create instance staging buffer");
+        }
+        tempBuffers.emplace_back(stagingBuffer, stagingAllocation);
+
+        void* mappedData = nullptr;
+        if (vmaMapMemory(allocator, stagingAllocation, &mappedData) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to map instance staging buffer");
+        }
+        for (size_t n = 0; n < changedIndices.size(); ++n) {
+            const RayTracingInstanceSource& source = sources[changedIndices[n]];
+            void* dst = static_cast<uint8_t*>(mappedData) + recordSize * n;
+            if (gpuPacking) {
+                memcpy(dst, &source, sizeof(source));
+                continue;
+            }
+            RHIAccelerationStructureInstanceKHR instance{};
+            memcpy(instance.transform, source.transformRows, sizeof(instance.transform));
+            instance.instanceCustomIndex = source.customIndex;
+            instance.mask = source.maskAndFlags & 0xFFu;
+            instance.instanceShaderBindingTableRecordOffset = 0;
+            instance.flags = (source.maskAndFlags >> 8) & 0xFFu;
+            instance.accelerationStructureReference = source.blasAddress;
+            memcpy(dst, &instance, sizeof(instance));
+        }
+        vmaFlushAllocation(allocator, stagingAllocation, 0, VK_WHOLE_SIZE);
+        vmaUnmapMemory(allocator, stagingAllocation);
+
+        // 3. 复制变化的记录；先等待此前读取这些缓冲区的实例生成与TLAS构建（读后写）
+        RHIMemoryBarrier previousUseBarrier{};
+        previousUseBarrier.sType = RHI_STRUCTURE_TYPE_MEMORY_BARRIER;
+        previousUseBarrier.srcAccessMask = 0;
+        previousUseBarrier.dstAccessMask = 0;
+        m_rhi->cmdPipelineBarrier(
+            commandBuffer,
+            RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT | RHI_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            RHI_PIPELINE_STAGE_TRANSFER_BIT | RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 1, &previousUseBarrier, 0, nullptr, 0, nullptr
+        );
+
+        RHIBuffer* uploadTarget = gpuPacking ? m_rayTracingResource.instanceSourceBuffer : m_rayTracingResource.instanceBuffer;
+        m_rhi->cmdCopyBuffer(commandBuffer, stagingBuffer, uploadTarget, static_cast<uint32_t>(regions.size()), regions.data());
+
+        RHIMemoryBarrier uploadBarrier{};
+        uploadBarrier.sType = RHI_STRUCTURE_TYPE_MEMORY_BARRIER;
+        uploadBarrier.srcAccessMask = RHI_ACCESS_TRANSFER_WRITE_BIT;
+        uploadBarrier.dstAccessMask = gpuPacking ? RHI_ACCESS_SHADER_READ_BIT : RHI_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | RHI_ACCESS_SHADER_READ_BIT;
+        m_rhi->cmdPipelineBarrier(
+            commandBuffer,
+            RHI_PIPELINE_STAGE_TRANSFER_BIT,
+            gpuPacking ? RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT : RHI_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            0, 1, &uploadBarrier, 0, nullptr, 0, nullptr
+        );
+
+        // 4. 计算着色器生成全部实例记录，TLAS构建读取前等待写入完成
+        if (gpuPacking) {
+            struct {
+                uint64_t sourceAddress;
+                uint64_t instanceAddress;
+                uint32_t instanceCount;
+            } pushConstants{};
+            pushConstants.sourceAddress = m_rhi->getBufferDeviceAddress(m_rayTracingResource.instanceSourceBuffer);
+            pushConstants.instanceAddress = m_rayTracingInstancesData.data.deviceAddress;
+            pushConstants.instanceCount = instanceCount;
+
+            m_rhi->cmdBindPipelinePFN(commandBuffer, RHI_PIPELINE_BIND_POINT_COMPUTE, m_tlasInstancePipeline);
+            m_rhi->cmdPushConstantsPFN(commandBuffer, m_tlasInstancePipelineLayout, RHI_SHADER_STAGE_COMPUTE_BIT,
+                                       0, sizeof(pushConstants), &pushConstants);
+            m_rhi->cmdDispatch(commandBuffer, (instanceCount + k_tlasInstanceWorkgroupSize - 1) / k_tlasInstanceWorkgroupSize, 1, 1);
+
+            RHIMemoryBarrier instanceWriteBarrier{};
+            instanceWriteBarrier.sType = RHI_STRUCTURE_TYPE_MEMORY_BARRIER;
+            instanceWriteBarrier.srcAccessMask = RHI_ACCESS_SHADER_WRITE_BIT;
+            instanceWriteBarrier.dstAccessMask = RHI_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | RHI_ACCESS_SHADER_READ_BIT;
+            m_rhi->cmdPipelineBarrier(
+                commandBuffer,
+                RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                RHI_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                0, 1, &instanceWriteBarrier, 0, nullptr, 0, nullptr
+            );
+        }
+
+        m_rayTracingInstanceSources = std::move(sources);
+    }
+
     /**
      * @brief 更新光线追踪加速结构
      * @return 更新是否成功
@@ -1847,13 +2758,34 @@ namespace Elish
             return false;
         }
         
-        // 获取命令缓冲区用于构建加速结构
-        RHICommandBuffer* commandBuffer = m_rhi->beginSingleTimeCommands();
+        // 回收已完成的异步构建；积压过多时等待最早的一次，避免暂存缓冲区无限增长
+        releaseCompletedAccelerationStructureBuilds();
+        bool asyncSubmit = m_rhi->isAsyncSubmitSupported();
+        if (asyncSubmit && m_pendingAccelerationStructureBuilds.size() >= k_maxPendingAccelerationStructureBuilds) {
+            m_rhi->waitForAsyncValue(m_pendingAccelerationStructureBuilds.front().timelineValue, UINT64_MAX);
+            releaseCompletedAccelerationStructureBuilds();
+        }
+        
+        // 获取命令缓冲区用于构建加速结构（异步提交时不等待队列空闲）
+        RHICommandBuffer* commandBuffer = asyncSubmit ? m_rhi->beginAsyncCommands() : m_rhi->beginSingleTimeCommands();
         if (!commandBuffer) {
             LOG_ERROR("[RenderResource::updateRayTracingAccelerationStructures] Failed to begin command buffer");
             return false;
         }
         
+        // 原地重建会覆盖此前提交的光线追踪/光线查询仍可能在读取的加速结构，
+        // 屏障的第一同步域包含队列中先前提交的全部命令
+        RHIMemoryBarrier previousReadBarrier{};
+        previousReadBarrier.sType = RHI_STRUCTURE_TYPE_MEMORY_BARRIER;
+        previousReadBarrier.srcAccessMask = RHI_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | RHI_ACCESS_SHADER_READ_BIT;
+        previousReadBarrier.dstAccessMask = RHI_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        m_rhi->cmdPipelineBarrier(
+            commandBuffer,
+            RHI_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            RHI_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            0, 1, &previousReadBarrier, 0, nullptr, 0, nullptr
+        );
+        
         // 获取VMA分配器（避免重复声明）
         VulkanRHI* vulkanRHI = static_cast<VulkanRHI*>(m_rhi.get());
         VmaAllocator allocator = vulkanRHI->getAssetsAllocator();
@@ -1863,7 +2795,9 @@ namespace Elish
         
         try {
             // 1. 构建底层加速结构（BLAS）
-            for (size_t i = 0; i < m_RenderObjects.size(); ++i) {
+            // 网格数据不变，加载期已构建（或从缓存反序列化）并压缩的BLAS无需重建，压缩后的BLAS也无法原地重建
+            size_t blasRebuildCount = m_rayTracingResource.bottomLevelASBuilt ? 0 : m_RenderObjects.size();
+            for (size_t i = 0; i < blasRebuildCount; ++i) {
                 const auto& renderObject = m_RenderObjects[i];
                 
                 // 创建BLAS构建信息
@@ -1949,104 +2883,8 @@ namespace Elish
                 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr
             );
             
-            // 2. 创建实例缓冲区
-            if (!m_rayTracingResource.instanceBuffer) {
-                // 创建实例数据
-                std::vector<RHIAccelerationStructureInstanceKHR> instances(m_RenderObjects.size());
-                
-                // 初始化索引偏移量
-                uint32_t currentIndexOffset = 0;
-                
-                for (size_t i = 0; i < m_RenderObjects.size(); ++i) {
-                    auto& instance = instances[i];
-                    
-                    // 根据 animationParams 计算模型矩阵
-                    const auto& renderObject = m_RenderObjects[i];
-                    glm::mat4 model = glm::mat4(1.0f);
-                    
-                    // 平移
-                    model = glm::translate(model, renderObject.animationParams.position);
-                    
-                    // 旋转 (XYZ 欧拉角)
-                    model = glm::rotate(model, renderObject.animationParams.rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
-                    model = glm::rotate(model, renderObject.animationParams.rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
-                    model = glm::rotate(model, renderObject.animationParams.rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
-                    
-                    // 缩放
-                    model = glm::scale(model, renderObject.animationParams.scale);
-                    
-                    // 转换为 Vulkan 3x4 row-major 格式
-                    // GLM 是 column-major，所以 model[col][row]
-                    // Row 0
-                    instance.transform[0][0] = model[0][0]; 
-                    instance.transform[0][1] = model[1][0]; 
-                    instance.transform[0][2] = model[2][0]; 
-                    instance.transform[0][3] = model[3][0];
-                    // Row 1
-                    instance.transform[1][0] = model[0][1]; 
-                    instance.transform[1][1] = model[1][1]; 
-                    instance.transform[1][2] = model[2][1]; 
-                    instance.transform[1][3] = model[3][1];
-                    // Row 2
-                    instance.transform[2][0] = model[0][2]; 
-                    instance.transform[2][1] = model[1][2]; 
-                    instance.transform[2][2] = model[2][2]; 
-                    instance.transform[2][3] = model[3][2];
-                    
-                    instance.instanceCustomIndex = currentIndexOffset;
-                    // 更新偏移量以便下一个对象使用
-                    currentIndexOffset += static_cast<uint32_t>(m_RenderObjects[i].indices.size());
-                    
-                    instance.mask = 0xFF;
-                    instance.instanceShaderBindingTableRecordOffset = 0;
-                    instance.flags = RHI_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR;
-                    
-                    // 获取BLAS设备地址 - 现在BLAS构建已完成
-                    // LOG_DEBUG("[RenderResource::updateRayTracingAccelerationStructures] Getting device address for BLAS {}", i);
-                    RHIAccelerationStructureDeviceAddressInfo addressInfo{};
-                    addressInfo.sType = RHI_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
-                    addressInfo.accelerationStructure = m_rayTracingResource.bottomLevelAS[i];
-                    m_rhi->getAccelerationStructureDeviceAddress(&addressInfo, &instance.accelerationStructureReference);
-                    
-                    if (instance.accelerationStructureReference == 0) {
-                        LOG_ERROR("[RenderResource::updateRayTracingAccelerationStructures] Failed to get device address for BLAS {}", i);
-                        throw std::runtime_error("Failed to get BLAS device address");
-                    }
-                    // LOG_DEBUG("[RenderResource::updateRayTracingAccelerationStructures] BLAS {} device address: 0x{:x}", i, instance.accelerationStructureReference);
-                }
-                
-                // 创建实例缓冲区
-                RHIBufferCreateInfo instanceBufferInfo{};
-                instanceBufferInfo.sType = RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-                instanceBufferInfo.size = sizeof(RHIAccelerationStructureInstanceKHR) * instances.size();
-                instanceBufferInfo.usage = RHI_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR | RHI_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
-                instanceBufferInfo.sharingMode = RHI_SHARING_MODE_EXCLUSIVE;
-                
-                VmaAllocationCreateInfo instanceAllocInfo{};
-                instanceAllocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
-                
-                VmaAllocationInfo instanceAllocInfoResult = {};
-                
-                if (!m_rhi->createBufferVMA(allocator, &instanceBufferInfo, &instanceAllocInfo, m_rayTracingResource.instanceBuffer, &m_rayTracingResource.instanceAllocation, &instanceAllocInfoResult)) {
-                    LOG_ERROR("[RenderResource::updateRayTracingAccelerationStructures] Failed to create instance buffer");
-                    throw std::runtime_error("Failed to create instance buffer");
-                }
-                
-                // 复制实例数据到缓冲区
-                void* mappedData = nullptr;
-                if (vmaMapMemory(allocator, m_rayTracingResource.instanceAllocation, &mappedData) == VK_SUCCESS) {
-                    memcpy(mappedData, instances.data(), instanceBufferInfo.size);
-                    vmaUnmapMemory(allocator, m_rayTracingResource.instanceAllocation);
-                } else {
-                    LOG_ERROR("[RenderResource::updateRayTracingAccelerationStructures] Failed to map instance buffer memory");
-                    throw std::runtime_error("Failed to map instance buffer memory");
-                }
-                
-                // 更新实例几何数据的设备地址
-                m_rayTracingInstancesData.data.deviceAddress = m_rhi->getBufferDeviceAddress(m_rayTracingResource.instanceBuffer);
-                
-                LOG_DEBUG("[RenderResource::updateRayTracingAccelerationStructures] Instance buffer created successfully");
-            }
+            // 2. 更新实例缓冲区：只上传变化的实例源数据，由计算着色器生成实例记录
+            updateRayTracingInstances(commandBuffer, tempBuffers);
             
             // 3. 构建顶层加速结构（TLAS）
             RHIAccelerationStructureGeometry tlasGeometry{};
@@ -2128,8 +2966,12 @@ namespace Elish
                 }
             }
             
-            // 确保命令缓冲区被正确结束和清理
-            m_rhi->endSingleTimeCommands(commandBuffer);
+            // 确保命令缓冲区被正确结束和清理（临时缓冲区已销毁，失败路径必须同步等待）
+            if (asyncSubmit) {
+                m_rhi->waitForAsyncValue(m_rhi->submitAsyncCommands(commandBuffer), UINT64_MAX);
+            } else {
+                m_rhi->endSingleTimeCommands(commandBuffer);
+            }
             
             // 即使失败也要释放暂存缓冲区使用状态
             m_rayTracingResource.scratchBufferInUse = false;
@@ -2138,15 +2980,59 @@ namespace Elish
             return false;
         }
         
-        // 提交命令缓冲区（这会等待GPU完成）
-        m_rhi->endSingleTimeCommands(commandBuffer);
+        if (asyncSubmit) {
+            // 异步提交：记录时间线值，临时缓冲区在GPU完成后由releaseCompletedAccelerationStructureBuilds回收
+            uint64_t timelineValue = m_rhi->submitAsyncCommands(commandBuffer);
+            if (timelineValue == 0) {
+                LOG_ERROR("[RenderResource::updateRayTracingAccelerationStructures] Async submit failed");
+                m_rhi->queueWaitIdle(m_rhi->getGraphicsQueue());
+                timelineValue = m_rhi->getCompletedAsyncValue();
+            }
+            PendingAccelerationStructureBuild pendingBuild;
+            pendingBuild.timelineValue = timelineValue;
+            pendingBuild.tempBuffers = std::move(tempBuffers);
+            m_pendingAccelerationStructureBuilds.push_back(std::move(pendingBuild));
+        } else {
+            // 提交命令缓冲区（这会等待GPU完成）
+            m_rhi->endSingleTimeCommands(commandBuffer);
+            PendingAccelerationStructureBuild completedBuild;
+            completedBuild.tempBuffers = std::move(tempBuffers);
+            m_pendingAccelerationStructureBuilds.push_back(std::move(completedBuild));
+            releaseCompletedAccelerationStructureBuilds();
+        }
         
-        // GPU完成后释放暂存缓冲区使用状态
+        // 暂存缓冲区为每次构建独立分配，提交后即可接受下一次构建
         m_rayTracingResource.scratchBufferInUse = false;
-        LOG_DEBUG("[RenderResource::updateRayTracingAccelerationStructures] Released scratch buffer for reuse");
         
-        LOG_INFO("[RenderResource::updateRayTracingAccelerationStructures] Acceleration structures built successfully");
+        LOG_DEBUG("[RenderResource::updateRayTracingAccelerationStructures] Acceleration structures submitted ({})", asyncSubmit ? "async" : "blocking");
         return true;
     }
 
+    /**
+     * @brief 回收已完成的异步加速结构构建
+     */
+    void RenderResource::releaseCompletedAccelerationStructureBuilds(bool wait_all)
+    {
+        if (!m_rhi || m_pendingAccelerationStructureBuilds.empty()) {
+            return;
+        }
+
+        if (wait_all) {
+            m_rhi->waitForAsyncValue(m_pendingAccelerationStructureBuilds.back().timelineValue, UINT64_MAX);
+        }
+
+        uint64_t completedValue = m_rhi->getCompletedAsyncValue();
+        VmaAllocator allocator = static_cast<VulkanRHI*>(m_rhi.get())->getAssetsAllocator();
+        while (!m_pendingAccelerationStructureBuilds.empty() &&
+               m_pendingAccelerationStructureBuilds.front().timelineValue <= completedValue) {
+            for (auto& [buffer, allocation] : m_pendingAccelerationStructureBuilds.front().tempBuffers) {
+                if (buffer && allocation) {
+                    vmaDestroyBuffer(allocator, static_cast<VulkanBuffer*>(buffer)->getResource(), allocation);
+                    delete buffer;
+                }
+            }
+            m_pendingAccelerationStructureBuilds.pop_front();
+        }
+    }
+
 } // namespace Elish
\ No newline at end of file
@@ -2,12 +2,19 @@
 
 #include "../core/base/macro.h"
 #include "interface/vulkan/vulkan_rhi_resource.h"
+#include "acceleration_structure_cache.h"
+#include "resource_state_tracker.h"
+#include "pipeline_cache.h"
+#include "../scene/entity_world.h"
+#include "../scene/scene_components.h"
+#include "../scene/scene_graph.h"
 #include "../../3rdparty/json11/json11.hpp"
 #include <vector>
 #include <memory>
 #include <string>
 #include <array>
 #include <unordered_map>
+#include <deque>
 #include <glm/glm.hpp>
 
     
@@ -16,6 +23,7 @@
 namespace Elish {
     class RHI;
     class RenderCamera;
+    class PipelineCache;
     
     struct Vertex {
 	glm::vec3 pos;
@@ -145,6 +153,7 @@ namespace Elish {
         float rotationSpeed = 1.0f;                 // 旋转速度倍数
         bool enableAnimation = false;               // 是否启用动画（默认禁用，保持静止）
         bool isPlatform = false;                    // 是否为平台（保持静止）
+        int parentIndex = -1;                       // 父物体的渲染对象索引，-1表示根物体；非根物体的变换相对父物体
         
         /**
          * @brief 将动画参数序列化为JSON对象
@@ -181,9 +190,16 @@ namespace Elish {
 		RHIDescriptorPool* descriptorPool;				// 描述符池
 		std::vector<RHIDescriptorSet*> descriptorSets;		// 描述符集合
 		RHIDescriptorSet* textureDescriptorSet;			// 纹理描述符集合
+
+        // 粗糙度贴图中的最小线性粗糙度（默认白色贴图为1），光线追踪反射按此跳过整体粗糙的物体
+        float minRoughness = 1.0f;
         
         // 新增：每个模型的独立动画参数
         ModelAnimationParams animationParams;
+
+        // 光线追踪实例可见性：掩码与光线的cullMask按位与为0时该实例不会被命中
+        uint8_t rayTracingMask = 0xFF;
+        RHIGeometryInstanceFlagsKHR rayTracingInstanceFlags = RHI_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR;
 	};
 
 
@@ -206,6 +222,41 @@ namespace Elish {
         VmaAllocation shaderBindingTableAllocation;   // 着色器绑定表内存分配
     };
 
+    /**
+     * @brief 光线追踪实例几何地址表项
+     * @details 与raytracing.rchit中GeometryAddress的std430布局一致，按TLAS实例索引（instanceCustomIndex）寻址，
+     *          命中着色器通过GL_EXT_buffer_reference直接读取各网格自身的顶点/索引缓冲区
+     */
+    struct RayTracingGeometryAddress {
+        uint64_t vertexAddress;     // 顶点缓冲区设备地址
+        uint64_t indexAddress;      // 索引缓冲区设备地址
+        uint64_t materialAddress;   // 材质数据设备地址
+        uint32_t vertexCount;       // 顶点数量（越界检查）
+        uint32_t indexCount;        // 索引数量（越界检查）
+    };
+
+    /**
+     * @brief TLAS实例源数据
+     * @details 与rt_tlas_instances.comp中InstanceSource的std430布局一致，常驻GPU；
+     *          CPU只上传发生变化的记录，由计算着色器打包为RHIAccelerationStructureInstanceKHR
+     */
+    struct RayTracingInstanceSource {
+        glm::vec4 transformRows[3];  // 模型矩阵前三行（行主序3x4）
+        uint64_t blasAddress;        // BLAS设备地址
+        uint32_t customIndex;        // 实例自定义索引（几何地址表索引）
+        uint32_t maskAndFlags;       // 低8位: 可见性掩码, 8~15位: 实例标志
+    };
+    static_assert(sizeof(RayTracingInstanceSource) == sizeof(RHIAccelerationStructureInstanceKHR), "Instance source must match instance record size");
+
+    /**
+     * @brief 光线追踪材质数据
+     * @details 与raytracing.rchit中MaterialData的布局一致
+     */
+    struct RayTracingMaterialData {
+        glm::vec4 albedoMetallic = glm::vec4(0.8f, 0.8f, 0.8f, 0.0f);   // xyz: 反照率, w: 金属度
+        glm::vec4 roughnessParams = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f);  // x: 粗糙度下界, y: 是否使用顶点色, zw: 保留
+    };
+
     /**
      * @brief 光线追踪资源结构
      * @details 包含光线追踪所需的加速结构和相关资源
@@ -218,19 +269,23 @@ namespace Elish {
         std::vector<RHIAccelerationStructure*> bottomLevelAS;  // 底层加速结构数组（BLAS）
         std::vector<RHIBuffer*> bottomLevelASBuffers;          // BLAS缓冲区数组
         std::vector<VmaAllocation> bottomLevelASAllocations;   // BLAS内存分配数组
+        bool bottomLevelASBuilt;                               // BLAS已构建/反序列化（网格静态，之后无需重建）
         
-        RHIBuffer* instanceBuffer;                    // 实例缓冲区
+        RHIBuffer* instanceBuffer;                    // 实例缓冲区（TLAS构建输入，GPU写入）
         VmaAllocation instanceAllocation;             // 实例缓冲区内存分配
+        RHIBuffer* instanceSourceBuffer;              // 实例源数据缓冲区（变换/掩码/标志，按变化增量上传）
+        VmaAllocation instanceSourceAllocation;       // 实例源数据缓冲区内存分配
         
         RHIImage* rayTracingOutputImage;             // 光线追踪输出图像
         RHIImageView* rayTracingOutputImageView;     // 光线追踪输出图像视图
         VmaAllocation rayTracingOutputImageAllocation; // 输出图像内存分配
         
-        // 合并缓冲区（用于光线追踪着色器）
-        RHIBuffer* mergedVertexBuffer;               // 合并的顶点缓冲区
-        VmaAllocation mergedVertexAllocation;        // 合并顶点缓冲区内存分配
-        RHIBuffer* mergedIndexBuffer;                // 合并的索引缓冲区
-        VmaAllocation mergedIndexAllocation;         // 合并索引缓冲区内存分配
+        // 实例几何地址表（用于光线追踪着色器，按实例索引访问各网格自身的缓冲区）
+        RHIBuffer* geometryAddressBuffer;            // 几何地址表缓冲区
+        VmaAllocation geometryAddressAllocation;     // 几何地址表内存分配
+        RHIBuffer* materialBuffer;                   // 实例材质缓冲区
+        VmaAllocation materialAllocation;            // 实例材质缓冲区内存分配
+        uint32_t geometryAddressCount;               // 地址表中的实例数量
         
         // 暂存缓冲区重用机制（性能优化）
         RHIBuffer* scratchBuffer;                    // 可重用的暂存缓冲区
@@ -240,8 +295,6 @@ namespace Elish {
         
         // 兼容性成员变量（用于raytracing_pass.cpp）
         RHIAccelerationStructure* tlas;              // TLAS别名，指向topLevelAS
-        RHIBuffer* vertex_buffer;                     // 顶点缓冲区
-        RHIBuffer* index_buffer;                      // 索引缓冲区
     };
     /** 全局常量*/
     struct GlobalConstants {
@@ -326,8 +379,17 @@ namespace Elish {
         /**
          * @brief 添加一个渲染对象到资源管理器中
          * @param renderObject 要添加的渲染对象
+         * @return 新对象的索引
+         */
+        size_t addRenderObject(const RenderObject& renderObject);
+
+        /**
+         * @brief 开始批量添加/编辑渲染对象
+         * @details 批量期间不重算世界矩阵、不回扫先于父物体加载的子物体，由endRenderObjectBatch()统一挂接并只update()一次，
+         *          避免逐个添加时O(n²)的开销；可嵌套，批量期间读到的世界矩阵可能是旧值
          */
-        void addRenderObject(const RenderObject& renderObject);
+        void beginRenderObjectBatch() { ++m_renderObjectBatchDepth; }
+        void endRenderObjectBatch();
         
         /**
          * @brief 清空所有渲染对象
@@ -341,6 +403,69 @@ namespace Elish {
          * @return 更新是否成功
          */
         bool updateRenderObjectAnimationParams(size_t objectIndex, const ModelAnimationParams& newParams);
+
+        /**
+         * @brief 设置渲染对象的父物体
+         * @details 子物体的位置/旋转/缩放解释为相对父物体的局部变换，父物体移动时子物体随之移动
+         * @param objectIndex 渲染对象的索引
+         * @param parentIndex 父物体的索引，-1表示解除父子关系
+         * @return 索引无效或会形成环时返回false，原有父子关系保持不变
+         */
+        bool setRenderObjectParent(size_t objectIndex, int parentIndex);
+
+        /**
+         * @brief 设置渲染对象的光线追踪实例掩码与标志
+         * @details 下一次TLAS更新时生效，只重新上传该实例的源数据
+         * @param objectIndex 渲染对象的索引
+         * @param mask 可见性掩码，0表示不参与任何光线求交
+         * @param flags 实例标志（如RHI_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR）
+         * @return 设置是否成功
+         */
+        bool setRenderObjectRayTracingInstance(size_t objectIndex, uint8_t mask, RHIGeometryInstanceFlagsKHR flags);
+
+        /**
+         * @brief 更新场景实体的世界矩阵
+         * @details 变换系统只遍历带AnimationComponent的实体并刷新其局部矩阵，再由场景图只重算发生变化的子树；
+         *          静态层级的世界矩阵在变换被修改时即已算好。每帧在各通道准备数据前调用一次，同一帧内所有通道使用同一时间
+         * @param time 动画时间（秒）
+         */
+        void updateSceneTransforms(float time);
+
+        /**
+         * @brief 获取渲染对象的世界矩阵（模型矩阵）
+         * @param index 渲染对象的索引，越界时返回单位矩阵
+         */
+        const glm::mat4& getRenderObjectWorldMatrix(size_t index) const;
+
+        /**
+         * @brief 获取渲染对象对应的场景实体
+         */
+        Entity getRenderObjectEntity(size_t index) const {
+            return index < m_renderObjectEntities.size() ? m_renderObjectEntities[index] : Entity{};
+        }
+
+        /**
+         * @brief 是否存在带动画的渲染对象（其加速结构需要每帧刷新）
+         */
+        bool hasAnimatedRenderObjects() const { return m_sceneWorld.count<AnimationComponent>() > 0; }
+
+        /**
+         * @brief 渲染对象的世界矩阵是否随时间变化（自身或任一祖先带动画）
+         */
+        bool isRenderObjectAnimated(size_t index) const;
+
+        /**
+         * @brief 场景实体存储
+         * @details 每个渲染对象对应一个实体，变换、动画与网格绘制数据作为组件按原型连续存放；
+         *          缓冲区、纹理、材质参数与描述符集的所有权仍在RenderObject
+         */
+        EntityWorld& getSceneWorld() { return m_sceneWorld; }
+        const EntityWorld& getSceneWorld() const { return m_sceneWorld; }
+
+        /**
+         * @brief 场景图，TransformComponent::node对应的世界矩阵从中读取
+         */
+        const SceneGraph& getSceneGraph() const { return m_sceneGraph; }
         // 创建一个渲染对象，包括对应的顶点和纹理
         bool createRenderObjectResource(RenderObject& outRenderObject, const std::string& objfile, const std::vector<std::string>& pngfiles);
         
@@ -355,10 +480,20 @@ namespace Elish {
         /**
          * @brief 创建模型渲染管线资源
          * @param renderPass 渲染通道
+         * @param pipelineCache 管线缓存，默认模型管线与其变体（光线查询阴影、光线追踪光照）均从中获取，归缓存所有
          * @return 创建是否成功
          */
-        bool createModelPipelineResource(RHIRenderPass* renderPass);
+        bool createModelPipelineResource(RHIRenderPass* renderPass, const std::shared_ptr<PipelineCache>& pipelineCache);
         
+        /**
+         * @brief 检查后台编译中的模型管线变体
+         * @details 光线查询阴影与光线追踪光照变体由createModelPipelineResource交给管线缓存的后台线程编译，
+         *          就绪前对应的is*Created()返回false，调用方继续使用默认模型管线；每帧在渲染线程调用
+         * @param pipelineCache 创建模型管线时使用的管线缓存
+         * @return 有变体就绪或编译失败（状态发生变化）时返回true
+         */
+        bool updateModelPipelineRequests(PipelineCache* pipelineCache);
+
         /**
          * @brief 检查模型渲染管线资源是否已创建
          * @return 如果已创建返回true，否则返回false
@@ -367,6 +502,49 @@ namespace Elish {
             return m_modelPipelineResourceCreated;
         }
 
+        /**
+         * @brief 获取光线查询阴影模型管线资源
+         * @details 描述符集合0与默认模型管线相同，集合1为TLAS；仅在设备支持光线查询时创建
+         * @return 光线查询阴影模型管线资源的常量引用
+         */
+        const RenderPipelineResource& getModelRayQueryPipelineResource() const {
+            return m_modelRayQueryPipelineResource;
+        }
+
+        /**
+         * @brief 检查光线查询阴影模型管线资源是否已创建
+         * @return 如果已创建返回true，否则返回false
+         */
+        bool isModelRayQueryPipelineResourceCreated() const {
+            return m_modelRayQueryPipelineResourceCreated;
+        }
+
+        /**
+         * @brief 获取光线追踪光照模型管线资源
+         * @details 集合1为TLAS与半分辨率反射/环境遮蔽采样器，片段阶段推送常量位于model矩阵之后；仅在设备支持光线查询时创建
+         * @return 光线追踪光照模型管线资源的常量引用
+         */
+        const RenderPipelineResource& getModelRtLightingPipelineResource() const {
+            return m_modelRtLightingPipelineResource;
+        }
+
+        /**
+         * @brief 检查光线追踪光照模型管线资源是否已创建
+         * @return 如果已创建返回true，否则返回false
+         */
+        bool isModelRtLightingPipelineResourceCreated() const {
+            return m_modelRtLightingPipelineResourceCreated;
+        }
+
+        /**
+         * @brief 模型描述符集合0是否为推送描述符布局
+         * @details 设备支持VK_KHR_push_descriptor且上限容纳全部绑定时，集合0带PUSH_DESCRIPTOR标志，
+         *          绘制时逐物体推送绑定，不再为每个物体每帧分配描述符集（三种模型管线共用此布局）
+         */
+        bool isModelPushDescriptorEnabled() const {
+            return m_modelPushDescriptorEnabled;
+        }
+
         
         /**
          * @brief Loads a cubemap texture from specified file paths.
@@ -505,9 +683,10 @@ namespace Elish {
         
         /**
          * @brief 创建光线追踪资源（加速结构等）
+         * @param pipelineCache 管线缓存，TLAS实例生成计算管线从中获取，归缓存所有；为空时实例记录在CPU上打包
          * @return 创建是否成功
          */
-        bool createRayTracingResource();
+        bool createRayTracingResource(const std::shared_ptr<PipelineCache>& pipelineCache);
         
         /**
          * @brief 获取光线追踪管线资源
@@ -543,9 +722,30 @@ namespace Elish {
         
         /**
          * @brief 更新光线追踪加速结构
+         * @details 支持时间线信号量时异步提交并立即返回，临时缓冲区在GPU完成后回收；
+         *          同队列上后续的帧命令通过屏障等待构建完成，CPU不再阻塞于队列空闲
          * @return 成功返回true，失败返回false
          */
         bool updateRayTracingAccelerationStructures();
+
+        /**
+         * @brief 创建或重建实例几何地址表
+         * @details 为每个渲染对象写入其顶点/索引缓冲区和材质数据的设备地址，表项索引即TLAS实例的instanceCustomIndex；
+         *          几何数据不再复制，新增实例时只需重写这张表（主机可见内存，无需暂存与队列等待）
+         * @return 成功返回true，失败返回false
+         */
+        bool updateRayTracingGeometryTable();
+
+        /**
+         * @brief 非阻塞回收已完成的异步加速结构构建所占用的临时缓冲区
+         * @param wait_all 为true时等待所有未完成的构建（销毁资源前使用）
+         */
+        void releaseCompletedAccelerationStructureBuilds(bool wait_all = false);
+
+        /**
+         * @brief 获取尚未完成的异步加速结构构建数量
+         */
+        size_t getPendingAccelerationStructureBuildCount() const { return m_pendingAccelerationStructureBuilds.size(); }
         
         /**
          * @brief 获取相机对象
@@ -564,8 +764,21 @@ namespace Elish {
         std::shared_ptr<RHI> m_rhi;
         
         std::vector<RenderObject> m_RenderObjects;               ///< 存储加载的模型
+        EntityWorld m_sceneWorld;                                ///< 场景实体（变换/动画/网格组件）
+        SceneGraph m_sceneGraph;                                 ///< 实体的父子层级与局部/世界矩阵
+        std::vector<Entity> m_renderObjectEntities;              ///< 渲染对象索引 -> 场景实体
+        float m_sceneTime = 0.0f;                                ///< 最近一次updateSceneTransforms的动画时间
+        uint32_t m_renderObjectBatchDepth = 0;                   ///< begin/endRenderObjectBatch的嵌套深度
         RenderPipelineResource m_modelPipelineResource;          ///< 模型渲染管线资源
         bool m_modelPipelineResourceCreated = false;             ///< 模型渲染管线资源是否已创建
+        RenderPipelineResource m_modelRayQueryPipelineResource{}; ///< 光线查询阴影模型管线资源
+        bool m_modelRayQueryPipelineResourceCreated = false;     ///< 光线查询阴影模型管线资源是否已创建
+        RenderPipelineResource m_modelRtLightingPipelineResource{}; ///< 光线追踪光照（反射/环境遮蔽）模型管线资源
+        bool m_modelRtLightingPipelineResourceCreated = false; ///< 光线追踪光照模型管线资源是否已创建
+        PipelineRequest m_modelRayQueryPipelineRequest = 0;     ///< 光线查询阴影模型管线的后台编译请求
+        PipelineRequest m_modelRtLightingPipelineRequest = 0;   ///< 光线追踪光照模型管线的后台编译请求
+        std::weak_ptr<PipelineCache> m_modelPipelineCache;      ///< 模型管线所在的缓存，销毁模型管线布局前从中移除对应管线
+        bool m_modelPushDescriptorEnabled = false;              ///< 模型集合0是否使用推送描述符
         
         class RenderCamera* m_camera = nullptr;                 ///< 相机对象指针
 
@@ -590,6 +803,41 @@ namespace Elish {
         // 光线追踪几何数据结构存储（避免悬空指针）
         std::vector<RHIAccelerationStructureGeometryTrianglesDataKHR> m_rayTracingTrianglesData;  ///< 三角形几何数据数组
         RHIAccelerationStructureGeometryInstancesDataKHR m_rayTracingInstancesData;              ///< 实例几何数据
+
+        /**
+         * @brief 异步加速结构构建记录
+         * @details 时间线信号量到达timelineValue后，构建使用的暂存缓冲区才可以销毁
+         */
+        struct PendingAccelerationStructureBuild {
+            uint64_t timelineValue = 0;
+            std::vector<std::pair<RHIBuffer*, VmaAllocation>> tempBuffers;
+        };
+        std::deque<PendingAccelerationStructureBuild> m_pendingAccelerationStructureBuilds;  ///< 按提交顺序排列
+        static constexpr size_t k_maxPendingAccelerationStructureBuilds = 3;                ///< 超出时等待最早的构建，限制暂存内存
+
+        // TLAS实例生成：已上传实例源数据的CPU镜像（用于增量上传）与计算管线
+        std::vector<RayTracingInstanceSource> m_rayTracingInstanceSources;
+        RHIPipelineLayout* m_tlasInstancePipelineLayout = nullptr;
+        RHIPipeline* m_tlasInstancePipeline = nullptr;                  ///< 归管线缓存所有
+        std::weak_ptr<PipelineCache> m_tlasInstancePipelineCache;       ///< 销毁实例生成管线布局前从中移除对应管线
+        static constexpr uint32_t k_tlasInstanceWorkgroupSize = 64;
+
+        AccelerationStructureCache m_accelerationStructureCache;                            ///< BLAS序列化磁盘缓存
+        ResourceStateTracker m_resource_states;                                             ///< 纹理等资源的布局/访问状态跟踪
+
+        /**
+         * @brief 待提交的纹理上传任务
+         */
+        struct TextureUpload
+        {
+            RHIImage*        image;
+            RHIBuffer*       staging_buffer;
+            RHIDeviceMemory* staging_memory;
+            uint32_t         width;
+            uint32_t         height;
+        };
+        static constexpr RHIBuildAccelerationStructureFlagsKHR k_blasBuildFlags =
+            RHI_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR | RHI_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;  ///< BLAS构建标志（参与缓存键）
         
         /**
          * @brief 加载OBJ模型文件
@@ -597,6 +845,25 @@ namespace Elish {
          * @return 是否加载成功
          */
         bool loadOBJ(const std::string& objPath); 
+
+        /**
+         * @brief 从资源状态跟踪器中移除所有渲染对象的纹理图像，丢弃渲染对象前调用
+         */
+        void forgetRenderObjectImages();
+
+        /**
+         * @brief 按渲染对象的当前数据创建或刷新其场景实体
+         * @details 写入变换组件，按是否动画增删AnimationComponent，并立即算出世界矩阵
+         */
+        void syncRenderObjectEntity(size_t index);
+
+        /**
+         * @brief 按animationParams.parentIndex把渲染对象挂到父物体的场景节点下
+         * @details 父物体尚未加载时暂作根节点，父物体加载后再挂接
+         * @return 父子关系会形成环时解除父子关系（parentIndex置为-1）并返回false
+         */
+        bool linkRenderObjectParent(size_t index);
+
         /**
          * @brief 解析OBJ文件
          * @param objPath OBJ文件路径
@@ -622,15 +889,51 @@ namespace Elish {
          * @brief 创建单个默认纹理
          * @param renderObject 渲染对象
          * @param index 纹理索引
+         * @param uploads 非空时把上传任务加入该批次由调用方统一提交，为空时立即提交
          * @return 创建是否成功
          */
-        bool createSingleDefaultTexture(RenderObject& renderObject, size_t index);
+        bool createSingleDefaultTexture(RenderObject& renderObject, size_t index, std::vector<TextureUpload>* uploads = nullptr);
+        /**
+         * @brief 在一个命令缓冲区中完成一批纹理的布局转换与拷贝，并释放暂存缓冲区
+         * @details 转换通过资源状态跟踪器声明，整批纹理只录制两次管线屏障、提交一次
+         */
+        void submitTextureUploads(std::vector<TextureUpload>& uploads);
 
         /**
-         * @brief 创建合并的顶点和索引缓冲区（用于光线追踪）
-         * @return 创建是否成功
+         * @brief 销毁实例几何地址表与材质缓冲区
+         */
+        void destroyRayTracingGeometryTable();
+
+        /**
+         * @brief 创建TLAS实例生成计算管线
+         * @details 失败时updateRayTracingInstances退回CPU打包实例记录
+         */
+        void createTlasInstancePipeline(const std::shared_ptr<PipelineCache>& pipelineCache);
+
+        /**
+         * @brief 计算渲染对象当前的实例源数据（变换取自场景实体的世界矩阵，与光栅化一致）
+         */
+        RayTracingInstanceSource buildRayTracingInstanceSource(size_t index) const;
+
+        /**
+         * @brief 录制实例缓冲区更新命令
+         * @details 只把变化的实例源数据经暂存缓冲区复制到GPU，再由计算着色器生成实例记录；
+         *          暂存缓冲区追加到tempBuffers，随本次构建一起回收
+         */
+        void updateRayTracingInstances(RHICommandBuffer* commandBuffer, std::vector<std::pair<RHIBuffer*, VmaAllocation>>& tempBuffers);
+
+        /**
+         * @brief 销毁实例缓冲区与实例源数据缓冲区
+         */
+        void destroyRayTracingInstanceBuffers();
+
+        /**
+         * @brief 初始化底层加速结构（缓存反序列化或构建+压缩+写缓存）
+         * @param meshHashes 各对象网格哈希
+         * @param cachedBlobs 各对象的缓存数据，为空表示需要构建
+         * @return 成功返回true
          */
-        bool createMergedVertexIndexBuffers();
+        bool initializeBottomLevelAccelerationStructures(const std::vector<uint64_t>& meshHashes, const std::vector<std::vector<uint8_t>>& cachedBlobs);
 
         
     };
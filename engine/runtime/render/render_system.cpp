@@ -297,7 +297,12 @@ namespace Elish
                 }
                 
                 LOG_INFO("[RenderSystem] Creating ray tracing acceleration structures");
-                if (!m_render_resource->createRayTracingResource()) {
+                // TLAS实例生成计算管线与各通道共用同一管线缓存
+                std::shared_ptr<PipelineCache> pipeline_cache;
+                if (auto render_pipeline = std::dynamic_pointer_cast<RenderPipeline>(m_render_pipeline)) {
+                    pipeline_cache = render_pipeline->getPipelineCache();
+                }
+                if (!m_render_resource->createRayTracingResource(pipeline_cache)) {
                     LOG_ERROR("[RenderSystem] Failed to create ray tracing resources");
                 } else {
                     LOG_INFO("[RenderSystem] Ray tracing resources created successfully! 🚀");
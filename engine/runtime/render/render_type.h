@@ -1398,6 +1398,22 @@ namespace Elish
         RHI_ACCELERATION_STRUCTURE_BUILD_TYPE_MAX_ENUM_KHR = 0x7FFFFFFF
     };
 
+    // 加速结构复制模式枚举
+    enum RHICopyAccelerationStructureModeKHR : int {
+        RHI_COPY_ACCELERATION_STRUCTURE_MODE_CLONE_KHR = 0,        // 克隆
+        RHI_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR = 1,      // 压缩
+        RHI_COPY_ACCELERATION_STRUCTURE_MODE_SERIALIZE_KHR = 2,    // 序列化到内存
+        RHI_COPY_ACCELERATION_STRUCTURE_MODE_DESERIALIZE_KHR = 3,  // 从内存反序列化
+        RHI_COPY_ACCELERATION_STRUCTURE_MODE_MAX_ENUM_KHR = 0x7FFFFFFF
+    };
+
+    // 加速结构属性查询类型枚举
+    enum RHIAccelerationStructureQueryTypeKHR : int {
+        RHI_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR = 1000150000,      // 压缩后大小
+        RHI_QUERY_TYPE_ACCELERATION_STRUCTURE_SERIALIZATION_SIZE_KHR = 1000150001,  // 序列化大小
+        RHI_QUERY_TYPE_ACCELERATION_STRUCTURE_MAX_ENUM_KHR = 0x7FFFFFFF
+    };
+
     // 光线追踪相关类型定义
     typedef uint32_t RHIBuildAccelerationStructureFlagsKHR;
     typedef uint32_t RHIGeometryFlagsKHR;
@@ -1700,6 +1716,11 @@ namespace Elish
         RHI_COMMAND_BUFFER_USAGE_FLAG_BITS_MAX_ENUM = 0x7FFFFFFF
     };
 
+    enum RHIDescriptorSetLayoutCreateFlagBits {
+        RHI_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR = 0x00000001,
+        RHI_DESCRIPTOR_SET_LAYOUT_CREATE_FLAG_BITS_MAX_ENUM = 0x7FFFFFFF
+    };
+
     enum RHIDefaultSamplerType
     {
         Default_Sampler_Linear,
@@ -0,0 +1,462 @@
+#include "resource_state_tracker.h"
+#include "../core/base/macro.h"
+
+#include <algorithm>
+
+namespace Elish
+{
+    namespace
+    {
+        struct StateInfo
+        {
+            RHIPipelineStageFlags stages;
+            RHIAccessFlags        access;
+            RHIImageLayout        layout;   // 缓冲区状态不使用
+            bool                  write;
+        };
+
+        constexpr RHIPipelineStageFlags k_graphics_shader_stages = RHI_PIPELINE_STAGE_VERTEX_SHADER_BIT | RHI_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        constexpr RHIPipelineStageFlags k_fragment_test_stages = RHI_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | RHI_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+
+        // 按ResourceState顺序排列
+        constexpr StateInfo k_state_infos[] = {
+            // Undefined
+            { RHI_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, RHI_IMAGE_LAYOUT_UNDEFINED, false },
+            // TransferSrc
+            { RHI_PIPELINE_STAGE_TRANSFER_BIT, RHI_ACCESS_TRANSFER_READ_BIT, RHI_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, false },
+            // TransferDst
+            { RHI_PIPELINE_STAGE_TRANSFER_BIT, RHI_ACCESS_TRANSFER_WRITE_BIT, RHI_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, true },
+            // VertexBuffer
+            { RHI_PIPELINE_STAGE_VERTEX_INPUT_BIT, RHI_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, RHI_IMAGE_LAYOUT_UNDEFINED, false },
+            // IndexBuffer
+            { RHI_PIPELINE_STAGE_VERTEX_INPUT_BIT, RHI_ACCESS_INDEX_READ_BIT, RHI_IMAGE_LAYOUT_UNDEFINED, false },
+            // UniformBuffer
+            { k_graphics_shader_stages | RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT, RHI_ACCESS_UNIFORM_READ_BIT, RHI_IMAGE_LAYOUT_UNDEFINED, false },
+            // ShaderReadGraphics
+            { k_graphics_shader_stages, RHI_ACCESS_SHADER_READ_BIT, RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, false },
+            // ShaderReadCompute
+            { RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT, RHI_ACCESS_SHADER_READ_BIT, RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, false },
+            // ShaderReadRayTracing
+            { RHI_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR, RHI_ACCESS_SHADER_READ_BIT, RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, false },
+            // StorageCompute
+            { RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT, RHI_ACCESS_SHADER_READ_BIT | RHI_ACCESS_SHADER_WRITE_BIT, RHI_IMAGE_LAYOUT_GENERAL, true },
+            // StorageRayTracing
+            { RHI_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR, RHI_ACCESS_SHADER_READ_BIT | RHI_ACCESS_SHADER_WRITE_BIT, RHI_IMAGE_LAYOUT_GENERAL, true },
+            // ColorAttachment
+            { RHI_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, RHI_ACCESS_COLOR_ATTACHMENT_READ_BIT | RHI_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+              RHI_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, true },
+            // DepthStencilAttachment
+            { k_fragment_test_stages, RHI_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | RHI_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+              RHI_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, true },
+            // DepthStencilRead
+            { k_fragment_test_stages | RHI_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, RHI_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | RHI_ACCESS_SHADER_READ_BIT,
+              RHI_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, false },
+            // AccelerationStructureBuild
+            { RHI_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+              RHI_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | RHI_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR, RHI_IMAGE_LAYOUT_UNDEFINED, true },
+            // AccelerationStructureRead
+            { RHI_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | RHI_PIPELINE_STAGE_COMPUTE_SHADER_BIT | RHI_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+              RHI_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR, RHI_IMAGE_LAYOUT_UNDEFINED, false },
+            // Present
+            { RHI_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, RHI_IMAGE_LAYOUT_PRESENT_SRC_KHR, false },
+            // HostRead
+            { RHI_PIPELINE_STAGE_HOST_BIT, RHI_ACCESS_HOST_READ_BIT, RHI_IMAGE_LAYOUT_GENERAL, false },
+        };
+        static_assert(sizeof(k_state_infos) / sizeof(k_state_infos[0]) == static_cast<size_t>(ResourceState::Count),
+                      "k_state_infos must cover every ResourceState");
+
+        const StateInfo& getStateInfo(ResourceState state)
+        {
+            return k_state_infos[static_cast<size_t>(state)];
+        }
+    } // namespace
+
+    void ResourceStateTracker::registerImage(RHIImage* image, uint32_t mip_levels, uint32_t array_layers, RHIImageAspectFlags aspect_mask,
+                                             ResourceState initial_state)
+    {
+        if (!image)
+        {
+            return;
+        }
+
+        ImageState& image_state = m_images[image];
+        image_state.mip_levels = std::max(1u, mip_levels);
+        image_state.array_layers = std::max(1u, array_layers);
+        image_state.aspect_mask = aspect_mask;
+        image_state.subresources.assign(image_state.mip_levels * image_state.array_layers, SubresourceState{ initial_state, 0, -1 });
+    }
+
+    void ResourceStateTracker::registerBuffer(RHIBuffer* buffer, ResourceState initial_state)
+    {
+        if (buffer)
+        {
+            m_buffers[buffer] = SubresourceState{ initial_state, 0, -1 };
+        }
+    }
+
+    void ResourceStateTracker::forget(RHIImage* image)
+    {
+        m_images.erase(image);
+        for (BarrierBatch& batch : m_closed_batches)
+        {
+            batch.image_barriers.erase(
+                std::remove_if(batch.image_barriers.begin(), batch.image_barriers.end(),
+                               [image](const RHIImageMemoryBarrier& barrier) { return barrier.image == image; }),
+                batch.image_barriers.end());
+        }
+        m_pending_image_barriers.erase(
+            std::remove_if(m_pending_image_barriers.begin(), m_pending_image_barriers.end(),
+                           [image](const RHIImageMemoryBarrier& barrier) { return barrier.image == image; }),
+            m_pending_image_barriers.end());
+        // 删除待提交屏障会改变其余屏障的索引，重建索引
+        for (auto& entry : m_images)
+        {
+            for (SubresourceState& subresource : entry.second.subresources)
+            {
+                subresource.pending_barrier = -1;
+            }
+        }
+        for (int32_t i = 0; i < static_cast<int32_t>(m_pending_image_barriers.size()); ++i)
+        {
+            const RHIImageMemoryBarrier& barrier = m_pending_image_barriers[i];
+            ImageState& image_state = m_images[barrier.image];
+            const RHIImageSubresourceRange& range = barrier.subresourceRange;
+            for (uint32_t layer = range.baseArrayLayer; layer < range.baseArrayLayer + range.layerCount; ++layer)
+            {
+                for (uint32_t mip = range.baseMipLevel; mip < range.baseMipLevel + range.levelCount; ++mip)
+                {
+                    image_state.subresources[layer * image_state.mip_levels + mip].pending_barrier = i;
+                }
+            }
+        }
+    }
+
+    void ResourceStateTracker::forget(RHIBuffer* buffer)
+    {
+        m_buffers.erase(buffer);
+        for (BarrierBatch& batch : m_closed_batches)
+        {
+            batch.buffer_barriers.erase(
+                std::remove_if(batch.buffer_barriers.begin(), batch.buffer_barriers.end(),
+                               [buffer](const RHIBufferMemoryBarrier& barrier) { return barrier.buffer == buffer; }),
+                batch.buffer_barriers.end());
+        }
+        m_pending_buffer_barriers.erase(
+            std::remove_if(m_pending_buffer_barriers.begin(), m_pending_buffer_barriers.end(),
+                           [buffer](const RHIBufferMemoryBarrier& barrier) { return barrier.buffer == buffer; }),
+            m_pending_buffer_barriers.end());
+        for (int32_t i = 0; i < static_cast<int32_t>(m_pending_buffer_barriers.size()); ++i)
+        {
+            m_buffers[m_pending_buffer_barriers[i].buffer].pending_barrier = i;
+        }
+    }
+
+    void ResourceStateTracker::clear()
+    {
+        m_images.clear();
+        m_buffers.clear();
+        m_pending_image_barriers.clear();
+        m_pending_buffer_barriers.clear();
+        m_pending_src_stages = 0;
+        m_pending_dst_stages = 0;
+        m_closed_batches.clear();
+    }
+
+    bool ResourceStateTracker::transition(SubresourceState& current, ResourceState state, RHIPipelineStageFlags& src_stages, RHIAccessFlags& src_access)
+    {
+        const StateInfo& old_info = getStateInfo(current.state);
+        const StateInfo& new_info = getStateInfo(state);
+
+        // 丢弃内容：下次转换从UNDEFINED开始，但仍需等待此前的读取者
+        if (state == ResourceState::Undefined)
+        {
+            current.reader_stages |= old_info.write ? old_info.stages : 0;
+            current.state = state;
+            return false;
+        }
+
+        // 读后读且布局相同：无冒险，只记录新的读取阶段
+        if (!old_info.write && !new_info.write && current.state != ResourceState::Undefined && old_info.layout == new_info.layout)
+        {
+            current.reader_stages |= new_info.stages;
+            current.state = state;
+            return false;
+        }
+
+        // 写后读/写后写需要使写入可见；读后写只需执行依赖
+        src_stages = old_info.stages | current.reader_stages;
+        src_access = old_info.write ? old_info.access : 0;
+
+        current.state = state;
+        current.reader_stages = new_info.write ? 0 : new_info.stages;
+        return true;
+    }
+
+    void ResourceStateTracker::retargetPendingImageBarrier(int32_t index, ResourceState state)
+    {
+        const StateInfo& new_info = getStateInfo(state);
+        RHIImageMemoryBarrier& barrier = m_pending_image_barriers[index];
+        barrier.newLayout = new_info.layout;
+        barrier.dstAccessMask = new_info.access;
+        m_pending_dst_stages |= new_info.stages;
+    }
+
+    int32_t ResourceStateTracker::appendImageBarrier(RHIImage* image, RHIImageAspectFlags aspect_mask, ResourceState old_state, ResourceState new_state,
+                                                     RHIPipelineStageFlags src_stages, RHIAccessFlags src_access, uint32_t base_mip, uint32_t mip_count, uint32_t layer)
+    {
+        const StateInfo& old_info = getStateInfo(old_state);
+        const StateInfo& new_info = getStateInfo(new_state);
+        m_pending_src_stages |= src_stages;
+        m_pending_dst_stages |= new_info.stages;
+
+        // 与上一数组层相同mip范围、相同转换的屏障合并
+        if (!m_pending_image_barriers.empty())
+        {
+            RHIImageMemoryBarrier& last = m_pending_image_barriers.back();
+            if (last.image == image && last.subresourceRange.baseMipLevel == base_mip && last.subresourceRange.levelCount == mip_count &&
+                last.subresourceRange.baseArrayLayer + last.subresourceRange.layerCount == layer && last.oldLayout == old_info.layout &&
+                last.newLayout == new_info.layout && last.srcAccessMask == src_access && last.dstAccessMask == new_info.access)
+            {
+                ++last.subresourceRange.layerCount;
+                return static_cast<int32_t>(m_pending_image_barriers.size()) - 1;
+            }
+        }
+
+        RHIImageMemoryBarrier barrier{};
+        barrier.sType = RHI_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = src_access;
+        barrier.dstAccessMask = new_info.access;
+        barrier.oldLayout = old_info.layout;
+        barrier.newLayout = new_info.layout;
+        barrier.srcQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
+        barrier.image = image;
+        barrier.subresourceRange.aspectMask = aspect_mask;
+        barrier.subresourceRange.baseMipLevel = base_mip;
+        barrier.subresourceRange.levelCount = mip_count;
+        barrier.subresourceRange.baseArrayLayer = layer;
+        barrier.subresourceRange.layerCount = 1;
+        m_pending_image_barriers.push_back(barrier);
+        return static_cast<int32_t>(m_pending_image_barriers.size()) - 1;
+    }
+
+    bool ResourceStateTracker::requireState(RHIImage* image, ResourceState state,
+                                            uint32_t base_mip_level, uint32_t level_count,
+                                            uint32_t base_array_layer, uint32_t layer_count)
+    {
+        auto it = m_images.find(image);
+        if (it == m_images.end())
+        {
+            LOG_ERROR("[ResourceStateTracker] Image {} is not registered", (void*)image);
+            return false;
+        }
+
+        ImageState& image_state = it->second;
+        uint32_t mip_end = level_count == k_all_remaining ? image_state.mip_levels : std::min(image_state.mip_levels, base_mip_level + level_count);
+        uint32_t layer_end = layer_count == k_all_remaining ? image_state.array_layers : std::min(image_state.array_layers, base_array_layer + layer_count);
+
+        std::vector<int32_t> retargeted;
+        for (uint32_t layer = base_array_layer; layer < layer_end; ++layer)
+        {
+            // 当前层内连续、旧状态相同的mip合并为一个屏障
+            uint32_t run_begin = 0;
+            uint32_t run_count = 0;
+            ResourceState run_old_state = ResourceState::Undefined;
+            RHIPipelineStageFlags run_src_stages = 0;
+            RHIAccessFlags run_src_access = 0;
+            std::vector<SubresourceState*> run_subresources;
+
+            auto flush_run = [&]() {
+                if (run_count == 0)
+                {
+                    return;
+                }
+                int32_t index = appendImageBarrier(image, image_state.aspect_mask, run_old_state, state, run_src_stages, run_src_access,
+                                                   run_begin, run_count, layer);
+                for (SubresourceState* subresource : run_subresources)
+                {
+                    subresource->pending_barrier = index;
+                }
+                run_subresources.clear();
+                run_count = 0;
+            };
+
+            for (uint32_t mip = base_mip_level; mip < mip_end; ++mip)
+            {
+                SubresourceState& subresource = image_state.subresources[layer * image_state.mip_levels + mip];
+                ++m_stats.requests;
+
+                if (subresource.pending_barrier >= 0)
+                {
+                    // 待提交屏障还覆盖请求范围之外的子资源，不能整体改写：先封批，再按已登记的目标状态录制新屏障
+                    const RHIImageSubresourceRange& range = m_pending_image_barriers[subresource.pending_barrier].subresourceRange;
+                    bool contained = range.baseMipLevel >= base_mip_level && range.baseMipLevel + range.levelCount <= mip_end &&
+                                     range.baseArrayLayer >= base_array_layer && range.baseArrayLayer + range.layerCount <= layer_end;
+                    if (!contained)
+                    {
+                        flush_run();
+                        closePendingBatch();
+                        retargeted.clear();
+                    }
+                }
+
+                if (subresource.pending_barrier >= 0)
+                {
+                    // 已有待提交的转换：中间状态未被使用，直接改写该屏障的目标状态
+                    if (state != ResourceState::Undefined &&
+                        std::find(retargeted.begin(), retargeted.end(), subresource.pending_barrier) == retargeted.end())
+                    {
+                        retargetPendingImageBarrier(subresource.pending_barrier, state);
+                        retargeted.push_back(subresource.pending_barrier);
+                    }
+                    const StateInfo& new_info = getStateInfo(state);
+                    subresource.state = state;
+                    subresource.reader_stages = new_info.write ? 0 : new_info.stages;
+                    ++m_stats.merged;
+                    flush_run();
+                    continue;
+                }
+
+                ResourceState old_state = subresource.state;
+                RHIPipelineStageFlags src_stages = 0;
+                RHIAccessFlags src_access = 0;
+                if (!transition(subresource, state, src_stages, src_access))
+                {
+                    ++m_stats.skipped;
+                    flush_run();
+                    continue;
+                }
+
+                if (run_count > 0 && (old_state != run_old_state || src_stages != run_src_stages || src_access != run_src_access))
+                {
+                    flush_run();
+                }
+                if (run_count == 0)
+                {
+                    run_begin = mip;
+                    run_old_state = old_state;
+                    run_src_stages = src_stages;
+                    run_src_access = src_access;
+                }
+                ++run_count;
+                run_subresources.push_back(&subresource);
+            }
+            flush_run();
+        }
+        return true;
+    }
+
+    bool ResourceStateTracker::requireState(RHIBuffer* buffer, ResourceState state)
+    {
+        auto it = m_buffers.find(buffer);
+        if (it == m_buffers.end())
+        {
+            LOG_ERROR("[ResourceStateTracker] Buffer {} is not registered", (void*)buffer);
+            return false;
+        }
+
+        SubresourceState& current = it->second;
+        const StateInfo& new_info = getStateInfo(state);
+        ++m_stats.requests;
+
+        if (current.pending_barrier >= 0)
+        {
+            if (state != ResourceState::Undefined)
+            {
+                RHIBufferMemoryBarrier& barrier = m_pending_buffer_barriers[current.pending_barrier];
+                barrier.dstAccessMask = new_info.access;
+                m_pending_dst_stages |= new_info.stages;
+            }
+            current.state = state;
+            current.reader_stages = new_info.write ? 0 : new_info.stages;
+            ++m_stats.merged;
+            return true;
+        }
+
+        RHIPipelineStageFlags src_stages = 0;
+        RHIAccessFlags src_access = 0;
+        if (!transition(current, state, src_stages, src_access))
+        {
+            ++m_stats.skipped;
+            return true;
+        }
+
+        RHIBufferMemoryBarrier barrier{};
+        barrier.sType = RHI_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcAccessMask = src_access;
+        barrier.dstAccessMask = new_info.access;
+        barrier.srcQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = RHI_QUEUE_FAMILY_IGNORED;
+        barrier.buffer = buffer;
+        barrier.offset = 0;
+        barrier.size = RHI_WHOLE_SIZE;
+        m_pending_buffer_barriers.push_back(barrier);
+        current.pending_barrier = static_cast<int32_t>(m_pending_buffer_barriers.size()) - 1;
+
+        m_pending_src_stages |= src_stages;
+        m_pending_dst_stages |= new_info.stages;
+        return true;
+    }
+
+    void ResourceStateTracker::closePendingBatch()
+    {
+        if (m_pending_image_barriers.empty() && m_pending_buffer_barriers.empty())
+        {
+            return;
+        }
+
+        for (const RHIImageMemoryBarrier& barrier : m_pending_image_barriers)
+        {
+            ImageState& image_state = m_images[barrier.image];
+            const RHIImageSubresourceRange& range = barrier.subresourceRange;
+            for (uint32_t layer = range.baseArrayLayer; layer < range.baseArrayLayer + range.layerCount; ++layer)
+            {
+                for (uint32_t mip = range.baseMipLevel; mip < range.baseMipLevel + range.levelCount; ++mip)
+                {
+                    image_state.subresources[layer * image_state.mip_levels + mip].pending_barrier = -1;
+                }
+            }
+        }
+        for (const RHIBufferMemoryBarrier& barrier : m_pending_buffer_barriers)
+        {
+            m_buffers[barrier.buffer].pending_barrier = -1;
+        }
+
+        BarrierBatch batch;
+        batch.image_barriers.swap(m_pending_image_barriers);
+        batch.buffer_barriers.swap(m_pending_buffer_barriers);
+        batch.src_stages = m_pending_src_stages;
+        batch.dst_stages = m_pending_dst_stages;
+        m_closed_batches.push_back(std::move(batch));
+        m_pending_src_stages = 0;
+        m_pending_dst_stages = 0;
+    }
+
+    void ResourceStateTracker::flush(RHI* rhi, RHICommandBuffer* command_buffer)
+    {
+        if (!hasPendingBarriers())
+        {
+            return;
+        }
+
+        closePendingBatch();
+        for (const BarrierBatch& batch : m_closed_batches)
+        {
+            if (batch.image_barriers.empty() && batch.buffer_barriers.empty())
+            {
+                continue;
+            }
+            rhi->cmdPipelineBarrier(command_buffer,
+                                    batch.src_stages ? batch.src_stages : RHI_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                    batch.dst_stages ? batch.dst_stages : RHI_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                    0,
+                                    0, nullptr,
+                                    static_cast<uint32_t>(batch.buffer_barriers.size()), batch.buffer_barriers.data(),
+                                    static_cast<uint32_t>(batch.image_barriers.size()), batch.image_barriers.data());
+
+            m_stats.barriers += batch.image_barriers.size() + batch.buffer_barriers.size();
+            ++m_stats.flushes;
+        }
+        m_closed_batches.clear();
+    }
+} // namespace Elish
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "interface/rhi.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Elish
+{
+    /**
+     * @brief 资源的使用状态
+     * @details 每个状态对应一组（管线阶段, 访问类型, 图像布局），屏障的阶段掩码与访问掩码由新旧状态推导，
+     *          调用方只需声明“接下来要怎样使用该资源”
+     */
+    enum class ResourceState : uint8_t
+    {
+        Undefined,                  // 内容无需保留
+        TransferSrc,
+        TransferDst,
+        VertexBuffer,
+        IndexBuffer,
+        UniformBuffer,
+        ShaderReadGraphics,         // 顶点/片段着色器采样或只读访问
+        ShaderReadCompute,
+        ShaderReadRayTracing,
+        StorageCompute,             // 计算着色器读写（GENERAL布局）
+        StorageRayTracing,          // 光线追踪着色器读写（GENERAL布局）
+        ColorAttachment,
+        DepthStencilAttachment,
+        DepthStencilRead,
+        AccelerationStructureBuild,
+        AccelerationStructureRead,
+        Present,
+        HostRead,
+        Count
+    };
+
+    /**
+     * @brief 资源状态跟踪器
+     * @details 按子资源（mip层级 × 数组层）记录图像状态、按整体记录缓冲区状态。requireState()只登记需求：
+     *          状态相同且为只读时跳过（读后读无冒险），否则生成屏障放入待提交列表；同一子资源在两次flush之间的
+     *          多次转换会合并为一次（如 Undefined→TransferDst→ShaderRead 中间未被使用时直接合并）。
+     *          flush()把所有待提交屏障合并为一次cmdPipelineBarrier，源/目标阶段掩码取参与屏障的最小并集；
+     *          待提交屏障的范围超出新请求时无法整体改写，先把已登记的屏障封为一批，新屏障排在其后，flush()按批依次录制。
+     *          跟踪器不拥有资源，资源销毁前应调用forget()，否则地址复用时会得到错误的旧状态
+     */
+    class ResourceStateTracker
+    {
+    public:
+        static constexpr uint32_t k_all_remaining = ~0u;
+
+        /**
+         * @brief 开始跟踪图像
+         * @param initial_state 图像当前状态，新建图像为Undefined
+         */
+        void registerImage(RHIImage* image, uint32_t mip_levels, uint32_t array_layers, RHIImageAspectFlags aspect_mask,
+                           ResourceState initial_state = ResourceState::Undefined);
+
+        /**
+         * @brief 开始跟踪缓冲区
+         */
+        void registerBuffer(RHIBuffer* buffer, ResourceState initial_state = ResourceState::Undefined);
+
+        void forget(RHIImage* image);
+        void forget(RHIBuffer* buffer);
+        void clear();
+
+        /**
+         * @brief 声明图像子资源范围接下来的使用状态
+         * @return 图像未注册时返回false
+         */
+        bool requireState(RHIImage* image, ResourceState state,
+                          uint32_t base_mip_level = 0, uint32_t level_count = k_all_remaining,
+                          uint32_t base_array_layer = 0, uint32_t layer_count = k_all_remaining);
+
+        /**
+         * @brief 声明缓冲区接下来的使用状态
+         * @return 缓冲区未注册时返回false
+         */
+        bool requireState(RHIBuffer* buffer, ResourceState state);
+
+        /**
+         * @brief 将所有待提交屏障录制到命令缓冲区，每批一次管线屏障（未发生封批时只有一次）
+         */
+        void flush(RHI* rhi, RHICommandBuffer* command_buffer);
+
+        bool hasPendingBarriers() const
+        {
+            return !m_closed_batches.empty() || !m_pending_image_barriers.empty() || !m_pending_buffer_barriers.empty();
+        }
+
+        struct Stats
+        {
+            uint64_t requests = 0;          // requireState调用涉及的子资源转换请求
+            uint64_t skipped = 0;           // 读后读等无需屏障而跳过的请求
+            uint64_t merged = 0;            // 与尚未提交的屏障合并的请求
+            uint64_t barriers = 0;          // 实际录制的图像/缓冲区屏障数量
+            uint64_t flushes = 0;           // 实际录制的cmdPipelineBarrier次数
+        };
+        const Stats& getStats() const { return m_stats; }
+
+    private:
+        struct SubresourceState
+        {
+            ResourceState         state = ResourceState::Undefined;
+            RHIPipelineStageFlags reader_stages = 0;    // 自上次写入以来读取过该资源的阶段，供读后写屏障等待
+            int32_t               pending_barrier = -1; // 尚未提交的屏障索引，-1表示无
+        };
+
+        /** @brief 已封批、等待flush()按顺序录制的一组屏障 */
+        struct BarrierBatch
+        {
+            std::vector<RHIImageMemoryBarrier>  image_barriers;
+            std::vector<RHIBufferMemoryBarrier> buffer_barriers;
+            RHIPipelineStageFlags               src_stages = 0;
+            RHIPipelineStageFlags               dst_stages = 0;
+        };
+
+        struct ImageState
+        {
+            uint32_t                      mip_levels = 1;
+            uint32_t                      array_layers = 1;
+            RHIImageAspectFlags           aspect_mask = 0;
+            std::vector<SubresourceState> subresources;     // 索引 = layer * mip_levels + mip
+        };
+
+        /**
+         * @brief 处理一个子资源的状态需求
+         * @return 需要屏障时返回true，并输出源阶段与源访问掩码
+         */
+        bool transition(SubresourceState& current, ResourceState state, RHIPipelineStageFlags& src_stages, RHIAccessFlags& src_access);
+
+        /**
+         * @brief 把新状态合并进尚未提交的屏障（中间状态未被使用，直接改写目标状态）
+         */
+        void retargetPendingImageBarrier(int32_t index, ResourceState state);
+
+        /**
+         * @brief 把当前待提交屏障封为一批，之后登记的屏障在其后录制；相关子资源不再有可改写的待提交屏障
+         */
+        void closePendingBatch();
+
+        int32_t appendImageBarrier(RHIImage* image, RHIImageAspectFlags aspect_mask, ResourceState old_state, ResourceState new_state,
+                                   RHIPipelineStageFlags src_stages, RHIAccessFlags src_access, uint32_t base_mip, uint32_t mip_count, uint32_t layer);
+
+        std::unordered_map<RHIImage*, ImageState>         m_images;
+        std::unordered_map<RHIBuffer*, SubresourceState>  m_buffers;
+
+        std::vector<RHIImageMemoryBarrier>  m_pending_image_barriers;
+        std::vector<RHIBufferMemoryBarrier> m_pending_buffer_barriers;
+        RHIPipelineStageFlags               m_pending_src_stages = 0;
+        RHIPipelineStageFlags               m_pending_dst_stages = 0;
+        std::vector<BarrierBatch>           m_closed_batches;
+
+        Stats m_stats;
+    };
+} // namespace Elish
@@ -0,0 +1,707 @@
+#include "cpu_bvh.h"
+
+#include <algorithm>
+#include <cassert>
+#include <future>
+#include <thread>
+#include <cmath>
+#include <limits>
+
+namespace Elish
+{
+    namespace
+    {
+        /**
+         * @brief 计算分量倒数，零分量用极小值替代，避免slab测试中出现0*inf
+         */
+        float safeInverse(float value)
+        {
+            const float epsilon = 1e-12f;
+            if (std::fabs(value) < epsilon)
+            {
+                value = value < 0.0f ? -epsilon : epsilon;
+            }
+            return 1.0f / value;
+        }
+
+        SimdFloat4 dot3(const SimdFloat4 a[3], const SimdFloat4 b[3])
+        {
+            return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        }
+
+        void cross3(const SimdFloat4 a[3], const SimdFloat4 b[3], SimdFloat4 out[3])
+        {
+            out[0] = a[1] * b[2] - a[2] * b[1];
+            out[1] = a[2] * b[0] - a[0] * b[2];
+            out[2] = a[0] * b[1] - a[1] * b[0];
+        }
+
+        /**
+         * @brief 遍历栈
+         * @details 容量由树深度决定，不超过InlineSize时使用栈上数组，否则分配堆内存；
+         *          容量按最坏情况计算，压栈永远不会溢出，断言只用于捕获容量计算错误
+         */
+        template<typename T, uint32_t InlineSize>
+        class TraversalStack
+        {
+        public:
+            explicit TraversalStack(uint32_t capacity) : m_capacity(capacity)
+            {
+                if (capacity > InlineSize)
+                {
+                    m_heap.reset(new T[capacity]);
+                    m_data = m_heap.get();
+                }
+            }
+
+            void push(const T& value)
+            {
+                assert(m_size < m_capacity && "BVH traversal stack overflow");
+                m_data[m_size++] = value;
+            }
+
+            T pop() { return m_data[--m_size]; }
+            bool empty() const { return m_size == 0; }
+
+        private:
+            T m_inline[InlineSize];
+            std::unique_ptr<T[]> m_heap;
+            T* m_data = m_inline;
+            uint32_t m_size = 0;
+            uint32_t m_capacity = 0;
+        };
+    }
+
+    void CpuRayPacket4::setRay(int lane, const CpuRay& ray)
+    {
+        origin_x[lane] = ray.origin.x;
+        origin_y[lane] = ray.origin.y;
+        origin_z[lane] = ray.origin.z;
+        dir_x[lane] = ray.direction.x;
+        dir_y[lane] = ray.direction.y;
+        dir_z[lane] = ray.direction.z;
+        t_min[lane] = ray.t_min;
+        t_max[lane] = ray.t_max;
+    }
+
+    float CpuBvh::Aabb::area() const
+    {
+        glm::vec3 extent = glm::max(max - min, glm::vec3(0.0f));
+        return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+    }
+
+    void CpuBvh::clear()
+    {
+        m_triangles.clear();
+        m_nodes.clear();
+        m_leaves.clear();
+        m_root = k_empty_child;
+        m_depth = 0;
+        m_stack_capacity = 0;
+    }
+
+    /**
+     * @brief 构建BVH4
+     * @details 先以分箱SAH构建二叉树（大子树并行），再按主存顺序重排三角形并折叠为宽节点
+     */
+    void CpuBvh::build(std::vector<CpuTriangle> triangles, uint32_t worker_count)
+    {
+        clear();
+        m_triangles = std::move(triangles);
+        if (m_triangles.empty())
+        {
+            return;
+        }
+
+        uint32_t triangle_count = static_cast<uint32_t>(m_triangles.size());
+        m_primitive_bounds.resize(triangle_count);
+        m_primitive_centroids.resize(triangle_count);
+        m_primitive_indices.resize(triangle_count);
+        for (uint32_t i = 0; i < triangle_count; ++i)
+        {
+            const CpuTriangle& tri = m_triangles[i];
+            Aabb bounds;
+            bounds.grow(tri.v0);
+            bounds.grow(tri.v0 + tri.e1);
+            bounds.grow(tri.v0 + tri.e2);
+            m_primitive_bounds[i] = bounds;
+            m_primitive_centroids[i] = (bounds.min + bounds.max) * 0.5f;
+            m_primitive_indices[i] = i;
+        }
+
+        // 每深入一层并行任务数翻倍，深度上限取log2(线程数)
+        if (worker_count == 0)
+        {
+            worker_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+        m_parallel_depth = 0;
+        while ((1u << m_parallel_depth) < worker_count)
+        {
+            ++m_parallel_depth;
+        }
+
+        std::unique_ptr<BuildNode> root = buildRecursive(0, triangle_count, 0);
+
+        // 按叶节点顺序重排三角形，使每个叶节点引用一段连续区间
+        std::vector<CpuTriangle> ordered(triangle_count);
+        for (uint32_t i = 0; i < triangle_count; ++i)
+        {
+            ordered[i] = m_triangles[m_primitive_indices[i]];
+        }
+        m_triangles = std::move(ordered);
+
+        m_nodes.reserve(triangle_count / 2 + 1);
+        if (root->isLeaf())
+        {
+            // 根节点即叶节点时包一层宽节点，遍历逻辑保持统一
+            Node4 node{};
+            std::fill(std::begin(node.min_x), std::end(node.min_x), 1e30f);
+            std::fill(std::begin(node.min_y), std::end(node.min_y), 1e30f);
+            std::fill(std::begin(node.min_z), std::end(node.min_z), 1e30f);
+            std::fill(std::begin(node.max_x), std::end(node.max_x), -1e30f);
+            std::fill(std::begin(node.max_y), std::end(node.max_y), -1e30f);
+            std::fill(std::begin(node.max_z), std::end(node.max_z), -1e30f);
+            std::fill(std::begin(node.child), std::end(node.child), k_empty_child);
+            node.min_x[0] = root->bounds.min.x; node.min_y[0] = root->bounds.min.y; node.min_z[0] = root->bounds.min.z;
+            node.max_x[0] = root->bounds.max.x; node.max_y[0] = root->bounds.max.y; node.max_z[0] = root->bounds.max.z;
+            node.child[0] = makeLeaf(root.get());
+            m_nodes.push_back(node);
+            m_root = 0;
+            m_depth = 1;
+        }
+        else
+        {
+            m_root = collapse(root.get(), 1);
+        }
+        m_stack_capacity = 3 * m_depth + 1;
+
+        m_primitive_bounds.clear();
+        m_primitive_bounds.shrink_to_fit();
+        m_primitive_centroids.clear();
+        m_primitive_centroids.shrink_to_fit();
+        m_primitive_indices.clear();
+        m_primitive_indices.shrink_to_fit();
+    }
+
+    /**
+     * @brief 分箱SAH递归构建
+     * @details 在质心包围盒的三个轴上各分k_bin_count个箱，取SAH代价最小的划分；
+     *          所有质心重合或划分退化时按中位数对半拆分
+     */
+    std::unique_ptr<CpuBvh::BuildNode> CpuBvh::buildRecursive(uint32_t first, uint32_t count, uint32_t depth)
+    {
+        auto node = std::make_unique<BuildNode>();
+        node->first = first;
+        node->count = count;
+
+        Aabb centroid_bounds;
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            uint32_t index = m_primitive_indices[i];
+            node->bounds.grow(m_primitive_bounds[index]);
+            centroid_bounds.grow(m_primitive_centroids[index]);
+        }
+
+        if (count <= k_max_leaf_size)
+        {
+            return node;
+        }
+
+        struct Bin
+        {
+            Aabb bounds;
+            uint32_t count = 0;
+        };
+
+        float best_cost = std::numeric_limits<float>::max();
+        int best_axis = -1;
+        uint32_t best_split = 0;
+        glm::vec3 extent = centroid_bounds.max - centroid_bounds.min;
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (extent[axis] <= 1e-8f)
+            {
+                continue;
+            }
+
+            Bin bins[k_bin_count];
+            float scale = k_bin_count / extent[axis];
+            for (uint32_t i = first; i < first + count; ++i)
+            {
+                uint32_t index = m_primitive_indices[i];
+                uint32_t bin = std::min(k_bin_count - 1,
+                    static_cast<uint32_t>((m_primitive_centroids[index][axis] - centroid_bounds.min[axis]) * scale));
+                bins[bin].bounds.grow(m_primitive_bounds[index]);
+                ++bins[bin].count;
+            }
+
+            // 从右向左扫描得到每个划分右侧的面积与数量，再从左向右累计计算代价
+            float right_area[k_bin_count];
+            uint32_t right_count[k_bin_count];
+            Aabb right_bounds;
+            uint32_t right_sum = 0;
+            for (uint32_t b = k_bin_count - 1; b > 0; --b)
+            {
+                right_bounds.grow(bins[b].bounds);
+                right_sum += bins[b].count;
+                right_area[b] = right_bounds.area();
+                right_count[b] = right_sum;
+            }
+
+            Aabb left_bounds;
+            uint32_t left_sum = 0;
+            for (uint32_t b = 1; b < k_bin_count; ++b)
+            {
+                left_bounds.grow(bins[b - 1].bounds);
+                left_sum += bins[b - 1].count;
+                if (left_sum == 0 || right_count[b] == 0)
+                {
+                    continue;
+                }
+                float cost = left_bounds.area() * left_sum + right_area[b] * right_count[b];
+                if (cost < best_cost)
+                {
+                    best_cost = cost;
+                    best_axis = axis;
+                    best_split = b;
+                }
+            }
+        }
+
+        uint32_t* begin = m_primitive_indices.data() + first;
+        uint32_t* end = begin + count;
+        uint32_t* middle = begin + count / 2;
+        if (best_axis >= 0)
+        {
+            float scale = k_bin_count / extent[best_axis];
+            float axis_min = centroid_bounds.min[best_axis];
+            middle = std::partition(begin, end, [&](uint32_t index) {
+                uint32_t bin = std::min(k_bin_count - 1,
+                    static_cast<uint32_t>((m_primitive_centroids[index][best_axis] - axis_min) * scale));
+                return bin < best_split;
+            });
+        }
+        if (best_axis < 0 || middle == begin || middle == end)
+        {
+            middle = begin + count / 2;
+        }
+
+        uint32_t left_count = static_cast<uint32_t>(middle - begin);
+        uint32_t right_count = count - left_count;
+
+        if (depth < m_parallel_depth && count >= k_parallel_threshold)
+        {
+            // 两侧索引区间互不重叠，可安全并行
+            auto left_future = std::async(std::launch::async, [this, first, left_count, depth]() {
+                return buildRecursive(first, left_count, depth + 1);
+            });
+            node->children[1] = buildRecursive(first + left_count, right_count, depth + 1);
+            node->children[0] = left_future.get();
+        }
+        else
+        {
+            node->children[0] = buildRecursive(first, left_count, depth + 1);
+            node->children[1] = buildRecursive(first + left_count, right_count, depth + 1);
+        }
+        return node;
+    }
+
+    uint32_t CpuBvh::makeLeaf(const BuildNode* node)
+    {
+        uint32_t leaf_index = static_cast<uint32_t>(m_leaves.size());
+        m_leaves.push_back({ node->first, node->count });
+        return leaf_index | k_leaf_flag;
+    }
+
+    /**
+     * @brief 将二叉子树折叠为宽节点
+     * @details 反复展开表面积最大的内部子节点，直到凑满4个子节点或全部为叶节点
+     */
+    uint32_t CpuBvh::collapse(const BuildNode* node, uint32_t depth)
+    {
+        m_depth = std::max(m_depth, depth);
+        const BuildNode* children[4] = { node->children[0].get(), node->children[1].get(), nullptr, nullptr };
+        uint32_t child_count = 2;
+        while (child_count < 4)
+        {
+            int expand = -1;
+            float largest_area = -1.0f;
+            for (uint32_t i = 0; i < child_count; ++i)
+            {
+                if (!children[i]->isLeaf() && children[i]->bounds.area() > largest_area)
+                {
+                    largest_area = children[i]->bounds.area();
+                    expand = static_cast<int>(i);
+                }
+            }
+            if (expand < 0)
+            {
+                break;
+            }
+            const BuildNode* expanded = children[expand];
+            children[expand] = expanded->children[0].get();
+            children[child_count++] = expanded->children[1].get();
+        }
+
+        uint32_t node_index = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+        {
+            Node4& wide = m_nodes[node_index];
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                wide.min_x[i] = wide.min_y[i] = wide.min_z[i] = 1e30f;
+                wide.max_x[i] = wide.max_y[i] = wide.max_z[i] = -1e30f;
+                wide.child[i] = k_empty_child;
+            }
+        }
+
+        for (uint32_t i = 0; i < child_count; ++i)
+        {
+            const BuildNode* child = children[i];
+            uint32_t encoded = child->isLeaf() ? makeLeaf(child) : collapse(child, depth + 1);
+
+            // 递归期间m_nodes可能重新分配，按下标重新取引用
+            Node4& wide = m_nodes[node_index];
+            wide.min_x[i] = child->bounds.min.x;
+            wide.min_y[i] = child->bounds.min.y;
+            wide.min_z[i] = child->bounds.min.z;
+            wide.max_x[i] = child->bounds.max.x;
+            wide.max_y[i] = child->bounds.max.y;
+            wide.max_z[i] = child->bounds.max.z;
+            wide.child[i] = encoded;
+        }
+        return node_index;
+    }
+
+    /**
+     * @brief 单光线与宽节点4个子包围盒的SIMD slab测试
+     * @return 命中子节点的位掩码，distances中写入各子节点入口距离
+     */
+    int CpuBvh::intersectChildren(const Node4& node, const SimdFloat4 origin[3], const SimdFloat4 inv_dir[3],
+                                  float t_min, float t_max, float distances[4]) const
+    {
+        SimdFloat4 tx0 = (SimdFloat4::load(node.min_x) - origin[0]) * inv_dir[0];
+        SimdFloat4 tx1 = (SimdFloat4::load(node.max_x) - origin[0]) * inv_dir[0];
+        SimdFloat4 ty0 = (SimdFloat4::load(node.min_y) - origin[1]) * inv_dir[1];
+        SimdFloat4 ty1 = (SimdFloat4::load(node.max_y) - origin[1]) * inv_dir[1];
+        SimdFloat4 tz0 = (SimdFloat4::load(node.min_z) - origin[2]) * inv_dir[2];
+        SimdFloat4 tz1 = (SimdFloat4::load(node.max_z) - origin[2]) * inv_dir[2];
+
+        SimdFloat4 t_near = simdMax(simdMax(simdMin(tx0, tx1), simdMin(ty0, ty1)), simdMax(simdMin(tz0, tz1), SimdFloat4(t_min)));
+        SimdFloat4 t_far = simdMin(simdMin(simdMax(tx0, tx1), simdMax(ty0, ty1)), simdMin(simdMax(tz0, tz1), SimdFloat4(t_max)));
+
+        alignas(16) float near_values[4];
+        t_near.store(near_values);
+        for (int i = 0; i < 4; ++i)
+        {
+            distances[i] = near_values[i];
+        }
+        return simdMoveMask(t_near <= t_far);
+    }
+
+    /**
+     * @brief Möller-Trumbore光线三角形求交
+     */
+    bool CpuBvh::intersectTriangle(const CpuRay& ray, uint32_t index, float t_max, CpuHit& hit) const
+    {
+        const CpuTriangle& tri = m_triangles[index];
+        glm::vec3 p = glm::cross(ray.direction, tri.e2);
+        float det = glm::dot(tri.e1, p);
+        if (std::fabs(det) < 1e-10f)
+        {
+            return false;
+        }
+        float inv_det = 1.0f / det;
+        glm::vec3 s = ray.origin - tri.v0;
+        float u = glm::dot(s, p) * inv_det;
+        if (u < 0.0f || u > 1.0f)
+        {
+            return false;
+        }
+        glm::vec3 q = glm::cross(s, tri.e1);
+        float v = glm::dot(ray.direction, q) * inv_det;
+        if (v < 0.0f || u + v > 1.0f)
+        {
+            return false;
+        }
+        float t = glm::dot(tri.e2, q) * inv_det;
+        if (t <= ray.t_min || t >= t_max)
+        {
+            return false;
+        }
+        hit.t = t;
+        hit.u = u;
+        hit.v = v;
+        hit.triangle = index;
+        return true;
+    }
+
+    bool CpuBvh::intersect(const CpuRay& ray, CpuHit& hit) const
+    {
+        hit = CpuHit{};
+        if (m_nodes.empty())
+        {
+            return false;
+        }
+
+        SimdFloat4 origin[3] = { SimdFloat4(ray.origin.x), SimdFloat4(ray.origin.y), SimdFloat4(ray.origin.z) };
+        SimdFloat4 inv_dir[3] = { SimdFloat4(safeInverse(ray.direction.x)), SimdFloat4(safeInverse(ray.direction.y)),
+                                  SimdFloat4(safeInverse(ray.direction.z)) };
+
+        float closest = ray.t_max;
+        TraversalStack<uint32_t, k_inline_stack_size> stack(m_stack_capacity);
+        stack.push(m_root);
+
+        while (!stack.empty())
+        {
+            uint32_t entry = stack.pop();
+            if (entry & k_leaf_flag)
+            {
+                const Leaf& leaf = m_leaves[entry & ~k_leaf_flag];
+                for (uint32_t i = leaf.first; i < leaf.first + leaf.count; ++i)
+                {
+                    if (intersectTriangle(ray, i, closest, hit))
+                    {
+                        closest = hit.t;
+                    }
+                }
+                continue;
+            }
+
+            const Node4& node = m_nodes[entry];
+            float distances[4];
+            int mask = intersectChildren(node, origin, inv_dir, ray.t_min, closest, distances);
+
+            // 按入口距离由远到近压栈，使最近的子节点最先出栈，尽早收紧closest
+            uint32_t hit_children[4];
+            float hit_distances[4];
+            uint32_t hit_count = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                if (!(mask & (1 << i)) || node.child[i] == k_empty_child)
+                {
+                    continue;
+                }
+                uint32_t slot = hit_count++;
+                while (slot > 0 && hit_distances[slot - 1] < distances[i])
+                {
+                    hit_children[slot] = hit_children[slot - 1];
+                    hit_distances[slot] = hit_distances[slot - 1];
+                    --slot;
+                }
+                hit_children[slot] = node.child[i];
+                hit_distances[slot] = distances[i];
+            }
+            for (uint32_t i = 0; i < hit_count; ++i)
+            {
+                stack.push(hit_children[i]);
+            }
+        }
+
+        return hit.valid();
+    }
+
+    bool CpuBvh::occluded(const CpuRay& ray) const
+    {
+        if (m_nodes.empty())
+        {
+            return false;
+        }
+
+        SimdFloat4 origin[3] = { SimdFloat4(ray.origin.x), SimdFloat4(ray.origin.y), SimdFloat4(ray.origin.z) };
+        SimdFloat4 inv_dir[3] = { SimdFloat4(safeInverse(ray.direction.x)), SimdFloat4(safeInverse(ray.direction.y)),
+                                  SimdFloat4(safeInverse(ray.direction.z)) };
+
+        TraversalStack<uint32_t, k_inline_stack_size> stack(m_stack_capacity);
+        stack.push(m_root);
+        CpuHit hit;
+
+        while (!stack.empty())
+        {
+            uint32_t entry = stack.pop();
+            if (entry & k_leaf_flag)
+            {
+                const Leaf& leaf = m_leaves[entry & ~k_leaf_flag];
+                for (uint32_t i = leaf.first; i < leaf.first + leaf.count; ++i)
+                {
+                    if (intersectTriangle(ray, i, ray.t_max, hit))
+                    {
+                        return true;
+                    }
+                }
+                continue;
+            }
+
+            const Node4& node = m_nodes[entry];
+            float distances[4];
+            int mask = intersectChildren(node, origin, inv_dir, ray.t_min, ray.t_max, distances);
+            for (int i = 0; i < 4; ++i)
+            {
+                if ((mask & (1 << i)) && node.child[i] != k_empty_child)
+                {
+                    stack.push(node.child[i]);
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief 4光线包遍历
+     * @details 栈中同时记录子树的活跃光线掩码；包围盒与三角形测试都在4条光线上并行执行，
+     *          只有至少一条活跃光线命中的子节点才会入栈
+     */
+    void CpuBvh::intersectPacket(const CpuRayPacket4& packet, CpuHit hits[4]) const
+    {
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            hits[lane] = CpuHit{};
+        }
+        if (m_nodes.empty() || packet.active_mask == 0)
+        {
+            return;
+        }
+
+        SimdFloat4 origin[3] = { SimdFloat4::load(packet.origin_x), SimdFloat4::load(packet.origin_y), SimdFloat4::load(packet.origin_z) };
+        SimdFloat4 direction[3] = { SimdFloat4::load(packet.dir_x), SimdFloat4::load(packet.dir_y), SimdFloat4::load(packet.dir_z) };
+        SimdFloat4 inv_dir[3] = {
+            SimdFloat4(safeInverse(packet.dir_x[0]), safeInverse(packet.dir_x[1]), safeInverse(packet.dir_x[2]), safeInverse(packet.dir_x[3])),
+            SimdFloat4(safeInverse(packet.dir_y[0]), safeInverse(packet.dir_y[1]), safeInverse(packet.dir_y[2]), safeInverse(packet.dir_y[3])),
+            SimdFloat4(safeInverse(packet.dir_z[0]), safeInverse(packet.dir_z[1]), safeInverse(packet.dir_z[2]), safeInverse(packet.dir_z[3]))
+        };
+        SimdFloat4 t_min = SimdFloat4::load(packet.t_min);
+        SimdFloat4 closest = SimdFloat4::load(packet.t_max);
+        SimdFloat4 hit_u(0.0f);
+        SimdFloat4 hit_v(0.0f);
+
+        struct StackEntry
+        {
+            uint32_t node;
+            int mask;
+        };
+        TraversalStack<StackEntry, k_inline_stack_size> stack(m_stack_capacity);
+        stack.push({ m_root, packet.active_mask });
+
+        while (!stack.empty())
+        {
+            StackEntry entry = stack.pop();
+
+            if (entry.node & k_leaf_flag)
+            {
+                const Leaf& leaf = m_leaves[entry.node & ~k_leaf_flag];
+                for (uint32_t i = leaf.first; i < leaf.first + leaf.count; ++i)
+                {
+                    const CpuTriangle& tri = m_triangles[i];
+                    SimdFloat4 e1[3] = { SimdFloat4(tri.e1.x), SimdFloat4(tri.e1.y), SimdFloat4(tri.e1.z) };
+                    SimdFloat4 e2[3] = { SimdFloat4(tri.e2.x), SimdFloat4(tri.e2.y), SimdFloat4(tri.e2.z) };
+                    SimdFloat4 s[3] = { origin[0] - SimdFloat4(tri.v0.x), origin[1] - SimdFloat4(tri.v0.y), origin[2] - SimdFloat4(tri.v0.z) };
+
+                    SimdFloat4 p[3];
+                    cross3(direction, e2, p);
+                    SimdFloat4 det = dot3(e1, p);
+                    SimdFloat4 inv_det = SimdFloat4(1.0f) / det;
+                    SimdFloat4 u = dot3(s, p) * inv_det;
+                    SimdFloat4 q[3];
+                    cross3(s, e1, q);
+                    SimdFloat4 v = dot3(direction, q) * inv_det;
+                    SimdFloat4 t = dot3(e2, q) * inv_det;
+
+                    SimdFloat4 zero(0.0f);
+                    SimdFloat4 valid = (simdMax(det, zero - det) > SimdFloat4(1e-10f)) &
+                                       (u >= zero) & (v >= zero) & ((u + v) <= SimdFloat4(1.0f)) &
+                                       (t > t_min) & (t < closest) & SimdFloat4::fromMask(entry.mask);
+                    int lanes = simdMoveMask(valid);
+                    if (lanes == 0)
+                    {
+                        continue;
+                    }
+
+                    closest = simdSelect(valid, t, closest);
+                    hit_u = simdSelect(valid, u, hit_u);
+                    hit_v = simdSelect(valid, v, hit_v);
+                    for (int lane = 0; lane < 4; ++lane)
+                    {
+                        if (lanes & (1 << lane))
+                        {
+                            hits[lane].triangle = i;
+                        }
+                    }
+                }
+                continue;
+            }
+
+            const Node4& node = m_nodes[entry.node];
+            uint32_t hit_children[4];
+            int hit_masks[4];
+            float hit_distances[4];
+            uint32_t hit_count = 0;
+            for (int c = 0; c < 4; ++c)
+            {
+                if (node.child[c] == k_empty_child)
+                {
+                    continue;
+                }
+                SimdFloat4 tx0 = (SimdFloat4(node.min_x[c]) - origin[0]) * inv_dir[0];
+                SimdFloat4 tx1 = (SimdFloat4(node.max_x[c]) - origin[0]) * inv_dir[0];
+                SimdFloat4 ty0 = (SimdFloat4(node.min_y[c]) - origin[1]) * inv_dir[1];
+                SimdFloat4 ty1 = (SimdFloat4(node.max_y[c]) - origin[1]) * inv_dir[1];
+                SimdFloat4 tz0 = (SimdFloat4(node.min_z[c]) - origin[2]) * inv_dir[2];
+                SimdFloat4 tz1 = (SimdFloat4(node.max_z[c]) - origin[2]) * inv_dir[2];
+                SimdFloat4 t_near = simdMax(simdMax(simdMin(tx0, tx1), simdMin(ty0, ty1)), simdMax(simdMin(tz0, tz1), t_min));
+                SimdFloat4 t_far = simdMin(simdMin(simdMax(tx0, tx1), simdMax(ty0, ty1)), simdMin(simdMax(tz0, tz1), closest));
+
+                int lanes = simdMoveMask(t_near <= t_far) & entry.mask;
+                if (lanes == 0)
+                {
+                    continue;
+                }
+
+                // 以活跃光线中最小的入口距离作为排序键
+                alignas(16) float near_values[4];
+                t_near.store(near_values);
+                float distance = std::numeric_limits<float>::max();
+                for (int lane = 0; lane < 4; ++lane)
+                {
+                    if (lanes & (1 << lane))
+                    {
+                        distance = std::min(distance, near_values[lane]);
+                    }
+                }
+
+                uint32_t slot = hit_count++;
+                while (slot > 0 && hit_distances[slot - 1] < distance)
+                {
+                    hit_children[slot] = hit_children[slot - 1];
+                    hit_masks[slot] = hit_masks[slot - 1];
+                    hit_distances[slot] = hit_distances[slot - 1];
+                    --slot;
+                }
+                hit_children[slot] = node.child[c];
+                hit_masks[slot] = lanes;
+                hit_distances[slot] = distance;
+            }
+            for (uint32_t i = 0; i < hit_count; ++i)
+            {
+                stack.push({ hit_children[i], hit_masks[i] });
+            }
+        }
+
+        alignas(16) float t_values[4];
+        alignas(16) float u_values[4];
+        alignas(16) float v_values[4];
+        closest.store(t_values);
+        hit_u.store(u_values);
+        hit_v.store(v_values);
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            if (hits[lane].valid())
+            {
+                hits[lane].t = t_values[lane];
+                hits[lane].u = u_values[lane];
+                hits[lane].v = v_values[lane];
+            }
+        }
+    }
+
+} // namespace Elish
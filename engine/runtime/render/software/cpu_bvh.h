@@ -0,0 +1,185 @@
+#pragma once
+
+#include "cpu_simd.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Elish
+{
+    /**
+     * @brief 软件光线追踪使用的世界空间三角形
+     * @details 以顶点+两条边存储，便于Möller-Trumbore求交直接使用
+     */
+    struct CpuTriangle
+    {
+        glm::vec3 v0;
+        glm::vec3 e1;           // v1 - v0
+        glm::vec3 e2;           // v2 - v0
+        uint32_t object_id;     // 所属渲染对象索引
+        uint32_t primitive_id;  // 对象内的三角形序号
+    };
+
+    /**
+     * @brief 单条光线
+     */
+    struct CpuRay
+    {
+        glm::vec3 origin;
+        glm::vec3 direction;
+        float t_min = 0.001f;
+        float t_max = 10000.0f;
+    };
+
+    /**
+     * @brief 命中结果
+     * @details triangle为BVH内部三角形数组下标，未命中时为k_invalid_triangle；u/v为相对v1、v2的重心坐标
+     */
+    struct CpuHit
+    {
+        static constexpr uint32_t k_invalid_triangle = 0xFFFFFFFFu;
+
+        float t = 0.0f;
+        float u = 0.0f;
+        float v = 0.0f;
+        uint32_t triangle = k_invalid_triangle;
+
+        bool valid() const { return triangle != k_invalid_triangle; }
+    };
+
+    /**
+     * @brief 4条光线组成的SoA光线包
+     * @details 用于相干的主光线，4条光线共享一次节点遍历；active为逐通道掩码（与SimdFloat4比较结果一致）
+     */
+    struct alignas(16) CpuRayPacket4
+    {
+        alignas(16) float origin_x[4];
+        alignas(16) float origin_y[4];
+        alignas(16) float origin_z[4];
+        alignas(16) float dir_x[4];
+        alignas(16) float dir_y[4];
+        alignas(16) float dir_z[4];
+        alignas(16) float t_min[4];
+        alignas(16) float t_max[4];
+        int active_mask = 0xF;  // bit i: 第i条光线参与遍历
+
+        void setRay(int lane, const CpuRay& ray);
+    };
+
+    /**
+     * @brief 4路包围盒层次结构（BVH4）
+     * @details 构建：对质心分箱的SAH二叉构建，较大的子树通过std::async分发到多个核心；
+     *                随后把二叉树按表面积贪心展开，折叠为每个节点4个子节点的宽BVH，子节点包围盒按SoA存储。
+     *          遍历：单光线一次SIMD运算同时测试4个子包围盒；光线包将4条光线放入SIMD通道，
+     *                对每个子包围盒一次测试4条光线，叶节点三角形同样按光线并行求交
+     */
+    class CpuBvh
+    {
+    public:
+        /**
+         * @brief 构建BVH
+         * @param triangles 世界空间三角形（拷贝保存，叶节点顺序会重排）
+         * @param worker_count 并行构建使用的线程数上限，0表示使用硬件并发数
+         */
+        void build(std::vector<CpuTriangle> triangles, uint32_t worker_count = 0);
+
+        void clear();
+
+        bool empty() const { return m_nodes.empty(); }
+
+        /**
+         * @brief 最近命中查询
+         * @return 命中返回true，hit中写入最近交点
+         */
+        bool intersect(const CpuRay& ray, CpuHit& hit) const;
+
+        /**
+         * @brief 任意命中查询（阴影/遮挡），找到第一个交点即返回
+         */
+        bool occluded(const CpuRay& ray) const;
+
+        /**
+         * @brief 4光线包最近命中查询
+         * @param packet 光线包，仅active_mask中的通道参与
+         * @param hits 输出4个命中结果
+         */
+        void intersectPacket(const CpuRayPacket4& packet, CpuHit hits[4]) const;
+
+        const std::vector<CpuTriangle>& getTriangles() const { return m_triangles; }
+        uint32_t getNodeCount() const { return static_cast<uint32_t>(m_nodes.size()); }
+
+        /**
+         * @brief 宽节点层数，根节点为第1层
+         */
+        uint32_t getDepth() const { return m_depth; }
+
+    private:
+        static constexpr uint32_t k_leaf_flag = 0x80000000u;
+        static constexpr uint32_t k_empty_child = 0xFFFFFFFFu;
+        static constexpr uint32_t k_max_leaf_size = 4;
+        static constexpr uint32_t k_bin_count = 16;
+        static constexpr uint32_t k_parallel_threshold = 16384;  // 子树三角形数超过该值时并行构建
+        static constexpr uint32_t k_inline_stack_size = 96;       // 遍历栈在栈上预留的容量，树更深时改用堆内存
+
+        struct Aabb
+        {
+            glm::vec3 min = glm::vec3(1e30f);
+            glm::vec3 max = glm::vec3(-1e30f);
+
+            void grow(const glm::vec3& p) { min = glm::min(min, p); max = glm::max(max, p); }
+            void grow(const Aabb& b) { min = glm::min(min, b.min); max = glm::max(max, b.max); }
+            float area() const;
+        };
+
+        /** @brief 二叉构建节点，仅在构建期间存在 */
+        struct BuildNode
+        {
+            Aabb bounds;
+            std::unique_ptr<BuildNode> children[2];
+            uint32_t first = 0;
+            uint32_t count = 0;
+
+            bool isLeaf() const { return !children[0]; }
+        };
+
+        /** @brief 宽节点：4个子包围盒按分量连续存放，便于一次加载 */
+        struct alignas(16) Node4
+        {
+            alignas(16) float min_x[4];
+            alignas(16) float min_y[4];
+            alignas(16) float min_z[4];
+            alignas(16) float max_x[4];
+            alignas(16) float max_y[4];
+            alignas(16) float max_z[4];
+            uint32_t child[4];  // 内部节点下标；带k_leaf_flag时为叶表下标；k_empty_child表示空槽
+        };
+
+        struct Leaf
+        {
+            uint32_t first;
+            uint32_t count;
+        };
+
+        std::unique_ptr<BuildNode> buildRecursive(uint32_t first, uint32_t count, uint32_t depth);
+        uint32_t collapse(const BuildNode* node, uint32_t depth);
+        uint32_t makeLeaf(const BuildNode* node);
+
+        bool intersectTriangle(const CpuRay& ray, uint32_t index, float t_max, CpuHit& hit) const;
+        int intersectChildren(const Node4& node, const SimdFloat4 origin[3], const SimdFloat4 inv_dir[3],
+                              float t_min, float t_max, float distances[4]) const;
+
+    private:
+        std::vector<CpuTriangle> m_triangles;
+        std::vector<Aabb> m_primitive_bounds;       // 构建期间使用
+        std::vector<glm::vec3> m_primitive_centroids;
+        std::vector<uint32_t> m_primitive_indices;
+        std::vector<Node4> m_nodes;
+        std::vector<Leaf> m_leaves;
+        uint32_t m_root = k_empty_child;
+        uint32_t m_depth = 0;
+        uint32_t m_stack_capacity = 0;              // 遍历栈所需容量：每下降一层弹出1个、压入至多4个，即3 * m_depth + 1
+        uint32_t m_parallel_depth = 0;              // 不超过该深度的子树允许并行
+    };
+
+} // namespace Elish
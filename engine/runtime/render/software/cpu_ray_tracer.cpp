@@ -0,0 +1,257 @@
+#include "cpu_ray_tracer.h"
+#include "../render_resource.h"
+#include "../../core/base/macro.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+namespace Elish
+{
+    namespace
+    {
+        /**
+         * @brief 与光线追踪实例变换一致的模型矩阵：平移 -> XYZ欧拉旋转 -> 缩放，再逐级左乘父物体的局部矩阵
+         * @details parentIndex链由RenderResource保证无环，父物体尚未加载时链在此中断
+         */
+        glm::mat4 computeModelMatrix(const std::vector<RenderObject>& render_objects, size_t index)
+        {
+            glm::mat4 world(1.0f);
+            while (index < render_objects.size())
+            {
+                const ModelAnimationParams& params = render_objects[index].animationParams;
+                glm::mat4 model = glm::translate(glm::mat4(1.0f), params.position);
+                model = glm::rotate(model, params.rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
+                model = glm::rotate(model, params.rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
+                model = glm::rotate(model, params.rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
+                world = glm::scale(model, params.scale) * world;
+                if (params.parentIndex < 0)
+                {
+                    break;
+                }
+                index = static_cast<size_t>(params.parentIndex);
+            }
+            return world;
+        }
+
+        /**
+         * @brief 生成像素中心的主光线，与raytracing.rgen一致
+         */
+        CpuRay makeCameraRay(const glm::mat4& view_inverse, const glm::mat4& proj_inverse,
+                             uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+        {
+            glm::vec2 uv((x + 0.5f) / width, (y + 0.5f) / height);
+            glm::vec2 d = uv * 2.0f - 1.0f;
+            glm::vec4 target = proj_inverse * glm::vec4(d.x, d.y, 1.0f, 1.0f);
+
+            CpuRay ray;
+            ray.origin = glm::vec3(view_inverse * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+            ray.direction = glm::vec3(view_inverse * glm::vec4(glm::normalize(glm::vec3(target)), 0.0f));
+            ray.t_min = 0.001f;
+            ray.t_max = 10000.0f;
+            return ray;
+        }
+    }
+
+    bool CpuRayTracer::updateScene(const RenderResource& render_resource)
+    {
+        const auto& render_objects = render_resource.getLoadedRenderObjects();
+
+        size_t seed = 0;
+        auto hash_combine = [&seed](size_t value) {
+            seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        };
+        auto hash_vec3 = [&hash_combine](const glm::vec3& v) {
+            hash_combine(std::hash<float>{}(v.x));
+            hash_combine(std::hash<float>{}(v.y));
+            hash_combine(std::hash<float>{}(v.z));
+        };
+        hash_combine(render_objects.size());
+        for (const auto& render_object : render_objects)
+        {
+            hash_combine(render_object.vertices.size());
+            hash_combine(render_object.indices.size());
+            hash_combine(reinterpret_cast<size_t>(render_object.vertices.data()));
+            hash_vec3(render_object.animationParams.position);
+            hash_vec3(render_object.animationParams.rotation);
+            hash_vec3(render_object.animationParams.scale);
+            hash_combine(static_cast<size_t>(render_object.animationParams.parentIndex + 1));
+        }
+
+        if (m_has_scene && seed == m_scene_hash)
+        {
+            return false;
+        }
+
+        auto build_start = std::chrono::high_resolution_clock::now();
+
+        std::vector<CpuTriangle> triangles;
+        m_objects.assign(render_objects.size(), ObjectShading{});
+        for (size_t object_index = 0; object_index < render_objects.size(); ++object_index)
+        {
+            const RenderObject& render_object = render_objects[object_index];
+            glm::mat4 model = computeModelMatrix(render_objects, object_index);
+            glm::mat3 normal_matrix = glm::transpose(glm::inverse(glm::mat3(model)));
+
+            ObjectShading& shading = m_objects[object_index];
+            shading.indices = render_object.indices;
+            shading.normals.resize(render_object.vertices.size());
+            shading.colors.resize(render_object.vertices.size());
+            std::vector<glm::vec3> positions(render_object.vertices.size());
+            for (size_t i = 0; i < render_object.vertices.size(); ++i)
+            {
+                const Vertex& vertex = render_object.vertices[i];
+                positions[i] = glm::vec3(model * glm::vec4(vertex.pos, 1.0f));
+                shading.normals[i] = normal_matrix * vertex.normal;
+                shading.colors[i] = vertex.color;
+            }
+
+            uint32_t triangle_count = static_cast<uint32_t>(render_object.indices.size() / 3);
+            triangles.reserve(triangles.size() + triangle_count);
+            for (uint32_t t = 0; t < triangle_count; ++t)
+            {
+                uint32_t i0 = render_object.indices[t * 3 + 0];
+                uint32_t i1 = render_object.indices[t * 3 + 1];
+                uint32_t i2 = render_object.indices[t * 3 + 2];
+                if (i0 >= positions.size() || i1 >= positions.size() || i2 >= positions.size())
+                {
+                    continue;
+                }
+
+                CpuTriangle triangle;
+                triangle.v0 = positions[i0];
+                triangle.e1 = positions[i1] - positions[i0];
+                triangle.e2 = positions[i2] - positions[i0];
+                triangle.object_id = static_cast<uint32_t>(object_index);
+                triangle.primitive_id = t;
+                triangles.push_back(triangle);
+            }
+        }
+
+        size_t triangle_count = triangles.size();
+        m_bvh.build(std::move(triangles), m_worker_count);
+        m_scene_hash = seed;
+        m_has_scene = true;
+
+        auto build_time = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - build_start).count();
+        LOG_DEBUG("[CpuRayTracer] BVH rebuilt: {} triangles, {} nodes, {:.2f}ms", triangle_count, m_bvh.getNodeCount(), build_time);
+        return true;
+    }
+
+    /**
+     * @brief 渲染一帧
+     * @details 以2像素高的行带为任务单位，工作线程通过原子计数领取；每个2x2像素块组成一个光线包，
+     *          图像右/下边缘不足2x2的部分通过active_mask屏蔽
+     */
+    void CpuRayTracer::render(const glm::mat4& view_inverse, const glm::mat4& proj_inverse,
+                              const glm::vec3& light_position, const glm::vec3& light_color,
+                              uint32_t width, uint32_t height, std::vector<uint32_t>& pixels) const
+    {
+        pixels.resize(static_cast<size_t>(width) * height);
+        if (width == 0 || height == 0)
+        {
+            return;
+        }
+
+        uint32_t row_pair_count = (height + 1) / 2;
+        std::atomic<uint32_t> next_row_pair{ 0 };
+
+        auto worker = [&]() {
+            for (uint32_t row_pair = next_row_pair++; row_pair < row_pair_count; row_pair = next_row_pair++)
+            {
+                uint32_t y0 = row_pair * 2;
+                for (uint32_t x0 = 0; x0 < width; x0 += 2)
+                {
+                    CpuRayPacket4 packet;
+                    CpuRay rays[4];
+                    packet.active_mask = 0;
+                    for (int lane = 0; lane < 4; ++lane)
+                    {
+                        uint32_t x = std::min(x0 + (lane & 1), width - 1);
+                        uint32_t y = std::min(y0 + (lane >> 1), height - 1);
+                        rays[lane] = makeCameraRay(view_inverse, proj_inverse, x, y, width, height);
+                        packet.setRay(lane, rays[lane]);
+                        if (x0 + (lane & 1) < width && y0 + (lane >> 1) < height)
+                        {
+                            packet.active_mask |= 1 << lane;
+                        }
+                    }
+
+                    CpuHit hits[4];
+                    m_bvh.intersectPacket(packet, hits);
+
+                    for (int lane = 0; lane < 4; ++lane)
+                    {
+                        if (!(packet.active_mask & (1 << lane)))
+                        {
+                            continue;
+                        }
+                        glm::vec3 color = hits[lane].valid()
+                            ? shade(rays[lane], hits[lane], light_position, light_color)
+                            : sky(rays[lane].direction);
+                        uint32_t x = x0 + (lane & 1);
+                        uint32_t y = y0 + (lane >> 1);
+                        pixels[static_cast<size_t>(y) * width + x] = packColor(color);
+                    }
+                }
+            }
+        };
+
+        uint32_t worker_count = m_worker_count ? m_worker_count : std::max(1u, std::thread::hardware_concurrency());
+        worker_count = std::min(worker_count, row_pair_count);
+
+        std::vector<std::thread> threads;
+        threads.reserve(worker_count - 1);
+        for (uint32_t i = 1; i < worker_count; ++i)
+        {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    glm::vec3 CpuRayTracer::shade(const CpuRay& ray, const CpuHit& hit,
+                                  const glm::vec3& light_position, const glm::vec3& light_color) const
+    {
+        const CpuTriangle& triangle = m_bvh.getTriangles()[hit.triangle];
+        const ObjectShading& shading = m_objects[triangle.object_id];
+
+        uint32_t i0 = shading.indices[triangle.primitive_id * 3 + 0];
+        uint32_t i1 = shading.indices[triangle.primitive_id * 3 + 1];
+        uint32_t i2 = shading.indices[triangle.primitive_id * 3 + 2];
+        glm::vec3 barycentrics(1.0f - hit.u - hit.v, hit.u, hit.v);
+
+        glm::vec3 normal = shading.normals[i0] * barycentrics.x + shading.normals[i1] * barycentrics.y + shading.normals[i2] * barycentrics.z;
+        glm::vec3 albedo = shading.colors[i0] * barycentrics.x + shading.colors[i1] * barycentrics.y + shading.colors[i2] * barycentrics.z;
+        float normal_length = glm::length(normal);
+        normal = normal_length > 0.0f ? normal / normal_length : glm::vec3(0.0f, 1.0f, 0.0f);
+
+        glm::vec3 position = ray.origin + ray.direction * hit.t;
+        glm::vec3 light_dir = glm::normalize(light_position - position);
+        float diffuse = std::max(glm::dot(normal, light_dir), 0.0f);
+
+        return 0.2f * albedo + diffuse * albedo * light_color;
+    }
+
+    glm::vec3 CpuRayTracer::sky(const glm::vec3& direction)
+    {
+        float t = 0.5f * (glm::normalize(direction).y + 1.0f);
+        return glm::mix(glm::vec3(1.0f), glm::vec3(0.5f, 0.7f, 1.0f), t);
+    }
+
+    uint32_t CpuRayTracer::packColor(const glm::vec3& color)
+    {
+        glm::vec3 c = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+        return static_cast<uint32_t>(c.r) |
+               (static_cast<uint32_t>(c.g) << 8) |
+               (static_cast<uint32_t>(c.b) << 16) |
+               (255u << 24);
+    }
+
+} // namespace Elish
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "cpu_bvh.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Elish
+{
+    class RenderResource;
+
+    /**
+     * @brief CPU软件光线追踪器
+     * @details 设备不支持硬件光线追踪（或无GPU的CI环境）时的回退实现：
+     *          - 从RenderResource的渲染对象生成世界空间三角形并构建CpuBvh，仅在场景变化时重建
+     *          - 相机光线、Lambert着色与渐变天空与raytracing.rgen/rchit/rmiss保持一致，每像素单采样
+     *          - 以2x2像素为一个光线包在多个线程上并行追踪，输出RGBA8像素供上传到光线追踪输出图像
+     */
+    class CpuRayTracer
+    {
+    public:
+        /**
+         * @brief 同步场景几何
+         * @details 以物体数量、顶点/索引数量与变换参数计算哈希，未变化时直接返回
+         * @param render_resource 渲染资源
+         * @return 本次调用是否重建了BVH
+         */
+        bool updateScene(const RenderResource& render_resource);
+
+        /**
+         * @brief 渲染一帧
+         * @param view_inverse 视图矩阵的逆
+         * @param proj_inverse 投影矩阵的逆
+         * @param light_position 点光源位置
+         * @param light_color 点光源颜色
+         * @param width 输出宽度
+         * @param height 输出高度
+         * @param pixels 输出像素（RGBA8，行优先，按需调整大小）
+         */
+        void render(const glm::mat4& view_inverse, const glm::mat4& proj_inverse,
+                    const glm::vec3& light_position, const glm::vec3& light_color,
+                    uint32_t width, uint32_t height, std::vector<uint32_t>& pixels) const;
+
+        /**
+         * @brief 场景最近命中查询（供拾取、调试等CPU侧查询使用）
+         */
+        bool intersect(const CpuRay& ray, CpuHit& hit) const { return m_bvh.intersect(ray, hit); }
+
+        /**
+         * @brief 场景遮挡查询
+         */
+        bool occluded(const CpuRay& ray) const { return m_bvh.occluded(ray); }
+
+        uint32_t getTriangleCount() const { return static_cast<uint32_t>(m_bvh.getTriangles().size()); }
+        void setWorkerCount(uint32_t worker_count) { m_worker_count = worker_count; }
+
+    private:
+        /** @brief 每个渲染对象的着色数据（世界空间法线与顶点色） */
+        struct ObjectShading
+        {
+            std::vector<uint32_t> indices;
+            std::vector<glm::vec3> normals;
+            std::vector<glm::vec3> colors;
+        };
+
+        /**
+         * @brief 计算命中点着色，与raytracing.rchit一致
+         */
+        glm::vec3 shade(const CpuRay& ray, const CpuHit& hit,
+                        const glm::vec3& light_position, const glm::vec3& light_color) const;
+
+        /**
+         * @brief 未命中时的渐变天空，与raytracing.rmiss一致
+         */
+        static glm::vec3 sky(const glm::vec3& direction);
+
+        static uint32_t packColor(const glm::vec3& color);
+
+    private:
+        CpuBvh m_bvh;
+        std::vector<ObjectShading> m_objects;
+        size_t m_scene_hash = 0;
+        bool m_has_scene = false;
+        uint32_t m_worker_count = 0;  // 0表示使用硬件并发数
+    };
+
+} // namespace Elish
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ELISH_CPU_SIMD_SSE 1
+#include <emmintrin.h>
+#else
+#define ELISH_CPU_SIMD_SSE 0
+#endif
+
+namespace Elish
+{
+    /**
+     * @brief 4宽单精度SIMD向量
+     * @details x86平台使用SSE2实现，其他平台退化为逐通道标量实现，接口保持一致；
+     *          比较运算返回逐通道全1/全0掩码，可直接用于select与movemask
+     */
+    struct alignas(16) SimdFloat4
+    {
+#if ELISH_CPU_SIMD_SSE
+        __m128 v;
+
+        SimdFloat4() = default;
+        explicit SimdFloat4(__m128 value) : v(value) {}
+        explicit SimdFloat4(float value) : v(_mm_set1_ps(value)) {}
+        SimdFloat4(float a, float b, float c, float d) : v(_mm_setr_ps(a, b, c, d)) {}
+
+        static SimdFloat4 load(const float* p) { return SimdFloat4(_mm_load_ps(p)); }
+
+        /** @brief 由4位整数生成逐通道掩码（simdMoveMask的逆运算） */
+        static SimdFloat4 fromMask(int bits)
+        {
+            return SimdFloat4(_mm_castsi128_ps(_mm_setr_epi32(
+                (bits & 1) ? -1 : 0, (bits & 2) ? -1 : 0, (bits & 4) ? -1 : 0, (bits & 8) ? -1 : 0)));
+        }
+        void store(float* p) const { _mm_store_ps(p, v); }
+
+        friend SimdFloat4 operator+(SimdFloat4 a, SimdFloat4 b) { return SimdFloat4(_mm_add_ps(a.v, b.v)); }
+        friend SimdFloat4 operator-(SimdFloat4 a, SimdFloat4 b) { return SimdFloat4(_mm_sub_ps(a.v, b.v)); }
+        friend SimdFloat4 operator*(SimdFloat4 a, SimdFloat4 b) { return SimdFloat4(_mm_mul_ps(a.v, b.v)); }
+        friend SimdFloat4 operator/(SimdFloat4 a, SimdFloat4 b) { return SimdFloat4(_mm_div_ps(a.v, b.v)); }
+        friend SimdFloat4 operator&(SimdFloat4 a, SimdFloat4 b) { return SimdFloat4(_mm_and_ps(a.v, b.v)); }
+        friend SimdFloat4 operator|(SimdFloat4 a, SimdFloat4 b) { return SimdFloat4(_mm_or_ps(a.v, b.v)); }
+        friend SimdFloat4 operator<(SimdFloat4 a, SimdFloat4 b) { return SimdFloat4(_mm_cmplt_ps(a.v, b.v)); }
+        friend SimdFloat4 operator<=(SimdFloat4 a, SimdFloat4 b) { return SimdFloat4(_mm_cmple_ps(a.v, b.v)); }
+        friend SimdFloat4 operator>(SimdFloat4 a, SimdFloat4 b) { return SimdFloat4(_mm_cmpgt_ps(a.v, b.v)); }
+        friend SimdFloat4 operator>=(SimdFloat4 a, SimdFloat4 b) { return SimdFloat4(_mm_cmpge_ps(a.v, b.v)); }
+
+        friend SimdFloat4 simdMin(SimdFloat4 a, SimdFloat4 b) { return SimdFloat4(_mm_min_ps(a.v, b.v)); }
+        friend SimdFloat4 simdMax(SimdFloat4 a, SimdFloat4 b) { return SimdFloat4(_mm_max_ps(a.v, b.v)); }
+
+        /** @brief 按掩码逐通道选择：掩码为真取a，否则取b */
+        friend SimdFloat4 simdSelect(SimdFloat4 mask, SimdFloat4 a, SimdFloat4 b)
+        {
+            return SimdFloat4(_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)));
+        }
+
+        /** @brief 取每个通道掩码的符号位，组成4位整数 */
+        friend int simdMoveMask(SimdFloat4 mask) { return _mm_movemask_ps(mask.v); }
+#else
+        float v[4];
+
+        SimdFloat4() = default;
+        explicit SimdFloat4(float value) : v{ value, value, value, value } {}
+        SimdFloat4(float a, float b, float c, float d) : v{ a, b, c, d } {}
+
+        static SimdFloat4 load(const float* p) { return SimdFloat4(p[0], p[1], p[2], p[3]); }
+        void store(float* p) const { p[0] = v[0]; p[1] = v[1]; p[2] = v[2]; p[3] = v[3]; }
+
+        static SimdFloat4 fromMask(int bits)
+        {
+            return SimdFloat4(maskValue(bits & 1), maskValue(bits & 2), maskValue(bits & 4), maskValue(bits & 8));
+        }
+
+        template <typename Op>
+        static SimdFloat4 map(SimdFloat4 a, SimdFloat4 b, Op op)
+        {
+            return SimdFloat4(op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3]));
+        }
+
+        static float maskValue(bool value)
+        {
+            uint32_t bits = value ? 0xFFFFFFFFu : 0u;
+            float result;
+            std::memcpy(&result, &bits, sizeof(float));
+            return result;
+        }
+
+        static uint32_t bitsOf(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(float));
+            return bits;
+        }
+
+        friend SimdFloat4 operator+(SimdFloat4 a, SimdFloat4 b) { return map(a, b, [](float x, float y) { return x + y; }); }
+        friend SimdFloat4 operator-(SimdFloat4 a, SimdFloat4 b) { return map(a, b, [](float x, float y) { return x - y; }); }
+        friend SimdFloat4 operator*(SimdFloat4 a, SimdFloat4 b) { return map(a, b, [](float x, float y) { return x * y; }); }
+        friend SimdFloat4 operator/(SimdFloat4 a, SimdFloat4 b) { return map(a, b, [](float x, float y) { return x / y; }); }
+        friend SimdFloat4 operator&(SimdFloat4 a, SimdFloat4 b)
+        {
+            return map(a, b, [](float x, float y) { return maskValue((bitsOf(x) & bitsOf(y)) != 0); });
+        }
+        friend SimdFloat4 operator|(SimdFloat4 a, SimdFloat4 b)
+        {
+            return map(a, b, [](float x, float y) { return maskValue((bitsOf(x) | bitsOf(y)) != 0); });
+        }
+        friend SimdFloat4 operator<(SimdFloat4 a, SimdFloat4 b) { return map(a, b, [](float x, float y) { return maskValue(x < y); }); }
+        friend SimdFloat4 operator<=(SimdFloat4 a, SimdFloat4 b) { return map(a, b, [](float x, float y) { return maskValue(x <= y); }); }
+        friend SimdFloat4 operator>(SimdFloat4 a, SimdFloat4 b) { return map(a, b, [](float x, float y) { return maskValue(x > y); }); }
+        friend SimdFloat4 operator>=(SimdFloat4 a, SimdFloat4 b) { return map(a, b, [](float x, float y) { return maskValue(x >= y); }); }
+
+        friend SimdFloat4 simdMin(SimdFloat4 a, SimdFloat4 b) { return map(a, b, [](float x, float y) { return y < x ? y : x; }); }
+        friend SimdFloat4 simdMax(SimdFloat4 a, SimdFloat4 b) { return map(a, b, [](float x, float y) { return y > x ? y : x; }); }
+
+        friend SimdFloat4 simdSelect(SimdFloat4 mask, SimdFloat4 a, SimdFloat4 b)
+        {
+            SimdFloat4 result;
+            for (int i = 0; i < 4; ++i)
+            {
+                result.v[i] = bitsOf(mask.v[i]) ? a.v[i] : b.v[i];
+            }
+            return result;
+        }
+
+        friend int simdMoveMask(SimdFloat4 mask)
+        {
+            int result = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                result |= (bitsOf(mask.v[i]) >> 31) << i;
+            }
+            return result;
+        }
+#endif
+    };
+
+} // namespace Elish
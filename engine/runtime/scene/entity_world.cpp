@@ -0,0 +1,320 @@
+#include "entity_world.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+namespace Elish
+{
+    namespace
+    {
+        struct ComponentTypeRegistry
+        {
+            std::mutex        mutex;
+            ComponentTypeInfo infos[k_max_component_types];
+            uint32_t          count = 0;
+        };
+
+        ComponentTypeRegistry& getRegistry()
+        {
+            static ComponentTypeRegistry registry;
+            return registry;
+        }
+
+        size_t alignUp(size_t value, size_t alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    } // namespace
+
+    ComponentTypeId registerComponentType(const ComponentTypeInfo& info)
+    {
+        ComponentTypeRegistry& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        if (registry.count >= k_max_component_types)
+        {
+            throw std::runtime_error("Too many ECS component types");
+        }
+        registry.infos[registry.count] = info;
+        return registry.count++;
+    }
+
+    const ComponentTypeInfo& getComponentTypeInfo(ComponentTypeId type)
+    {
+        // 注册只追加，已分配ID的表项不再改写
+        return getRegistry().infos[type];
+    }
+
+    // ---------------------------------------------------------------------
+    // Archetype
+    // ---------------------------------------------------------------------
+
+    Archetype::Archetype(ComponentMask mask)
+        : m_mask(mask)
+    {
+        std::fill(std::begin(m_columns), std::end(m_columns), int8_t(-1));
+        for (ComponentTypeId type = 0; type < k_max_component_types; ++type)
+        {
+            if ((mask >> type) & 1)
+            {
+                m_columns[type] = static_cast<int8_t>(m_types.size());
+                m_types.push_back(type);
+            }
+        }
+
+        // 估算容量后逐步缩小，直到句柄数组与各组件数组（含对齐填充）放得进一块
+        size_t row_bytes = sizeof(Entity);
+        for (ComponentTypeId type : m_types)
+        {
+            row_bytes += getComponentTypeInfo(type).size;
+        }
+        uint32_t capacity = static_cast<uint32_t>(std::max<size_t>(1, k_chunk_size / row_bytes));
+        m_column_offsets.resize(m_types.size());
+        while (true)
+        {
+            size_t offset = sizeof(Entity) * capacity;
+            for (size_t column = 0; column < m_types.size(); ++column)
+            {
+                const ComponentTypeInfo& info = getComponentTypeInfo(m_types[column]);
+                offset = alignUp(offset, info.alignment);
+                m_column_offsets[column] = offset;
+                offset += info.size * capacity;
+            }
+            if (offset <= k_chunk_size || capacity == 1)
+            {
+                // 单行都放不下的超大组件按实际大小分配块
+                m_chunk_bytes = std::max(k_chunk_size, alignUp(offset, k_chunk_alignment));
+                break;
+            }
+            --capacity;
+        }
+        m_chunk_capacity = capacity;
+    }
+
+    Archetype::~Archetype()
+    {
+        clear();
+    }
+
+    size_t Archetype::getEntityCount() const
+    {
+        return m_chunks.empty() ? 0 : (m_chunks.size() - 1) * m_chunk_capacity + m_chunks.back().count;
+    }
+
+    void* Archetype::getComponentArray(uint32_t chunk, ComponentTypeId type)
+    {
+        int8_t column = m_columns[type];
+        if (column < 0)
+        {
+            return nullptr;
+        }
+        return m_chunks[chunk].data + m_column_offsets[column];
+    }
+
+    void* Archetype::getComponent(uint32_t chunk, uint32_t row, ComponentTypeId type)
+    {
+        uint8_t* array = static_cast<uint8_t*>(getComponentArray(chunk, type));
+        return array ? array + getComponentTypeInfo(type).size * row : nullptr;
+    }
+
+    void Archetype::allocateRow(Entity entity, uint32_t& chunk, uint32_t& row)
+    {
+        if (m_chunks.empty() || m_chunks.back().count == m_chunk_capacity)
+        {
+            Chunk new_chunk;
+            new_chunk.data = static_cast<uint8_t*>(::operator new(m_chunk_bytes, std::align_val_t(k_chunk_alignment)));
+            m_chunks.push_back(new_chunk);
+        }
+
+        chunk = static_cast<uint32_t>(m_chunks.size() - 1);
+        row = m_chunks.back().count++;
+        getEntities(chunk)[row] = entity;
+    }
+
+    Entity Archetype::eraseRow(uint32_t chunk, uint32_t row)
+    {
+        uint32_t last_chunk = static_cast<uint32_t>(m_chunks.size() - 1);
+        uint32_t last_row = m_chunks[last_chunk].count - 1;
+
+        Entity moved{};
+        if (chunk != last_chunk || row != last_row)
+        {
+            for (ComponentTypeId type : m_types)
+            {
+                getComponentTypeInfo(type).relocate(getComponent(chunk, row, type), getComponent(last_chunk, last_row, type));
+            }
+            moved = getEntities(last_chunk)[last_row];
+            getEntities(chunk)[row] = moved;
+        }
+
+        if (--m_chunks[last_chunk].count == 0)
+        {
+            ::operator delete(m_chunks[last_chunk].data, std::align_val_t(k_chunk_alignment));
+            m_chunks.pop_back();
+        }
+        return moved;
+    }
+
+    void Archetype::clear()
+    {
+        for (uint32_t chunk = 0; chunk < m_chunks.size(); ++chunk)
+        {
+            for (ComponentTypeId type : m_types)
+            {
+                const ComponentTypeInfo& info = getComponentTypeInfo(type);
+                uint8_t* array = static_cast<uint8_t*>(getComponentArray(chunk, type));
+                for (uint32_t row = 0; row < m_chunks[chunk].count; ++row)
+                {
+                    info.destroy(array + info.size * row);
+                }
+            }
+            ::operator delete(m_chunks[chunk].data, std::align_val_t(k_chunk_alignment));
+        }
+        m_chunks.clear();
+    }
+
+    // ---------------------------------------------------------------------
+    // EntityWorld
+    // ---------------------------------------------------------------------
+
+    EntityWorld::EntityWorld() = default;
+
+    EntityWorld::~EntityWorld()
+    {
+        clear();
+    }
+
+    Entity EntityWorld::createEntity()
+    {
+        return allocateEntity(getOrCreateArchetype(0));
+    }
+
+    void EntityWorld::destroyEntity(Entity entity)
+    {
+        if (!isAlive(entity))
+        {
+            return;
+        }
+
+        EntityRecord& record = m_records[entity.index];
+        for (ComponentTypeId type : record.archetype->getComponentTypes())
+        {
+            getComponentTypeInfo(type).destroy(record.archetype->getComponent(record.chunk, record.row, type));
+        }
+        eraseRecordRow(record);
+
+        record.archetype = nullptr;
+        ++record.generation;
+        m_free_records.push_back(entity.index);
+        --m_alive_count;
+    }
+
+    bool EntityWorld::isAlive(Entity entity) const
+    {
+        return entity.index < m_records.size() &&
+               m_records[entity.index].archetype != nullptr &&
+               m_records[entity.index].generation == entity.generation;
+    }
+
+    void EntityWorld::clear()
+    {
+        for (Archetype* archetype : m_archetype_list)
+        {
+            archetype->clear();
+        }
+
+        // 记录保留并递增代数，旧句柄全部失效
+        m_free_records.clear();
+        for (uint32_t index = 0; index < m_records.size(); ++index)
+        {
+            EntityRecord& record = m_records[index];
+            if (record.archetype)
+            {
+                record.archetype = nullptr;
+                ++record.generation;
+            }
+            m_free_records.push_back(index);
+        }
+        m_alive_count = 0;
+    }
+
+    Archetype* EntityWorld::getOrCreateArchetype(ComponentMask mask)
+    {
+        auto it = m_archetypes.find(mask);
+        if (it != m_archetypes.end())
+        {
+            return it->second.get();
+        }
+
+        std::unique_ptr<Archetype> archetype = std::make_unique<Archetype>(mask);
+        Archetype* result = archetype.get();
+        m_archetypes.emplace(mask, std::move(archetype));
+        m_archetype_list.push_back(result);
+        return result;
+    }
+
+    Entity EntityWorld::allocateEntity(Archetype* archetype)
+    {
+        Entity entity;
+        if (!m_free_records.empty())
+        {
+            entity.index = m_free_records.back();
+            m_free_records.pop_back();
+        }
+        else
+        {
+            entity.index = static_cast<uint32_t>(m_records.size());
+            m_records.emplace_back();
+        }
+
+        EntityRecord& record = m_records[entity.index];
+        entity.generation = record.generation;
+        record.archetype = archetype;
+        archetype->allocateRow(entity, record.chunk, record.row);
+        ++m_alive_count;
+        return entity;
+    }
+
+    void EntityWorld::moveEntity(Entity entity, Archetype* target)
+    {
+        EntityRecord& record = m_records[entity.index];
+        Archetype* source = record.archetype;
+        if (source == target)
+        {
+            return;
+        }
+
+        uint32_t chunk = 0;
+        uint32_t row = 0;
+        target->allocateRow(entity, chunk, row);
+        for (ComponentTypeId type : source->getComponentTypes())
+        {
+            void* component = source->getComponent(record.chunk, record.row, type);
+            if (target->hasComponent(type))
+            {
+                getComponentTypeInfo(type).relocate(target->getComponent(chunk, row, type), component);
+            }
+            else
+            {
+                getComponentTypeInfo(type).destroy(component);
+            }
+        }
+        eraseRecordRow(record);
+
+        record.archetype = target;
+        record.chunk = chunk;
+        record.row = row;
+    }
+
+    void EntityWorld::eraseRecordRow(const EntityRecord& record)
+    {
+        Entity moved = record.archetype->eraseRow(record.chunk, record.row);
+        if (moved.isValid())
+        {
+            EntityRecord& moved_record = m_records[moved.index];
+            moved_record.chunk = record.chunk;
+            moved_record.row = record.row;
+        }
+    }
+} // namespace Elish
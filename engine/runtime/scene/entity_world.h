@@ -0,0 +1,326 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Elish
+{
+    /**
+     * @brief 实体句柄
+     * @details index索引实体记录表，generation在实体销毁后递增，旧句柄因代数不符而失效；
+     *          实体增删组件、在原型之间迁移时句柄保持不变
+     */
+    struct Entity
+    {
+        static constexpr uint32_t k_invalid_index = ~0u;
+
+        uint32_t index = k_invalid_index;
+        uint32_t generation = 0;
+
+        bool isValid() const { return index != k_invalid_index; }
+        bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+        bool operator!=(const Entity& other) const { return !(*this == other); }
+    };
+
+    using ComponentTypeId = uint32_t;
+    using ComponentMask = uint64_t;     // 每个组件类型占一位，原型由组件集合唯一确定
+
+    constexpr uint32_t k_max_component_types = 64;
+
+    /**
+     * @brief 组件类型的类型擦除操作，原型按此在块内搬移和析构组件
+     */
+    struct ComponentTypeInfo
+    {
+        size_t size = 0;
+        size_t alignment = 0;
+        void (*relocate)(void* destination, void* source) = nullptr;   // 移动构造到destination并析构source
+        void (*destroy)(void* object) = nullptr;
+    };
+
+    /**
+     * @brief 注册组件类型
+     * @details 由componentTypeId<T>()在首次使用时调用，超过k_max_component_types时抛出std::runtime_error
+     */
+    ComponentTypeId registerComponentType(const ComponentTypeInfo& info);
+    const ComponentTypeInfo& getComponentTypeInfo(ComponentTypeId type);
+
+    template<typename T>
+    ComponentTypeId componentTypeId()
+    {
+        static const ComponentTypeId id = registerComponentType(ComponentTypeInfo{
+            sizeof(T),
+            alignof(T),
+            [](void* destination, void* source) {
+                T* object = static_cast<T*>(source);
+                new (destination) T(std::move(*object));
+                object->~T();
+            },
+            [](void* object) { static_cast<T*>(object)->~T(); } });
+        return id;
+    }
+
+    template<typename... Ts>
+    ComponentMask componentMask()
+    {
+        ComponentMask mask = 0;
+        ((mask |= ComponentMask(1) << componentTypeId<Ts>()), ...);
+        return mask;
+    }
+
+    /**
+     * @brief 原型：拥有相同组件集合的实体的存储
+     * @details 实体按块存放，每块固定k_chunk_size字节，块内依次为实体句柄数组和各组件的连续数组（SoA），
+     *          遍历时每个组件都是一段连续内存。除最后一块外所有块均为满块，删除行时由最后一行填补空位
+     */
+    class Archetype
+    {
+    public:
+        static constexpr size_t k_chunk_size = 16 * 1024;
+        static constexpr size_t k_chunk_alignment = 64;
+
+        explicit Archetype(ComponentMask mask);
+        ~Archetype();
+
+        Archetype(const Archetype&) = delete;
+        Archetype& operator=(const Archetype&) = delete;
+
+        ComponentMask getMask() const { return m_mask; }
+        bool hasComponent(ComponentTypeId type) const { return (m_mask >> type) & 1; }
+        const std::vector<ComponentTypeId>& getComponentTypes() const { return m_types; }
+
+        uint32_t getChunkCapacity() const { return m_chunk_capacity; }
+        uint32_t getChunkCount() const { return static_cast<uint32_t>(m_chunks.size()); }
+        uint32_t getChunkEntityCount(uint32_t chunk) const { return m_chunks[chunk].count; }
+        size_t getEntityCount() const;
+
+        Entity* getEntities(uint32_t chunk) { return reinterpret_cast<Entity*>(m_chunks[chunk].data); }
+
+        /**
+         * @brief 获取块内某组件的连续数组，原型不含该组件时返回nullptr
+         */
+        void* getComponentArray(uint32_t chunk, ComponentTypeId type);
+
+        template<typename T>
+        T* getComponents(uint32_t chunk) { return static_cast<T*>(getComponentArray(chunk, componentTypeId<T>())); }
+
+        void* getComponent(uint32_t chunk, uint32_t row, ComponentTypeId type);
+
+        /**
+         * @brief 在末尾分配一行并写入实体句柄，组件内存未构造，由调用方构造
+         */
+        void allocateRow(Entity entity, uint32_t& chunk, uint32_t& row);
+
+        /**
+         * @brief 删除一行，该行组件必须已析构或已搬走
+         * @return 被搬入空位的实体（原最后一行），没有搬移时返回无效句柄
+         */
+        Entity eraseRow(uint32_t chunk, uint32_t row);
+
+        /**
+         * @brief 析构全部组件并释放所有块
+         */
+        void clear();
+
+    private:
+        struct Chunk
+        {
+            uint8_t* data = nullptr;
+            uint32_t count = 0;
+        };
+
+        ComponentMask                m_mask = 0;
+        std::vector<ComponentTypeId> m_types;           // 按类型ID升序
+        std::vector<size_t>          m_column_offsets;  // 与m_types一一对应，组件数组在块内的字节偏移
+        int8_t                       m_columns[k_max_component_types];   // 类型ID -> 列索引，-1表示不含
+        uint32_t                     m_chunk_capacity = 0;
+        size_t                       m_chunk_bytes = 0;
+        std::vector<Chunk>           m_chunks;
+    };
+
+    /**
+     * @brief 基于原型的实体组件存储
+     * @details 实体的组件集合决定其所在原型，增删组件时整行迁移到目标原型；查询只遍历包含所需组件的原型，
+     *          按块把连续的组件数组交给系统，系统只接触自己需要的数据，遍历开销与匹配的实体数量成线性关系。
+     *          遍历过程中不得增删实体或组件；非线程安全，只允许在拥有者线程访问
+     */
+    class EntityWorld
+    {
+    public:
+        EntityWorld();
+        ~EntityWorld();
+
+        EntityWorld(const EntityWorld&) = delete;
+        EntityWorld& operator=(const EntityWorld&) = delete;
+
+        Entity createEntity();
+
+        /**
+         * @brief 创建实体并直接放入对应原型，避免逐个添加组件时的多次迁移
+         */
+        template<typename... Ts>
+        Entity createEntity(Ts&&... components)
+        {
+            Archetype* archetype = getOrCreateArchetype(componentMask<std::decay_t<Ts>...>());
+            Entity entity = allocateEntity(archetype);
+            const EntityRecord& record = m_records[entity.index];
+            (new (archetype->getComponent(record.chunk, record.row, componentTypeId<std::decay_t<Ts>>()))
+                 std::decay_t<Ts>(std::forward<Ts>(components)), ...);
+            return entity;
+        }
+
+        void destroyEntity(Entity entity);
+        bool isAlive(Entity entity) const;
+
+        /**
+         * @brief 添加组件，已存在时直接赋值；实体必须存活
+         */
+        template<typename T>
+        T& addComponent(Entity entity, T component)
+        {
+            ComponentTypeId type = componentTypeId<T>();
+            if (T* existing = getComponent<T>(entity))
+            {
+                *existing = std::move(component);
+                return *existing;
+            }
+            EntityRecord& record = m_records[entity.index];
+            moveEntity(entity, getOrCreateArchetype(record.archetype->getMask() | (ComponentMask(1) << type)));
+            return *new (record.archetype->getComponent(record.chunk, record.row, type)) T(std::move(component));
+        }
+
+        /**
+         * @brief 移除组件，不含该组件时不做任何事
+         */
+        template<typename T>
+        void removeComponent(Entity entity)
+        {
+            if (!hasComponent<T>(entity))
+            {
+                return;
+            }
+            ComponentTypeId type = componentTypeId<T>();
+            EntityRecord& record = m_records[entity.index];
+            moveEntity(entity, getOrCreateArchetype(record.archetype->getMask() & ~(ComponentMask(1) << type)));
+        }
+
+        template<typename T>
+        bool hasComponent(Entity entity) const
+        {
+            return isAlive(entity) && m_records[entity.index].archetype->hasComponent(componentTypeId<T>());
+        }
+
+        /**
+         * @return 实体不存在或不含该组件时返回nullptr
+         */
+        template<typename T>
+        T* getComponent(Entity entity)
+        {
+            if (!hasComponent<T>(entity))
+            {
+                return nullptr;
+            }
+            const EntityRecord& record = m_records[entity.index];
+            return static_cast<T*>(record.archetype->getComponent(record.chunk, record.row, componentTypeId<T>()));
+        }
+
+        template<typename T>
+        const T* getComponent(Entity entity) const
+        {
+            return const_cast<EntityWorld*>(this)->getComponent<T>(entity);
+        }
+
+        /**
+         * @brief 按块遍历包含全部Ts组件的实体
+         * @param func 签名为(uint32_t count, const Entity* entities, Ts*... components)，各数组长度为count
+         * @param excluded 含有其中任一组件的原型被跳过
+         */
+        template<typename... Ts, typename Func>
+        void eachChunk(Func&& func, ComponentMask excluded = 0)
+        {
+            const ComponentMask required = componentMask<Ts...>();
+            for (Archetype* archetype : m_archetype_list)
+            {
+                ComponentMask mask = archetype->getMask();
+                if ((mask & required) != required || (mask & excluded) != 0)
+                {
+                    continue;
+                }
+                for (uint32_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk)
+                {
+                    func(archetype->getChunkEntityCount(chunk), archetype->getEntities(chunk), archetype->getComponents<Ts>(chunk)...);
+                }
+            }
+        }
+
+        /**
+         * @brief 逐实体遍历包含全部Ts组件的实体
+         * @param func 签名为(Entity entity, Ts&... components)
+         */
+        template<typename... Ts, typename Func>
+        void each(Func&& func, ComponentMask excluded = 0)
+        {
+            eachChunk<Ts...>([&func](uint32_t count, const Entity* entities, Ts*... components) {
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    func(entities[i], components[i]...);
+                }
+            }, excluded);
+        }
+
+        /**
+         * @brief 统计包含全部Ts组件的实体数量，只累加各块计数
+         */
+        template<typename... Ts>
+        size_t count(ComponentMask excluded = 0) const
+        {
+            size_t total = 0;
+            const_cast<EntityWorld*>(this)->eachChunk<Ts...>(
+                [&total](uint32_t chunk_count, const Entity*, Ts*...) { total += chunk_count; }, excluded);
+            return total;
+        }
+
+        size_t getEntityCount() const { return m_alive_count; }
+        size_t getArchetypeCount() const { return m_archetype_list.size(); }
+
+        /**
+         * @brief 销毁所有实体，已有句柄全部失效
+         */
+        void clear();
+
+    private:
+        struct EntityRecord
+        {
+            Archetype* archetype = nullptr;     // nullptr表示空闲记录
+            uint32_t   chunk = 0;
+            uint32_t   row = 0;
+            uint32_t   generation = 0;
+        };
+
+        Archetype* getOrCreateArchetype(ComponentMask mask);
+        Entity allocateEntity(Archetype* archetype);
+
+        /**
+         * @brief 把实体整行迁移到目标原型
+         * @details 两个原型共有的组件搬移过去，源原型独有的组件析构，目标原型独有的组件内存未构造，由调用方构造
+         */
+        void moveEntity(Entity entity, Archetype* target);
+
+        /**
+         * @brief 删除实体所在行并修正被搬入空位的实体记录
+         */
+        void eraseRecordRow(const EntityRecord& record);
+
+        std::unordered_map<ComponentMask, std::unique_ptr<Archetype>> m_archetypes;
+        std::vector<Archetype*>                                       m_archetype_list;    // 按创建顺序，遍历顺序稳定
+        std::vector<EntityRecord>                                     m_records;
+        std::vector<uint32_t>                                         m_free_records;
+        size_t                                                        m_alive_count = 0;
+    };
+} // namespace Elish
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "scene_graph.h"
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace Elish
+{
+    class RHIBuffer;
+
+    /**
+     * @brief 变换组件
+     * @details position/rotation/scale为相对父节点的局部变换（rotation为XYZ欧拉角，弧度），
+     *          组合顺序：平移 -> 动画旋转 -> X/Y/Z旋转 -> 缩放；局部与世界矩阵存放在node对应的SceneGraph中
+     */
+    struct TransformComponent
+    {
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::vec3 rotation = glm::vec3(0.0f);
+        glm::vec3 scale = glm::vec3(1.0f);
+        SceneNode node;
+    };
+
+    /**
+     * @brief 动画组件：只有绕轴持续旋转的物体带此组件，静态物体与平台不带，变换系统只遍历带此组件的实体
+     */
+    struct AnimationComponent
+    {
+        glm::vec3 rotationAxis = glm::vec3(0.0f, 1.0f, 0.0f);
+        float     rotationSpeed = 1.0f;
+    };
+
+    /**
+     * @brief 网格组件：绘制所需的几何缓冲区句柄与计数
+     * @details 缓冲区由对应的RenderObject创建和销毁，组件只持有句柄，随渲染对象同步；
+     *          只需几何数据的通道（如阴影贴图）遍历此组件，不再读取整个RenderObject
+     */
+    struct MeshComponent
+    {
+        RHIBuffer* vertexBuffer = nullptr;
+        RHIBuffer* indexBuffer = nullptr;      // 为空时按vertexCount非索引绘制
+        uint32_t   vertexCount = 0;
+        uint32_t   indexCount = 0;
+        uint32_t   renderObjectIndex = 0;      // 对应渲染对象的索引，绘制时作为实例索引
+    };
+} // namespace Elish
@@ -0,0 +1,372 @@
+#include "scene_graph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace Elish
+{
+    namespace
+    {
+        const glm::mat4 k_identity(1.0f);
+    } // namespace
+
+    SceneNode SceneGraph::createNode(SceneNode parent)
+    {
+        SceneNode node;
+        if (!m_free_records.empty())
+        {
+            node.index = m_free_records.back();
+            m_free_records.pop_back();
+        }
+        else
+        {
+            node.index = static_cast<uint32_t>(m_records.size());
+            m_records.emplace_back();
+        }
+
+        NodeRecord& record = m_records[node.index];
+        node.generation = record.generation;
+        record.alive = true;
+        record.dirty = false;
+        record.parent = SceneNode::k_invalid_index;
+        record.first_child = SceneNode::k_invalid_index;
+        record.next_sibling = SceneNode::k_invalid_index;
+
+        // 先追加到数组末尾，下次update()时再排到父节点之后
+        record.slot = static_cast<uint32_t>(m_slot_nodes.size());
+        m_slot_nodes.push_back(node.index);
+        m_slot_parents.push_back(k_invalid_slot);
+        m_slot_subtree_ends.push_back(record.slot + 1);
+        m_local_matrices.push_back(k_identity);
+        m_world_matrices.push_back(k_identity);
+
+        if (isAlive(parent))
+        {
+            linkChild(parent.index, node.index);
+        }
+        m_topology_dirty = true;
+        markDirty(node.index);
+        return node;
+    }
+
+    void SceneGraph::destroyNode(SceneNode node)
+    {
+        if (!isAlive(node))
+        {
+            return;
+        }
+
+        NodeRecord& record = m_records[node.index];
+        uint32_t child = record.first_child;
+        while (child != SceneNode::k_invalid_index)
+        {
+            uint32_t next = m_records[child].next_sibling;
+            m_records[child].parent = SceneNode::k_invalid_index;
+            m_records[child].next_sibling = SceneNode::k_invalid_index;
+            if (record.parent != SceneNode::k_invalid_index)
+            {
+                linkChild(record.parent, child);
+            }
+            markDirty(child);
+            child = next;
+        }
+        if (record.parent != SceneNode::k_invalid_index)
+        {
+            unlinkChild(record.parent, node.index);
+        }
+
+        // 数组中的旧位置在下次重建时丢弃
+        m_slot_nodes[record.slot] = SceneNode::k_invalid_index;
+        record.alive = false;
+        record.dirty = false;
+        record.slot = k_invalid_slot;
+        record.first_child = SceneNode::k_invalid_index;
+        ++record.generation;
+        m_free_records.push_back(node.index);
+        m_topology_dirty = true;
+    }
+
+    bool SceneGraph::isAlive(SceneNode node) const
+    {
+        return node.index < m_records.size() &&
+               m_records[node.index].alive &&
+               m_records[node.index].generation == node.generation;
+    }
+
+    bool SceneGraph::setParent(SceneNode node, SceneNode parent)
+    {
+        if (!isAlive(node) || (parent.isValid() && !isAlive(parent)))
+        {
+            return false;
+        }
+
+        NodeRecord& record = m_records[node.index];
+        uint32_t new_parent = parent.isValid() ? parent.index : SceneNode::k_invalid_index;
+        if (record.parent == new_parent)
+        {
+            return true;
+        }
+
+        // 新父节点不能是自身或自身的后代
+        for (uint32_t ancestor = new_parent; ancestor != SceneNode::k_invalid_index; ancestor = m_records[ancestor].parent)
+        {
+            if (ancestor == node.index)
+            {
+                return false;
+            }
+        }
+
+        if (record.parent != SceneNode::k_invalid_index)
+        {
+            unlinkChild(record.parent, node.index);
+        }
+        if (new_parent != SceneNode::k_invalid_index)
+        {
+            linkChild(new_parent, node.index);
+        }
+        m_topology_dirty = true;
+        markDirty(node.index);
+        return true;
+    }
+
+    SceneNode SceneGraph::getParent(SceneNode node) const
+    {
+        if (!isAlive(node) || m_records[node.index].parent == SceneNode::k_invalid_index)
+        {
+            return SceneNode{};
+        }
+        uint32_t parent = m_records[node.index].parent;
+        return SceneNode{ parent, m_records[parent].generation };
+    }
+
+    void SceneGraph::setLocalMatrix(SceneNode node, const glm::mat4& local)
+    {
+        if (!isAlive(node))
+        {
+            return;
+        }
+        m_local_matrices[m_records[node.index].slot] = local;
+        markDirty(node.index);
+    }
+
+    const glm::mat4& SceneGraph::getLocalMatrix(SceneNode node) const
+    {
+        return isAlive(node) ? m_local_matrices[m_records[node.index].slot] : k_identity;
+    }
+
+    const glm::mat4& SceneGraph::getWorldMatrix(SceneNode node) const
+    {
+        return isAlive(node) ? m_world_matrices[m_records[node.index].slot] : k_identity;
+    }
+
+    /**
+     * @brief 传播脏标记并重算变化子树的世界矩阵
+     * @details 脏节点按slot排序后依次扫描：落在前一个区间内的节点是其后代，已被该区间覆盖，直接跳过；
+     *          得到的区间互不重叠，区间起点的父节点不在任何脏区间内，世界矩阵已是最新，可以安全地并行读取
+     */
+    uint32_t SceneGraph::update()
+    {
+        if (m_topology_dirty)
+        {
+            rebuildOrder();
+        }
+        if (m_dirty_nodes.empty())
+        {
+            return 0;
+        }
+
+        std::vector<uint32_t> dirty_slots;
+        dirty_slots.reserve(m_dirty_nodes.size());
+        for (uint32_t index : m_dirty_nodes)
+        {
+            NodeRecord& record = m_records[index];
+            if (record.alive && record.dirty)
+            {
+                dirty_slots.push_back(record.slot);
+            }
+            record.dirty = false;
+        }
+        m_dirty_nodes.clear();
+        std::sort(dirty_slots.begin(), dirty_slots.end());
+
+        m_dirty_ranges.clear();
+        uint32_t node_count = 0;
+        for (uint32_t slot : dirty_slots)
+        {
+            if (!m_dirty_ranges.empty() && slot < m_dirty_ranges.back().end)
+            {
+                continue;
+            }
+            DirtyRange range{ slot, m_slot_subtree_ends[slot] };
+            node_count += range.end - range.begin;
+            m_dirty_ranges.push_back(range);
+        }
+
+        uint32_t worker_count = m_worker_count ? m_worker_count : std::max(1u, std::thread::hardware_concurrency());
+        worker_count = std::min(worker_count, static_cast<uint32_t>(m_dirty_ranges.size()));
+        if (worker_count <= 1 || node_count < k_parallel_min_nodes)
+        {
+            for (const DirtyRange& range : m_dirty_ranges)
+            {
+                updateRange(range);
+            }
+            return node_count;
+        }
+
+        std::atomic<uint32_t> next_range{ 0 };
+        const uint32_t range_count = static_cast<uint32_t>(m_dirty_ranges.size());
+        auto worker = [&]() {
+            for (uint32_t i = next_range++; i < range_count; i = next_range++)
+            {
+                updateRange(m_dirty_ranges[i]);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(worker_count - 1);
+        for (uint32_t i = 1; i < worker_count; ++i)
+        {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        return node_count;
+    }
+
+    void SceneGraph::clear()
+    {
+        m_free_records.clear();
+        for (uint32_t index = 0; index < m_records.size(); ++index)
+        {
+            NodeRecord& record = m_records[index];
+            uint32_t generation = record.alive ? record.generation + 1 : record.generation;
+            record = NodeRecord{};
+            record.generation = generation;
+            m_free_records.push_back(index);
+        }
+
+        m_dirty_nodes.clear();
+        m_slot_nodes.clear();
+        m_slot_parents.clear();
+        m_slot_subtree_ends.clear();
+        m_local_matrices.clear();
+        m_world_matrices.clear();
+        m_dirty_ranges.clear();
+        m_topology_dirty = false;
+    }
+
+    void SceneGraph::markDirty(uint32_t index)
+    {
+        NodeRecord& record = m_records[index];
+        if (!record.dirty)
+        {
+            record.dirty = true;
+            m_dirty_nodes.push_back(index);
+        }
+    }
+
+    void SceneGraph::linkChild(uint32_t parent, uint32_t child)
+    {
+        m_records[child].parent = parent;
+        m_records[child].next_sibling = m_records[parent].first_child;
+        m_records[parent].first_child = child;
+    }
+
+    void SceneGraph::unlinkChild(uint32_t parent, uint32_t child)
+    {
+        uint32_t* link = &m_records[parent].first_child;
+        while (*link != SceneNode::k_invalid_index && *link != child)
+        {
+            link = &m_records[*link].next_sibling;
+        }
+        if (*link == child)
+        {
+            *link = m_records[child].next_sibling;
+        }
+        m_records[child].parent = SceneNode::k_invalid_index;
+        m_records[child].next_sibling = SceneNode::k_invalid_index;
+    }
+
+    /**
+     * @brief 按先序遍历重建有序数组
+     * @details 根节点保持原有相对顺序；子树结束位置由逆序扫描累计得到（子节点的slot总大于父节点）
+     */
+    void SceneGraph::rebuildOrder()
+    {
+        std::vector<uint32_t>  slot_nodes;
+        std::vector<uint32_t>  slot_parents;
+        std::vector<glm::mat4> local_matrices;
+        std::vector<glm::mat4> world_matrices;
+        size_t alive_count = m_records.size() - m_free_records.size();
+        slot_nodes.reserve(alive_count);
+        slot_parents.reserve(alive_count);
+        local_matrices.reserve(alive_count);
+        world_matrices.reserve(alive_count);
+
+        std::vector<std::pair<uint32_t, uint32_t>> stack;   // (记录索引, 父节点新slot)
+        for (uint32_t old_slot = 0; old_slot < m_slot_nodes.size(); ++old_slot)
+        {
+            uint32_t root = m_slot_nodes[old_slot];
+            if (root == SceneNode::k_invalid_index || m_records[root].parent != SceneNode::k_invalid_index)
+            {
+                continue;
+            }
+
+            stack.emplace_back(root, k_invalid_slot);
+            while (!stack.empty())
+            {
+                auto [index, parent_slot] = stack.back();
+                stack.pop_back();
+
+                NodeRecord& record = m_records[index];
+                uint32_t slot = static_cast<uint32_t>(slot_nodes.size());
+                slot_nodes.push_back(index);
+                slot_parents.push_back(parent_slot);
+                local_matrices.push_back(m_local_matrices[record.slot]);
+                world_matrices.push_back(m_world_matrices[record.slot]);
+                record.slot = slot;
+
+                for (uint32_t child = record.first_child; child != SceneNode::k_invalid_index; child = m_records[child].next_sibling)
+                {
+                    stack.emplace_back(child, slot);
+                }
+            }
+        }
+
+        std::vector<uint32_t> subtree_ends(slot_nodes.size());
+        for (uint32_t slot = 0; slot < subtree_ends.size(); ++slot)
+        {
+            subtree_ends[slot] = slot + 1;
+        }
+        for (uint32_t slot = static_cast<uint32_t>(subtree_ends.size()); slot-- > 0;)
+        {
+            uint32_t parent_slot = slot_parents[slot];
+            if (parent_slot != k_invalid_slot)
+            {
+                subtree_ends[parent_slot] = std::max(subtree_ends[parent_slot], subtree_ends[slot]);
+            }
+        }
+
+        m_slot_nodes = std::move(slot_nodes);
+        m_slot_parents = std::move(slot_parents);
+        m_slot_subtree_ends = std::move(subtree_ends);
+        m_local_matrices = std::move(local_matrices);
+        m_world_matrices = std::move(world_matrices);
+        m_topology_dirty = false;
+    }
+
+    void SceneGraph::updateRange(const DirtyRange& range)
+    {
+        for (uint32_t slot = range.begin; slot < range.end; ++slot)
+        {
+            uint32_t parent_slot = m_slot_parents[slot];
+            m_world_matrices[slot] = parent_slot == k_invalid_slot
+                ? m_local_matrices[slot]
+                : m_world_matrices[parent_slot] * m_local_matrices[slot];
+        }
+    }
+} // namespace Elish
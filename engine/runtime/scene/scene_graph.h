@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Elish
+{
+    /**
+     * @brief 场景图节点句柄
+     * @details 与Entity相同，index索引节点记录，generation在节点销毁后递增使旧句柄失效；
+     *          层级变化导致节点在有序数组中的位置改变时句柄保持不变
+     */
+    struct SceneNode
+    {
+        static constexpr uint32_t k_invalid_index = ~0u;
+
+        uint32_t index = k_invalid_index;
+        uint32_t generation = 0;
+
+        bool isValid() const { return index != k_invalid_index; }
+        bool operator==(const SceneNode& other) const { return index == other.index && generation == other.generation; }
+        bool operator!=(const SceneNode& other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief 层级场景图
+     * @details 局部/世界矩阵存放在按先序遍历排列的连续数组中：父节点总在子节点之前，每棵子树占据一段连续区间。
+     *          修改局部矩阵或父节点只置脏标记；update()把脏节点按所在子树合并为互不重叠的区间，
+     *          每个区间内顺序执行 world = parent_world * local，工作量只与发生变化的子树大小成正比。
+     *          互不包含的脏子树之间没有依赖，数量足够多时分发到多个线程并行计算。
+     *          层级结构变化（增删节点、改父节点）在下次update()时重建有序数组，开销与节点总数成正比。
+     *          非线程安全，只允许在拥有者线程访问
+     */
+    class SceneGraph
+    {
+    public:
+        SceneNode createNode(SceneNode parent = SceneNode{});
+
+        /**
+         * @brief 销毁节点，其子节点挂到该节点的父节点下（局部矩阵不变）
+         */
+        void destroyNode(SceneNode node);
+        bool isAlive(SceneNode node) const;
+
+        /**
+         * @brief 修改父节点
+         * @param parent 无效句柄表示变为根节点
+         * @return 节点无效、父节点无效或会形成环时返回false
+         */
+        bool setParent(SceneNode node, SceneNode parent);
+        SceneNode getParent(SceneNode node) const;
+
+        void setLocalMatrix(SceneNode node, const glm::mat4& local);
+        const glm::mat4& getLocalMatrix(SceneNode node) const;
+
+        /**
+         * @brief 获取世界矩阵，反映最近一次update()的结果；节点无效时返回单位矩阵
+         */
+        const glm::mat4& getWorldMatrix(SceneNode node) const;
+
+        /**
+         * @brief 传播脏标记并重算变化子树的世界矩阵
+         * @return 本次重算的节点数量
+         */
+        uint32_t update();
+
+        bool hasPendingUpdates() const { return m_topology_dirty || !m_dirty_nodes.empty(); }
+        size_t getNodeCount() const { return m_records.size() - m_free_records.size(); }
+
+        /**
+         * @brief 并行更新的线程数，0表示使用硬件线程数
+         */
+        void setWorkerCount(uint32_t worker_count) { m_worker_count = worker_count; }
+
+        /**
+         * @brief 销毁所有节点，已有句柄全部失效
+         */
+        void clear();
+
+    private:
+        static constexpr uint32_t k_invalid_slot = ~0u;
+        static constexpr uint32_t k_parallel_min_nodes = 4096;   // 本帧重算节点少于此数时单线程执行，避免线程启动开销
+
+        struct NodeRecord
+        {
+            uint32_t generation = 0;
+            bool     alive = false;
+            bool     dirty = false;                     // 已进入m_dirty_nodes
+            uint32_t slot = k_invalid_slot;             // 在有序数组中的位置
+            uint32_t parent = SceneNode::k_invalid_index;
+            uint32_t first_child = SceneNode::k_invalid_index;
+            uint32_t next_sibling = SceneNode::k_invalid_index;
+        };
+
+        /** @brief 一段连续的脏子树区间 [begin, end) */
+        struct DirtyRange
+        {
+            uint32_t begin = 0;
+            uint32_t end = 0;
+        };
+
+        void markDirty(uint32_t index);
+        void linkChild(uint32_t parent, uint32_t child);
+        void unlinkChild(uint32_t parent, uint32_t child);
+
+        /**
+         * @brief 按先序遍历重建有序数组，保留各节点的局部/世界矩阵
+         */
+        void rebuildOrder();
+
+        void updateRange(const DirtyRange& range);
+
+        std::vector<NodeRecord> m_records;
+        std::vector<uint32_t>   m_free_records;
+        std::vector<uint32_t>   m_dirty_nodes;          // 记录索引
+
+        // 按先序排列的节点数据，下标为slot
+        std::vector<uint32_t>   m_slot_nodes;           // slot -> 记录索引
+        std::vector<uint32_t>   m_slot_parents;         // slot -> 父节点slot，根节点为k_invalid_slot
+        std::vector<uint32_t>   m_slot_subtree_ends;    // slot -> 子树区间的结束位置（不含）
+        std::vector<glm::mat4>  m_local_matrices;
+        std::vector<glm::mat4>  m_world_matrices;
+
+        std::vector<DirtyRange> m_dirty_ranges;
+        bool                    m_topology_dirty = false;
+        uint32_t                m_worker_count = 0;
+    };
+} // namespace Elish
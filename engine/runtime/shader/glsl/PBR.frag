@@ -1,4 +1,12 @@
-#version 450  // 指定GLSL版本为4.5，支持现代GPU特性和计算着色器
+#version 460  // 指定GLSL版本为4.6，光线查询扩展要求460
+
+// 光线查询阴影变体：由构建系统以 -DRAY_QUERY_SHADOWS 额外编译一份（PBR_ray_query_shadows.frag）
+// 该变体用一条阴影光线替代阴影贴图查找，需设备支持 VK_KHR_ray_query
+// 光线追踪光照变体：以 -DRT_LIGHTING 编译（PBR_rt_lighting.frag），光滑表面的IBL镜面项改用半分辨率
+// 反射通道的结果，环境遮蔽叠加光线追踪AO；阴影来源与启用项由推送常量标志位选择
+#if defined(RAY_QUERY_SHADOWS) || defined(RT_LIGHTING)
+#extension GL_EXT_ray_query : require
+#endif
 
 // ============================================================================
 // PBR片段着色器 - 基于物理的渲染实现
@@ -158,6 +166,32 @@ layout(set = 0, binding = 7) uniform sampler2D sampler5;
 // 用于实时阴影计算，支持PCF软阴影技术
 layout(set = 0, binding = 8) uniform sampler2D directional_light_shadow;
 
+#if defined(RAY_QUERY_SHADOWS) || defined(RT_LIGHTING)
+// 描述符集合1：场景顶层加速结构（TLAS），与光线追踪通道共享
+layout(set = 1, binding = 0) uniform accelerationStructureEXT topLevelAS;
+#endif
+
+#ifdef RT_LIGHTING
+// 描述符集合1：半分辨率光线追踪反射（rgb: 反射辐射度, a: 有效性）与上采样引导（xyz: 法线, w: 主表面距离），
+// 以及半分辨率光线追踪环境遮蔽（r: 遮蔽, g: 主表面距离）
+layout(set = 1, binding = 1) uniform sampler2D reflectionColor;
+layout(set = 1, binding = 2) uniform sampler2D reflectionGuide;
+layout(set = 1, binding = 3) uniform sampler2D ambientOcclusion;
+
+#define RT_LIGHTING_FLAG_RAY_QUERY_SHADOWS 1u
+#define RT_LIGHTING_FLAG_REFLECTIONS 2u
+#define RT_LIGHTING_FLAG_AMBIENT_OCCLUSION 4u
+
+// 片段阶段推送常量，位于顶点阶段model矩阵之后
+layout(push_constant) uniform RayTracedLightingConstants
+{
+    layout(offset = 64) vec2 viewportOffset;  // 场景视口左上角（像素）
+    vec2 viewportExtent;                       // 场景视口尺寸（像素）
+    float roughnessThreshold;                  // 反射通道的粗糙度阈值
+    uint flags;                                // bit0: 阴影使用光线查询, bit1: 反射有效, bit2: 环境遮蔽有效
+} rt_lighting;
+#endif
+
 // ============================================================================
 // 变换矩阵Uniform缓冲对象
 // ============================================================================
@@ -778,6 +812,126 @@ float calculateDirectionalShadow(vec4 fragPosLightSpace, vec3 normal, vec3 light
     return 1.0 - (enhancedShadow * shadowIntensity);
 }
 
+#if defined(RAY_QUERY_SHADOWS) || defined(RT_LIGHTING)
+/**
+ * @brief 使用光线查询计算方向光源的阴影因子
+ * @param worldPos 片段世界坐标
+ * @param normal 几何法线（世界空间，已归一化），用于偏移光线起点避免自相交
+ * @param lightDir 光线方向向量（从表面指向光源，已归一化）
+ * @return 光照因子，与calculateDirectionalShadow保持一致：1.0=完全光照，0.15=完全阴影
+ *
+ * 每像素一条阴影光线，命中任意不透明几何体即终止，结果精确到像素且无需阴影贴图
+ */
+float calculateRayQueryShadow(vec3 worldPos, vec3 normal, vec3 lightDir)
+{
+    // 沿法线与光线方向偏移起点，避免自相交
+    vec3 origin = worldPos + normal * 0.01 + lightDir * 0.001;
+
+    rayQueryEXT rayQuery;
+    rayQueryInitializeEXT(rayQuery, topLevelAS,
+                          gl_RayFlagsTerminateOnFirstHitEXT | gl_RayFlagsOpaqueEXT,
+                          0xFF, origin, 0.001, lightDir, 10000.0);
+
+    // 不透明几何体由硬件直接提交，循环体无需处理候选交点
+    while (rayQueryProceedEXT(rayQuery))
+    {
+    }
+
+    bool occluded = rayQueryGetIntersectionTypeEXT(rayQuery, true) != gl_RayQueryCommittedIntersectionNoneEXT;
+    float shadowIntensity = 0.85; // 与阴影贴图路径相同的阴影强度系数
+    return occluded ? 1.0 - shadowIntensity : 1.0;
+}
+#endif
+
+#ifdef RT_LIGHTING
+/**
+ * @brief 深度/法线感知地上采样半分辨率光线追踪反射
+ * @param worldPos 片段世界坐标
+ * @param geometryNormal 朝向相机的几何法线（世界空间，已归一化）
+ * @param radiance 输出：上采样后的反射辐射度
+ * @return 反射覆盖率[0,1]，0表示该片段应完全使用IBL
+ *
+ * 取最近的2x2个半分辨率样本，双线性权重再乘以主表面距离与法线的相似度，
+ * 跨越几何边缘的样本权重趋近于0；未追踪（粗糙或未命中）的样本只降低覆盖率，不参与颜色平均
+ */
+float sampleRayTracedReflection(vec3 worldPos, vec3 geometryNormal, out vec3 radiance)
+{
+    radiance = vec3(0.0);
+
+    vec2 uv = (gl_FragCoord.xy - rt_lighting.viewportOffset) / rt_lighting.viewportExtent;
+    ivec2 size = textureSize(reflectionColor, 0);
+    vec2 texel = uv * vec2(size) - 0.5;
+    ivec2 base = ivec2(floor(texel));
+    vec2 f = texel - vec2(base);
+    float depth = length(worldPos - view.camera_position.xyz);
+
+    vec3 colorSum = vec3(0.0);
+    float coveredWeight = 0.0;
+    float totalWeight = 0.0;
+    for (int i = 0; i < 4; ++i)
+    {
+        ivec2 offset = ivec2(i & 1, i >> 1);
+        ivec2 p = clamp(base + offset, ivec2(0), size - 1);
+        vec4 guide = texelFetch(reflectionGuide, p, 0);
+        if (guide.w < 0.0)
+        {
+            continue;
+        }
+
+        float bilinear = (offset.x == 1 ? f.x : 1.0 - f.x) * (offset.y == 1 ? f.y : 1.0 - f.y);
+        float depthWeight = exp(-abs(guide.w - depth) / (0.02 * depth + 0.001));
+        float normalWeight = pow(max(dot(guide.xyz, geometryNormal), 0.0), 16.0);
+        float weight = max(bilinear, 0.001) * depthWeight * normalWeight;
+
+        vec4 reflection = texelFetch(reflectionColor, p, 0);
+        colorSum += reflection.rgb * reflection.a * weight;
+        coveredWeight += reflection.a * weight;
+        totalWeight += weight;
+    }
+
+    if (totalWeight < 0.0001 || coveredWeight < 0.0001)
+    {
+        return 0.0;
+    }
+    radiance = colorSum / coveredWeight;
+    return coveredWeight / totalWeight;
+}
+
+/**
+ * @brief 深度感知地上采样半分辨率光线追踪环境遮蔽
+ * @param worldPos 片段世界坐标
+ * @return 遮蔽值[0,1]，1表示无遮蔽；附近没有深度一致的样本时返回1
+ */
+float sampleRayTracedAmbientOcclusion(vec3 worldPos)
+{
+    vec2 uv = (gl_FragCoord.xy - rt_lighting.viewportOffset) / rt_lighting.viewportExtent;
+    ivec2 size = textureSize(ambientOcclusion, 0);
+    vec2 texel = uv * vec2(size) - 0.5;
+    ivec2 base = ivec2(floor(texel));
+    vec2 f = texel - vec2(base);
+    float depth = length(worldPos - view.camera_position.xyz);
+
+    float aoSum = 0.0;
+    float totalWeight = 0.0;
+    for (int i = 0; i < 4; ++i)
+    {
+        ivec2 offset = ivec2(i & 1, i >> 1);
+        vec2 ao = texelFetch(ambientOcclusion, clamp(base + offset, ivec2(0), size - 1), 0).rg;
+        if (ao.g < 0.0)
+        {
+            continue;
+        }
+
+        float bilinear = (offset.x == 1 ? f.x : 1.0 - f.x) * (offset.y == 1 ? f.y : 1.0 - f.y);
+        float weight = max(bilinear, 0.001) * exp(-abs(ao.g - depth) / (0.02 * depth + 0.001));
+        aoSum += ao.r * weight;
+        totalWeight += weight;
+    }
+
+    return totalWeight < 0.0001 ? 1.0 : aoSum / totalWeight;
+}
+#endif
+
 // ============================================================================
 // 环境光照辅助函数
 // ============================================================================
@@ -1055,6 +1209,14 @@ void main()
     // 环境遮蔽贴图：模拟几何自遮挡，增强深度感
     vec3 ambient_occlution = texture(sampler5, fragTexCoord).rgb;
 
+#ifdef RT_LIGHTING
+    // 材质AO只描述网格自身的遮蔽，物体之间的接触遮蔽由光线追踪AO补充
+    if ((rt_lighting.flags & RT_LIGHTING_FLAG_AMBIENT_OCCLUSION) != 0u)
+    {
+        ambient_occlution *= sampleRayTracedAmbientOcclusion(fragPosition);
+    }
+#endif
+
     // 限制粗糙度最小值，避免数值不稳定和过度锐利的反射
     // 完全光滑的表面在现实中不存在，最小值0.01提供合理的物理约束
     roughness = max(0.01, roughness);
@@ -1143,11 +1305,27 @@ void main()
         
         // 将当前片段位置变换到光源空间坐标系
         // 用于在阴影贴图中查找对应的深度值
-        vec4 fragPosLightSpace = ubo.directional_light_proj_view * vec4(fragPosition, 1.0);
-        
-        // 计算阴影因子（0=完全阴影，1=完全光照）
-        // 使用PCF（Percentage Closer Filtering）实现软阴影边缘
-        float shadow = calculateDirectionalShadow(fragPosLightSpace, N, L);
+#if defined(RAY_QUERY_SHADOWS)
+        // 光线查询变体：直接对TLAS发射阴影光线，不读取阴影贴图
+        float shadow = calculateRayQueryShadow(fragPosition, normalize(fragNormal), L);
+#else
+        float shadow;
+#ifdef RT_LIGHTING
+        // 光照变体同时承担光线查询阴影，由推送常量选择阴影来源
+        if ((rt_lighting.flags & RT_LIGHTING_FLAG_RAY_QUERY_SHADOWS) != 0u)
+        {
+            shadow = calculateRayQueryShadow(fragPosition, normalize(fragNormal), L);
+        }
+        else
+#endif
+        {
+            vec4 fragPosLightSpace = ubo.directional_light_proj_view * vec4(fragPosition, 1.0);
+
+            // 计算阴影因子（0=完全阴影，1=完全光照）
+            // 使用PCF（Percentage Closer Filtering）实现软阴影边缘
+            shadow = calculateDirectionalShadow(fragPosLightSpace, N, L);
+        }
+#endif
         
         // 添加最小环境光强度，确保阴影区域仍有基础可见度
         // 这模拟了现实中的天空光、反射光等间接光照效应
@@ -1196,6 +1374,19 @@ void main()
     // 从天空盒采样环境光照，使用计算得到的mip级别
     // 乘以10.0是HDR环境贴图的强度调整因子
     vec3 reflection_L = textureLod(skycube, R, mip).rgb * 10.0;
+
+#ifdef RT_LIGHTING
+	// 光滑表面用光线追踪反射替换天空盒辐射度，粗糙度接近阈值时与IBL平滑过渡
+	if ((rt_lighting.flags & RT_LIGHTING_FLAG_REFLECTIONS) != 0u)
+	{
+		vec3 geometry_normal = normalize(fragNormal);
+		geometry_normal = dot(geometry_normal, V) < 0.0 ? -geometry_normal : geometry_normal;
+		vec3 traced_reflection;
+		float reflection_coverage = sampleRayTracedReflection(fragPosition, geometry_normal, traced_reflection);
+		float roughness_gate = 1.0 - smoothstep(rt_lighting.roughnessThreshold * 0.75, rt_lighting.roughnessThreshold, roughness);
+		reflection_L = mix(reflection_L, traced_reflection, reflection_coverage * roughness_gate);
+	}
+#endif
 	
 	// 计算镜面遮蔽：考虑粗糙度和AO对环境反射的影响
 	float reflection_V = GetSpecularOcclusion(NdotV, roughness * roughness, ambient_occlution.x);
@@ -0,0 +1,35 @@
+#version 450
+
+// ============================================================================
+// 光线追踪合成片段着色器
+// ============================================================================
+/**
+ * @file rt_composite.frag
+ * @brief 在UI子通道中将光线追踪输出作为纹理采样并混合到场景视口
+ * @details 配合 post_process.vert 的全屏三角形使用：
+ *          - 按场景视口计算纹理坐标，光线追踪输出分辨率低于视口时由线性采样器完成双线性放大
+ *          - 以 opacity 作为alpha输出，与已有的光栅化结果进行alpha混合，UI随后绘制在其上方
+ */
+
+// 光线追踪输出图像（GENERAL布局，线性采样）
+layout(set = 0, binding = 0) uniform sampler2D rtOutput;
+
+layout(push_constant) uniform PushConstants
+{
+    vec2 viewportOffset;   // 场景视口左上角（像素）
+    vec2 viewportExtent;   // 场景视口尺寸（像素）
+    float opacity;         // 合成不透明度，1.0完全覆盖光栅化结果
+} pc;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    vec2 uv = (gl_FragCoord.xy - pc.viewportOffset) / pc.viewportExtent;
+
+    // 夹紧到半个纹素内，避免默认采样器的重复寻址在边缘混入对侧像素
+    vec2 halfTexel = 0.5 / vec2(textureSize(rtOutput, 0));
+    uv = clamp(uv, halfTexel, vec2(1.0) - halfTexel);
+
+    outColor = vec4(texture(rtOutput, uv).rgb, pc.opacity);
+}
@@ -0,0 +1,176 @@
+#include "render/software/cpu_bvh.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace Elish;
+
+namespace
+{
+    int g_failures = 0;
+
+    void check(bool condition, const char* message, int index)
+    {
+        if (!condition)
+        {
+            std::printf("[CpuBvhTest] FAILED: %s (ray %d)\n", message, index);
+            ++g_failures;
+        }
+    }
+
+    /**
+     * @brief 逐个三角形求交的参考实现，与CpuBvh使用相同的Möller-Trumbore判定
+     */
+    CpuHit bruteForceIntersect(const std::vector<CpuTriangle>& triangles, const CpuRay& ray)
+    {
+        CpuHit best;
+        float closest = ray.t_max;
+        for (uint32_t i = 0; i < triangles.size(); ++i)
+        {
+            const CpuTriangle& tri = triangles[i];
+            glm::vec3 p = glm::cross(ray.direction, tri.e2);
+            float det = glm::dot(tri.e1, p);
+            if (std::fabs(det) < 1e-10f)
+            {
+                continue;
+            }
+            float inv_det = 1.0f / det;
+            glm::vec3 s = ray.origin - tri.v0;
+            float u = glm::dot(s, p) * inv_det;
+            if (u < 0.0f || u > 1.0f)
+            {
+                continue;
+            }
+            glm::vec3 q = glm::cross(s, tri.e1);
+            float v = glm::dot(ray.direction, q) * inv_det;
+            if (v < 0.0f || u + v > 1.0f)
+            {
+                continue;
+            }
+            float t = glm::dot(tri.e2, q) * inv_det;
+            if (t > ray.t_min && t < closest)
+            {
+                closest = t;
+                best.t = t;
+                best.u = u;
+                best.v = v;
+                best.triangle = i;
+            }
+        }
+        return best;
+    }
+
+    CpuTriangle makeTriangle(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, uint32_t id)
+    {
+        CpuTriangle tri;
+        tri.v0 = v0;
+        tri.e1 = v1 - v0;
+        tri.e2 = v2 - v0;
+        tri.object_id = 0;
+        tri.primitive_id = id;
+        return tri;
+    }
+
+    /**
+     * @brief 随机射线与暴力求交逐条比对命中与否和最近距离
+     * @details BVH会重排三角形且重叠三角形可能命中其中任意一个，因此只比较距离
+     */
+    void compareAgainstBruteForce(const char* name, std::vector<CpuTriangle> triangles, const glm::vec3& scene_min,
+                                  const glm::vec3& scene_max, uint32_t ray_count, std::mt19937& rng)
+    {
+        CpuBvh bvh;
+        bvh.build(triangles, 4);
+        std::printf("[CpuBvhTest] %s: %zu triangles, %u nodes, depth %u\n",
+                    name, triangles.size(), bvh.getNodeCount(), bvh.getDepth());
+
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        auto randomPoint = [&]() {
+            return scene_min + (scene_max - scene_min) * glm::vec3(unit(rng), unit(rng), unit(rng));
+        };
+
+        for (uint32_t r = 0; r < ray_count; r += 4)
+        {
+            CpuRay rays[4];
+            CpuRayPacket4 packet;
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                rays[lane].origin = randomPoint();
+                rays[lane].direction = glm::normalize(randomPoint() - rays[lane].origin + glm::vec3(1e-3f));
+                rays[lane].t_max = 1e4f;
+                packet.setRay(lane, rays[lane]);
+            }
+
+            CpuHit packet_hits[4];
+            bvh.intersectPacket(packet, packet_hits);
+
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                int index = static_cast<int>(r) + lane;
+                const CpuRay& ray = rays[lane];
+                CpuHit expected = bruteForceIntersect(triangles, ray);
+
+                CpuHit hit;
+                bool hit_found = bvh.intersect(ray, hit);
+                check(hit_found == expected.valid(), "intersect hit mismatch", index);
+                check(bvh.occluded(ray) == expected.valid(), "occluded mismatch", index);
+                check(packet_hits[lane].valid() == expected.valid(), "intersectPacket hit mismatch", index);
+                if (!expected.valid() || !hit_found || !packet_hits[lane].valid())
+                {
+                    continue;
+                }
+
+                float tolerance = 1e-4f * std::max(1.0f, expected.t);
+                check(std::fabs(hit.t - expected.t) <= tolerance, "intersect distance mismatch", index);
+                check(std::fabs(packet_hits[lane].t - expected.t) <= tolerance, "intersectPacket distance mismatch", index);
+            }
+        }
+    }
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    // 均匀分布的随机小三角形
+    {
+        std::vector<CpuTriangle> triangles;
+        for (uint32_t i = 0; i < 2000; ++i)
+        {
+            glm::vec3 center(unit(rng) * 20.0f - 10.0f, unit(rng) * 20.0f - 10.0f, unit(rng) * 20.0f - 10.0f);
+            glm::vec3 a(unit(rng) - 0.5f, unit(rng) - 0.5f, unit(rng) - 0.5f);
+            glm::vec3 b(unit(rng) - 0.5f, unit(rng) - 0.5f, unit(rng) - 0.5f);
+            triangles.push_back(makeTriangle(center, center + a, center + b, i));
+        }
+        compareAgainstBruteForce("random", triangles, glm::vec3(-12.0f), glm::vec3(12.0f), 4000, rng);
+    }
+
+    // 沿x轴按等比数列排列的三角形：分箱SAH每次只能切下末端少量三角形，
+    // 折叠后的宽节点深度使遍历栈超出栈上预留的容量，覆盖堆内存分支
+    {
+        std::vector<CpuTriangle> triangles;
+        float position = 1.0f;
+        for (uint32_t i = 0; i < 4000; ++i)
+        {
+            glm::vec3 center(position, 0.0f, 0.0f);
+            triangles.push_back(makeTriangle(center + glm::vec3(0.0f, -1.0f, -1.0f),
+                                             center + glm::vec3(0.0f, 1.0f, -1.0f),
+                                             center + glm::vec3(0.0f, 0.0f, 1.0f), i));
+            position *= 1.02f;
+        }
+        CpuBvh bvh;
+        bvh.build(triangles, 1);
+        check(3 * bvh.getDepth() + 1 > 96, "deep scene does not exceed the inline traversal stack", -1);
+        compareAgainstBruteForce("deep", triangles, glm::vec3(0.0f, -1.0f, -1.0f), glm::vec3(position, 1.0f, 1.0f), 2000, rng);
+    }
+
+    if (g_failures != 0)
+    {
+        std::printf("[CpuBvhTest] %d checks failed\n", g_failures);
+        return 1;
+    }
+    std::printf("[CpuBvhTest] all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include "render/interface/null/null_rhi.h"
+#include "render/passes/main_camera_pass.h"
+#include "render/render_pass_base.h"
+#include "render/render_resource.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Elish
+{
+    /**
+     * @brief 访问MainCameraPass私有绘制路径的测试入口
+     * @details 跳过initialize()：模型管线句柄为空，NullRHI只按句柄id录制，不会解引用
+     */
+    class MainCameraPassTestAccess
+    {
+    public:
+        static void setScene(MainCameraPass& pass, std::shared_ptr<RenderResource> render_resource, std::vector<RenderObject> render_objects)
+        {
+            pass.m_render_resource = std::move(render_resource);
+            pass.m_loaded_render_objects = std::move(render_objects);
+        }
+
+        static void drawModels(MainCameraPass& pass, RHICommandBuffer* command_buffer, bool static_only)
+        {
+            RenderPipelineResource pipeline{};
+            MainCameraPass::ModelPipelineSelection selection;
+            selection.pipeline = &pipeline;
+            pass.drawModels(command_buffer, selection,
+                            static_only ? MainCameraPass::ModelDrawFilter::StaticOnly : MainCameraPass::ModelDrawFilter::All);
+        }
+    };
+} // namespace Elish
+
+using namespace Elish;
+
+namespace
+{
+    int g_failures = 0;
+
+    void checkEqual(uint64_t actual, uint64_t expected, const char* message)
+    {
+        if (actual != expected)
+        {
+            std::printf("[NullRhiDrawTest] FAILED: %s (expected %llu, got %llu)\n", message,
+                        static_cast<unsigned long long>(expected), static_cast<unsigned long long>(actual));
+            ++g_failures;
+        }
+    }
+
+    RHIBuffer* createBuffer(NullRHI& rhi, RHIDeviceSize size, RHIBufferUsageFlags usage)
+    {
+        RHIBufferCreateInfo create_info{};
+        create_info.sType = RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        create_info.size = size;
+        create_info.usage = usage;
+        create_info.sharingMode = RHI_SHARING_MODE_EXCLUSIVE;
+
+        RHIBuffer* buffer = nullptr;
+        rhi.createBuffer(&create_info, buffer);
+        return buffer;
+    }
+} // namespace
+
+int main()
+{
+    constexpr uint32_t k_object_count = 64;
+    constexpr uint32_t k_animated_count = 8;
+
+    auto rhi = std::make_shared<NullRHI>();
+    rhi->initialize(RHIInitInfo{});
+
+    // 前k_animated_count个物体随时间旋转，其余静止；另加一个缺少索引缓冲区的物体，应被跳过
+    auto render_resource = std::make_shared<RenderResource>();
+    for (uint32_t i = 0; i <= k_object_count; ++i)
+    {
+        RenderObject render_object{};
+        render_object.name = "object_" + std::to_string(i);
+        render_object.indices = { 0, 1, 2 };
+        render_object.vertexBuffer = createBuffer(*rhi, sizeof(Vertex) * 3, RHI_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+        render_object.indexBuffer = i < k_object_count ? createBuffer(*rhi, sizeof(uint32_t) * 3, RHI_BUFFER_USAGE_INDEX_BUFFER_BIT) : nullptr;
+        render_object.animationParams.enableAnimation = i < k_animated_count;
+        render_resource->addRenderObject(render_object);
+    }
+
+    std::vector<RenderObject> render_objects = render_resource->getLoadedRenderObjects();
+    for (RenderObject& render_object : render_objects)
+    {
+        render_object.descriptorSets.resize(rhi->getMaxFramesInFlight());
+        for (RHIDescriptorSet*& descriptor_set : render_object.descriptorSets)
+        {
+            rhi->allocateDescriptorSets(static_cast<RHIDescriptorSetLayout*>(nullptr), descriptor_set);
+        }
+    }
+
+    RenderPassCommonInfo common_info{};
+    common_info.rhi = rhi;
+    MainCameraPass pass;
+    pass.setCommonInfo(common_info);
+    MainCameraPassTestAccess::setScene(pass, render_resource, render_objects);
+
+    RHICommandBuffer* command_buffer = rhi->getCurrentCommandBuffer();
+
+    // 全部模型：每个有效物体一次推送常量、顶点/索引/描述符集绑定与索引绘制
+    rhi->resetStats();
+    MainCameraPassTestAccess::drawModels(pass, command_buffer, false);
+    checkEqual(rhi->getStats().pipeline_binds, 1, "all models: pipeline binds");
+    checkEqual(rhi->getStats().draw_calls, k_object_count, "all models: draw calls");
+    checkEqual(rhi->getStats().push_constants, k_object_count, "all models: push constants");
+    checkEqual(rhi->getStats().vertex_buffer_binds, k_object_count, "all models: vertex buffer binds");
+    checkEqual(rhi->getStats().index_buffer_binds, k_object_count, "all models: index buffer binds");
+    checkEqual(rhi->getStats().descriptor_set_binds, k_object_count, "all models: descriptor set binds");
+
+    // 仅静止模型：动画物体不录制
+    rhi->resetStats();
+    MainCameraPassTestAccess::drawModels(pass, command_buffer, true);
+    checkEqual(rhi->getStats().draw_calls, k_object_count - k_animated_count, "static models: draw calls");
+    checkEqual(rhi->getStats().descriptor_set_binds, k_object_count - k_animated_count, "static models: descriptor set binds");
+
+    if (g_failures != 0)
+    {
+        std::printf("[NullRhiDrawTest] %d checks failed\n", g_failures);
+        return 1;
+    }
+    std::printf("[NullRhiDrawTest] all checks passed\n");
+    return 0;
+}